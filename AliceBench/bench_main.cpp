@@ -0,0 +1,201 @@
+#define ALICE_NO_ENTRY_POINT 1
+#include "main.cpp"
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// peak resident set size of this process, in kilobytes
+static int64_t peak_rss_kb() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return int64_t(counters.PeakWorkingSetSize / 1024);
+	return 0;
+#else
+	rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) == 0)
+		return int64_t(usage.ru_maxrss);
+	return 0;
+#endif
+}
+
+// nothing consumes the ui-bound queues in a headless run, so empty them between ticks to keep them from filling up
+static void drain_ui_queues(sys::state& state) {
+	while(state.new_n_event.front())
+		state.new_n_event.pop();
+	while(state.new_f_n_event.front())
+		state.new_f_n_event.pop();
+	while(state.new_p_event.front())
+		state.new_p_event.pop();
+	while(state.new_f_p_event.front())
+		state.new_f_p_event.pop();
+	while(state.new_requests.front())
+		state.new_requests.pop();
+	while(state.new_messages.front())
+		state.new_messages.pop();
+	while(state.naval_battle_reports.front())
+		state.naval_battle_reports.pop();
+	while(state.land_battle_reports.front())
+		state.land_battle_reports.pop();
+}
+
+// the value below which the given fraction of the (sorted) samples lie
+static double percentile_ms(std::vector<int64_t> const& sorted_us, double fraction) {
+	if(sorted_us.empty())
+		return 0.0;
+	return double(sorted_us[size_t(double(sorted_us.size() - 1) * fraction)]) / 1000.0;
+}
+
+static void write_json_report(char const* path, char const* scenario, int32_t days, uint32_t seed, double ticks_per_second,
+	std::vector<int64_t> const& sorted_tick_us, std::string const& checksum, sys::state& state) {
+
+	std::string out = "{\n";
+	out += "\t\"scenario\": \"";
+	for(auto c = scenario; *c; ++c) {
+		if(*c == '\\' || *c == '"')
+			out += '\\';
+		out += *c;
+	}
+	out += "\",\n";
+	out += "\t\"days\": " + std::to_string(days) + ",\n";
+	out += "\t\"seed\": " + std::to_string(seed) + ",\n";
+	out += "\t\"ticks_per_second\": " + std::to_string(ticks_per_second) + ",\n";
+	out += "\t\"tick_median_ms\": " + std::to_string(percentile_ms(sorted_tick_us, 0.5)) + ",\n";
+	out += "\t\"tick_p99_ms\": " + std::to_string(percentile_ms(sorted_tick_us, 0.99)) + ",\n";
+	out += "\t\"peak_rss_kb\": " + std::to_string(peak_rss_kb()) + ",\n";
+	out += "\t\"checksum\": \"" + checksum + "\",\n";
+	out += "\t\"memory_kb\": {";
+	bool first = true;
+	for(auto& m : sys::describe_memory_usage(state)) {
+		out += first ? "\n" : ",\n";
+		out += "\t\t\"" + std::string(m.name) + "\": " + std::to_string(m.bytes / 1024);
+		first = false;
+	}
+	out += "\n\t},\n";
+	out += "\t\"phases\": [";
+	first = true;
+	for(auto& p : state.tick_timings.top_phases(sys::tick_profiler::max_phases)) {
+		out += first ? "\n" : ",\n";
+		out += "\t\t{ \"name\": \"" + std::string(p.name) + "\", \"average_ms\": " + std::to_string(p.average_ms)
+			+ ", \"median_ms\": " + std::to_string(p.median_ms) + ", \"p99_ms\": " + std::to_string(p.p99_ms)
+			+ ", \"peak_ms\": " + std::to_string(p.peak_ms) + " }";
+		first = false;
+	}
+	out += "\n\t]\n}\n";
+
+	if(auto f = std::fopen(path, "wb"); f) {
+		std::fwrite(out.data(), 1, out.size(), f);
+		std::fclose(f);
+	} else {
+		std::printf("Could not write %s\n", path);
+	}
+}
+
+int main(int argc, char** argv) {
+	if(argc <= 1) {
+		std::printf("Usage: %s [scenario file] [days = 365] [seed = 1] [json report file]\n", argv[0]);
+		std::printf("       %s [scenario file] --replay [replay file] [json report file]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	// plays back a replay written by the record-replay console command, rather than letting the ai run the game from the
+	// scenario's start
+	char const* replay_path = argc > 3 && std::strcmp(argv[2], "--replay") == 0 ? argv[3] : nullptr;
+	int32_t days = replay_path ? 1 : (argc > 2 ? std::atoi(argv[2]) : 365);
+	uint32_t seed = !replay_path && argc > 3 ? uint32_t(std::strtoul(argv[3], nullptr, 10)) : 1;
+	char const* json_path = argc > 4 ? argv[4] : nullptr;
+	if(days <= 0) {
+		std::printf("The number of days must be positive\n");
+		return EXIT_FAILURE;
+	}
+
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
+	add_root(game_state->common_fs, NATIVE("."));
+
+	auto load_start = std::chrono::steady_clock::now();
+	if(!sys::try_read_scenario_and_save_file(*game_state, simple_fs::utf8_to_native(argv[1]))) {
+		std::printf("Scenario file %s could not be read\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	game_state->fill_unsaved_data();
+	// the scenario loader picks a random seed; a benchmark has to be repeatable
+	game_state->game_seed = seed;
+	game_state->local_player_nation = dcon::nation_id{};
+
+	sys::replay replay;
+	if(replay_path) {
+		std::vector<uint8_t> replay_data;
+		if(auto f = std::fopen(replay_path, "rb"); f) {
+			uint8_t buffer[1 << 16];
+			size_t count = 0;
+			while((count = std::fread(buffer, 1, sizeof(buffer), f)) > 0)
+				replay_data.insert(replay_data.end(), buffer, buffer + count);
+			std::fclose(f);
+		}
+		if(!replay.deserialize(replay_data.data(), replay_data.data() + replay_data.size())) {
+			std::printf("Replay file %s could not be read\n", replay_path);
+			return EXIT_FAILURE;
+		}
+		// the seed and the local player come from the save the replay starts with
+		if(!sys::load_replay_start(*game_state, replay)) {
+			std::printf("Replay file %s was not recorded with this scenario\n", replay_path);
+			return EXIT_FAILURE;
+		}
+		days = replay.end_date.value - replay.start_date.value;
+		seed = game_state->game_seed;
+	}
+	auto load_end = std::chrono::steady_clock::now();
+
+	std::printf("Loaded %s in %d ms\n", argv[1], int32_t(std::chrono::duration_cast<std::chrono::milliseconds>(load_end - load_start).count()));
+
+	game_state->tick_timings.clear();
+	game_state->tick_timings.enabled.store(true, std::memory_order::release);
+
+	std::vector<int64_t> tick_us;
+	tick_us.reserve(size_t(days));
+	size_t next_replay_command = 0;
+	auto run_start = std::chrono::steady_clock::now();
+	for(int32_t i = 0; i < days; ++i) {
+		auto tick_start = std::chrono::steady_clock::now();
+		if(replay_path)
+			sys::prepare_replay_day(*game_state, replay, next_replay_command);
+		game_state->single_game_tick();
+		tick_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tick_start).count());
+		drain_ui_queues(*game_state);
+	}
+	if(replay_path) // the commands given on the day the recording stopped, so that the checksum is that of the recorded game
+		sys::prepare_replay_day(*game_state, replay, next_replay_command);
+	auto run_end = std::chrono::steady_clock::now();
+	std::sort(tick_us.begin(), tick_us.end());
+
+	auto run_ms = std::chrono::duration_cast<std::chrono::milliseconds>(run_end - run_start).count();
+	auto ticks_per_second = run_ms > 0 ? double(days) * 1000.0 / double(run_ms) : 0.0;
+	std::printf("Ran %d days (seed %u) in %d ms: %.2f ticks/sec\n", days, seed, int32_t(run_ms), ticks_per_second);
+	std::printf("Tick time: %.3f ms median, %.3f ms p99\n", percentile_ms(tick_us, 0.5), percentile_ms(tick_us, 0.99));
+	std::printf("Peak RSS: %lld KB\n", static_cast<long long>(peak_rss_kb()));
+	std::string checksum_hex;
+	auto checksum = game_state->get_save_checksum();
+	for(auto b : checksum.key) {
+		char digits[3];
+		std::snprintf(digits, sizeof(digits), "%02x", static_cast<unsigned int>(b));
+		checksum_hex += digits;
+	}
+	std::printf("Checksum: %s\n", checksum_hex.c_str());
+
+	std::printf("Memory (KB):\n");
+	for(auto& m : sys::describe_memory_usage(*game_state)) {
+		std::printf("%-48s %10lld\n", m.name, static_cast<long long>(m.bytes / 1024));
+	}
+
+	std::printf("Phase times over the last %d days (avg / median / p99 / peak ms):\n", std::min(days, sys::tick_profiler::history_length));
+	for(auto& p : game_state->tick_timings.top_phases(sys::tick_profiler::max_phases)) {
+		std::printf("%-48s %10.3f %10.3f %10.3f %10.3f\n", p.name, p.average_ms, p.median_ms, p.p99_ms, p.peak_ms);
+	}
+
+	if(json_path)
+		write_json_report(json_path, argv[1], days, seed, ticks_per_second, tick_us, checksum_hex, *game_state);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+#define ALICE_NO_ENTRY_POINT 1
+#include "main.cpp"
+
+#include <cctype>
+#include <csignal>
+#include <iostream>
+
+// A host that never opens a window: nothing here touches the window, opengl, the fonts, the map display data or the sound
+// system, so only the simulation and the network are ever initialized. The game thread is the same state::game_loop the
+// game runs, and the operator drives the session through stdin instead of the lobby and the console window.
+
+static std::atomic<bool> stop_requested = false;
+
+static void on_stop_signal(int) {
+	stop_requested.store(true, std::memory_order::release);
+}
+
+// nobody reads the ui-bound queues on a dedicated server, and a full queue would block the tick that pushes into it
+static void drain_ui_queues(sys::state& state) {
+	while(state.new_n_event.front())
+		state.new_n_event.pop();
+	while(state.new_f_n_event.front())
+		state.new_f_n_event.pop();
+	while(state.new_p_event.front())
+		state.new_p_event.pop();
+	while(state.new_f_p_event.front())
+		state.new_f_p_event.pop();
+	while(state.new_requests.front())
+		state.new_requests.pop();
+	while(state.new_messages.front())
+		state.new_messages.pop();
+	while(state.naval_battle_reports.front())
+		state.naval_battle_reports.pop();
+	while(state.land_battle_reports.front())
+		state.land_battle_reports.pop();
+}
+
+// the console output is meant for the text renderer, which takes ?X for a change of color and \n for a line break
+static std::string to_plain_text(std::string_view s) {
+	std::string out;
+	out.reserve(s.size());
+	for(size_t i = 0; i < s.size(); ++i) {
+		if(s[i] == '?' && i + 1 < s.size() && std::isalpha(uint8_t(s[i + 1]))) {
+			++i;
+		} else if(s[i] == '\\' && i + 1 < s.size() && s[i + 1] == 'n') {
+			out += '\n';
+			++i;
+		} else {
+			out += s[i];
+		}
+	}
+	return out;
+}
+
+static void print_console_output(sys::state& state) {
+	std::string result;
+	{
+		std::lock_guard lg{ state.lock_console_strings };
+		result = std::move(state.console_command_result);
+		state.console_command_result.clear();
+	}
+	if(!result.empty()) {
+		std::fputs(to_plain_text(result).c_str(), stdout);
+		std::fflush(stdout);
+	}
+}
+
+// the few things the lobby and the speed buttons would otherwise do; anything else is handed to the console
+static void run_server_command(sys::state& state, std::string const& line) {
+	if(line == "quit") {
+		stop_requested.store(true, std::memory_order::release);
+	} else if(line == "start") {
+		if(state.current_scene.game_in_progress)
+			std::printf("The game has already started\n");
+		else
+			command::notify_start_game(state, state.local_player_nation);
+	} else if(line == "stop") {
+		if(!state.current_scene.is_lobby)
+			command::notify_stop_game(state, state.local_player_nation);
+	} else if(line == "pause") {
+		state.actual_game_speed.store(0, std::memory_order::release);
+	} else if(line.starts_with("speed ")) {
+		auto speed = std::atoi(line.c_str() + 6);
+		state.actual_game_speed.store(std::clamp(speed, 0, 5), std::memory_order::release);
+	} else if(line == "save") {
+		command::save_game(state, state.local_player_nation, false);
+	} else if(!line.empty()) {
+		std::lock_guard lg{ state.lock_console_strings };
+		state.console_command_pending += line;
+		command::notify_console_command(state);
+	}
+	std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	if(argc <= 1) {
+		std::printf("Usage: %s [scenario file] [-save save file] [-name name] [-password password] [-speed 1-5] [-v4 | -v6]\n", argv[0]);
+		std::printf("Lines read from stdin: start, stop, pause, speed [0-5], save, quit, or any console command\n");
+		return EXIT_FAILURE;
+	}
+
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
+	add_root(game_state->common_fs, NATIVE("."));
+	game_state->network_state.nickname = sys::player_name{ "server" };
+
+	native_string save_file;
+	int32_t speed = 2;
+	for(int i = 2; i < argc; ++i) {
+		std::string_view arg{ argv[i] };
+		if(arg == "-save" && i + 1 < argc) {
+			save_file = simple_fs::utf8_to_native(argv[++i]);
+		} else if(arg == "-name" && i + 1 < argc) {
+			std::string nickname = argv[++i];
+			game_state->network_state.nickname = sys::player_name{};
+			memcpy(game_state->network_state.nickname.data, nickname.data(), std::min<size_t>(nickname.length(), 8));
+		} else if(arg == "-password" && i + 1 < argc) {
+			std::string_view str{ argv[++i] };
+			std::memset(game_state->network_state.password, '\0', sizeof(game_state->network_state.password));
+			std::memcpy(game_state->network_state.password, str.data(), std::min(sizeof(game_state->network_state.password), str.length()));
+		} else if(arg == "-speed" && i + 1 < argc) {
+			speed = std::clamp(std::atoi(argv[++i]), 1, 5);
+		} else if(arg == "-v6") {
+			game_state->network_state.as_v6 = true;
+		} else if(arg == "-v4") {
+			game_state->network_state.as_v6 = false;
+		} else {
+			std::printf("Unknown argument %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	auto load_start = std::chrono::steady_clock::now();
+	auto scenario_file = simple_fs::utf8_to_native(argv[1]);
+	if(!sys::try_read_scenario_and_save_file(*game_state, scenario_file)) {
+		std::printf("Scenario file %s could not be read\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	game_state->loaded_scenario_file = scenario_file;
+	game_state->fill_unsaved_data();
+	if(!save_file.empty()) {
+		if(!sys::try_read_save_file(*game_state, save_file)) {
+			std::printf("Save file could not be read with this scenario\n");
+			return EXIT_FAILURE;
+		}
+		game_state->fill_unsaved_data();
+	}
+	game_state->load_user_settings();
+	std::printf("Loaded %s in %d ms\n", argv[1], int32_t(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - load_start).count()));
+
+	game_state->network_mode = sys::network_mode_type::host;
+	network::init(*game_state);
+	game_state->actual_game_speed.store(speed, std::memory_order::release);
+
+	std::signal(SIGINT, on_stop_signal);
+	std::signal(SIGTERM, on_stop_signal);
+
+	std::thread update_thread([&]() { game_state->game_loop(); });
+
+	// stdin is read on a thread of its own, since there is no portable way to wait on it with a timeout; the thread is left
+	// behind at exit, as it may still be blocked in getline
+	std::mutex lines_lock;
+	std::vector<std::string> lines;
+	std::thread([&]() {
+		std::string line;
+		while(std::getline(std::cin, line)) {
+			if(!line.empty() && line.back() == '\r')
+				line.pop_back();
+			std::lock_guard l{ lines_lock };
+			lines.push_back(std::move(line));
+		}
+	}).detach();
+
+	std::printf("Hosting; type start once the players have joined\n");
+	std::fflush(stdout);
+	std::vector<std::string> to_run;
+	while(!stop_requested.load(std::memory_order::acquire)) {
+		{
+			std::lock_guard l{ lines_lock };
+			to_run.swap(lines);
+		}
+		for(auto& line : to_run)
+			run_server_command(*game_state, line);
+		to_run.clear();
+		drain_ui_queues(*game_state);
+		print_console_output(*game_state);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	game_state->quit_signaled.store(true, std::memory_order_release);
+	update_thread.join();
+	sys::finish_background_save(*game_state);
+	network::finish(*game_state, true);
+	std::quick_exit(EXIT_SUCCESS); // without waiting for the stdin thread
+}
@@ -367,10 +367,29 @@ void explain_ai_access_reasons(sys::state& state, dcon::nation_id target, text::
 void update_ai_research(sys::state& state) {
 	auto ymd_date = state.current_date.to_ymd(state.start_date);
 	auto year = uint32_t(ymd_date.year);
+
+	// The techs invented by this year are the same for every nation, as is the tech each of them needs first (the one before
+	// it in the same folder); they are gathered once so that the nations only have to look at their own progress.
+	static std::vector<dcon::technology_id> invented_techs;
+	static std::vector<dcon::technology_id> required_techs;
+	invented_techs.clear();
+	required_techs.clear();
+	for(auto tid : state.world.in_technology) {
+		if(ymd_date.year >= state.world.technology_get_year(tid)) {
+			dcon::technology_id prev_tech = dcon::technology_id(dcon::technology_id::value_base_t(tid.id.index() - 1));
+			invented_techs.push_back(tid);
+			if(tid.id.index() != 0 && state.world.technology_get_folder_index(prev_tech) == state.world.technology_get_folder_index(tid))
+				required_techs.push_back(prev_tech);
+			else // first tech in folder
+				required_techs.push_back(dcon::technology_id{});
+		}
+	}
+
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t id) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(id) };
 
 		if(state.world.nation_get_is_player_controlled(n)
+			|| !state.world.nation_get_ai_is_scheduled(n)
 			|| state.world.nation_get_current_research(n)
 			|| !state.world.nation_get_is_civilized(n)
 			|| state.world.nation_get_owned_province_count(n) == 0) {
@@ -378,50 +397,34 @@ void update_ai_research(sys::state& state) {
 			//skip -- does not need new research
 			return;
 		}
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::research, int32_t(id) };
 
-		struct potential_techs {
-			dcon::technology_id id;
-			float weight = 0.0f;
-		};
-
-		std::vector<potential_techs> potential;
-
-		for(auto tid : state.world.in_technology) {
+		// the highest weight wins, ties are broken semi randomly
+		auto rval = rng::get_random(state, id);
+		dcon::technology_id best;
+		float best_weight = 0.0f;
+		for(uint32_t i = 0; i < uint32_t(invented_techs.size()); ++i) {
+			auto tid = invented_techs[i];
 			if(state.world.nation_get_active_technologies(n, tid))
 				continue; // Already researched
+			// Only allow if all previously researched techs are researched
+			if(required_techs[i] && !state.world.nation_get_active_technologies(n, required_techs[i]))
+				continue;
 
-			if(state.current_date.to_ymd(state.start_date).year >= state.world.technology_get_year(tid)) {
-				// Find previous technology before this one
-				dcon::technology_id prev_tech = dcon::technology_id(dcon::technology_id::value_base_t(tid.id.index() - 1));
-				// Previous technology is from the same folder so we have to check that we have researched it beforehand
-				if(tid.id.index() != 0 && state.world.technology_get_folder_index(prev_tech) == state.world.technology_get_folder_index(tid)) {
-					// Only allow if all previously researched techs are researched
-					if(state.world.nation_get_active_technologies(n, prev_tech))
-						potential.push_back(potential_techs{ tid, 0.0f });
-				} else { // first tech in folder
-					potential.push_back(potential_techs{ tid, 0.0f });
-				}
-			}
-		}
-
-		for(auto& pt : potential) { // weight techs
-			auto base = state.world.technology_get_ai_weight(pt.id);
-			if(state.world.nation_get_ai_is_threatened(n) && state.culture_definitions.tech_folders[state.world.technology_get_folder_index(pt.id)].category == culture::tech_category::army) {
+			auto base = state.world.technology_get_ai_weight(tid);
+			if(state.world.nation_get_ai_is_threatened(n) && state.culture_definitions.tech_folders[state.world.technology_get_folder_index(tid)].category == culture::tech_category::army) {
 				base *= 2.0f;
 			}
-			auto cost = std::max(1.0f, culture::effective_technology_cost(state, year, n, pt.id));
-			pt.weight = base / cost;
+			auto cost = std::max(1.0f, culture::effective_technology_cost(state, year, n, tid));
+			auto weight = base / cost;
+			if(!best || weight > best_weight || (weight == best_weight && (tid.index() ^ rval) > (best.index() ^ rval))) {
+				best = tid;
+				best_weight = weight;
+			}
 		}
-		auto rval = rng::get_random(state, id);
-		std::sort(potential.begin(), potential.end(), [&](potential_techs& a, potential_techs& b) {
-			if(a.weight != b.weight)
-				return a.weight > b.weight;
-			else // sort semi randomly
-				return (a.id.index() ^ rval) > (b.id.index() ^ rval);
-		});
 
-		if(!potential.empty()) {
-			state.world.nation_set_current_research(n, potential[0].id);
+		if(best) {
+			state.world.nation_set_current_research(n, best);
 		}
 	});
 }
@@ -476,7 +479,6 @@ void update_influence_priorities(sys::state& state) {
 		dcon::nation_id id;
 		float weight = 0.0f;
 	};
-	static std::vector<weighted_nation> targets;
 
 	for(auto gprl : state.world.in_gp_relationship) {
 		if(gprl.get_great_power().get_is_player_controlled()) {
@@ -490,11 +492,15 @@ void update_influence_priorities(sys::state& state) {
 		}
 	}
 
-	for(auto& n : state.great_nations) {
+	// The targets of each great power are weighed in parallel, since the weights only read state that setting the priorities
+	// below doesn't change, and then the priorities are set in the order of the great powers as before.
+	std::vector<std::vector<weighted_nation>> gp_targets(state.great_nations.size());
+	concurrency::parallel_for(0, int32_t(state.great_nations.size()), [&](int32_t gp_index) {
+		auto& n = state.great_nations[gp_index];
 		if(state.world.nation_get_is_player_controlled(n.nation))
-			continue;
+			return;
 
-		targets.clear();
+		auto& targets = gp_targets[gp_index];
 		for(auto t : state.world.in_nation) {
 			if(t.get_is_great_power())
 				continue;
@@ -571,7 +577,14 @@ void update_influence_priorities(sys::state& state) {
 			else
 				return a.id.index() < b.id.index();
 		});
+	});
 
+	for(size_t gp_index = 0; gp_index < state.great_nations.size(); ++gp_index) {
+		auto& n = state.great_nations[gp_index];
+		if(state.world.nation_get_is_player_controlled(n.nation))
+			continue;
+
+		auto& targets = gp_targets[gp_index];
 		uint32_t i = 0;
 		for(; i < 2 && i < targets.size(); ++i) {
 			auto rel = state.world.get_gp_relationship_by_gp_influence_pair(targets[i].id, n.nation);
@@ -786,6 +799,63 @@ void update_focuses(sys::state& state) {
 	}
 }
 
+/*
+most decisions can only ever be taken by a single nation (a tag = X or owns = Y at the top of their potential), or only
+by civilized or uncivilized nations; these conditions are read off of the potential bytecode so that the full triggers
+are evaluated only for the nations that could possibly pass them
+*/
+struct decision_static_conditions {
+	dcon::nation_id only_nation;
+	bool impossible = false;
+	int8_t civilized = -1; // -1 = either, 0 = uncivilized only, 1 = civilized only
+};
+
+static bool association_is_equality(uint16_t code) {
+	auto const association = code & trigger::association_mask;
+	return association != trigger::association_ne && association != trigger::association_gt && association != trigger::association_lt;
+}
+
+static void read_static_condition(sys::state& state, uint16_t const* tval, decision_static_conditions& result) {
+	auto const code = tval[0] & trigger::code_mask;
+	if(code == trigger::generic_scope) {
+		if((tval[0] & trigger::is_disjunctive_scope) != 0)
+			return;
+		auto const source_size = 1 + trigger::get_trigger_scope_payload_size(tval);
+		auto sub_units_start = tval + 2;
+		while(sub_units_start < tval + source_size && !result.impossible) {
+			read_static_condition(state, sub_units_start, result);
+			sub_units_start += 1 + trigger::get_trigger_payload_size(sub_units_start);
+		}
+		return;
+	}
+
+	dcon::nation_id required;
+	if(code == trigger::tag_tag && association_is_equality(tval[0])) {
+		required = state.world.national_identity_get_nation_from_identity_holder(trigger::payload(tval[1]).tag_id);
+	} else if(code == trigger::owns && association_is_equality(tval[0])) {
+		required = state.world.province_get_nation_from_province_ownership(trigger::payload(tval[1]).prov_id);
+	} else if(code == trigger::civilized_nation) {
+		int8_t const civilized = association_is_equality(tval[0]) ? 1 : 0;
+		if(result.civilized != -1 && result.civilized != civilized)
+			result.impossible = true;
+		result.civilized = civilized;
+		return;
+	} else {
+		return;
+	}
+
+	if(!required || (result.only_nation && result.only_nation != required))
+		result.impossible = true;
+	result.only_nation = required;
+}
+
+static decision_static_conditions read_static_conditions(sys::state& state, dcon::trigger_key potential) {
+	decision_static_conditions result;
+	if(potential)
+		read_static_condition(state, state.trigger_data.data() + state.trigger_data_indices[potential.index() + 1], result);
+	return result;
+}
+
 void take_ai_decisions(sys::state& state) {
 	for(auto d : state.world.in_decision) {
 		auto e = d.get_effect();
@@ -796,10 +866,53 @@ void take_ai_decisions(sys::state& state) {
 		auto allow = d.get_allow();
 		auto ai_will_do = d.get_ai_will_do();
 
+		auto const conditions = read_static_conditions(state, potential);
+		if(conditions.impossible)
+			continue;
+
+		auto take_decision = [&](dcon::nation_id n) {
+			effect::execute(state, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(state.current_date.value),
+				uint32_t(n.index() << 4 ^ d.id.index()));
+			notification::post(state, notification::message{
+				[e, n, did = d.id, when = state.current_date](sys::state& state, text::layout_base& contents) {
+					text::add_line(state, contents, "msg_decision_1", text::variable_type::x, n, text::variable_type::y, state.world.decision_get_name(did));
+					text::add_line(state, contents, "msg_decision_2");
+					ui::effect_description(state, contents, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(when.value), uint32_t(n.index() << 4 ^ did.index()));
+				},
+				"msg_decision_title",
+				n, dcon::nation_id{}, dcon::nation_id{},
+				sys::message_base_type::decision
+			});
+		};
+
+		if(conditions.only_nation) {
+			auto n = conditions.only_nation;
+			if(state.world.nation_get_is_player_controlled(n) || state.world.nation_get_owned_province_count(n) == 0)
+				continue;
+			if(conditions.civilized != -1 && state.world.nation_get_is_civilized(n) != (conditions.civilized == 1))
+				continue;
+			if(potential && !trigger::evaluate(state, potential, trigger::to_generic(n), trigger::to_generic(n), 0))
+				continue;
+			if(allow && !trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0))
+				continue;
+			if(ai_will_do && !(trigger::evaluate_multiplicative_modifier(state, ai_will_do, trigger::to_generic(n), trigger::to_generic(n), 0) > 0.0f))
+				continue;
+			take_decision(n);
+			continue;
+		}
+
 		ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
+			ve::vbitfield_type candidates = !state.world.nation_get_is_player_controlled(ids);
+			if(conditions.civilized == 1)
+				candidates = candidates & state.world.nation_get_is_civilized(ids);
+			else if(conditions.civilized == 0)
+				candidates = candidates & !state.world.nation_get_is_civilized(ids);
+			if(candidates.v == 0)
+				return;
+
 			ve::vbitfield_type filter_a = potential
-				? (ve::compress_mask(trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0)) & !state.world.nation_get_is_player_controlled(ids))
-				: !state.world.nation_get_is_player_controlled(ids);
+				? (ve::compress_mask(trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0)) & candidates)
+				: candidates;
 
 			if(filter_a.v != 0) {
 				// empty allow assumed to be an "always = yes"
@@ -819,18 +932,7 @@ void take_ai_decisions(sys::state& state) {
 							? trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0)
 							: true);
 						if(second_validity) {
-							effect::execute(state, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(state.current_date.value),
-								uint32_t(n.index() << 4 ^ d.id.index()));
-							notification::post(state, notification::message{
-								[e, n, did = d.id, when = state.current_date](sys::state& state, text::layout_base& contents) {
-									text::add_line(state, contents, "msg_decision_1", text::variable_type::x, n, text::variable_type::y, state.world.decision_get_name(did));
-									text::add_line(state, contents, "msg_decision_2");
-									ui::effect_description(state, contents, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(when.value), uint32_t(n.index() << 4 ^ did.index()));
-								},
-								"msg_decision_title",
-								n, dcon::nation_id{}, dcon::nation_id{},
-								sys::message_base_type::decision
-							});
+							take_decision(n);
 						}
 					}
 				}, ids, filter_b);
@@ -963,13 +1065,14 @@ void get_desired_factory_types(sys::state& state, dcon::nation_id nid, std::vect
 void update_ai_econ_construction(sys::state& state) {
 	for(auto n : state.world.in_nation) {
 		// skip over: non ais, dead nations, and nations that aren't making money
-		if(n.get_owned_province_count() == 0 || !n.get_is_civilized())
+		if(n.get_owned_province_count() == 0 || !n.get_is_civilized() || !n.get_ai_is_scheduled())
 			continue;
 
 		if(n.get_is_player_controlled()) {
 			// to handle the logic of player building automation later
 			continue;
 		}
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::econ_construction, int32_t(n.id.index()) };
 
 		/*
 		if(n.get_spending_level() < 1.0f || n.get_last_treasury() >= n.get_stockpiles(economy::money))
@@ -1343,7 +1446,9 @@ void update_ai_colony_starting(sys::state& state) {
 			}
 		}
 	}
-	for(auto sd : state.world.in_state_definition) {
+	// states without unowned land could not be colonized anyway
+	for(auto sd_id : state.province_definitions.colonizable_states) {
+		auto sd = fatten(state.world, sd_id);
 		if(sd.get_colonization_stage() <= 1) {
 			bool has_unowned_land = false;
 
@@ -1618,73 +1723,67 @@ bool ai_offer_cb(sys::state& state, dcon::cb_type_id t) {
 }
 
 void state_target_list(std::vector<dcon::state_instance_id>& result, sys::state& state, dcon::nation_id for_nation, dcon::nation_id within) {
-	result.clear();
+	// The war goal searches ask for this once per target and war, so the border and coast tests, which walk the provinces of
+	// the state, and the distances are worked out once per state instead of on every step of the partitions and sorts.
+	struct target_state {
+		dcon::state_instance_id id;
+		float distance = 0.0f;
+		bool matches = false;
+	};
+	thread_local std::vector<target_state> targets;
+	targets.clear();
+
+	auto distance_from = state.world.nation_get_capital(for_nation).id;
 	for(auto si : state.world.nation_get_state_ownership(within)) {
-		result.push_back(si.get_state().id);
+		targets.push_back(target_state{ si.get_state().id, province::sorting_distance(state, si.get_state().get_capital(), distance_from), false });
 	}
 
-	auto distance_from = state.world.nation_get_capital(for_nation).id;
 	int32_t first = 0;
-
-	if(state.world.get_nation_adjacency_by_nation_adjacency_pair(for_nation, within)) {
-		int32_t last = int32_t(result.size());
+	// moves the states from first on that match to the front, in the same order as swapping from either end would
+	auto partition_matching = [&]() {
+		int32_t last = int32_t(targets.size());
 		while(first < last - 1) {
-			while(first < last && province::state_borders_nation(state, for_nation, result[first])) {
+			while(first < last && targets[first].matches) {
 				++first;
 			}
-			while(first < last - 1 && !province::state_borders_nation(state, for_nation, result[last - 1])) {
+			while(first < last - 1 && !targets[last - 1].matches) {
 				--last;
 			}
 			if(first < last - 1) {
-				std::swap(result[first], result[last - 1]);
+				std::swap(targets[first], targets[last - 1]);
 				++first;
 				--last;
 			}
 		}
-
-		std::sort(result.begin(), result.begin() + first, [&](dcon::state_instance_id a, dcon::state_instance_id b) {
-			auto a_distance = province::sorting_distance(state, state.world.state_instance_get_capital(a), distance_from);
-			auto b_distance = province::sorting_distance(state, state.world.state_instance_get_capital(b), distance_from);
-			if(a_distance != b_distance)
-				return a_distance < b_distance;
+	};
+	auto sort_by_distance = [&](int32_t from, int32_t to) {
+		std::sort(targets.begin() + from, targets.begin() + to, [&](target_state const& a, target_state const& b) {
+			if(a.distance != b.distance)
+				return a.distance < b.distance;
 			else
-				return a.index() < b.index();
+				return a.id.index() < b.id.index();
 		});
+	};
+
+	if(state.world.get_nation_adjacency_by_nation_adjacency_pair(for_nation, within)) {
+		for(auto& t : targets)
+			t.matches = province::state_borders_nation(state, for_nation, t.id);
+		partition_matching();
+		sort_by_distance(0, first);
 	}
 	if(state.world.nation_get_total_ports(for_nation) > 0 && state.world.nation_get_total_ports(within) > 0) {
-		int32_t last = int32_t(result.size());
-		while(first < last - 1) {
-			while(first < last && province::state_is_coastal(state, result[first])) {
-				++first;
-			}
-			while(first < last - 1 && !province::state_is_coastal(state, result[last - 1])) {
-				--last;
-			}
-			if(first < last - 1) {
-				std::swap(result[first], result[last - 1]);
-				++first;
-				--last;
-			}
-		}
-		std::sort(result.begin(), result.begin() + first, [&](dcon::state_instance_id a, dcon::state_instance_id b) {
-			auto a_distance = province::sorting_distance(state, state.world.state_instance_get_capital(a), distance_from);
-			auto b_distance = province::sorting_distance(state, state.world.state_instance_get_capital(b), distance_from);
-			if(a_distance != b_distance)
-				return a_distance < b_distance;
-			else
-				return a.index() < b.index();
-		});
+		for(size_t i = size_t(first); i < targets.size(); ++i)
+			targets[i].matches = province::state_is_coastal(state, targets[i].id);
+		partition_matching();
+		sort_by_distance(0, first);
 	}
-	if(first < int32_t(result.size())) {
-		std::sort(result.begin() + first, result.end(), [&](dcon::state_instance_id a, dcon::state_instance_id b) {
-			auto a_distance = province::sorting_distance(state, state.world.state_instance_get_capital(a), distance_from);
-			auto b_distance = province::sorting_distance(state, state.world.state_instance_get_capital(b), distance_from);
-			if(a_distance != b_distance)
-				return a_distance < b_distance;
-			else
-				return a.index() < b.index();
-		});
+	if(first < int32_t(targets.size())) {
+		sort_by_distance(first, int32_t(targets.size()));
 	}
+
+	result.clear();
+	for(auto& t : targets)
+		result.push_back(t.id);
 }
 
 void update_crisis_leaders(sys::state& state) {
@@ -2076,7 +2175,7 @@ void update_war_intervention(sys::state& state) {
 }
 
 dcon::cb_type_id pick_fabrication_type(sys::state& state, dcon::nation_id from, dcon::nation_id target) {
-	static std::vector<dcon::cb_type_id> possibilities;
+	thread_local std::vector<dcon::cb_type_id> possibilities;
 	possibilities.clear();
 
 	for(auto c : state.world.in_cb_type) {
@@ -2141,16 +2240,24 @@ bool valid_construction_target(sys::state& state, dcon::nation_id from, dcon::na
 }
 
 void update_cb_fabrication(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+	// Every nation picks its target in parallel, from the state at the start of the update, and the picks are stored
+	// afterwards. A nation's pick only depends on its own cb being constructed, not on those of the other nations (outside of
+	// cb trigger conditions that test them), and the random values are drawn per nation.
+	std::vector<dcon::nation_id> new_targets(state.world.nation_size());
+	std::vector<dcon::cb_type_id> new_types(state.world.nation_size());
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(index) });
+		if(!n.is_valid())
+			return;
 		if(!n.get_is_player_controlled() && n.get_owned_province_count() > 0) {
 			if(n.get_is_at_war())
-				continue;
+				return;
 			// Uncivilized nations are more aggressive to westernize faster
 			float infamy_limit = state.world.nation_get_is_civilized(n) ? state.defines.badboy_limit / 2.5f : state.defines.badboy_limit;
 			if(n.get_infamy() > infamy_limit)
-				continue;
+				return;
 			if(n.get_constructing_cb_type())
-				continue;
+				return;
 			auto ol = n.get_overlord_as_subject().get_ruler().id;
 			if(n.get_ai_rival()
 				&& n.get_ai_rival().get_in_sphere_of() != n
@@ -2161,11 +2268,11 @@ void update_cb_fabrication(sys::state& state) {
 
 				auto cb = pick_fabrication_type(state, n, n.get_ai_rival());
 				if(cb) {
-					n.set_constructing_cb_target(n.get_ai_rival());
-					n.set_constructing_cb_type(cb);
+					new_targets[index] = n.get_ai_rival();
+					new_types[index] = cb;
 				}
 			} else {
-				static std::vector<dcon::nation_id> possible_targets;
+				thread_local std::vector<dcon::nation_id> possible_targets;
 				possible_targets.clear();
 				for(auto i : state.world.in_nation) {
 					if(valid_construction_target(state, n, i)
@@ -2178,12 +2285,18 @@ void update_cb_fabrication(sys::state& state) {
 				if(!possible_targets.empty()) {
 					auto t = possible_targets[rng::reduce(uint32_t(rng::get_random(state, uint32_t(n.id.index())) >> 2), uint32_t(possible_targets.size()))];
 					if(auto cb = pick_fabrication_type(state, n, t); cb) {
-						n.set_constructing_cb_target(t);
-						n.set_constructing_cb_type(cb);
+						new_targets[index] = t;
+						new_types[index] = cb;
 					}
 				}
 			}
 		}
+	});
+	for(auto n : state.world.in_nation) {
+		if(new_types[n.id.index()]) {
+			n.set_constructing_cb_target(new_targets[n.id.index()]);
+			n.set_constructing_cb_type(new_types[n.id.index()]);
+		}
 	}
 }
 
@@ -2970,18 +3083,21 @@ bool naval_supremacy(sys::state& state, dcon::nation_id n, dcon::nation_id targe
 
 void make_war_decs(sys::state& state) {
 	auto targets = ve::vectorizable_buffer<dcon::nation_id, dcon::nation_id>(state.world.nation_size());
+	// choosing targets doesn't change anything, and the same cb conditions are often tested more than once for a pair
+	std::optional<trigger::scoped_evaluation_memo> memo{ std::in_place };
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 		if(state.world.nation_get_owned_province_count(n) == 0)
 			return;
 		if(state.world.nation_get_is_at_war(n))
 			return;
-		if(state.world.nation_get_is_player_controlled(n))
+		if(state.world.nation_get_is_player_controlled(n) || !state.world.nation_get_ai_is_scheduled(n))
 			return;
 		if(state.world.nation_get_military_score(n) == 0)
 			return;
 		if(auto ol = state.world.nation_get_overlord_as_subject(n); state.world.overlord_get_ruler(ol))
 			return;
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::war_declarations, int32_t(i) };
 		auto base_strength = estimate_strength(state, n);
 		float best_difference = 2.0f;
 		//Great powers should look for non-neighbor nations to use their existing wargoals on; helpful for forcing unification/repay debts wars to happen
@@ -3083,6 +3199,7 @@ void make_war_decs(sys::state& state) {
 			}
 		}
 	});
+	memo.reset();
 	for(auto n : state.world.in_nation) {
 		if(n.get_is_at_war() == false && targets.get(n)) {
 			static std::vector<possible_cb> potential;
@@ -3099,8 +3216,9 @@ void update_budget(sys::state& state) {
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id nid{ dcon::nation_id::value_base_t(i) };
 		auto n = fatten(state.world, nid);
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !n.get_ai_is_scheduled())
 			return;
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::budget, int32_t(i) };
 
 		float base_income = economy::estimate_daily_income(state, n) + n.get_stockpiles(economy::money) / 365.f;
 
@@ -3389,10 +3507,11 @@ void update_ships(sys::state& state) {
 
 void build_ships(sys::state& state) {
 	for(auto n : state.world.in_nation) {
-		if(!n.get_is_player_controlled() && n.get_province_naval_construction().begin() == n.get_province_naval_construction().end()) {
+		if(!n.get_is_player_controlled() && n.get_ai_is_scheduled() && n.get_province_naval_construction().begin() == n.get_province_naval_construction().end()) {
 			auto disarm = n.get_disarmed_until();
 			if(disarm && state.current_date < disarm)
 				continue;
+			sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::build_ships, int32_t(n.id.index()) };
 
 			dcon::unit_type_id best_transport;
 			dcon::unit_type_id best_light;
@@ -3612,7 +3731,7 @@ void send_fleet_home(sys::state& state, dcon::navy_id n, fleet_activity moving_s
 		for(uint32_t i = 0; i < new_size; ++i) {
 			existing_path[i] = naval_path[i];
 		}
-		v.set_arrival_time(military::arrival_time_to(state, v, naval_path.back()));
+		military::set_arrival_time(state, v, military::arrival_time_to(state, v, naval_path.back()));
 		v.set_ai_activity(uint8_t(moving_status));
 	} else {
 		v.set_ai_activity(uint8_t(fleet_activity::unspecified));
@@ -3654,7 +3773,7 @@ bool set_fleet_target(sys::state& state, dcon::nation_id n, dcon::province_id st
 				assert(path[path.size() - 1 - i]);
 				existing_path[new_size - 1 - i] = path[path.size() - 1 - i];
 			}
-			state.world.navy_set_arrival_time(for_navy, military::arrival_time_to(state, for_navy, path.back()));
+			military::set_arrival_time(state, for_navy, military::arrival_time_to(state, for_navy, path.back()));
 			state.world.navy_set_ai_activity(for_navy, uint8_t(fleet_activity::attacking));
 			return true;
 		} else {
@@ -3681,7 +3800,7 @@ void unload_units_from_transport(sys::state& state, dcon::navy_id n) {
 				assert(path[i]);
 				existing_path[i] = path[i];
 			}
-			ar.get_army().set_arrival_time(military::arrival_time_to(state, ar.get_army(), path.back()));
+			military::set_arrival_time(state, ar.get_army(), military::arrival_time_to(state, ar.get_army(), path.back()));
 			ar.get_army().set_dig_in(0);
 			auto activity = army_activity(ar.get_army().get_ai_activity());
 			if(activity == army_activity::transport_guard) {
@@ -3730,6 +3849,23 @@ bool merge_fleet(sys::state& state, dcon::navy_id n, dcon::province_id p, dcon::
 }
 
 void pickup_idle_ships(sys::state& state) {
+	// how many armies of each nation are waiting to be transported, counted the first time a boarding fleet of the nation
+	// asks, instead of every boarding fleet going through all the armies of its owner. Only unloading changes what armies are
+	// waiting, so unloading has the owners of the unloaded armies counted again.
+	static std::vector<int32_t> waiting_for_transport;
+	waiting_for_transport.assign(state.world.nation_size(), -1);
+	auto waiting_armies = [&](dcon::nation_id owner) {
+		auto& count = waiting_for_transport[owner.index()];
+		if(count < 0) {
+			count = 0;
+			for(auto ar : state.world.nation_get_army_control(owner)) {
+				if(ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_guard) || ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_attack))
+					++count;
+			}
+		}
+		return count;
+	};
+
 	for(auto n : state.world.in_navy) {
 		if(n.get_battle_from_navy_battle_participation())
 			continue;
@@ -3740,6 +3876,7 @@ void pickup_idle_ships(sys::state& state) {
 
 		if(!owner || owner.get_is_player_controlled() || owner.get_owned_province_count() == 0)
 			continue;
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::pickup_idle_ships, int32_t(owner.id.index()) };
 
 		auto home_port = state.world.nation_get_ai_home_port(owner);
 		if(!home_port)
@@ -3762,13 +3899,14 @@ void pickup_idle_ships(sys::state& state) {
 			break;
 		case fleet_activity::boarding:
 		{
-			bool all_loaded = true;
-			for(auto ar : state.world.nation_get_army_control(owner)) {
-				if(ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_guard) || ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_attack)) {
-					if(ar.get_army().get_navy_from_army_transport() != n)
-						all_loaded = false;
-				}
+			// everyone is aboard when the waiting armies on this fleet are all the waiting armies there are
+			int32_t aboard = 0;
+			for(auto ar : n.get_army_transport()) {
+				if(ar.get_army().get_controller_from_army_control() == owner
+					&& (ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_guard) || ar.get_army().get_ai_activity() == uint8_t(army_activity::transport_attack)))
+					++aboard;
 			}
+			bool all_loaded = aboard == waiting_armies(owner);
 
 			if(all_loaded) {
 				auto transporting_range = n.get_army_transport();
@@ -3793,10 +3931,10 @@ void pickup_idle_ships(sys::state& state) {
 							existing_path[k] = naval_path[k];
 						}
 						if(new_size > 0) {
-							n.set_arrival_time(military::arrival_time_to(state, n, naval_path.back()));
+							military::set_arrival_time(state, n, military::arrival_time_to(state, n, naval_path.back()));
 							n.set_ai_activity(uint8_t(fleet_activity::transporting));
 						} else {
-							n.set_arrival_time(sys::date{});
+							military::set_arrival_time(state, n, sys::date{});
 							send_fleet_home(state, n);
 						}
 
@@ -3817,10 +3955,10 @@ void pickup_idle_ships(sys::state& state) {
 							existing_path[k] = naval_path[k];
 						}
 						if(new_size > 0) {
-							n.set_arrival_time(military::arrival_time_to(state, n, naval_path.back()));
+							military::set_arrival_time(state, n, military::arrival_time_to(state, n, naval_path.back()));
 							n.set_ai_activity(uint8_t(fleet_activity::transporting));
 						} else {
-							n.set_arrival_time(sys::date{});
+							military::set_arrival_time(state, n, sys::date{});
 							send_fleet_home(state, n);
 						}
 					}
@@ -3829,6 +3967,10 @@ void pickup_idle_ships(sys::state& state) {
 		}
 		break;
 		case fleet_activity::transporting:
+			for(auto ar : n.get_army_transport()) {
+				if(auto c = ar.get_army().get_controller_from_army_control(); c)
+					waiting_for_transport[c.id.index()] = -1;
+			}
 			unload_units_from_transport(state, n);
 			break;
 		case fleet_activity::failed_transport:
@@ -3846,7 +3988,7 @@ void pickup_idle_ships(sys::state& state) {
 						assert(path[i]);
 						existing_path[i] = path[i];
 					}
-					state.world.navy_set_arrival_time(n, military::arrival_time_to(state, n, path.back()));
+					military::set_arrival_time(state, n, military::arrival_time_to(state, n, path.back()));
 				}
 			}
 			break;
@@ -4136,6 +4278,10 @@ void move_idle_guards(sys::state& state) {
 	std::vector<dcon::army_id> require_transport;
 	require_transport.reserve(state.world.army_size());
 
+	static std::vector<dcon::army_id> moving_guards;
+	static std::vector<std::vector<dcon::province_id>> planned_paths;
+	moving_guards.clear();
+
 	for(auto ar : state.world.in_army) {
 		if(ar.get_ai_activity() == uint8_t(army_activity::on_guard)
 			&& ar.get_ai_province()
@@ -4146,23 +4292,39 @@ void move_idle_guards(sys::state& state) {
 			&& !ar.get_battle_from_army_battle_participation()
 			&& !ar.get_navy_from_army_transport()) {
 
-			auto path = ar.get_black_flag() ? province::make_unowned_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province()) : province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar);
-			if(path.size() > 0) {
-				auto existing_path = ar.get_path();
-				auto new_size = uint32_t(path.size());
-				existing_path.resize(new_size);
+			moving_guards.push_back(ar.id);
+		}
+	}
 
-				for(uint32_t i = 0; i < new_size; ++i) {
-					assert(path[i]);
-					existing_path[i] = path[i];
-				}
-				ar.set_arrival_time(military::arrival_time_to(state, ar, path.back()));
-				ar.set_dig_in(0);
-			} else {
-				//Units delegated to the AI won't transport themselves on their own
-				if(!ar.get_controller_from_army_control().get_is_player_controlled())
-					require_transport.push_back(ar.id);
+	/*
+	The path searches only read where units are and who may enter where, neither of which changes until the paths are
+	handed out below. They can therefore be planned for all guards in parallel, and applying them afterwards in army
+	order gives the same result as planning and moving the guards one after another.
+	*/
+	planned_paths.resize(moving_guards.size());
+	concurrency::parallel_for(0, int32_t(moving_guards.size()), [&](int32_t i) {
+		auto ar = fatten(state.world, moving_guards[i]);
+		planned_paths[i] = ar.get_black_flag() ? province::make_unowned_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province()) : province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar);
+	});
+
+	for(uint32_t j = 0; j < moving_guards.size(); ++j) {
+		auto ar = fatten(state.world, moving_guards[j]);
+		auto& path = planned_paths[j];
+		if(path.size() > 0) {
+			auto existing_path = ar.get_path();
+			auto new_size = uint32_t(path.size());
+			existing_path.resize(new_size);
+
+			for(uint32_t i = 0; i < new_size; ++i) {
+				assert(path[i]);
+				existing_path[i] = path[i];
 			}
+			military::set_arrival_time(state, ar, military::arrival_time_to(state, ar, path.back()));
+			ar.set_dig_in(0);
+		} else {
+			//Units delegated to the AI won't transport themselves on their own
+			if(!ar.get_controller_from_army_control().get_is_player_controlled())
+				require_transport.push_back(ar.id);
 		}
 	}
 
@@ -4207,7 +4369,7 @@ void move_idle_guards(sys::state& state) {
 					assert(path[k]);
 					existing_path[k] = path[k];
 				}
-				state.world.army_set_arrival_time(require_transport[i], military::arrival_time_to(state, require_transport[i], path.back()));
+				military::set_arrival_time(state, require_transport[i], military::arrival_time_to(state, require_transport[i], path.back()));
 				state.world.army_set_dig_in(require_transport[i], 0);
 				state.world.army_set_dig_in(require_transport[i], 0);
 			}
@@ -4217,7 +4379,7 @@ void move_idle_guards(sys::state& state) {
 			auto fleet_destination = province::has_naval_access_to_province(state, controller, coastal_target_prov) ? coastal_target_prov : state.world.province_get_port_to(coastal_target_prov);
 			if(fleet_destination == state.world.navy_get_location_from_navy_location(transport_fleet)) {
 				state.world.navy_get_path(transport_fleet).clear();
-				state.world.navy_set_arrival_time(transport_fleet, sys::date{});
+				military::set_arrival_time(state, transport_fleet, sys::date{});
 				state.world.navy_set_ai_activity(transport_fleet, uint8_t(fleet_activity::boarding));
 			} else if(auto fleet_path = province::make_naval_path(state, state.world.navy_get_location_from_navy_location(transport_fleet), fleet_destination); fleet_path.empty()) { // this essentially should be impossible ...
 				continue;
@@ -4230,7 +4392,7 @@ void move_idle_guards(sys::state& state) {
 					assert(fleet_path[k]);
 					existing_path[k] = fleet_path[k];
 				}
-				state.world.navy_set_arrival_time(transport_fleet, military::arrival_time_to(state, transport_fleet, fleet_path.back()));
+				military::set_arrival_time(state, transport_fleet, military::arrival_time_to(state, transport_fleet, fleet_path.back()));
 				state.world.navy_set_ai_activity(transport_fleet, uint8_t(fleet_activity::boarding));
 			}
 		}
@@ -4263,7 +4425,7 @@ void move_idle_guards(sys::state& state) {
 								assert(jpath[k]);
 								existing_path[k] = jpath[k];
 							}
-							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
+							military::set_arrival_time(state, require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
 							state.world.army_set_dig_in(require_transport[j], 0);
 							state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_guard));
 							tcap -= int32_t(jregs.end() - jregs.begin());
@@ -4279,6 +4441,12 @@ void move_idle_guards(sys::state& state) {
 }
 
 void update_naval_transport(sys::state& state) {
+	// the fleet each nation is boarding its armies onto, looked up once per nation rather than once per waiting army; nothing
+	// below changes which fleets are boarding
+	static std::vector<dcon::navy_id> boarding_fleet;
+	static std::vector<uint8_t> boarding_fleet_found;
+	boarding_fleet.assign(state.world.nation_size(), dcon::navy_id{});
+	boarding_fleet_found.assign(state.world.nation_size(), uint8_t(0));
 
 	// set armies to move into transports
 	for(auto ar : state.world.in_army) {
@@ -4292,10 +4460,16 @@ void update_naval_transport(sys::state& state) {
 		if(ar.get_ai_activity() == uint8_t(army_activity::transport_guard) || ar.get_ai_activity() == uint8_t(army_activity::transport_attack)) {
 			auto controller = ar.get_controller_from_army_control();
 			dcon::navy_id transports;
-			for(auto v : controller.get_navy_control()) {
-				if(v.get_navy().get_ai_activity() == uint8_t(fleet_activity::boarding)) {
-					transports = v.get_navy();
+			if(controller) {
+				if(!boarding_fleet_found[controller.id.index()]) {
+					for(auto v : controller.get_navy_control()) {
+						if(v.get_navy().get_ai_activity() == uint8_t(fleet_activity::boarding)) {
+							boarding_fleet[controller.id.index()] = v.get_navy();
+						}
+					}
+					boarding_fleet_found[controller.id.index()] = uint8_t(1);
 				}
+				transports = boarding_fleet[controller.id.index()];
 			}
 			if(!transports) {
 				ar.set_ai_activity(uint8_t(army_activity::on_guard));
@@ -4315,7 +4489,7 @@ void update_naval_transport(sys::state& state) {
 				existing_path.resize(1);
 				assert(transport_location);
 				existing_path[0] = transport_location;
-				ar.set_arrival_time(military::arrival_time_to(state, ar, transport_location));
+				military::set_arrival_time(state, ar, military::arrival_time_to(state, ar, transport_location));
 				ar.set_dig_in(0);
 			} else { // transport arrived in inaccessible location
 				ar.set_ai_activity(uint8_t(army_activity::on_guard));
@@ -4379,7 +4553,7 @@ void gather_to_battle(sys::state& state, dcon::nation_id n, dcon::province_id p)
 			}
 			assert(location);
 			existing_path[0] = location;
-			ar.get_army().set_arrival_time(military::arrival_time_to(state, ar.get_army(), jpath.back()));
+			military::set_arrival_time(state, ar.get_army(), military::arrival_time_to(state, ar.get_army(), jpath.back()));
 			ar.get_army().set_dig_in(0);
 		}
 
@@ -4482,20 +4656,45 @@ float estimate_army_offensive_strength(sys::state& state, dcon::army_id a) {
 	return std::max(0.1f, strength * scale);
 }
 
-float estimate_enemy_defensive_force(sys::state& state, dcon::province_id target, dcon::nation_id by) {
+/*
+The armies that may defend a target against an attack, with their estimated defensive strength. These are gathered once
+for all the nations planning attacks on a given day, instead of walking every army and re-estimating its strength for
+every potential target: nothing in make_attacks moves armies or changes their strength.
+*/
+struct defending_army_field {
+	std::vector<dcon::province_id> locations;
+	std::vector<dcon::nation_id> controllers;
+	std::vector<float> strengths; // as given by estimate_army_defensive_strength
+};
+
+static void make_defending_army_field(sys::state& state, defending_army_field& field) {
+	field.locations.clear();
+	field.controllers.clear();
+	std::vector<dcon::army_id> armies;
+	for(auto ar : state.world.in_army) {
+		if(ar.get_is_retreating() || ar.get_battle_from_army_battle_participation())
+			continue;
+		armies.push_back(ar);
+		field.locations.push_back(ar.get_location_from_army_location());
+		field.controllers.push_back(ar.get_controller_from_army_control());
+	}
+	field.strengths.resize(armies.size());
+	concurrency::parallel_for(0, int32_t(armies.size()), [&](int32_t i) {
+		field.strengths[i] = estimate_army_defensive_strength(state, armies[i]);
+	});
+}
+
+float estimate_enemy_defensive_force(sys::state& state, defending_army_field const& defenders, dcon::province_id target, dcon::nation_id by) {
 	float strength_total = 0.f;
 	if(state.world.nation_get_is_at_war(by)) {
-		for(auto ar : state.world.in_army) {
-			if(ar.get_is_retreating()
-			|| ar.get_battle_from_army_battle_participation()
-			|| ar.get_controller_from_army_control() == by)
+		for(uint32_t i = 0; i < defenders.strengths.size(); ++i) {
+			auto other_nation = defenders.controllers[i];
+			if(other_nation == by)
 				continue;
-			auto loc = ar.get_location_from_army_location();
-			auto sdist = province::sorting_distance(state, loc, target);
+			auto sdist = province::sorting_distance(state, defenders.locations[i], target);
 			if(sdist < state.defines.alice_ai_threat_radius) {
-				auto other_nation = ar.get_controller_from_army_control();
 				if(!other_nation || military::are_at_war(state, other_nation, by)) {
-					strength_total += estimate_army_defensive_strength(state, ar);
+					strength_total += defenders.strengths[i];
 				}
 			}
 		}
@@ -4510,7 +4709,7 @@ float estimate_enemy_defensive_force(sys::state& state, dcon::province_id target
 	return state.defines.alice_ai_offensive_strength_overestimate * strength_total;
 }
 
-void assign_targets(sys::state& state, dcon::nation_id n) {
+void assign_targets(sys::state& state, defending_army_field const& defenders, dcon::nation_id n) {
 	struct a_str {
 		dcon::province_id p;
 		float str = 0.0f;
@@ -4620,12 +4819,14 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 	int32_t min_ready_count = std::min(ready_count, 3); //Atleast 3 attacks
 	int32_t max_attacks_to_make = is_at_war ? std::max(min_ready_count, (ready_count + 1) / 3) : ready_count; // not at war -- allow all stacks to attack rebels
 	auto const psize = potential_targets.size();
+	std::vector<dcon::province_id> gather_sources;
+	province::land_path_field gather_field;
 
 	for(uint32_t i = 0; i < psize && max_attacks_to_make > 0; ++i) {
 		if(!potential_targets[i].location)
 			continue; // target has been removed as too close by some earlier iteration
 		if(potential_targets[i].strength_estimate == 0.0f)
-			potential_targets[i].strength_estimate = estimate_enemy_defensive_force(state, potential_targets[i].location, n) + 0.00001f;
+			potential_targets[i].strength_estimate = estimate_enemy_defensive_force(state, defenders, potential_targets[i].location, n) + 0.00001f;
 
 		auto target_attack_force = potential_targets[i].strength_estimate;
 		std::sort(ready_armies.begin(), ready_armies.end(), [&](a_str const& a, a_str const& b) {
@@ -4690,7 +4891,13 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		if(!central_province)
 			continue;
 
-		// issue safe-move gather command
+		// issue safe-move gather command; every gathering army shares the same destination, so their paths come out of a single search
+		gather_sources.clear();
+		for(int32_t m = int32_t(ready_armies.size()); m-- > k + 1; ) {
+			gather_sources.push_back(ready_armies[m].p);
+		}
+		province::make_safe_land_path_field(state, gather_field, central_province, n, gather_sources);
+
 		for(int32_t m = int32_t(ready_armies.size()); m-- > k + 1; ) {
 			assert(m >= 0 && m < int32_t(ready_armies.size()));
 			for(auto ar : state.world.province_get_army_location(ready_armies[m].p)) {
@@ -4708,7 +4915,7 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 				if(ready_armies[m].p == central_province) {
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
-				} else if(auto path = province::make_safe_land_path(state, ready_armies[m].p, central_province, n); !path.empty()) {
+				} else if(auto path = gather_field.path_from(ready_armies[m].p); !path.empty()) {
 					auto existing_path = ar.get_army().get_path();
 					auto new_size = uint32_t(path.size());
 					existing_path.resize(new_size);
@@ -4717,7 +4924,7 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 						assert(path[q]);
 						existing_path[q] = path[q];
 					}
-					ar.get_army().set_arrival_time(military::arrival_time_to(state, ar.get_army(), path.back()));
+					military::set_arrival_time(state, ar.get_army(), military::arrival_time_to(state, ar.get_army(), path.back()));
 					ar.get_army().set_dig_in(0);
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
@@ -4739,10 +4946,14 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 }
 
 void make_attacks(sys::state& state) {
+	defending_army_field defenders;
+	make_defending_army_field(state, defenders);
+
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 		if(state.world.nation_is_valid(n)) {
-			assign_targets(state, n);
+			sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::assign_targets, int32_t(i) };
+			assign_targets(state, defenders, n);
 		}
 	});
 }
@@ -4751,6 +4962,7 @@ void make_defense(sys::state& state) {
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 		if(state.world.nation_is_valid(n)) {
+			sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::distribute_guards, int32_t(i) };
 			distribute_guards(state, n);
 		}
 	});
@@ -4798,7 +5010,7 @@ void move_gathered_attackers(sys::state& state) {
 								assert(path[i]);
 								existing_path[i] = path[i];
 							}
-							ar.set_arrival_time(military::arrival_time_to(state, ar, path.back()));
+							military::set_arrival_time(state, ar, military::arrival_time_to(state, ar, path.back()));
 							ar.set_dig_in(0);
 						} else {
 							ar.set_ai_activity(uint8_t(army_activity::on_guard));
@@ -4859,7 +5071,7 @@ void move_gathered_attackers(sys::state& state) {
 									assert(path[i]);
 									existing_path[i] = path[i];
 								}
-								o.get_army().set_arrival_time(military::arrival_time_to(state, o.get_army(), path.back()));
+								military::set_arrival_time(state, o.get_army(), military::arrival_time_to(state, o.get_army(), path.back()));
 								o.get_army().set_dig_in(0);
 								o.get_army().set_ai_activity(uint8_t(army_activity::attack_gathered));
 							}
@@ -4924,7 +5136,7 @@ void move_gathered_attackers(sys::state& state) {
 					assert(path[k]);
 					existing_path[k] = path[k];
 				}
-				state.world.army_set_arrival_time(require_transport[i], military::arrival_time_to(state, require_transport[i], path.back()));
+				military::set_arrival_time(state, require_transport[i], military::arrival_time_to(state, require_transport[i], path.back()));
 				state.world.army_set_dig_in(require_transport[i], 0);
 			}
 		}
@@ -4933,7 +5145,7 @@ void move_gathered_attackers(sys::state& state) {
 			auto fleet_destination = province::has_naval_access_to_province(state, controller, coastal_target_prov) ? coastal_target_prov : state.world.province_get_port_to(coastal_target_prov);
 			if(fleet_destination == state.world.navy_get_location_from_navy_location(transport_fleet)) {
 				state.world.navy_get_path(transport_fleet).clear();
-				state.world.navy_set_arrival_time(transport_fleet, sys::date{});
+				military::set_arrival_time(state, transport_fleet, sys::date{});
 				state.world.navy_set_ai_activity(transport_fleet, uint8_t(fleet_activity::boarding));
 			} else if(auto fleet_path = province::make_naval_path(state, state.world.navy_get_location_from_navy_location(transport_fleet), fleet_destination); fleet_path.empty()) {
 				continue;
@@ -4946,7 +5158,7 @@ void move_gathered_attackers(sys::state& state) {
 					assert(fleet_path[k]);
 					existing_path[k] = fleet_path[k];
 				}
-				state.world.navy_set_arrival_time(transport_fleet, military::arrival_time_to(state, transport_fleet, fleet_path.back()));
+				military::set_arrival_time(state, transport_fleet, military::arrival_time_to(state, transport_fleet, fleet_path.back()));
 				state.world.navy_set_ai_activity(transport_fleet, uint8_t(fleet_activity::boarding));
 			}
 		}
@@ -4979,7 +5191,7 @@ void move_gathered_attackers(sys::state& state) {
 								assert(jpath[k]);
 								existing_path[k] = jpath[k];
 							}
-							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
+							military::set_arrival_time(state, require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
 							state.world.army_set_dig_in(require_transport[j], 0);
 							state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_attack));
 							tcap -= int32_t(jregs.end() - jregs.begin());
@@ -4996,11 +5208,12 @@ void move_gathered_attackers(sys::state& state) {
 
 void update_land_constructions(sys::state& state) {
 	for(auto n : state.world.in_nation) {
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !n.get_ai_is_scheduled())
 			continue;
 		auto disarm = n.get_disarmed_until();
 		if(disarm && state.current_date < disarm)
 			continue;
+		sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::land_constructions, int32_t(n.id.index()) };
 
 		static std::vector<dcon::province_land_construction_id> hopeless_construction;
 		hopeless_construction.clear();
@@ -5138,6 +5351,7 @@ void new_units_and_merging(sys::state& state) {
 			&& !ar.get_battle_from_army_battle_participation()
 			&& !ar.get_navy_from_army_transport()
 			&& !ar.get_arrival_time()) {
+			sys::scoped_ai_timer timer{ state.ai_timings, sys::ai_profiler::task::new_units_and_merging, int32_t(controller.id.index()) };
 
 			auto location = ar.get_location_from_army_location();
 
@@ -5193,7 +5407,7 @@ void new_units_and_merging(sys::state& state) {
 								assert(path[i]);
 								existing_path[i] = path[i];
 							}
-							ar.set_arrival_time(military::arrival_time_to(state, ar, path.back()));
+							military::set_arrival_time(state, ar, military::arrival_time_to(state, ar, path.back()));
 							ar.set_dig_in(0);
 							ar.set_ai_province(target_location);
 							ar.set_ai_activity(uint8_t(army_activity::merging));
@@ -5244,6 +5458,9 @@ void general_ai_unit_tick(sys::state& state) {
 	auto v = state.current_date.value;
 	auto r = v % 8;
 
+	// only units are moved around below, so who may go where stays fixed
+	province::scoped_land_access_cache access_cache{ state };
+
 	switch(r) {
 	case 0:
 		pickup_idle_ships(state);
@@ -5271,6 +5488,66 @@ void general_ai_unit_tick(sys::state& state) {
 	}
 }
 
+// Roughly how much work planning for a nation is, in units that are the same on every machine: the monthly plans walk the
+// provinces of the nation and then do a fixed amount of work besides. The scheduler cannot use measured times, as the
+// nations picked on a day have to be the same in every game of a multiplayer session.
+int32_t ai_planning_cost(sys::state& state, dcon::nation_id n) {
+	return 8 + int32_t(state.world.nation_get_owned_province_count(n));
+}
+
+void schedule_ai_planning(sys::state& state) {
+	static std::vector<dcon::nation_id> candidates;
+	candidates.clear();
+
+	int64_t total_cost = 0;
+	for(auto n : state.world.in_nation) {
+		n.set_ai_is_scheduled(false);
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+			continue;
+		candidates.push_back(n);
+		total_cost += ai_planning_cost(state, n);
+	}
+	if(candidates.empty())
+		return;
+
+	// the longest waiting first (nations that have never been planned for have a last_planned of 0); ties go to the lower id
+	std::sort(candidates.begin(), candidates.end(), [&](dcon::nation_id a, dcon::nation_id b) {
+		auto la = state.world.nation_get_ai_last_planned(a);
+		auto lb = state.world.nation_get_ai_last_planned(b);
+		if(la != lb)
+			return la < lb;
+		return a.index() < b.index();
+	});
+
+	// enough for every nation to be planned for once per period; whoever does not fit today is a day staler tomorrow, and so
+	// comes earlier in the order
+	auto period = int64_t(std::max(state.defines.alice_ai_planning_period, 1.0f));
+	auto budget = (total_cost + period - 1) / period;
+	int64_t spent = 0;
+	for(auto n : candidates) {
+		if(spent >= budget)
+			break;
+		state.world.nation_set_ai_is_scheduled(n, true);
+		state.world.nation_set_ai_last_planned(n, state.current_date);
+		spent += ai_planning_cost(state, n);
+	}
+}
+
+void schedule_all_ai_planning(sys::state& state) {
+	for(auto n : state.world.in_nation)
+		n.set_ai_is_scheduled(!n.get_is_player_controlled() && n.get_owned_province_count() != 0);
+}
+
+void update_ai_planning(sys::state& state) {
+	schedule_ai_planning(state);
+	update_ai_research(state);
+	build_ships(state);
+	update_land_constructions(state);
+	update_ai_econ_construction(state);
+	update_budget(state);
+	make_war_decs(state);
+}
+
 float estimate_rebel_strength(sys::state& state, dcon::province_id p) {
 	float v = 0.f;
 	for(auto ar : state.world.province_get_army_location(p))
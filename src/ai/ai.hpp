@@ -55,6 +55,16 @@ void make_attacks(sys::state& state);
 void make_defense(sys::state& state);
 void general_ai_unit_tick(sys::state& state);
 
+// The per-nation monthly plans (research, ship and land unit construction, economic construction, the budget and war
+// declarations) only run for the nations scheduled for the day, so that their cost is spread evenly over the month instead
+// of landing on a handful of days. schedule_ai_planning picks the nations that have waited longest, up to a share of the
+// estimated total work that gets every nation planned for once per alice_ai_planning_period days.
+void schedule_ai_planning(sys::state& state);
+// schedules every ai nation at once, for running the plans outside of the daily tick
+void schedule_all_ai_planning(sys::state& state);
+// schedule_ai_planning followed by the plans themselves
+void update_ai_planning(sys::state& state);
+
 bool will_accept_peace_offer_value(sys::state& state,
 	dcon::nation_id n, dcon::nation_id from,
 	dcon::nation_id prime_attacker, dcon::nation_id prime_defender,
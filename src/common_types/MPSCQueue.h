@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace sys {
+
+// A bounded, lock free queue that any number of threads may push to, but that only a single thread may consume. It has
+// the interface of rigtorp::SPSCQueue (push, try_push, front, pop), so that it can stand in for one wherever commands are
+// issued from more than one thread. Each slot carries a sequence number (after Dmitry Vyukov's bounded queue): a producer
+// claims a position by advancing the tail and publishes its element by bumping the slot's sequence, and the consumer only
+// looks at a slot once that has happened.
+template<typename T>
+class MPSCQueue {
+public:
+	explicit MPSCQueue(size_t capacity) {
+		size_t size = 2;
+		while(size < capacity)
+			size *= 2;
+		mask = size - 1;
+		slots = std::unique_ptr<slot[]>(new slot[size]);
+		for(size_t i = 0; i < size; ++i)
+			slots[i].sequence.store(i, std::memory_order::relaxed);
+	}
+	MPSCQueue(MPSCQueue const&) = delete;
+	MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+	// safe to call from any thread; returns false if the queue is full
+	bool try_push(T const& v) noexcept {
+		size_t position = tail.load(std::memory_order::relaxed);
+		slot* s = nullptr;
+		while(true) {
+			s = &slots[position & mask];
+			auto sequence = s->sequence.load(std::memory_order::acquire);
+			auto difference = intptr_t(sequence) - intptr_t(position);
+			if(difference == 0) {
+				if(tail.compare_exchange_weak(position, position + 1, std::memory_order::relaxed))
+					break;
+			} else if(difference < 0) {
+				return false; // the consumer has not yet freed this slot from the previous lap
+			} else {
+				position = tail.load(std::memory_order::relaxed);
+			}
+		}
+		s->value = v;
+		s->sequence.store(position + 1, std::memory_order::release);
+		return true;
+	}
+
+	// safe to call from any thread; waits for the consumer to free a slot if the queue is full
+	void push(T const& v) noexcept {
+		while(!try_push(v))
+			std::this_thread::yield();
+	}
+
+	// consumer only
+	T* front() noexcept {
+		auto& s = slots[head & mask];
+		if(s.sequence.load(std::memory_order::acquire) != head + 1)
+			return nullptr;
+		return &s.value;
+	}
+	// consumer only, after front has returned an element
+	void pop() noexcept {
+		auto& s = slots[head & mask];
+		assert(s.sequence.load(std::memory_order::relaxed) == head + 1);
+		s.sequence.store(head + mask + 1, std::memory_order::release);
+		++head;
+	}
+
+private:
+	struct slot {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<slot[]> slots;
+	size_t mask = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+	alignas(64) size_t head = 0;
+};
+
+} // namespace sys
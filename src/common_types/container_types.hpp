@@ -278,7 +278,7 @@ struct checksum_key {
 	static constexpr uint32_t key_size = 64;
 	uint8_t key[key_size] = { 0 };
 
-	bool is_equal(const checksum_key& a) noexcept {
+	bool is_equal(const checksum_key& a) const noexcept {
 		for(size_t i = 0; i < key_size; i++)
 			if(key[i] != a.key[i])
 				return false;
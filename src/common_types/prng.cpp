@@ -2,6 +2,7 @@
 #include "system_state.hpp"
 
 #include "random123/philox.h"
+#include <algorithm>
 
 namespace rng {
 
@@ -43,6 +44,46 @@ random_pair get_random_pair(sys::state const& state, uint32_t value_in_hi, uint3
 
 	return random_pair{(uint64_t(r[0]) << 32) | uint64_t(r[1]), (uint64_t(r[2]) << 32) | uint64_t(r[3])};
 }
+void get_random_batch(sys::state const& state, uint32_t const* values_in, uint64_t* results_out, uint32_t count) {
+	// Philox4x32-10, as in random123/philox.h, but with the counter words of a block of values held in separate arrays so that
+	// each step of a round is one loop over the block that the compiler can vectorize. Only the first two output words are
+	// needed for get_random, but all four words feed the next round.
+	constexpr uint32_t block = 16;
+	uint32_t c0[block];
+	uint32_t c1[block];
+	uint32_t c2[block];
+	uint32_t c3[block];
+
+	for(uint32_t start = 0; start < count; start += block) {
+		uint32_t const n = std::min(block, count - start);
+		for(uint32_t i = 0; i < block; ++i) {
+			c0[i] = state.current_date.value;
+			c1[i] = i < n ? values_in[start + i] : 0;
+			c2[i] = 0;
+			c3[i] = 0;
+		}
+		uint32_t k0 = state.game_seed;
+		uint32_t k1 = 0x3918CA23;
+		for(int32_t round = 0; round < 10; ++round) {
+			if(round != 0) {
+				k0 += PHILOX_W32_0;
+				k1 += PHILOX_W32_1;
+			}
+			for(uint32_t i = 0; i < block; ++i) {
+				uint64_t p0 = uint64_t(PHILOX_M4x32_0) * uint64_t(c0[i]);
+				uint64_t p1 = uint64_t(PHILOX_M4x32_1) * uint64_t(c2[i]);
+				uint32_t n0 = uint32_t(p1 >> 32) ^ c1[i] ^ k0;
+				uint32_t n2 = uint32_t(p0 >> 32) ^ c3[i] ^ k1;
+				c1[i] = uint32_t(p1);
+				c3[i] = uint32_t(p0);
+				c0[i] = n0;
+				c2[i] = n2;
+			}
+		}
+		for(uint32_t i = 0; i < n; ++i)
+			results_out[start + i] = (uint64_t(c0[i]) << 32) | uint64_t(c1[i]);
+	}
+}
 uint32_t reduce(uint32_t value_in, uint32_t upper_bound) {
 	return uint32_t((uint64_t(value_in) * uint64_t(upper_bound)) >> 32);
 }
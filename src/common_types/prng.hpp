@@ -15,6 +15,9 @@ uint64_t get_random(sys::state const& state, uint32_t value_in);			 // try to po
 random_pair get_random_pair(sys::state const& state, uint32_t value_in);	// each call natively generates 128 random bits anyways
 uint64_t get_random(sys::state const& state, uint32_t value_in_hi, uint32_t value_in_lo);
 random_pair get_random_pair(sys::state const& state, uint32_t value_in_hi, uint32_t value_in_lo);
+// fills results_out[i] with get_random(state, values_in[i]) for each of the count values, working through them a block
+// at a time so that the rounds can be computed for several values at once
+void get_random_batch(sys::state const& state, uint32_t const* values_in, uint64_t* results_out, uint32_t count);
 uint32_t reduce(uint32_t value_in, uint32_t upper_bound);
 
 } // namespace rng
@@ -979,66 +979,55 @@ void discover_inventions(sys::state& state) {
 	discovered, the discoverer gains that amount of shared prestige / the number of times it has been discovered (including the
 	current time).
 	*/
+
+	/*
+	the limits and chances of the inventions are independent of each other, so they are evaluated in parallel against the state
+	as it was at the start of the month. The discoveries themselves change prestige, modifiers and the shared prestige counter,
+	so they are applied afterwards, serially and in invention order
+	*/
+	static std::vector<std::vector<dcon::nation_id>> discoveries;
+	discoveries.resize(state.world.invention_size());
+
+	concurrency::parallel_for(uint32_t(0), state.world.invention_size(), [&](uint32_t i) {
+		dcon::invention_id inv{ dcon::invention_id::value_base_t(i) };
+		auto& discovered_by = discoveries[i];
+		discovered_by.clear();
+
+		auto lim = state.world.invention_get_limit(inv);
+		auto odds = state.world.invention_get_chance(inv);
+		ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
+			auto may_discover = !state.world.nation_get_active_inventions(nids, inv)
+				&& (state.world.nation_get_owned_province_count(nids) != 0);
+			if(lim && ve::compress_mask(may_discover).v != 0)
+				may_discover = may_discover && trigger::evaluate(state, lim, trigger::to_generic(nids), trigger::to_generic(nids), 0);
+
+			if(ve::compress_mask(may_discover).v != 0) {
+				auto chances = odds
+					? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
+					: 1.f;
+				ve::apply([&](dcon::nation_id n, float chance, bool allow_discovery) {
+					if(allow_discovery) {
+						auto random = rng::get_random(state, uint32_t(inv.index()) << 5 ^ uint32_t(n.index()));
+						if(int32_t(random % 100) < int32_t(chance))
+							discovered_by.push_back(n);
+					}
+				}, nids, chances, may_discover);
+			}
+		});
+	});
+
 	for(auto inv : state.world.in_invention) {
-		auto lim = inv.get_limit();
-		auto odds = inv.get_chance();
-		if(lim) {
-			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
-				auto may_discover = !state.world.nation_get_active_inventions(nids, inv)
-					&& (state.world.nation_get_owned_province_count(nids) != 0)
-					&& trigger::evaluate(state, lim, trigger::to_generic(nids), trigger::to_generic(nids), 0);
-
-				if(ve::compress_mask(may_discover).v != 0) {
-					auto chances = odds
-						? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
-						: 1.f;
-					ve::apply([&](dcon::nation_id n, float chance, bool allow_discovery) {
-						if(allow_discovery) {
-							auto random = rng::get_random(state, uint32_t(inv.id.index()) << 5 ^ uint32_t(n.index()));
-							if(int32_t(random % 100) < int32_t(chance)) {
-								apply_invention(state, n, inv);
-
-								notification::post(state, notification::message{
-									[inv](sys::state& state, text::layout_base& contents) {
-										text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
-										ui::invention_description(state, contents, inv, 0);
-									},
-									"msg_inv_title",
-									n, dcon::nation_id{}, dcon::nation_id{},
-									sys::message_base_type::invention
-								});
-							}
-						}
-					}, nids, chances, may_discover);
-				}
-			});
-		} else {
-			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
-				auto may_not_discover =
-						state.world.nation_get_active_inventions(nids, inv) || (state.world.nation_get_owned_province_count(nids) == 0);
-				if(ve::compress_mask(may_not_discover).v != 0) {
-					auto chances = odds
-						? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
-						: 1.f;
-					ve::apply([&](dcon::nation_id n, float chance, bool block_discovery) {
-						if(!block_discovery) {
-							auto random = rng::get_random(state, uint32_t(inv.id.index()) << 5 ^ uint32_t(n.index()));
-							if(int32_t(random % 100) < int32_t(chance)) {
-								apply_invention(state, n, inv);
-
-								notification::post(state, notification::message{
-									[inv](sys::state& state, text::layout_base& contents) {
-										text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
-										ui::invention_description(state, contents, inv, 0);
-									},
-									"msg_inv_title",
-									n, dcon::nation_id{}, dcon::nation_id{},
-									sys::message_base_type::invention
-								});
-							}
-						}
-					}, nids, chances, may_not_discover);
-				}
+		for(auto n : discoveries[inv.id.index()]) {
+			apply_invention(state, n, inv);
+
+			notification::post(state, notification::message{
+				[inv = inv.id](sys::state& state, text::layout_base& contents) {
+					text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
+					ui::invention_description(state, contents, inv, 0);
+				},
+				"msg_inv_title",
+				n, dcon::nation_id{}, dcon::nation_id{},
+				sys::message_base_type::invention
 			});
 		}
 	}
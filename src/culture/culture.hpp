@@ -174,6 +174,19 @@ struct global_cultural_state {
 	uint64_t conversion_chance_fn = 0;
 };
 
+// population weighted averages of the estimated daily pop changes of one nation, as shown in the top bar tooltips; computed
+// on demand by demographics::get_estimated_changes and dropped whenever the game state changes
+struct estimated_pop_changes {
+	float militancy = 0.0f;
+	float consciousness = 0.0f;
+	float literacy = 0.0f;
+};
+struct estimated_pop_change_cache {
+	estimated_pop_changes values;
+	dcon::nation_id nation;
+	bool valid = false;
+};
+
 enum class issue_category : uint8_t { party, political, social, military, economic };
 
 enum class rebel_area : uint8_t { none = 0, nation, culture, nation_culture, nation_religion, religion, culture_group, all };
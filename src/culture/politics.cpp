@@ -10,14 +10,12 @@ namespace politics {
 
 float vote_total(sys::state& state, dcon::nation_id nation) {
 	float total = 0.f;
-	state.world.for_each_province([&](dcon::province_id province) {
-		if(nation == state.world.province_get_nation_from_province_ownership(province)) {
-			for(auto pop_loc : state.world.province_get_pop_location(province)) {
-				auto pop_id = pop_loc.get_pop();
-				total += pop_vote_weight(state, pop_id, nation);
-			}
+	for(auto province : state.world.nation_get_province_ownership(nation)) {
+		for(auto pop_loc : province.get_province().get_pop_location()) {
+			auto pop_id = pop_loc.get_pop();
+			total += pop_vote_weight(state, pop_id, nation);
 		}
-	});
+	}
 	return total;
 }
 
@@ -48,6 +46,31 @@ float get_voter_support(sys::state& state, dcon::nation_id nation, dcon::issue_o
 	return support / total;
 }
 
+std::vector<float> get_all_voter_support(sys::state& state, dcon::nation_id nation) {
+	std::vector<float> support(state.world.issue_option_size(), 0.f);
+	auto total = 0.f;
+	for(auto province : state.world.nation_get_province_ownership(nation)) {
+		for(auto pop_loc : province.get_province().get_pop_location()) {
+			auto pop_id = pop_loc.get_pop();
+			auto vote_size = pop_vote_weight(state, pop_id, nation);
+			if(vote_size <= 0.f)
+				continue;
+			total += vote_size;
+			for(uint32_t i = 0; i < support.size(); ++i) {
+				dcon::issue_option_id opt{ dcon::issue_option_id::value_base_t(i) };
+				support[i] += vote_size * pop_demographics::get_demo(state, pop_id.id, pop_demographics::to_key(state, opt));
+			}
+		}
+	}
+	if(total <= 0.f) {
+		std::fill(support.begin(), support.end(), 0.f);
+	} else {
+		for(auto& s : support)
+			s /= total;
+	}
+	return support;
+}
+
 bool can_appoint_ruling_party(sys::state& state, dcon::nation_id nation) {
 	return  dcon::fatten(state.world, nation).get_government_type().get_can_appoint_ruling_party();
 }
@@ -306,8 +329,7 @@ void set_ruling_party(sys::state& state, dcon::nation_id n, dcon::political_part
 		state.world.nation_set_issues(n, pi, state.world.political_party_get_party_issues(p, pi));
 	}
 	culture::update_nation_issue_rules(state, n);
-	sys::update_single_nation_modifiers(state, n);
-	economy::bound_budget_settings(state, n);
+	sys::update_nation_modifiers_soon(state, n);
 	if(auto rules = state.world.nation_get_combined_issue_rules(n); (rules & issue_rule::factory_priority) == 0) {
 		for(auto po : state.world.nation_get_province_ownership_as_nation(n)) {
 			for(auto fl : po.get_province().get_factory_location()) {
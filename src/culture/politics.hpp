@@ -11,6 +11,8 @@ float vote_total(sys::state& state, dcon::nation_id nation);
 float pop_vote_weight(sys::state& state, dcon::pop_id p, dcon::nation_id n);
 float get_popular_support(sys::state& state, dcon::nation_id nation, dcon::issue_option_id issue_option);
 float get_voter_support(sys::state& state, dcon::nation_id nation, dcon::issue_option_id issue_option);
+// the voter support of every issue option, indexed by issue option, from a single pass over the pops of the nation
+std::vector<float> get_all_voter_support(sys::state& state, dcon::nation_id nation);
 
 bool can_appoint_ruling_party(sys::state& state, dcon::nation_id nation);
 bool is_election_ongoing(sys::state& state, dcon::nation_id nation);
@@ -191,7 +191,61 @@ bool movement_is_valid(sys::state& state, dcon::movement_id m) {
 	return false;
 }
 
+// picks the issue a pop without a movement would join a movement for, if any. This only reads the state, so it can be done
+// for all pops in parallel ahead of the membership changes: those never alter the inputs of another pop's choice
+dcon::issue_option_id choose_movement_issue(sys::state& state, dcon::pop_id p, dcon::nation_id owner) {
+	auto con = pop_demographics::get_consciousness(state, p);
+	auto lit = pop_demographics::get_literacy(state, p);
+	dcon::issue_option_id max_option;
+	float max_support = 0;
+	state.world.for_each_issue_option([&](dcon::issue_option_id io) {
+		auto parent = state.world.issue_option_get_parent_issue(io);
+		auto co = state.world.nation_get_issues(owner, parent);
+		auto allow = state.world.issue_option_get_allow(io);
+		if(co != io && (state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::social) || state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::political))) { // filter out currently active issue
+			auto sup = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, io));
+			if(sup * 100.0f >= state.defines.issue_movement_join_limit && sup > max_support) { // filter out -- above limit thersholds
+				/*
+				then the pop has a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy + issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
+				*/
+
+				// probability test
+				auto fp_prob = 9.0f * sup * (state.defines.movement_lit_factor * lit + state.defines.movement_con_factor * con);
+				auto rvalue = float(uint32_t(rng::get_random(state, (p.value << 3) ^ io.index()) & 0xFFFF)) / float(0x10000);
+				if(rvalue < fp_prob) {
+
+					// is this issue possible to get by law?
+					if(state.world.issue_get_is_next_step_only(parent) == false || co.id.index() + 1 == io.index() || co.id.index() - 1 == io.index()) {
+
+						max_option = io;
+						max_support = sup;
+					}
+				}
+			}
+		}
+	});
+	return max_option;
+}
+
 void update_pop_movement_membership(sys::state& state) {
+	static std::vector<dcon::issue_option_id> movement_choices;
+	movement_choices.resize(state.world.pop_size());
+	concurrency::parallel_for(uint32_t(0), state.world.pop_size(), [&](uint32_t i) {
+		dcon::pop_id p{ dcon::pop_id::value_base_t(i) };
+		movement_choices[i] = dcon::issue_option_id{};
+		// the same conditions the serial pass below checks before a pop may join a new issue movement
+		auto owner = nations::owner_of_pop(state, p);
+		if(!owner
+			|| state.world.pop_get_poptype(p) == state.culture_definitions.slaves
+			|| state.world.pop_get_rebel_faction_from_pop_rebellion_membership(p)
+			|| state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p))
+			|| state.world.pop_get_movement_from_pop_movement_membership(p)
+			|| pop_demographics::get_militancy(state, p) >= state.defines.mil_to_join_rebel)
+			return;
+		if(pop_demographics::get_consciousness(state, p) >= 1.5f || pop_demographics::get_literacy(state, p) >= 0.25f)
+			movement_choices[i] = choose_movement_issue(state, p, owner);
+	});
+
 	state.world.for_each_pop([&](dcon::pop_id p) {
 		auto owner = nations::owner_of_pop(state, p);
 		// pops not in a nation can't be in a movement
@@ -249,34 +303,7 @@ void update_pop_movement_membership(sys::state& state) {
 			a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy
 			+ issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
 			*/
-			dcon::issue_option_id max_option;
-			float max_support = 0;
-			state.world.for_each_issue_option([&](dcon::issue_option_id io) {
-				auto parent = state.world.issue_option_get_parent_issue(io);
-				auto co = state.world.nation_get_issues(owner, parent);
-				auto allow = state.world.issue_option_get_allow(io);
-				if(co != io && (state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::social) || state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::political))) { // filter out currently active issue
-					auto sup = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, io));
-					if(sup * 100.0f >= state.defines.issue_movement_join_limit && sup > max_support) { // filter out -- above limit thersholds
-						/*
-						then the pop has a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy + issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
-						*/
-
-						// probability test
-						auto fp_prob = 9.0f * sup * (state.defines.movement_lit_factor * lit + state.defines.movement_con_factor * con);
-						auto rvalue = float(uint32_t(rng::get_random(state, (p.value << 3) ^ io.index()) & 0xFFFF)) / float(0x10000);
-						if(rvalue < fp_prob) {
-
-							// is this issue possible to get by law?
-							if(state.world.issue_get_is_next_step_only(parent) == false || co.id.index() + 1 == io.index() || co.id.index() - 1 == io.index()) {
-
-								max_option = io;
-								max_support = sup;
-							}
-						}
-					}
-				}
-			});
+			dcon::issue_option_id max_option = movement_choices[p.index()];
 			if(max_option) {
 				if(auto m = get_movement_by_position(state, owner, max_option); m) {
 					add_pop_to_movement(state, p, m);
@@ -806,6 +833,24 @@ void sort_hunting_targets(sys::state& state, impl::arm_str const& ar, std::vecto
 }
 
 void rebel_hunting_check(sys::state& state) {
+	// Where the rebels are does not change while the hunters are being sent after them, so the targets of each nation are
+	// found once, up front and in parallel, instead of once for every faction within it.
+	static std::vector<dcon::nation_id> hunting_nations;
+	static std::vector<std::vector<impl::prov_str>> hunting_targets;
+	hunting_nations.clear();
+	for(auto rf : state.world.in_rebel_faction) {
+		auto const faction_owner = rf.get_ruler_from_rebellion_within();
+		if(faction_owner.get_is_player_controlled())
+			hunting_nations.push_back(faction_owner.id);
+	}
+	std::sort(hunting_nations.begin(), hunting_nations.end());
+	hunting_nations.erase(std::unique(hunting_nations.begin(), hunting_nations.end()), hunting_nations.end());
+	hunting_targets.resize(hunting_nations.size());
+	concurrency::parallel_for(uint32_t(0), uint32_t(hunting_nations.size()), [&](uint32_t i) {
+		hunting_targets[i].clear();
+		get_hunting_targets(state, hunting_nations[i], hunting_targets[i]);
+	});
+
 	for(auto rf : state.world.in_rebel_faction) {
 		auto const faction_owner = rf.get_ruler_from_rebellion_within();
 		// rebel hunting logic
@@ -825,8 +870,8 @@ void rebel_hunting_check(sys::state& state) {
 			}
 
 			static std::vector<impl::prov_str> rebel_provs;
-			rebel_provs.clear();
-			get_hunting_targets(state, faction_owner.id, rebel_provs);
+			auto nation_index = std::lower_bound(hunting_nations.begin(), hunting_nations.end(), faction_owner.id) - hunting_nations.begin();
+			rebel_provs = hunting_targets[nation_index];
 
 			while(rebel_provs.size() > 0 && rebel_hunters.size() > 0) {
 				auto rh = rebel_hunters[0];
@@ -850,7 +895,7 @@ void rebel_hunting_check(sys::state& state) {
 					auto a = rebel_hunters[i].a;
 					if(state.world.army_get_location_from_army_location(a) == closest_prov) {
 						state.world.army_get_path(a).clear();
-						state.world.army_set_arrival_time(a, sys::date{});
+						military::set_arrival_time(state, a, sys::date{});
 
 						rebel_hunters[i] = rebel_hunters.back();
 						rebel_hunters.pop_back();
@@ -862,7 +907,7 @@ void rebel_hunting_check(sys::state& state) {
 						for(uint32_t j = 0; j < new_size; j++) {
 							existing_path.at(j) = path[j];
 						}
-						state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+						military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 						state.world.army_set_dig_in(a, 0);
 
 						rebel_hunters[i] = rebel_hunters.back();
@@ -891,7 +936,7 @@ void rebel_hunting_check(sys::state& state) {
 				for(uint32_t j = 0; j < new_size; j++) {
 					existing_path.at(j) = path[j];
 				}
-				state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+				military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 				state.world.army_set_dig_in(a, 0);
 			} else {
 				state.world.army_set_ai_province(a, state.world.army_get_location_from_army_location(a));
@@ -906,16 +951,26 @@ void rebel_risings_check(sys::state& state) {
 	static std::vector<dcon::army_id> new_armies;
 	new_armies.clear();
 
-	for(auto rf : state.world.in_rebel_faction) {
+	// A faction rising only adds to its own armies, so whether (and how far) each of them rises can be decided for all of them
+	// at once; the regiments are then raised in faction order.
+	static std::vector<int32_t> regiments_to_raise;
+	regiments_to_raise.assign(state.world.rebel_faction_size(), 0);
+	concurrency::parallel_for(uint32_t(0), state.world.rebel_faction_size(), [&](uint32_t i) {
+		dcon::rebel_faction_id rf{ dcon::rebel_faction_id::value_base_t(i) };
+		if(!state.world.rebel_faction_is_valid(rf))
+			return;
 		auto revolt_chance = get_faction_revolt_risk(state, rf);
-		auto rval = rng::get_random(state, uint32_t(rf.id.value));
+		auto rval = rng::get_random(state, uint32_t(rf.value));
 		float p_val = float(rval & 0xFFFF) / float(0x10000);
-		if(p_val < revolt_chance) {
+		if(p_val < revolt_chance)
+			regiments_to_raise[i] = int32_t(float(get_faction_brigades_ready(state, rf)) * rebel_size_reduction);
+	});
+
+	for(auto rf : state.world.in_rebel_faction) {
+		auto const new_to_make = regiments_to_raise[rf.id.index()];
+		if(new_to_make > 0) {
 			auto const faction_owner = rf.get_ruler_from_rebellion_within();
-			auto const new_to_make = int32_t(float(get_faction_brigades_ready(state, rf)) * rebel_size_reduction);
 			auto counter = new_to_make;
-			if(new_to_make == 0)
-				continue;
 
 			/*
 			- When a rising happens, pops with at least define:MILITANCY_TO_JOIN_RISING will spawn faction-organization x
@@ -1180,14 +1235,29 @@ float get_suppression_point_cost(sys::state& state, dcon::movement_id m) {
 }
 
 void execute_rebel_victories(sys::state& state) {
-	for(uint32_t i = state.world.rebel_faction_size(); i-- > 0;) {
-		auto reb = dcon::rebel_faction_id{dcon::rebel_faction_id::value_base_t(i)};
+	auto demands_enforced = [&](dcon::rebel_faction_id reb) {
 		auto within = state.world.rebel_faction_get_ruler_from_rebellion_within(reb);
 		auto is_active = get_faction_brigades_active(state, reb) > 0;
 		auto enforce_trigger = state.world.rebel_faction_get_type(reb).get_demands_enforced_trigger();
-		if(is_active && enforce_trigger &&
+		return is_active && enforce_trigger &&
 				trigger::evaluate(state, enforce_trigger, trigger::to_generic(within), trigger::to_generic(within),
-						trigger::to_generic(reb))) {
+						trigger::to_generic(reb));
+	};
+
+	// Victories are rare, so the triggers are evaluated for every faction in parallel ahead of time. Those results only hold
+	// until the first victory changes the world; the factions after it are evaluated again as they come up.
+	static std::vector<uint8_t> enforced;
+	enforced.assign(state.world.rebel_faction_size(), 0);
+	concurrency::parallel_for(uint32_t(0), state.world.rebel_faction_size(), [&](uint32_t i) {
+		enforced[i] = demands_enforced(dcon::rebel_faction_id{ dcon::rebel_faction_id::value_base_t(i) }) ? 1 : 0;
+	});
+
+	bool any_victory = false;
+	for(uint32_t i = state.world.rebel_faction_size(); i-- > 0;) {
+		auto reb = dcon::rebel_faction_id{dcon::rebel_faction_id::value_base_t(i)};
+		auto within = state.world.rebel_faction_get_ruler_from_rebellion_within(reb);
+		if(any_victory ? demands_enforced(reb) : enforced[i] != 0) {
+			any_victory = true;
 			// rebel victory
 
 			/*
@@ -1380,7 +1450,7 @@ void update_armies(sys::state& state) {
 		if(best_prov != location) {
 			ar.get_path().resize(1);
 			ar.get_path()[0] = best_prov;
-			ar.set_arrival_time(military::arrival_time_to(state, ar.id, best_prov));
+			military::set_arrival_time(state, ar, military::arrival_time_to(state, ar.id, best_prov));
 			ar.set_dig_in(0);
 			ar.set_is_rebel_hunter(false);
 		}
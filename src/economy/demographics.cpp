@@ -136,6 +136,10 @@ void set_political_reform_desire(sys::state& state, dcon::pop_id p, float v) {
 } // namespace pop_demographics
 namespace demographics {
 
+void tick_buffers_deleter::operator()(tick_buffers* p) const noexcept {
+	delete p;
+}
+
 inline constexpr float small_pop_size = 100.0f;
 
 dcon::demographics_key to_key(sys::state const& state, dcon::pop_type_id v) {
@@ -167,60 +171,207 @@ uint32_t common_size(sys::state const& state) {
 	return count_special_keys + uint32_t(2) * state.world.pop_type_size();
 }
 
+inline constexpr uint32_t extra_demo_grouping = 8;
+
+/*
+Every demographic key of a province is a sum over the pops located there. Rather than walking all of the pops once per
+key, the pops are bucketed by province once, and each province then reads each of its pops a single time and adds it to
+every key it contributes to. Within a province, pops are still added in ascending id order, which is the order the per key
+walk used, so the sums are unchanged. A pop only contributes to the keys of its own type, culture and religion; skipping
+the zeros it would have added to the others does not change a sum either. Ideology and issue option keys, to which every
+pop contributes, are not produced here: sum_over_demographics visits only those of them that are being recomputed.
+*/
 template<typename F>
-void sum_over_demographics(sys::state& state, dcon::demographics_key key, F const& source) {
-	// clear province
-	province::ve_for_each_land_province(state, [&](auto pi) { state.world.province_set_demographics(pi, key, ve::fp_vector()); });
-	// sum in province
-	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto location = state.world.pop_get_province_from_pop_location(p);
-		state.world.province_get_demographics(location, key) += source(state, p);
-	});
-	// clear state
-	state.world.execute_serial_over_state_instance(
-			[&](auto si) { state.world.state_instance_set_demographics(si, key, ve::fp_vector()); });
-	// sum in state
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		auto location = state.world.province_get_state_membership(p);
-		state.world.state_instance_get_demographics(location, key) += state.world.province_get_demographics(p, key);
-	});
-	// clear nation
-	state.world.execute_serial_over_nation([&](auto ni) { state.world.nation_set_demographics(ni, key, ve::fp_vector()); });
-	// sum in nation
-	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-		auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-		state.world.nation_get_demographics(location, key) += state.world.state_instance_get_demographics(s, key);
-	});
+void for_each_pop_demographic(sys::state& state, dcon::pop_id p, F&& add) {
+	auto const size = state.world.pop_get_size(p);
+	auto const ptype = state.world.pop_get_poptype(p);
+	auto const strata = state.world.pop_type_get_strata(ptype);
+	auto const militancy_amount = pop_demographics::get_militancy(state, p) * size;
+
+	add(total, size);
+	add(employable, state.world.pop_type_get_has_unemployment(ptype) ? size : 0.0f);
+	add(employed, pop_demographics::get_employment(state, p));
+	add(consciousness, pop_demographics::get_consciousness(state, p) * size);
+	add(militancy, militancy_amount);
+	add(literacy, pop_demographics::get_literacy(state, p) * size);
+
+	float political_desire = 0.0f;
+	float social_desire = 0.0f;
+	if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
+		auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
+		if(movement) {
+			auto opt = state.world.movement_get_associated_issue_option(movement);
+			auto optpar = state.world.issue_option_get_parent_issue(opt);
+			if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
+				political_desire = size;
+			if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
+				social_desire = size;
+		}
+	}
+	add(political_reform_desire, political_desire);
+	add(social_reform_desire, social_desire);
+
+	auto const poor = strata == uint8_t(culture::pop_strata::poor);
+	auto const middle = strata == uint8_t(culture::pop_strata::middle);
+	auto const rich = strata == uint8_t(culture::pop_strata::rich);
+	auto const life = pop_demographics::get_life_needs(state, p) * size;
+	auto const everyday = pop_demographics::get_everyday_needs(state, p) * size;
+	auto const luxury = pop_demographics::get_luxury_needs(state, p) * size;
+	add(poor_militancy, poor ? militancy_amount : 0.0f);
+	add(middle_militancy, middle ? militancy_amount : 0.0f);
+	add(rich_militancy, rich ? militancy_amount : 0.0f);
+	add(poor_life_needs, poor ? life : 0.0f);
+	add(middle_life_needs, middle ? life : 0.0f);
+	add(rich_life_needs, rich ? life : 0.0f);
+	add(poor_everyday_needs, poor ? everyday : 0.0f);
+	add(middle_everyday_needs, middle ? everyday : 0.0f);
+	add(rich_everyday_needs, rich ? everyday : 0.0f);
+	add(poor_luxury_needs, poor ? luxury : 0.0f);
+	add(middle_luxury_needs, middle ? luxury : 0.0f);
+	add(rich_luxury_needs, rich ? luxury : 0.0f);
+	add(poor_total, poor ? size : 0.0f);
+	add(middle_total, middle ? size : 0.0f);
+	add(rich_total, rich ? size : 0.0f);
+
+	if(ptype) {
+		add(to_key(state, ptype), size);
+		add(to_employment_key(state, ptype), state.world.pop_type_get_has_unemployment(ptype) ? pop_demographics::get_employment(state, p) : size);
+	}
+	if(auto c = state.world.pop_get_culture(p); c)
+		add(to_key(state, c), size);
+	if(auto r = state.world.pop_get_religion(p); r)
+		add(to_key(state, r), size);
+}
+
+template<bool alt>
+float& province_demographics(sys::state& state, dcon::province_id p, dcon::demographics_key key) {
+	if constexpr(alt)
+		return state.world.province_get_demographics_alt(p, key);
+	else
+		return state.world.province_get_demographics(p, key);
+}
+template<bool alt>
+float& state_demographics(sys::state& state, dcon::state_instance_id s, dcon::demographics_key key) {
+	if constexpr(alt)
+		return state.world.state_instance_get_demographics_alt(s, key);
+	else
+		return state.world.state_instance_get_demographics(s, key);
+}
+template<bool alt>
+float& nation_demographics(sys::state& state, dcon::nation_id n, dcon::demographics_key key) {
+	if constexpr(alt)
+		return state.world.nation_get_demographics_alt(n, key);
+	else
+		return state.world.nation_get_demographics(n, key);
+}
+
+// the keys recomputed today: all of them for a full update, otherwise the common keys and one of the
+// extra_demo_grouping groups of the remaining keys, in rotation
+template<bool full>
+void select_demographics_keys(sys::state& state, std::vector<dcon::demographics_key>& keys, std::vector<uint8_t>& selected) {
+	auto const sz = size(state);
+	auto const csz = common_size(state);
+	auto const extra_size = sz - csz;
+	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
+
+	keys.clear();
+	selected.assign(sz, uint8_t(0));
+	for(uint32_t base_index = 0; base_index < (full ? sz : csz + extra_group_size); ++base_index) {
+		auto index = base_index;
+		if constexpr(!full) {
+			if(index >= csz) {
+				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
+				if(index >= sz)
+					break;
+			}
+		}
+		keys.push_back(dcon::demographics_key{ dcon::demographics_key::value_base_t(index) });
+		selected[index] = uint8_t(1);
+	}
 }
 
-template<typename F>
-void alt_sum_over_demographics(sys::state& state, dcon::demographics_key key, F const& source) {
-	// clear province
-	province::ve_for_each_land_province(state, [&](auto pi) { state.world.province_set_demographics_alt(pi, key, ve::fp_vector()); });
-	// sum in province
+template<bool alt>
+void sum_over_demographics(sys::state& state, std::vector<dcon::demographics_key> const& keys, std::vector<uint8_t> const& selected) {
+	// bucket the pops by province, keeping them in ascending id order
+	static std::vector<uint32_t> first_pop;
+	static std::vector<dcon::pop_id> pops;
+	auto const province_count = state.world.province_size();
+	first_pop.assign(province_count + 1, 0);
 	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto location = state.world.pop_get_province_from_pop_location(p);
-		state.world.province_get_demographics_alt(location, key) += source(state, p);
+		if(auto location = state.world.pop_get_province_from_pop_location(p); location)
+			++first_pop[location.index() + 1];
 	});
-	// clear state
-	state.world.execute_serial_over_state_instance(
-			[&](auto si) { state.world.state_instance_set_demographics_alt(si, key, ve::fp_vector()); });
-	// sum in state
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		auto location = state.world.province_get_state_membership(p);
-		state.world.state_instance_get_demographics_alt(location, key) += state.world.province_get_demographics_alt(p, key);
+	for(uint32_t i = 0; i < province_count; ++i) {
+		first_pop[i + 1] += first_pop[i];
+	}
+	pops.resize(first_pop[province_count]);
+	{
+		static std::vector<uint32_t> next;
+		next.assign(first_pop.begin(), first_pop.end() - 1);
+		state.world.for_each_pop([&](dcon::pop_id p) {
+			if(auto location = state.world.pop_get_province_from_pop_location(p); location)
+				pops[next[location.index()]++] = p;
+		});
+	}
+
+	// the ideology and issue option keys being recomputed, with the matching per pop value
+	static std::vector<std::pair<dcon::demographics_key, dcon::pop_demographics_key>> weighted_keys;
+	weighted_keys.clear();
+	auto const first_ideology_key = uint32_t(to_key(state, dcon::ideology_id(0)).index());
+	auto const first_religion_key = uint32_t(to_key(state, dcon::religion_id(0)).index());
+	for(auto key : keys) {
+		if(first_ideology_key <= uint32_t(key.index()) && uint32_t(key.index()) < first_religion_key) {
+			weighted_keys.emplace_back(key, dcon::pop_demographics_key(
+				dcon::pop_demographics_key::value_base_t(uint32_t(key.index()) - first_ideology_key + pop_demographics::count_special_keys)));
+		}
+	}
+
+	// sum in province
+	concurrency::parallel_for(0, state.province_definitions.first_sea_province.index(), [&](int32_t i) {
+		dcon::province_id location{ dcon::province_id::value_base_t(i) };
+		for(auto key : keys) {
+			province_demographics<alt>(state, location, key) = 0.0f;
+		}
+		for(uint32_t j = first_pop[i]; j < first_pop[i + 1]; ++j) {
+			auto p = pops[j];
+			for_each_pop_demographic(state, p, [&](dcon::demographics_key key, float value) {
+				if(selected[key.index()])
+					province_demographics<alt>(state, location, key) += value;
+			});
+			auto size = state.world.pop_get_size(p);
+			for(auto& [key, pkey] : weighted_keys) {
+				province_demographics<alt>(state, location, key) += pop_demographics::get_demo(state, p, pkey) * size;
+			}
+		}
 	});
-	// clear nation
-	state.world.execute_serial_over_nation([&](auto ni) { state.world.nation_set_demographics_alt(ni, key, ve::fp_vector()); });
-	// sum in nation
-	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-		auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-		state.world.nation_get_demographics_alt(location, key) += state.world.state_instance_get_demographics_alt(s, key);
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(keys.size()), [&](uint32_t k) {
+		auto key = keys[k];
+		// sum in state
+		state.world.execute_serial_over_state_instance([&](auto si) {
+			if constexpr(alt)
+				state.world.state_instance_set_demographics_alt(si, key, ve::fp_vector());
+			else
+				state.world.state_instance_set_demographics(si, key, ve::fp_vector());
+		});
+		province::for_each_land_province(state, [&](dcon::province_id p) {
+			auto location = state.world.province_get_state_membership(p);
+			state_demographics<alt>(state, location, key) += province_demographics<alt>(state, p, key);
+		});
+		// sum in nation
+		state.world.execute_serial_over_nation([&](auto ni) {
+			if constexpr(alt)
+				state.world.nation_set_demographics_alt(ni, key, ve::fp_vector());
+			else
+				state.world.nation_set_demographics(ni, key, ve::fp_vector());
+		});
+		state.world.for_each_state_instance([&](dcon::state_instance_id s) {
+			auto location = state.world.state_instance_get_nation_from_state_ownership(s);
+			nation_demographics<alt>(state, location, key) += state_demographics<alt>(state, s, key);
+		});
 	});
 }
 
-inline constexpr uint32_t extra_demo_grouping = 8;
-
 template<typename F>
 void sum_over_single_nation_demographics(sys::state& state, dcon::demographics_key key, dcon::nation_id n, F const& source) {
 	// clear province
@@ -257,229 +408,10 @@ void regenerate_jingoism_support(sys::state& state, dcon::nation_id n) {
 
 template<bool full>
 void regenerate_from_pop_data(sys::state& state) {
-	auto const sz = size(state);
-	auto const csz = common_size(state);
-	auto const extra_size = sz - csz;
-	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
-
-	concurrency::parallel_for(uint32_t(0), full ?  sz : csz + extra_group_size, [&](uint32_t base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					return;
-			}
-		}
-		dcon::demographics_key key{dcon::demographics_key::value_base_t(index)};
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			}
-		// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
-			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size()))};
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size()))};
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else  { // religion
-			dcon::religion_id pkey{dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size()))};
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		}
-	});
+	static std::vector<dcon::demographics_key> keys;
+	static std::vector<uint8_t> selected;
+	select_demographics_keys<full>(state, keys, selected);
+	sum_over_demographics<false>(state, keys, selected);
 
 	//
 	// calculate values derived from demographics
@@ -554,591 +486,7 @@ void regenerate_from_pop_data(sys::state& state) {
 					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_religion([&](dcon::religion_id c) {
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.province_set_dominant_religion(p,
-							ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.province_get_dominant_religion(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 4: {
-			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.state_instance_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_religion([&](dcon::religion_id c) {
-				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.state_instance_set_dominant_religion(p,
-							ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.state_instance_get_dominant_religion(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 5: {
-			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.nation_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.nation_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_religion([&](dcon::religion_id c) {
-				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.nation_set_dominant_religion(p,
-							ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.nation_get_dominant_religion(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 6: {
-			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
-
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_ideology([&](dcon::ideology_id c) {
-				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.province_set_dominant_ideology(p,
-							ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.province_get_dominant_ideology(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 7: {
-			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.state_instance_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_ideology([&](dcon::ideology_id c) {
-				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.state_instance_set_dominant_ideology(p,
-							ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.state_instance_get_dominant_ideology(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 8: {
-			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.nation_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.nation_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_ideology([&](dcon::ideology_id c) {
-				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.nation_set_dominant_ideology(p,
-							ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.nation_get_dominant_ideology(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 9: {
-			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
-
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
-				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.province_set_dominant_issue_option(p,
-							ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.province_get_dominant_issue_option(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 10: {
-			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.state_instance_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
-				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.state_instance_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.state_instance_get_dominant_issue_option(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 11: {
-			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.nation_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.nation_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
-				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.nation_set_dominant_issue_option(p,
-						ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.nation_get_dominant_issue_option(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 12: {
-			static ve::vectorizable_buffer<float, dcon::pop_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.pop_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.pop_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_pop([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
-				state.world.execute_serial_over_pop([&, k = pop_demographics::to_key(state, c)](auto p) {
-					auto v = pop_demographics::get_demo(state, p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.pop_set_dominant_issue_option(p,
-						ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.pop_get_dominant_issue_option(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 13: {
-			static ve::vectorizable_buffer<float, dcon::pop_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.pop_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.pop_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_pop([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_ideology([&](dcon::ideology_id c) {
-				state.world.execute_serial_over_pop([&, k = pop_demographics::to_key(state, c)](auto p) {
-					auto v = pop_demographics::get_demo(state, p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.pop_set_dominant_ideology(p,
-						ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.pop_get_dominant_ideology(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 14: {
-			// clear nation
-			state.world.execute_serial_over_nation(
-					[&](auto ni) { state.world.nation_set_non_colonial_population(ni, ve::fp_vector()); });
-			// sum in nation
-			state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-				if(!state.world.province_get_is_colonial(state.world.state_instance_get_capital(s))) {
-					auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-					state.world.nation_get_non_colonial_population(location) +=
-							state.world.state_instance_get_demographics(s, demographics::total);
-				}
-			});
-			break;
-		}
-		case 15: {
-			// clear nation
-			state.world.execute_serial_over_nation(
-					[&](auto ni) { state.world.nation_set_non_colonial_bureaucrats(ni, ve::fp_vector()); });
-			// sum in nation
-			state.world.for_each_state_instance(
-					[&, k = demographics::to_key(state, state.culture_definitions.bureaucrat)](dcon::state_instance_id s) {
-						if(!state.world.province_get_is_colonial(state.world.state_instance_get_capital(s))) {
-							auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-							state.world.nation_get_non_colonial_bureaucrats(location) += state.world.state_instance_get_demographics(s, k);
-						}
-					});
-			break;
-		}
-		case 16:
-		{
-			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { state.world.province_set_dominant_accepted_culture(p, dcon::culture_id{}); });
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-
-			state.world.for_each_culture([&](dcon::culture_id c) {
-				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, key = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics(p, key);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max &&  nations::nation_accepts_culture(state, state.world.province_get_nation_from_province_ownership(p), c);
-					state.world.province_set_dominant_accepted_culture(p,
-							ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.province_get_dominant_accepted_culture(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		default:
-			break;
-		}
-	});
-}
-
-void regenerate_from_pop_data_full(sys::state& state) {
-	regenerate_from_pop_data<true>(state);
-}
-void regenerate_from_pop_data_daily(sys::state& state) {
-	regenerate_from_pop_data<false>(state);
-}
-
-template<bool full>
-void alt_mt_regenerate_from_pop_data(sys::state& state) {
-	auto const sz = size(state);
-	auto const csz = common_size(state);
-	auto const extra_size = sz - csz;
-	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
-
-	concurrency::parallel_for(uint32_t(0), full ? sz : csz + extra_group_size, [&](uint32_t base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					return;
-			}
-		}
-		dcon::demographics_key key{ dcon::demographics_key::value_base_t(index) };
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				alt_sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			}
-			// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
-			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{ dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{ dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else { // religion
-			dcon::religion_id pkey{ dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size())) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		}
-	});
-
-	//
-	// calculate values derived from demographics
-	//
-
-	concurrency::parallel_for(uint32_t(0), uint32_t(12), [&](uint32_t index) {
-		switch(index) {
-		case 0:
-		{
-			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
-
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_culture([&](dcon::culture_id c) {
-				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics_alt(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.province_set_dominant_culture(p,
-							ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.province_get_dominant_culture(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 1:
-		{
-			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.state_instance_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_culture([&](dcon::culture_id c) {
-				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics_alt(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.state_instance_set_dominant_culture(p,
-							ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.state_instance_get_dominant_culture(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 2:
-		{
-			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
-			static uint32_t old_count = 1;
-
-			auto new_count = state.world.nation_size();
-			if(new_count > old_count) {
-				max_buffer = state.world.nation_make_vectorizable_float_buffer();
-				old_count = new_count;
-			}
-			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_culture([&](dcon::culture_id c) {
-				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics_alt(p, k);
-					auto old_max = max_buffer.get(p);
-					auto mask = v > old_max;
-					state.world.nation_set_dominant_culture(p,
-							ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.nation_get_dominant_culture(p)));
-					max_buffer.set(p, ve::select(mask, v, old_max));
-				});
-			});
-			break;
-		}
-		case 3:
-		{
-			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
-
-			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
-					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
-			state.world.for_each_religion([&](dcon::religion_id c) {
-				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics_alt(p, k);
+					auto v = state.world.province_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.province_set_dominant_religion(p,
@@ -1148,8 +496,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 4:
-		{
+		case 4: {
 			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1161,7 +508,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_religion([&](dcon::religion_id c) {
 				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics_alt(p, k);
+					auto v = state.world.state_instance_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.state_instance_set_dominant_religion(p,
@@ -1171,8 +518,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 5:
-		{
+		case 5: {
 			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1184,7 +530,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_religion([&](dcon::religion_id c) {
 				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics_alt(p, k);
+					auto v = state.world.nation_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.nation_set_dominant_religion(p,
@@ -1194,15 +540,14 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 6:
-		{
+		case 6: {
 			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
 
 			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
 					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_ideology([&](dcon::ideology_id c) {
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics_alt(p, k);
+					auto v = state.world.province_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.province_set_dominant_ideology(p,
@@ -1212,8 +557,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 7:
-		{
+		case 7: {
 			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1225,7 +569,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_ideology([&](dcon::ideology_id c) {
 				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics_alt(p, k);
+					auto v = state.world.state_instance_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.state_instance_set_dominant_ideology(p,
@@ -1235,8 +579,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 8:
-		{
+		case 8: {
 			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1248,7 +591,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_ideology([&](dcon::ideology_id c) {
 				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics_alt(p, k);
+					auto v = state.world.nation_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.nation_set_dominant_ideology(p,
@@ -1258,15 +601,14 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 9:
-		{
+		case 9: {
 			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
 
 			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
 					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, k = to_key(state, c)](auto p) {
-					auto v = state.world.province_get_demographics_alt(p, k);
+					auto v = state.world.province_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.province_set_dominant_issue_option(p,
@@ -1276,8 +618,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 10:
-		{
+		case 10: {
 			static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1289,7 +630,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_state_instance([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 				state.world.execute_serial_over_state_instance([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.state_instance_get_demographics_alt(p, k);
+					auto v = state.world.state_instance_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.state_instance_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.state_instance_get_dominant_issue_option(p)));
@@ -1298,8 +639,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		case 11:
-		{
+		case 11: {
 			static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
 			static uint32_t old_count = 1;
 
@@ -1311,7 +651,7 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			state.world.execute_serial_over_nation([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
 			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 				state.world.execute_serial_over_nation([&, k = to_key(state, c)](auto p) {
-					auto v = state.world.nation_get_demographics_alt(p, k);
+					auto v = state.world.nation_get_demographics(p, k);
 					auto old_max = max_buffer.get(p);
 					auto mask = v > old_max;
 					state.world.nation_set_dominant_issue_option(p,
@@ -1321,237 +661,117 @@ void alt_mt_regenerate_from_pop_data(sys::state& state) {
 			});
 			break;
 		}
-		default:
-			break;
-		}
-	});
-}
-
-template<bool full>
-void alt_st_regenerate_from_pop_data(sys::state& state) {
-	auto const sz = size(state);
-	auto const csz = common_size(state);
-	auto const extra_size = sz - csz;
-	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
+		case 12: {
+			static ve::vectorizable_buffer<float, dcon::pop_id> max_buffer(uint32_t(1));
+			static uint32_t old_count = 1;
 
-	for(uint32_t base_index = 0; base_index < (full ? sz : csz + extra_group_size); ++ base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					return;
+			auto new_count = state.world.pop_size();
+			if(new_count > old_count) {
+				max_buffer = state.world.pop_make_vectorizable_float_buffer();
+				old_count = new_count;
 			}
-		}
-		dcon::demographics_key key{ dcon::demographics_key::value_base_t(index) };
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				alt_sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? state.world.pop_get_size(p)
-						: 0.0f;
+			state.world.execute_serial_over_pop([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
+			state.world.for_each_issue_option([&](dcon::issue_option_id c) {
+				state.world.execute_serial_over_pop([&, k = pop_demographics::to_key(state, c)](auto p) {
+					auto v = pop_demographics::get_demo(state, p, k);
+					auto old_max = max_buffer.get(p);
+					auto mask = v > old_max;
+					state.world.pop_set_dominant_issue_option(p,
+						ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.pop_get_dominant_issue_option(p)));
+					max_buffer.set(p, ve::select(mask, v, old_max));
 				});
-				break;
-			}
-			// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
 			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
+			break;
+		}
+		case 13: {
+			static ve::vectorizable_buffer<float, dcon::pop_id> max_buffer(uint32_t(1));
+			static uint32_t old_count = 1;
+
+			auto new_count = state.world.pop_size();
+			if(new_count > old_count) {
+				max_buffer = state.world.pop_make_vectorizable_float_buffer();
+				old_count = new_count;
 			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{ dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
+			state.world.execute_serial_over_pop([&](auto p) { max_buffer.set(p, ve::fp_vector()); });
+			state.world.for_each_ideology([&](dcon::ideology_id c) {
+				state.world.execute_serial_over_pop([&, k = pop_demographics::to_key(state, c)](auto p) {
+					auto v = pop_demographics::get_demo(state, p, k);
+					auto old_max = max_buffer.get(p);
+					auto mask = v > old_max;
+					state.world.pop_set_dominant_ideology(p,
+						ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.pop_get_dominant_ideology(p)));
+					max_buffer.set(p, ve::select(mask, v, old_max));
+				});
 			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{ dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
+			break;
+		}
+		case 14: {
+			// clear nation
+			state.world.execute_serial_over_nation(
+					[&](auto ni) { state.world.nation_set_non_colonial_population(ni, ve::fp_vector()); });
+			// sum in nation
+			state.world.for_each_state_instance([&](dcon::state_instance_id s) {
+				if(!state.world.province_get_is_colonial(state.world.state_instance_get_capital(s))) {
+					auto location = state.world.state_instance_get_nation_from_state_ownership(s);
+					state.world.nation_get_non_colonial_population(location) +=
+							state.world.state_instance_get_demographics(s, demographics::total);
+				}
 			});
-		} else { // religion
-			dcon::religion_id pkey{ dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size())) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
+			break;
+		}
+		case 15: {
+			// clear nation
+			state.world.execute_serial_over_nation(
+					[&](auto ni) { state.world.nation_set_non_colonial_bureaucrats(ni, ve::fp_vector()); });
+			// sum in nation
+			state.world.for_each_state_instance(
+					[&, k = demographics::to_key(state, state.culture_definitions.bureaucrat)](dcon::state_instance_id s) {
+						if(!state.world.province_get_is_colonial(state.world.state_instance_get_capital(s))) {
+							auto location = state.world.state_instance_get_nation_from_state_ownership(s);
+							state.world.nation_get_non_colonial_bureaucrats(location) += state.world.state_instance_get_demographics(s, k);
+						}
+					});
+			break;
+		}
+		case 16:
+		{
+			static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
+			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
+					[&](auto p) { state.world.province_set_dominant_accepted_culture(p, dcon::culture_id{}); });
+			ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
+					[&](auto p) { max_buffer.set(p, ve::fp_vector()); });
+
+			state.world.for_each_culture([&](dcon::culture_id c) {
+				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&, key = to_key(state, c)](auto p) {
+					auto v = state.world.province_get_demographics(p, key);
+					auto old_max = max_buffer.get(p);
+					auto mask = v > old_max &&  nations::nation_accepts_culture(state, state.world.province_get_nation_from_province_ownership(p), c);
+					state.world.province_set_dominant_accepted_culture(p,
+							ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.province_get_dominant_accepted_culture(p)));
+					max_buffer.set(p, ve::select(mask, v, old_max));
+				});
 			});
+			break;
 		}
-	}
+		default:
+			break;
+		}
+	});
+}
+
+void regenerate_from_pop_data_full(sys::state& state) {
+	regenerate_from_pop_data<true>(state);
+}
+void regenerate_from_pop_data_daily(sys::state& state) {
+	regenerate_from_pop_data<false>(state);
+}
+
+template<bool full>
+void alt_st_regenerate_from_pop_data(sys::state& state) {
+	static std::vector<dcon::demographics_key> keys;
+	static std::vector<uint8_t> selected;
+	select_demographics_keys<full>(state, keys, selected);
+	sum_over_demographics<true>(state, keys, selected);
 
 	//
 	// calculate values derived from demographics
@@ -2237,18 +1457,185 @@ float get_estimated_literacy_change(sys::state& state, dcon::pop_id ids) {
 	auto old_lit = pop_demographics::get_literacy(state, ids);
 	auto new_lit = std::min(std::max(old_lit + (0.01f * state.defines.literacy_change_speed) * ((espending * cmod) * (tmod * nmod)), 0.01f), 1.0f);
 
-	return new_lit - old_lit;
-}
+	return new_lit - old_lit;
+}
+
+float get_estimated_literacy_change(sys::state& state, dcon::nation_id n) {
+	float sum = 0.0f;
+	for(auto prov : dcon::fatten(state.world, n).get_province_ownership()) {
+		for(auto pop : prov.get_province().get_pop_location()) {
+			sum += pop.get_pop().get_size() * get_estimated_literacy_change(state, pop.get_pop());
+		}
+	}
+	auto t = state.world.nation_get_demographics(n, demographics::total);
+	return t != 0.f ? sum / t : 0.f;
+}
+
+culture::estimated_pop_changes const& get_estimated_changes(sys::state& state, dcon::nation_id n) {
+	auto& cache = state.pop_change_estimates;
+	if(cache.valid && cache.nation == n)
+		return cache.values;
+
+	float mil = 0.0f;
+	float con = 0.0f;
+	float lit = 0.0f;
+	for(auto prov : dcon::fatten(state.world, n).get_province_ownership()) {
+		for(auto pop : prov.get_province().get_pop_location()) {
+			auto size = pop.get_pop().get_size();
+			mil += size * get_estimated_mil_change(state, pop.get_pop());
+			con += size * get_estimated_con_change(state, pop.get_pop());
+			lit += size * get_estimated_literacy_change(state, pop.get_pop());
+		}
+	}
+	auto t = state.world.nation_get_demographics(n, demographics::total);
+	cache.values.militancy = t != 0.f ? mil / t : 0.f;
+	cache.values.consciousness = t != 0.f ? con / t : 0.f;
+	cache.values.literacy = t != 0.f ? lit / t : 0.f;
+	cache.nation = n;
+	cache.valid = true;
+	return cache.values;
+}
+
+// The lanes of a block of pops, grouped by pop type. The jit compiles the ideology and issue modifiers separately for each pop
+// type, so the pops of one type in a block can be handed to that type's block export together, in place of a call per pop.
+struct pop_type_lanes {
+	int32_t first_pop = std::numeric_limits<int32_t>::max();
+	int32_t pops[ve::vector_size] = { };
+	dcon::pop_type_id types[ve::vector_size];
+	dcon::pop_type_id distinct_types[ve::vector_size];
+	int32_t lane_count = 0;
+	int32_t distinct_count = 0;
+};
+
+template<typename T>
+pop_type_lanes group_lanes_by_pop_type(sys::state& state, T ids) {
+	pop_type_lanes result;
+	ve::apply([&](dcon::pop_id pid, dcon::pop_type_id ptid) {
+		result.pops[result.lane_count] = pid.index();
+		result.types[result.lane_count] = ptid;
+		++result.lane_count;
+		result.first_pop = std::min(result.first_pop, int32_t(pid.index()));
+		auto const distinct_end = result.distinct_types + result.distinct_count;
+		if(std::find(result.distinct_types, distinct_end, ptid) == distinct_end) {
+			result.distinct_types[result.distinct_count] = ptid;
+			++result.distinct_count;
+		}
+		return 0.0f;
+	}, ids, state.world.pop_get_poptype(ids));
+	return result;
+}
+
+// evaluates a pop type modifier for every lane, through block_fn_for(pop type) where the jit provided one and through
+// single(pop, pop type) otherwise
+template<typename T, typename B, typename S>
+ve::fp_vector evaluate_by_pop_type(T ids, pop_type_lanes const& lanes, B&& block_fn_for, S&& single) {
+	float results[ve::vector_size] = { };
+	for(int32_t d = 0; d < lanes.distinct_count; ++d) {
+		auto const ptid = lanes.distinct_types[d];
+		if(auto bfn = block_fn_for(ptid); bfn != 0) {
+			int32_t buffer[ve::vector_size];
+			int32_t buffer_lanes[ve::vector_size];
+			int32_t count = 0;
+			for(int32_t l = 0; l < lanes.lane_count; ++l) {
+				if(lanes.types[l] == ptid) {
+					buffer[count] = lanes.pops[l];
+					buffer_lanes[count] = l;
+					++count;
+				}
+			}
+			using ftype = void(*)(int32_t*, int32_t);
+			ftype fn = (ftype)bfn;
+			fn(buffer, count); // overwrites each pop id with the value for that pop
+			for(int32_t k = 0; k < count; ++k) {
+				std::memcpy(&results[lanes.pops[buffer_lanes[k]] - lanes.first_pop], &buffer[k], sizeof(float));
+			}
+		} else {
+			for(int32_t l = 0; l < lanes.lane_count; ++l) {
+				if(lanes.types[l] == ptid) {
+					results[lanes.pops[l] - lanes.first_pop] = single(dcon::pop_id{ dcon::pop_id::value_base_t(lanes.pops[l]) }, ptid);
+				}
+			}
+		}
+	}
+	return ve::apply([&](dcon::pop_id pid) {
+		return results[pid.index() - lanes.first_pop];
+	}, ids);
+}
+
+// The daily ideology and issue updates are each split into the computation of the attraction weights of a block of pops and the
+// writes of the resulting support, so that update_ideologies_and_issues can do both for a block before writing any of it.
+template<typename T, typename O>
+void compute_ideology_weights(sys::state& state, T ids, O owner, pop_type_lanes const& lanes, ve::fp_vector* iopt_weights, ve::fp_vector& ttotal) {
+	state.world.for_each_ideology([&](dcon::ideology_id i) {
+		if(!state.world.ideology_get_enabled(i)) {
+			iopt_weights[i.index()] = 0.0f;
+		} else {
+			auto amount = evaluate_by_pop_type(ids, lanes,
+				[&](dcon::pop_type_id ptid) { return state.world.pop_type_get_ideology_block_fns(ptid, i); },
+				[&](dcon::pop_id pid, dcon::pop_type_id ptid) {
+					if(auto mfn = state.world.pop_type_get_ideology_fns(ptid, i); mfn != 0) {
+						using ftype = float(*)(int32_t);
+						ftype fn = (ftype)mfn;
+						float llvm_result = fn(pid.index());
+#ifdef CHECK_LLVM_RESULTS
+						float interp_result = 0.0f;
+						if(auto mtrigger = state.world.pop_type_get_ideology(ptid, i); mtrigger) {
+							interp_result = trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
+						}
+						assert(llvm_result == interp_result);
+#endif
+						return llvm_result;
+					} else {
+						auto ptrigger = state.world.pop_type_get_ideology(ptid, i);
+						return ptrigger ? trigger::evaluate_multiplicative_modifier(state, ptrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0) : 0.0f;
+					}
+				});
+			if(state.world.ideology_get_is_civilized_only(i)) {
+				amount = ve::select(state.world.nation_get_is_civilized(owner), amount, 0.0f);
+			}
+
+			iopt_weights[i.index()] = amount;
+			ttotal = ttotal + amount;
+		}
+	});
+}
+
+template<typename T>
+void store_ideologies(sys::state& state, T ids, ve::fp_vector const* iopt_weights, ve::fp_vector ttotal, ideology_buffer& ibuf) {
+	if(state.network_mode == sys::network_mode_type::single_player) {
+		ve::fp_vector max_weight{ 0.0f };
+		ve::tagged_vector<dcon::ideology_id> preferred{};
+
+		state.world.for_each_ideology([&](dcon::ideology_id iid) {
+			auto avalue = iopt_weights[iid.index()] / ttotal;
+
+			auto const i_key = pop_demographics::to_key(state, iid);
+			auto current = pop_demographics::get_demo(state, ids, i_key);
+
+			auto new_weight = ve::select(ttotal > 0.0f, state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current);
+			auto new_max = new_weight > max_weight;
+			preferred = ve::select(new_max, ve::tagged_vector<dcon::ideology_id>{iid}, preferred);
+			max_weight = ve::select(new_max, new_weight, max_weight);
+
+			pop_demographics::set_demo(state, ids, i_key, new_weight);
+		});
+
+		state.world.pop_set_dominant_ideology(ids, preferred);
+	} else {
+		state.world.for_each_ideology([&](dcon::ideology_id iid) {
+			auto avalue = iopt_weights[iid.index()] / ttotal;
+
+			auto const i_key = pop_demographics::to_key(state, iid);
+			auto current = pop_demographics::get_demo(state, ids, i_key);
+
+			//pop_demographics::set_demo(state, ids, i_key,
+			//	ve::select(ttotal > 0.0f, state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current));
 
-float get_estimated_literacy_change(sys::state& state, dcon::nation_id n) {
-	float sum = 0.0f;
-	for(auto prov : dcon::fatten(state.world, n).get_province_ownership()) {
-		for(auto pop : prov.get_province().get_pop_location()) {
-			sum += pop.get_pop().get_size() * get_estimated_literacy_change(state, pop.get_pop());
-		}
+			ibuf.temp_buffers[iid].set(ids, pop_demographics::to_pu8(ve::select(ttotal > 0.0f,
+				state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current)));
+			
+		});
 	}
-	auto t = state.world.nation_get_demographics(n, demographics::total);
-	return t != 0.f ? sum / t : 0.f;
 }
 
 void update_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& ibuf) {
@@ -2267,102 +1654,11 @@ void update_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, i
 	pexecute_staggered_blocks(offset, divisions, new_pop_count, [&](auto ids) {
 		ve::fp_vector iopt_weights[64];
 		ve::fp_vector ttotal = 0.0f;
+		auto owner = nations::owner_of_pop(state, ids);
+		auto const lanes = group_lanes_by_pop_type(state, ids);
 
-		state.world.for_each_ideology([&](dcon::ideology_id i) {
-			if(!state.world.ideology_get_enabled(i)) {
-				iopt_weights[i.index()] = 0.0f;
-			} else {
-				auto const i_key = pop_demographics::to_key(state, i);
-				auto owner = nations::owner_of_pop(state, ids);
-
-				if(state.world.ideology_get_is_civilized_only(i)) {
-					auto amount = ve::apply(
-						[&](dcon::pop_id pid, dcon::pop_type_id ptid, dcon::nation_id o) {
-							if(state.world.nation_get_is_civilized(o)) {
-								if(auto mfn = state.world.pop_type_get_ideology_fns(ptid, i); mfn != 0) {
-									using ftype = float(*)(int32_t);
-									ftype fn = (ftype)mfn;
-									float llvm_result = fn(pid.index());
-#ifdef CHECK_LLVM_RESULTS
-									float interp_result = 0.0f;
-									if(auto mtrigger = state.world.pop_type_get_ideology(ptid, i); mtrigger) {
-										interp_result = trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
-									}
-									assert(llvm_result == interp_result);
-#endif
-									return llvm_result;
-								} else {
-									auto ptrigger = state.world.pop_type_get_ideology(ptid, i);
-									return ptrigger ? trigger::evaluate_multiplicative_modifier(state, ptrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0) : 0.0f;
-								}
-							} else {
-								return 0.0f;
-							}
-						}, ids, state.world.pop_get_poptype(ids), owner);
-
-					iopt_weights[i.index()] = amount;
-					ttotal = ttotal + amount;
-				} else {
-					auto amount = ve::apply(
-						[&](dcon::pop_id pid, dcon::pop_type_id ptid, dcon::nation_id o) {
-							if(auto mfn = state.world.pop_type_get_ideology_fns(ptid, i); mfn != 0) {
-								using ftype = float(*)(int32_t);
-								ftype fn = (ftype)mfn;
-								float llvm_result = fn(pid.index());
-#ifdef CHECK_LLVM_RESULTS
-								float interp_result = 0.0f;
-								if(auto mtrigger = state.world.pop_type_get_ideology(ptid, i); mtrigger) {
-									interp_result = trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
-								}
-								assert(llvm_result == interp_result);
-#endif
-								return llvm_result;
-							} else {
-								auto ptrigger = state.world.pop_type_get_ideology(ptid, i);
-								return ptrigger ? trigger::evaluate_multiplicative_modifier(state, ptrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0) : 0.0f;
-							}
-						}, ids, state.world.pop_get_poptype(ids), owner);
-
-					iopt_weights[i.index()] = amount;
-					ttotal = ttotal + amount;
-				}
-			}
-		});
-
-		if(state.network_mode == sys::network_mode_type::single_player) {
-			ve::fp_vector max_weight{ 0.0f };
-			ve::tagged_vector<dcon::ideology_id> preferred{};
-
-			state.world.for_each_ideology([&](dcon::ideology_id iid) {
-				auto avalue = iopt_weights[iid.index()] / ttotal;
-
-				auto const i_key = pop_demographics::to_key(state, iid);
-				auto current = pop_demographics::get_demo(state, ids, i_key);
-
-				auto new_weight = ve::select(ttotal > 0.0f, state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current);
-				auto new_max = new_weight > max_weight;
-				preferred = ve::select(new_max, ve::tagged_vector<dcon::ideology_id>{iid}, preferred);
-				max_weight = ve::select(new_max, new_weight, max_weight);
-
-				state.world.pop_set_udemographics(ids, i_key, pop_demographics::to_pu8(new_weight));
-			});
-
-			state.world.pop_set_dominant_ideology(ids, preferred);
-		} else {
-			state.world.for_each_ideology([&](dcon::ideology_id iid) {
-				auto avalue = iopt_weights[iid.index()] / ttotal;
-
-				auto const i_key = pop_demographics::to_key(state, iid);
-				auto current = pop_demographics::get_demo(state, ids, i_key);
-
-				//pop_demographics::set_demo(state, ids, i_key,
-				//	ve::select(ttotal > 0.0f, state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current));
-
-				ibuf.temp_buffers[iid].set(ids, pop_demographics::to_pu8(ve::select(ttotal > 0.0f,
-					state.defines.alice_ideology_base_change_rate * avalue + (1.0f - state.defines.alice_ideology_base_change_rate) * current, current)));
-				
-			});
-		}
+		compute_ideology_weights(state, ids, owner, lanes, iopt_weights, ttotal);
+		store_ideologies(state, ids, iopt_weights, ttotal, ibuf);
 	});
 }
 
@@ -2392,6 +1688,97 @@ void apply_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, id
 
 inline constexpr float issues_change_rate = 0.20f;
 
+template<typename T, typename O>
+void compute_issue_weights(sys::state& state, T ids, O owner, pop_type_lanes const& lanes, ve::fp_vector* iopt_weights, ve::fp_vector& ttotal) {
+	state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
+		auto opt = fatten(state.world, iid);
+		auto allow = opt.get_allow();
+		auto parent_issue = opt.get_parent_issue();
+		auto const i_key = pop_demographics::to_key(state, iid);
+		auto is_party_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::party);
+		auto is_social_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::social);
+		auto is_political_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::political);
+		auto has_modifier = is_social_issue || is_political_issue;
+		auto modifier_key =
+			is_social_issue ? sys::national_mod_offsets::social_reform_desire : sys::national_mod_offsets::political_reform_desire;
+
+		auto current_issue_setting = state.world.nation_get_issues(owner, parent_issue);
+		auto allowed_by_owner =
+			(state.world.nation_get_is_civilized(owner) || ve::mask_vector(is_party_issue))
+			&& (ve::mask_vector(!state.world.issue_get_is_next_step_only(parent_issue)) ||
+					(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index()) ||
+					(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index() - 1) ||
+					(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index() + 1));
+		auto owner_modifier =
+				has_modifier ? (state.world.nation_get_modifier_values(owner, modifier_key) + 1.0f) : ve::fp_vector(1.0f);
+
+		auto amount = owner_modifier * ve::select(allowed_by_owner,
+			evaluate_by_pop_type(ids, lanes,
+			[&](dcon::pop_type_id ptid) { return state.world.pop_type_get_issues_block_fns(ptid, iid); },
+			[&](dcon::pop_id pid, dcon::pop_type_id ptid) {
+				if(auto mfn = state.world.pop_type_get_issues_fns(ptid, iid); mfn != 0) {
+					using ftype = float(*)(int32_t);
+					ftype fn = (ftype)mfn;
+					float llvm_result = fn(pid.index());
+#ifdef CHECK_LLVM_RESULTS
+					float interp_result = 0.0f;
+					if(auto mtrigger = state.world.pop_type_get_issues(ptid, iid); mtrigger) {
+						interp_result = trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
+					}
+					assert(llvm_result == interp_result);
+#endif
+					return llvm_result;
+				} else { 
+					if(auto mtrigger = state.world.pop_type_get_issues(ptid, iid); mtrigger) {
+						return trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
+					} else {
+						return 0.0f;
+					}
+				}
+			}),
+		0.0f);
+
+		iopt_weights[iid.index()] = amount;
+		ttotal = ttotal + amount;
+	});
+}
+
+template<typename T, typename O>
+void store_issues(sys::state& state, T ids, O owner, ve::fp_vector const* iopt_weights, ve::fp_vector ttotal, issues_buffer& ibuf) {
+	if(state.network_mode == sys::network_mode_type::single_player) {
+		ve::fp_vector max_weight{ 0.0f };
+		ve::tagged_vector<dcon::issue_option_id> preferred{};
+
+		state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
+			auto avalue = iopt_weights[iid.index()] / ttotal;
+
+			auto const i_key = pop_demographics::to_key(state, iid);
+			auto current = pop_demographics::get_demo(state, ids, i_key);
+			auto owner_rate_modifier = (state.world.nation_get_modifier_values(owner, sys::national_mod_offsets::issue_change_speed) + 1.0f);
+
+			auto new_weight = ve::select(ttotal > 0.0f, issues_change_rate * owner_rate_modifier * avalue + (1.0f - issues_change_rate * owner_rate_modifier) * current, current);
+			auto new_max = new_weight > max_weight;
+			preferred = ve::select(new_max, ve::tagged_vector<dcon::issue_option_id>{iid}, preferred);
+			max_weight = ve::select(new_max, new_weight, max_weight);
+
+			pop_demographics::set_demo(state, ids, i_key, new_weight);
+		});
+
+		state.world.pop_set_dominant_issue_option(ids, preferred);
+	} else {
+		state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
+			auto avalue = iopt_weights[iid.index()] / ttotal;
+
+			auto const i_key = pop_demographics::to_key(state, iid);
+			auto current = pop_demographics::get_demo(state, ids, i_key);
+			auto owner_rate_modifier = (state.world.nation_get_modifier_values(owner, sys::national_mod_offsets::issue_change_speed) + 1.0f);
+
+			ibuf.temp_buffers[iid].set(ids, pop_demographics::to_pu8(ve::select(ttotal > 0.0f,
+				issues_change_rate * owner_rate_modifier * avalue + (1.0f - issues_change_rate * owner_rate_modifier) * current, current)));
+		});
+	}
+}
+
 void update_issues(sys::state& state, uint32_t offset, uint32_t divisions, issues_buffer& ibuf) {
 	/*
 	As with ideologies, the attraction modifier for each issue is computed *multiplicatively* and then are collectively
@@ -2409,89 +1796,35 @@ void update_issues(sys::state& state, uint32_t offset, uint32_t divisions, issue
 		ve::fp_vector iopt_weights[720];
 		ve::fp_vector ttotal = 0.0f;
 		auto owner = nations::owner_of_pop(state, ids);
+		auto const lanes = group_lanes_by_pop_type(state, ids);
 
-		state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
-			auto opt = fatten(state.world, iid);
-			auto allow = opt.get_allow();
-			auto parent_issue = opt.get_parent_issue();
-			auto const i_key = pop_demographics::to_key(state, iid);
-			auto is_party_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::party);
-			auto is_social_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::social);
-			auto is_political_issue = state.world.issue_get_issue_type(parent_issue) == uint8_t(culture::issue_type::political);
-			auto has_modifier = is_social_issue || is_political_issue;
-			auto modifier_key =
-				is_social_issue ? sys::national_mod_offsets::social_reform_desire : sys::national_mod_offsets::political_reform_desire;
-
-			auto current_issue_setting = state.world.nation_get_issues(owner, parent_issue);
-			auto allowed_by_owner =
-				(state.world.nation_get_is_civilized(owner) || ve::mask_vector(is_party_issue))
-				&& (ve::mask_vector(!state.world.issue_get_is_next_step_only(parent_issue)) ||
-						(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index()) ||
-						(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index() - 1) ||
-						(ve::tagged_vector<int32_t>(current_issue_setting) == iid.index() + 1));
-			auto owner_modifier =
-					has_modifier ? (state.world.nation_get_modifier_values(owner, modifier_key) + 1.0f) : ve::fp_vector(1.0f);
-
-			auto amount = owner_modifier * ve::select(allowed_by_owner,
-				ve::apply([&](dcon::pop_id pid, dcon::pop_type_id ptid, dcon::nation_id o) {
-					if(auto mfn = state.world.pop_type_get_issues_fns(ptid, iid); mfn != 0) {
-						using ftype = float(*)(int32_t);
-						ftype fn = (ftype)mfn;
-						float llvm_result = fn(pid.index());
-#ifdef CHECK_LLVM_RESULTS
-						float interp_result = 0.0f;
-						if(auto mtrigger = state.world.pop_type_get_issues(ptid, iid); mtrigger) {
-							interp_result = trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
-						}
-						assert(llvm_result == interp_result);
-#endif
-						return llvm_result;
-					} else { 
-						if(auto mtrigger = state.world.pop_type_get_issues(ptid, iid); mtrigger) {
-							return trigger::evaluate_multiplicative_modifier(state, mtrigger, trigger::to_generic(pid), trigger::to_generic(pid), 0);
-						} else {
-							return 0.0f;
-						}
-					}
-				},  ids, state.world.pop_get_poptype(ids), owner),
-			0.0f);
-
-			iopt_weights[iid.index()] = amount;
-			ttotal = ttotal + amount;
-		});
-
-		if(state.network_mode == sys::network_mode_type::single_player) {
-			ve::fp_vector max_weight{ 0.0f };
-			ve::tagged_vector<dcon::issue_option_id> preferred{};
-
-			state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
-				auto avalue = iopt_weights[iid.index()] / ttotal;
-
-				auto const i_key = pop_demographics::to_key(state, iid);
-				auto current = pop_demographics::get_demo(state, ids, i_key);
-				auto owner_rate_modifier = (state.world.nation_get_modifier_values(owner, sys::national_mod_offsets::issue_change_speed) + 1.0f);
-
-				auto new_weight = ve::select(ttotal > 0.0f, issues_change_rate * owner_rate_modifier * avalue + (1.0f - issues_change_rate * owner_rate_modifier) * current, current);
-				auto new_max = new_weight > max_weight;
-				preferred = ve::select(new_max, ve::tagged_vector<dcon::issue_option_id>{iid}, preferred);
-				max_weight = ve::select(new_max, new_weight, max_weight);
+		compute_issue_weights(state, ids, owner, lanes, iopt_weights, ttotal);
+		store_issues(state, ids, owner, iopt_weights, ttotal, ibuf);
+	});
+}
 
-				state.world.pop_set_udemographics(ids, i_key, pop_demographics::to_pu8(new_weight));
-			});
+void update_ideologies_and_issues(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& idbuf, issues_buffer& isbuf) {
+	auto new_pop_count = state.world.pop_size();
+	idbuf.update(state, new_pop_count);
+	isbuf.update(state, new_pop_count);
 
-			state.world.pop_set_dominant_issue_option(ids, preferred);
-		} else {
-			state.world.for_each_issue_option([&](dcon::issue_option_id iid) {
-				auto avalue = iopt_weights[iid.index()] / ttotal;
+	assert(state.world.ideology_size() <= 64);
+	assert(state.world.issue_option_size() <= 720);
 
-				auto const i_key = pop_demographics::to_key(state, iid);
-				auto current = pop_demographics::get_demo(state, ids, i_key);
-				auto owner_rate_modifier = (state.world.nation_get_modifier_values(owner, sys::national_mod_offsets::issue_change_speed) + 1.0f);
+	// One pass over the pops for both updates: a block's owner is looked up once and its pops are still in cache when the issue
+	// weights are computed. Both sets of weights are computed before either is written, so neither sees the other's result.
+	pexecute_staggered_blocks(offset, divisions, new_pop_count, [&](auto ids) {
+		ve::fp_vector ideology_weights[64];
+		ve::fp_vector ideology_total = 0.0f;
+		ve::fp_vector issue_weights[720];
+		ve::fp_vector issue_total = 0.0f;
+		auto owner = nations::owner_of_pop(state, ids);
+		auto const lanes = group_lanes_by_pop_type(state, ids);
 
-				ibuf.temp_buffers[iid].set(ids, pop_demographics::to_pu8(ve::select(ttotal > 0.0f,
-					issues_change_rate * owner_rate_modifier * avalue + (1.0f - issues_change_rate * owner_rate_modifier) * current, current)));
-			});
-		}
+		compute_ideology_weights(state, ids, owner, lanes, ideology_weights, ideology_total);
+		compute_issue_weights(state, ids, owner, lanes, issue_weights, issue_total);
+		store_ideologies(state, ids, ideology_weights, ideology_total, idbuf);
+		store_issues(state, ids, owner, issue_weights, issue_total, isbuf);
 	});
 }
 
@@ -3288,125 +2621,109 @@ float get_estimated_conversion(sys::state& state, dcon::pop_id ids) {
 	}
 }
 
+void migration_destinations::update(sys::state& state, bool colonial_targets) {
+	provinces.clear();
+	ranges.clear();
+	for(auto n : state.world.in_nation) {
+		ranges.push_back(uint32_t(provinces.size()));
+		for(auto loc : n.get_province_ownership()) {
+			if(loc.get_province().get_is_colonial() == colonial_targets)
+				provinces.push_back(loc.get_province());
+		}
+		ranges.push_back(uint32_t(provinces.size()));
+		for(auto loc : n.get_province_ownership()) {
+			if(loc.get_province().get_is_colonial() == colonial_targets && loc.get_province().get_state_membership().get_capital().id == loc.get_province().id)
+				provinces.push_back(loc.get_province());
+		}
+	}
+	ranges.push_back(uint32_t(provinces.size()));
+}
+
 namespace impl {
-dcon::province_id get_province_target_in_nation(sys::state& state, dcon::nation_id n, dcon::pop_id p) {
-	/*
-	Destination for internal migration: colonial provinces are not valid targets, nor are non state capital provinces for pop
-	types restricted to capitals. Valid provinces are weighted according to the product of the factors, times the value of the
-	immigration focus
-	+ 1.0 if it is present, times the provinces immigration attractiveness modifier + 1.0. The pop is then distributed more or
-	less evenly over those provinces with positive attractiveness in proportion to their attractiveness, or dumped somewhere at
-	random if no provinces are attractive.
-	*/
-	auto weights_buffer = state.world.province_make_vectorizable_float_buffer();
-	float total_weight = 0.0f;
+/*
+Picks a migration destination for p among the candidate provinces (which must be in ownership order) accepted by
+is_candidate. The migration target modifier is evaluated for all of them in one batch when no compiled version of it is
+available. Provinces that are not candidates have zero weight and so can never be picked, which is why skipping them
+leaves the result unchanged.
+*/
+template<typename F>
+dcon::province_id pick_migration_destination(sys::state& state, std::span<dcon::province_id const> provinces, dcon::pop_id p, uint32_t rng_channel, F&& is_candidate) {
+	thread_local std::vector<int32_t> candidates;
+	thread_local std::vector<float> weights;
 
-	auto pt = state.world.pop_get_poptype(p);
-	auto modifier = state.world.pop_type_get_migration_target(pt);
-	auto modifier_fn = state.world.pop_type_get_migration_target_fn(pt);
+	auto modifier = state.world.pop_type_get_migration_target(state.world.pop_get_poptype(p));
+	auto modifier_fn = state.world.pop_type_get_migration_target_fn(state.world.pop_get_poptype(p));
 	if(!modifier)
 		return dcon::province_id{};
 
-	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(pt);
-	for(auto loc : state.world.nation_get_province_ownership(n)) {
-		if(loc.get_province().get_is_colonial() == false) {
-			if(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id) {
-				float weight = 0.0f;
-				if(modifier_fn) {
-					using ftype = float(*)(int32_t, int32_t);
-					ftype fn = (ftype)modifier_fn;
-					float llvm_result = fn(loc.get_province().id.index(), p.index());
+	candidates.clear();
+	for(auto prov : provinces) {
+		if(is_candidate(prov))
+			candidates.push_back(trigger::to_generic(prov));
+	}
+
+	weights.resize(candidates.size());
+	if(modifier_fn) {
+		using ftype = float(*)(int32_t, int32_t);
+		ftype fn = (ftype)modifier_fn;
+		for(size_t i = 0; i < candidates.size(); ++i) {
+			weights[i] = fn(candidates[i], p.index());
 #ifdef CHECK_LLVM_RESULTS
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					assert(llvm_result == interp_result);
+			float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, candidates[i], trigger::to_generic(p), 0);
+			assert(weights[i] == interp_result);
 #endif
-					weight = llvm_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f);
-				} else {
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					weight = interp_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f);
-				}
-
-				if(weight > 0.0f) {
-					weights_buffer.set(loc.get_province(), weight);
-					total_weight += weight;
-				}
-			}
 		}
+	} else {
+		trigger::evaluate_multiplicative_modifier(state, modifier, candidates, trigger::to_generic(p), 0, weights);
+	}
+
+	float total_weight = 0.0f;
+	for(size_t i = 0; i < candidates.size(); ++i) {
+		float weight = weights[i] * (state.world.province_get_modifier_values(trigger::to_prov(candidates[i]), sys::provincial_mod_offsets::immigrant_attract) + 1.0f);
+		weights[i] = weight > 0.0f ? weight : 0.0f;
+		total_weight += weights[i];
 	}
 
 	if(total_weight <= 0.0f)
 		return dcon::province_id{};
 
-	auto rvalue = float(rng::get_random(state, (uint32_t(p.index()) << 2) | uint32_t(1)) & 0xFFFF) / float(0xFFFF + 1);
-	for(auto loc : state.world.nation_get_province_ownership(n)) {
-		rvalue -= weights_buffer.get(loc.get_province()) / total_weight;
+	auto rvalue = float(rng::get_random(state, (uint32_t(p.index()) << 2) | rng_channel) & 0xFFFF) / float(0xFFFF + 1);
+	for(size_t i = 0; i < candidates.size(); ++i) {
+		rvalue -= weights[i] / total_weight;
 		if(rvalue < 0.0f) {
-			return loc.get_province();
+			return trigger::to_prov(candidates[i]);
 		}
 	}
 
 	return dcon::province_id{};
 }
-dcon::province_id get_colonial_province_target_in_nation(sys::state& state, dcon::nation_id n, dcon::pop_id p) {
+
+dcon::province_id get_province_target_in_nation(sys::state& state, migration_destinations const& destinations, dcon::nation_id n, dcon::pop_id p) {
+	/*
+	Destination for internal migration: colonial provinces are not valid targets, nor are non state capital provinces for pop
+	types restricted to capitals. Valid provinces are weighted according to the product of the factors, times the value of the
+	immigration focus
+	+ 1.0 if it is present, times the provinces immigration attractiveness modifier + 1.0. The pop is then distributed more or
+	less evenly over those provinces with positive attractiveness in proportion to their attractiveness, or dumped somewhere at
+	random if no provinces are attractive.
+	*/
+	assert(!destinations.ranges.empty());
+	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(state.world.pop_get_poptype(p));
+	return pick_migration_destination(state, destinations.get(n, limit_to_capitals), p, 1, [](dcon::province_id) { return true; });
+}
+dcon::province_id get_colonial_province_target_in_nation(sys::state& state, migration_destinations const& destinations, dcon::nation_id n, dcon::pop_id p) {
 	/*
 	 *only* colonial provinces are valid targets, and pops belonging to cultures with "overseas" = false set will not colonially
 	 *migrate outside the same continent. The same trigger seems to be used as internal migration for weighting the colonial
 	 *provinces.
 	 */
-	auto weights_buffer = state.world.province_make_vectorizable_float_buffer();
-	float total_weight = 0.0f;
-
-	auto modifier = state.world.pop_type_get_migration_target(state.world.pop_get_poptype(p));
-	auto modifier_fn = state.world.pop_type_get_migration_target_fn(state.world.pop_get_poptype(p));
-	if(!modifier)
-		return dcon::province_id{};
-
 	auto overseas_culture = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
 	auto home_continent = state.world.province_get_continent(state.world.pop_get_province_from_pop_location(p));
 
 	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(state.world.pop_get_poptype(p));
-	for(auto loc : state.world.nation_get_province_ownership(n)) {
-		if(loc.get_province().get_is_colonial() == true) {
-			if((overseas_culture || loc.get_province().get_continent() == home_continent) &&
-					(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id)) {
-
-				float weight = 0.0f;
-				if(modifier_fn) {
-					using ftype = float(*)(int32_t, int32_t);
-					ftype fn = (ftype)modifier_fn;
-					float llvm_result = fn(loc.get_province().id.index(), p.index());
-#ifdef CHECK_LLVM_RESULTS
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					assert(llvm_result == interp_result);
-#endif
-					weight = llvm_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f);
-				} else {
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					weight = interp_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f);
-				}
-
-				if(weight > 0.0f) {
-					if(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id) {
-						weights_buffer.set(loc.get_province(), weight);
-						total_weight += weight;
-					}
-				}
-			}
-		}
-	}
-
-	if(total_weight <= 0.0f)
-		return dcon::province_id{};
-
-	auto rvalue = float(rng::get_random(state, (uint32_t(p.index()) << 2) | uint32_t(2)) & 0xFFFF) / float(0xFFFF + 1);
-	for(auto loc : state.world.nation_get_province_ownership(n)) {
-		rvalue -= weights_buffer.get(loc.get_province()) / total_weight;
-		if(rvalue < 0.0f) {
-			return loc.get_province();
-		}
-	}
-
-	return dcon::province_id{};
+	return pick_migration_destination(state, destinations.get(n, limit_to_capitals), p, 2, [&](dcon::province_id prov) {
+		return overseas_culture || state.world.province_get_continent(prov) == home_continent;
+	});
 }
 
 dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner, dcon::pop_id p, sys::date day) {
@@ -3492,6 +2809,7 @@ dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner,
 
 void update_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	pbuf.candidates.update(state, false);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3517,7 +2835,7 @@ void update_internal_migration(sys::state& state, uint32_t offset, uint32_t divi
 					if(state.world.pop_get_poptype(p) == state.culture_definitions.slaves)
 						return; // early exit
 
-					auto dest = impl::get_province_target_in_nation(state, owner, p);
+					auto dest = impl::get_province_target_in_nation(state, pbuf.candidates, owner, p);
 
 					//if(pop_size < small_pop_size) {
 					//	pbuf.amounts.set(p, pop_size);
@@ -3554,6 +2872,7 @@ float get_estimated_internal_migration(sys::state& state, dcon::pop_id ids) {
 
 void update_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	pbuf.candidates.update(state, true);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3597,7 +2916,7 @@ void update_colonial_migration(sys::state& state, uint32_t offset, uint32_t divi
 					pbuf.amounts.set(p, std::min(pop_size, std::ceil(amount)));
 					//}
 
-					auto dest = impl::get_colonial_province_target_in_nation(state, owner, p);
+					auto dest = impl::get_colonial_province_target_in_nation(state, pbuf.candidates, owner, p);
 					pbuf.destinations.set(p, dest);
 				},
 				ids, loc, owners, amounts, pop_sizes);
@@ -3637,6 +2956,7 @@ float get_estimated_colonial_migration(sys::state& state, dcon::pop_id ids) {
 
 void update_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	pbuf.candidates.update(state, false);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3684,7 +3004,7 @@ void update_immigration(sys::state& state, uint32_t offset, uint32_t divisions,
 					//}
 
 					auto ndest = impl::get_immigration_target(state, owner, p, state.current_date);
-					auto dest = impl::get_province_target_in_nation(state, ndest, p);
+					auto dest = impl::get_province_target_in_nation(state, pbuf.candidates, ndest, p);
 
 					pbuf.destinations.set(p, dest);
 				},
@@ -3758,20 +3078,33 @@ float get_estimated_emigration(sys::state& state, dcon::pop_id ids) {
 }
 
 namespace impl {
-dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid,
-		dcon::pop_type_id ptid, float l) {
+dcon::pop_type_id pop_type_in_province(sys::state& state, dcon::province_id loc, dcon::pop_type_id ptid) {
 	bool is_mine = state.world.commodity_get_is_mine(state.world.province_get_rgo(loc));
 	if(is_mine && ptid == state.culture_definitions.farmers) {
-		ptid = state.culture_definitions.laborers;
+		return state.culture_definitions.laborers;
 	} else if(!is_mine && ptid == state.culture_definitions.laborers) {
-		ptid = state.culture_definitions.farmers;
+		return state.culture_definitions.farmers;
 	}
-	// TODO: fix state capital only type pops ?
+	return ptid;
+}
+
+// ptid must already have gone through pop_type_in_province
+dcon::pop_id find_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid, dcon::pop_type_id ptid) {
 	for(auto pl : state.world.province_get_pop_location(loc)) {
 		if(pl.get_pop().get_culture() == cid && pl.get_pop().get_religion() == rid && pl.get_pop().get_poptype() == ptid) {
 			return pl.get_pop();
 		}
 	}
+	return dcon::pop_id{};
+}
+
+dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid,
+		dcon::pop_type_id ptid, float l) {
+	ptid = pop_type_in_province(state, loc, ptid);
+	// TODO: fix state capital only type pops ?
+	if(auto existing = find_pop(state, loc, cid, rid, ptid); existing)
+		return existing;
+
 	auto np = fatten(state.world, state.world.create_pop());
 	state.world.force_create_pop_location(np, loc);
 	np.set_culture(cid);
@@ -3861,145 +3194,188 @@ dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::cu
 	}
 	return np;
 }
-} // namespace impl
 
-void apply_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
+struct pop_transfer_target {
+	dcon::province_id location;
+	dcon::culture_id culture;
+	dcon::religion_id religion;
+	dcon::pop_type_id type;
+};
+
+/*
+Moves part of a pop into the pop matching the target returned by target_of, making that pop if it does not exist yet.
+Looking up existing target pops is the expensive part and is done in parallel first. The transfers themselves, and the
+creation of any missing pops, are then applied in the same order as a plain serial loop. Lookups cannot go stale in the
+meantime: pops are only ever appended to a province, and one is only made when no pop with its key exists there, so the
+first match found beforehand is still the first match. The lookup is nevertheless checked again before it is used in case
+a new pop reused the id of a pop removed earlier.
+*/
+template<typename T, typename A>
+void apply_pop_transfers(sys::state& state, uint32_t offset, uint32_t divisions, uint32_t max, T&& target_of, A&& transfer) {
+	static std::vector<dcon::pop_id> found;
+	if(found.size() < max + 16)
+		found.resize(max + 16);
+
+	pexecute_staggered_blocks(offset, divisions, max, [&](auto ids) {
+		ve::apply(
+				[&](dcon::pop_id p) {
+					pop_transfer_target t;
+					if(target_of(p, t)) {
+						found[p.index()] = find_pop(state, t.location, t.culture, t.religion, pop_type_in_province(state, t.location, t.type));
+					} else {
+						found[p.index()] = dcon::pop_id{};
+					}
+				},
+				ids);
+	});
+
+	execute_staggered_blocks(offset, divisions, max, [&](auto ids) {
 		ve::apply(
 				[&](dcon::pop_id p) {
-					if(pbuf.amounts.get(p) > 0.0f && pbuf.types.get(p)) {
-						auto target_pop = impl::find_or_make_pop(state, state.world.pop_get_province_from_pop_location(p),
-								state.world.pop_get_culture(p), state.world.pop_get_religion(p), pbuf.types.get(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+					pop_transfer_target t;
+					if(target_of(p, t)) {
+						auto target_pop = found[p.index()];
+						if(!target_pop
+							|| state.world.pop_get_province_from_pop_location(target_pop) != t.location
+							|| state.world.pop_get_culture(target_pop) != t.culture
+							|| state.world.pop_get_religion(target_pop) != t.religion
+							|| state.world.pop_get_poptype(target_pop) != pop_type_in_province(state, t.location, t.type)) {
+							target_pop = find_or_make_pop(state, t.location, t.culture, t.religion, t.type, pop_demographics::get_literacy(state, p));
+						}
+						transfer(p, target_pop);
 					}
 				},
 				ids);
 	});
 }
+} // namespace impl
+
+void apply_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf) {
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f && pbuf.types.get(p)) {
+				t = impl::pop_transfer_target{ state.world.pop_get_province_from_pop_location(p), state.world.pop_get_culture(p), state.world.pop_get_religion(p), pbuf.types.get(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			state.world.pop_get_size(p) -= pbuf.amounts.get(p);
+			state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+		});
+}
 
 void apply_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf) {
-	if(bool(state.defines.alice_nurture_religion_assimilation)) {
-		auto exec_fn = [&](auto ids) {
-			auto locs = state.world.pop_get_province_from_pop_location(ids);
-			ve::apply([&](dcon::pop_id p, dcon::province_id l, dcon::culture_id dac) {
-				if(pbuf.amounts.get(p) > 0.0f) {
-					//auto o = nations::owner_of_pop(state, p);
-					auto cul = dac ? dac : state.world.province_get_dominant_culture(l);
-					auto rel = state.world.pop_get_religion(p);
-					assert(state.world.pop_get_poptype(p));
-					auto target_pop = impl::find_or_make_pop(state, l, cul, rel, state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-					state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-					state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-				}
-			},
-			ids, locs, state.world.province_get_dominant_accepted_culture(locs));
-		};
-		execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), exec_fn);
-	} else {
-		auto exec_fn = [&](auto ids) {
-			auto locs = state.world.pop_get_province_from_pop_location(ids);
-			ve::apply([&](dcon::pop_id p, dcon::province_id l, dcon::culture_id dac) {
-				if(pbuf.amounts.get(p) > 0.0f) {
-					//auto o = nations::owner_of_pop(state, p);
-					auto cul = dac ? dac : state.world.province_get_dominant_culture(l);
-					auto rel = dac
+	bool nurture_religion = bool(state.defines.alice_nurture_religion_assimilation);
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f) {
+				//auto o = nations::owner_of_pop(state, p);
+				auto l = state.world.pop_get_province_from_pop_location(p);
+				auto dac = state.world.province_get_dominant_accepted_culture(l);
+				auto cul = dac ? dac : state.world.province_get_dominant_culture(l);
+				auto rel = nurture_religion
+					? state.world.pop_get_religion(p)
+					: (dac
 						? state.world.nation_get_religion(nations::owner_of_pop(state, p))
-						: state.world.province_get_dominant_religion(l);
-					assert(state.world.pop_get_poptype(p));
-					auto target_pop = impl::find_or_make_pop(state, l, cul, rel, state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-					state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-					state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-				}
-			},
-			ids, locs, state.world.province_get_dominant_accepted_culture(locs));
-			};
-		execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), exec_fn);
-	}
+						: state.world.province_get_dominant_religion(l));
+				assert(state.world.pop_get_poptype(p));
+				t = impl::pop_transfer_target{ l, cul, rel, state.world.pop_get_poptype(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			state.world.pop_get_size(p) -= pbuf.amounts.get(p);
+			state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+		});
 }
 
 void apply_conversion(sys::state& state, uint32_t offset, uint32_t divisions, conversion_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		auto locs = state.world.pop_get_province_from_pop_location(ids);
-		ve::apply(
-				[&](dcon::pop_id p, dcon::province_id l) {
-					if(pbuf.amounts.get(p) > 0.0f) {
-						auto state_rel = state.world.nation_get_religion(nations::owner_of_pop(state, p));
-						auto rel = state_rel
-							? state_rel
-							: state.world.province_get_dominant_religion(l);
-						assert(state.world.pop_get_poptype(p));
-						assert(state.world.pop_get_culture(p));
-						auto target_pop = impl::find_or_make_pop(state, l, state.world.pop_get_culture(p), rel, state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-					}
-				},
-				ids, locs);
-	});
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f) {
+				auto l = state.world.pop_get_province_from_pop_location(p);
+				auto state_rel = state.world.nation_get_religion(nations::owner_of_pop(state, p));
+				auto rel = state_rel
+					? state_rel
+					: state.world.province_get_dominant_religion(l);
+				assert(state.world.pop_get_poptype(p));
+				assert(state.world.pop_get_culture(p));
+				t = impl::pop_transfer_target{ l, state.world.pop_get_culture(p), rel, state.world.pop_get_poptype(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			state.world.pop_get_size(p) -= pbuf.amounts.get(p);
+			state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+		});
 }
 
 void apply_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		ve::apply(
-				[&](dcon::pop_id p) {
-					if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
-						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
-								pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
-					}
-				},
-				ids);
-	});
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
+				assert(state.world.pop_get_poptype(p));
+				t = impl::pop_transfer_target{ pbuf.destinations.get(p), state.world.pop_get_culture(p), state.world.pop_get_religion(p), state.world.pop_get_poptype(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			state.world.pop_get_size(p) -= pbuf.amounts.get(p);
+			state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+			state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
+					pbuf.amounts.get(p);
+			state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
+		});
 }
 
 void apply_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		ve::apply(
-				[&](dcon::pop_id p) {
-					if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
-						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
-								pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
-					}
-				},
-				ids);
-	});
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
+				assert(state.world.pop_get_poptype(p));
+				t = impl::pop_transfer_target{ pbuf.destinations.get(p), state.world.pop_get_culture(p), state.world.pop_get_religion(p), state.world.pop_get_poptype(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			state.world.pop_get_size(p) -= pbuf.amounts.get(p);
+			state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+			state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
+					pbuf.amounts.get(p);
+			state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
+		});
 }
 
 void apply_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		ve::apply(
-				[&](dcon::pop_id p) {
-					auto amount = pbuf.amounts.get(p);
-					if(amount > 0.0f && pbuf.destinations.get(p)) {
-						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-
-						state.world.pop_get_size(p) -= amount;
-						state.world.pop_get_size(target_pop) += amount;
-						state.world.province_get_daily_net_immigration(state.world.pop_get_province_from_pop_location(p)) -= amount;
-						state.world.province_get_daily_net_immigration(pbuf.destinations.get(p)) += amount;
-						state.world.province_set_last_immigration(pbuf.destinations.get(p), state.current_date);
-					}
-				},
-				ids);
-	});
+	impl::apply_pop_transfers(state, offset, divisions, std::min(state.world.pop_size(), pbuf.size),
+		[&](dcon::pop_id p, impl::pop_transfer_target& t) {
+			if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
+				assert(state.world.pop_get_poptype(p));
+				t = impl::pop_transfer_target{ pbuf.destinations.get(p), state.world.pop_get_culture(p), state.world.pop_get_religion(p), state.world.pop_get_poptype(p) };
+				return true;
+			}
+			return false;
+		},
+		[&](dcon::pop_id p, dcon::pop_id target_pop) {
+			auto amount = pbuf.amounts.get(p);
+			state.world.pop_get_size(p) -= amount;
+			state.world.pop_get_size(target_pop) += amount;
+			state.world.province_get_daily_net_immigration(state.world.pop_get_province_from_pop_location(p)) -= amount;
+			state.world.province_get_daily_net_immigration(pbuf.destinations.get(p)) += amount;
+			state.world.province_set_last_immigration(pbuf.destinations.get(p), state.current_date);
+		});
 }
 
 void remove_size_zero_pops(sys::state& state) {
 	// IMPORTANT: we count down here so that we can delete as we go, compacting from the end
+	// deleting moves the last pop into the freed slot, so the pops of a province drift apart in memory over time. We don't
+	// re-sort them by location: pop ids seed the per-pop random rolls and are stored in the migration, promotion and
+	// rebel bookkeeping, so renumbering them would change the outcome of the campaign
 	for(auto last = state.world.pop_size(); last-- > 0;) {
 		dcon::pop_id m{dcon::pop_id::value_base_t(last)};
 		if(state.world.pop_get_size(m) < 1.0f) {
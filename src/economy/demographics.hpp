@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include "dcon_generated.hpp"
 #include "system_state.hpp"
 
@@ -266,9 +267,25 @@ struct conversion_buffer {
 	}
 };
 
+// the provinces each nation could receive migrants in, listed in ownership order; rebuilt at the start of each migration
+// update so that migrating pops don't have to filter the whole ownership list of their destination nation
+struct migration_destinations {
+	std::vector<dcon::province_id> provinces;
+	std::vector<uint32_t> ranges; // two ranges per nation: every candidate, then only the state capitals
+
+	void update(sys::state& state, bool colonial_targets);
+	std::span<dcon::province_id const> get(dcon::nation_id n, bool capitals_only) const {
+		if(!n || 2 * uint32_t(n.index()) + 2 >= uint32_t(ranges.size()))
+			return std::span<dcon::province_id const>{};
+		auto i = 2 * uint32_t(n.index()) + (capitals_only ? 1 : 0);
+		return std::span<dcon::province_id const>(provinces.data() + ranges[i], ranges[i + 1] - ranges[i]);
+	}
+};
+
 struct migration_buffer {
 	ve::vectorizable_buffer<float, dcon::pop_id> amounts;
 	ve::vectorizable_buffer<dcon::province_id, dcon::pop_id> destinations;
+	migration_destinations candidates;
 	uint32_t size = 0;
 	uint32_t reserved = 0;
 
@@ -283,11 +300,28 @@ struct migration_buffer {
 	}
 };
 
+// The staging buffers of the daily pop updates. They are owned by the state so that they are sized for the loaded scenario
+// (remade when a different save or scenario is loaded) and reused from one tick to the next rather than reallocated.
+struct tick_buffers {
+	ideology_buffer idbuf;
+	issues_buffer isbuf;
+	promotion_buffer pbuf;
+	assimilation_buffer abuf;
+	conversion_buffer rbuf;
+	migration_buffer mbuf;
+	migration_buffer cmbuf;
+	migration_buffer imbuf;
+
+	tick_buffers(sys::state& state) : idbuf(state), isbuf(state) { }
+};
+
 void update_literacy(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_consciousness(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_militancy(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& ibuf);
 void update_issues(sys::state& state, uint32_t offset, uint32_t divisions, issues_buffer& ibuf);
+// update_ideologies and update_issues over the same slice of pops, fused into a single pass
+void update_ideologies_and_issues(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& idbuf, issues_buffer& isbuf);
 void update_growth(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf);
 void update_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf);
@@ -299,6 +333,8 @@ void update_conversion(sys::state& state, uint32_t offset, uint32_t divisions, c
 float get_estimated_literacy_change(sys::state& state, dcon::nation_id n);
 float get_estimated_mil_change(sys::state& state, dcon::nation_id n);
 float get_estimated_con_change(sys::state& state, dcon::nation_id n);
+// the three estimates above, computed in a single pass over the pops of n and reused until the game state next changes
+culture::estimated_pop_changes const& get_estimated_changes(sys::state& state, dcon::nation_id n);
 float get_estimated_promotion(sys::state& state, dcon::nation_id n);
 
 void apply_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& pbuf);
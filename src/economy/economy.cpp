@@ -42,6 +42,27 @@ void register_domestic_supply(sys::state& state, dcon::nation_id n, dcon::commod
 	state.world.nation_get_gdp(n) += amount * state.world.commodity_get_current_price(commodity_type);
 }
 
+// intermediate demand computed concurrently is recorded here first; commit then registers it in the order it was recorded,
+// so the nation's sums come out exactly as if every amount had been registered directly
+struct intermediate_demand_ledger {
+	struct entry {
+		dcon::commodity_id commodity_type;
+		float amount = 0.0f;
+		economy_reason reason = economy_reason::pop;
+	};
+	std::vector<entry> entries;
+
+	void add(dcon::commodity_id commodity_type, float amount, economy_reason reason) {
+		entries.push_back(entry{ commodity_type, amount, reason });
+	}
+	void commit(sys::state& state, dcon::nation_id n) {
+		for(auto& e : entries) {
+			register_intermediate_demand(state, n, e.commodity_type, e.amount, e.reason);
+		}
+		entries.clear();
+	}
+};
+
 template void for_each_new_factory<std::function<void(new_factory)>>(sys::state&, dcon::state_instance_id, std::function<void(new_factory)>&&);
 template void for_each_upgraded_factory<std::function<void(upgraded_factory)>>(sys::state&, dcon::state_instance_id, std::function<void(upgraded_factory)>&&);
 
@@ -95,6 +116,43 @@ int32_t previous_gdp_record_index(sys::state& state) {
 	return ((date.year * 4 + date.month / 3) + gdp_history_length - 1) % gdp_history_length;
 }
 
+int32_t most_recent_yearly_record_index(sys::state& state) {
+	auto date = state.current_date.to_ymd(state.start_date);
+	return date.year % yearly_history_length;
+}
+
+uint16_t encode_history_value(float v) {
+	auto l = std::log2(1.0f + std::max(v, 0.0f)) * 1024.0f;
+	return uint16_t(std::clamp(l + 0.5f, 0.0f, 65535.0f));
+}
+float decode_history_value(uint16_t v) {
+	return std::exp2(float(v) / 1024.0f) - 1.0f;
+}
+
+float yearly_price_record(sys::state& state, dcon::commodity_id c, int32_t years_ago) {
+	auto index = (most_recent_yearly_record_index(state) + yearly_history_length - uint32_t(years_ago) % yearly_history_length) % yearly_history_length;
+	return decode_history_value(state.world.commodity_get_yearly_price_record(c, index));
+}
+float yearly_gdp_record(sys::state& state, dcon::nation_id n, int32_t years_ago) {
+	auto index = (most_recent_yearly_record_index(state) + yearly_history_length - uint32_t(years_ago) % yearly_history_length) % yearly_history_length;
+	return decode_history_value(state.world.nation_get_yearly_gdp_record(n, index));
+}
+float yearly_population_record(sys::state& state, dcon::nation_id n, int32_t years_ago) {
+	auto index = (most_recent_yearly_record_index(state) + yearly_history_length - uint32_t(years_ago) % yearly_history_length) % yearly_history_length;
+	return decode_history_value(state.world.nation_get_yearly_population_record(n, index));
+}
+
+void update_yearly_records(sys::state& state) {
+	auto index = most_recent_yearly_record_index(state);
+	for(auto c : state.world.in_commodity) {
+		c.set_yearly_price_record(index, encode_history_value(c.get_current_price()));
+	}
+	for(auto n : state.world.in_nation) {
+		n.set_yearly_gdp_record(index, encode_history_value(gdp_adjusted(state, n)));
+		n.set_yearly_population_record(index, encode_history_value(n.get_demographics(demographics::total)));
+	}
+}
+
 float ideal_pound_conversion_rate(sys::state& state, dcon::nation_id n) {
 	return state.world.nation_get_life_needs_costs(n, state.culture_definitions.primary_factory_worker)
 		+ 0.1f * state.world.nation_get_everyday_needs_costs(n, state.culture_definitions.primary_factory_worker);
@@ -369,6 +427,7 @@ void convert_commodities_into_ingredients(
 
 void presimulate(sys::state& state) {
 	// economic updates without construction
+	ai::schedule_all_ai_planning(state);
 #ifdef NDEBUG
 	for(uint32_t i = 0; i < 365; i++) {
 #else
@@ -607,6 +666,9 @@ void initialize(sys::state& state) {
 		for(uint32_t i = 0; i < price_history_length; ++i) {
 			fc.set_price_record(i, fc.get_cost());
 		}
+		for(uint32_t i = 0; i < yearly_history_length; ++i) {
+			fc.set_yearly_price_record(i, encode_history_value(fc.get_cost()));
+		}
 		// fc.set_global_market_pool();
 	});
 
@@ -805,6 +867,23 @@ void initialize(sys::state& state) {
 	state.world.for_each_nation([&](dcon::nation_id n) {
 		state.world.nation_set_stockpiles(n, money, 2.0f * full_spending_cost(state, n));
 	});
+
+	update_rgo_goods(state);
+}
+
+void update_rgo_goods(sys::state& state) {
+	auto& start = state.province_definitions.rgo_goods_start;
+	auto& goods = state.province_definitions.rgo_goods;
+	start.clear();
+	goods.clear();
+	state.world.for_each_province([&](dcon::province_id p) {
+		start.push_back(uint32_t(goods.size()));
+		state.world.for_each_commodity([&](dcon::commodity_id c) {
+			if(state.world.province_get_rgo_max_size_per_good(p, c) != 0.0f)
+				goods.push_back(c);
+		});
+	});
+	start.push_back(uint32_t(goods.size()));
 }
 
 float sphere_leader_share_factor(sys::state& state, dcon::nation_id sphere_leader, dcon::nation_id sphere_member) {
@@ -874,7 +953,11 @@ float global_market_price_multiplier(sys::state& state, dcon::nation_id n) {
 }
 
 void update_factory_triggered_modifiers(sys::state& state) {
-	state.world.for_each_factory([&](dcon::factory_id f) {
+	// every factory evaluates its own bonus triggers and only writes its own value
+	concurrency::parallel_for(uint32_t(0), state.world.factory_size(), [&](uint32_t i) {
+		dcon::factory_id f{ dcon::factory_id::value_base_t(i) };
+		if(!state.world.factory_is_valid(f))
+			return;
 		auto fac_type = fatten(state.world, state.world.factory_get_building_type(f));
 		float sum = 1.0f;
 		auto prov = state.world.factory_get_province_from_factory_location(f);
@@ -1418,6 +1501,27 @@ float factory_e_input_total_cost(sys::state& state, dcon::nation_id n, dcon::fac
 	return e_input_total;
 }
 
+// the costs and availability of a factory type's inputs as seen by one nation; they are the same for every factory of
+// that type the nation owns and stay fixed from populate_effective_prices until the day's purchasing
+struct factory_type_input_summary {
+	float input_total = 0.0f;
+	float min_input_available = 1.0f;
+	float e_input_total = 0.0f;
+	float min_e_input_available = 1.0f;
+};
+
+void populate_factory_type_input_summaries(sys::state& state, dcon::nation_id n, std::vector<factory_type_input_summary>& summaries) {
+	summaries.resize(state.world.factory_type_size());
+	state.world.for_each_factory_type([&](dcon::factory_type_id t) {
+		auto fac_type = fatten(state.world, t);
+		auto& summary = summaries[t.index()];
+		summary.input_total = factory_input_total_cost(state, n, fac_type);
+		summary.min_input_available = factory_min_input_available(state, n, fac_type);
+		summary.e_input_total = factory_e_input_total_cost(state, n, fac_type);
+		summary.min_e_input_available = factory_min_e_input_available(state, n, fac_type);
+	});
+}
+
 float nation_factory_input_multiplier(sys::state& state, dcon::nation_id n) {
 	return std::max(
 		0.1f,
@@ -1533,7 +1637,7 @@ float factory_desired_raw_profit(dcon::factory_fat_id fac, float spendings) {
 	return spendings * (1.2f + fac.get_secondary_employment() * fac.get_level() / 150.f );
 }
 
-void update_single_factory_consumption(sys::state& state, dcon::factory_id f, dcon::nation_id n, dcon::province_id p, dcon::state_instance_id s, float mobilization_impact, float expected_min_wage, bool occupied) {
+void update_single_factory_consumption(sys::state& state, intermediate_demand_ledger& demand, std::vector<factory_type_input_summary> const& type_inputs, dcon::factory_id f, dcon::nation_id n, dcon::province_id p, dcon::state_instance_id s, float mobilization_impact, float expected_min_wage, bool occupied) {
 	auto fac = fatten(state.world, f);
 	auto fac_type = fac.get_building_type();
 
@@ -1556,10 +1660,11 @@ void update_single_factory_consumption(sys::state& state, dcon::factory_id f, dc
 
 	//inputs
 
-	float input_total = factory_input_total_cost(state, n, fac_type);
-	float min_input_available = factory_min_input_available(state, n, fac_type);
-	float e_input_total = factory_e_input_total_cost(state, n , fac_type);
-	float min_e_input_available = factory_min_e_input_available(state, n, fac_type);
+	auto& type_summary = type_inputs[fac_type.id.index()];
+	float input_total = type_summary.input_total;
+	float min_input_available = type_summary.min_input_available;
+	float e_input_total = type_summary.e_input_total;
+	float min_e_input_available = type_summary.min_e_input_available;
 
 	//modifiers
 
@@ -1623,8 +1728,7 @@ void update_single_factory_consumption(sys::state& state, dcon::factory_id f, dc
 	
 	for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
 		if(inputs.commodity_type[i]) {
-			register_intermediate_demand(state,
-				n,
+			demand.add(
 				inputs.commodity_type[i],
 				input_scale
 				* inputs.commodity_amounts[i]
@@ -1640,9 +1744,7 @@ void update_single_factory_consumption(sys::state& state, dcon::factory_id f, dc
 	//  throughput-multiplier x factory level
 	for(uint32_t i = 0; i < small_commodity_set::set_size; ++i) {
 		if(e_inputs.commodity_type[i]) {
-			register_intermediate_demand(
-				state,
-				n,
+			demand.add(
 				e_inputs.commodity_type[i],
 				mfactor
 				* input_scale
@@ -1819,7 +1921,12 @@ void update_province_rgo_consumption(
 	auto rgo_pops = rgo_relevant_population(state, p, n);
 	float desired_profit = rgo_desired_worker_norm_profit(state, p, n, expected_min_wage, rgo_pops.total);
 
-	state.world.for_each_commodity([&](dcon::commodity_id c) {
+	/*
+	any other good has an effective size of zero here, so its production would be below the threshold anyway
+	*/
+	auto main_rgo = state.world.province_get_rgo(p);
+	bool main_rgo_listed = false;
+	auto update_good = [&](dcon::commodity_id c) {
 		auto max_production = rgo_full_production_quantity(state, n, p, c);
 		if(max_production < 0.001f) {
 			return;
@@ -1849,7 +1956,17 @@ void update_province_rgo_consumption(
 		float employment_ratio = current_employment / pops_max;
 		assert(max_production * employment_ratio >= 0);
 		state.world.province_set_rgo_actual_production_per_good(p, c, max_production * employment_ratio);
-	});	
+	};
+
+	auto& goods = state.province_definitions.rgo_goods;
+	auto& start = state.province_definitions.rgo_goods_start;
+	for(uint32_t i = start[p.index()]; i < start[p.index() + 1]; ++i) {
+		main_rgo_listed = main_rgo_listed || goods[i] == main_rgo;
+		update_good(goods[i]);
+	}
+	if(main_rgo && !main_rgo_listed) {
+		update_good(main_rgo);
+	}
 }
 
 void update_province_rgo_production(sys::state& state, dcon::province_id p, dcon::nation_id n) {
@@ -2061,6 +2178,20 @@ float global_factory_construction_time_modifier(sys::state& state) {
 	return day_inf_build_time_modifier_factory + slope_factory / (t + shift_factory);
 }
 
+// land provinces with at least one naval construction, in ascending order, so that walking them visits the head of each
+// shipyard queue in the same order as a walk over every land province would
+void collect_naval_construction_provinces(sys::state& state, std::vector<dcon::province_id>& result) {
+	result.clear();
+	auto last = state.province_definitions.first_sea_province.index();
+	for(auto c : state.world.in_province_naval_construction) {
+		auto p = c.get_province().id;
+		if(p && p.index() < last)
+			result.push_back(p);
+	}
+	std::sort(result.begin(), result.end(), [](dcon::province_id a, dcon::province_id b) { return a.index() < b.index(); });
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
 void populate_construction_consumption(sys::state& state) {
 	uint32_t total_commodities = state.world.commodity_size();
 	for(uint32_t i = 1; i < total_commodities; ++i) {
@@ -2094,10 +2225,12 @@ void populate_construction_consumption(sys::state& state) {
 		}
 	}
 
-	province::for_each_land_province(state, [&](dcon::province_id p) {
+	static std::vector<dcon::province_id> shipyards;
+	collect_naval_construction_provinces(state, shipyards);
+	for(auto p : shipyards) {
 		auto owner = state.world.province_get_nation_from_province_ownership(p);
 		if(!owner || state.world.province_get_nation_from_province_control(p) != owner)
-			return;
+			continue;
 		{
 			auto rng = state.world.province_get_province_naval_construction(p);
 			if(rng.begin() != rng.end()) {
@@ -2121,7 +2254,7 @@ void populate_construction_consumption(sys::state& state) {
 				}
 			}
 		}
-	});
+	}
 
 	for(auto c : state.world.in_province_building_construction) {
 		auto owner = c.get_nation().id;
@@ -2422,7 +2555,22 @@ void update_national_consumption(sys::state& state, dcon::nation_id n, float spe
 	}
 }
 
-void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_demand, float invention_factor) {
+// marks the commodities that appear in the life, everyday or luxury needs of at least one pop type; every other commodity
+// only ever adds exact zeros to the needs costs and pop demand, so those passes may skip it
+void find_commodities_in_pop_needs(sys::state& state, std::vector<bool>& in_pop_needs) {
+	in_pop_needs.assign(state.world.commodity_size(), false);
+	state.world.for_each_commodity([&](dcon::commodity_id c) {
+		state.world.for_each_pop_type([&](dcon::pop_type_id t) {
+			if(state.world.pop_type_get_life_needs(t, c) != 0.0f
+				|| state.world.pop_type_get_everyday_needs(t, c) != 0.0f
+				|| state.world.pop_type_get_luxury_needs(t, c) != 0.0f) {
+				in_pop_needs[c.index()] = true;
+			}
+		});
+	});
+}
+
+void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_demand, float invention_factor, std::vector<bool> const& in_pop_needs) {
 	uint32_t total_commodities = state.world.commodity_size();
 
 	static auto ln_demand_vector = state.world.pop_type_make_vectorizable_float_buffer();
@@ -2435,9 +2583,36 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 	// state.defines.alice_needs_scaling_factor
 	auto nation_rules = state.world.nation_get_combined_issue_rules(n);
 	bool nation_allows_investment = state.world.nation_get_is_civilized(n) && (nation_rules & (issue_rule::pop_build_factory | issue_rule::pop_expand_factory)) != 0;
+	/*
+	the pops of each province are updated concurrently; what each pop adds to the per type demand and to private
+	investment is stored in pop_results and summed afterwards in the original province and pop order
+	*/
+	struct pop_consumption_result {
+		dcon::pop_type_id type;
+		float life = 0.0f;
+		float everyday = 0.0f;
+		float luxury = 0.0f;
+		float investment = 0.0f;
+	};
+	static std::vector<dcon::province_id> provinces;
+	static std::vector<uint32_t> first_pop;
+	static std::vector<pop_consumption_result> pop_results;
+	provinces.clear();
+	first_pop.clear();
+	uint32_t pop_count = 0;
 	for(auto p : state.world.nation_get_province_ownership(n)) {
+		provinces.push_back(p.get_province());
+		first_pop.push_back(pop_count);
+		auto pops = state.world.province_get_pop_location(p.get_province());
+		pop_count += uint32_t(pops.end() - pops.begin());
+	}
+	pop_results.resize(pop_count);
 
-		float subsistence = adjusted_subsistence_score(state, p.get_province());
+	concurrency::parallel_for(0, int32_t(provinces.size()), [&](int32_t province_index) {
+		auto p = fatten(state.world, provinces[province_index]);
+		uint32_t pop_index = first_pop[province_index];
+
+		float subsistence = adjusted_subsistence_score(state, p);
 		float subsistence_life = std::clamp(subsistence, 0.f, subsistence_score_life);
 		subsistence -= subsistence_life;
 		float subsistence_everyday = std::clamp(subsistence, 0.f, subsistence_score_everyday);
@@ -2448,7 +2623,9 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 		subsistence_everyday /= subsistence_score_everyday;
 		subsistence_luxury /= subsistence_score_luxury;
 
-		for(auto pl : state.world.province_get_pop_location(p.get_province())) {
+		for(auto pl : p.get_pop_location()) {
+			auto& result = pop_results[pop_index++];
+			result = pop_consumption_result{};
 			auto t = pl.get_pop().get_poptype();
 			assert(t);
 			auto total_budget = pl.get_pop().get_savings();
@@ -2474,10 +2651,10 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 			if(!nation_allows_investment || (t != state.culture_definitions.aristocrat && t != state.culture_definitions.capitalists)) {
 
 			} else if(t == state.culture_definitions.capitalists) {
-				state.world.nation_get_private_investment(n) += total_budget * state.defines.alice_invest_capitalist;
+				result.investment = total_budget * state.defines.alice_invest_capitalist;
 				total_budget -= total_budget * state.defines.alice_invest_capitalist;
 			} else {
-				state.world.nation_get_private_investment(n) += total_budget * state.defines.alice_invest_aristocrat;
+				result.investment = total_budget * state.defines.alice_invest_aristocrat;
 				total_budget -= total_budget * state.defines.alice_invest_aristocrat;
 			}
 
@@ -2536,14 +2713,25 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 			pop_demographics::set_everyday_needs(state, pl.get_pop(), std::clamp(old_everyday * 0.99f + final_everyday_needs_fraction * 0.01f, 0.f, 1.f));
 			pop_demographics::set_luxury_needs(state, pl.get_pop(), std::clamp(old_luxury * 0.99f + final_luxury_needs_fraction * 0.01f, 0.f, 1.f));
 
-			ln_demand_vector.get(t) += result_life * total_pop / state.defines.alice_needs_scaling_factor;
-			en_demand_vector.get(t) += result_everyday * total_pop / state.defines.alice_needs_scaling_factor;
-			lx_demand_vector.get(t) += result_luxury * total_pop / state.defines.alice_needs_scaling_factor;
-
-			assert(std::isfinite(ln_demand_vector.get(t)));
-			assert(std::isfinite(en_demand_vector.get(t)));
-			assert(std::isfinite(lx_demand_vector.get(t)));
+			result.type = t;
+			result.life = result_life * total_pop / state.defines.alice_needs_scaling_factor;
+			result.everyday = result_everyday * total_pop / state.defines.alice_needs_scaling_factor;
+			result.luxury = result_luxury * total_pop / state.defines.alice_needs_scaling_factor;
 		}
+	});
+
+	for(uint32_t i = 0; i < pop_count; ++i) {
+		auto& result = pop_results[i];
+		auto t = result.type;
+		state.world.nation_get_private_investment(n) += result.investment;
+
+		ln_demand_vector.get(t) += result.life;
+		en_demand_vector.get(t) += result.everyday;
+		lx_demand_vector.get(t) += result.luxury;
+
+		assert(std::isfinite(ln_demand_vector.get(t)));
+		assert(std::isfinite(en_demand_vector.get(t)));
+		assert(std::isfinite(lx_demand_vector.get(t)));
 	}
 
 	float ln_mul[] = {state.world.nation_get_modifier_values(n, sys::national_mod_offsets::poor_life_needs) + 1.0f,
@@ -2560,6 +2748,8 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 
 	for(uint32_t i = 1; i < total_commodities; ++i) {
 		dcon::commodity_id cid{ dcon::commodity_id::value_base_t(i) };
+		if(!in_pop_needs[i])
+			continue;
 		auto kf = state.world.commodity_get_key_factory(cid);
 		if(state.world.commodity_get_is_available_from_start(cid) || (kf && state.world.nation_get_active_building(n, kf))) {
 			for(const auto t : state.world.in_pop_type) {
@@ -2588,7 +2778,7 @@ void update_pop_consumption(sys::state& state, dcon::nation_id n, float base_dem
 	}
 }
 
-void populate_needs_costs(sys::state& state, dcon::nation_id n, float base_demand, float invention_factor) {
+void populate_needs_costs(sys::state& state, dcon::nation_id n, float base_demand, float invention_factor, std::vector<bool> const& in_pop_needs) {
 	/*
 	- Each pop strata and needs type has its own demand modifier, calculated as follows:
 	- (national-modifier-to-goods-demand + define:BASE_GOODS_DEMAND) x (national-modifier-to-specific-strata-and-needs-type + 1) x
@@ -2613,6 +2803,8 @@ void populate_needs_costs(sys::state& state, dcon::nation_id n, float base_deman
 
 	for(uint32_t i = 1; i < total_commodities; ++i) {
 		dcon::commodity_id c{dcon::commodity_id::value_base_t(i)};
+		if(!in_pop_needs[i])
+			continue;
 		auto kf = state.world.commodity_get_key_factory(c);
 		if(state.world.commodity_get_is_available_from_start(c) || (kf && state.world.nation_get_active_building(n, kf))) {
 			float effective_price = state.world.nation_get_effective_prices(n, c);
@@ -3147,16 +3339,28 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 		}
 	}
 
-	for(auto n : state.nations_by_rank) {
-		if(!n) // test for running out of sorted nations
-			break;
-		absorb_sphere_member_production(state, n); // no need for redundant checks here
-	}
-	for(auto n : state.nations_by_rank) {
-		if(!n) // test for running out of sorted nations
-			break;
-		give_sphere_leader_production(state, n); // no need for redundant checks here
-	}
+	/*
+	Each sphere leader only adds to its own pool while reading the pools of its members, and members never lead a sphere
+	of their own, so the leaders can be handled concurrently. Likewise, each member then only rescales its own pool.
+	*/
+	concurrency::parallel_for(uint32_t(0), num_nation, [&](uint32_t i) {
+		absorb_sphere_member_production(state, dcon::nation_id{ dcon::nation_id::value_base_t(i) });
+	});
+	concurrency::parallel_for(uint32_t(0), num_nation, [&](uint32_t i) {
+		give_sphere_leader_production(state, dcon::nation_id{ dcon::nation_id::value_base_t(i) });
+	});
+
+	/*
+	The purchasing below has to run serially and in rank order: the effective prices and the supply available to each
+	nation depend on what the nations ahead of it have already bought from the sphere and world pools.
+	*/
+
+	std::vector<bool> in_pop_needs;
+	find_commodities_in_pop_needs(state, in_pop_needs);
+
+	std::vector<dcon::province_id> owned_provinces;
+	std::vector<intermediate_demand_ledger> province_demand;
+	std::vector<factory_type_input_summary> factory_type_inputs;
 
 	for(auto n : state.nations_by_rank) {
 		if(!n) // test for running out of sorted nations
@@ -3190,7 +3394,7 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 				[&](auto iid) { num_inventions += int32_t(state.world.nation_get_active_inventions(n, iid)); });
 		float invention_factor = float(num_inventions) * state.defines.invention_impact_on_demand + 1.0f;
 
-		populate_needs_costs(state, n, base_demand, invention_factor);
+		populate_needs_costs(state, n, base_demand, invention_factor, in_pop_needs);
 
 		float mobilization_impact = state.world.nation_get_is_mobilized(n) ? military::mobilization_impact(state, n) : 1.0f;
 
@@ -3217,29 +3421,49 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 
 		update_national_artisan_consumption(state, n, artisan_min_wage, mobilization_impact);
 
+		/*
+		factories and rgos only read the nation's prices and satisfaction, which stay fixed until the purchasing below,
+		so the provinces are handled concurrently and the factory demand is registered afterwards in province order
+		*/
+		owned_provinces.clear();
 		for(auto p : state.world.nation_get_province_ownership(n)) {
-			for(auto f : state.world.province_get_factory_location(p.get_province())) {
+			owned_provinces.push_back(p.get_province());
+		}
+		if(province_demand.size() < owned_provinces.size())
+			province_demand.resize(owned_provinces.size());
+		populate_factory_type_input_summaries(state, n, factory_type_inputs);
+
+		concurrency::parallel_for(0, int32_t(owned_provinces.size()), [&](int32_t index) {
+			auto p = fatten(state.world, owned_provinces[index]);
+			bool occupied = p.get_nation_from_province_control() != n;
+
+			for(auto f : p.get_factory_location()) {
 				// factory
 
 				update_single_factory_consumption(
 					state,
+					province_demand[index],
+					factory_type_inputs,
 					f.get_factory(),
 					n,
-					p.get_province(),
-					p.get_province().get_state_membership(),
+					p,
+					p.get_state_membership(),
 					mobilization_impact,
 					factory_min_wage,
-					p.get_province().get_nation_from_province_control() != n // is occupied
+					occupied
 				);
 			}
 
 			// rgo
-			bool is_mine = state.world.commodity_get_is_mine(state.world.province_get_rgo(p.get_province()));
-			update_province_rgo_consumption(state, p.get_province(), n, mobilization_impact,
-					is_mine ? laborer_min_wage : farmer_min_wage, p.get_province().get_nation_from_province_control() != n);
+			bool is_mine = state.world.commodity_get_is_mine(state.world.province_get_rgo(p));
+			update_province_rgo_consumption(state, p, n, mobilization_impact,
+					is_mine ? laborer_min_wage : farmer_min_wage, occupied);
+		});
+		for(size_t index = 0; index < owned_provinces.size(); ++index) {
+			province_demand[index].commit(state, n);
 		}
 
-		update_pop_consumption(state, n, base_demand, invention_factor);
+		update_pop_consumption(state, n, base_demand, invention_factor, in_pop_needs);
 
 		{
 			// update national spending
@@ -3339,7 +3563,8 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 	/*
 	move remaining domestic supply to global pool, clear domestic market
 	*/
-	state.world.for_each_commodity([&](dcon::commodity_id c) {
+	concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
+		dcon::commodity_id c{ dcon::commodity_id::value_base_t(k) };
 		// per good decay would be nice...
 		float decay = 0.5f;
 		float world_pool = state.world.commodity_get_global_market_pool(c) * decay;
@@ -3441,6 +3666,8 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 			float lx_total = 0.0f;
 			for(uint32_t i = 1; i < total_commodities; ++i) {
 				dcon::commodity_id c{ dcon::commodity_id::value_base_t(i) };
+				if(!in_pop_needs[i])
+					continue;
 				auto kf = state.world.commodity_get_key_factory(c);
 				if(state.world.commodity_get_is_available_from_start(c) || (kf && state.world.nation_get_active_building(n, kf))) {
 					auto sat = state.world.nation_get_demand_satisfaction(n, c);
@@ -4309,6 +4536,8 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 		}
 	}
 
+	update_factory_type_cost_table(state);
+
 	//write gdp to file
 	if(state.cheat_data.ecodump) {
 		for(auto n : state.world.in_nation) {
@@ -4330,6 +4559,10 @@ void daily_update(sys::state& state, bool initiate_buildings) {
 }
 
 void regenerate_unsaved_values(sys::state& state) {
+	// filled in again by the next daily update; until then the figures are computed on demand
+	state.factory_type_costs = factory_type_cost_table{};
+	update_rgo_goods(state);
+
 	state.culture_definitions.rgo_workers.clear();
 	for(auto pt : state.world.in_pop_type) {
 		if(pt.get_is_paid_rgo_worker())
@@ -4432,6 +4665,42 @@ float factory_type_input_cost(sys::state& state, dcon::nation_id n, dcon::factor
 	return input_total * input_multiplier + e_input_total * input_multiplier * maint_multiplier;
 }
 
+factory_type_costs compute_factory_type_costs(sys::state& state, dcon::nation_id n, dcon::factory_type_id factory_type) {
+	auto fac_type = dcon::fatten(state.world, factory_type);
+	factory_type_costs result;
+	result.input_total = factory_input_total_cost(state, n, fac_type);
+	result.min_input_available = factory_min_input_available(state, n, fac_type);
+	result.e_input_total = factory_e_input_total_cost(state, n, fac_type);
+	result.min_e_input_available = factory_min_e_input_available(state, n, fac_type);
+	result.input_cost = factory_type_input_cost(state, n, factory_type);
+	result.output_cost = factory_type_output_cost(state, n, factory_type);
+	result.build_cost = factory_type_build_cost(state, n, factory_type);
+	return result;
+}
+
+void update_factory_type_cost_table(sys::state& state) {
+	auto& table = state.factory_type_costs;
+	table.nation_count = state.world.nation_size();
+	table.type_count = state.world.factory_type_size();
+	table.entries.resize(size_t(table.nation_count) * size_t(table.type_count));
+
+	concurrency::parallel_for(uint32_t(0), table.nation_count, [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		for(uint32_t j = 0; j < table.type_count; ++j) {
+			dcon::factory_type_id t{ dcon::factory_type_id::value_base_t(j) };
+			table.entries[size_t(i) * size_t(table.type_count) + size_t(j)] = compute_factory_type_costs(state, n, t);
+		}
+	});
+}
+
+factory_type_costs get_factory_type_costs(sys::state& state, dcon::nation_id n, dcon::factory_type_id factory_type) {
+	auto& table = state.factory_type_costs;
+	if(uint32_t(n.index()) < table.nation_count && uint32_t(factory_type.index()) < table.type_count) {
+		return table.entries[size_t(n.index()) * size_t(table.type_count) + size_t(factory_type.index())];
+	}
+	return compute_factory_type_costs(state, n, factory_type);
+}
+
 float nation_factory_consumption(sys::state& state, dcon::nation_id n, dcon::commodity_id c) {
 	auto amount = 0.f;
 	for(auto ownership : state.world.nation_get_province_ownership(n)) {
@@ -4556,15 +4825,21 @@ float pop_income(sys::state& state, dcon::pop_id p) {
 }
 
 float estimate_gold_income(sys::state& state, dcon::nation_id n) {
+	static std::vector<dcon::commodity_id> money_goods;
+	money_goods.clear();
+	state.world.for_each_commodity([&](dcon::commodity_id c) {
+		if(state.world.commodity_get_money_rgo(c))
+			money_goods.push_back(c);
+	});
+	if(money_goods.empty())
+		return 0.0f;
+
 	auto amount = 0.f;
 	for(auto poid : state.world.nation_get_province_ownership_as_nation(n)) {
 		auto prov = poid.get_province();
-
-		state.world.for_each_commodity([&](dcon::commodity_id c) {
-			if(state.world.commodity_get_money_rgo(c)) {
-				amount += province::rgo_production_quantity(state, prov.id, c);
-			}
-		});
+		for(auto c : money_goods) {
+			amount += province::rgo_production_quantity(state, prov.id, c);
+		}
 	}
 	return amount * state.defines.gold_to_cash_rate;
 }
@@ -5038,7 +5313,9 @@ void resolve_constructions(sys::state& state) {
 		}
 	}
 
-	province::for_each_land_province(state, [&](dcon::province_id p) {
+	static std::vector<dcon::province_id> shipyards;
+	collect_naval_construction_provinces(state, shipyards);
+	for(auto p : shipyards) {
 		auto rng = state.world.province_get_province_naval_construction(p);
 		if(rng.begin() != rng.end()) {
 			auto c = *(rng.begin());
@@ -5084,7 +5361,7 @@ void resolve_constructions(sys::state& state) {
 				state.world.delete_province_naval_construction(c);
 			}
 		}
-	});
+	}
 
 	for(uint32_t i = state.world.province_building_construction_size(); i-- > 0;) {
 		dcon::province_building_construction_id c{dcon::province_building_construction_id::value_base_t(i)};
@@ -5234,6 +5511,36 @@ float estimate_daily_income(sys::state& state, dcon::nation_id n) {
 	) * tax_eff;
 }
 
+budget_estimates const& get_budget_estimates(sys::state& state, dcon::nation_id n) {
+	auto& cache = state.budget_estimates;
+	if(cache.valid && cache.nation == n)
+		return cache.values;
+
+	auto& v = cache.values;
+	v.tax_income[uint8_t(culture::pop_strata::poor)] = estimate_tax_income_by_strata(state, n, culture::pop_strata::poor);
+	v.tax_income[uint8_t(culture::pop_strata::middle)] = estimate_tax_income_by_strata(state, n, culture::pop_strata::middle);
+	v.tax_income[uint8_t(culture::pop_strata::rich)] = estimate_tax_income_by_strata(state, n, culture::pop_strata::rich);
+	for(uint8_t i = 0; i < uint8_t(v.pop_payouts.size()); ++i) {
+		v.pop_payouts[i] = estimate_pop_payouts_by_income_type(state, n, culture::income_type(i));
+	}
+	v.gold_income = estimate_gold_income(state, n);
+	v.tariff_income = estimate_tariff_income(state, n);
+	v.diplomatic_balance = estimate_diplomatic_balance(state, n);
+	v.interest = interest_payment(state, n);
+	v.social_spending = estimate_social_spending(state, n);
+	v.land_spending = estimate_land_spending(state, n);
+	v.naval_spending = estimate_naval_spending(state, n);
+	v.construction_spending = estimate_construction_spending(state, n);
+	v.domestic_investment = estimate_domestic_investment(state, n);
+	v.subsidy_spending = estimate_subsidy_spending(state, n);
+	v.overseas_penalty_spending = estimate_overseas_penalty_spending(state, n);
+	v.stockpile_filling_spending = estimate_stockpile_filling_spending(state, n);
+
+	cache.nation = n;
+	cache.valid = true;
+	return v;
+}
+
 void try_add_factory_to_state(sys::state& state, dcon::state_instance_id s, dcon::factory_type_id t) {
 	auto n = state.world.state_instance_get_nation_from_state_ownership(s);
 
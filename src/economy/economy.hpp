@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include "container_types.hpp"
 #include "dcon_generated.hpp"
 
@@ -121,6 +122,7 @@ inline constexpr float production_scale_delta = 0.1f;
 inline constexpr float factory_closed_threshold = 0.0001f;
 inline constexpr uint32_t price_history_length = 256;
 inline constexpr uint32_t gdp_history_length = 128;
+inline constexpr uint32_t yearly_history_length = 128; // one entry per year, old enough to cover a whole game
 inline constexpr float rgo_owners_cut = 0.05f;
 
 void presimulate(sys::state& state);
@@ -164,6 +166,7 @@ bool nation_has_closed_factories(sys::state& state, dcon::nation_id n);
 
 void initialize(sys::state& state);
 void regenerate_unsaved_values(sys::state& state);
+void update_rgo_goods(sys::state& state); // must run again if rgo_max_size_per_good changes
 
 float pop_min_wage_factor(sys::state& state, dcon::nation_id n);
 float pop_farmer_min_wage(sys::state& state, dcon::nation_id n, float min_wage_factor);
@@ -185,6 +188,26 @@ float factory_type_output_cost(sys::state& state, dcon::nation_id n, dcon::facto
 float factory_type_input_cost(sys::state& state, dcon::nation_id n, dcon::factory_type_id factory_type);
 float factory_type_build_cost(sys::state& state, dcon::nation_id n, dcon::factory_type_id factory_type);
 
+// the figures above for every (nation, factory type) pair, as of the end of the last economy update, so that the
+// production window can sort and draw its factory type table without rederiving them for every comparison
+struct factory_type_costs {
+	float input_total = 0.0f; // factory_input_total_cost
+	float min_input_available = 1.0f; // factory_min_input_available
+	float e_input_total = 0.0f; // factory_e_input_total_cost
+	float min_e_input_available = 1.0f; // factory_min_e_input_available
+	float input_cost = 0.0f; // factory_type_input_cost
+	float output_cost = 0.0f; // factory_type_output_cost
+	float build_cost = 0.0f; // factory_type_build_cost
+};
+struct factory_type_cost_table {
+	std::vector<factory_type_costs> entries; // nation_count rows of type_count entries
+	uint32_t nation_count = 0;
+	uint32_t type_count = 0;
+};
+void update_factory_type_cost_table(sys::state& state);
+// nations and factory types created since the last update are computed on the spot
+factory_type_costs get_factory_type_costs(sys::state& state, dcon::nation_id n, dcon::factory_type_id factory_type);
+
 void update_rgo_employment(sys::state& state);
 void update_factory_employment(sys::state& state);
 void daily_update(sys::state& state, bool initiate_building);
@@ -226,6 +249,32 @@ float estimate_war_subsidies(sys::state& state, dcon::nation_id n);
 
 float estimate_daily_income(sys::state& state, dcon::nation_id n);
 
+// the budget window asks for the same estimates from many of its elements every frame; this snapshot computes them
+// once per nation and is thrown away whenever the gamestate is updated (see sys::state::render). It is only for the ui:
+// the ai must keep calling the estimators above directly so that its choices do not depend on when a frame was drawn
+struct budget_estimates {
+	std::array<float, 3> tax_income = { 0.0f, 0.0f, 0.0f }; // by culture::pop_strata
+	std::array<float, 5> pop_payouts = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }; // by culture::income_type
+	float gold_income = 0.0f;
+	float tariff_income = 0.0f;
+	float diplomatic_balance = 0.0f;
+	float interest = 0.0f;
+	float social_spending = 0.0f;
+	float land_spending = 0.0f;
+	float naval_spending = 0.0f;
+	float construction_spending = 0.0f;
+	float domestic_investment = 0.0f;
+	float subsidy_spending = 0.0f;
+	float overseas_penalty_spending = 0.0f;
+	float stockpile_filling_spending = 0.0f;
+};
+struct budget_estimate_cache {
+	budget_estimates values;
+	dcon::nation_id nation;
+	bool valid = false;
+};
+budget_estimates const& get_budget_estimates(sys::state& state, dcon::nation_id n);
+
 struct construction_status {
 	float progress = 0.0f; // in range [0,1)
 	bool is_under_construction = false;
@@ -257,6 +306,18 @@ int32_t previous_price_record_index(sys::state& state);
 int32_t most_recent_gdp_record_index(sys::state& state);
 int32_t previous_gdp_record_index(sys::state& state);
 
+// Long histories (prices, gdp, population) are kept once a year next to the finer records above. They are stored as
+// 16 bit logarithms so that keeping the whole game costs a quarter of what the same number of floats would in a save;
+// the rounding error is below a tenth of a percent of the recorded value.
+int32_t most_recent_yearly_record_index(sys::state& state);
+uint16_t encode_history_value(float v);
+float decode_history_value(uint16_t v);
+// years_ago = 0 is the record of the most recent january first
+float yearly_price_record(sys::state& state, dcon::commodity_id c, int32_t years_ago);
+float yearly_gdp_record(sys::state& state, dcon::nation_id n, int32_t years_ago);
+float yearly_population_record(sys::state& state, dcon::nation_id n, int32_t years_ago);
+void update_yearly_records(sys::state& state); // called on january first
+
 float gdp_adjusted(sys::state& state, dcon::nation_id n);
 
 void prune_factories(sys::state& state); // get rid of closed factories in full states
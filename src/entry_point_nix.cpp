@@ -119,7 +119,13 @@ void build_scenario_file() {
 			}
 			++max_scenario_count;
 			selected_scenario_file = base_name + NATIVE("-") + std::to_string(append) + NATIVE(".bin");
+			auto write_start = std::chrono::steady_clock::now();
 			sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+			{
+				auto write_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - write_start).count();
+				auto timings = err.build_timings + "Writing the scenario file: " + std::to_string(write_ms) + " ms\n";
+				simple_fs::write_file(sdir, NATIVE("scenario_build_times.log"), timings.data(), uint32_t(timings.length()));
+			}
 			if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 				auto content = view_contents(*of);
 				auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
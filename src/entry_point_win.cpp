@@ -254,6 +254,9 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPWSTR
 					headless = true;
 				} else if(native_string(parsed_cmd[i]) == NATIVE("-repeat")) {
 					headless_repeat = true;
+				} else if(native_string(parsed_cmd[i]) == NATIVE("-unpack")) {
+					// trade disk space for load time, mostly useful for dedicated hosts
+					sys::unpack_scenario_file(parsed_cmd[1]);
 				} else if(native_string(parsed_cmd[i]) == NATIVE("-speed")) {
 					if(i + 1 < num_params) {
 						auto str = simple_fs::native_to_utf8(native_string(parsed_cmd[i + 1]));
@@ -62,6 +62,8 @@ native_string get_full_name(directory const& f);
 
 // write_file will clear an existing file, if it exists, will create a new file if it does not
 void write_file(directory const& dir, native_string_view file_name, char const* file_data, uint32_t file_size);
+// does nothing if there is no such file
+void remove_file(directory const& dir, native_string_view file_name);
 
 // unopened file functions
 std::optional<file> open_file(unopened_file const& f);
@@ -79,6 +81,9 @@ directory get_or_create_oos_directory();
 directory get_or_create_scenario_directory();
 directory get_or_create_settings_directory();
 directory get_or_create_data_dumps_directory();
+directory get_or_create_jit_cache_directory();
+directory get_or_create_shader_cache_directory();
+directory get_or_create_font_cache_directory();
 directory get_or_create_root_documents();
 
 // necessary for reading paths out of data from inside older paradox files:
@@ -438,6 +438,14 @@ void write_file(directory const& dir, native_string_view file_name, char const*
 	}
 }
 
+void remove_file(directory const& dir, native_string_view file_name) {
+	if(dir.parent_system)
+		std::abort();
+
+	native_string full_path = dir.relative_path + NATIVE('/') + native_string(file_name);
+	unlink(full_path.c_str());
+}
+
 file_contents view_contents(file const& f) {
 	return f.content;
 }
@@ -500,6 +508,27 @@ directory get_or_create_data_dumps_directory() {
 	return directory(nullptr, path);
 }
 
+directory get_or_create_jit_cache_directory() {
+	native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/jit_cache/";
+	make_directories(path);
+
+	return directory(nullptr, path);
+}
+
+directory get_or_create_shader_cache_directory() {
+	native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/shader_cache/";
+	make_directories(path);
+
+	return directory(nullptr, path);
+}
+
+directory get_or_create_font_cache_directory() {
+	native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/font_cache/";
+	make_directories(path);
+
+	return directory(nullptr, path);
+}
+
 directory get_or_create_scenario_directory() {
 	native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/scenarios/";
 	make_directories(path);
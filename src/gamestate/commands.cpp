@@ -20,6 +20,192 @@ bool is_console_command(command_type t) {
 	return uint8_t(t) == 255;
 }
 
+size_t payload_data_size(command_type t) {
+	switch(t) {
+	case command_type::change_nat_focus:
+		return sizeof(national_focus_data);
+	case command_type::start_research:
+		return sizeof(start_research_data);
+	case command_type::make_leader:
+	case command_type::enable_debt:
+		return sizeof(make_leader_data);
+	case command_type::begin_province_building_construction:
+		return sizeof(province_building_data);
+	case command_type::increase_relations:
+	case command_type::decrease_relations:
+	case command_type::war_subsidies:
+	case command_type::cancel_war_subsidies:
+	case command_type::ask_for_military_access:
+	case command_type::ask_for_alliance:
+	case command_type::cancel_military_access:
+	case command_type::cancel_alliance:
+	case command_type::cancel_given_military_access:
+	case command_type::give_military_access:
+	case command_type::release_subject:
+	case command_type::toggle_interested_in_alliance:
+		return sizeof(diplo_action_data);
+	case command_type::begin_factory_building_construction:
+	case command_type::cancel_factory_building_construction:
+		return sizeof(factory_building_data);
+	case command_type::begin_naval_unit_construction:
+	case command_type::cancel_naval_unit_construction:
+		return sizeof(naval_unit_construction_data);
+	case command_type::change_factory_settings:
+	case command_type::delete_factory:
+		return sizeof(factory_data);
+	case command_type::make_vassal:
+	case command_type::release_and_play_nation:
+		return sizeof(tag_target_data);
+	case command_type::change_budget:
+		return sizeof(budget_settings_data);
+	case command_type::change_influence_priority:
+		return sizeof(influence_priority_data);
+	case command_type::discredit_advisors:
+	case command_type::expel_advisors:
+	case command_type::ban_embassy:
+	case command_type::increase_opinion:
+	case command_type::decrease_opinion:
+	case command_type::add_to_sphere:
+	case command_type::remove_from_sphere:
+		return sizeof(influence_action_data);
+	case command_type::upgrade_colony_to_state:
+	case command_type::invest_in_colony:
+	case command_type::abandon_colony:
+	case command_type::finish_colonization:
+	case command_type::toggle_select_province:
+	case command_type::toggle_immigrator_province:
+	case command_type::move_capital:
+		return sizeof(generic_location_data);
+	case command_type::intervene_in_war:
+		return sizeof(war_target_data);
+	case command_type::suppress_movement:
+		return sizeof(movement_data);
+	case command_type::appoint_ruling_party:
+		return sizeof(political_party_data);
+	case command_type::change_issue_option:
+		return sizeof(issue_selection_data);
+	case command_type::change_reform_option:
+		return sizeof(reform_selection_data);
+	case command_type::take_sides_in_crisis:
+		return sizeof(crisis_join_data);
+	case command_type::begin_land_unit_construction:
+	case command_type::cancel_land_unit_construction:
+		return sizeof(land_unit_construction_data);
+	case command_type::change_stockpile_settings:
+		return sizeof(stockpile_settings_data);
+	case command_type::take_decision:
+		return sizeof(decision_data);
+	case command_type::make_n_event_choice:
+		return sizeof(pending_human_n_event_data);
+	case command_type::make_f_n_event_choice:
+		return sizeof(pending_human_f_n_event_data);
+	case command_type::make_p_event_choice:
+		return sizeof(pending_human_p_event_data);
+	case command_type::make_f_p_event_choice:
+		return sizeof(pending_human_f_p_event_data);
+	case command_type::fabricate_cb:
+		return sizeof(cb_fabrication_data);
+	case command_type::call_to_arms:
+		return sizeof(call_to_arms_data);
+	case command_type::respond_to_diplomatic_message:
+		return sizeof(message_data);
+	case command_type::declare_war:
+		return sizeof(new_war_data);
+	case command_type::add_war_goal:
+		return sizeof(new_war_goal_data);
+	case command_type::start_peace_offer:
+	case command_type::start_crisis_peace_offer:
+		return sizeof(new_offer_data);
+	case command_type::add_peace_offer_term:
+		return sizeof(offer_wargoal_data);
+	case command_type::move_army:
+	case command_type::embark_army:
+	case command_type::split_army:
+	case command_type::delete_army:
+	case command_type::disband_undermanned:
+	case command_type::even_split_army:
+	case command_type::toggle_hunt_rebels:
+	case command_type::toggle_unit_ai_control:
+		return sizeof(army_movement_data);
+	case command_type::move_armies:
+		return sizeof(multi_army_movement_data);
+	case command_type::move_navy:
+	case command_type::split_navy:
+	case command_type::delete_navy:
+	case command_type::even_split_navy:
+		return sizeof(navy_movement_data);
+	case command_type::merge_armies:
+		return sizeof(merge_army_data);
+	case command_type::merge_navies:
+		return sizeof(merge_navy_data);
+	case command_type::designate_split_regiments:
+		return sizeof(split_regiments_data);
+	case command_type::designate_split_ships:
+		return sizeof(split_ships_data);
+	case command_type::naval_retreat:
+		return sizeof(naval_battle_data);
+	case command_type::land_retreat:
+		return sizeof(land_battle_data);
+	case command_type::invite_to_crisis:
+	case command_type::add_wargoal_to_crisis_offer:
+		return sizeof(crisis_invitation_data);
+	case command_type::change_admiral:
+		return sizeof(new_admiral_data);
+	case command_type::change_general:
+		return sizeof(new_general_data);
+	case command_type::set_rally_point:
+		return sizeof(rally_point_data);
+	case command_type::save_game:
+		return sizeof(save_game_data);
+	case command_type::state_transfer:
+		return sizeof(state_transfer_data);
+	case command_type::pbutton_script:
+		return sizeof(pbutton_data);
+	case command_type::nbutton_script:
+		return sizeof(nbutton_data);
+	case command_type::notify_player_ban:
+	case command_type::notify_player_kick:
+	case command_type::notify_player_picks_nation:
+		return sizeof(nation_pick_data);
+	case command_type::notify_player_joins:
+		return sizeof(sys::player_name);
+	case command_type::notify_player_leaves:
+		return sizeof(notify_leaves_data);
+	case command_type::notify_player_oos:
+	case command_type::notify_checksum_tree:
+		return sizeof(checksum_tree_data);
+	case command_type::notify_save_loaded:
+		return sizeof(notify_save_loaded_data);
+	case command_type::notify_reload:
+		return sizeof(notify_reload_data);
+	case command_type::advance_tick:
+		return sizeof(advance_tick_data);
+	case command_type::notify_checksum:
+		return sizeof(notify_checksum_data);
+	case command_type::notify_ping:
+		return sizeof(notify_ping_data);
+	case command_type::notify_tick_ack:
+		return sizeof(notify_tick_ack_data);
+	case command_type::chat_message:
+		return sizeof(chat_message_data);
+	case command_type::invalid:
+	case command_type::start_election:
+	case command_type::civilize_nation:
+	case command_type::become_interested_in_crisis:
+	case command_type::cancel_cb_fabrication:
+	case command_type::send_peace_offer:
+	case command_type::send_crisis_peace_offer:
+	case command_type::toggle_mobilization:
+	case command_type::toggle_mobilized_is_ai_controlled:
+	case command_type::notify_start_game:
+	case command_type::notify_stop_game:
+	case command_type::notify_pause_game:
+	case command_type::console_command:
+		return 0;
+	}
+	return sizeof(payload::dtype);
+}
+
 void add_to_command_queue(sys::state& state, payload& p) {
 	assert(command::can_perform_command(state, p));
 
@@ -31,6 +217,8 @@ void add_to_command_queue(sys::state& state, payload& p) {
 	case command_type::notify_player_kick:
 	case command_type::notify_save_loaded:
 	case command_type::notify_reload:
+	case command_type::notify_checksum_tree:
+	case command_type::notify_checksum:
 	case command_type::notify_start_game:
 	case command_type::notify_stop_game:
 	case command_type::notify_player_oos:
@@ -100,6 +288,7 @@ void execute_save_game(sys::state& state, dcon::nation_id source, bool and_quit)
 	sys::write_save_file(state);
 
 	if(and_quit) {
+		sys::finish_background_save(state);
 		window::close_window(state);
 	}
 }
@@ -815,6 +1004,41 @@ void change_factory_settings(sys::state& state, dcon::nation_id source, dcon::fa
 	p.data.factory.priority = priority;
 	p.data.factory.subsidize = subsidized;
 	add_to_command_queue(state, p);
+
+	if(state.network_mode == sys::network_mode_type::client && state.current_scene.game_in_progress) {
+		auto& prediction = state.network_state.predicted_factories[f.index()];
+		prediction.sent = std::chrono::steady_clock::now();
+		prediction.pending++;
+		prediction.priority = priority;
+		prediction.subsidized = subsidized;
+		state.game_state_updated.store(true, std::memory_order::release);
+	}
+}
+
+// a command that gets lost (for example because the host rejects it) never comes back, so predictions don't outlive this
+constexpr std::chrono::seconds factory_prediction_lifetime{ 5 };
+
+static network::predicted_factory_settings const* find_factory_prediction(sys::state& state, dcon::factory_id f) {
+	if(state.network_mode != sys::network_mode_type::client)
+		return nullptr;
+	auto it = state.network_state.predicted_factories.find(f.index());
+	if(it == state.network_state.predicted_factories.end())
+		return nullptr;
+	if(std::chrono::steady_clock::now() - it->second.sent > factory_prediction_lifetime) {
+		state.network_state.predicted_factories.erase(it);
+		return nullptr;
+	}
+	return &it->second;
+}
+uint8_t predicted_factory_priority(sys::state& state, dcon::factory_id f) {
+	if(auto prediction = find_factory_prediction(state, f); prediction)
+		return prediction->priority;
+	return uint8_t(economy::factory_priority(state, f));
+}
+bool predicted_factory_subsidized(sys::state& state, dcon::factory_id f) {
+	if(auto prediction = find_factory_prediction(state, f); prediction)
+		return prediction->subsidized;
+	return state.world.factory_get_subsidized(f);
 }
 bool can_change_factory_settings(sys::state& state, dcon::nation_id source, dcon::factory_id f, uint8_t priority, bool subsidized) {
 	auto loc = state.world.factory_get_province_from_factory_location(f);
@@ -839,6 +1063,17 @@ bool can_change_factory_settings(sys::state& state, dcon::nation_id source, dcon
 	return true;
 }
 void execute_change_factory_settings(sys::state& state, dcon::nation_id source, dcon::province_id location, dcon::factory_type_id type, uint8_t priority, bool subsidized) {
+	if(state.network_mode == sys::network_mode_type::client && source == state.local_player_nation) {
+		// one of our own commands is back, whether or not it still applies
+		for(auto f : state.world.province_get_factory_location(location)) {
+			if(f.get_factory().get_building_type() == type) {
+				auto it = state.network_state.predicted_factories.find(f.get_factory().id.index());
+				if(it != state.network_state.predicted_factories.end() && --it->second.pending == 0)
+					state.network_state.predicted_factories.erase(it);
+				break;
+			}
+		}
+	}
 
 	if(state.world.province_get_nation_from_province_ownership(location) != source)
 		return;
@@ -3163,7 +3398,43 @@ bool can_partial_retreat_from(sys::state& state, dcon::naval_battle_id b) {
 	return state.network_mode != sys::network_mode_type::single_player;
 }
 
-std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest) {
+void move_armies(sys::state& state, dcon::nation_id source, std::vector<dcon::army_id> const& armies, dcon::province_id dest, bool reset) {
+	for(size_t first = 0; first < armies.size(); first += max_armies_per_move) {
+		payload p;
+		memset(&p, 0, sizeof(payload));
+		p.type = command_type::move_armies;
+		p.source = source;
+		p.data.multi_army_movement.count = uint8_t(std::min(armies.size() - first, size_t(max_armies_per_move)));
+		for(uint8_t i = 0; i < p.data.multi_army_movement.count; ++i)
+			p.data.multi_army_movement.armies[i] = armies[first + i];
+		p.data.multi_army_movement.dest = dest;
+		p.data.multi_army_movement.reset = reset;
+		add_to_command_queue(state, p);
+	}
+}
+
+void make_army_paths(sys::state& state, dcon::nation_id source, std::vector<dcon::army_id> const& armies, dcon::province_id dest, province::land_path_field& field) {
+	static std::vector<dcon::province_id> starts;
+	starts.clear();
+	dcon::army_id largest;
+	int64_t largest_size = -1;
+	for(auto a : armies) {
+		// the path is continued from the end of the current one, unless the orders are replaced
+		starts.push_back(state.world.army_get_location_from_army_location(a));
+		auto movement = state.world.army_get_path(a);
+		if(movement.size() > 0)
+			starts.push_back(movement.at(0));
+		auto regs = state.world.army_get_army_membership(a);
+		if(int64_t(regs.end() - regs.begin()) > largest_size) {
+			largest_size = int64_t(regs.end() - regs.begin());
+			largest = a;
+		}
+	}
+	province::make_land_path_field(state, field, dest, source, largest, starts);
+}
+
+// the paths come from the field where it has one, which is the case for armies at most as large as the ones it was made for
+static std::vector<dcon::province_id> find_army_path(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, province::land_path_field const* field) {
 	if(source != state.world.army_get_controller_from_army_control(a))
 		return std::vector<dcon::province_id>{};
 	if(state.world.army_get_is_retreating(a))
@@ -3180,6 +3451,12 @@ std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id
 	if(last_province == dest)
 		return std::vector<dcon::province_id>{};
 
+	auto land_path = [&]() {
+		if(field && field->destination == dest && field->reaches(last_province))
+			return field->path_from(last_province);
+		return province::make_land_path(state, last_province, dest, source, a);
+	};
+
 	if(!can_partial_retreat_from(state, state.world.army_get_battle_from_army_battle_participation(a)))
 		return std::vector<dcon::province_id>{};
 
@@ -3246,7 +3523,7 @@ std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id
 				if(state.world.army_get_black_flag(a)) {
 					return province::make_unowned_land_path(state, last_province, dest);
 				} else if(province::has_access_to_province(state, source, dest) && b_12 && b_13) {
-					return province::make_land_path(state, last_province, dest, source, a);
+					return land_path();
 				} else if(b_10) {
 					return province::make_unowned_land_path(state, last_province, dest);
 				} else {
@@ -3256,7 +3533,7 @@ std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id
 				if(state.world.army_get_black_flag(a)) {
 					return province::make_unowned_land_path(state, last_province, dest);
 				} else if(province::has_access_to_province(state, source, dest)) {
-					return province::make_land_path(state, last_province, dest, source, a);
+					return land_path();
 				} else {
 					return std::vector<dcon::province_id>{};
 				}
@@ -3265,7 +3542,7 @@ std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id
 			if(state.world.army_get_black_flag(a)) {
 				return province::make_unowned_land_path(state, last_province, dest);
 			} else if(province::has_access_to_province(state, source, dest)) {
-				return province::make_land_path(state, last_province, dest, source, a);
+				return land_path();
 			} else {
 				return std::vector<dcon::province_id>{};
 			}
@@ -3277,12 +3554,19 @@ std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id
 		if(state.world.army_get_black_flag(a)) {
 			return province::make_unowned_land_path(state, last_province, dest);
 		} else {
-			return province::make_land_path(state, last_province, dest, source, a);
+			return land_path();
 		}
 	}
 }
 
-void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, bool reset) {
+std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest) {
+	return find_army_path(state, source, a, dest, nullptr);
+}
+std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, province::land_path_field const& field) {
+	return find_army_path(state, source, a, dest, &field);
+}
+
+void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, bool reset, province::land_path_field const* field) {
 	if(source != state.world.army_get_controller_from_army_control(a))
 		return;
 	if(state.world.army_get_is_retreating(a))
@@ -3305,7 +3589,7 @@ void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id
 
 	if(!dest) {
 		existing_path.clear();
-		state.world.army_set_arrival_time(a, sys::date{});
+		military::set_arrival_time(state, a, sys::date{});
 		return;
 	}
 
@@ -3314,7 +3598,7 @@ void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id
 		existing_path.clear();
 	}
 
-	auto path = can_move_army(state, source, a, dest);
+	auto path = find_army_path(state, source, a, dest, field);
 
 	if(path.size() > 0) {
 		auto append_size = uint32_t(path.size());
@@ -3330,12 +3614,12 @@ void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id
 		}
 
 		if(existing_path.at(new_size - 1) != old_first_prov) {
-			state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+			military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 		}
 		state.world.army_set_dig_in(a, 0);
 		state.world.army_set_is_rebel_hunter(a, false);
 	} else if(reset) {
-		state.world.army_set_arrival_time(a, sys::date{});
+		military::set_arrival_time(state, a, sys::date{});
 	}
 	state.world.army_set_moving_to_merge(a, false);
 
@@ -3385,6 +3669,24 @@ void execute_move_army(sys::state& state, dcon::nation_id source, dcon::army_id
 	}
 }
 
+void execute_move_armies(sys::state& state, dcon::nation_id source, multi_army_movement_data const& data) {
+	static std::vector<dcon::army_id> armies;
+	armies.clear();
+	for(uint8_t i = 0; i < std::min(data.count, max_armies_per_move); ++i) {
+		if(state.world.army_is_valid(data.armies[i]) && state.world.army_get_controller_from_army_control(data.armies[i]) == source)
+			armies.push_back(data.armies[i]);
+	}
+	if(armies.empty())
+		return;
+
+	// moving the armies changes none of what the paths depend on, so the one search serves all of them
+	static province::land_path_field field;
+	if(data.dest)
+		make_army_paths(state, source, armies, data.dest, field);
+	for(auto a : armies)
+		execute_move_army(state, source, a, data.dest, data.reset, data.dest ? &field : nullptr);
+}
+
 void move_navy(sys::state& state, dcon::nation_id source, dcon::navy_id n, dcon::province_id dest, bool reset) {
 	payload p;
 	memset(&p, 0, sizeof(payload));
@@ -3442,7 +3744,7 @@ void execute_move_navy(sys::state& state, dcon::nation_id source, dcon::navy_id
 
 	if(!dest) {
 		existing_path.clear();
-		state.world.navy_set_arrival_time(n, sys::date{});
+		military::set_arrival_time(state, n, sys::date{});
 		return;
 	}
 
@@ -3466,10 +3768,10 @@ void execute_move_navy(sys::state& state, dcon::nation_id source, dcon::navy_id
 		}
 
 		if(existing_path.at(new_size - 1) != old_first_prov) {
-			state.world.navy_set_arrival_time(n, military::arrival_time_to(state, n, path.back()));
+			military::set_arrival_time(state, n, military::arrival_time_to(state, n, path.back()));
 		}
 	} else if(reset) {
-		state.world.navy_set_arrival_time(n, sys::date{});
+		military::set_arrival_time(state, n, sys::date{});
 	}
 	state.world.navy_set_moving_to_merge(n, false);
 
@@ -3587,7 +3889,7 @@ void execute_merge_armies(sys::state& state, dcon::nation_id source, dcon::army_
 
 	// stop movement
 	state.world.army_get_path(a).clear();
-	state.world.army_set_arrival_time(a, sys::date{});
+	military::set_arrival_time(state, a, sys::date{});
 
 	auto regs = state.world.army_get_army_membership(b);
 	while(regs.begin() != regs.end()) {
@@ -3637,7 +3939,7 @@ void execute_merge_navies(sys::state& state, dcon::nation_id source, dcon::navy_
 
 	// stop movement
 	state.world.navy_get_path(a).clear();
-	state.world.navy_set_arrival_time(a, sys::date{});
+	military::set_arrival_time(state, a, sys::date{});
 
 	auto regs = state.world.navy_get_navy_membership(b);
 	while(regs.begin() != regs.end()) {
@@ -4655,11 +4957,16 @@ void notify_player_oos(sys::state& state, dcon::nation_id source) {
 	memset(&p, 0, sizeof(payload));
 	p.type = command_type::notify_player_oos;
 	p.source = source;
+	p.data.checksum_tree.date = state.network_state.mismatched_checksum_tree.date;
 	add_to_command_queue(state, p);
 }
-void execute_notify_player_oos(sys::state& state, dcon::nation_id source) {
+void execute_notify_player_oos(sys::state& state, dcon::nation_id source, sys::date checksum_date) {
 	state.actual_game_speed = 0; //pause host immediately
 	state.debug_save_oos_dump();
+	if(state.network_mode == sys::network_mode_type::host) {
+		// let the client work out which columns diverged
+		network::send_checksum_tree(state, source, checksum_date);
+	}
 
 	ui::chat_message m{};
 	m.source = source;
@@ -4674,21 +4981,26 @@ void advance_tick(sys::state& state, dcon::nation_id source) {
 	memset(&p, 0, sizeof(payload));
 	p.type = command::command_type::advance_tick;
 	p.source = source;
-	// Postponed until it is sent!
-	//p.data.advance_tick.checksum = state.get_save_checksum();
 	p.data.advance_tick.speed = state.actual_game_speed.load(std::memory_order::acquire);
 	add_to_command_queue(state, p);
 }
 
-void execute_advance_tick(sys::state& state, dcon::nation_id source, sys::checksum_key& k, int32_t speed) {
+// client, drops a checksum that the host has yet to confirm once the state it was taken from is gone
+static void discard_pending_checksum(sys::state& state) {
+	if(state.save_checksum.async_pending())
+		state.save_checksum.async_result();
+	state.network_state.pending_resync_base.clear();
+}
+
+void execute_advance_tick(sys::state& state, dcon::nation_id source, int32_t speed) {
 	if(state.network_mode == sys::network_mode_type::client) {
 		if(!state.network_state.out_of_sync) {
 			if(state.current_date.to_ymd(state.start_date).day == 1 || state.cheat_data.daily_oos_check) {
-				sys::checksum_key current = state.get_save_checksum();
-				if(!current.is_equal(k)) {
-					state.network_state.out_of_sync = true;
-					state.debug_save_oos_dump();
-				}
+				// hashed in the background like on the host, and compared once the host's key arrives in a notify_checksum
+				discard_pending_checksum(state);
+				state.save_checksum.compute_async(state, state.current_date);
+				state.network_state.async_checksum_date = state.current_date;
+				network::take_pending_resync_snapshot(state);
 			}
 		}
 		state.actual_game_speed = speed;
@@ -4696,6 +5008,24 @@ void execute_advance_tick(sys::state& state, dcon::nation_id source, sys::checks
 	state.single_game_tick();
 }
 
+void execute_notify_checksum(sys::state& state, dcon::nation_id source, sys::date checksum_date, sys::checksum_key& k) {
+	if(state.network_mode != sys::network_mode_type::client)
+		return;
+	if(!state.save_checksum.async_pending() || state.network_state.async_checksum_date != checksum_date)
+		return; // taken before this client joined or loaded a save
+	auto [current, tree] = state.save_checksum.async_result();
+	if(state.network_state.out_of_sync)
+		return;
+	if(!current.is_equal(k)) {
+		state.network_state.out_of_sync = true;
+		state.network_state.mismatched_checksum_tree = std::move(tree);
+		state.debug_save_oos_dump();
+	} else {
+		// the host took the same snapshot when it sent the advance_tick
+		network::confirm_pending_resync_snapshot(state);
+	}
+}
+
 void notify_save_loaded(sys::state& state, dcon::nation_id source) {
 	payload p;
 	memset(&p, 0, sizeof(payload));
@@ -4712,6 +5042,10 @@ void execute_notify_save_loaded(sys::state& state, dcon::nation_id source, sys::
 	state.network_state.is_new_game = false;
 	state.network_state.out_of_sync = false;
 	state.network_state.reported_oos = false;
+	if(state.network_mode == sys::network_mode_type::client) {
+		discard_pending_checksum(state);
+		state.network_state.predicted_factories.clear();
+	}
 }
 
 void notify_reload(sys::state& state, dcon::nation_id source) {
@@ -4729,6 +5063,10 @@ void execute_notify_reload(sys::state& state, dcon::nation_id source, sys::check
 	state.network_state.is_new_game = false;
 	state.network_state.out_of_sync = false;
 	state.network_state.reported_oos = false;
+	if(state.network_mode == sys::network_mode_type::client) {
+		discard_pending_checksum(state);
+		state.network_state.predicted_factories.clear();
+	}
 
 	std::vector<dcon::nation_id> players;
 	for(const auto n : state.world.in_nation)
@@ -4749,6 +5087,7 @@ void execute_notify_reload(sys::state& state, dcon::nation_id source, sys::check
 	assert(state.world.nation_get_is_player_controlled(state.local_player_nation));
 	state.fill_unsaved_data();
 	assert(state.session_host_checksum.is_equal(state.get_save_checksum()));
+	network::take_resync_snapshot(state);
 }
 
 void execute_notify_start_game(sys::state& state, dcon::nation_id source) {
@@ -4759,7 +5098,6 @@ void execute_notify_start_game(sys::state& state, dcon::nation_id source) {
 	for(auto& v : state.ctrl_navies) v.clear();
 	/* And clear the save stuff */
 	state.network_state.current_save_buffer.reset();
-	state.network_state.current_save_length = 0;
 	/* Clear AI data */
 	for(const auto n : state.world.in_nation)
 		if(state.world.nation_get_is_player_controlled(n))
@@ -5000,6 +5338,10 @@ bool can_perform_command(sys::state& state, payload& c) {
 	case command_type::move_army:
 		return can_move_army(state, c.source, c.data.army_movement.a, c.data.army_movement.dest).size() != 0;
 
+	case command_type::move_armies:
+		// the armies that cannot be moved there are skipped; finding that out for each of them is most of the work
+		return c.data.multi_army_movement.count > 0 && c.data.multi_army_movement.count <= max_armies_per_move;
+
 	case command_type::move_navy:
 		return can_move_navy(state, c.source, c.data.navy_movement.n, c.data.navy_movement.dest).size() != 0;
 
@@ -5141,6 +5483,14 @@ bool can_perform_command(sys::state& state, payload& c) {
 		return true; //return can_notify_save_loaded(state, c.source, c.data.notify_save_loaded.seed, c.data.notify_save_loaded.checksum);
 	case command_type::notify_reload:
 		return true;
+	case command_type::notify_checksum_tree:
+		return true;
+	case command_type::notify_checksum:
+		return true;
+	case command_type::notify_ping:
+		return true;
+	case command_type::notify_tick_ack:
+		return true;
 	case command_type::notify_start_game:
 		return true; //return can_notify_start_game(state, c.source);
 	case command_type::notify_stop_game:
@@ -5158,6 +5508,7 @@ bool can_perform_command(sys::state& state, payload& c) {
 void execute_command(sys::state& state, payload& c) {
 	if(!can_perform_command(state, c))
 		return;
+	state.replay_recording.record(state, c);
 	switch(c.type) {
 	case command_type::invalid:
 		std::abort(); // invalid command
@@ -5352,7 +5703,10 @@ void execute_command(sys::state& state, payload& c) {
 		execute_send_peace_offer(state, c.source);
 		break;
 	case command_type::move_army:
-		execute_move_army(state, c.source, c.data.army_movement.a, c.data.army_movement.dest, c.data.army_movement.reset);
+		execute_move_army(state, c.source, c.data.army_movement.a, c.data.army_movement.dest, c.data.army_movement.reset, nullptr);
+		break;
+	case command_type::move_armies:
+		execute_move_armies(state, c.source, c.data.multi_army_movement);
 		break;
 	case command_type::move_navy:
 		execute_move_navy(state, c.source, c.data.navy_movement.n, c.data.navy_movement.dest, c.data.navy_movement.reset);
@@ -5495,17 +5849,26 @@ void execute_command(sys::state& state, payload& c) {
 		execute_notify_player_picks_nation(state, c.source, c.data.nation_pick.target);
 		break;
 	case command_type::notify_player_oos:
-		execute_notify_player_oos(state, c.source);
+		execute_notify_player_oos(state, c.source, c.data.checksum_tree.date);
 		break;
 	case command_type::advance_tick:
-		execute_advance_tick(state, c.source, c.data.advance_tick.checksum, c.data.advance_tick.speed);
+		execute_advance_tick(state, c.source, c.data.advance_tick.speed);
 		break;
+	case command_type::notify_checksum:
+		execute_notify_checksum(state, c.source, c.data.notify_checksum.date, c.data.notify_checksum.checksum);
+		break;
+	case command_type::notify_ping:
+	case command_type::notify_tick_ack:
+		break; // handled by the network code
+
 	case command_type::notify_save_loaded:
 		execute_notify_save_loaded(state, c.source, c.data.notify_save_loaded.checksum);
 		break;
 	case command_type::notify_reload:
 		execute_notify_reload(state, c.source, c.data.notify_reload.checksum);
 		break;
+	case command_type::notify_checksum_tree:
+		break; // the tree itself follows the command and is handled by the network code
 	case command_type::notify_start_game:
 		execute_notify_start_game(state, c.source);
 		break;
@@ -5535,6 +5898,7 @@ void execute_pending_commands(sys::state& state) {
 		province::update_connected_regions(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		state.replay_recording.record_batch_end(state);
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
 }
@@ -4,6 +4,10 @@
 #include "events.hpp"
 #include "diplomatic_messages.hpp"
 
+namespace province {
+struct land_path_field;
+}
+
 namespace command {
 
 enum class command_type : uint8_t {
@@ -106,6 +110,7 @@ enum class command_type : uint8_t {
 	toggle_interested_in_alliance = 97,
 	pbutton_script = 98,
 	nbutton_script = 99,
+	move_armies = 100,
 
 	// network
 	notify_player_ban = 106,
@@ -119,8 +124,12 @@ enum class command_type : uint8_t {
 	notify_stop_game = 114, // "go back to lobby"
 	notify_pause_game = 115, // visual aid mostly
 	notify_reload = 116,
+	notify_checksum_tree = 117, // host -> client, followed by a serialized sys::checksum_tree
+	notify_checksum = 118, // host -> client, the checksum taken before an earlier advance_tick
+	notify_ping = 119, // host -> client, and answered straight back by the client for the host's telemetry
 	advance_tick = 120,
 	chat_message = 121,
+	notify_tick_ack = 122, // client -> host, after executing advance_ticks, so that the host can hold back for slow clients
 
 	// console cheats
 	console_command = 255,
@@ -368,6 +377,15 @@ struct army_movement_data {
 	bool reset;
 };
 
+// as many armies as fit into the payload without making it any larger than the chat messages already make it
+constexpr inline uint8_t max_armies_per_move = 24;
+struct multi_army_movement_data {
+	dcon::army_id armies[max_armies_per_move];
+	dcon::province_id dest;
+	uint8_t count;
+	bool reset;
+};
+
 struct navy_movement_data {
 	dcon::navy_id n;
 	dcon::province_id dest;
@@ -436,18 +454,37 @@ struct nation_pick_data {
 };
 
 struct advance_tick_data {
-	sys::checksum_key checksum;
 	int32_t speed;
 };
 
+struct notify_ping_data {
+	int64_t sent_at; // microseconds on the host's steady clock, echoed back unchanged
+	sys::date date; // host: its date when sending, client: the date it had reached when answering
+};
+
+struct notify_tick_ack_data {
+	sys::date date; // that the client has reached
+};
+
+struct notify_checksum_data {
+	sys::checksum_key checksum;
+	sys::date date; // of the advance_tick that the checksum was taken before
+};
+
 struct notify_save_loaded_data {
 	sys::checksum_key checksum;
 	uint32_t length;
 	dcon::nation_id target;
+	bool is_delta; // the stream has to be xor-ed with the resync base of the client
 };
 struct notify_reload_data {
 	sys::checksum_key checksum;
 };
+struct checksum_tree_data {
+	sys::date date; // of the checksum that did not match
+	uint32_t length;
+	dcon::nation_id target;
+};
 struct notify_leaves_data {
 	bool make_ai;
 };
@@ -490,6 +527,7 @@ struct payload {
 		offer_wargoal_data offer_wargoal;
 		cheat_data cheat;
 		army_movement_data army_movement;
+		multi_army_movement_data multi_army_movement;
 		navy_movement_data navy_movement;
 		merge_army_data merge_army;
 		merge_navy_data merge_navy;
@@ -506,9 +544,13 @@ struct payload {
 		cheat_data_int cheat_int;
 		cheat_event_data cheat_event;
 		advance_tick_data advance_tick;
+		notify_checksum_data notify_checksum;
+		notify_ping_data notify_ping;
+		notify_tick_ack_data notify_tick_ack;
 		save_game_data save_game;
 		notify_save_loaded_data notify_save_loaded;
 		notify_reload_data notify_reload;
+		checksum_tree_data checksum_tree;
 		sys::player_name player_name;
 		cheat_location_data cheat_location;
 		notify_leaves_data notify_leave;
@@ -522,12 +564,16 @@ struct payload {
 
 	payload() { }
 };
+static_assert(sizeof(multi_army_movement_data) <= sizeof(chat_message_data), "max_armies_per_move would make every payload larger");
 
 void save_game(sys::state& state, dcon::nation_id source, bool and_quit);
 
 void set_rally_point(sys::state& state, dcon::nation_id source, dcon::province_id location, bool naval, bool enable);
 
 bool is_console_command(command_type t);
+// the number of bytes at the start of payload::data that a command of the given type uses; only that much of the data is
+// sent over the network, so a command type that starts using a different member of the union has to be updated here too
+size_t payload_data_size(command_type t);
 
 void set_national_focus(sys::state& state, dcon::nation_id source, dcon::state_instance_id target_state, dcon::national_focus_id focus);
 bool can_set_national_focus(sys::state& state, dcon::nation_id source, dcon::state_instance_id target_state, dcon::national_focus_id focus);
@@ -567,6 +613,11 @@ bool can_delete_factory(sys::state& state, dcon::nation_id source, dcon::factory
 
 void change_factory_settings(sys::state& state, dcon::nation_id source, dcon::factory_id f, uint8_t priority, bool subsidized);
 bool can_change_factory_settings(sys::state& state, dcon::nation_id source, dcon::factory_id f, uint8_t priority, bool subsidized);
+// The settings of a factory as they will be once the local player's change_factory_settings commands have come back from
+// the host. Only a client predicts them, elsewhere (and once the commands are back) these are just the current settings.
+// For display only.
+uint8_t predicted_factory_priority(sys::state& state, dcon::factory_id f);
+bool predicted_factory_subsidized(sys::state& state, dcon::factory_id f);
 
 void make_vassal(sys::state& state, dcon::nation_id source, dcon::national_identity_id t);
 bool can_make_vassal(sys::state& state, dcon::nation_id source, dcon::national_identity_id t);
@@ -724,6 +775,13 @@ bool can_add_war_goal(sys::state& state, dcon::nation_id source, dcon::war_id w,
 // ALSO: can returns an empty vector if no path could be made
 void move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, bool reset);
 std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest);
+// Moves several armies to the same destination, as when a whole selection is ordered there. Their paths all come from a single
+// search outwards from the destination (see province::make_land_path_field), made once per command rather than once per army.
+// There is no need to split the armies into groups of max_armies_per_move: more commands are sent if they do not fit into one.
+void move_armies(sys::state& state, dcon::nation_id source, std::vector<dcon::army_id> const& armies, dcon::province_id dest, bool reset);
+// the same search, for the ui to check which of the armies could be moved there; pass the field to can_move_army afterwards
+void make_army_paths(sys::state& state, dcon::nation_id source, std::vector<dcon::army_id> const& armies, dcon::province_id dest, province::land_path_field& field);
+std::vector<dcon::province_id> can_move_army(sys::state& state, dcon::nation_id source, dcon::army_id a, dcon::province_id dest, province::land_path_field const& field);
 
 void move_navy(sys::state& state, dcon::nation_id source, dcon::navy_id n, dcon::province_id dest, bool reset);
 std::vector<dcon::province_id> can_move_navy(sys::state& state, dcon::nation_id source, dcon::navy_id n, dcon::province_id dest);
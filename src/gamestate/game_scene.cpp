@@ -118,14 +118,24 @@ void selected_units_control(
 	bool reset_orders = (uint8_t(mod) & uint8_t(sys::key_modifiers::modifiers_shift)) == 0;
 	float volume = get_effects_volume(state);
 
+	// one search for the paths of the whole selection, both here and when the command is carried out
+	static province::land_path_field field;
+	static std::vector<dcon::army_id> movable;
+	movable.clear();
+	if(target && !state.selected_armies.empty())
+		command::make_army_paths(state, nation, state.selected_armies, target, field);
 	for(auto a : state.selected_armies) {
-		if(command::can_move_army(state, nation, a, target).empty()) {
+		if(command::can_move_army(state, nation, a, target, field).empty()) {
 			fail = true;
 		} else {
-			command::move_army(state, nation, a, target, reset_orders);
+			movable.push_back(a);
 			army_play = true;
 		}
 	}
+	if(movable.size() == 1)
+		command::move_army(state, nation, movable[0], target, reset_orders);
+	else if(!movable.empty())
+		command::move_armies(state, nation, movable, target, reset_orders);
 	for(auto a : state.selected_navies) {
 		if(command::can_move_navy(state, nation, a, target).empty()) {
 			fail = true;
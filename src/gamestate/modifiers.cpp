@@ -262,19 +262,20 @@ void recreate_national_modifiers(sys::state& state) {
 		state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_modifier_values(ids, mid, ve::fp_vector{}); });
 	});
 
-	for(auto n : state.world.in_nation) {
+	// The loops over nations below only add to the values of the nation itself, and add the same modifiers in the same order as
+	// separate loops over all nations would, so they are done in parallel with the results unchanged.
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(i) });
+		if(!n.is_valid())
+			return;
 		if(auto ts = n.get_tech_school(); ts)
 			apply_modifier_values_to_nation(state, n, ts);
-	}
-	for(auto n : state.world.in_nation) {
 		if(auto nv = n.get_national_value(); nv)
 			apply_modifier_values_to_nation(state, n, nv);
-	}
-	for(auto n : state.world.in_nation) {
 		for(auto mpr : state.world.nation_get_current_modifiers(n)) {
 			apply_modifier_values_to_nation(state, n, mpr.mod_id);
 		}
-	}
+	});
 	state.world.for_each_technology([&](dcon::technology_id t) {
 		auto tmod = state.world.technology_get_modifier(t);
 		if(tmod) {
@@ -289,25 +290,24 @@ void recreate_national_modifiers(sys::state& state) {
 					[&](auto ids) { return state.world.nation_get_active_inventions(ids, i); });
 		}
 	});
-	state.world.for_each_issue([&](dcon::issue_id i) {
-		for(auto n : state.world.in_nation) {
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t j) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(j) });
+		if(!n.is_valid())
+			return;
+		state.world.for_each_issue([&](dcon::issue_id i) {
 			auto iopt = state.world.nation_get_issues(n, i);
 			auto imod = state.world.issue_option_get_modifier(iopt);
 			if(imod && (n.get_is_civilized() || state.world.issue_get_issue_type(i) == uint8_t(culture::issue_type::party))) {
 				apply_modifier_values_to_nation(state, n, imod);
 			}
-		}
-	});
-	state.world.for_each_reform([&](dcon::reform_id i) {
-		for(auto n : state.world.in_nation) {
+		});
+		state.world.for_each_reform([&](dcon::reform_id i) {
 			auto iopt = state.world.nation_get_reforms(n, i);
 			auto imod = state.world.reform_option_get_modifier(iopt);
 			if(imod && !n.get_is_civilized()) {
 				apply_modifier_values_to_nation(state, n, imod);
 			}
-		}
-	});
-	for(auto n : state.world.in_nation) {
+		});
 		auto in_wars = n.get_war_participant();
 		if(in_wars.begin() != in_wars.end()) {
 			if(state.national_definitions.war)
@@ -316,7 +316,7 @@ void recreate_national_modifiers(sys::state& state) {
 			if(state.national_definitions.peace)
 				apply_modifier_values_to_nation(state, n, state.national_definitions.peace);
 		}
-	}
+	});
 
 	if(state.national_definitions.badboy) {
 		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.badboy,
@@ -367,7 +367,10 @@ void recreate_national_modifiers(sys::state& state) {
 					ids);
 		});
 	}
-	for(auto n : state.world.in_nation) {
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(i) });
+		if(!n.is_valid())
+			return;
 		if(n.get_is_civilized() == false) {
 			if(state.national_definitions.unciv_nation)
 				apply_modifier_values_to_nation(state, n, state.national_definitions.unciv_nation);
@@ -381,14 +384,12 @@ void recreate_national_modifiers(sys::state& state) {
 			if(state.national_definitions.civ_nation)
 				apply_modifier_values_to_nation(state, n, state.national_definitions.civ_nation);
 		}
-	}
-	if(state.national_definitions.disarming) {
-		for(auto n : state.world.in_nation) {
+		if(state.national_definitions.disarming) {
 			if(bool(n.get_disarmed_until()) && n.get_disarmed_until() > state.current_date) {
 				apply_modifier_values_to_nation(state, n, state.national_definitions.disarming);
 			}
 		}
-	}
+	});
 	if(state.national_definitions.in_bankrupcy) {
 		bulk_apply_masked_modifier_to_nations(state, state.national_definitions.in_bankrupcy,
 				[&](auto ids) { return state.world.nation_get_is_bankrupt(ids); });
@@ -649,6 +650,32 @@ void recreate_province_modifiers(sys::state& state) {
 	}
 }
 
+static void update_nation_modifiers_now(sys::state& state, dcon::nation_id n) {
+	update_single_nation_modifiers(state, n);
+	economy::bound_budget_settings(state, n);
+}
+
+scoped_deferred_nation_modifiers::scoped_deferred_nation_modifiers(sys::state& state) : state(state) {
+	++state.deferred_modifiers.depth;
+}
+scoped_deferred_nation_modifiers::~scoped_deferred_nation_modifiers() {
+	auto& deferred = state.deferred_modifiers;
+	if(--deferred.depth != 0)
+		return;
+	for(auto n : deferred.nations)
+		update_nation_modifiers_now(state, n);
+	deferred.nations.clear();
+}
+
+void update_nation_modifiers_soon(sys::state& state, dcon::nation_id n) {
+	auto& deferred = state.deferred_modifiers;
+	if(deferred.depth == 0) {
+		update_nation_modifiers_now(state, n);
+	} else if(std::find(deferred.nations.begin(), deferred.nations.end(), n) == deferred.nations.end()) {
+		deferred.nations.push_back(n);
+	}
+}
+
 // restores values after loading a save
 void repopulate_modifier_effects(sys::state& state) {
 	recreate_national_modifiers(state);
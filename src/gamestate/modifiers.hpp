@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <vector>
 #include "date_interface.hpp"
 #include "dcon_generated.hpp"
 
@@ -331,6 +332,22 @@ void repopulate_modifier_effects(sys::state& state);
 void update_modifier_effects(sys::state& state);
 void update_single_nation_modifiers(sys::state& state, dcon::nation_id n);
 
+// An event option that enacts several reforms, or gives several technologies, would recompute all of the nation's modifiers
+// after each of them. While this scope (it is held around every effect, see effect::execute) is open, they are only marked
+// as out of date by update_nation_modifiers_soon, and each marked nation is recomputed once when the outermost scope ends.
+struct deferred_nation_modifiers {
+	std::vector<dcon::nation_id> nations;
+	int32_t depth = 0;
+};
+class scoped_deferred_nation_modifiers {
+	sys::state& state;
+public:
+	explicit scoped_deferred_nation_modifiers(sys::state& state);
+	~scoped_deferred_nation_modifiers();
+};
+// recomputes the modifiers of the nation, and the budget settings bounded by them, now or once the scope above ends
+void update_nation_modifiers_soon(sys::state& state, dcon::nation_id n);
+
 void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id,
 		sys::date expiration); // default construct date for no expiration
 void add_modifier_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id,
@@ -4,16 +4,30 @@
 namespace notification {
 
 void post(sys::state& state, message&& m) {
-	//
-	// TODO: pre filter out any messages that the player is not interested in at all according to their message settings.
-	// But, probably don't try to fiter out by "interesting" except for considering whether the player nation is itself involved
-	// as that will probably be a more computationally expensive check
-	//
+	// messages that the player's settings would ignore entirely are dropped here, rather than taking up space in the queue until
+	// the ui thread gets around to discarding them (which matters during large wars, when most battles and sieges are between
+	// nations the player doesn't care about)
+	if(get_response_bits(state, m) == 0)
+		return;
 
 	bool v = state.new_messages.try_emplace(std::move(m));
 	assert(v);
 }
 
+uint8_t get_response_bits(sys::state& state, message const& m) {
+	auto setting_types = sys::message_setting_map[int32_t(m.type)];
+	auto bits_for = [&](dcon::nation_id n, sys::message_setting_type t) -> uint8_t {
+		if(t == sys::message_setting_type::count)
+			return 0;
+		if(n == state.local_player_nation)
+			return state.user_settings.self_message_settings[int32_t(t)];
+		if(nation_is_interesting(state, n))
+			return state.user_settings.interesting_message_settings[int32_t(t)];
+		return state.user_settings.other_message_settings[int32_t(t)];
+	};
+	return uint8_t(bits_for(m.source, setting_types.source) | bits_for(m.target, setting_types.target) | bits_for(m.third, setting_types.third));
+}
+
 bool nation_is_interesting(sys::state& state, dcon::nation_id n) {
 	return state.world.nation_get_is_interesting(n);
 }
@@ -15,6 +15,8 @@ struct message {
 };
 
 void post(sys::state& state, message&& m);
+// the sys::message_response flags the player's message settings give to the message; 0 if it is to be ignored entirely
+uint8_t get_response_bits(sys::state& state, message const& m);
 bool nation_is_interesting(sys::state& state, dcon::nation_id n);
 
 } // namespace notification
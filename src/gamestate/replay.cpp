@@ -0,0 +1,168 @@
+#include "replay.hpp"
+#include "system_state.hpp"
+#include "serialization.hpp"
+#include <cstring>
+
+namespace sys {
+
+namespace {
+
+constexpr uint32_t replay_magic = 0x50524c41; // "ALRP"
+// bump whenever command::payload or the layout below changes; a replay is only valid for the build that recorded it anyway
+constexpr uint32_t replay_version = 1;
+
+template<typename T>
+void write_replay_value(std::vector<uint8_t>& out, T const& v) {
+	auto old_size = out.size();
+	out.resize(old_size + sizeof(T));
+	std::memcpy(out.data() + old_size, &v, sizeof(T));
+}
+template<typename T>
+bool read_replay_value(uint8_t const*& ptr, uint8_t const* end, T& v) {
+	if(size_t(end - ptr) < sizeof(T))
+		return false;
+	std::memcpy(&v, ptr, sizeof(T));
+	ptr += sizeof(T);
+	return true;
+}
+
+}
+
+std::vector<uint8_t> replay::serialize() const {
+	std::vector<uint8_t> out;
+	out.reserve(initial_state.size() + commands.size() * sizeof(entry) + 256);
+	write_replay_value(out, replay_magic);
+	write_replay_value(out, replay_version);
+	write_replay_value(out, uint32_t(sizeof(command::payload)));
+	write_replay_value(out, scenario_checksum);
+	write_replay_value(out, start_date);
+	write_replay_value(out, end_date);
+	write_replay_value(out, uint32_t(player_nations.size()));
+	for(auto n : player_nations)
+		write_replay_value(out, n);
+	write_replay_value(out, uint64_t(initial_state.size()));
+	out.insert(out.end(), initial_state.begin(), initial_state.end());
+	write_replay_value(out, uint32_t(commands.size()));
+	for(auto& e : commands) {
+		write_replay_value(out, e.date);
+		write_replay_value(out, e.command);
+	}
+	return out;
+}
+
+bool replay::deserialize(uint8_t const* ptr, uint8_t const* end) {
+	initial_state.clear();
+	player_nations.clear();
+	commands.clear();
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t payload_size = 0;
+	if(!read_replay_value(ptr, end, magic) || !read_replay_value(ptr, end, version) || !read_replay_value(ptr, end, payload_size))
+		return false;
+	if(magic != replay_magic || version != replay_version || payload_size != uint32_t(sizeof(command::payload)))
+		return false;
+	if(!read_replay_value(ptr, end, scenario_checksum) || !read_replay_value(ptr, end, start_date) || !read_replay_value(ptr, end, end_date))
+		return false;
+
+	uint32_t count = 0;
+	if(!read_replay_value(ptr, end, count) || size_t(end - ptr) / sizeof(dcon::nation_id) < count)
+		return false;
+	player_nations.resize(count);
+	for(uint32_t i = 0; i < count; ++i)
+		read_replay_value(ptr, end, player_nations[i]);
+
+	uint64_t state_size = 0;
+	if(!read_replay_value(ptr, end, state_size) || uint64_t(end - ptr) < state_size)
+		return false;
+	initial_state.assign(ptr, ptr + state_size);
+	ptr += state_size;
+
+	if(!read_replay_value(ptr, end, count) || size_t(end - ptr) / (sizeof(sys::date) + sizeof(command::payload)) < count)
+		return false;
+	commands.resize(count);
+	for(uint32_t i = 0; i < count; ++i) {
+		read_replay_value(ptr, end, commands[i].date);
+		read_replay_value(ptr, end, commands[i].command);
+	}
+	return true;
+}
+
+bool is_recorded_in_replays(command::command_type t) {
+	switch(t) {
+	case command::command_type::invalid:
+	case command::command_type::save_game:
+	case command::command_type::console_command: // its text is not part of the payload
+		return false;
+	case command::command_type::notify_player_picks_nation: // decides which nations the ai runs
+		return true;
+	default:
+		return uint8_t(t) < uint8_t(command::command_type::notify_player_ban);
+	}
+}
+
+void replay_recorder::start(sys::state& state) {
+	current = replay{};
+	current.scenario_checksum = state.scenario_checksum;
+	current.start_date = state.current_date;
+	current.initial_state.resize(sizeof_save_section(state));
+	write_save_section(current.initial_state.data(), state);
+	for(auto n : state.world.in_nation) {
+		if(n.get_is_player_controlled())
+			current.player_nations.push_back(n);
+	}
+	active = true;
+}
+
+void replay_recorder::record(sys::state& state, command::payload const& c) {
+	if(active && is_recorded_in_replays(c.type))
+		current.commands.push_back(replay::entry{ state.current_date, c });
+}
+
+void replay_recorder::record_batch_end(sys::state& state) {
+	if(!active)
+		return;
+	// running the updates twice in a row changes nothing, so a batch that recorded nothing new needs no second marker
+	if(!current.commands.empty() && current.commands.back().command.type == command::command_type::invalid && current.commands.back().date == state.current_date)
+		return;
+	replay::entry e{ state.current_date, command::payload{} };
+	std::memset(&e.command, 0, sizeof(command::payload));
+	e.command.type = command::command_type::invalid;
+	current.commands.push_back(e);
+}
+
+replay replay_recorder::stop(sys::state& state) {
+	active = false;
+	current.end_date = state.current_date;
+	return std::move(current);
+}
+
+bool load_replay_start(sys::state& state, replay const& r) {
+	if(!state.scenario_checksum.is_equal(r.scenario_checksum))
+		return false;
+
+	state.preload();
+	read_save_section(r.initial_state.data(), r.initial_state.data() + r.initial_state.size(), state);
+	state.fill_unsaved_data();
+	for(auto n : r.player_nations)
+		state.world.nation_set_is_player_controlled(n, true);
+	return state.current_date == r.start_date;
+}
+
+bool prepare_replay_day(sys::state& state, replay const& r, size_t& next_command) {
+	while(next_command < r.commands.size() && r.commands[next_command].date == state.current_date) {
+		auto c = r.commands[next_command].command;
+		if(c.type == command::command_type::invalid) {
+			// the end of a batch, as in command::execute_pending_commands
+			province::update_connected_regions(state);
+			province::update_cached_values(state);
+			nations::update_cached_values(state);
+		} else {
+			command::execute_command(state, c);
+		}
+		++next_command;
+	}
+	return state.current_date < r.end_date;
+}
+
+} // namespace sys
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "container_types.hpp"
+#include "date_interface.hpp"
+#include "commands.hpp"
+
+namespace sys {
+struct state;
+}
+
+namespace sys {
+
+// A recorded stretch of a game: the save section of the state it started from, and every command executed from then on
+// along with the day it was executed on. As the simulation is deterministic given the starting state and the commands,
+// playing the commands back reproduces the game exactly, at whatever speed the machine can manage.
+struct replay {
+	struct entry {
+		sys::date date;
+		command::payload command; // see replay_recorder::record_batch_end for entries of type invalid
+	};
+
+	checksum_key scenario_checksum;
+	std::vector<uint8_t> initial_state; // an uncompressed save section
+	std::vector<dcon::nation_id> player_nations; // fill_unsaved_data does not restore who was controlled by a player
+	std::vector<entry> commands;
+	sys::date start_date;
+	sys::date end_date;
+
+	std::vector<uint8_t> serialize() const;
+	// returns false if the data is truncated, malformed or from a different version
+	bool deserialize(uint8_t const* start, uint8_t const* end);
+};
+
+// whether a command changes the game state and so has to be part of a replay (rather than only driving the network, the ui
+// or the game speed)
+bool is_recorded_in_replays(command::command_type t);
+
+// Records a replay from the state at the time start is called. start and stop have to be called between ticks, with the
+// game state locked; record is called by command::execute_command.
+class replay_recorder {
+public:
+	bool recording() const {
+		return active;
+	}
+	void start(sys::state& state);
+	void record(sys::state& state, command::payload const& c);
+	// called by command::execute_pending_commands after it has updated the cached values at the end of a batch of commands;
+	// in the replay this is an entry of type invalid, at which the same updates are made
+	void record_batch_end(sys::state& state);
+	// stops the recording and hands over the replay
+	replay stop(sys::state& state);
+
+private:
+	replay current;
+	bool active = false;
+};
+
+// Loads the state a replay starts from; the scenario the replay was recorded with must already be loaded. Returns false
+// if it was recorded with a different scenario.
+bool load_replay_start(sys::state& state, replay const& r);
+// Executes the commands recorded on the current day, starting from next_command (which is advanced past them), so that the
+// next call to single_game_tick continues the replay; returns false once the end of the replay has been reached.
+bool prepare_replay_day(sys::state& state, replay const& r, size_t& next_command);
+
+} // namespace sys
@@ -0,0 +1,246 @@
+#include "sampling_profiler.hpp"
+#include <stdio.h>
+#include <algorithm>
+#include <array>
+
+#ifdef _WIN64
+
+#ifndef UNICODE
+#define UNICODE
+#endif
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+
+#include "Windows.h"
+
+#else
+
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <execinfo.h>
+#include <dlfcn.h>
+
+#endif
+
+namespace sys {
+
+#ifdef _WIN64
+
+void sampling_profiler::set_target_to_current_thread() {
+	if(has_target)
+		CloseHandle(reinterpret_cast<HANDLE>(target));
+	auto handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, GetCurrentThreadId());
+	target = reinterpret_cast<uintptr_t>(handle);
+	has_target = handle != nullptr;
+}
+
+bool sampling_profiler::take_sample(std::vector<uintptr_t>& frames) {
+	std::array<uintptr_t, max_depth> addresses;
+	int32_t depth = 0;
+
+	// Nothing may be allocated (or any other lock taken) while the thread is suspended, as it may be holding the lock itself.
+	auto handle = reinterpret_cast<HANDLE>(target);
+	if(SuspendThread(handle) == DWORD(-1))
+		return false;
+	CONTEXT context{};
+	context.ContextFlags = CONTEXT_FULL;
+	if(GetThreadContext(handle, &context)) {
+		while(context.Rip != 0 && depth < max_depth) {
+			addresses[depth++] = uintptr_t(context.Rip);
+			DWORD64 image_base = 0;
+			auto function = RtlLookupFunctionEntry(context.Rip, &image_base, nullptr);
+			if(function) {
+				void* handler_data = nullptr;
+				DWORD64 establisher_frame = 0;
+				RtlVirtualUnwind(UNW_FLAG_NHANDLER, image_base, context.Rip, function, &context, &handler_data, &establisher_frame, nullptr);
+			} else {
+				// a leaf function, which keeps its return address at the top of the stack
+				context.Rip = *reinterpret_cast<DWORD64 const*>(context.Rsp);
+				context.Rsp += 8;
+			}
+		}
+	}
+	ResumeThread(handle);
+
+	frames.assign(addresses.begin(), addresses.begin() + depth);
+	return depth > 0;
+}
+
+static std::string describe_address(uintptr_t address) {
+	HMODULE module = nullptr;
+	char offset[24];
+	if(!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, reinterpret_cast<LPCSTR>(address), &module)) {
+		snprintf(offset, sizeof(offset), "?+0x%llx", static_cast<unsigned long long>(address));
+		return offset;
+	}
+	char path[MAX_PATH] = { 0 };
+	GetModuleFileNameA(module, path, MAX_PATH);
+	std::string_view name{ path };
+	if(auto slash = name.find_last_of("\\/"); slash != std::string_view::npos)
+		name = name.substr(slash + 1);
+	snprintf(offset, sizeof(offset), "+0x%llx", static_cast<unsigned long long>(address - reinterpret_cast<uintptr_t>(module)));
+	return std::string(name) + offset;
+}
+
+static bool install_sampler() {
+	return true;
+}
+static void uninstall_sampler() { }
+
+#else
+
+namespace {
+
+// The signal handler can only reach the profiler through globals. Only one thread is ever sampled at a time: request_state
+// goes from 0 (idle) to 1, set by the sampling thread before it sends the signal, to 2 once the handler has filled in the frames.
+std::atomic<int32_t> request_state = 0;
+void* signal_frames[sampling_profiler::max_depth + 2];
+int32_t signal_depth = 0;
+struct sigaction previous_action;
+
+void sample_signal_handler(int) {
+	if(request_state.load(std::memory_order::acquire) != 1)
+		return;
+	auto saved_errno = errno;
+	signal_depth = backtrace(signal_frames, sampling_profiler::max_depth + 2);
+	errno = saved_errno;
+	request_state.store(2, std::memory_order::release);
+}
+
+}
+
+void sampling_profiler::set_target_to_current_thread() {
+	target = uintptr_t(pthread_self());
+	has_target = true;
+}
+
+bool sampling_profiler::take_sample(std::vector<uintptr_t>& frames) {
+	request_state.store(1, std::memory_order::release);
+	if(pthread_kill(pthread_t(target), SIGPROF) != 0) {
+		request_state.store(0, std::memory_order::release);
+		return false;
+	}
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+	while(request_state.load(std::memory_order::acquire) != 2) {
+		if(std::chrono::steady_clock::now() > deadline) {
+			// the thread could not run the handler in time (it may have been descheduled); give up on this sample, unless the
+			// handler has started in the meantime
+			int32_t expected = 1;
+			if(request_state.compare_exchange_strong(expected, 0, std::memory_order::acq_rel))
+				return false;
+		}
+		std::this_thread::yield();
+	}
+	// the first two frames are the handler itself and the kernel's signal trampoline
+	frames.clear();
+	for(int32_t i = 2; i < signal_depth; ++i)
+		frames.push_back(uintptr_t(signal_frames[i]));
+	request_state.store(0, std::memory_order::release);
+	return !frames.empty();
+}
+
+static std::string describe_address(uintptr_t address) {
+	Dl_info info;
+	char offset[24];
+	if(dladdr(reinterpret_cast<void*>(address), &info) == 0 || !info.dli_fname) {
+		snprintf(offset, sizeof(offset), "?+0x%llx", static_cast<unsigned long long>(address));
+		return offset;
+	}
+	std::string_view name{ info.dli_fname };
+	if(auto slash = name.find_last_of('/'); slash != std::string_view::npos)
+		name = name.substr(slash + 1);
+	snprintf(offset, sizeof(offset), "+0x%llx", static_cast<unsigned long long>(address - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+	return std::string(name) + offset;
+}
+
+static bool install_sampler() {
+	// backtrace loads the unwinder the first time it is called, which must not happen inside the signal handler
+	void* warm_up[1];
+	backtrace(warm_up, 1);
+
+	struct sigaction action{};
+	action.sa_handler = sample_signal_handler;
+	action.sa_flags = SA_RESTART; // so that the blocking calls of the game thread are not interrupted by the samples
+	sigemptyset(&action.sa_mask);
+	return sigaction(SIGPROF, &action, &previous_action) == 0;
+}
+static void uninstall_sampler() {
+	sigaction(SIGPROF, &previous_action, nullptr);
+}
+
+#endif
+
+bool sampling_profiler::start(std::chrono::microseconds interval) {
+	stop();
+	if(!has_target || !install_sampler())
+		return false;
+	{
+		std::lock_guard l{ samples_lock };
+		samples.clear();
+		total_samples = 0;
+	}
+	active.store(true, std::memory_order::release);
+	sampler = std::thread([this, interval]() { sample_loop(interval); });
+	return true;
+}
+
+void sampling_profiler::stop() {
+	if(!active.exchange(false, std::memory_order::acq_rel))
+		return;
+	if(sampler.joinable())
+		sampler.join();
+	uninstall_sampler();
+}
+
+void sampling_profiler::sample_loop(std::chrono::microseconds interval) {
+	std::vector<uintptr_t> frames;
+	frames.reserve(max_depth);
+	auto next = std::chrono::steady_clock::now();
+	while(active.load(std::memory_order::acquire)) {
+		// after a stall (a breakpoint, a suspended laptop), carry on from now rather than trying to catch up
+		next = std::max(next + interval, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(next);
+		if(!take_sample(frames))
+			continue;
+		std::reverse(frames.begin(), frames.end());
+		std::lock_guard l{ samples_lock };
+		++samples[frames];
+		++total_samples;
+	}
+}
+
+int64_t sampling_profiler::sample_count() const {
+	std::lock_guard l{ samples_lock };
+	return total_samples;
+}
+
+std::string sampling_profiler::to_folded() const {
+	std::vector<std::pair<std::vector<uintptr_t> const*, int64_t>> stacks;
+	std::lock_guard l{ samples_lock };
+	stacks.reserve(samples.size());
+	for(auto& s : samples)
+		stacks.emplace_back(&s.first, s.second);
+	std::sort(stacks.begin(), stacks.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+
+	std::map<uintptr_t, std::string> names;
+	std::string out;
+	for(auto& s : stacks) {
+		bool first = true;
+		for(auto address : *s.first) {
+			auto it = names.find(address);
+			if(it == names.end())
+				it = names.emplace(address, describe_address(address)).first;
+			if(!first)
+				out += ';';
+			out += it->second;
+			first = false;
+		}
+		out += ' ';
+		out += std::to_string(s.second);
+		out += '\n';
+	}
+	return out;
+}
+
+} // namespace sys
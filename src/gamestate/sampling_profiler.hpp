@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sys {
+
+// Periodically captures the call stack of one thread (the game thread, see state::game_loop) from a separate sampling thread,
+// so that release builds can be profiled where no external profiler can be attached. On linux the thread is interrupted with
+// SIGPROF and walks its own stack; on windows it is briefly suspended and its stack is unwound from the outside. Nothing is
+// symbolized in the game: the stacks are written out as module-relative addresses, see to_folded.
+class sampling_profiler {
+public:
+	static constexpr int32_t max_depth = 96;
+
+	~sampling_profiler() {
+		stop();
+	}
+
+	// makes the calling thread the one that will be sampled; has to be called before start
+	void set_target_to_current_thread();
+	// starts sampling at the given interval, discarding the previous samples; returns false if there is no thread to sample
+	// or sampling is not supported on this platform
+	bool start(std::chrono::microseconds interval);
+	// stops sampling without discarding the samples
+	void stop();
+	bool running() const {
+		return active.load(std::memory_order::acquire);
+	}
+	int64_t sample_count() const;
+	// One line per distinct stack, outermost frame first, in the folded format read by flamegraph.pl and speedscope:
+	// `Alice+0x1a2b3c;Alice+0x1a4d00;... 17`. The offsets are relative to the base the module was loaded at, so they can be
+	// symbolized offline against the same build, with `addr2line -f -C -e Alice 0x1a2b3c` or, for windows builds,
+	// `llvm-symbolizer --relative-address --obj=Alice.exe 0x1a2b3c`.
+	std::string to_folded() const;
+
+private:
+	void sample_loop(std::chrono::microseconds interval);
+	// fills frames with the return addresses on the target thread's stack, innermost first
+	bool take_sample(std::vector<uintptr_t>& frames);
+
+	uintptr_t target = 0; // a pthread_t, or a thread HANDLE on windows
+	bool has_target = false;
+	std::atomic<bool> active = false;
+	std::thread sampler;
+	mutable std::mutex samples_lock;
+	std::map<std::vector<uintptr_t>, int64_t> samples; // stacks stored outermost frame first
+	int64_t total_samples = 0;
+};
+
+} // namespace sys
@@ -0,0 +1,241 @@
+#include "save_checksum.hpp"
+#include "system_state.hpp"
+#include <algorithm>
+#include <cstring>
+#include "blake2.h"
+
+namespace sys {
+
+void save_checksum_cache::serialize_world(sys::state& state) {
+	dcon::load_record loaded = state.world.make_serialize_record_store_save();
+	auto required = state.world.serialize_size(loaded);
+	if(required > buffer_capacity) {
+		// the world only grows in the course of a game, so leave some room to avoid reallocating every time it does
+		buffer_capacity = required + required / 8;
+		buffer = std::unique_ptr<uint8_t[]>(new uint8_t[buffer_capacity]);
+	}
+	std::byte* start = reinterpret_cast<std::byte*>(buffer.get());
+	std::byte* end = start;
+	state.world.serialize(end, loaded);
+
+	records.clear();
+	pieces.clear();
+	dcon::for_each_record(start, end, [&](dcon::record_header const& header, std::byte const* data_start, std::byte const* data_end) {
+		record_hash r;
+		r.object = std::string_view{ header.object_name_start, header.object_name_end };
+		r.property = std::string_view{ header.property_name_start, header.property_name_end };
+		r.offset = uint32_t(data_start - start);
+		r.size = uint32_t(data_end - data_start);
+		r.first_piece = uint32_t(pieces.size());
+		for(uint32_t i = 0; i < r.size || i == 0; i += piece_size) {
+			pieces.push_back(piece{ r.offset + i, std::min(piece_size, r.size - i) });
+		}
+		r.piece_count = uint32_t(pieces.size()) - r.first_piece;
+		records.push_back(r);
+	});
+}
+
+checksum_key save_checksum_cache::hash_buffer() {
+	piece_hashes.resize(pieces.size());
+	concurrency::parallel_for(0, int32_t(pieces.size()), [&](int32_t i) {
+		blake2b(&piece_hashes[i], sizeof(checksum_key), buffer.get() + pieces[i].offset, pieces[i].size, nullptr, 0);
+	});
+
+	std::vector<checksum_key> record_keys;
+	record_keys.reserve(records.size());
+	for(auto& r : records) {
+		// a record made of a single piece simply takes its hash
+		if(r.piece_count == 1)
+			r.hash = piece_hashes[r.first_piece];
+		else
+			blake2b(&r.hash, sizeof(checksum_key), piece_hashes.data() + r.first_piece, sizeof(checksum_key) * r.piece_count, nullptr, 0);
+		record_keys.push_back(r.hash);
+	}
+
+	checksum_key key;
+	blake2b(&key, sizeof(key), record_keys.data(), sizeof(checksum_key) * record_keys.size(), nullptr, 0);
+	return key;
+}
+
+void save_checksum_cache::finish_async() {
+	// the result itself stays in the future until it is taken by async_result
+	if(async_result_future.valid())
+		async_result_future.wait();
+}
+
+checksum_key save_checksum_cache::compute(sys::state& state) {
+	finish_async();
+	std::lock_guard l{ lock };
+	serialize_world(state);
+	return hash_buffer();
+}
+
+void save_checksum_cache::compute_async(sys::state& state, sys::date d) {
+	finish_async();
+	std::lock_guard l{ lock };
+	serialize_world(state);
+	// the buffer is not touched again before the hashing is done, see finish_async
+	async_result_future = std::async(std::launch::async, [this, d]() {
+		std::lock_guard l{ lock };
+		auto key = hash_buffer();
+		return std::pair<checksum_key, checksum_tree>{ key, copy_tree(d) };
+	});
+}
+
+std::pair<checksum_key, checksum_tree> save_checksum_cache::async_result() {
+	assert(async_result_future.valid());
+	return async_result_future.get();
+}
+
+checksum_tree save_checksum_cache::make_tree(sys::date d) {
+	finish_async();
+	std::lock_guard l{ lock };
+	return copy_tree(d);
+}
+
+checksum_tree save_checksum_cache::copy_tree(sys::date d) const {
+	checksum_tree result;
+	result.date = d;
+	result.piece_size = piece_size;
+	result.pieces = piece_hashes;
+	result.records.reserve(records.size());
+	for(auto& r : records) {
+		checksum_tree::record t;
+		t.object = std::string(r.object);
+		t.property = std::string(r.property);
+		t.size = r.size;
+		t.first_piece = r.first_piece;
+		t.piece_count = r.piece_count;
+		t.hash = r.hash;
+		result.records.push_back(std::move(t));
+	}
+	return result;
+}
+
+namespace {
+
+template<typename T>
+void write_value(std::vector<uint8_t>& out, T const& v) {
+	auto old_size = out.size();
+	out.resize(old_size + sizeof(T));
+	std::memcpy(out.data() + old_size, &v, sizeof(T));
+}
+void write_string(std::vector<uint8_t>& out, std::string const& s) {
+	write_value(out, uint32_t(s.size()));
+	out.insert(out.end(), s.begin(), s.end());
+}
+template<typename T>
+bool read_value(uint8_t const*& ptr, uint8_t const* end, T& v) {
+	if(size_t(end - ptr) < sizeof(T))
+		return false;
+	std::memcpy(&v, ptr, sizeof(T));
+	ptr += sizeof(T);
+	return true;
+}
+bool read_string(uint8_t const*& ptr, uint8_t const* end, std::string& s) {
+	uint32_t length = 0;
+	if(!read_value(ptr, end, length) || size_t(end - ptr) < length)
+		return false;
+	s.assign(reinterpret_cast<char const*>(ptr), length);
+	ptr += length;
+	return true;
+}
+
+}
+
+std::vector<uint8_t> checksum_tree::serialize() const {
+	std::vector<uint8_t> out;
+	write_value(out, date);
+	write_value(out, piece_size);
+	write_value(out, uint32_t(records.size()));
+	for(auto& r : records) {
+		write_string(out, r.object);
+		write_string(out, r.property);
+		write_value(out, r.size);
+		write_value(out, r.first_piece);
+		write_value(out, r.piece_count);
+		write_value(out, r.hash);
+	}
+	write_value(out, uint32_t(pieces.size()));
+	for(auto& p : pieces)
+		write_value(out, p);
+	return out;
+}
+
+bool checksum_tree::deserialize(uint8_t const* ptr, uint8_t const* end) {
+	records.clear();
+	pieces.clear();
+
+	uint32_t count = 0;
+	if(!read_value(ptr, end, date) || !read_value(ptr, end, piece_size) || !read_value(ptr, end, count))
+		return false;
+	for(uint32_t i = 0; i < count; ++i) {
+		record r;
+		if(!read_string(ptr, end, r.object) || !read_string(ptr, end, r.property))
+			return false;
+		if(!read_value(ptr, end, r.size) || !read_value(ptr, end, r.first_piece) || !read_value(ptr, end, r.piece_count) || !read_value(ptr, end, r.hash))
+			return false;
+		records.push_back(std::move(r));
+	}
+	if(!read_value(ptr, end, count) || size_t(end - ptr) / sizeof(checksum_key) < count)
+		return false;
+	pieces.resize(count);
+	for(uint32_t i = 0; i < count; ++i)
+		read_value(ptr, end, pieces[i]);
+	for(auto& r : records) {
+		if(uint64_t(r.first_piece) + uint64_t(r.piece_count) > uint64_t(pieces.size()))
+			return false;
+	}
+	return true;
+}
+
+std::string describe_divergence(checksum_tree const& local, checksum_tree const& remote) {
+	std::string result;
+	if(local.date != remote.date)
+		result += "checksums were taken on different days (" + std::to_string(local.date.value) + " vs " + std::to_string(remote.date.value) + ")\n";
+
+	for(auto& r : remote.records) {
+		auto it = std::find_if(local.records.begin(), local.records.end(), [&](checksum_tree::record const& l) {
+			return l.object == r.object && l.property == r.property;
+		});
+		if(it == local.records.end()) {
+			result += r.object + "." + r.property + ": missing locally\n";
+			continue;
+		}
+		auto& l = *it;
+		if(l.hash.is_equal(r.hash))
+			continue;
+
+		result += r.object + "." + r.property + ":";
+		if(l.size != r.size)
+			result += " size " + std::to_string(l.size) + " vs " + std::to_string(r.size) + ";";
+		if(local.piece_size != remote.piece_size) {
+			result += " contents differ\n";
+			continue;
+		}
+		// report runs of consecutive differing pieces as byte ranges within the record
+		auto common = std::min(l.piece_count, r.piece_count);
+		uint32_t i = 0;
+		while(i < common) {
+			if(local.pieces[l.first_piece + i].is_equal(remote.pieces[r.first_piece + i])) {
+				++i;
+				continue;
+			}
+			auto run_start = i;
+			while(i < common && !local.pieces[l.first_piece + i].is_equal(remote.pieces[r.first_piece + i]))
+				++i;
+			result += " bytes [" + std::to_string(run_start * local.piece_size) + ", " + std::to_string(std::min(i * local.piece_size, std::min(l.size, r.size))) + ")";
+		}
+		result += "\n";
+	}
+	for(auto& l : local.records) {
+		auto it = std::find_if(remote.records.begin(), remote.records.end(), [&](checksum_tree::record const& r) {
+			return l.object == r.object && l.property == r.property;
+		});
+		if(it == remote.records.end())
+			result += l.object + "." + l.property + ": missing on the host\n";
+	}
+	return result;
+}
+
+} // namespace sys
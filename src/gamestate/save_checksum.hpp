@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "container_types.hpp"
+#include "date_interface.hpp"
+
+namespace sys {
+struct state;
+}
+
+namespace sys {
+
+// A snapshot of the per record and per piece hashes behind a save checksum. The host keeps the trees of the checksums it
+// has sent, a client keeps the tree of the checksum that did not match, and comparing the two pins down the diverging
+// columns and byte ranges without having to diff full oos dumps.
+struct checksum_tree {
+	struct record {
+		std::string object;
+		std::string property;
+		uint32_t size = 0;
+		uint32_t first_piece = 0;
+		uint32_t piece_count = 0;
+		checksum_key hash;
+	};
+
+	sys::date date;
+	uint32_t piece_size = 0;
+	std::vector<record> records;
+	std::vector<checksum_key> pieces;
+
+	std::vector<uint8_t> serialize() const;
+	// returns false if the data is truncated or malformed
+	bool deserialize(uint8_t const* start, uint8_t const* end);
+};
+
+// one line per record that is missing from either tree or whose contents differ, with the differing byte ranges
+std::string describe_divergence(checksum_tree const& local, checksum_tree const& remote);
+
+// Computes the save checksum used for out of sync detection. Rather than allocating a fresh buffer for the serialized
+// world and hashing it front to back every time, the serialization buffer is kept between calls and every dcon record
+// (one object.property column) is hashed independently and in parallel. The final key is the hash of the record hashes.
+class save_checksum_cache {
+public:
+	// records are split into pieces of at most this many bytes, which bounds both the size of a single parallel work item
+	// and the granularity at which divergence can be reported
+	static constexpr uint32_t piece_size = uint32_t(1) << 16;
+
+	struct record_hash {
+		std::string_view object;
+		std::string_view property;
+		uint32_t offset = 0; // from the start of the serialized world
+		uint32_t size = 0;
+		uint32_t first_piece = 0;
+		uint32_t piece_count = 0;
+		checksum_key hash;
+	};
+
+	checksum_key compute(sys::state& state);
+	// Serializes the world right away but hashes it on a background thread, so that the game can carry on ticking in the
+	// meantime. The key comes with the tree of its hashes, dated d. Every other member function first waits for the
+	// background hashing to finish.
+	void compute_async(sys::state& state, sys::date d);
+	bool async_pending() const {
+		return async_result_future.valid();
+	}
+	bool async_ready() const {
+		return async_result_future.valid() && async_result_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+	// waits for the result of compute_async, which can only be taken once
+	std::pair<checksum_key, checksum_tree> async_result();
+	// a copy of the hashes from the most recent call to compute
+	checksum_tree make_tree(sys::date d);
+
+private:
+	struct piece {
+		uint32_t offset = 0;
+		uint32_t size = 0;
+	};
+
+	void serialize_world(sys::state& state);
+	checksum_key hash_buffer();
+	void finish_async();
+	checksum_tree copy_tree(sys::date d) const;
+
+	std::unique_ptr<uint8_t[]> buffer;
+	size_t buffer_capacity = 0;
+	std::vector<record_hash> records;
+	std::vector<piece> pieces;
+	std::vector<checksum_key> piece_hashes;
+	std::mutex lock;
+	std::future<std::pair<checksum_key, checksum_tree>> async_result_future;
+};
+
+} // namespace sys
@@ -3,6 +3,7 @@
 #include "serialization.hpp"
 #include <random>
 #include <ctime>
+#include <future>
 
 #define ZSTD_STATIC_LINKING_ONLY
 #define XXH_NAMESPACE ZSTD_
@@ -100,14 +101,70 @@ mod_identifier extract_mod_information(uint8_t const* ptr_in, uint64_t file_size
 	native_string mod_path;
 	read_mod_path(ptr_in, file_end, mod_path);
 
-	return mod_identifier{ mod_path, h.timestamp, h.count };
+	return mod_identifier{ mod_path, h.timestamp, h.count, h.sources };
 }
 
+checksum_key compute_scenario_sources_checksum(simple_fs::file_system const& fs) {
+	static native_char const* const content_directories[] = { NATIVE("common"), NATIVE("map"), NATIVE("history"), NATIVE("events"),
+		NATIVE("decisions"), NATIVE("inventions"), NATIVE("technologies"), NATIVE("units"), NATIVE("poptypes"), NATIVE("news"),
+		NATIVE("tutorial"), NATIVE("battleplans"), NATIVE("scripted triggers"), NATIVE("localisation"), NATIVE("interface") };
+
+	blake2b_state hasher;
+	blake2b_init(&hasher, sizeof(checksum_key::key));
+	auto add_directory = [&](auto& self, simple_fs::directory const& dir, bool include_contents) -> void {
+		for(auto& f : simple_fs::list_files(dir, NATIVE(""))) {
+			auto name = simple_fs::get_full_name(f); // also tells apart the same file provided by different mods
+			blake2b_update(&hasher, name.data(), name.length() * sizeof(native_char));
+			if(include_contents) {
+				if(auto opened = simple_fs::open_file(f); opened) {
+					auto content = simple_fs::view_contents(*opened);
+					uint64_t size = content.file_size;
+					blake2b_update(&hasher, &size, sizeof(size));
+					blake2b_update(&hasher, content.data, content.file_size);
+				}
+			}
+		}
+		for(auto& d : simple_fs::list_subdirectories(dir))
+			self(self, d, include_contents);
+	};
+
+	auto root = simple_fs::get_root(fs);
+	for(auto d : content_directories)
+		add_directory(add_directory, simple_fs::open_directory(root, d), true);
+	add_directory(add_directory, simple_fs::open_directory(root, NATIVE("gfx")), false);
+
+	checksum_key result;
+	blake2b_final(&hasher, result.key, sizeof(result.key));
+	return result;
+}
+
+/*
+Sections are compressed as a sequence of independent zstd frames of (roughly) compressed_frame_size bytes each, which are
+compressed, and when loading decompressed, in parallel. Since a concatenation of frames is still a valid zstd stream, files
+written this way can be read by older builds and files written as a single frame by older builds can still be read.
+*/
+constexpr uint32_t compressed_frame_size = uint32_t(8) << 20;
+
 uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size) {
 	uint32_t decompressed_length = uncompressed_size;
 
-	uint32_t section_length = uint32_t(ZSTD_compress(ptr_out + sizeof(uint32_t) * 2, ZSTD_compressBound(uncompressed_size), ptr_in,
-		uncompressed_size, 0)); // write compressed data
+	// the remainder is folded into the last frame, so that the frames never need more room than ZSTD_compressBound of the whole
+	uint32_t frame_count = std::max(uint32_t(1), uncompressed_size / compressed_frame_size);
+	std::vector<std::unique_ptr<uint8_t[]>> frames(frame_count);
+	std::vector<size_t> frame_sizes(frame_count, 0);
+	concurrency::parallel_for(uint32_t(0), frame_count, [&](uint32_t i) {
+		uint32_t offset = i * compressed_frame_size;
+		uint32_t size = (i + 1 == frame_count) ? uncompressed_size - offset : compressed_frame_size;
+		auto bound = ZSTD_compressBound(size);
+		frames[i] = std::unique_ptr<uint8_t[]>(new uint8_t[bound]);
+		frame_sizes[i] = ZSTD_compress(frames[i].get(), bound, ptr_in + offset, size, 0);
+	});
+
+	uint32_t section_length = 0;
+	for(uint32_t i = 0; i < frame_count; ++i) {
+		memcpy(ptr_out + sizeof(uint32_t) * 2 + section_length, frames[i].get(), frame_sizes[i]); // write compressed data
+		section_length += uint32_t(frame_sizes[i]);
+	}
 
 	memcpy(ptr_out, &section_length, sizeof(uint32_t));
 	memcpy(ptr_out + sizeof(uint32_t), &decompressed_length, sizeof(uint32_t));
@@ -123,17 +180,228 @@ uint8_t const* with_decompressed_section(uint8_t const* ptr_in, T const& functio
 	memcpy(&decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
 
 	uint8_t* temp_buffer = new uint8_t[decompressed_length];
-	// TODO: allocate memory for decompression and decompress into it
+	uint8_t const* compressed = ptr_in + sizeof(uint32_t) * 2;
+
+	struct frame {
+		size_t compressed_offset = 0;
+		size_t compressed_size = 0;
+		size_t decompressed_offset = 0;
+		size_t decompressed_size = 0;
+	};
+	std::vector<frame> frames;
+	bool frames_known = true;
+	for(size_t offset = 0, out_offset = 0; offset < section_length;) {
+		auto compressed_size = ZSTD_findFrameCompressedSize(compressed + offset, section_length - offset);
+		auto content_size = ZSTD_getFrameContentSize(compressed + offset, section_length - offset);
+		if(ZSTD_isError(compressed_size) || content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR || out_offset + content_size > decompressed_length) {
+			frames_known = false;
+			break;
+		}
+		frames.push_back(frame{ offset, compressed_size, out_offset, size_t(content_size) });
+		offset += compressed_size;
+		out_offset += size_t(content_size);
+	}
 
-	ZSTD_decompress(temp_buffer, decompressed_length, ptr_in + sizeof(uint32_t) * 2, section_length);
+	if(frames_known && frames.size() > 1) {
+		concurrency::parallel_for(0, int32_t(frames.size()), [&](int32_t i) {
+			ZSTD_decompress(temp_buffer + frames[i].decompressed_offset, frames[i].decompressed_size, compressed + frames[i].compressed_offset, frames[i].compressed_size);
+		});
+	} else {
+		ZSTD_decompress(temp_buffer, decompressed_length, compressed, section_length);
+	}
 
-	// function(ptr_in + sizeof(uint32_t) * 2, decompressed_length);
 	function(temp_buffer, decompressed_length);
 
 	delete[] temp_buffer;
 	return ptr_in + sizeof(uint32_t) * 2 + section_length;
 }
 
+constexpr size_t uncompressed_section_alignment = 4096;
+
+// the alignment is relative to the start of the file, which is where the mapping of the file starts
+uint8_t* write_uncompressed_section(uint8_t* ptr_out, uint8_t const* file_start, uint8_t const* ptr_in, uint32_t size) {
+	auto data_offset = size_t(ptr_out - file_start) + sizeof(uint32_t) * 2;
+	uint32_t padding = uint32_t((uncompressed_section_alignment - data_offset % uncompressed_section_alignment) % uncompressed_section_alignment);
+
+	memcpy(ptr_out, &size, sizeof(uint32_t));
+	memcpy(ptr_out + sizeof(uint32_t), &padding, sizeof(uint32_t));
+	memset(ptr_out + sizeof(uint32_t) * 2, 0, padding);
+	memcpy(ptr_out + sizeof(uint32_t) * 2 + padding, ptr_in, size);
+
+	return ptr_out + sizeof(uint32_t) * 2 + padding + size;
+}
+
+template<typename T>
+uint8_t const* with_uncompressed_section(uint8_t const* ptr_in, T const& function) {
+	uint32_t size = 0;
+	uint32_t padding = 0;
+	memcpy(&size, ptr_in, sizeof(uint32_t));
+	memcpy(&padding, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
+
+	function(ptr_in + sizeof(uint32_t) * 2 + padding, size);
+
+	return ptr_in + sizeof(uint32_t) * 2 + padding + size;
+}
+
+template<typename T>
+uint8_t const* with_scenario_file_section(scenario_header const& header, uint8_t const* ptr_in, T const& function) {
+	if((header.flags & scenario_flags::uncompressed_sections) != 0)
+		return with_uncompressed_section(ptr_in, function);
+	return with_decompressed_section(ptr_in, function);
+}
+
+uint8_t const* skip_scenario_file_section(scenario_header const& header, uint8_t const* ptr_in) {
+	uint32_t size = 0;
+	uint32_t second = 0; // the padding of an uncompressed section, or the decompressed length of a compressed one
+	memcpy(&size, ptr_in, sizeof(uint32_t));
+	memcpy(&second, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
+	if((header.flags & scenario_flags::uncompressed_sections) != 0)
+		return ptr_in + sizeof(uint32_t) * 2 + second + size;
+	return ptr_in + sizeof(uint32_t) * 2 + size;
+}
+
+/*
+A save of a game started from a scenario mostly repeats the save section of that scenario: the definitions, the map and
+whatever else has not changed since the start. Delta saves are therefore compressed with the scenario's save section as a
+prefix (what zstd's --patch-from does), so that everything that is still as it was comes out as a reference into the
+scenario instead of as data of its own. Long distance matching finds those references even where what comes before them has
+grown or shrunk, and the window has to span both the prefix and the section.
+*/
+std::vector<uint8_t> read_scenario_save_section(native_string_view scenario_name, checksum_key const& checksum) {
+	std::vector<uint8_t> result;
+	if(scenario_name.empty())
+		return result;
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	auto scenario_file = open_file(dir, scenario_name);
+	if(!scenario_file)
+		return result;
+
+	scenario_header header;
+	header.version = 0;
+	auto contents = simple_fs::view_contents(*scenario_file);
+	uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
+	auto file_end = buffer_pos + contents.file_size;
+	if(contents.file_size > sizeof_scenario_header(header))
+		buffer_pos = read_scenario_header(buffer_pos, header);
+	if(header.version != sys::scenario_file_version || !header.checksum.is_equal(checksum))
+		return result;
+
+	native_string mod_path;
+	read_mod_path(buffer_pos, file_end, mod_path);
+	buffer_pos += sizeof_mod_path(mod_path);
+	buffer_pos = skip_scenario_file_section(header, buffer_pos);
+	with_scenario_file_section(header, buffer_pos, [&](uint8_t const* ptr_in, uint32_t length) { result.assign(ptr_in, ptr_in + length); });
+	return result;
+}
+
+int32_t delta_window_log(size_t prefix_size, size_t content_size) {
+	int32_t window_log = ZSTD_WINDOWLOG_MIN;
+	while(window_log < ZSTD_WINDOWLOG_MAX && (size_t(1) << window_log) < prefix_size + content_size)
+		++window_log;
+	return window_log;
+}
+
+uint8_t* write_delta_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size, std::vector<uint8_t> const& prefix) {
+	auto cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, delta_window_log(prefix.size(), uncompressed_size));
+	ZSTD_CCtx_refPrefix(cctx, prefix.data(), prefix.size());
+	auto section_length = uint32_t(ZSTD_compress2(cctx, ptr_out + sizeof(uint32_t) * 2, ZSTD_compressBound(uncompressed_size), ptr_in, uncompressed_size));
+	ZSTD_freeCCtx(cctx);
+
+	memcpy(ptr_out, &section_length, sizeof(uint32_t));
+	memcpy(ptr_out + sizeof(uint32_t), &uncompressed_size, sizeof(uint32_t));
+	return ptr_out + sizeof(uint32_t) * 2 + section_length;
+}
+
+template<typename T>
+uint8_t const* with_delta_decompressed_section(uint8_t const* ptr_in, std::vector<uint8_t> const& prefix, T const& function) {
+	uint32_t section_length = 0;
+	uint32_t decompressed_length = 0;
+	memcpy(&section_length, ptr_in, sizeof(uint32_t));
+	memcpy(&decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
+
+	auto temp_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[decompressed_length]);
+	auto dctx = ZSTD_createDCtx();
+	ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, ZSTD_WINDOWLOG_MAX);
+	ZSTD_DCtx_refPrefix(dctx, prefix.data(), prefix.size());
+	ZSTD_decompressDCtx(dctx, temp_buffer.get(), decompressed_length, ptr_in + sizeof(uint32_t) * 2, section_length);
+	ZSTD_freeDCtx(dctx);
+
+	function(temp_buffer.get(), decompressed_length);
+	return ptr_in + sizeof(uint32_t) * 2 + section_length;
+}
+
+checksum_key section_key(uint8_t const* data, size_t size) {
+	checksum_key key;
+	blake2b(&key, sizeof(key), data, size, nullptr, 0);
+	return key;
+}
+
+// the bases are not .bin files, so that they are not listed among the saves
+native_string autosave_base_file_name(checksum_key const& key) {
+	std::string file_name = "autosave_base_";
+	for(uint32_t i = 0; i < 8; ++i) {
+		char const* digits = "0123456789abcdef";
+		file_name += digits[key.key[i] >> 4];
+		file_name += digits[key.key[i] & 0x0F];
+	}
+	file_name += ".base";
+	return simple_fs::utf8_to_native(file_name);
+}
+
+std::vector<uint8_t> read_autosave_base_section(native_string_view scenario_name, checksum_key const& key) {
+	std::vector<uint8_t> result;
+	auto dir = simple_fs::get_or_create_save_game_directory();
+	auto base_file = simple_fs::open_file(dir, autosave_base_file_name(key));
+	if(!base_file)
+		return result;
+
+	save_header header;
+	header.version = 0;
+	auto contents = simple_fs::view_contents(*base_file);
+	uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
+	if(contents.file_size > sizeof_save_header(header))
+		buffer_pos = read_save_header(buffer_pos, header);
+	if(header.version != sys::save_file_version)
+		return result;
+
+	auto keep = [&](uint8_t const* ptr_in, uint32_t length) { result.assign(ptr_in, ptr_in + length); };
+	if((header.flags & save_flags::delta_from_scenario) != 0) {
+		auto baseline = read_scenario_save_section(scenario_name, header.checksum);
+		if(baseline.empty())
+			return result;
+		with_delta_decompressed_section(buffer_pos, baseline, keep);
+	} else {
+		with_decompressed_section(buffer_pos, keep);
+	}
+	if(!section_key(result.data(), result.size()).is_equal(key))
+		result.clear();
+	return result;
+}
+
+// the bases that no autosave is compressed against anymore, other than the current one
+void remove_unreferenced_autosave_bases(simple_fs::directory const& dir, checksum_key const& current_base) {
+	std::vector<native_string> referenced{ autosave_base_file_name(current_base) };
+	for(int32_t i = 0; i < sys::max_autosaves; ++i) {
+		auto autosave = simple_fs::open_file(dir, native_string(NATIVE("autosave_")) + simple_fs::utf8_to_native(std::to_string(i)) + native_string(NATIVE(".bin")));
+		if(autosave) {
+			auto content = simple_fs::view_contents(*autosave);
+			save_header header;
+			if(content.file_size > sizeof_save_header(header)) {
+				read_save_header(reinterpret_cast<uint8_t const*>(content.data), header);
+				if((header.flags & save_flags::delta_from_autosave_base) != 0)
+					referenced.push_back(autosave_base_file_name(header.base));
+			}
+		}
+	}
+	for(auto& f : simple_fs::list_files(dir, NATIVE(".base"))) {
+		auto name = simple_fs::get_file_name(f);
+		if(std::find(referenced.begin(), referenced.end(), name) == referenced.end())
+			simple_fs::remove_file(dir, name);
+	}
+}
+
 uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* section_end, sys::state& state) {
 	// hand-written contribution
 	{ // map
@@ -828,6 +1096,7 @@ void write_scenario_file(sys::state& state, native_string_view name, uint32_t co
 	scenario_header header;
 	header.count = count;
 	header.timestamp = uint64_t(std::time(nullptr));
+	header.sources = state.scenario_sources_checksum;
 
 	auto scenario_space = sizeof_scenario_section(state);
 	size_t save_space = sizeof_save_section(state);
@@ -899,7 +1168,7 @@ bool try_read_scenario_file(sys::state& state, native_string_view name) {
 
 		buffer_pos = load_mod_path(buffer_pos, state);
 
-		buffer_pos = with_decompressed_section(buffer_pos,
+		buffer_pos = with_scenario_file_section(header, buffer_pos,
 				[&](uint8_t const* ptr_in, uint32_t length) { read_scenario_section(ptr_in, ptr_in + length, state); });
 
 		return true;
@@ -936,9 +1205,9 @@ bool try_read_scenario_and_save_file(sys::state& state, native_string_view name)
 
 		buffer_pos = load_mod_path(buffer_pos, state);
 
-		buffer_pos = with_decompressed_section(buffer_pos,
+		buffer_pos = with_scenario_file_section(header, buffer_pos,
 				[&](uint8_t const* ptr_in, uint32_t length) { read_scenario_section(ptr_in, ptr_in + length, state); });
-		buffer_pos = with_decompressed_section(buffer_pos,
+		buffer_pos = with_scenario_file_section(header, buffer_pos,
 				[&](uint8_t const* ptr_in, uint32_t length) { read_save_section(ptr_in, ptr_in + length, state); });
 
 		state.game_seed = uint32_t(std::random_device()());
@@ -977,11 +1246,11 @@ bool try_read_scenario_as_save_file(sys::state& state, native_string_view name)
 
 		buffer_pos = load_mod_path(buffer_pos, state);
 
-		buffer_pos = with_decompressed_section(buffer_pos,
+		buffer_pos = with_scenario_file_section(header, buffer_pos,
 			[&](uint8_t const* ptr_in, uint32_t length) {
 				// DO NOTHING -- this skips over reading the scenario section
 			});
-		buffer_pos = with_decompressed_section(buffer_pos,
+		buffer_pos = with_scenario_file_section(header, buffer_pos,
 			[&](uint8_t const* ptr_in, uint32_t length) {
 				read_save_section(ptr_in, ptr_in + length, state);
 			});
@@ -994,6 +1263,61 @@ bool try_read_scenario_as_save_file(sys::state& state, native_string_view name)
 	}
 }
 
+bool unpack_scenario_file(native_string_view name) {
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	std::vector<uint8_t> unpacked;
+	{
+		auto scenario_file = open_file(dir, name);
+		if(!scenario_file)
+			return false;
+
+		scenario_header header;
+		header.version = 0;
+
+		auto contents = simple_fs::view_contents(*scenario_file);
+		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
+		auto file_end = buffer_pos + contents.file_size;
+
+		if(contents.file_size > sizeof_scenario_header(header)) {
+			buffer_pos = read_scenario_header(buffer_pos, header);
+		}
+		if(header.version != sys::scenario_file_version)
+			return false;
+		if((header.flags & scenario_flags::uncompressed_sections) != 0)
+			return true;
+
+		// the mod path is copied over as is
+		auto mod_path_start = buffer_pos;
+		uint32_t mod_path_length = 0;
+		memcpy(&mod_path_length, buffer_pos, sizeof(uint32_t));
+		buffer_pos += sizeof(uint32_t) + mod_path_length * sizeof(native_char);
+		auto mod_path_size = size_t(buffer_pos - mod_path_start);
+		if(buffer_pos > file_end)
+			return false;
+
+		std::vector<uint8_t> scenario_section;
+		std::vector<uint8_t> save_section;
+		buffer_pos = with_decompressed_section(buffer_pos, [&](uint8_t const* ptr_in, uint32_t length) {
+			scenario_section.assign(ptr_in, ptr_in + length);
+		});
+		buffer_pos = with_decompressed_section(buffer_pos, [&](uint8_t const* ptr_in, uint32_t length) {
+			save_section.assign(ptr_in, ptr_in + length);
+		});
+
+		header.flags |= scenario_flags::uncompressed_sections;
+		unpacked.resize(sizeof_scenario_header(header) + mod_path_size + scenario_section.size() + save_section.size() + (sizeof(uint32_t) * 2 + uncompressed_section_alignment) * 2);
+		auto write_pos = write_scenario_header(unpacked.data(), header);
+		memcpy(write_pos, mod_path_start, mod_path_size);
+		write_pos += mod_path_size;
+		write_pos = write_uncompressed_section(write_pos, unpacked.data(), scenario_section.data(), uint32_t(scenario_section.size()));
+		write_pos = write_uncompressed_section(write_pos, unpacked.data(), save_section.data(), uint32_t(save_section.size()));
+		unpacked.resize(size_t(write_pos - unpacked.data()));
+	}
+	// the mapping of the original file has been released here, so it can be overwritten
+	simple_fs::write_file(dir, name, reinterpret_cast<char const*>(unpacked.data()), uint32_t(unpacked.size()));
+	return true;
+}
+
 std::string make_time_string(uint64_t value) {
 	std::string result;
 	for(int32_t i = 64 / 4; i --> 0; ) {
@@ -1002,6 +1326,11 @@ std::string make_time_string(uint64_t value) {
 	return result;
 }
 
+void finish_background_save(sys::state& state) {
+	if(state.background_save.valid())
+		state.background_save.get();
+}
+
 void write_save_file(sys::state& state, save_type type, std::string const& name) {
 	save_header header;
 	header.count = state.scenario_counter;
@@ -1020,42 +1349,97 @@ void write_save_file(sys::state& state, save_type type, std::string const& name)
 		header.save_name[31] = 0;
 	}
 
-	size_t save_space = sizeof_save_section(state);
-
-	// this is an upper bound, since compacting the data may require less space
-	size_t total_size = sizeof_save_header(header) + ZSTD_compressBound(save_space) + sizeof(uint32_t) * 2;
-
-	uint8_t* temp_buffer = new uint8_t[total_size];
-	uint8_t* buffer_position = temp_buffer;
-
-	buffer_position = write_save_header(buffer_position, header);
-
-	uint8_t* temp_save_buffer = new uint8_t[save_space];
-	write_save_section(temp_save_buffer, state);
-
-	buffer_position = write_compressed_section(buffer_position, temp_save_buffer, uint32_t(save_space));
-	delete[] temp_save_buffer;
-
-	auto total_size_used = buffer_position - temp_buffer;
-
-	auto sdir = simple_fs::get_or_create_save_game_directory();
-
+	native_string file_name;
 	if(type == sys::save_type::autosave) {
-		simple_fs::write_file(sdir, native_string(NATIVE("autosave_")) + simple_fs::utf8_to_native(std::to_string(state.autosave_counter)) + native_string(NATIVE(".bin")), reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
+		file_name = native_string(NATIVE("autosave_")) + simple_fs::utf8_to_native(std::to_string(state.autosave_counter)) + native_string(NATIVE(".bin"));
 		state.autosave_counter = (state.autosave_counter + 1) % sys::max_autosaves;
 	} else if(type == sys::save_type::bookmark) {
 		auto ymd_date = state.current_date.to_ymd(state.start_date);
 		auto base_str = "bookmark_" + make_time_string(uint64_t(std::time(nullptr))) + "-" + std::to_string(ymd_date.year) + "-" + std::to_string(ymd_date.month) + "-" + std::to_string(ymd_date.day) + ".bin";
-		simple_fs::write_file(sdir, simple_fs::utf8_to_native(base_str), reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
+		file_name = simple_fs::utf8_to_native(base_str);
 	} else {
 		auto ymd_date = state.current_date.to_ymd(state.start_date);
 		auto base_str = make_time_string(uint64_t(std::time(nullptr))) + "-" + nations::int_to_tag(state.world.national_identity_get_identifying_int(header.tag)) + "-" + std::to_string(ymd_date.year) + "-" + std::to_string(ymd_date.month) + "-" + std::to_string(ymd_date.day) + ".bin";
-		simple_fs::write_file(sdir, simple_fs::utf8_to_native(base_str), reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
+		file_name = simple_fs::utf8_to_native(base_str);
 	}
-	delete[] temp_buffer;
 
-	state.save_list_updated.store(true, std::memory_order::release); // update for ui
+	// only one save is in flight at a time, which also keeps autosaves from overtaking each other
+	finish_background_save(state);
+
+	/*
+	Serializing the save section is the only part that has to see a consistent game state, so it is done right here and
+	the serialized copy serves as the snapshot. Compressing it and writing it out does not touch the game state anymore and
+	is left to a worker thread, so that the simulation can continue in the meantime.
+	*/
+	size_t save_space = sizeof_save_section(state);
+	auto temp_save_buffer = std::shared_ptr<uint8_t[]>(new uint8_t[save_space]);
+	write_save_section(temp_save_buffer.get(), state);
+
+	// bookmarks are kept whole, since the tools that write them may rebuild the scenario they came from afterwards
+	auto delta_scenario = type == sys::save_type::bookmark ? native_string() : state.loaded_scenario_file;
+	auto compress_and_write = [&state, header, save_space, temp_save_buffer, file_name, delta_scenario, type]() {
+		auto sdir = simple_fs::get_or_create_save_game_directory();
+
+		// returns the size of the file
+		auto write_section = [&](native_string_view name, save_header const& file_header, std::vector<uint8_t> const* prefix) {
+			// this is an upper bound, since compacting the data may require less space
+			size_t total_size = sizeof_save_header(file_header) + ZSTD_compressBound(save_space) + sizeof(uint32_t) * 2;
+			auto temp_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[total_size]);
+
+			uint8_t* buffer_position = temp_buffer.get();
+			buffer_position = write_save_header(buffer_position, file_header);
+			if(prefix)
+				buffer_position = write_delta_compressed_section(buffer_position, temp_save_buffer.get(), uint32_t(save_space), *prefix);
+			else
+				buffer_position = write_compressed_section(buffer_position, temp_save_buffer.get(), uint32_t(save_space));
+			auto total_size_used = buffer_position - temp_buffer.get();
+
+			simple_fs::write_file(sdir, name, reinterpret_cast<char*>(temp_buffer.get()), uint32_t(total_size_used));
+			return size_t(total_size_used);
+		};
+		// a full save, which is still compressed against the scenario when it can be
+		auto write_full = [&](native_string_view name) {
+			auto file_header = header;
+			auto baseline = read_scenario_save_section(delta_scenario, header.checksum);
+			if(!baseline.empty())
+				file_header.flags |= save_flags::delta_from_scenario;
+			return write_section(name, file_header, baseline.empty() ? nullptr : &baseline);
+		};
+
+		if(type == sys::save_type::autosave) {
+			/*
+			The base is written in full once, and from then on every autosave only holds what differs from it, which makes
+			frequent autosaves cheap in both time and space. Once an autosave comes out at more than half the size of the base,
+			the game has moved on far enough that the next autosave starts a new base. The bases that are no longer used by
+			any autosave are removed.
+			*/
+			auto& chain = state.autosave_chain;
+			if(!chain.base || chain.rebase_due) {
+				auto base = std::make_shared<std::vector<uint8_t>>(temp_save_buffer.get(), temp_save_buffer.get() + save_space);
+				chain.base_key = section_key(base->data(), base->size());
+				chain.base_file_size = write_full(autosave_base_file_name(chain.base_key));
+				chain.base = std::move(base);
+				chain.rebase_due = false;
+			}
+			auto file_header = header;
+			file_header.flags |= save_flags::delta_from_autosave_base;
+			file_header.base = chain.base_key;
+			auto size = write_section(file_name, file_header, chain.base.get());
+			chain.rebase_due = size > chain.base_file_size / 2;
+			remove_unreferenced_autosave_bases(sdir, chain.base_key);
+		} else {
+			write_full(file_name);
+		}
 
+		state.save_list_updated.store(true, std::memory_order::release); // update for ui
+	};
+
+	if(type == sys::save_type::bookmark) {
+		// bookmarks are written in bulk by tools that may exit right afterwards
+		compress_and_write();
+	} else {
+		state.background_save = std::async(std::launch::async, std::move(compress_and_write));
+	}
 
 	if(state.cheat_data.ecodump) {
 		auto data_dumps_directory = simple_fs::get_or_create_data_dumps_directory();
@@ -1093,6 +1477,7 @@ void write_save_file(sys::state& state, save_type type, std::string const& name)
 	}
 }
 bool try_read_save_file(sys::state& state, native_string_view name) {
+	finish_background_save(state); // it may be the very file that is being loaded
 	auto dir = simple_fs::get_or_create_save_game_directory();
 	auto save_file = open_file(dir, name);
 	if(save_file) {
@@ -1118,6 +1503,27 @@ bool try_read_save_file(sys::state& state, native_string_view name) {
 		if(!state.scenario_checksum.is_equal(header.checksum))
 			return false;
 
+		if((header.flags & save_flags::delta_from_autosave_base) != 0) {
+			auto base = read_autosave_base_section(state.loaded_scenario_file, header.base);
+			if(base.empty())
+				return false;
+
+			state.loaded_save_file = name;
+			buffer_pos = with_delta_decompressed_section(buffer_pos, base,
+					[&](uint8_t const* ptr_in, uint32_t length) { read_save_section(ptr_in, ptr_in + length, state); });
+			return true;
+		}
+		if((header.flags & save_flags::delta_from_scenario) != 0) {
+			auto baseline = read_scenario_save_section(state.loaded_scenario_file, header.checksum);
+			if(baseline.empty())
+				return false;
+
+			state.loaded_save_file = name;
+			buffer_pos = with_delta_decompressed_section(buffer_pos, baseline,
+					[&](uint8_t const* ptr_in, uint32_t length) { read_save_section(ptr_in, ptr_in + length, state); });
+			return true;
+		}
+
 		state.loaded_save_file = name;
 
 		buffer_pos = with_decompressed_section(buffer_pos,
@@ -151,16 +151,30 @@ inline uint8_t const* deserialize(uint8_t const* ptr_in, ankerl::unordered_dense
 	return ptr_in + sizeof(uint32_t) + sizeof(vec.values()[0]) * length;
 }
 
-constexpr inline uint32_t save_file_version = 42;
+constexpr inline uint32_t save_file_version = 43;
 constexpr inline uint32_t scenario_file_version = 134 + save_file_version;
 
+namespace scenario_flags {
+// the sections are stored uncompressed and page aligned, see unpack_scenario_file
+constexpr inline uint32_t uncompressed_sections = 0x0001;
+}
+
 struct scenario_header {
 	uint32_t version = scenario_file_version;
 	uint32_t count = 0;
 	uint64_t timestamp = 0;
 	checksum_key checksum;
+	uint32_t flags = 0; // missing (and so zero) in files written before it was added
+	checksum_key sources; // see compute_scenario_sources_checksum; likewise zero in older files
 };
 
+namespace save_flags {
+// the save section is compressed against the save section of the scenario, see write_save_file
+constexpr inline uint32_t delta_from_scenario = 0x0001;
+// the save section is compressed against the base of the autosave chain named by save_header::base, see write_save_file
+constexpr inline uint32_t delta_from_autosave_base = 0x0002;
+}
+
 struct save_header {
 	uint32_t version = save_file_version;
 	uint32_t count = 0;
@@ -170,12 +184,15 @@ struct save_header {
 	dcon::government_type_id cgov;
 	sys::date d;
 	char save_name[32];
+	uint32_t flags = 0;
+	checksum_key base;
 };
 
 struct mod_identifier {
 	native_string mod_path;
 	uint64_t timestamp = 0;
 	uint32_t count = 0;
+	checksum_key sources;
 };
 
 void read_mod_path(uint8_t const* ptr_in, uint8_t const* lim, native_string& path_out);
@@ -191,6 +208,9 @@ size_t sizeof_scenario_header(scenario_header const& header_in);
 size_t sizeof_save_header(save_header const& header_in);
 
 mod_identifier extract_mod_information(uint8_t const* ptr_in, uint64_t file_size);
+// Hashes the names and contents of the files that building a scenario reads from (for the pictures under gfx only their
+// names), so that a scenario that is still up to date with its mod files does not have to be built again.
+checksum_key compute_scenario_sources_checksum(simple_fs::file_system const& fs);
 
 uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size);
 
@@ -210,8 +230,15 @@ void write_scenario_file(sys::state& state, native_string_view name, uint32_t co
 bool try_read_scenario_file(sys::state& state, native_string_view name);
 bool try_read_scenario_and_save_file(sys::state& state, native_string_view name);
 bool try_read_scenario_as_save_file(sys::state& state, native_string_view name);
+// Rewrites a scenario file in the scenario directory with its sections stored uncompressed and page aligned. Such a file
+// is several times larger, but loading it reads the sections straight out of the memory mapped file, with no
+// decompression and no intermediate copies. The checksum is not affected, so it still matches compressed copies.
+bool unpack_scenario_file(native_string_view name);
 
+// serializes on the calling thread, then compresses and writes the file in the background (except for bookmarks)
 void write_save_file(sys::state& state, sys::save_type type = sys::save_type::normal, std::string const& name = std::string(""));
+// blocks until a save that is still being written in the background is on disk
+void finish_background_save(sys::state& state);
 bool try_read_save_file(sys::state& state, native_string_view name);
 
 } // namespace sys
@@ -38,6 +38,14 @@
 #include "gui_unit_grid_box.hpp"
 #include "blake2.h"
 #include "fif_common.hpp"
+#ifdef PREFER_ONE_TBB
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
 
 namespace ui {
 
@@ -232,6 +240,9 @@ void create_in_game_windows(sys::state& state) {
 		auto new_elm = ui::make_element_by_type<ui::topbar_window>(state, "topbar");
 		new_elm->impl_on_update(state);
 		state.ui_state.root->add_child_to_front(std::move(new_elm));
+		// the topbar's subwindows are all opened frequently, so their textures are loaded now rather than on first use
+		ui::prefetch_window_textures(state, { "country_production", "country_budget", "country_technology", "country_politics",
+			"country_pop", "alice_country_trade", "country_diplomacy", "country_military" });
 	}
 	{
 		auto legend_win = ui::make_element_by_type<ui::map_legend_gradient>(state, "alice_map_legend_gradient_window");
@@ -323,27 +334,35 @@ void state::state_select(dcon::state_definition_id sdef) {
 //
 
 void state::on_rbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	game_scene::on_rbutton_down(*this, x, y, mod);
 }
 
 void state::on_mbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	// Lose focus on text
 	ui_state.edit_target = nullptr;
 	map_state.on_mbuttom_down(x, y, x_size, y_size, mod);
 }
 
 void state::on_lbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	game_scene::on_lbutton_down(*this, x, y, mod);
 }
 
-void state::on_rbutton_up(int32_t x, int32_t y, key_modifiers mod) { }
+void state::on_rbutton_up(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
+}
 void state::on_mbutton_up(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	map_state.on_mbuttom_up(x, y, mod);
 }
 void state::on_lbutton_up(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	game_scene::on_lbutton_up(*this, x, y, mod);
 }
 void state::on_mouse_move(int32_t x, int32_t y, key_modifiers mod) {
+	note_window_event();
 	map_state.on_mouse_move(x, y, x_size, y_size, mod);
 	if(map_state.is_dragging) {
 		if(ui_state.mouse_sensitive_target) {
@@ -365,6 +384,7 @@ void state::on_mouse_move(int32_t x, int32_t y, key_modifiers mod) {
 	}
 }
 void state::on_mouse_drag(int32_t x, int32_t y, key_modifiers mod) { // called when the left button is held down
+	note_window_event();
 	is_dragging = true;
 	if(ui_state.drag_target) {
 		ui_state.drag_target->on_drag(*this, int32_t(mouse_x_position / user_settings.ui_scale),
@@ -373,12 +393,14 @@ void state::on_mouse_drag(int32_t x, int32_t y, key_modifiers mod) { // called w
 	}
 }
 void state::on_drag_finished(int32_t x, int32_t y, key_modifiers mod) { // called when the left button is released after one or more drag events
+	note_window_event();
 	if(ui_state.drag_target) {
 		ui_state.drag_target->on_drag_finish(*this);
 		ui_state.drag_target = nullptr;
 	}
 }
 void state::on_resize(int32_t x, int32_t y, window::window_state win_state) {
+	note_window_event();
 	ogl::deinitialize_msaa(*this);
 	ogl::initialize_msaa(*this, x, y);
 
@@ -392,6 +414,7 @@ void state::on_resize(int32_t x, int32_t y, window::window_state win_state) {
 }
 
 void state::on_mouse_wheel(int32_t x, int32_t y, key_modifiers mod, float amount) { // an amount of 1.0 is one "click" of the wheel
+	note_window_event();
 	//update en demand
 	ui::element_base* root_elm = current_scene.get_root(*this);
 	ui_state.scroll_target = root_elm->impl_probe_mouse(*this,
@@ -422,6 +445,7 @@ void state::on_mouse_wheel(int32_t x, int32_t y, key_modifiers mod, float amount
 	}
 }
 void state::on_key_down(virtual_key keycode, key_modifiers mod) {
+	note_window_event();
 	if(keycode == virtual_key::CONTROL)
 		ui_state.ctrl_held_down = true;
 	if(keycode == virtual_key::SHIFT || keycode == virtual_key::LSHIFT || keycode == virtual_key::RSHIFT)
@@ -431,6 +455,7 @@ void state::on_key_down(virtual_key keycode, key_modifiers mod) {
 }
 
 void state::on_key_up(virtual_key keycode, key_modifiers mod) {
+	note_window_event();
 	if(keycode == virtual_key::CONTROL)
 		ui_state.ctrl_held_down = false;
 	if(keycode == virtual_key::SHIFT || keycode == virtual_key::LSHIFT || keycode == virtual_key::RSHIFT)
@@ -451,6 +476,7 @@ void state::on_key_up(virtual_key keycode, key_modifiers mod) {
 	map_state.on_key_up(keycode, mod);
 }
 void state::on_text(char32_t c) { // c is win1250 codepage value
+	note_window_event();
 	if(ui_state.edit_target)
 		ui_state.edit_target->on_text(*this, c);
 }
@@ -462,7 +488,23 @@ void state::render() { // called to render the frame may (and should) delay retu
 	if(!current_scene.get_root)
 		return;
 
+	auto& frame_timings = open_gl.frame_timings;
+	frame_timings.begin_frame();
+	font_collection.upload_finished_glyphs();
+	auto frame_stage_start = std::chrono::steady_clock::now();
+	auto end_frame_stage = [&](ogl::frame_profiler::cpu_stage s) {
+		if(frame_timings.active()) {
+			auto now = std::chrono::steady_clock::now();
+			frame_timings.record_cpu(s, std::chrono::duration_cast<std::chrono::microseconds>(now - frame_stage_start).count());
+			frame_stage_start = now;
+		}
+	};
+
 	auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+	if(game_state_was_updated) {
+		budget_estimates.valid = false;
+		pop_change_estimates.valid = false;
+	}
 	if(game_state_was_updated && !current_scene.starting_scene && !ui_state.lazy_load_in_game) {
 		window::change_cursor(*this, window::cursor_type::busy);
 		ui::create_in_game_windows(*this);
@@ -659,35 +701,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 			auto* c6 = new_messages.front();
 			while(c6) {
 				auto base_type = c6->type;
-				auto setting_types = sys::message_setting_map[int32_t(base_type)];
-				uint8_t settings_bits = 0;
-				if(setting_types.source != sys::message_setting_type::count) {
-					if(c6->source == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.source)];
-					} else if(notification::nation_is_interesting(*this, c6->source)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.source)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.source)];
-					}
-				}
-				if(setting_types.target != sys::message_setting_type::count) {
-					if(c6->target == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.target)];
-					} else if(notification::nation_is_interesting(*this, c6->target)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.target)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.target)];
-					}
-				}
-				if(setting_types.third != sys::message_setting_type::count) {
-					if(c6->third == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.third)];
-					} else if(notification::nation_is_interesting(*this, c6->third)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.third)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.third)];
-					}
-				}
+				uint8_t settings_bits = notification::get_response_bits(*this, *c6);
 
 				if((settings_bits & message_response::log) && ui_state.msg_log_window) {
 					static_cast<ui::message_log_window*>(ui_state.msg_log_window)->messages.push_back(*c6);
@@ -811,6 +825,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 							10);
 				ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y,
 						container);
+				ui_state.last_tooltip_location = tooltip_probe.relative_location;
 				populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
 				if(container.native_rtl == text::layout_base::rtl_status::rtl) {
 					container.used_width = -container.used_width;
@@ -848,6 +863,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 					text::alignment::left, text::text_color::white, true }, 10);
 				ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y,
 						container);
+				ui_state.last_tooltip_location = tooltip_probe.relative_location;
 				populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
 				if(container.native_rtl == text::layout_base::rtl_status::rtl) {
 					container.used_width = -container.used_width;
@@ -873,11 +889,14 @@ void state::render() { // called to render the frame may (and should) delay retu
 		} else {
 			ui_state.tooltip->set_visible(*this, false);
 		}
-	} else if(ui_state.last_tooltip && ui_state.last_tooltip->has_tooltip(*this) == ui::tooltip_behavior::position_sensitive_tooltip) {
+	} else if(ui_state.last_tooltip
+		&& (ui_state.last_tooltip_location.x != tooltip_probe.relative_location.x || ui_state.last_tooltip_location.y != tooltip_probe.relative_location.y)
+		&& ui_state.last_tooltip->has_tooltip(*this) == ui::tooltip_behavior::position_sensitive_tooltip) {
 		auto container = text::create_columnar_layout(*this, ui_state.tooltip->internal_layout,
 			text::layout_parameters{ 0, 0, tooltip_width, int16_t(root_elm->base_data.size.y - 20), ui_state.tooltip_font, 0,
 			text::alignment::left, text::text_color::white, true }, 10);
 		ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y, container);
+		ui_state.last_tooltip_location = tooltip_probe.relative_location;
 		populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
 		if(container.native_rtl == text::layout_base::rtl_status::rtl) {
 			container.used_width = -container.used_width;
@@ -983,7 +1002,14 @@ void state::render() { // called to render the frame may (and should) delay retu
 		) {
 			prov = dcon::province_id{};
 		}
-		if(prov) {
+		if(game_state_was_updated)
+			ui_state.map_tooltip_province = dcon::province_id{};
+		if(prov && (prov != ui_state.map_tooltip_province
+			|| uint8_t(map_state.active_map_mode) != ui_state.map_tooltip_mode
+			|| map_state.selected_province != ui_state.map_tooltip_selected_province
+			|| selected_armies != ui_state.map_tooltip_armies
+			|| selected_navies != ui_state.map_tooltip_navies)
+		) {
 			auto container = text::create_columnar_layout(*this, ui_state.tooltip->internal_layout,
 				text::layout_parameters{ 0, 0, tooltip_width, int16_t(ui_state.root->base_data.size.y - 20), ui_state.tooltip_font, 0, text::alignment::left, text::text_color::white, true },
 				20);
@@ -1002,7 +1028,17 @@ void state::render() { // called to render the frame may (and should) delay retu
 			}
 			ui_state.tooltip->base_data.size.x = int16_t(container.used_width + 32);
 			ui_state.tooltip->base_data.size.y = int16_t(container.used_height + 32);
-			if(container.used_width > 0) {
+			ui_state.map_tooltip_province = prov;
+			ui_state.map_tooltip_mode = uint8_t(map_state.active_map_mode);
+			ui_state.map_tooltip_selected_province = map_state.selected_province;
+			ui_state.map_tooltip_armies = selected_armies;
+			ui_state.map_tooltip_navies = selected_navies;
+			ui_state.map_tooltip_width = container.used_width;
+		}
+		if(prov) {
+			// the tooltip follows the province as the map is moved, so it is positioned every frame even when it is not rebuilt
+			auto used_width = ui_state.map_tooltip_width;
+			if(used_width > 0) {
 				// This block positions the tooltip somewhat under the province centroid
 				auto mid_point = world.province_get_mid_point(prov);
 				auto map_pos = map_state.normalize_map_coord(mid_point);
@@ -1013,7 +1049,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 					ui_state.tooltip->set_visible(*this, false);
 				} else {
 					ui_state.tooltip->base_data.position =
-						ui::xy_pair{ int16_t(screen_pos.x - container.used_width / 2 - 8), int16_t(screen_pos.y + 3.5f * map_state.get_zoom()) };
+						ui::xy_pair{ int16_t(screen_pos.x - used_width / 2 - 8), int16_t(screen_pos.y + 3.5f * map_state.get_zoom()) };
 					ui_state.tooltip->set_visible(*this, true);
 				}
 				// Alternatively: just make it visible
@@ -1022,10 +1058,16 @@ void state::render() { // called to render the frame may (and should) delay retu
 				ui_state.tooltip->set_visible(*this, false);
 			}
 		} else {
+			ui_state.map_tooltip_province = dcon::province_id{};
 			ui_state.tooltip->set_visible(*this, false);
 		}
+	} else {
+		// anything else shown in the tooltip overwrites the map tooltip's layout
+		ui_state.map_tooltip_province = dcon::province_id{};
 	}
 
+	end_frame_stage(ogl::frame_profiler::ui_update);
+
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 	glEnable(GL_BLEND);
@@ -1051,6 +1093,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 	}
 
 	current_scene.render_map(*this);
+	end_frame_stage(ogl::frame_profiler::map_submission);
 
 	//UI rendering
 	glEnable(GL_BLEND);
@@ -1115,6 +1158,35 @@ void state::render() { // called to render the frame may (and should) delay retu
 	} else { //if there is no tooltip to display, reset tooltip_timer
 		tooltip_timer = std::chrono::steady_clock::now();
 	}
+
+	frame_timings.end_pass(ogl::frame_profiler::ui);
+	end_frame_stage(ogl::frame_profiler::ui_submission);
+	frame_timings.end_frame();
+}
+
+bool state::frame_needed() {
+	// what an event does is not always on the screen in the very next frame (a window may only fill itself in on its first
+	// update, say), so frames keep coming for a little while after each one
+	constexpr auto window_event_grace = std::chrono::milliseconds{ 250 };
+
+	if(!current_scene.game_in_progress)
+		return true;
+	auto running = actual_game_speed.load(std::memory_order::acquire) > 0 && !ui_pause.load(std::memory_order::acquire)
+		&& !internally_paused && !current_scene.enforced_pause;
+	if(running)
+		return true;
+	if(game_state_updated.load(std::memory_order::acquire) || province_ownership_changed.load(std::memory_order::acquire))
+		return true;
+	if(user_settings.railroads_enabled && railroad_built.load(std::memory_order::acquire))
+		return true;
+	if(std::chrono::steady_clock::now() - last_window_event < window_event_grace)
+		return true;
+	if(ui_state.left_mouse_hold_target != nullptr)
+		return true;
+	if(map_state.is_camera_moving(*this))
+		return true;
+	map_state.stop_camera();
+	return false;
 }
 
 void state::on_create() {
@@ -1229,57 +1301,59 @@ void state::load_locale_strings(std::string_view locale_name) {
 	auto root_dir = get_root(common_fs);
     auto assets_dir = open_directory(root_dir, NATIVE("assets/localisation"));
 
-	auto load_base_files = [&](int32_t column) {
-		auto text_dir = open_directory(root_dir, NATIVE("localisation"));
-		for(auto& file : list_files(text_dir, NATIVE(".csv"))) {
-			if(auto ofile = open_file(file); ofile) {
-				auto content = view_contents(*ofile);
-				text::consume_csv_file(*this, content.data, content.file_size, column, false);
-			}
-		}
-		for(auto& file : list_files(assets_dir, NATIVE(".csv"))) {
-			if(auto ofile = open_file(file); ofile) {
-				auto content = view_contents(*ofile);
-				text::consume_csv_file(*this, content.data, content.file_size, column, false);
-			}
-		}
-	};
+	int32_t base_column = 0; // of the base game files, which hold all the supported languages in one file
 
 	if(locale_name.starts_with("en")) {
-		load_base_files(1);
+		base_column = 1;
 	} else if(locale_name.starts_with("fr")) {
-		load_base_files(2);
+		base_column = 2;
 	} else if(locale_name.starts_with("de")) {
-		load_base_files(3);
+		base_column = 3;
 	} else if(locale_name.starts_with("pl")) {
-		load_base_files(4);
+		base_column = 4;
 	} else if(locale_name.starts_with("es")) {
-		load_base_files(5);
+		base_column = 5;
 	} else if(locale_name.starts_with("it")) {
-		load_base_files(6);
+		base_column = 6;
 	} else if(locale_name.starts_with("sv")) {
-		load_base_files(7);
+		base_column = 7;
 	} else if(locale_name.starts_with("cs")) {
-		load_base_files(8);
+		base_column = 8;
 	} else if(locale_name.starts_with("hu")) {
-		load_base_files(9);
+		base_column = 9;
 	} else if(locale_name.starts_with("nl")) {
-		load_base_files(10);
+		base_column = 10;
 	} else if(locale_name.starts_with("pt")) {
-		load_base_files(11);
+		base_column = 11;
 	} else if(locale_name.starts_with("ru")) {
-		load_base_files(12);
+		base_column = 12;
 	} else if(locale_name.starts_with("fi")) {
-		load_base_files(13);
+		base_column = 13;
 	}
 
+	// the files are read in parallel, but their rows are added in the original order, so that later files still override
+	// earlier ones and new keys are given the same positions
+	std::vector<simple_fs::unopened_file> base_files;
+	if(base_column != 0) {
+		auto text_dir = open_directory(root_dir, NATIVE("localisation"));
+		base_files = list_files(text_dir, NATIVE(".csv"));
+		auto asset_files = list_files(assets_dir, NATIVE(".csv"));
+		base_files.insert(base_files.end(), asset_files.begin(), asset_files.end());
+	}
 	auto locale_dir = open_directory(assets_dir, simple_fs::utf8_to_native(locale_name));
-	for(auto& file : list_files(locale_dir, NATIVE(".csv"))) {
+	auto locale_files = list_files(locale_dir, NATIVE(".csv"));
+
+	std::vector<text::csv_entries> entries(base_files.size() + locale_files.size());
+	concurrency::parallel_for(0, int32_t(entries.size()), [&](int32_t i) {
+		bool is_base = size_t(i) < base_files.size();
+		auto& file = is_base ? base_files[i] : locale_files[i - base_files.size()];
 		if(auto ofile = open_file(file); ofile) {
 			auto content = view_contents(*ofile);
-			text::consume_csv_file(*this, content.data, content.file_size, 1, true);
+			entries[i] = text::read_csv_file(content.data, content.file_size, is_base ? base_column : 1, !is_base);
 		}
-	}
+	});
+	for(auto& e : entries)
+		text::add_csv_entries(*this, e);
 }
 
 bool state::key_is_localized(dcon::text_key tag) const {
@@ -1545,6 +1619,10 @@ void state::save_user_settings() const {
 	US_SAVE(color_blind_mode);
 	US_SAVE(UNUSED_UINT32_T);
 	US_SAVE(locale);
+	US_SAVE(simulation_threads);
+	US_SAVE(render_reserved_cores);
+	US_SAVE(simulation_high_priority);
+	US_SAVE(pin_simulation_threads);
 #undef US_SAVE
 
 	simple_fs::write_file(settings_location, NATIVE("user_settings.dat"), &buffer[0], uint32_t(ptr - buffer));
@@ -1613,6 +1691,10 @@ void state::load_user_settings() {
 			US_LOAD(color_blind_mode);
 			US_LOAD(UNUSED_UINT32_T);
 			US_LOAD(locale);
+			US_LOAD(simulation_threads);
+			US_LOAD(render_reserved_cores);
+			US_LOAD(simulation_high_priority);
+			US_LOAD(pin_simulation_threads);
 #undef US_LOAD
 		} while(false);
 
@@ -1741,6 +1823,25 @@ void list_pop_types(sys::state& state, parsers::scenario_building_context& conte
 	}
 }
 
+struct tokenized_file {
+	std::optional<simple_fs::file> file;
+	std::vector<parsers::token_and_type> tokens;
+};
+
+// opens and tokenizes the given files in parallel; the parsers that consume the results must still be run in order, since they
+// write directly into the world
+std::vector<tokenized_file> open_and_tokenize(std::vector<simple_fs::unopened_file> const& files) {
+	std::vector<tokenized_file> result(files.size());
+	concurrency::parallel_for(0, int32_t(files.size()), [&](int32_t i) {
+		result[i].file = open_file(files[i]);
+		if(result[i].file) {
+			auto content = view_contents(*result[i].file);
+			result[i].tokens = parsers::tokenize_file(content.data, content.data + content.file_size);
+		}
+	});
+	return result;
+}
+
 void state::open_diplomacy(dcon::nation_id target) {
 	if(ui_state.diplomacy_subwindow != nullptr) {
 		if(ui_state.topbar_subwindow != nullptr) {
@@ -1758,10 +1859,13 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	auto common = open_directory(root, NATIVE("common"));
 
 	parsers::scenario_building_context context(*this);
+	sys::scenario_build_timer timer;
 
 	//text::name_into_font_id(*this, "garamond_14");
 	ui::load_text_gui_definitions(*this, context.gfx_context, err);
 
+	timer.end_stage("gui definitions");
+
 	auto map = open_directory(root, NATIVE("map"));
 	// parse default.map
 	{
@@ -1843,7 +1947,13 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	}
 
 
-	std::thread map_loader([&]() { map_state.load_map_data(context); });
+	int64_t map_load_microseconds = 0;
+	std::thread map_loader([&]() {
+		auto map_load_start = std::chrono::steady_clock::now();
+		map_state.load_map_data(context);
+		map_load_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - map_load_start).count();
+	});
+	timer.end_stage("map definitions");
 
 	parsers::make_leader_images(context);
 
@@ -2291,6 +2401,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	}
 
+	timer.end_stage("common files");
+
 	// load scripted triggers
 	auto stdir = open_directory(root, NATIVE("scripted triggers"));
 	for(auto st_file : simple_fs::list_files(stdir, NATIVE(".txt"))) {
@@ -2299,6 +2411,7 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 			auto content = view_contents(*opened_file);
 			err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
 			parsers::token_generator gen(content.data, content.data + content.file_size);
+			sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 			parsers::parse_scripted_trigger_file(gen, err, context);
 		}
 	}
@@ -2317,6 +2430,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 
 	world.province_resize_rgo_max_size_per_good(world.commodity_size());
 
+	timer.end_stage("scripted triggers and country files");
+
 	// load province history files
 	auto history = open_directory(root, NATIVE("history"));
 	{
@@ -2328,11 +2443,15 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 				if(opened_file) {
 					err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
 					auto content = view_contents(*opened_file);
+					sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 					parsers::parse_csv_province_history_file(*this, content.data, content.data + content.file_size, err, context);
 				}
 			}
 
-			for(auto prov_file : list_files(subdir, NATIVE(".txt"))) {
+			auto prov_files = list_files(subdir, NATIVE(".txt"));
+			auto tokenized_prov_files = open_and_tokenize(prov_files);
+			for(size_t i = 0; i < prov_files.size(); ++i) {
+				auto& prov_file = prov_files[i];
 				auto file_name = simple_fs::native_to_utf8(get_file_name(prov_file));
 				auto name_start = file_name.c_str();
 				auto name_end = name_start + file_name.length();
@@ -2354,18 +2473,18 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 				err.file_name = simple_fs::native_to_utf8(get_full_name(prov_file));
 				auto province_id = parsers::parse_int(std::string_view(value_start, value_end), 0, err);
 				if(province_id > 0 && uint32_t(province_id) < context.original_id_to_prov_id_map.size()) {
-					auto opened_file = open_file(prov_file);
-					if(opened_file) {
+					if(tokenized_prov_files[i].file) {
 						auto pid = context.original_id_to_prov_id_map[province_id];
 						parsers::province_file_context pf_context{ context, pid };
-						auto content = view_contents(*opened_file);
-						parsers::token_generator gen(content.data, content.data + content.file_size);
+						parsers::token_generator gen(tokenized_prov_files[i].tokens);
+						sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 						parsers::parse_province_history_file(gen, err, pf_context);
 					}
 				}
 			}
 		}
 	}
+	timer.end_stage("province history");
 	culture::set_default_issue_and_reform_options(*this);
 	// load pop history files
 	{
@@ -2380,12 +2499,11 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		auto directory_file_count = list_files(date_directory, NATIVE(".txt")).size();
 		if(directory_file_count == 0)
 			date_directory = open_directory(pop_history, simple_fs::utf8_to_native("1836.1.1"));
-		for(auto pop_file : list_files(date_directory, NATIVE(".txt"))) {
-			auto opened_file = open_file(pop_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
+		for(auto& pop_file : open_and_tokenize(list_files(date_directory, NATIVE(".txt")))) {
+			if(pop_file.file) {
+				err.file_name = simple_fs::native_to_utf8(get_full_name(*pop_file.file));
+				parsers::token_generator gen(pop_file.tokens);
+				sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 				parsers::parse_pop_history_file(gen, err, context);
 			}
 		}
@@ -2397,11 +2515,14 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 			if(opened_file) {
 				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
 				auto content = view_contents(*opened_file);
+				sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 				parsers::parse_csv_pop_history_file(*this, content.data, content.data + content.file_size, err, context);
 			}
 		}
 	}
 
+	timer.end_stage("pop history");
+
 	// load poptype definitions
 	{
 		auto poptypes = open_directory(root, NATIVE("poptypes"));
@@ -2578,36 +2699,41 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 			parsers::read_pending_rebel_type(r.second.id, r.second.generator_state, err, context);
 		}
 	}
+	timer.end_stage("pending common contents");
+
 	// load decisions
 	{
 		auto decisions = open_directory(root, NATIVE("decisions"));
-		for(auto decision_file : list_files(decisions, NATIVE(".txt"))) {
-			auto opened_file = open_file(decision_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
+		for(auto& decision_file : open_and_tokenize(list_files(decisions, NATIVE(".txt")))) {
+			if(decision_file.file) {
+				err.file_name = simple_fs::native_to_utf8(get_full_name(*decision_file.file));
+				parsers::token_generator gen(decision_file.tokens);
+				sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 				parsers::parse_decision_file(gen, err, context);
 			}
 		}
 	}
+	timer.end_stage("decisions");
+
 	// load events
 	{
 		auto events = open_directory(root, NATIVE("events"));
-		std::vector<simple_fs::file> held_open_files;
-		for(auto event_file : list_files(events, NATIVE(".txt"))) {
-			auto opened_file = open_file(event_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
+		// the pending events point into these files (and their tokens) until they are committed
+		auto held_open_files = open_and_tokenize(list_files(events, NATIVE(".txt")));
+		for(auto& event_file : held_open_files) {
+			if(event_file.file) {
+				err.file_name = simple_fs::native_to_utf8(get_full_name(*event_file.file));
+				parsers::token_generator gen(event_file.tokens);
+				sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 				parsers::parse_event_file(gen, err, context);
-				held_open_files.emplace_back(std::move(*opened_file));
 			}
 		}
+		timer.end_stage("events");
 		err.file_name = "pending events";
 		parsers::commit_pending_events(err, context);
 	}
+	timer.end_stage("committing events");
+
 	// load news
 	{
 		auto news_dir = open_directory(root, NATIVE("news"));
@@ -2647,6 +2773,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	}
 
+	timer.end_stage("news, tutorial and battleplans");
+
 	// load oob
 	{
 		auto oob_dir = open_directory(history, NATIVE("units"));
@@ -2722,6 +2850,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 			}
 		}
 	}
+	timer.end_stage("order of battle");
+
 	// parse diplomacy history
 	{
 		auto diplomacy_dir = open_directory(history, NATIVE("diplomacy"));
@@ -2745,8 +2875,10 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	// load country history
 	{
 		auto country_dir = open_directory(history, NATIVE("countries"));
-		for(auto country_file : list_files(country_dir, NATIVE(".txt"))) {
-			auto file_name = get_full_name(country_file);
+		auto country_files = list_files(country_dir, NATIVE(".txt"));
+		auto tokenized_country_files = open_and_tokenize(country_files);
+		for(size_t i = 0; i < country_files.size(); ++i) {
+			auto file_name = get_full_name(country_files[i]);
 
 			auto last = file_name.c_str() + file_name.length();
 			auto first = file_name.c_str();
@@ -2772,11 +2904,10 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 
 					parsers::country_history_context new_context{ context, it->second, holder, pending_decisions };
 
-					auto opened_file = open_file(country_file);
-					if(opened_file) {
+					if(tokenized_country_files[i].file) {
 						err.file_name = utf8name;
-						auto content = view_contents(*opened_file);
-						parsers::token_generator gen(content.data, content.data + content.file_size);
+						parsers::token_generator gen(tokenized_country_files[i].tokens);
+						sys::scenario_build_timer::scoped_file file_timer(timer, err.file_name);
 						parsers::parse_country_history_file(gen, err, new_context);
 					}
 
@@ -2803,6 +2934,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	}
 
+	timer.end_stage("diplomacy, country and war history");
+
 	// misc touch ups
 	nations::generate_initial_state_instances(*this);
 	world.nation_resize_stockpiles(world.commodity_size());
@@ -2830,6 +2963,9 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	world.nation_resize_unit_stats(uint32_t(military_definitions.unit_base_definitions.size()));
 	world.nation_resize_max_building_level(economy::max_building_types);
 	world.province_resize_modifier_values(provincial_mod_offsets::count);
+
+	// the ideology and issue staging buffers depend on the scenario, and any old buffers may be far larger than needed
+	demographics_buffers.reset(new demographics::tick_buffers(*this));
 	world.nation_resize_demographics(demographics::size(*this));
 	world.state_instance_resize_demographics(demographics::size(*this));
 	world.province_resize_demographics(demographics::size(*this));
@@ -2859,6 +2995,9 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	world.nation_resize_effective_prices(world.commodity_size());
 	world.commodity_resize_price_record(economy::price_history_length);
 	world.nation_resize_gdp_record(economy::gdp_history_length);
+	world.commodity_resize_yearly_price_record(economy::yearly_history_length);
+	world.nation_resize_yearly_gdp_record(economy::yearly_history_length);
+	world.nation_resize_yearly_population_record(economy::yearly_history_length);
 
 	nations_by_rank.resize(2000); // TODO: take this value directly from the data container: max number of nations
 	nations_by_industrial_score.resize(2000);
@@ -2884,7 +3023,10 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	}
 
+	timer.end_stage("misc touch ups");
 	map_loader.join();
+	timer.end_stage("waiting for the map");
+	timer.add_background("map data", map_load_microseconds);
 
 	// touch up adjacencies
 	world.for_each_province_adjacency([&](dcon::province_adjacency_id id) {
@@ -3163,6 +3305,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	}
 
+	timer.end_stage("province and unit touch ups, ui scripts");
+
 	// run pending triggers and effects
 	for(auto pending_decision : pending_decisions) {
 		dcon::nation_id n = pending_decision.first;
@@ -3217,6 +3361,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		}
 	});
 
+	timer.end_stage("initial state");
+
 	economy::presimulate(*this);
 
 	ai::identify_focuses(*this);
@@ -3228,6 +3374,9 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	military::recover_org(*this);
 
 	military::set_initial_leaders(*this);
+
+	timer.end_stage("presimulation and ai");
+	err.build_timings = timer.report(20);
 }
 
 void state::preload() {
@@ -3276,7 +3425,9 @@ void state::preload() {
 
 void state::on_scenario_load() {
 	world.pop_type_resize_issues_fns(world.issue_option_size());
+	world.pop_type_resize_issues_block_fns(world.issue_option_size());
 	world.pop_type_resize_ideology_fns(world.ideology_size());
+	world.pop_type_resize_ideology_block_fns(world.ideology_size());
 	world.pop_type_resize_promotion_fns(world.pop_type_size());
 
 	if(network_mode != network_mode_type::single_player)
@@ -3299,11 +3450,28 @@ void state::on_scenario_load() {
 
 
 	fif::interpreter_stack values{ };
+	// everything handed to the jit is also collected here, so that the cached object code can be keyed on it
+	std::string jit_source;
+	auto add_definitions = [&](std::string const& fn_str) {
+		jit_source += fn_str;
+		fif::run_fif_interpreter(*jit_environment, fn_str, values);
+	};
 
 	//AllocConsole();
 	//freopen("CONOUT$", "w", stdout);
 	//freopen("CONOUT$", "w", stderr);
 
+	// The block exports take (buffer, count): the buffer holds count pop ids, each of which is overwritten in place by the
+	// value of the modifier for that pop. Demographics hands them all the pops of one type in a block at once.
+	auto block_definition = [](std::string const& base_name) {
+		return ": " + base_name + "block let buf let count 0 var i "
+			"while i @ count < loop "
+				"i @ 4 * buf buf-add dup ptr-cast ptr(i32) @ " + base_name + "internal swap ptr-cast ptr(f32) ! "
+				"i @ 1 + i ! "
+			"end-while ; "
+			":export " + base_name + "blk i32 ptr(nil) " + base_name + "block ; ";
+	};
+
 	for(auto p : world.in_pop_type) {
 		for(auto i : world.in_issue_option) {
 			auto mkey = world.pop_type_get_issues(p, i);
@@ -3311,11 +3479,13 @@ void state::on_scenario_load() {
 			if(mkey) {
 				std::string fn_str = ": " + base_name + "internal >pop_id dup " + fif_trigger::multiplicative_modifier(*this, mkey) + " drop drop r> ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				fn_str += block_definition(base_name);
+				add_definitions(fn_str);
 			} else {
 				std::string fn_str = ": " + base_name + "internal" + " drop 0.0 ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				fn_str += block_definition(base_name);
+				add_definitions(fn_str);
 			}
 		}
 
@@ -3325,11 +3495,13 @@ void state::on_scenario_load() {
 			if(mkey) {
 				std::string fn_str = ": " + base_name + "internal >pop_id dup " + fif_trigger::multiplicative_modifier(*this, mkey) + " drop drop r> ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				fn_str += block_definition(base_name);
+				add_definitions(fn_str);
 			} else {
 				std::string fn_str = ": " + base_name + "internal" + " drop 0.0 ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				fn_str += block_definition(base_name);
+				add_definitions(fn_str);
 			}
 		}
 
@@ -3339,7 +3511,7 @@ void state::on_scenario_load() {
 			if(mkey) {
 				std::string fn_str = ": " + base_name + "internal >pop_id dup " + fif_trigger::additive_modifier(*this, mkey) + " drop drop r> ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				add_definitions(fn_str);
 			}
 		}
 
@@ -3349,7 +3521,7 @@ void state::on_scenario_load() {
 			if(mkey) {
 				std::string fn_str = ": " + base_name + "internal swap >pop_id swap >province_id " + fif_trigger::multiplicative_modifier(*this, mkey) + " drop drop r> ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				add_definitions(fn_str);
 			}
 		}
 		{
@@ -3358,22 +3530,163 @@ void state::on_scenario_load() {
 			if(mkey) {
 				std::string fn_str = ": " + base_name + "internal swap >pop_id swap >nation_id " + fif_trigger::multiplicative_modifier(*this, mkey) + " drop drop r> ; ";
 				fn_str += ":export " + base_name + "ext" + " i32 i32 " + base_name + "internal ; ";
-				fif::run_fif_interpreter(*jit_environment, fn_str, values);
+				add_definitions(fn_str);
 			}
 		}
 	}
 	{
 		std::string fn_str = ": promote_internal >pop_id dup " + fif_trigger::additive_modifier(*this, culture_definitions.promotion_chance) + " drop drop r> ; ";
 		fn_str += ":export promote_ext i32 promote_internal ; ";
-		fif::run_fif_interpreter(*jit_environment, fn_str, values);
+		add_definitions(fn_str);
 	}
 	{
 		std::string fn_str = ": demote_internal >pop_id dup " + fif_trigger::additive_modifier(*this, culture_definitions.demotion_chance) + " drop drop r> ; ";
 		fn_str += ":export demote_ext i32 demote_internal ; ";
-		fif::run_fif_interpreter(*jit_environment, fn_str, values);
+		add_definitions(fn_str);
+	}
+
+	// event triggers and mtth modifiers; the triggers are compiled to return 1.0 or 0.0
+	auto compile_event = [&](std::string const& base_name, std::string const& to_slot, dcon::trigger_key t, dcon::value_modifier_key mtth) {
+		if(t) {
+			std::string fn_str = ": " + base_name + "tinternal " + to_slot + " dup " + fif_trigger::evaluate(*this, t) + " >r drop drop r> 0.0 swap 1.0 swap select ; ";
+			fn_str += ":export " + base_name + "text" + " i32 " + base_name + "tinternal ; ";
+			add_definitions(fn_str);
+		}
+		if(mtth) {
+			std::string fn_str = ": " + base_name + "minternal " + to_slot + " dup " + fif_trigger::multiplicative_modifier(*this, mtth) + " drop drop r> ; ";
+			fn_str += ":export " + base_name + "mext" + " i32 " + base_name + "minternal ; ";
+			add_definitions(fn_str);
+		}
+	};
+	for(auto e : world.in_free_national_event) {
+		compile_event("fne" + std::to_string(e.id.index()), ">nation_id", e.get_trigger(), e.get_mtth());
+	}
+	for(auto e : world.in_free_provincial_event) {
+		compile_event("fpe" + std::to_string(e.id.index()), ">province_id", e.get_trigger(), e.get_mtth());
+	}
+
+	/*
+	Compiling the module is the slow part of starting the jit, so the resulting object code is cached on disk. The key covers
+	everything the object code depends on: the generated definitions (which embed the scenario's triggers and modifiers),
+	the LLVM version, the host cpu the code is tuned for, and the build of the game itself, since the common fif environment
+	bakes in the data container layout.
+	*/
+	{
+		unsigned llvm_major = 0;
+		unsigned llvm_minor = 0;
+		unsigned llvm_patch = 0;
+		LLVMGetVersion(&llvm_major, &llvm_minor, &llvm_patch);
+		char* cpu_name = LLVMGetHostCPUName();
+		char* cpu_features = LLVMGetHostCPUFeatures();
+		std::string key_source = std::string(__DATE__ " " __TIME__ " llvm ") + std::to_string(llvm_major) + "." + std::to_string(llvm_minor) + "." + std::to_string(llvm_patch) + " " + cpu_name + " " + cpu_features + "\n" + jit_source;
+		LLVMDisposeMessage(cpu_name);
+		LLVMDisposeMessage(cpu_features);
+
+		checksum_key jit_key;
+		blake2b(&jit_key, sizeof(jit_key), key_source.data(), key_source.size(), nullptr, 0);
+
+		std::string file_name = "jit_";
+		for(uint32_t i = 0; i < 8; ++i) {
+			char const* digits = "0123456789abcdef";
+			file_name += digits[jit_key.key[i] >> 4];
+			file_name += digits[jit_key.key[i] & 0x0F];
+		}
+		file_name += ".bin";
+		auto native_file_name = simple_fs::utf8_to_native(file_name);
+
+		// the cache file holds the full key followed by the object code
+		auto cache_dir = simple_fs::get_or_create_jit_cache_directory();
+		std::string cached_object;
+		if(auto f = simple_fs::open_file(cache_dir, native_file_name); f) {
+			auto contents = simple_fs::view_contents(*f);
+			if(contents.file_size > sizeof(jit_key) && std::memcmp(contents.data, jit_key.key, sizeof(jit_key)) == 0) {
+				cached_object.assign(contents.data + sizeof(jit_key), contents.file_size - sizeof(jit_key));
+			}
+		}
+
+		if(!cached_object.empty()) {
+			fif::perform_jit(*jit_environment, cached_object);
+		} else {
+			std::string emitted_object;
+			fif::perform_jit(*jit_environment, std::string_view{}, &emitted_object);
+			if(!emitted_object.empty()) {
+				std::string file_data(reinterpret_cast<char const*>(jit_key.key), sizeof(jit_key));
+				file_data += emitted_object;
+				simple_fs::write_file(cache_dir, native_file_name, file_data.data(), uint32_t(file_data.size()));
+			}
+		}
+	}
+
+	/*
+	The game keeps running on the interpreter while this thread compiles. A compiled function only becomes visible to it once
+	its address is stored below, so the globals that the compiled code reads have to be set before any address is published.
+	*/
+	//
+	// set global values
+	//
+	bool globals_set = true;
+	{
+		LLVMOrcExecutorAddress bare_address = 0;
+		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_container");
+
+		if(error) {
+			auto msg = LLVMGetErrorMessage(error);
+#ifdef _WIN32
+			OutputDebugStringA(msg);
+			OutputDebugStringA("\n");
+#endif
+			LLVMDisposeErrorMessage(msg);
+			globals_set = false;
+		} else {
+			assert(bare_address != 0);
+			using ftype = void(*)(void*);
+			ftype fn = (ftype)bare_address;
+			fn(&world);
+		}
+	}
+	{
+		LLVMOrcExecutorAddress bare_address = 0;
+		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_vector_storage");
+
+		if(error) {
+			auto msg = LLVMGetErrorMessage(error);
+#ifdef _WIN32
+			OutputDebugStringA(msg);
+			OutputDebugStringA("\n");
+#endif
+			LLVMDisposeErrorMessage(msg);
+			globals_set = false;
+		} else {
+			assert(bare_address != 0);
+			using ftype = void(*)(void*);
+			ftype fn = (ftype)bare_address;
+			fn(dcon::shared_backing_storage.allocation);
+		}
 	}
+	{
+		LLVMOrcExecutorAddress bare_address = 0;
+		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_state");
 
-	fif::perform_jit(*jit_environment);
+		if(error) {
+			auto msg = LLVMGetErrorMessage(error);
+#ifdef _WIN32
+			OutputDebugStringA(msg);
+			OutputDebugStringA("\n");
+#endif
+			LLVMDisposeErrorMessage(msg);
+			globals_set = false;
+		} else {
+			assert(bare_address != 0);
+			using ftype = void(*)(void*);
+			ftype fn = (ftype)bare_address;
+			fn(this);
+		}
+	}
+	//
+	// END set global values
+	//
+	if(!globals_set)
+		return; // keep using the interpreter
 
 	//
 	// load exported fns
@@ -3396,6 +3709,24 @@ void state::on_scenario_load() {
 				assert(bare_address != 0);
 				world.pop_type_set_issues_fns(p, i, bare_address);
 			}
+			{
+				std::string block_name = "pi" + std::to_string(p.id.index()) + "_" + std::to_string(i.id.index()) + "blk";
+
+				LLVMOrcExecutorAddress block_address = 0;
+				auto block_error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &block_address, block_name.c_str());
+
+				if(block_error) {
+					auto msg = LLVMGetErrorMessage(block_error);
+#ifdef _WIN32
+					OutputDebugStringA(msg);
+					OutputDebugStringA("\n");
+#endif
+					LLVMDisposeErrorMessage(msg);
+				} else {
+					assert(block_address != 0);
+					world.pop_type_set_issues_block_fns(p, i, block_address);
+				}
+			}
 		}
 		for(auto id : world.in_ideology) {
 			std::string name = "pid" + std::to_string(p.id.index()) + "_" + std::to_string(id.id.index()) + "ext";
@@ -3414,6 +3745,24 @@ void state::on_scenario_load() {
 				assert(bare_address != 0);
 				world.pop_type_set_ideology_fns(p, id, bare_address);
 			}
+			{
+				std::string block_name = "pid" + std::to_string(p.id.index()) + "_" + std::to_string(id.id.index()) + "blk";
+
+				LLVMOrcExecutorAddress block_address = 0;
+				auto block_error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &block_address, block_name.c_str());
+
+				if(block_error) {
+					auto msg = LLVMGetErrorMessage(block_error);
+#ifdef _WIN32
+					OutputDebugStringA(msg);
+					OutputDebugStringA("\n");
+#endif
+					LLVMDisposeErrorMessage(msg);
+				} else {
+					assert(block_address != 0);
+					world.pop_type_set_ideology_block_fns(p, id, block_address);
+				}
+			}
 		}
 		for(auto t : world.in_pop_type) {
 			if(world.pop_type_get_promotion(p, t)) {
@@ -3511,48 +3860,10 @@ void state::on_scenario_load() {
 		}
 	}
 
-	//
-	// set global values
-	//
-	{
-		LLVMOrcExecutorAddress bare_address = 0;
-		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_container");
-
-		if(error) {
-			auto msg = LLVMGetErrorMessage(error);
-#ifdef _WIN32
-			OutputDebugStringA(msg);
-			OutputDebugStringA("\n");
-#endif
-			LLVMDisposeErrorMessage(msg);
-		} else {
-			assert(bare_address != 0);
-			using ftype = void(*)(void*);
-			ftype fn = (ftype)bare_address;
-			fn(&world);
-		}
-	}
-	{
-		LLVMOrcExecutorAddress bare_address = 0;
-		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_vector_storage");
-
-		if(error) {
-			auto msg = LLVMGetErrorMessage(error);
-#ifdef _WIN32
-			OutputDebugStringA(msg);
-			OutputDebugStringA("\n");
-#endif
-			LLVMDisposeErrorMessage(msg);
-		} else {
-			assert(bare_address != 0);
-			using ftype = void(*)(void*);
-			ftype fn = (ftype)bare_address;
-			fn(dcon::shared_backing_storage.allocation);
-		}
-	}
-	{
+	// the event functions are published in the same way
+	auto lookup_event_fn = [&](std::string const& name) {
 		LLVMOrcExecutorAddress bare_address = 0;
-		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, "set_state");
+		auto error = LLVMOrcLLJITLookup(jit_environment->llvm_jit, &bare_address, name.c_str());
 
 		if(error) {
 			auto msg = LLVMGetErrorMessage(error);
@@ -3561,16 +3872,25 @@ void state::on_scenario_load() {
 			OutputDebugStringA("\n");
 #endif
 			LLVMDisposeErrorMessage(msg);
-		} else {
-			assert(bare_address != 0);
-			using ftype = void(*)(void*);
-			ftype fn = (ftype)bare_address;
-			fn(this);
+			return uint64_t(0);
 		}
+		assert(bare_address != 0);
+		return uint64_t(bare_address);
+	};
+	for(auto e : world.in_free_national_event) {
+		std::string base_name = "fne" + std::to_string(e.id.index());
+		if(e.get_trigger())
+			e.set_trigger_fn(lookup_event_fn(base_name + "text"));
+		if(e.get_mtth())
+			e.set_mtth_fn(lookup_event_fn(base_name + "mext"));
+	}
+	for(auto e : world.in_free_provincial_event) {
+		std::string base_name = "fpe" + std::to_string(e.id.index());
+		if(e.get_trigger())
+			e.set_trigger_fn(lookup_event_fn(base_name + "text"));
+		if(e.get_mtth())
+			e.set_mtth_fn(lookup_event_fn(base_name + "mext"));
 	}
-	//
-	// END set global values
-	//
 	} };
 
 	dispatch.detach();
@@ -3603,6 +3923,11 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	world.province_resize_demographics_alt(demographics::size(*this));
 
 	province::restore_distances(*this);
+	province::update_movement_regions(*this);
+	province::update_landmark_distances(*this);
+	military::rebuild_arrival_calendar(*this);
+	military::update_war_status_matrix(*this);
+	event::update_next_future_event(*this);
 
 	world.for_each_nation([&](dcon::nation_id id) { politics::update_displayed_identity(*this, id); });
 
@@ -3772,12 +4097,12 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	military::run_gc(*this);
 	for(auto a : world.in_army) {
 		if(a.get_arrival_time() && a.get_arrival_time() <= current_date) {
-			a.set_arrival_time(current_date + 1);
+			military::set_arrival_time(*this, a, current_date + 1);
 		}
 	}
 	for(auto a : world.in_navy) {
 		if(a.get_arrival_time() && a.get_arrival_time() <= current_date) {
-			a.set_arrival_time(current_date + 1);
+			military::set_arrival_time(*this, a, current_date + 1);
 		}
 	}
 	for(auto shp : world.in_ship) {
@@ -3803,10 +4128,147 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	game_state_updated.store(true, std::memory_order::release);
 }
 
-void state::single_game_tick() {
-	// do update logic
+void build_daily_tick_graph(tick_task_graph& graph) {
+	using namespace tick_data;
 
-	current_date += 1;
+	// values updates pass 1 (mostly trivial things, none of these conflict with each other)
+	graph.add("refresh_home_ports", units, home_ports, [](sys::state& state) {
+		ai::refresh_home_ports(state);
+	});
+	graph.add("update_research_points", pops | pop_demographics | modifiers, research_points, [](sys::state& state) {
+		// Instant research cheat
+		for(auto n : state.cheat_data.instant_research_nations) {
+			auto tech = state.world.nation_get_current_research(n);
+			if(tech.is_valid()) {
+				float points = culture::effective_technology_cost(state, state.current_date.to_ymd(state.start_date).year, n, tech);
+				state.world.nation_set_research_points(n, points);
+			}
+		}
+		nations::update_research_points(state);
+	});
+	graph.add("regenerate_land_unit_average", modifiers, land_unit_average, [](sys::state& state) {
+		military::regenerate_land_unit_average(state);
+	});
+	graph.add("regenerate_ship_scores", units | modifiers, ship_scores, [](sys::state& state) {
+		military::regenerate_ship_scores(state);
+	});
+	graph.add("update_industrial_scores", economy | pop_demographics, industrial_scores, [](sys::state& state) {
+		nations::update_industrial_scores(state);
+	});
+	graph.add("update_naval_supply_points", units | province_control | modifiers, naval_supply, [](sys::state& state) {
+		military::update_naval_supply_points(state);
+	});
+	graph.add("update_all_recruitable_regiments", pops | pop_demographics, recruitable_regiments, [](sys::state& state) {
+		military::update_all_recruitable_regiments(state);
+	});
+	graph.add("regenerate_total_regiment_counts", units, regiment_counts, [](sys::state& state) {
+		military::regenerate_total_regiment_counts(state);
+	});
+	graph.add("update_rgo_employment", pops | pop_demographics | modifiers, rgo_employment, [](sys::state& state) {
+		economy::update_rgo_employment(state);
+	});
+	graph.add("update_factory_employment", pops | pop_demographics | modifiers, factory_employment, [](sys::state& state) {
+		economy::update_factory_employment(state);
+	});
+	graph.add("update_administrative_efficiency", pops | pop_demographics | modifiers, administrative_efficiency | rebels, [](sys::state& state) {
+		nations::update_administrative_efficiency(state);
+		rebel::daily_update_rebel_organization(state);
+	});
+	graph.add("daily_leaders_update", battles, leaders | messages, [](sys::state& state) {
+		military::daily_leaders_update(state);
+	});
+	graph.add("daily_party_loyalty_update", pops | pop_demographics, party_loyalty, [](sys::state& state) {
+		politics::daily_party_loyalty_update(state);
+	});
+	graph.add("daily_update_flashpoint_tension", pops | province_control | crisis, flashpoints, [](sys::state& state) {
+		nations::daily_update_flashpoint_tension(state);
+	});
+	graph.add("update_ticking_war_score", province_control | wars, war_score, [](sys::state& state) {
+		military::update_ticking_war_score(state);
+	});
+	graph.add("increase_dig_in", units, dig_in, [](sys::state& state) {
+		military::increase_dig_in(state);
+	});
+	graph.add("update_blockade_status", units | province_control, blockades, [](sys::state& state) {
+		military::update_blockade_status(state);
+	});
+
+	graph.add("economy_daily_update",
+		pops | pop_demographics | pop_budgets | province_control | economy | rgo_employment | factory_employment | treasury | units
+			| administrative_efficiency | blockades | modifiers | wars | influence,
+		economy | pop_budgets | treasury | units | messages, [](sys::state& state) {
+		economy::daily_update(state, true);
+	});
+
+	graph.add("recover_org", units | leaders | battles | modifiers, units, [](sys::state& state) {
+		military::recover_org(state);
+	});
+	graph.add("update_siege_progress", units | leaders | modifiers, province_control | units | wars | messages, [](sys::state& state) {
+		military::update_siege_progress(state);
+	});
+	graph.add("update_movement", province_control | wars | modifiers, units | battles | province_control | messages, [](sys::state& state) {
+		military::update_movement(state);
+	});
+	graph.add("update_naval_battles", province_control | wars | modifiers, units | battles | leaders | war_score | wars | messages, [](sys::state& state) {
+		military::update_naval_battles(state);
+	});
+	graph.add("update_land_battles", province_control | wars | modifiers, units | battles | leaders | war_score | wars | messages, [](sys::state& state) {
+		military::update_land_battles(state);
+	});
+	graph.add("advance_mobilizations", pops | modifiers, units | pops | messages, [](sys::state& state) {
+		military::advance_mobilizations(state);
+	});
+	graph.add("update_colonization", treasury | modifiers, colonization | province_control | messages, [](sys::state& state) {
+		province::update_colonization(state);
+	});
+	graph.add("update_cbs", province_control | modifiers, wars | messages, [](sys::state& state) {
+		military::update_cbs(state); // may add/remove cbs to a nation
+	});
+	graph.add("update_events", everything, everything, [](sys::state& state) {
+		event::update_events(state);
+	});
+	graph.add("update_research", research_points | treasury, research | modifiers | messages, [](sys::state& state) {
+		culture::update_research(state, uint32_t(state.current_date.to_ymd(state.start_date).year));
+	});
+	graph.add("update_military_scores", land_unit_average | ship_scores | regiment_counts | units | leaders | modifiers, military_scores, [](sys::state& state) {
+		nations::update_military_scores(state); // depends on ship score, land unit average
+	});
+	graph.add("update_rankings", industrial_scores | military_scores | modifiers, rankings, [](sys::state& state) {
+		nations::update_rankings(state); // depends on industrial score, military scores
+	});
+	graph.add("update_great_powers", rankings, great_powers | influence | wars | messages, [](sys::state& state) {
+		nations::update_great_powers(state); // depends on rankings
+	});
+	graph.add("update_influence", rankings | great_powers | units | modifiers, influence, [](sys::state& state) {
+		nations::update_influence(state); // depends on rankings, great powers
+	});
+	graph.add("update_crisis", everything, everything, [](sys::state& state) {
+		nations::update_crisis(state);
+	});
+	graph.add("update_elections", pops | pop_demographics | party_loyalty, elections | modifiers | events | messages, [](sys::state& state) {
+		politics::update_elections(state);
+	});
+
+	graph.add("update_ai_colonial_investment", colonization | treasury | province_control | units, colonization | ai, [](sys::state& state) {
+		if(state.current_date.value % 4 == 0) {
+			ai::update_ai_colonial_investment(state);
+		}
+	});
+	graph.add("ai_daily_military", everything, units | ai | wars | messages, [](sys::state& state) {
+		if(state.defines.alice_eval_ai_mil_everyday != 0.0f) {
+			ai::make_defense(state);
+			ai::make_attacks(state);
+			ai::update_ships(state);
+		}
+	});
+
+	graph.compile();
+}
+
+void state::single_game_tick() {
+	// do update logic
+
+	current_date += 1;
 
 	if(!is_playable_date(current_date, start_date, end_date)) {
 		game_scene::switch_scene(*this, game_scene::scene_id::end_screen);
@@ -3816,529 +4278,392 @@ void state::single_game_tick() {
 
 	auto ymd_date = current_date.to_ymd(start_date);
 
+	static int32_t const demographics_update_phase = tick_timings.register_phase("demographics_update");
+	static int32_t const demographics_apply_phase = tick_timings.register_phase("demographics_apply");
+	static int32_t const demographics_apply_sequential_phase = tick_timings.register_phase("demographics_apply_sequential");
+	static int32_t const regenerate_demographics_phase = tick_timings.register_phase("regenerate_from_pop_data_daily");
+	static int32_t const alt_regenerate_demographics_phase = tick_timings.register_phase("alt_regenerate_from_pop_data_daily");
+	static int32_t const ai_planning_phase = tick_timings.register_phase("ai_planning");
+	static int32_t const regiment_damage_phase = tick_timings.register_phase("apply_regiment_damage");
+	static int32_t const pulses_phase = tick_timings.register_phase("monthly_and_yearly_pulses");
+	static int32_t const general_ai_unit_tick_phase = tick_timings.register_phase("general_ai_unit_tick");
+	static int32_t const cleanup_phase = tick_timings.register_phase("gc_and_cached_values");
+	static int32_t const autosave_phase = tick_timings.register_phase("autosave");
+	static char const* monthly_phase_names[31] = {
+		"monthly_day_1", "monthly_day_2", "monthly_day_3", "monthly_day_4", "monthly_day_5", "monthly_day_6", "monthly_day_7",
+		"monthly_day_8", "monthly_day_9", "monthly_day_10", "monthly_day_11", "monthly_day_12", "monthly_day_13", "monthly_day_14",
+		"monthly_day_15", "monthly_day_16", "monthly_day_17", "monthly_day_18", "monthly_day_19", "monthly_day_20", "monthly_day_21",
+		"monthly_day_22", "monthly_day_23", "monthly_day_24", "monthly_day_25", "monthly_day_26", "monthly_day_27", "monthly_day_28",
+		"monthly_day_29", "monthly_day_30", "monthly_day_31"
+	};
+	static std::array<int32_t, 31> const monthly_phases = [&]() {
+		std::array<int32_t, 31> result;
+		for(int32_t i = 0; i < 31; ++i)
+			result[i] = tick_timings.register_phase(monthly_phase_names[i]);
+		return result;
+	}();
+
+	tick_timings.begin_day(current_date);
+	if(ymd_date.day == 1)
+		ai_timings.end_month();
+
 	diplomatic_message::update_pending(*this);
 
 	auto month_start = sys::year_month_day{ ymd_date.year, ymd_date.month, uint16_t(1) };
 	auto next_month_start = ymd_date.month != 12 ? sys::year_month_day{ ymd_date.year, uint16_t(ymd_date.month + 1), uint16_t(1) } : sys::year_month_day{ ymd_date.year + 1, uint16_t(1), uint16_t(1) };
 	auto const days_in_month = uint32_t(sys::days_difference(month_start, next_month_start));
 
-	// pop update:
-	static demographics::ideology_buffer idbuf(*this);
-	static demographics::issues_buffer isbuf(*this);
-	static demographics::promotion_buffer pbuf;
-	static demographics::assimilation_buffer abuf;
-	static demographics::conversion_buffer rbuf;
-	static demographics::migration_buffer mbuf;
-	static demographics::migration_buffer cmbuf;
-	static demographics::migration_buffer imbuf;
-
-	// calculate complex changes in parallel where we can, but don't actually apply the results
-	// instead, the changes are saved to be applied only after all triggers have been evaluated
-	concurrency::parallel_for(0, 8, [&](int32_t index) {
-		switch(index) {
-		case 0:
-		{
-			auto o = uint32_t(ymd_date.day);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_ideologies(*this, o, days_in_month, idbuf);
-			break;
-		}
-		case 1:
-		{
-			auto o = uint32_t(ymd_date.day + 1);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_issues(*this, o, days_in_month, isbuf);
-			break;
-		}
-		case 2:
-		{
-			auto o = uint32_t(ymd_date.day + 6);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_type_changes(*this, o, days_in_month, pbuf);
-			break;
-		}
-		case 3:
-		{
-			auto o = uint32_t(ymd_date.day + 7);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_assimilation(*this, o, days_in_month, abuf);
-			break;
-		}
-		case 4:
-		{
-			auto o = uint32_t(ymd_date.day + 8);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_internal_migration(*this, o, days_in_month, mbuf);
-			break;
-		}
-		case 5:
-		{
-			auto o = uint32_t(ymd_date.day + 9);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_colonial_migration(*this, o, days_in_month, cmbuf);
-			break;
-		}
-		case 6:
-		{
-			auto o = uint32_t(ymd_date.day + 10);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_immigration(*this, o, days_in_month, imbuf);
-			break;
-		}
-		case 7:
-		{
-			auto o = uint32_t(ymd_date.day + 11);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_conversion(*this, o, days_in_month, rbuf);
-			break;
-		}
-		default:
-			break;
-		}
-	});
+	// Each staggered pop update touches 1/stagger_divisions of the pops per day, and the updates are kept out of step with
+	// each other by phase_spacing slices. By default there is one division per day of the month; alice_pop_update_divisions
+	// (at least 11) instead gives a fixed number of divisions that cycles independently of the calendar, trading fewer, larger
+	// daily batches against more, smaller ones.
+	auto const custom_divisions = defines.alice_pop_update_divisions > 10.0f;
+	auto const stagger_divisions = custom_divisions ? uint32_t(defines.alice_pop_update_divisions) : days_in_month;
+	auto const stagger_day = custom_divisions ? uint32_t(current_date.value) % stagger_divisions : uint32_t(ymd_date.day);
+	auto const phase_spacing = uint32_t(std::max(defines.alice_pop_update_phase_spacing, 1.0f));
+	auto stagger_offset = [&](uint32_t phase) {
+		return (stagger_day + phase * phase_spacing) % stagger_divisions;
+	};
 
-	// apply in parallel where we can
-	concurrency::parallel_for(0, 8, [&](int32_t index) {
-		switch(index) {
-		case 0:
-		{
-			auto o = uint32_t(ymd_date.day + 0);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::apply_ideologies(*this, o, days_in_month, idbuf);
-			break;
-		}
-		case 1:
-		{
-			auto o = uint32_t(ymd_date.day + 1);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::apply_issues(*this, o, days_in_month, isbuf);
-			break;
-		}
-		case 2:
-		{
-			auto o = uint32_t(ymd_date.day + 2);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_militancy(*this, o, days_in_month);
-			break;
-		}
-		case 3:
-		{
-			auto o = uint32_t(ymd_date.day + 3);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_consciousness(*this, o, days_in_month);
-			break;
-		}
-		case 4:
-		{
-			auto o = uint32_t(ymd_date.day + 4);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_literacy(*this, o, days_in_month);
-			break;
-		}
-		case 5:
-		{
-			auto o = uint32_t(ymd_date.day + 5);
-			if(o >= days_in_month)
-				o -= days_in_month;
-			demographics::update_growth(*this, o, days_in_month);
-			break;
-		}
-		case 6:
-			province::ve_for_each_land_province(*this,
-					[&](auto ids) { world.province_set_daily_net_migration(ids, ve::fp_vector{}); });
-			break;
-		case 7:
-			province::ve_for_each_land_province(*this,
-					[&](auto ids) { world.province_set_daily_net_immigration(ids, ve::fp_vector{}); });
-			break;
-		default:
-			break;
-		}
-	});
+	// pop update:
+	if(!demographics_buffers)
+		demographics_buffers.reset(new demographics::tick_buffers(*this));
+	auto& idbuf = demographics_buffers->idbuf;
+	auto& isbuf = demographics_buffers->isbuf;
+	auto& pbuf = demographics_buffers->pbuf;
+	auto& abuf = demographics_buffers->abuf;
+	auto& rbuf = demographics_buffers->rbuf;
+	auto& mbuf = demographics_buffers->mbuf;
+	auto& cmbuf = demographics_buffers->cmbuf;
+	auto& imbuf = demographics_buffers->imbuf;
 
-	// because they may add pops, these changes must be applied sequentially
-	{
-		auto o = uint32_t(ymd_date.day + 6);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_type_changes(*this, o, days_in_month, pbuf);
-	}
-	{
-		auto o = uint32_t(ymd_date.day + 7);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_assimilation(*this, o, days_in_month, abuf);
-	}
 	{
-		auto o = uint32_t(ymd_date.day + 8);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_internal_migration(*this, o, days_in_month, mbuf);
-	}
-	{
-		auto o = uint32_t(ymd_date.day + 9);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_colonial_migration(*this, o, days_in_month, cmbuf);
+		scoped_tick_timer timer{ tick_timings, demographics_update_phase };
+		// calculate complex changes in parallel where we can, but don't actually apply the results
+		// instead, the changes are saved to be applied only after all triggers have been evaluated
+		concurrency::parallel_for(0, 7, [&](int32_t index) {
+			switch(index) {
+			case 0:
+				demographics::update_ideologies_and_issues(*this, stagger_offset(0), stagger_divisions, idbuf, isbuf);
+				break;
+			case 1:
+				demographics::update_type_changes(*this, stagger_offset(6), stagger_divisions, pbuf);
+				break;
+			case 2:
+				demographics::update_assimilation(*this, stagger_offset(7), stagger_divisions, abuf);
+				break;
+			case 3:
+				demographics::update_internal_migration(*this, stagger_offset(8), stagger_divisions, mbuf);
+				break;
+			case 4:
+				demographics::update_colonial_migration(*this, stagger_offset(9), stagger_divisions, cmbuf);
+				break;
+			case 5:
+				demographics::update_immigration(*this, stagger_offset(10), stagger_divisions, imbuf);
+				break;
+			case 6:
+				demographics::update_conversion(*this, stagger_offset(11), stagger_divisions, rbuf);
+				break;
+			default:
+				break;
+			}
+		});
 	}
+
 	{
-		auto o = uint32_t(ymd_date.day + 10);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_immigration(*this, o, days_in_month, imbuf);
+		scoped_tick_timer timer{ tick_timings, demographics_apply_phase };
+		// apply in parallel where we can
+		concurrency::parallel_for(0, 8, [&](int32_t index) {
+			switch(index) {
+			case 0:
+				demographics::apply_ideologies(*this, stagger_offset(0), stagger_divisions, idbuf);
+				break;
+			case 1:
+				demographics::apply_issues(*this, stagger_offset(0), stagger_divisions, isbuf); // updated together with the ideologies
+				break;
+			case 2:
+				demographics::update_militancy(*this, stagger_offset(2), stagger_divisions);
+				break;
+			case 3:
+				demographics::update_consciousness(*this, stagger_offset(3), stagger_divisions);
+				break;
+			case 4:
+				demographics::update_literacy(*this, stagger_offset(4), stagger_divisions);
+				break;
+			case 5:
+				demographics::update_growth(*this, stagger_offset(5), stagger_divisions);
+				break;
+			case 6:
+				province::ve_for_each_land_province(*this,
+						[&](auto ids) { world.province_set_daily_net_migration(ids, ve::fp_vector{}); });
+				break;
+			case 7:
+				province::ve_for_each_land_province(*this,
+						[&](auto ids) { world.province_set_daily_net_immigration(ids, ve::fp_vector{}); });
+				break;
+			default:
+				break;
+			}
+		});
 	}
+
 	{
-		auto o = uint32_t(ymd_date.day + 11);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_conversion(*this, o, days_in_month, rbuf);
-	}
+		scoped_tick_timer timer{ tick_timings, demographics_apply_sequential_phase };
+		// because they may add pops, these changes must be applied sequentially
+		demographics::apply_type_changes(*this, stagger_offset(6), stagger_divisions, pbuf);
+		demographics::apply_assimilation(*this, stagger_offset(7), stagger_divisions, abuf);
+		demographics::apply_internal_migration(*this, stagger_offset(8), stagger_divisions, mbuf);
+		demographics::apply_colonial_migration(*this, stagger_offset(9), stagger_divisions, cmbuf);
+		demographics::apply_immigration(*this, stagger_offset(10), stagger_divisions, imbuf);
+		demographics::apply_conversion(*this, stagger_offset(11), stagger_divisions, rbuf);
 
-	demographics::remove_size_zero_pops(*this);
+		demographics::remove_size_zero_pops(*this);
+	}
 
 	// basic repopulation of demographics derived values
 
 	int64_t pc_difference = 0;
 
-	if(network_mode != network_mode_type::single_player)
+	if(network_mode != network_mode_type::single_player) {
+		scoped_tick_timer timer{ tick_timings, regenerate_demographics_phase };
 		demographics::regenerate_from_pop_data_daily(*this);
+	}
 
 	//
 	// ALTERNATE PAR DEMO START POINT A
 	//
 
 		
+	if(daily_tick_graph.empty())
+		build_daily_tick_graph(daily_tick_graph);
+	daily_tick_graph.register_profiler_phases(tick_timings);
+
 	concurrency::parallel_invoke([&]() {
-		// values updates pass 1 (mostly trivial things, can be done in parallel)
-		concurrency::parallel_for(0, 17, [&](int32_t index) {
-			switch(index) {
-			case 0:
-				ai::refresh_home_ports(*this);
-				break;
+		// the daily updates are dispatched through the tick graph, which groups together
+		// the tasks that do not conflict with anything registered before them
+		daily_tick_graph.run(*this);
+
+		{
+			scoped_tick_timer timer{ tick_timings, monthly_phases[ymd_date.day - 1] };
+			// Once per month updates, spread out over the month
+			switch(ymd_date.day) {
 			case 1:
-				// Instant research cheat
-				for(auto n : this->cheat_data.instant_research_nations) {
-					auto tech = this->world.nation_get_current_research(n);
-					if(tech.is_valid()) {
-						float points = culture::effective_technology_cost(*this, this->current_date.to_ymd(this->start_date).year, n, tech);
-						this->world.nation_set_research_points(n, points);
-					}
-				}
-				nations::update_research_points(*this);
+				nations::update_monthly_points(*this);
+				economy::prune_factories(*this);
 				break;
 			case 2:
-				military::regenerate_land_unit_average(*this);
+				province::update_blockaded_cache(*this);
+				sys::update_modifier_effects(*this);
 				break;
 			case 3:
-				military::regenerate_ship_scores(*this);
+				military::monthly_leaders_update(*this);
+				ai::add_gw_goals(*this);
 				break;
 			case 4:
-				nations::update_industrial_scores(*this);
+				military::reinforce_regiments(*this);
+				if(!bool(defines.alice_eval_ai_mil_everyday)) {
+					ai::make_defense(*this);
+				}
 				break;
 			case 5:
-				military::update_naval_supply_points(*this);
+				rebel::update_movements(*this);
+				rebel::update_factions(*this);
 				break;
 			case 6:
-				military::update_all_recruitable_regiments(*this);
+				ai::form_alliances(*this);
+				if(!bool(defines.alice_eval_ai_mil_everyday)) {
+					ai::make_attacks(*this);
+				}
 				break;
 			case 7:
-				military::regenerate_total_regiment_counts(*this);
+				ai::update_ai_general_status(*this);
 				break;
 			case 8:
-				economy::update_rgo_employment(*this);
+				military::apply_attrition(*this);
 				break;
 			case 9:
-				economy::update_factory_employment(*this);
+				military::repair_ships(*this);
 				break;
 			case 10:
-				nations::update_administrative_efficiency(*this);
-				rebel::daily_update_rebel_organization(*this);
+				province::update_crimes(*this);
 				break;
 			case 11:
-				military::daily_leaders_update(*this);
+				province::update_nationalism(*this);
 				break;
 			case 12:
-				politics::daily_party_loyalty_update(*this);
+				rebel::update_armies(*this);
+				rebel::rebel_hunting_check(*this);
 				break;
 			case 13:
-				nations::daily_update_flashpoint_tension(*this);
+				ai::perform_influence_actions(*this);
 				break;
 			case 14:
-				military::update_ticking_war_score(*this);
+				ai::update_focuses(*this);
 				break;
 			case 15:
-				military::increase_dig_in(*this);
+				culture::discover_inventions(*this);
 				break;
 			case 16:
-				military::update_blockade_status(*this);
+				ai::take_ai_decisions(*this);
+				break;
+			case 20:
+				nations::monthly_flashpoint_update(*this);
+				if(!bool(defines.alice_eval_ai_mil_everyday)) {
+					ai::make_defense(*this);
+				}
+				break;
+			case 21:
+				ai::update_ai_colony_starting(*this);
+				break;
+			case 22:
+				ai::take_reforms(*this);
+				break;
+			case 23:
+				ai::civilize(*this);
+				break;
+			case 24:
+				rebel::execute_rebel_victories(*this);
+				if(!bool(defines.alice_eval_ai_mil_everyday)) {
+					ai::make_attacks(*this);
+				}
+				rebel::update_armies(*this);
+				rebel::rebel_hunting_check(*this);
+				break;
+			case 25:
+				rebel::execute_province_defections(*this);
+				break;
+			case 26:
+				ai::make_peace_offers(*this);
+				break;
+			case 27:
+				ai::update_crisis_leaders(*this);
+				break;
+			case 28:
+				rebel::rebel_risings_check(*this);
+				break;
+			case 29:
+				ai::update_war_intervention(*this);
+				break;
+			case 30:
+				if(!bool(defines.alice_eval_ai_mil_everyday)) {
+					ai::update_ships(*this);
+				}
+				rebel::update_armies(*this);
+				rebel::rebel_hunting_check(*this);
+				break;
+			case 31:
+				ai::update_cb_fabrication(*this);
+				ai::update_ai_ruling_party(*this);
+				break;
+			default:
 				break;
 			}
-		});
-
-		economy::daily_update(*this, true);
-
-	
-		//
-		// ALTERNATE PAR DEMO START POINT B
-		//
-
-		military::recover_org(*this);
-		military::update_siege_progress(*this);
-		military::update_movement(*this);
-		military::update_naval_battles(*this);
-		military::update_land_battles(*this);
-
-		military::advance_mobilizations(*this);
-
-		province::update_colonization(*this);
-		military::update_cbs(*this); // may add/remove cbs to a nation
-
-		event::update_events(*this);
-
-		culture::update_research(*this, uint32_t(ymd_date.year));
-
-		nations::update_military_scores(*this); // depends on ship score, land unit average
-		nations::update_rankings(*this);				// depends on industrial score, military scores
-		nations::update_great_powers(*this);		// depends on rankings
-		nations::update_influence(*this);				// depends on rankings, great powers
-
-		nations::update_crisis(*this);
-		politics::update_elections(*this);
-
-		
-		if(current_date.value % 4 == 0) {
-			ai::update_ai_colonial_investment(*this);
 		}
 
-		if(defines.alice_eval_ai_mil_everyday != 0.0f) {
-			ai::make_defense(*this);
-			ai::make_attacks(*this);
-			ai::update_ships(*this);
+		{
+			scoped_tick_timer timer{ tick_timings, ai_planning_phase };
+			ai::update_ai_planning(*this);
 		}
 
-		// Once per month updates, spread out over the month
-		switch(ymd_date.day) {
-		case 1:
-			nations::update_monthly_points(*this);
-			economy::prune_factories(*this);
-			break;
-		case 2:
-			province::update_blockaded_cache(*this);
-			sys::update_modifier_effects(*this);
-			break;
-		case 3:
-			military::monthly_leaders_update(*this);
-			ai::add_gw_goals(*this);
-			break;
-		case 4:
-			military::reinforce_regiments(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_defense(*this);
-			}
-			break;
-		case 5:
-			rebel::update_movements(*this);
-			rebel::update_factions(*this);
-			break;
-		case 6:
-			ai::form_alliances(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_attacks(*this);
-			}
-			break;
-		case 7:
-			ai::update_ai_general_status(*this);
-			break;
-		case 8:
-			military::apply_attrition(*this);
-			break;
-		case 9:
-			military::repair_ships(*this);
-			break;
-		case 10:
-			province::update_crimes(*this);
-			break;
-		case 11:
-			province::update_nationalism(*this);
-			break;
-		case 12:
-			ai::update_ai_research(*this);
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 13:
-			ai::perform_influence_actions(*this);
-			break;
-		case 14:
-			ai::update_focuses(*this);
-			break;
-		case 15:
-			culture::discover_inventions(*this);
-			break;
-		case 16:
-			ai::take_ai_decisions(*this);
-			break;
-		case 17:
-			ai::build_ships(*this);
-			ai::update_land_constructions(*this);
-			break;
-		case 18:
-			ai::update_ai_econ_construction(*this);
-			break;
-		case 19:
-			ai::update_budget(*this);
-			break;
-		case 20:
-			nations::monthly_flashpoint_update(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_defense(*this);
-			}
-			break;
-		case 21:
-			ai::update_ai_colony_starting(*this);
-			break;
-		case 22:
-			ai::take_reforms(*this);
-			break;
-		case 23:
-			ai::civilize(*this);
-			ai::make_war_decs(*this);
-			break;
-		case 24:
-			rebel::execute_rebel_victories(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_attacks(*this);
-			}
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 25:
-			rebel::execute_province_defections(*this);
-			break;
-		case 26:
-			ai::make_peace_offers(*this);
-			break;
-		case 27:
-			ai::update_crisis_leaders(*this);
-			break;
-		case 28:
-			rebel::rebel_risings_check(*this);
-			break;
-		case 29:
-			ai::update_war_intervention(*this);
-			break;
-		case 30:
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::update_ships(*this);
-			}
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 31:
-			ai::update_cb_fabrication(*this);
-			ai::update_ai_ruling_party(*this);
-			break;
-		default:
-			break;
+		{
+			scoped_tick_timer timer{ tick_timings, regiment_damage_phase };
+			military::apply_regiment_damage(*this);
 		}
 
-		military::apply_regiment_damage(*this);
+		{
+			scoped_tick_timer timer{ tick_timings, pulses_phase };
+			if(ymd_date.day == 1) {
+				if(ymd_date.month == 1) {
+					// yearly update : redo the upper house
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() != 0)
+							politics::recalculate_upper_house(*this, n);
+					}
 
-		if(ymd_date.day == 1) {
-			if(ymd_date.month == 1) {
-				// yearly update : redo the upper house
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() != 0)
-						politics::recalculate_upper_house(*this, n);
+					ai::update_influence_priorities(*this);
 				}
-
-				ai::update_influence_priorities(*this);
-			}
-			if(ymd_date.month == 2) {
-				ai::upgrade_colonies(*this);
-			}
-			if(ymd_date.month == 3 && !national_definitions.on_quarterly_pulse.empty()) {
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() > 0) {
-						event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+				if(ymd_date.month == 2) {
+					ai::upgrade_colonies(*this);
+				}
+				if(ymd_date.month == 3 && !national_definitions.on_quarterly_pulse.empty()) {
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() > 0) {
+							event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+						}
 					}
 				}
-			}
-			if(ymd_date.month == 4 && ymd_date.year % 2 == 0) { // the purge
-				demographics::remove_small_pops(*this);
-			}
-			if(ymd_date.month == 5) {
-				ai::prune_alliances(*this);
-			}
-			if(ymd_date.month == 6 && !national_definitions.on_quarterly_pulse.empty()) {
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() > 0) {
-						event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+				if(ymd_date.month == 4 && ymd_date.year % 2 == 0) { // the purge
+					demographics::remove_small_pops(*this);
+				}
+				if(ymd_date.month == 5) {
+					ai::prune_alliances(*this);
+				}
+				if(ymd_date.month == 6 && !national_definitions.on_quarterly_pulse.empty()) {
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() > 0) {
+							event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+						}
 					}
 				}
-			}
-			if(ymd_date.month == 7) {
-				ai::update_influence_priorities(*this);
-			}
-			if(ymd_date.month == 9 && !national_definitions.on_quarterly_pulse.empty()) {
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() > 0) {
-						event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+				if(ymd_date.month == 7) {
+					ai::update_influence_priorities(*this);
+				}
+				if(ymd_date.month == 9 && !national_definitions.on_quarterly_pulse.empty()) {
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() > 0) {
+							event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+						}
 					}
 				}
-			}
-			if(ymd_date.month == 10 && !national_definitions.on_yearly_pulse.empty()) {
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() > 0) {
-						event::fire_fixed_event(*this, national_definitions.on_yearly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+				if(ymd_date.month == 10 && !national_definitions.on_yearly_pulse.empty()) {
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() > 0) {
+							event::fire_fixed_event(*this, national_definitions.on_yearly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+						}
 					}
 				}
-			}
-			if(ymd_date.month == 11) {
-				ai::prune_alliances(*this);
-			}
-			if(ymd_date.month == 12 && !national_definitions.on_quarterly_pulse.empty()) {
-				for(auto n : world.in_nation) {
-					if(n.get_owned_province_count() > 0) {
-						event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+				if(ymd_date.month == 11) {
+					ai::prune_alliances(*this);
+				}
+				if(ymd_date.month == 12 && !national_definitions.on_quarterly_pulse.empty()) {
+					for(auto n : world.in_nation) {
+						if(n.get_owned_province_count() > 0) {
+							event::fire_fixed_event(*this, national_definitions.on_quarterly_pulse, trigger::to_generic(n.id), event::slot_type::nation, n.id, -1, event::slot_type::none);
+						}
 					}
 				}
 			}
 		}
 
-		ai::general_ai_unit_tick(*this);
+		{
+			scoped_tick_timer timer{ tick_timings, general_ai_unit_tick_phase };
+			ai::general_ai_unit_tick(*this);
+		}
 
-		military::run_gc(*this);
-		nations::run_gc(*this);
-		military::update_blackflag_status(*this);
-		ai::daily_cleanup(*this);
+		{
+			scoped_tick_timer timer{ tick_timings, cleanup_phase };
+			military::run_gc(*this);
+			nations::run_gc(*this);
+			military::update_blackflag_status(*this);
+			ai::daily_cleanup(*this);
 
-		province::update_connected_regions(*this);
-		province::update_cached_values(*this);
-		nations::update_cached_values(*this);
+			province::update_connected_regions(*this);
+			province::update_cached_values(*this);
+			nations::update_cached_values(*this);
+		}
 
 		
 	},
 	[&]() {
-		if(network_mode == network_mode_type::single_player)
+		if(network_mode == network_mode_type::single_player) {
+			scoped_tick_timer timer{ tick_timings, alt_regenerate_demographics_phase };
 			demographics::alt_regenerate_from_pop_data_daily(*this);
+		}
 	}
 	);
 
 	if(network_mode == network_mode_type::single_player) {
+		scoped_tick_timer timer{ tick_timings, alt_regenerate_demographics_phase };
 		world.nation_swap_demographics_demographics_alt();
 		world.state_instance_swap_demographics_demographics_alt();
 		world.province_swap_demographics_demographics_alt();
@@ -4366,41 +4691,40 @@ void state::single_game_tick() {
 		}
 	}
 
+	if(ymd_date.month == 1 && ymd_date.day == 1) {
+		economy::update_yearly_records(*this);
+	}
+
 	ui_date = current_date;
 
 	game_state_updated.store(true, std::memory_order::release);
 
-	switch(user_settings.autosaves) {
-	case autosave_frequency::none:
-		break;
-	case autosave_frequency::daily:
-		write_save_file(*this, sys::save_type::autosave);
-		break;
-	case autosave_frequency::monthly:
-		if(ymd_date.day == 1)
-			write_save_file(*this, sys::save_type::autosave);
-		break;
-	case autosave_frequency::yearly:
-		if(ymd_date.month == 1 && ymd_date.day == 1)
+	{
+		scoped_tick_timer timer{ tick_timings, autosave_phase };
+		switch(user_settings.autosaves) {
+		case autosave_frequency::none:
+			break;
+		case autosave_frequency::daily:
 			write_save_file(*this, sys::save_type::autosave);
-		break;
-	default:
-		break;
+			break;
+		case autosave_frequency::monthly:
+			if(ymd_date.day == 1)
+				write_save_file(*this, sys::save_type::autosave);
+			break;
+		case autosave_frequency::yearly:
+			if(ymd_date.month == 1 && ymd_date.day == 1)
+				write_save_file(*this, sys::save_type::autosave);
+			break;
+		default:
+			break;
+		}
 	}
+
+	tick_timings.end_day();
 }
 
 sys::checksum_key state::get_save_checksum() {
-	dcon::load_record loaded = world.make_serialize_record_store_save();
-	auto buffer = std::unique_ptr<uint8_t[]>(new uint8_t[world.serialize_size(loaded)]);
-	std::byte* start = reinterpret_cast<std::byte*>(buffer.get());
-	world.serialize(start, loaded);
-
-	auto buffer_position = reinterpret_cast<uint8_t*>(start);
-	int32_t total_size_used = static_cast<int32_t>(buffer_position - buffer.get());
-
-	checksum_key key;
-	blake2b(&key, sizeof(key), buffer.get(), total_size_used, nullptr, 0);
-	return key;
+	return save_checksum.compute(*this);
 }
 
 void state::debug_save_oos_dump() {
@@ -4441,7 +4765,61 @@ void state::debug_scenario_oos_dump() {
 	}
 }
 
+int32_t state::simulation_thread_count() const {
+	auto const hardware_threads = std::max(int32_t(std::thread::hardware_concurrency()), 1);
+	if(user_settings.simulation_threads > 0)
+		return std::min(int32_t(user_settings.simulation_threads), hardware_threads);
+	return std::max(hardware_threads - int32_t(user_settings.render_reserved_cores), 1);
+}
+
+#if defined(PREFER_ONE_TBB) && defined(__linux__)
+// binds each thread that joins the simulation arena to a core of its own, starting after the cores reserved for rendering
+class simulation_thread_pinning : public tbb::task_scheduler_observer {
+	int32_t first_core = 0;
+public:
+	simulation_thread_pinning(tbb::task_arena& arena, int32_t first_core) : tbb::task_scheduler_observer(arena), first_core(first_core) {
+		observe(true);
+	}
+	~simulation_thread_pinning() {
+		observe(false);
+	}
+	void on_scheduler_entry(bool) override {
+		auto const hardware_threads = std::max(int32_t(std::thread::hardware_concurrency()), 1);
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET((first_core + tbb::this_task_arena::current_thread_index()) % hardware_threads, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+};
+#endif
+
 void state::game_loop() {
+	// The parallel work of the simulation runs in a pool of its own, so that it is not competing for threads with the loading
+	// and ui work that also goes through the global one, and so that it can be sized to leave the render thread a core.
+	auto const thread_count = simulation_thread_count();
+#ifdef PREFER_ONE_TBB
+	tbb::task_arena simulation_arena(thread_count, 1,
+		user_settings.simulation_high_priority ? tbb::task_arena::priority::high : tbb::task_arena::priority::normal);
+#ifdef __linux__
+	std::unique_ptr<simulation_thread_pinning> pinning;
+	if(user_settings.pin_simulation_threads)
+		pinning = std::make_unique<simulation_thread_pinning>(simulation_arena, int32_t(user_settings.render_reserved_cores));
+#endif
+	simulation_arena.execute([&]() { run_game_loop(); });
+#else
+	if(user_settings.simulation_high_priority)
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+	concurrency::SchedulerPolicy policy(3,
+		concurrency::MinConcurrency, 1,
+		concurrency::MaxConcurrency, thread_count,
+		concurrency::ContextPriority, user_settings.simulation_high_priority ? THREAD_PRIORITY_ABOVE_NORMAL : THREAD_PRIORITY_NORMAL);
+	concurrency::CurrentScheduler::Create(policy);
+	run_game_loop();
+	concurrency::CurrentScheduler::Detach();
+#endif
+}
+
+void state::run_game_loop() {
 	static int32_t game_speed[] = {
 		0,		// speed 0
 		2000,	// speed 1 -- 2 seconds
@@ -4454,6 +4832,8 @@ void state::game_loop() {
 	game_speed[3] = int32_t(defines.alice_speed_3);
 	game_speed[4] = int32_t(defines.alice_speed_4);
 
+	stack_samples.set_target_to_current_thread();
+
 	while(quit_signaled.load(std::memory_order::acquire) == false) {
 		network::send_and_receive_commands(*this);
 		{
@@ -4461,7 +4841,7 @@ void state::game_loop() {
 			command::execute_pending_commands(*this);
 		}
 		if(network_mode == sys::network_mode_type::client) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(15));
+			network::wait_for_host_data(*this, 15);
 		} else {
 			auto speed = actual_game_speed.load(std::memory_order::acquire);
 			auto upause = ui_pause.load(std::memory_order::acquire);
@@ -4474,7 +4854,11 @@ void state::game_loop() {
 			} else {
 				auto entry_time = std::chrono::steady_clock::now();
 				auto ms_count = std::chrono::duration_cast<std::chrono::milliseconds>(entry_time - last_update).count();
-				if(speed >= 5 || ms_count >= game_speed[speed]) { /*enough time has passed*/
+				if(network_mode == sys::network_mode_type::host && !network::clients_keep_up(*this)) {
+					// hold back (without resetting the timer, so the tick goes out as soon as they catch up) rather than
+					// running away from a slow client that would then have to chew through a burst of ticks
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				} else if(speed >= 5 || ms_count >= game_speed[speed]) { /*enough time has passed*/
 					last_update = entry_time;
 					if(network_mode == sys::network_mode_type::host) {
 						command::advance_tick(*this, local_player_nation);
@@ -4995,10 +5379,21 @@ dcon::province_id state::get_port_for_landing(dcon::automated_army_group_id grou
 		return target;
 	}
 
+	// a single search outward from the target answers the safe path question for every ferry origin at once
+	static std::vector<dcon::province_id> ferry_origins;
+	static province::land_path_field field;
+	ferry_origins.clear();
+	for(auto target_port : fat_group.get_provinces_ferry_origin()) {
+		ferry_origins.push_back(target_port);
+	}
+	if(ferry_origins.empty()) {
+		return dcon::province_id{};
+	}
+	province::make_safe_land_path_field(*this, field, target, local_player_nation, ferry_origins);
+
 	dcon::province_id potential_target_port{};
-	for(auto& target_port : fat_group.get_provinces_ferry_origin()) {
-		auto path = province::make_safe_land_path(*this, target_port, target, local_player_nation);
-		if(path.size() > 0) {
+	for(auto target_port : ferry_origins) {
+		if(target_port != target && field.reaches(target_port)) {
 			potential_target_port = target_port;
 		}
 	}
@@ -5010,6 +5405,7 @@ void state::army_group_distribute_tasks(dcon::automated_army_group_id group) {
 	static std::vector<dcon::province_id> province_queue;
 	static std::vector<dcon::province_id> provinces_to_reduce_weight;
 	static std::vector<dcon::province_id> provinces_to_maintain;
+	static std::vector<bool> province_queued;
 	static std::vector<float> regiments_distribution;
 	regiments_distribution.resize(military_definitions.unit_base_definitions.size() + 2);
 
@@ -5148,8 +5544,10 @@ void state::army_group_distribute_tasks(dcon::automated_army_group_id group) {
 	province_queue.clear();
 	provinces_to_reduce_weight.clear();
 	provinces_to_maintain.clear();
+	province_queued.assign(world.province_size(), false);
 
 	province_queue.push_back(fat_group.get_hq());
+	province_queued[fat_group.get_hq().index()] = true;
 
 	size_t l = 0;
 	size_t r = 1;
@@ -5218,7 +5616,8 @@ void state::army_group_distribute_tasks(dcon::automated_army_group_id group) {
 		for(auto adj : world.province_get_province_adjacency(current_location)) {
 			auto other = adj.get_connected_provinces(adj.get_connected_provinces(0) == current_location ? 1 : 0);
 
-			if(std::find(province_queue.begin(), province_queue.end(), other) == province_queue.end()) {
+			if(!province_queued[other.id.index()]) {
+				province_queued[other.id.index()] = true;
 				province_queue.push_back(other);
 				r += 1;
 			}
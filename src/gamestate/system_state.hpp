@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <atomic>
 #include <chrono>
+#include <future>
 //#include <fstream>
 
 #include "window.hpp"
@@ -26,12 +27,24 @@
 #include "province.hpp"
 #include "events.hpp"
 #include "SPSCQueue.h"
+#include "MPSCQueue.h"
 #include "commands.hpp"
 #include "diplomatic_messages.hpp"
 #include "events.hpp"
 #include "notifications.hpp"
 #include "network.hpp"
 #include "fif.hpp"
+#include "tick_graph.hpp"
+#include "save_checksum.hpp"
+#include "replay.hpp"
+#include "sampling_profiler.hpp"
+
+namespace demographics {
+struct tick_buffers;
+struct tick_buffers_deleter {
+	void operator()(tick_buffers* p) const noexcept;
+};
+}
 
 // this header will eventually contain the highest-level objects
 // that represent the overall state of the program
@@ -391,6 +404,20 @@ struct user_settings_s {
 	sys::color_blind_mode color_blind_mode = sys::color_blind_mode::none;
 	uint32_t UNUSED_UINT32_T = 0;
 	char locale[16] = "en-US";
+	// the simulation runs its parallel work on a pool of its own, see state::game_loop
+	uint8_t simulation_threads = 0; // 0 = every hardware thread not reserved below
+	uint8_t render_reserved_cores = 1; // hardware threads left out of the simulation pool for the render thread
+	bool simulation_high_priority = false;
+	bool pin_simulation_threads = false;
+};
+
+// Autosaves are written incrementally: each one is compressed against a base, a save of its own that is written once and
+// then shared by all the autosaves after it, until they have drifted too far from it and a new base is made.
+struct autosave_chain_data {
+	std::shared_ptr<std::vector<uint8_t> const> base; // the uncompressed save section of the current base, if there is one
+	checksum_key base_key; // the hash of that section, which also names the file it is in
+	size_t base_file_size = 0;
+	bool rebase_due = false;
 };
 
 struct global_scenario_data_s { // this struct holds miscellaneous global properties of the scenario
@@ -510,6 +537,7 @@ struct alignas(64) state {
 	uint32_t scenario_counter = 0;		// as above
 	int32_t autosave_counter = 0; // which autosave file is next
 	sys::checksum_key scenario_checksum;// for checksum for savefiles
+	sys::checksum_key scenario_sources_checksum; // of the mod files the scenario was built from, zero if unknown
 	sys::checksum_key session_host_checksum;// for checking that the client can join a session
 	native_string loaded_scenario_file;
 	native_string loaded_save_file;
@@ -552,6 +580,7 @@ struct alignas(64) state {
 
 	std::vector<event::pending_human_n_event> future_n_event;
 	std::vector<event::pending_human_p_event> future_p_event;
+	sys::date next_future_event; // earliest date among the future events, null if there are none; not saved, see event::update_next_future_event
 
 	std::vector<int32_t> unit_names_indices; // indices for the names
 	std::vector<char> unit_names;
@@ -612,9 +641,11 @@ struct alignas(64) state {
 	std::atomic<bool> game_state_updated = false;                    // game state -> ui signal
 	std::atomic<bool> province_ownership_changed = true;                    // game state -> ui signal
 	std::atomic<bool> save_list_updated = false;                     // game state -> ui signal
+	std::future<void> background_save;                               // compression and writing of the last save, see write_save_file
+	autosave_chain_data autosave_chain;                              // only touched by the background save, see write_save_file
 	std::atomic<bool> quit_signaled = false;                         // ui -> game state signal
 	std::atomic<int32_t> actual_game_speed = 0;                      // ui -> game state message
-	rigtorp::SPSCQueue<command::payload> incoming_commands;          // ui or network -> local gamestate
+	sys::MPSCQueue<command::payload> incoming_commands;              // ui or network -> local gamestate
 	std::atomic<bool> ui_pause = false;                              // force pause by an important message being open
 	std::atomic<bool> railroad_built = true; // game state -> map
 
@@ -631,6 +662,21 @@ struct alignas(64) state {
 	// internal game timer / update logic
 	std::chrono::time_point<std::chrono::steady_clock> last_update = std::chrono::steady_clock::now();
 	bool internally_paused = false; // should NOT be set from the ui context (but may be read)
+	tick_task_graph daily_tick_graph; // built on the first tick, see build_daily_tick_graph
+	tick_profiler tick_timings; // per-phase timings of recent ticks, only collected while enabled
+	script_profiler script_timings; // per-key trigger and effect timings, only collected while enabled
+	ai_profiler ai_timings; // per-nation timings of the ai, only collected while enabled
+	sampling_profiler stack_samples; // call stacks of the game thread, only collected while running
+	save_checksum_cache save_checksum; // reusable buffer and per record hashes for get_save_checksum
+	replay_recorder replay_recording; // see the record-replay console command
+	std::unique_ptr<demographics::tick_buffers, demographics::tick_buffers_deleter> demographics_buffers; // staging for the daily pop updates, remade by fill_unsaved_data
+	province::land_access_cache land_access; // see scoped_land_access_cache
+	deferred_nation_modifiers deferred_modifiers; // see scoped_deferred_nation_modifiers
+	military::arrival_calendar unit_arrivals; // see military::set_arrival_time
+	military::war_status_matrix war_status; // see military::update_war_status_matrix
+	economy::factory_type_cost_table factory_type_costs; // see economy::update_factory_type_cost_table
+	economy::budget_estimate_cache budget_estimates; // ui thread only, see economy::get_budget_estimates
+	culture::estimated_pop_change_cache pop_change_estimates; // ui thread only, see demographics::get_estimated_changes
 
 	// common data for the window
 	int32_t x_size = 0;
@@ -642,6 +688,8 @@ struct alignas(64) state {
 	int32_t x_drag_start = 0;
 	int32_t y_drag_start = 0;
 	std::chrono::time_point<std::chrono::steady_clock> tooltip_timer = std::chrono::steady_clock::now();
+	// when the last window event arrived; see frame_needed
+	std::chrono::time_point<std::chrono::steady_clock> last_window_event = std::chrono::steady_clock::now();
 
 	// map data
 	map::map_state map_state;
@@ -687,10 +735,19 @@ struct alignas(64) state {
 	void on_text(char32_t c); // c is a win1250 codepage value
 	void render(); // called to render the frame may (and should) delay returning until the frame is rendered, including waiting
 	               // for vsync
+	// Whether the window loop has to render a new frame. While the game is paused and nothing moves, the last frame is left on
+	// the screen until there is input, a change to the game state (from a command, say) or camera movement, rather than the same
+	// picture being drawn again at the refresh rate.
+	bool frame_needed();
+	void note_window_event() {
+		last_window_event = std::chrono::steady_clock::now();
+	}
 
 	void single_game_tick();
 	// this function runs the internal logic of the game. It will return *only* after a quit notification is sent to it
 	void game_loop();
+	void run_game_loop();
+	int32_t simulation_thread_count() const; // the size of the pool game_loop runs the parallel work of the simulation in
 	sys::checksum_key get_save_checksum();
 	void debug_save_oos_dump();
 	void debug_scenario_oos_dump();
@@ -0,0 +1,65 @@
+#include "tick_graph.hpp"
+#include "system_state.hpp"
+
+namespace sys {
+
+int32_t tick_task_graph::add(char const* name, uint64_t reads, uint64_t writes, std::function<void(sys::state&)> function) {
+	tick_task t;
+	t.function = std::move(function);
+	t.name = name;
+	t.reads = reads | writes; // writing something generally requires reading it
+	t.writes = writes;
+	tasks.emplace_back(std::move(t));
+	compiled = false;
+	return int32_t(tasks.size() - 1);
+}
+
+void tick_task_graph::compile() {
+	levels.clear();
+
+	/*
+	Each task is placed one level after the deepest earlier task that it conflicts with. Two tasks conflict if either
+	one writes something the other one reads or writes. Tasks sharing a level therefore never conflict with each other,
+	and any pair of conflicting tasks still runs in registration order.
+	*/
+	for(int32_t i = 0; i < int32_t(tasks.size()); ++i) {
+		int32_t level = 0;
+		for(int32_t j = 0; j < i; ++j) {
+			bool conflicts = (tasks[i].reads & tasks[j].writes) != 0 || (tasks[i].writes & tasks[j].reads) != 0;
+			if(conflicts)
+				level = std::max(level, tasks[j].level + 1);
+		}
+		tasks[i].level = level;
+		if(int32_t(levels.size()) <= level)
+			levels.resize(level + 1);
+		levels[level].push_back(i);
+	}
+
+	compiled = true;
+}
+
+void tick_task_graph::register_profiler_phases(tick_profiler& profiler) {
+	for(auto& t : tasks) {
+		if(t.profiler_phase == -1)
+			t.profiler_phase = profiler.register_phase(t.name);
+	}
+}
+
+void tick_task_graph::run(sys::state& state) {
+	if(!compiled)
+		compile();
+
+	for(auto& level : levels) {
+		if(level.size() == 1) {
+			scoped_tick_timer timer{ state.tick_timings, tasks[level[0]].profiler_phase };
+			tasks[level[0]].function(state);
+		} else {
+			concurrency::parallel_for(0, int32_t(level.size()), [&](int32_t index) {
+				scoped_tick_timer timer{ state.tick_timings, tasks[level[index]].profiler_phase };
+				tasks[level[index]].function(state);
+			});
+		}
+	}
+}
+
+} // namespace sys
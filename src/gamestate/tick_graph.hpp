@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+#include "tick_profiler.hpp"
+
+namespace sys {
+struct state;
+}
+
+namespace sys {
+
+// Data domains that tick tasks may read or write. Dependencies between tasks are derived from these:
+// a task must run after every task registered before it that writes something it reads, or that reads or
+// writes something it writes. Tasks that do not conflict may be dispatched together, but conflicting tasks
+// always keep their registration order, which is what keeps the tick deterministic.
+namespace tick_data {
+
+constexpr inline uint64_t pops = 0x0000000000000001;
+constexpr inline uint64_t pop_demographics = 0x0000000000000002;
+constexpr inline uint64_t pop_budgets = 0x0000004000000000; // pop money, employment and needs satisfaction
+constexpr inline uint64_t province_control = 0x0000000000000004;
+constexpr inline uint64_t colonization = 0x0000000000000008;
+constexpr inline uint64_t economy = 0x0000000000000010;
+constexpr inline uint64_t rgo_employment = 0x0000000000000020;
+constexpr inline uint64_t factory_employment = 0x0000000000000040;
+constexpr inline uint64_t treasury = 0x0000000000000080;
+constexpr inline uint64_t units = 0x0000000000000100; // armies, navies, regiments, ships
+constexpr inline uint64_t battles = 0x0000000000000200;
+constexpr inline uint64_t leaders = 0x0000000000000400;
+constexpr inline uint64_t land_unit_average = 0x0000000000000800;
+constexpr inline uint64_t ship_scores = 0x0000000000001000;
+constexpr inline uint64_t regiment_counts = 0x0000000000002000;
+constexpr inline uint64_t recruitable_regiments = 0x0000000000004000;
+constexpr inline uint64_t naval_supply = 0x0000000000008000;
+constexpr inline uint64_t dig_in = 0x0000000000010000;
+constexpr inline uint64_t blockades = 0x0000000000020000;
+constexpr inline uint64_t home_ports = 0x0000000000040000;
+constexpr inline uint64_t research = 0x0000000000080000;
+constexpr inline uint64_t research_points = 0x0000000000100000;
+constexpr inline uint64_t industrial_scores = 0x0000000000200000;
+constexpr inline uint64_t military_scores = 0x0000000000400000;
+constexpr inline uint64_t rankings = 0x0000000000800000;
+constexpr inline uint64_t great_powers = 0x0000000001000000;
+constexpr inline uint64_t influence = 0x0000000002000000;
+constexpr inline uint64_t administrative_efficiency = 0x0000000004000000;
+constexpr inline uint64_t rebels = 0x0000000008000000;
+constexpr inline uint64_t party_loyalty = 0x0000000010000000;
+constexpr inline uint64_t elections = 0x0000000020000000;
+constexpr inline uint64_t flashpoints = 0x0000000040000000;
+constexpr inline uint64_t crisis = 0x0000000080000000;
+constexpr inline uint64_t war_score = 0x0000000100000000;
+constexpr inline uint64_t wars = 0x0000000200000000; // wars, cbs, truces and other diplomatic relations
+constexpr inline uint64_t modifiers = 0x0000000400000000;
+constexpr inline uint64_t events = 0x0000000800000000;
+constexpr inline uint64_t ai = 0x0000001000000000;
+// anything that pushes into one of the single producer queues (notifications, events, diplomatic requests,
+// battle reports) must write this, since those queues may only be fed from one thread at a time
+constexpr inline uint64_t messages = 0x0000002000000000;
+
+constexpr inline uint64_t everything = ~uint64_t(0);
+
+} // namespace tick_data
+
+struct tick_task {
+	std::function<void(sys::state&)> function;
+	char const* name = "";
+	uint64_t reads = 0;
+	uint64_t writes = 0;
+	int32_t level = 0;
+	int32_t profiler_phase = -1;
+};
+
+class tick_task_graph {
+	std::vector<tick_task> tasks;
+	std::vector<std::vector<int32_t>> levels; // tasks grouped into waves that may run together
+	bool compiled = false;
+
+public:
+	// registration order matters: it is the order that conflicting tasks are executed in
+	int32_t add(char const* name, uint64_t reads, uint64_t writes, std::function<void(sys::state&)> function);
+	void compile();
+	// must be called outside of any parallel section, before the graph runs
+	void register_profiler_phases(tick_profiler& profiler);
+	void run(sys::state& state);
+
+	int32_t size() const {
+		return int32_t(tasks.size());
+	}
+	tick_task const& get_task(int32_t i) const {
+		return tasks[i];
+	}
+	int32_t level_count() const {
+		return int32_t(levels.size());
+	}
+	bool empty() const {
+		return tasks.empty();
+	}
+};
+
+} // namespace sys
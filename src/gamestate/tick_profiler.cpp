@@ -0,0 +1,410 @@
+#include <string.h>
+#include <algorithm>
+#include "tick_profiler.hpp"
+#include "system_state.hpp"
+#include "nations.hpp"
+
+namespace sys {
+
+int32_t tick_profiler::register_phase(char const* name) {
+	std::lock_guard l{ history_lock };
+	for(int32_t i = 0; i < int32_t(phase_names.size()); ++i) {
+		if(phase_names[i] == name || strcmp(phase_names[i], name) == 0)
+			return i;
+	}
+	if(int32_t(phase_names.size()) >= max_phases)
+		return -1;
+	phase_names.push_back(name);
+	return int32_t(phase_names.size() - 1);
+}
+
+void tick_profiler::begin_day(sys::date d) {
+	current.fill(0);
+	current_day = d;
+	day_start = std::chrono::steady_clock::now();
+}
+
+void tick_profiler::end_day() {
+	auto duration = std::chrono::steady_clock::now() - day_start;
+
+	std::lock_guard l{ history_lock };
+	auto row = days_recorded % history_length;
+	std::copy(current.begin(), current.end(), history.begin() + size_t(row) * size_t(max_phases));
+	history_dates[row] = current_day;
+	history_totals[row] = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	++days_recorded;
+}
+
+void tick_profiler::clear() {
+	std::lock_guard l{ history_lock };
+	std::fill(history.begin(), history.end(), int64_t(0));
+	history_totals.fill(0);
+	days_recorded = 0;
+}
+
+std::vector<tick_profiler::phase_summary> tick_profiler::top_phases(int32_t count) const {
+	std::vector<phase_summary> result;
+
+	std::lock_guard l{ history_lock };
+	auto rows = std::min(days_recorded, history_length);
+	if(rows == 0)
+		return result;
+	auto last_row = (days_recorded - 1) % history_length;
+
+	std::vector<int64_t> sorted(size_t(rows), 0);
+	for(int32_t i = 0; i < int32_t(phase_names.size()); ++i) {
+		int64_t sum = 0;
+		for(int32_t r = 0; r < rows; ++r) {
+			auto v = history[size_t(r) * size_t(max_phases) + size_t(i)];
+			sum += v;
+			sorted[r] = v;
+		}
+		std::sort(sorted.begin(), sorted.end());
+		phase_summary s;
+		s.name = phase_names[i];
+		s.average_ms = float(sum) / float(rows) / 1000.0f;
+		s.peak_ms = float(sorted.back()) / 1000.0f;
+		s.last_ms = float(history[size_t(last_row) * size_t(max_phases) + size_t(i)]) / 1000.0f;
+		s.median_ms = float(sorted[sorted.size() / 2]) / 1000.0f;
+		s.p99_ms = float(sorted[(sorted.size() - 1) * 99 / 100]) / 1000.0f;
+		result.push_back(s);
+	}
+
+	std::sort(result.begin(), result.end(), [](phase_summary const& a, phase_summary const& b) {
+		if(a.average_ms != b.average_ms)
+			return a.average_ms > b.average_ms;
+		return strcmp(a.name, b.name) < 0;
+	});
+	if(int32_t(result.size()) > count)
+		result.resize(count);
+	return result;
+}
+
+std::string tick_profiler::to_csv(sys::state& state) const {
+	std::string result = "date,total";
+
+	std::lock_guard l{ history_lock };
+	for(auto n : phase_names) {
+		result += ",";
+		result += n;
+	}
+	result += "\n";
+
+	auto rows = std::min(days_recorded, history_length);
+	auto first = days_recorded - rows;
+	for(int32_t d = first; d < days_recorded; ++d) {
+		auto row = d % history_length;
+		auto ymd = history_dates[row].to_ymd(state.start_date);
+		result += std::to_string(ymd.year) + "-" + std::to_string(ymd.month) + "-" + std::to_string(ymd.day);
+		result += "," + std::to_string(history_totals[row]);
+		for(int32_t i = 0; i < int32_t(phase_names.size()); ++i) {
+			result += ",";
+			result += std::to_string(history[size_t(row) * size_t(max_phases) + size_t(i)]);
+		}
+		result += "\n";
+	}
+	return result;
+}
+
+void profile_counters::resize(size_t count) {
+	// the counters are only reallocated the first time, so that a timer still running from an earlier profile (on the game
+	// thread) can't record into freed memory
+	if(count != size) {
+		calls = std::unique_ptr<std::atomic<int64_t>[]>(new std::atomic<int64_t>[count]);
+		nanoseconds = std::unique_ptr<std::atomic<int64_t>[]>(new std::atomic<int64_t>[count]);
+	}
+	for(size_t i = 0; i < count; ++i) {
+		calls[i].store(0, std::memory_order::relaxed);
+		nanoseconds[i].store(0, std::memory_order::relaxed);
+	}
+	size = count;
+}
+
+void script_profiler::reset(size_t trigger_key_count, size_t effect_key_count) {
+	triggers.resize(trigger_key_count);
+	effects.resize(effect_key_count);
+}
+
+std::vector<script_profiler::key_summary> script_profiler::all_keys(sys::state& state) const {
+	std::vector<key_summary> result;
+
+	for(size_t i = 0; i < triggers.size; ++i) {
+		if(auto c = triggers.calls[i].load(std::memory_order::relaxed); c != 0) {
+			key_summary s;
+			s.key = int32_t(i);
+			s.calls = c;
+			s.nanoseconds = triggers.nanoseconds[i].load(std::memory_order::relaxed);
+			result.push_back(std::move(s));
+		}
+	}
+	auto first_effect = result.size();
+	for(size_t i = 0; i < effects.size; ++i) {
+		if(auto c = effects.calls[i].load(std::memory_order::relaxed); c != 0) {
+			key_summary s;
+			s.is_effect = true;
+			s.key = int32_t(i);
+			s.calls = c;
+			s.nanoseconds = effects.nanoseconds[i].load(std::memory_order::relaxed);
+			result.push_back(std::move(s));
+		}
+	}
+
+	// map the keys back to whatever uses them
+	std::vector<int32_t> trigger_rows(triggers.size, -1);
+	std::vector<int32_t> effect_rows(effects.size, -1);
+	for(size_t i = 0; i < first_effect; ++i)
+		trigger_rows[result[i].key] = int32_t(i);
+	for(size_t i = first_effect; i < result.size(); ++i)
+		effect_rows[result[i].key] = int32_t(i);
+
+	auto add_user = [&](std::vector<int32_t> const& rows, int32_t key, std::string_view user) {
+		if(0 <= key && size_t(key) < rows.size() && rows[key] != -1) {
+			auto& u = result[rows[key]].used_by;
+			if(!u.empty())
+				u += "; ";
+			u += user;
+		}
+	};
+	auto add_trigger_user = [&](dcon::trigger_key k, std::string const& user) {
+		if(k)
+			add_user(trigger_rows, int32_t(k.index()), user);
+	};
+	auto add_effect_user = [&](dcon::effect_key k, std::string const& user) {
+		if(k)
+			add_user(effect_rows, int32_t(k.index()), user);
+	};
+	auto add_event_effects = [&](std::string const& name, dcon::effect_key immediate, std::array<sys::event_option, sys::max_event_options> const& options) {
+		add_effect_user(immediate, name + " immediate");
+		for(uint32_t j = 0; j < sys::max_event_options; ++j)
+			add_effect_user(options[j].effect, name + " option " + std::to_string(j + 1));
+	};
+
+	for(auto e : state.world.in_free_national_event) {
+		auto name = "national event " + std::to_string(e.get_legacy_id());
+		add_trigger_user(e.get_trigger(), name + " trigger");
+		add_event_effects(name, e.get_immediate_effect(), e.get_options());
+	}
+	for(auto e : state.world.in_free_provincial_event) {
+		auto name = "provincial event " + std::string(state.to_string_view(e.get_name()));
+		add_trigger_user(e.get_trigger(), name + " trigger");
+		add_event_effects(name, e.get_immediate_effect(), e.get_options());
+	}
+	for(auto e : state.world.in_national_event) {
+		add_event_effects("national event " + std::string(state.to_string_view(e.get_name())), e.get_immediate_effect(), e.get_options());
+	}
+	for(auto e : state.world.in_provincial_event) {
+		add_event_effects("provincial event " + std::string(state.to_string_view(e.get_name())), e.get_immediate_effect(), e.get_options());
+	}
+	for(auto d : state.world.in_decision) {
+		auto name = "decision " + std::string(state.to_string_view(d.get_name()));
+		add_trigger_user(d.get_potential(), name + " potential");
+		add_trigger_user(d.get_allow(), name + " allow");
+		add_effect_user(d.get_effect(), name + " effect");
+	}
+	for(auto t : state.world.in_stored_trigger) {
+		add_trigger_user(t.get_function(), "scripted trigger " + std::string(state.to_string_view(t.get_name())));
+	}
+
+	return result;
+}
+
+std::vector<script_profiler::key_summary> script_profiler::top_keys(sys::state& state, int32_t count) const {
+	auto result = all_keys(state);
+	std::sort(result.begin(), result.end(), [](key_summary const& a, key_summary const& b) {
+		if(a.nanoseconds != b.nanoseconds)
+			return a.nanoseconds > b.nanoseconds;
+		if(a.is_effect != b.is_effect)
+			return !a.is_effect;
+		return a.key < b.key;
+	});
+	if(int32_t(result.size()) > count)
+		result.resize(count);
+	return result;
+}
+
+std::string script_profiler::to_csv(sys::state& state) const {
+	std::string result = "kind,key,calls,total_us,used_by\n";
+	for(auto& k : all_keys(state)) {
+		result += k.is_effect ? "effect," : "trigger,";
+		result += std::to_string(k.key) + "," + std::to_string(k.calls) + "," + std::to_string(k.nanoseconds / 1000) + ",\"";
+		result += k.used_by;
+		result += "\"\n";
+	}
+	return result;
+}
+
+char const* ai_profiler::task_name(task t) {
+	switch(t) {
+	case task::research:
+		return "update_ai_research";
+	case task::econ_construction:
+		return "update_ai_econ_construction";
+	case task::budget:
+		return "update_budget";
+	case task::war_declarations:
+		return "make_war_decs";
+	case task::assign_targets:
+		return "assign_targets";
+	case task::distribute_guards:
+		return "distribute_guards";
+	case task::build_ships:
+		return "build_ships";
+	case task::land_constructions:
+		return "update_land_constructions";
+	case task::pickup_idle_ships:
+		return "pickup_idle_ships";
+	case task::new_units_and_merging:
+		return "new_units_and_merging";
+	default:
+		return "";
+	}
+}
+
+void ai_profiler::reset(size_t nation_count) {
+	current.resize(nation_count * task_count);
+	last_month.resize(nation_count * task_count);
+	has_last_month = false;
+}
+
+void ai_profiler::end_month() {
+	if(!enabled.load(std::memory_order::acquire))
+		return;
+	for(size_t i = 0; i < current.size && i < last_month.size; ++i) {
+		last_month.calls[i].store(current.calls[i].exchange(0, std::memory_order::relaxed), std::memory_order::relaxed);
+		last_month.nanoseconds[i].store(current.nanoseconds[i].exchange(0, std::memory_order::relaxed), std::memory_order::relaxed);
+	}
+	has_last_month = true;
+}
+
+std::vector<ai_profiler::entry> ai_profiler::all_entries() const {
+	auto& source = has_last_month ? last_month : current;
+	std::vector<entry> result;
+	for(size_t i = 0; i < source.size; ++i) {
+		if(auto c = source.calls[i].load(std::memory_order::relaxed); c != 0) {
+			entry e;
+			e.nation = int32_t(i / task_count);
+			e.t = task(i % task_count);
+			e.calls = c;
+			e.nanoseconds = source.nanoseconds[i].load(std::memory_order::relaxed);
+			result.push_back(e);
+		}
+	}
+	return result;
+}
+
+std::vector<ai_profiler::entry> ai_profiler::top_entries(int32_t count) const {
+	auto result = all_entries();
+	std::sort(result.begin(), result.end(), [](entry const& a, entry const& b) {
+		if(a.nanoseconds != b.nanoseconds)
+			return a.nanoseconds > b.nanoseconds;
+		if(a.nation != b.nation)
+			return a.nation < b.nation;
+		return a.t < b.t;
+	});
+	if(int32_t(result.size()) > count)
+		result.resize(count);
+	return result;
+}
+
+std::vector<ai_profiler::entry> ai_profiler::top_nations(int32_t count) const {
+	std::vector<entry> result;
+	for(auto& e : all_entries()) {
+		if(result.empty() || result.back().nation != e.nation) {
+			result.emplace_back();
+			result.back().nation = e.nation;
+		}
+		result.back().calls += e.calls;
+		result.back().nanoseconds += e.nanoseconds;
+	}
+	std::sort(result.begin(), result.end(), [](entry const& a, entry const& b) {
+		if(a.nanoseconds != b.nanoseconds)
+			return a.nanoseconds > b.nanoseconds;
+		return a.nation < b.nation;
+	});
+	if(int32_t(result.size()) > count)
+		result.resize(count);
+	return result;
+}
+
+std::string ai_profiler::to_csv(sys::state& state) const {
+	std::string result = "nation,tag,task,calls,total_us\n";
+	for(auto& e : all_entries()) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(e.nation) };
+		auto tag = state.world.nation_is_valid(n) ? nations::int_to_tag(state.world.national_identity_get_identifying_int(state.world.nation_get_identity_from_identity_holder(n))) : std::string("");
+		result += std::to_string(e.nation) + "," + tag + "," + task_name(e.t) + "," + std::to_string(e.calls) + "," + std::to_string(e.nanoseconds / 1000) + "\n";
+	}
+	return result;
+}
+
+void scenario_build_timer::end_stage(char const* name) {
+	auto now = std::chrono::steady_clock::now();
+	stages.push_back(entry{ name, std::chrono::duration_cast<std::chrono::microseconds>(now - stage_start).count() });
+	stage_start = now;
+}
+
+std::string scenario_build_timer::report(int32_t max_files) const {
+	auto ms = [](int64_t microseconds) {
+		return std::to_string(microseconds / 1000) + "." + std::to_string((microseconds / 100) % 10) + " ms";
+	};
+
+	std::string result = "Stages:\n";
+	int64_t total = 0;
+	for(auto& s : stages) {
+		result += "\t" + s.name + ": " + ms(s.microseconds) + "\n";
+		total += s.microseconds;
+	}
+	result += "\ttotal: " + ms(total) + "\n";
+
+	if(!background.empty()) {
+		result += "Background:\n";
+		for(auto& b : background)
+			result += "\t" + b.name + ": " + ms(b.microseconds) + "\n";
+	}
+
+	std::vector<entry const*> slowest;
+	slowest.reserve(files.size());
+	for(auto& f : files)
+		slowest.push_back(&f);
+	std::sort(slowest.begin(), slowest.end(), [](entry const* a, entry const* b) {
+		return a->microseconds > b->microseconds;
+	});
+	if(int32_t(slowest.size()) > max_files)
+		slowest.resize(max_files);
+	if(!slowest.empty()) {
+		result += "Slowest files:\n";
+		for(auto f : slowest)
+			result += "\t" + f->name + ": " + ms(f->microseconds) + "\n";
+	}
+	return result;
+}
+
+template<typename T>
+static size_t vector_bytes(std::vector<T> const& v) {
+	return v.capacity() * sizeof(T);
+}
+
+std::vector<memory_usage_entry> describe_memory_usage(sys::state& state) {
+	std::vector<memory_usage_entry> result;
+
+	result.push_back(memory_usage_entry{ "data container", size_t(state.world.serialize_size(state.world.make_serialize_record_store_full_save())) });
+	result.push_back(memory_usage_entry{ "trigger data", vector_bytes(state.trigger_data) + vector_bytes(state.trigger_data_indices) });
+	result.push_back(memory_usage_entry{ "effect data", vector_bytes(state.effect_data) + vector_bytes(state.effect_data_indices) });
+	result.push_back(memory_usage_entry{ "value modifiers", vector_bytes(state.value_modifier_segments) + state.value_modifiers.size() * sizeof(sys::value_modifier_description) });
+	result.push_back(memory_usage_entry{ "localisation", vector_bytes(state.key_data) + vector_bytes(state.locale_text_data) });
+
+	auto& m = state.map_state.map_data;
+	result.push_back(memory_usage_entry{ "map pixel data", vector_bytes(m.terrain_id_map) + vector_bytes(m.median_terrain_type)
+		+ vector_bytes(m.province_area) + vector_bytes(m.diagonal_borders) + vector_bytes(m.province_id_map) + vector_bytes(m.map_indices)
+		+ vector_bytes(m.province_id_sea_mask) + vector_bytes(m.uploaded_province_color) + vector_bytes(m.uploaded_province_fow) });
+	result.push_back(memory_usage_entry{ "map border and river meshes", vector_bytes(m.borders) + vector_bytes(m.border_vertices)
+		+ vector_bytes(m.river_vertices) + vector_bytes(m.river_starts) + vector_bytes(m.river_counts)
+		+ vector_bytes(m.railroad_vertices) + vector_bytes(m.railroad_starts) + vector_bytes(m.railroad_counts)
+		+ vector_bytes(m.coastal_vertices) + vector_bytes(m.coastal_starts) + vector_bytes(m.coastal_counts)
+		+ vector_bytes(m.border_draw_starts) + vector_bytes(m.border_draw_counts) + vector_bytes(m.static_mesh_starts) + vector_bytes(m.static_mesh_counts) });
+	result.push_back(memory_usage_entry{ "map text meshes", vector_bytes(m.text_line_texture_per_quad) + vector_bytes(m.text_line_vertices)
+		+ vector_bytes(m.province_text_line_vertices) });
+
+	return result;
+}
+
+} // namespace sys
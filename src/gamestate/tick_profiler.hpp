@@ -0,0 +1,291 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "date_interface.hpp"
+
+namespace sys {
+struct state;
+}
+
+namespace sys {
+
+// Collects wall-clock timings for the named phases of single_game_tick. The timings of the last
+// history_length days are kept in a ring buffer, so that individual slow days (for example the day of
+// the month on which a particular monthly update runs) remain visible rather than being averaged away.
+class tick_profiler {
+public:
+	static constexpr int32_t max_phases = 128;
+	static constexpr int32_t history_length = 128;
+
+	struct phase_summary {
+		char const* name = "";
+		float average_ms = 0.0f;
+		float peak_ms = 0.0f;
+		float last_ms = 0.0f;
+		float median_ms = 0.0f;
+		float p99_ms = 0.0f;
+	};
+
+	std::atomic<bool> enabled = false;
+
+	tick_profiler() : history(size_t(max_phases) * size_t(history_length), 0) { }
+
+	// phases may only be registered from the game thread outside of any parallel section; the
+	// same name (compared by content) always maps to the same phase
+	int32_t register_phase(char const* name);
+
+	void begin_day(sys::date d);
+	// safe to call concurrently, as long as every thread records into a distinct phase
+	void record(int32_t phase, int64_t microseconds) {
+		if(0 <= phase && phase < max_phases)
+			current[phase] += microseconds;
+	}
+	void end_day();
+	void clear();
+
+	std::vector<phase_summary> top_phases(int32_t count) const;
+	// one row per recorded day, one column per phase, times in microseconds
+	std::string to_csv(sys::state& state) const;
+
+private:
+	std::vector<char const*> phase_names;
+	std::array<int64_t, max_phases> current = { 0 };
+	std::vector<int64_t> history; // history_length rows of max_phases entries
+	std::array<sys::date, history_length> history_dates = { };
+	int64_t current_day_total = 0;
+	std::array<int64_t, history_length> history_totals = { 0 };
+	std::chrono::time_point<std::chrono::steady_clock> day_start;
+	sys::date current_day;
+	int32_t days_recorded = 0;
+	mutable std::mutex history_lock;
+};
+
+class scoped_tick_timer {
+	tick_profiler& profiler;
+	std::chrono::time_point<std::chrono::steady_clock> start;
+	int32_t phase = -1;
+public:
+	scoped_tick_timer(tick_profiler& profiler, int32_t phase) : profiler(profiler) {
+		if(profiler.enabled.load(std::memory_order::relaxed)) {
+			this->phase = phase;
+			start = std::chrono::steady_clock::now();
+		}
+	}
+	~scoped_tick_timer() {
+		if(phase != -1) {
+			auto duration = std::chrono::steady_clock::now() - start;
+			profiler.record(phase, std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+		}
+	}
+};
+
+// A call count and a total time for each of a fixed number of keys, safe to record into concurrently
+struct profile_counters {
+	std::unique_ptr<std::atomic<int64_t>[]> calls;
+	std::unique_ptr<std::atomic<int64_t>[]> nanoseconds;
+	size_t size = 0;
+
+	// zeroes the counters, sizing them for count keys
+	void resize(size_t count);
+	void record(size_t key, int64_t ns) {
+		if(key < size) {
+			calls[key].fetch_add(1, std::memory_order::relaxed);
+			nanoseconds[key].fetch_add(ns, std::memory_order::relaxed);
+		}
+	}
+};
+
+// Counts the calls to, and the time spent in, trigger::evaluate and effect::execute for each trigger and effect key, so that
+// expensive scripts can be found. Times are inclusive: a trigger tested from within an effect (or through `test`) counts
+// towards its own key as well as towards the key that invoked it.
+class script_profiler {
+public:
+	struct key_summary {
+		bool is_effect = false;
+		int32_t key = 0;
+		int64_t calls = 0;
+		int64_t nanoseconds = 0;
+		std::string used_by;
+	};
+
+	std::atomic<bool> enabled = false;
+
+	// zeroes the counters, sizing them for the given numbers of keys; only call this while the profiler is disabled
+	void reset(size_t trigger_key_count, size_t effect_key_count);
+	// safe to call concurrently
+	void record_trigger(int32_t key, int64_t nanoseconds) {
+		if(key >= 0)
+			triggers.record(size_t(key), nanoseconds);
+	}
+	void record_effect(int32_t key, int64_t nanoseconds) {
+		if(key >= 0)
+			effects.record(size_t(key), nanoseconds);
+	}
+
+	// the keys with the most total time, along with the events, decisions and scripted triggers that use them
+	std::vector<key_summary> top_keys(sys::state& state, int32_t count) const;
+	// one row per key that was called at least once, times in microseconds
+	std::string to_csv(sys::state& state) const;
+
+private:
+	std::vector<key_summary> all_keys(sys::state& state) const;
+
+	profile_counters triggers;
+	profile_counters effects;
+};
+
+class scoped_script_timer {
+	script_profiler& profiler;
+	std::chrono::time_point<std::chrono::steady_clock> start;
+	int32_t key = -1;
+	bool is_effect = false;
+public:
+	scoped_script_timer(script_profiler& profiler, int32_t key, bool is_effect) : profiler(profiler), is_effect(is_effect) {
+		if(profiler.enabled.load(std::memory_order::relaxed)) {
+			this->key = key;
+			start = std::chrono::steady_clock::now();
+		}
+	}
+	~scoped_script_timer() {
+		if(key != -1) {
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			if(is_effect)
+				profiler.record_effect(key, ns);
+			else
+				profiler.record_trigger(key, ns);
+		}
+	}
+};
+
+// The time spent by each nation in the per-nation parts of the larger ai functions, so that the nations behind the spikes on
+// the days those run can be found. What is recorded during a month is kept, once it is over, as the last month's figures.
+class ai_profiler {
+public:
+	enum class task : uint8_t {
+		research,
+		econ_construction,
+		budget,
+		war_declarations,
+		assign_targets,
+		distribute_guards,
+		build_ships,
+		land_constructions,
+		pickup_idle_ships,
+		new_units_and_merging,
+		count
+	};
+	static constexpr size_t task_count = size_t(task::count);
+
+	struct entry {
+		int32_t nation = 0;
+		task t = task::research;
+		int64_t calls = 0;
+		int64_t nanoseconds = 0;
+	};
+
+	std::atomic<bool> enabled = false;
+
+	static char const* task_name(task t);
+
+	// zeroes the counters of both months, sizing them for the given number of nations; only call this while the profiler is
+	// disabled
+	void reset(size_t nation_count);
+	// safe to call concurrently
+	void record(task t, int32_t nation, int64_t nanoseconds) {
+		if(nation >= 0)
+			current.record(size_t(nation) * task_count + size_t(t), nanoseconds);
+	}
+	// called at the start of each month, from the game thread outside of any parallel section
+	void end_month();
+
+	// the nation and task pairs that took the most time last month (or so far, if no month has ended since the reset)
+	std::vector<entry> top_entries(int32_t count) const;
+	// the nations that took the most time last month over all tasks, with t left at its default
+	std::vector<entry> top_nations(int32_t count) const;
+	// one row per nation and task that was called at least once last month, times in microseconds
+	std::string to_csv(sys::state& state) const;
+
+private:
+	std::vector<entry> all_entries() const;
+
+	profile_counters current;
+	profile_counters last_month;
+	bool has_last_month = false;
+};
+
+class scoped_ai_timer {
+	ai_profiler& profiler;
+	std::chrono::time_point<std::chrono::steady_clock> start;
+	int32_t nation = -1;
+	ai_profiler::task t;
+public:
+	scoped_ai_timer(ai_profiler& profiler, ai_profiler::task t, int32_t nation) : profiler(profiler), t(t) {
+		if(profiler.enabled.load(std::memory_order::relaxed)) {
+			this->nation = nation;
+			start = std::chrono::steady_clock::now();
+		}
+	}
+	~scoped_ai_timer() {
+		if(nation != -1)
+			profiler.record(t, nation, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+};
+
+// Wall-clock timings for building a scenario: the time taken by each stage of load_scenario_data, in order, and by each of
+// the individual files parsed within the stages that read many of them. Not thread safe; used only by the thread that
+// builds the scenario.
+class scenario_build_timer {
+public:
+	struct entry {
+		std::string name;
+		int64_t microseconds = 0;
+	};
+
+	// measures the time until it is destroyed as that taken by the named file
+	class scoped_file {
+		scenario_build_timer& timer;
+		std::string name;
+		std::chrono::time_point<std::chrono::steady_clock> start;
+	public:
+		scoped_file(scenario_build_timer& timer, std::string name) : timer(timer), name(std::move(name)), start(std::chrono::steady_clock::now()) { }
+		~scoped_file() {
+			timer.files.push_back(entry{ std::move(name), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() });
+		}
+	};
+
+	scenario_build_timer() : stage_start(std::chrono::steady_clock::now()) { }
+
+	// the named stage is the one that ran from the end of the previous stage until now
+	void end_stage(char const* name);
+	// for work done on another thread, which overlaps the stages
+	void add_background(char const* name, int64_t microseconds) {
+		background.push_back(entry{ name, microseconds });
+	}
+	// the stages, the background work and the slowest max_files files, times in milliseconds
+	std::string report(int32_t max_files) const;
+
+private:
+	std::vector<entry> stages;
+	std::vector<entry> background;
+	std::vector<entry> files;
+	std::chrono::time_point<std::chrono::steady_clock> stage_start;
+};
+
+struct memory_usage_entry {
+	char const* name = "";
+	size_t bytes = 0;
+};
+
+// An estimate of the memory held by the larger parts of the state: the live records of the data container (as the size they
+// would take up in a save, which leaves out any unused capacity), the script bytecode, the localisation text and the map's
+// cpu-side buffers. Buffers are counted at their capacity.
+std::vector<memory_usage_entry> describe_memory_usage(sys::state& state);
+
+} // namespace sys
@@ -3,6 +3,8 @@
 #include "simple_fs.hpp"
 #include "fonts.hpp"
 #include "bmfont.hpp"
+#include "blake2.h"
+#include <cstring>
 
 namespace ogl {
 
@@ -37,6 +39,16 @@ void notify_user_of_fatal_opengl_error(std::string message) {
 }
 
 
+// put in front of every shader's source
+constexpr char const* shader_prelude =
+		"#version 140\r\n"
+		"#extension GL_ARB_explicit_uniform_location : enable\r\n"
+		"#extension GL_ARB_explicit_attrib_location : enable\r\n"
+		"#extension GL_ARB_shader_subroutine : enable\r\n"
+		"#extension GL_ARB_vertex_array_object : enable\r\n"
+		"#define M_PI 3.1415926535897932384626433832795\r\n"
+		"#define PI 3.1415926535897932384626433832795\r\n";
+
 GLint compile_shader(std::string_view source, GLenum type) {
 	GLuint return_value = glCreateShader(type);
 
@@ -46,16 +58,10 @@ GLint compile_shader(std::string_view source, GLenum type) {
 
 	std::string s_source(source);
 	GLchar const* texts[] = {
-		"#version 140\r\n",
-		"#extension GL_ARB_explicit_uniform_location : enable\r\n",
-		"#extension GL_ARB_explicit_attrib_location : enable\r\n",
-		"#extension GL_ARB_shader_subroutine : enable\r\n",
-		"#extension GL_ARB_vertex_array_object : enable\r\n"
-		"#define M_PI 3.1415926535897932384626433832795\r\n",
-		"#define PI 3.1415926535897932384626433832795\r\n",
+		shader_prelude,
 		s_source.c_str()
 	};
-	glShaderSource(return_value, 7, texts, nullptr);
+	glShaderSource(return_value, 2, texts, nullptr);
 	glCompileShader(return_value);
 
 	GLint result;
@@ -72,11 +78,112 @@ GLint compile_shader(std::string_view source, GLenum type) {
 	return return_value;
 }
 
+/*
+Some drivers take seconds to compile and link all of the programs, so the linked programs are cached on disk. A program binary
+is only good for the driver that produced it, so the key covers the vendor, renderer and version strings of the driver along
+with the complete sources. The driver may still reject a binary (after an update that left the version string alone, say), in
+which case the program is compiled from source as if there had been no cache file.
+*/
+namespace {
+
+bool program_binaries_supported() {
+	if(!(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+		return false;
+	GLint format_count = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+	return format_count > 0;
+}
+
+sys::checksum_key program_cache_key(std::string_view vertex_shader, std::string_view fragment_shader) {
+	std::string key_source;
+	for(auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		if(auto str = reinterpret_cast<char const*>(glGetString(name)); str)
+			key_source += str;
+		key_source += '\n';
+	}
+	key_source += shader_prelude;
+	key_source += vertex_shader;
+	key_source += '\0';
+	key_source += fragment_shader;
+
+	sys::checksum_key key;
+	blake2b(&key, sizeof(key), key_source.data(), key_source.size(), nullptr, 0);
+	return key;
+}
+
+native_string program_cache_file_name(sys::checksum_key const& key) {
+	std::string file_name = "program_";
+	for(uint32_t i = 0; i < 8; ++i) {
+		char const* digits = "0123456789abcdef";
+		file_name += digits[key.key[i] >> 4];
+		file_name += digits[key.key[i] & 0x0F];
+	}
+	file_name += ".bin";
+	return simple_fs::utf8_to_native(file_name);
+}
+
+// a cache file holds the full key, then the binary format, then the binary itself
+GLuint load_cached_program(sys::checksum_key const& key) {
+	auto cache_dir = simple_fs::get_or_create_shader_cache_directory();
+	auto f = simple_fs::open_file(cache_dir, program_cache_file_name(key));
+	if(!f)
+		return 0;
+	auto contents = simple_fs::view_contents(*f);
+	if(contents.file_size <= sizeof(key) + sizeof(GLenum) || std::memcmp(contents.data, key.key, sizeof(key)) != 0)
+		return 0;
+	GLenum format = 0;
+	std::memcpy(&format, contents.data + sizeof(key), sizeof(GLenum));
+	auto binary = contents.data + sizeof(key) + sizeof(GLenum);
+	auto binary_size = GLsizei(contents.file_size - sizeof(key) - sizeof(GLenum));
+
+	GLuint program = glCreateProgram();
+	if(program == 0)
+		return 0;
+	glProgramBinary(program, format, binary, binary_size);
+	GLint result = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &result);
+	if(result == GL_FALSE) {
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+void store_cached_program(sys::checksum_key const& key, GLuint program) {
+	GLint binary_size = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+	if(binary_size <= 0)
+		return;
+	std::string file_data(sizeof(key) + sizeof(GLenum) + size_t(binary_size), '\0');
+	std::memcpy(file_data.data(), key.key, sizeof(key));
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(program, binary_size, &written, &format, file_data.data() + sizeof(key) + sizeof(GLenum));
+	if(written <= 0)
+		return;
+	std::memcpy(file_data.data() + sizeof(key), &format, sizeof(GLenum));
+	file_data.resize(sizeof(key) + sizeof(GLenum) + size_t(written));
+	auto cache_dir = simple_fs::get_or_create_shader_cache_directory();
+	simple_fs::write_file(cache_dir, program_cache_file_name(key), file_data.data(), uint32_t(file_data.size()));
+}
+
+}
+
 GLuint create_program(std::string_view vertex_shader, std::string_view fragment_shader) {
+	bool use_cache = program_binaries_supported();
+	sys::checksum_key cache_key;
+	if(use_cache) {
+		cache_key = program_cache_key(vertex_shader, fragment_shader);
+		if(auto cached = load_cached_program(cache_key); cached != 0)
+			return cached;
+	}
+
 	GLuint return_value = glCreateProgram();
 	if(return_value == 0) {
 		notify_user_of_fatal_opengl_error("program creation failed");
 	}
+	if(use_cache)
+		glProgramParameteri(return_value, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 	auto v_shader = compile_shader(vertex_shader, GL_VERTEX_SHADER);
 	auto f_shader = compile_shader(fragment_shader, GL_FRAGMENT_SHADER);
@@ -95,6 +202,8 @@ GLuint create_program(std::string_view vertex_shader, std::string_view fragment_
 		GLsizei written;
 		glGetProgramInfoLog(return_value, logLen, &written, log);
 		notify_user_of_fatal_opengl_error(std::string("Program failed to link:\n") + log);
+	} else if(use_cache) {
+		store_cached_program(cache_key, return_value);
 	}
 
 	glDeleteShader(v_shader);
@@ -285,6 +394,117 @@ void deinitialize_msaa(sys::state& state) {
 	glDisable(GL_MULTISAMPLE);
 }
 
+namespace {
+// the contribution of the latest frame to the smoothed frame timings
+constexpr float frame_timing_weight = 0.05f;
+}
+
+void frame_profiler::begin_frame() {
+	in_frame = enabled;
+	if(!in_frame)
+		return;
+
+	if(!created) {
+		created = true;
+		supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+		if(supported)
+			glGenQueries(GLsizei(frames_in_flight * (gpu_pass_count + 1)), &queries[0][0]);
+	}
+	if(!supported)
+		return;
+
+	auto slot = frame % frames_in_flight;
+	collect(slot);
+	glQueryCounter(queries[slot][0], GL_TIMESTAMP);
+	issued[slot] = 1;
+}
+
+void frame_profiler::end_pass(gpu_pass p) {
+	if(!in_frame || !supported)
+		return;
+	auto slot = frame % frames_in_flight;
+	glQueryCounter(queries[slot][p + 1], GL_TIMESTAMP);
+	issued[slot] |= uint32_t(1) << (p + 1);
+}
+
+void frame_profiler::record_cpu(cpu_stage s, int64_t microseconds) {
+	if(!in_frame)
+		return;
+	cpu_stage_ms[s] += (float(microseconds) / 1000.0f - cpu_stage_ms[s]) * frame_timing_weight;
+}
+
+void frame_profiler::end_frame() {
+	if(in_frame)
+		++frame;
+	in_frame = false;
+}
+
+void frame_profiler::collect(int32_t slot) {
+	if(issued[slot] == 0)
+		return;
+
+	// the queries complete in order, so once the last one issued is available all of them are
+	int32_t last = 0;
+	for(int32_t i = 0; i <= int32_t(gpu_pass_count); ++i) {
+		if((issued[slot] & (uint32_t(1) << i)) != 0)
+			last = i;
+	}
+	GLint available = 0;
+	glGetQueryObjectiv(queries[slot][last], GL_QUERY_RESULT_AVAILABLE, &available);
+	if(!available) {
+		issued[slot] = 0; // the queries are about to be reissued, so this frame goes unmeasured
+		return;
+	}
+
+	GLuint64 previous = 0;
+	glGetQueryObjectui64v(queries[slot][0], GL_QUERY_RESULT, &previous);
+	for(int32_t i = 0; i < int32_t(gpu_pass_count); ++i) {
+		float ms = 0.0f;
+		if((issued[slot] & (uint32_t(1) << (i + 1))) != 0) {
+			GLuint64 timestamp = 0;
+			glGetQueryObjectui64v(queries[slot][i + 1], GL_QUERY_RESULT, &timestamp);
+			ms = float(timestamp - previous) / 1000000.0f;
+			previous = timestamp;
+		}
+		gpu_pass_ms[i] += (ms - gpu_pass_ms[i]) * frame_timing_weight;
+	}
+	issued[slot] = 0;
+}
+
+char const* frame_profiler::name(gpu_pass p) {
+	switch(p) {
+	case map_terrain:
+		return "map terrain";
+	case map_rivers_and_railroads:
+		return "map rivers and railroads";
+	case map_borders:
+		return "map borders";
+	case map_unit_arrows:
+		return "map unit arrows";
+	case map_text:
+		return "map text";
+	case map_resolve:
+		return "map msaa resolve";
+	case ui:
+		return "ui";
+	default:
+		return "";
+	}
+}
+
+char const* frame_profiler::name(cpu_stage s) {
+	switch(s) {
+	case ui_update:
+		return "ui update";
+	case map_submission:
+		return "map draw calls";
+	case ui_submission:
+		return "ui draw calls";
+	default:
+		return "";
+	}
+}
+
 void initialize_opengl(sys::state& state) {
 	create_opengl_context(state);
 
@@ -440,6 +660,7 @@ void load_global_squares(sys::state& state) {
 	glEnableVertexAttribArray(1); // texture coordinates
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+	state.open_gl.bound_square_vertices = state.open_gl.global_square_buffer;
 
 	glVertexAttribFormat(0, 2, GL_FLOAT, GL_FALSE, 0);									 // position
 	glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 2); // texture coordinates
@@ -515,25 +736,33 @@ inline auto map_color_modification_to_index(color_modification e) {
 	}
 }
 
+// global_square_vao must be bound
+void bind_square_vertices(sys::state const& state, GLuint buffer) {
+	if(state.open_gl.bound_square_vertices == buffer)
+		return;
+	glBindVertexBuffer(0, buffer, 0, sizeof(GLfloat) * 4);
+	state.open_gl.bound_square_vertices = buffer;
+}
+
 void bind_vertices_by_rotation(sys::state const& state, ui::rotation r, bool flipped, bool rtl) {
 	switch(r) {
 	case ui::rotation::upright:
 		if(!flipped)
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_buffer : state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_buffer : state.open_gl.global_square_buffer);
 		else
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_flipped_buffer : state.open_gl.global_square_flipped_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_flipped_buffer : state.open_gl.global_square_flipped_buffer);
 		break;
 	case ui::rotation::r90_left:
 		if(!flipped)
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_left_buffer: state.open_gl.global_square_left_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_left_buffer: state.open_gl.global_square_left_buffer);
 		else
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_left_flipped_buffer : state.open_gl.global_square_left_flipped_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_left_flipped_buffer : state.open_gl.global_square_left_flipped_buffer);
 		break;
 	case ui::rotation::r90_right:
 		if(!flipped)
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_right_buffer : state.open_gl.global_square_right_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_right_buffer : state.open_gl.global_square_right_buffer);
 		else
-			glBindVertexBuffer(0, rtl ? state.open_gl.global_rtl_square_right_flipped_buffer : state.open_gl.global_square_right_flipped_buffer, 0, sizeof(GLfloat) * 4);
+			bind_square_vertices(state, rtl ? state.open_gl.global_rtl_square_right_flipped_buffer : state.open_gl.global_square_right_flipped_buffer);
 		break;
 	}
 }
@@ -572,7 +801,7 @@ void render_textured_rect(sys::state const& state, color_modification enabled, f
 void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle) {
 	glBindVertexArray(state.open_gl.global_square_vao);
 
-	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+	bind_square_vertices(state, state.open_gl.global_square_buffer);
 
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
 
@@ -591,6 +820,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
+	state.open_gl.bound_square_vertices = 0; // bound to the graph's own buffer
 
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
 	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::linegraph };
@@ -621,6 +851,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
+	state.open_gl.bound_square_vertices = 0; // bound to the graph's own buffer
 
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
 	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::linegraph_color };
@@ -659,7 +890,7 @@ void render_barchart(sys::state const& state, color_modification enabled, float
 void render_piechart(sys::state const& state, color_modification enabled, float x, float y, float size, data_texture& t) {
 	glBindVertexArray(state.open_gl.global_square_vao);
 
-	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+	bind_square_vertices(state, state.open_gl.global_square_buffer);
 
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, size, size);
 
@@ -950,6 +1181,10 @@ void internal_text_render(sys::state& state, text::stored_glyphs const& txt, flo
 	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, subroutines[0], subroutines[1]);
 	//glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
 
+	glBindVertexArray(state.open_gl.global_square_vao);
+	// consecutive glyphs mostly come from the same texture of the font, so it is only rebound when it changes
+	glActiveTexture(GL_TEXTURE0);
+	GLuint bound_texture = 0;
 	unsigned int glyph_count = static_cast<unsigned int>(txt.glyph_info.size());
 	for(unsigned int i = 0; i < glyph_count; i++) {
 		hb_codepoint_t glyphid = txt.glyph_info[i].codepoint;
@@ -957,11 +1192,13 @@ void internal_text_render(sys::state& state, text::stored_glyphs const& txt, flo
 		float x_advance = float(txt.glyph_info[i].x_advance) / (float((1 << 6) * text::magnification_factor));
 		float x_offset = float(txt.glyph_info[i].x_offset) / (float((1 << 6) * text::magnification_factor)) + float(gso.x);
 		float y_offset = float(gso.y) - float(txt.glyph_info[i].y_offset) / (float((1 << 6) * text::magnification_factor));
-		glBindVertexBuffer(0, state.open_gl.sub_square_buffers[gso.texture_slot & 63], 0, sizeof(GLfloat) * 4);
+		bind_square_vertices(state, state.open_gl.sub_square_buffers[gso.texture_slot & 63]);
 		assert(uint32_t(gso.texture_slot >> 6) < f.textures.size());
 		assert(f.textures[gso.texture_slot >> 6]);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, f.textures[gso.texture_slot >> 6]);
+		if(f.textures[gso.texture_slot >> 6] != bound_texture) {
+			bound_texture = f.textures[gso.texture_slot >> 6];
+			glBindTexture(GL_TEXTURE_2D, bound_texture);
+		}
 		glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x + x_offset * size / 64.f, baseline_y + y_offset * size / 64.f, size, size);
 		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 		x += x_advance * size / 64.f;
@@ -192,6 +192,55 @@ inline void debug_callback(GLenum source, GLenum type, GLuint id, GLenum severit
 }
 #endif
 
+// Times the parts of each frame, on the gpu with timestamp queries and on the cpu with the steady clock, while enabled. The
+// query results are only read back frames_in_flight frames later, when they are available, so that collecting them never
+// stalls the pipeline; the times reported are smoothed over the recent frames.
+class frame_profiler {
+public:
+	enum gpu_pass : uint8_t {
+		map_terrain, map_rivers_and_railroads, map_borders, map_unit_arrows, map_text, map_resolve, ui, gpu_pass_count
+	};
+	enum cpu_stage : uint8_t {
+		ui_update, map_submission, ui_submission, cpu_stage_count
+	};
+	static constexpr int32_t frames_in_flight = 4;
+
+	bool enabled = false;
+
+	// the gpu passes of a frame must be ended in order; a pass that is skipped in a frame counts as taking no time
+	void begin_frame();
+	void end_pass(gpu_pass p);
+	void record_cpu(cpu_stage s, int64_t microseconds);
+	void end_frame();
+
+	bool active() const {
+		return in_frame;
+	}
+	bool gpu_timers_supported() const {
+		return supported;
+	}
+	float gpu_ms(gpu_pass p) const {
+		return gpu_pass_ms[p];
+	}
+	float cpu_ms(cpu_stage s) const {
+		return cpu_stage_ms[s];
+	}
+	static char const* name(gpu_pass p);
+	static char const* name(cpu_stage s);
+
+private:
+	void collect(int32_t slot);
+
+	GLuint queries[frames_in_flight][gpu_pass_count + 1] = { };
+	uint32_t issued[frames_in_flight] = { }; // bit i + 1 is set once pass i has been ended, bit 0 for the start of the frame
+	float gpu_pass_ms[gpu_pass_count] = { };
+	float cpu_stage_ms[cpu_stage_count] = { };
+	int32_t frame = 0;
+	bool created = false;
+	bool supported = false;
+	bool in_frame = false;
+};
+
 struct data {
 	tagged_vector<texture, dcon::texture_id> asset_textures;
 
@@ -226,6 +275,9 @@ struct data {
 	GLuint global_rtl_square_left_flipped_buffer = 0;
 
 	GLuint sub_square_buffers[64] = {0};
+	// the buffer last bound to binding 0 of global_square_vao (through bind_square_vertices), so that the many consecutive
+	// ui draws sharing an orientation don't rebind it each time
+	mutable GLuint bound_square_vertices = 0;
 
 	GLuint money_icon_tex = 0;
 	GLuint cross_icon_tex = 0;
@@ -245,6 +297,8 @@ struct data {
 	GLuint msaa_uniform_screen_size = 0;
 	GLuint msaa_uniform_gaussian_blur = 0;
 	bool msaa_enabled = false;
+
+	frame_profiler frame_timings; // see the frame-profile console command
 };
 
 void notify_user_of_fatal_opengl_error(std::string message);
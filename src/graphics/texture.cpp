@@ -368,52 +368,92 @@ GLuint texture::get_texture_handle() const {
 	return texture_handle;
 }
 
+GLuint load_dds_and_return_handle(uint8_t const* content, uint32_t content_size, texture& asset_texture, bool keep_data) {
+	uint32_t w = 0;
+	uint32_t h = 0;
+	asset_texture.texture_handle = SOIL_direct_load_DDS_from_memory(content, content_size, w, h, 0);
+
+	if(asset_texture.texture_handle) {
+		asset_texture.channels = 4;
+		asset_texture.size_x = int32_t(w);
+		asset_texture.size_y = int32_t(h);
+		asset_texture.loaded = true;
+
+		if(keep_data) {
+			asset_texture.data = static_cast<uint8_t*>(STBI_MALLOC(4 * w * h));
+			glGetTextureImage(asset_texture.texture_handle, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<int32_t>(4 * w * h),
+				asset_texture.data);
+		}
+	}
+	return asset_texture.texture_handle;
+}
+
+GLuint upload_data_and_return_handle(texture& asset_texture, bool keep_data) {
+	asset_texture.channels = 4;
+	asset_texture.loaded = true;
+
+	glGenTextures(1, &asset_texture.texture_handle);
+	if(asset_texture.texture_handle) {
+		glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, asset_texture.size_x, asset_texture.size_y);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, asset_texture.size_x, asset_texture.size_y, GL_RGBA, GL_UNSIGNED_BYTE,
+				asset_texture.data);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	if(!keep_data) {
+		STBI_FREE(asset_texture.data);
+		asset_texture.data = nullptr;
+	}
+
+	return asset_texture.texture_handle;
+}
+
+native_string dds_file_name(native_string const& native_name) {
+	auto dds_name = native_name;
+	if(auto pos = dds_name.find_last_of('.'); pos != native_string::npos) {
+		dds_name[pos + 1] = NATIVE('d');
+		dds_name[pos + 2] = NATIVE('d');
+		dds_name[pos + 3] = NATIVE('s');
+		dds_name.resize(pos + 4);
+	}
+	return dds_name;
+}
+
+native_string png_file_name(native_string const& native_name) {
+	auto png_name = native_name;
+	if(auto pos = png_name.find_last_of('.'); pos != native_string::npos) {
+		png_name[pos + 1] = NATIVE('p');
+		png_name[pos + 2] = NATIVE('n');
+		png_name[pos + 3] = NATIVE('g');
+		png_name.resize(pos + 4);
+	}
+	return png_name;
+}
+
 GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs, texture& asset_texture, bool keep_data) {
 	auto name_length = native_name.length();
 
 	auto root = get_root(fs);
 	if(name_length > 4) { // try loading as a dds
-		auto dds_name = native_name;
-		if(auto pos = dds_name.find_last_of('.'); pos != native_string::npos) {
-			dds_name[pos + 1] = NATIVE('d');
-			dds_name[pos + 2] = NATIVE('d');
-			dds_name[pos + 3] = NATIVE('s');
-			dds_name.resize(pos + 4);
-		}
-		auto file = open_file(root, dds_name);
+		auto file = open_file(root, dds_file_name(native_name));
 		if(file) {
 			auto content = simple_fs::view_contents(*file);
-
-			uint32_t w = 0;
-			uint32_t h = 0;
-			asset_texture.texture_handle = SOIL_direct_load_DDS_from_memory(reinterpret_cast<uint8_t const*>(content.data), content.file_size, w, h, 0);
-
-			if(asset_texture.texture_handle) {
-				asset_texture.channels = 4;
-				asset_texture.size_x = int32_t(w);
-				asset_texture.size_y = int32_t(h);
-				asset_texture.loaded = true;
-
-				if(keep_data) {
-					asset_texture.data = static_cast<uint8_t*>(STBI_MALLOC(4 * w * h));
-					glGetTextureImage(asset_texture.texture_handle, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<int32_t>(4 * w * h),
-						asset_texture.data);
-				}
+			if(load_dds_and_return_handle(reinterpret_cast<uint8_t const*>(content.data), content.file_size, asset_texture, keep_data))
 				return asset_texture.texture_handle;
-			}
 		}
 	}
 
 	auto file = open_file(root, native_name);
 	if(!file && name_length > 4) {
-		auto png_name = native_name;
-		if(auto pos = png_name.find_last_of('.'); pos != native_string::npos) {
-			png_name[pos + 1] = NATIVE('p');
-			png_name[pos + 2] = NATIVE('n');
-			png_name[pos + 3] = NATIVE('g');
-			png_name.resize(pos + 4);
-		}
-		file = open_file(root, png_name);
+		file = open_file(root, png_file_name(native_name));
 	}
 	if(file) {
 		auto content = simple_fs::view_contents(*file);
@@ -423,34 +463,63 @@ GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::
 		asset_texture.data = stbi_load_from_memory(reinterpret_cast<uint8_t const*>(content.data), int32_t(content.file_size),
 			&(asset_texture.size_x), &(asset_texture.size_y), &file_channels, 4);
 
-		asset_texture.channels = 4;
-		asset_texture.loaded = true;
-
-		glGenTextures(1, &asset_texture.texture_handle);
-		if(asset_texture.texture_handle) {
-			glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
-
-			glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, asset_texture.size_x, asset_texture.size_y);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, asset_texture.size_x, asset_texture.size_y, GL_RGBA, GL_UNSIGNED_BYTE,
-					asset_texture.data);
-
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return upload_data_and_return_handle(asset_texture, keep_data);
+	}
+	asset_texture.loaded = true; // because we tried to load it (and failed) and trying again will be wasteful
+	return 0;
+}
 
-			glBindTexture(GL_TEXTURE_2D, 0);
+void prefetch_textures(sys::state& state, std::vector<texture_request> const& requests) {
+	struct prefetched_file {
+		std::vector<uint8_t> dds_content; // dds files are decoded while uploading them, so only their contents are read here
+		uint8_t* data = nullptr;
+		int32_t size_x = 0;
+		int32_t size_y = 0;
+	};
+
+	std::vector<texture_request> pending;
+	for(auto& r : requests) {
+		if(r.id && !state.open_gl.asset_textures[r.id].loaded
+			&& std::find_if(pending.begin(), pending.end(), [&](texture_request const& p) { return p.id == r.id; }) == pending.end()) {
+			pending.push_back(r);
 		}
-
-		if(!keep_data) {
-			STBI_FREE(asset_texture.data);
-			asset_texture.data = nullptr;
+	}
+	std::vector<prefetched_file> files(pending.size());
+
+	auto root = get_root(state.common_fs);
+	concurrency::parallel_for(0, int32_t(pending.size()), [&](int32_t i) {
+		auto native_name = simple_fs::win1250_to_native(state.to_string_view(state.ui_defs.textures[pending[i].id]));
+		if(native_name.length() > 4) {
+			if(auto file = open_file(root, dds_file_name(native_name)); file) {
+				auto content = simple_fs::view_contents(*file);
+				files[i].dds_content.assign(reinterpret_cast<uint8_t const*>(content.data), reinterpret_cast<uint8_t const*>(content.data) + content.file_size);
+				return;
+			}
+		}
+		auto file = open_file(root, native_name);
+		if(!file && native_name.length() > 4) {
+			file = open_file(root, png_file_name(native_name));
+		}
+		if(file) {
+			auto content = simple_fs::view_contents(*file);
+			int32_t file_channels = 4;
+			files[i].data = stbi_load_from_memory(reinterpret_cast<uint8_t const*>(content.data), int32_t(content.file_size),
+				&(files[i].size_x), &(files[i].size_y), &file_channels, 4);
+		}
+	});
+
+	// anything that couldn't be read or decoded here is left to be loaded (or to fail) the usual way when it is first drawn
+	for(size_t i = 0; i < pending.size(); ++i) {
+		auto& asset_texture = state.open_gl.asset_textures[pending[i].id];
+		if(!files[i].dds_content.empty()) {
+			load_dds_and_return_handle(files[i].dds_content.data(), uint32_t(files[i].dds_content.size()), asset_texture, pending[i].keep_data);
+		} else if(files[i].data) {
+			asset_texture.data = files[i].data;
+			asset_texture.size_x = files[i].size_x;
+			asset_texture.size_y = files[i].size_y;
+			upload_data_and_return_handle(asset_texture, pending[i].keep_data);
 		}
-
-		return asset_texture.texture_handle;
 	}
-	asset_texture.loaded = true; // because we tried to load it (and failed) and trying again will be wasteful
-	return 0;
 }
 
 native_string flag_type_to_name(sys::state& state, culture::flag_type type) {
@@ -547,8 +616,9 @@ GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, cul
 		masq_nat_id = nat_id;
 	}
 
+	auto const first_id = state.ui_defs.textures.size() + (1 + masq_nat_id.id.index()) * state.flag_types.size();
 	auto const offset = culture::get_remapped_flag_type(state, type);
-	dcon::texture_id id = dcon::texture_id{ dcon::texture_id::value_base_t(state.ui_defs.textures.size() + (1 + masq_nat_id.id.index()) * state.flag_types.size() + offset) };
+	dcon::texture_id id = dcon::texture_id{ dcon::texture_id::value_base_t(first_id + offset) };
 	if(state.open_gl.asset_textures[id].loaded) {
 		return state.open_gl.asset_textures[id].texture_handle;
 	} else { // load from file
@@ -563,12 +633,29 @@ GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, cul
 		GLuint p_tex = load_file_and_return_handle(file_str + NATIVE(".png"), state.common_fs, state.open_gl.asset_textures[id], false);
 		if(!p_tex) {
 			p_tex = load_file_and_return_handle(file_str + NATIVE(".tga"), state.common_fs, state.open_gl.asset_textures[id], false);
-			if(!p_tex) {
-				p_tex = load_file_and_return_handle(default_file_str + NATIVE(".png"), state.common_fs, state.open_gl.asset_textures[id], false);
-				if(!p_tex) {
-					return load_file_and_return_handle(default_file_str + NATIVE(".tga"), state.common_fs, state.open_gl.asset_textures[id], false);
-				}
+		}
+		if(!p_tex) {
+			/*
+			Most nations only have flags for a few of the flag types, and the rest fall back to the default flag. Rather
+			than loading another copy of the default flag for each of those types, they share the texture of the default
+			flag's own slot (the default flag type is always remapped to offset 0).
+			*/
+			dcon::texture_id default_id = dcon::texture_id{ dcon::texture_id::value_base_t(first_id) };
+			auto& d = state.open_gl.asset_textures[default_id];
+			if(default_id == id || !d.loaded) {
+				p_tex = load_file_and_return_handle(default_file_str + NATIVE(".png"), state.common_fs, d, false);
+				if(!p_tex)
+					p_tex = load_file_and_return_handle(default_file_str + NATIVE(".tga"), state.common_fs, d, false);
+			}
+			if(default_id != id) {
+				auto& t = state.open_gl.asset_textures[id];
+				t.texture_handle = d.texture_handle;
+				t.size_x = d.size_x;
+				t.size_y = d.size_y;
+				t.channels = d.channels;
+				t.loaded = true;
 			}
+			p_tex = d.texture_handle;
 		}
 		return p_tex;
 	}
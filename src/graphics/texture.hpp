@@ -15,6 +15,18 @@ GLuint get_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data
 native_string flag_type_to_name(sys::state& state, culture::flag_type type);
 GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, culture::flag_type type);
 GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs, texture& asset_texture, bool keep_data);
+GLuint load_dds_and_return_handle(uint8_t const* content, uint32_t content_size, texture& asset_texture, bool keep_data);
+// uploads the rgba pixels already stored in the texture's data
+GLuint upload_data_and_return_handle(texture& asset_texture, bool keep_data);
+
+struct texture_request {
+	dcon::texture_id id;
+	bool keep_data = false;
+};
+// Reads and decodes the files of those textures that aren't loaded yet in parallel and then uploads them, so that a window
+// opened for the first time doesn't have to load its textures one by one while it is being drawn. Must be called from the
+// thread that owns the gl context.
+void prefetch_textures(sys::state& state, std::vector<texture_request> const& requests);
 
 enum {
 	SOIL_FLAG_TEXTURE_REPEATS = 4,
@@ -47,6 +59,8 @@ public:
 	friend GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs,
 			texture& asset_texture, bool keep_data);
 	friend GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, culture::flag_type type);
+	friend GLuint load_dds_and_return_handle(uint8_t const* content, uint32_t content_size, texture& asset_texture, bool keep_data);
+	friend GLuint upload_data_and_return_handle(texture& asset_texture, bool keep_data);
 };
 
 class data_texture {
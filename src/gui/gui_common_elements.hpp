@@ -1760,7 +1760,7 @@ class factory_priority_image : public image_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
 		auto content = retrieve<dcon::factory_id>(state, parent);
-		frame = economy::factory_priority(state, content);
+		frame = command::predicted_factory_priority(state, content);
 	}
 };
 
@@ -95,6 +95,424 @@ int32_t* f_fps(fif::state_stack& s, int32_t* p, fif::environment* e) {
 	return p + 2;
 }
 
+int32_t* f_tick_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(!state->ui_state.tick_profiler_overlay) {
+		auto overlay = ui::make_element_by_type<ui::tick_profiler_overlay>(*state, "tick_profiler_overlay");
+		state->ui_state.tick_profiler_overlay = overlay.get();
+		state->ui_state.root->add_child_to_front(std::move(overlay));
+	}
+
+	if(s.main_data_back(0) != 0) {
+		state->tick_timings.clear();
+		state->tick_timings.enabled.store(true, std::memory_order::release);
+		state->ui_state.tick_profiler_overlay->set_visible(*state, true);
+		state->ui_state.root->move_child_to_front(state->ui_state.tick_profiler_overlay);
+	} else {
+		state->tick_timings.enabled.store(false, std::memory_order::release);
+		state->ui_state.tick_profiler_overlay->set_visible(*state, false);
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_frame_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(!state->ui_state.frame_profiler_overlay) {
+		auto overlay = ui::make_element_by_type<ui::frame_profiler_overlay>(*state, "frame_profiler_overlay");
+		state->ui_state.frame_profiler_overlay = overlay.get();
+		state->ui_state.root->add_child_to_front(std::move(overlay));
+	}
+
+	if(s.main_data_back(0) != 0) {
+		state->open_gl.frame_timings.enabled = true;
+		state->ui_state.frame_profiler_overlay->set_visible(*state, true);
+		state->ui_state.root->move_child_to_front(state->ui_state.frame_profiler_overlay);
+	} else {
+		state->open_gl.frame_timings.enabled = false;
+		state->ui_state.frame_profiler_overlay->set_visible(*state, false);
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_dump_tick_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto csv = state->tick_timings.to_csv(*state);
+	simple_fs::write_file(simple_fs::get_or_create_data_dumps_directory(), NATIVE("tick_profile.csv"), csv.c_str(), uint32_t(csv.size()));
+	log_to_console(*state, state->ui_state.console_window, "✔");
+
+	return p + 2;
+}
+
+int32_t* f_record_replay(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool start = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	if(start) {
+		std::lock_guard l{ state->ugly_ui_game_interaction_hack };
+		state->replay_recording.start(*state);
+		log_to_console(*state, state->ui_state.console_window, "Recording started");
+	} else if(state->replay_recording.recording()) {
+		sys::replay r;
+		{
+			std::lock_guard l{ state->ugly_ui_game_interaction_hack };
+			r = state->replay_recording.stop(*state);
+		}
+		auto data = r.serialize();
+		simple_fs::write_file(simple_fs::get_or_create_data_dumps_directory(), NATIVE("replay.bin"), reinterpret_cast<char const*>(data.data()), uint32_t(data.size()));
+		log_to_console(*state, state->ui_state.console_window, "Recorded " + std::to_string(r.commands.size()) + " commands ✔");
+	} else {
+		log_to_console(*state, state->ui_state.console_window, "Not recording");
+	}
+
+	return p + 2;
+}
+
+int32_t* f_net_stats(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(state->network_mode != sys::network_mode_type::host) {
+		log_to_console(*state, state->ui_state.console_window, "Only the host keeps network statistics");
+		s.pop_main();
+		return p + 2;
+	}
+
+	if(!state->ui_state.network_telemetry_overlay) {
+		auto overlay = ui::make_element_by_type<ui::network_telemetry_overlay>(*state, "network_telemetry_overlay");
+		state->ui_state.network_telemetry_overlay = overlay.get();
+		state->ui_state.root->add_child_to_front(std::move(overlay));
+	}
+
+	if(s.main_data_back(0) != 0) {
+		state->ui_state.network_telemetry_overlay->set_visible(*state, true);
+		state->ui_state.root->move_child_to_front(state->ui_state.network_telemetry_overlay);
+	} else {
+		state->ui_state.network_telemetry_overlay->set_visible(*state, false);
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_dump_net_stats(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	for(auto& line : network::describe_client_telemetry(*state))
+		log_to_console(*state, state->ui_state.console_window, line);
+
+	return p + 2;
+}
+
+int32_t* f_script_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(s.main_data_back(0) != 0) {
+		if(!state->script_timings.enabled.load(std::memory_order::acquire)) {
+			state->script_timings.reset(state->trigger_data_indices.size(), state->effect_data_indices.size());
+			state->script_timings.enabled.store(true, std::memory_order::release);
+		}
+	} else {
+		state->script_timings.enabled.store(false, std::memory_order::release);
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_dump_script_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	for(auto& k : state->script_timings.top_keys(*state, 10)) {
+		log_to_console(*state, state->ui_state.console_window, std::string(k.is_effect ? "effect " : "trigger ") + std::to_string(k.key) + ": "
+			+ std::to_string(k.nanoseconds / 1000000) + "ms in " + std::to_string(k.calls) + " calls (" + k.used_by + ")");
+	}
+	auto csv = state->script_timings.to_csv(*state);
+	simple_fs::write_file(simple_fs::get_or_create_data_dumps_directory(), NATIVE("script_profile.csv"), csv.c_str(), uint32_t(csv.size()));
+	log_to_console(*state, state->ui_state.console_window, "✔");
+
+	return p + 2;
+}
+
+int32_t* f_ai_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(s.main_data_back(0) != 0) {
+		if(!state->ai_timings.enabled.load(std::memory_order::acquire)) {
+			state->ai_timings.reset(state->world.nation_size());
+			state->ai_timings.enabled.store(true, std::memory_order::release);
+		}
+	} else {
+		state->ai_timings.enabled.store(false, std::memory_order::release);
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_dump_ai_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto tag_of = [&](int32_t nation) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(nation) };
+		return nations::int_to_tag(state->world.national_identity_get_identifying_int(state->world.nation_get_identity_from_identity_holder(n)));
+	};
+	for(auto& n : state->ai_timings.top_nations(10)) {
+		log_to_console(*state, state->ui_state.console_window, tag_of(n.nation) + ": " + std::to_string(n.nanoseconds / 1000000) + "ms");
+	}
+	for(auto& k : state->ai_timings.top_entries(10)) {
+		log_to_console(*state, state->ui_state.console_window, tag_of(k.nation) + " " + sys::ai_profiler::task_name(k.t) + ": "
+			+ std::to_string(k.nanoseconds / 1000000) + "ms in " + std::to_string(k.calls) + " calls");
+	}
+	auto csv = state->ai_timings.to_csv(*state);
+	simple_fs::write_file(simple_fs::get_or_create_data_dumps_directory(), NATIVE("ai_profile.csv"), csv.c_str(), uint32_t(csv.size()));
+	log_to_console(*state, state->ui_state.console_window, "✔");
+
+	return p + 2;
+}
+
+int32_t* f_sample_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	if(s.main_data_back(0) != 0) {
+		if(state->stack_samples.start(std::chrono::microseconds(1000)))
+			log_to_console(*state, state->ui_state.console_window, "Sampling started");
+		else
+			log_to_console(*state, state->ui_state.console_window, "Sampling is not available");
+	} else if(state->stack_samples.running()) {
+		state->stack_samples.stop();
+		auto folded = state->stack_samples.to_folded();
+		simple_fs::write_file(simple_fs::get_or_create_data_dumps_directory(), NATIVE("sample_profile.folded"), folded.c_str(), uint32_t(folded.size()));
+		log_to_console(*state, state->ui_state.console_window, std::to_string(state->stack_samples.sample_count()) + " samples ✔");
+	}
+
+	s.pop_main();
+	return p + 2;
+}
+
+int32_t* f_memory_report(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	size_t total = 0;
+	for(auto& entry : sys::describe_memory_usage(*state)) {
+		log_to_console(*state, state->ui_state.console_window, std::string(entry.name) + ": " + std::to_string(entry.bytes / 1024) + " KB");
+		total += entry.bytes;
+	}
+	log_to_console(*state, state->ui_state.console_window, "total: " + std::to_string(total / 1024) + " KB");
+
+	return p + 2;
+}
+
+// Times repetitions of a piece of the simulation and logs the mean and 99th percentile. The game thread is held off for the
+// duration, so that the benchmarked code sees the same state on every repetition.
+template<typename F>
+void run_benchmark(sys::state& state, std::string_view name, int32_t repetitions, F&& f) {
+	if(repetitions <= 0) {
+		log_to_console(state, state.ui_state.console_window, "The repetition count must be positive");
+		return;
+	}
+	std::vector<int64_t> times(repetitions);
+	{
+		std::lock_guard l{ state.ugly_ui_game_interaction_hack };
+		for(int32_t i = 0; i < repetitions; ++i) {
+			auto start = std::chrono::steady_clock::now();
+			f(i);
+			times[i] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+	int64_t total = 0;
+	for(auto t : times)
+		total += t;
+	std::sort(times.begin(), times.end());
+	auto p99 = times[std::min(size_t(repetitions) - 1, size_t(repetitions) * 99 / 100)];
+	log_to_console(state, state.ui_state.console_window, std::string(name) + ": mean " + std::to_string(total / repetitions) + "us, p99 "
+		+ std::to_string(p99) + "us over " + std::to_string(repetitions) + " runs");
+}
+
+int32_t* f_bench_paths(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto repetitions = int32_t(s.main_data_back(0));
+	s.pop_main();
+
+	std::vector<dcon::province_id> land_provinces;
+	province::for_each_land_province(*state, [&](dcon::province_id id) { land_provinces.push_back(id); });
+	if(land_provinces.empty())
+		return p + 2;
+
+	// the province pairs come from the game's own generator, so the same save always benchmarks the same paths
+	run_benchmark(*state, "make_land_path", repetitions, [&](int32_t i) {
+		auto from = land_provinces[rng::get_random(*state, uint32_t(i), 0) % land_provinces.size()];
+		auto to = land_provinces[rng::get_random(*state, uint32_t(i), 1) % land_provinces.size()];
+		province::make_land_path(*state, from, to, state->local_player_nation, dcon::army_id{});
+	});
+
+	return p + 2;
+}
+
+int32_t* f_bench_triggers(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto repetitions = int32_t(s.main_data_back(0));
+	s.pop_main();
+
+	auto n = state->local_player_nation;
+	auto capital = state->world.nation_get_capital(n);
+	if(!n || !capital) {
+		log_to_console(*state, state->ui_state.console_window, "The player needs a nation with a capital");
+		return p + 2;
+	}
+
+	// every free national event trigger tested against the player, and every free provincial one against their capital
+	run_benchmark(*state, "event triggers", repetitions, [&](int32_t i) {
+		for(auto ev : state->world.in_free_national_event) {
+			if(auto t = ev.get_trigger(); t)
+				trigger::evaluate(*state, t, trigger::to_generic(n), trigger::to_generic(n), 0);
+		}
+		for(auto ev : state->world.in_free_provincial_event) {
+			if(auto t = ev.get_trigger(); t)
+				trigger::evaluate(*state, t, trigger::to_generic(capital), trigger::to_generic(n), 0);
+		}
+	});
+
+	return p + 2;
+}
+
+int32_t* f_bench_checksum(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto repetitions = int32_t(s.main_data_back(0));
+	s.pop_main();
+
+	run_benchmark(*state, "get_save_checksum", repetitions, [&](int32_t i) {
+		state->get_save_checksum();
+	});
+
+	return p + 2;
+}
+
 int32_t* f_change_tag(fif::state_stack& s, int32_t* p, fif::environment* e) {
 	if(fif::typechecking_mode(e->mode)) {
 		if(fif::typechecking_failed(e->mode))
@@ -1363,6 +1781,21 @@ void ui::initialize_console_fif_environment(sys::state& state) {
 
 	fif::add_import("clear", nullptr, f_clear, {}, {}, * state.fif_environment);
 	fif::add_import("fps", nullptr, f_fps, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("tick-profile", nullptr, f_tick_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("frame-profile", nullptr, f_frame_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("dump-tick-profile", nullptr, f_dump_tick_profile, { }, {}, * state.fif_environment);
+	fif::add_import("record-replay", nullptr, f_record_replay, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("net-stats", nullptr, f_net_stats, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("dump-net-stats", nullptr, f_dump_net_stats, { }, {}, * state.fif_environment);
+	fif::add_import("script-profile", nullptr, f_script_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("dump-script-profile", nullptr, f_dump_script_profile, { }, {}, * state.fif_environment);
+	fif::add_import("ai-profile", nullptr, f_ai_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("dump-ai-profile", nullptr, f_dump_ai_profile, { }, {}, * state.fif_environment);
+	fif::add_import("sample-profile", nullptr, f_sample_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("memory-report", nullptr, f_memory_report, { }, {}, * state.fif_environment);
+	fif::add_import("bench-paths", nullptr, f_bench_paths, { fif::fif_i32 }, {}, * state.fif_environment);
+	fif::add_import("bench-triggers", nullptr, f_bench_triggers, { fif::fif_i32 }, {}, * state.fif_environment);
+	fif::add_import("bench-checksum", nullptr, f_bench_checksum, { fif::fif_i32 }, {}, * state.fif_environment);
 	fif::add_import("change-tag", nullptr, f_change_tag, { nation_id_type }, {}, *state.fif_environment);
 	fif::add_import("set-westernized", nullptr, f_set_westernized, { nation_id_type, fif::fif_bool }, {}, * state.fif_environment);
 	fif::add_import("make-crisis", nullptr, f_make_crisis, { }, {}, * state.fif_environment);
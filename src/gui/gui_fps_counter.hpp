@@ -32,4 +32,114 @@ public:
 	}
 };
 
+// shows the phases of the daily tick that took the longest on average over the recently recorded days
+class tick_profiler_overlay : public multiline_text_element_base {
+private:
+	std::chrono::time_point<std::chrono::steady_clock> last_compute_time{};
+
+public:
+	static constexpr int32_t shown_phases = 12;
+
+	void render(sys::state& state, int32_t x, int32_t y) noexcept override {
+		std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+		auto milliseconds_since_last_compute = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_compute_time);
+		if(milliseconds_since_last_compute.count() > 500) {
+			auto color = black_text ? text::text_color::black : text::text_color::white;
+			auto layout = text::create_endless_layout(state, internal_layout,
+				text::layout_parameters{ 0, 0, static_cast<int16_t>(base_data.size.x), static_cast<int16_t>(base_data.size.y),
+					base_data.data.text.font_handle, 0, text::alignment::left, color, false });
+			auto box = text::open_layout_box(layout, 0);
+			text::add_to_layout_box(state, layout, box, std::string_view("phase: avg / peak / last (ms)"), color);
+			text::add_line_break_to_layout_box(state, layout, box);
+			for(auto& p : state.tick_timings.top_phases(shown_phases)) {
+				text::add_to_layout_box(state, layout, box, std::string(p.name) + ": " + text::format_float(p.average_ms, 2) + " / "
+					+ text::format_float(p.peak_ms, 2) + " / " + text::format_float(p.last_ms, 2), color);
+				text::add_line_break_to_layout_box(state, layout, box);
+			}
+			text::close_layout_box(layout, box);
+			last_compute_time = now;
+		}
+
+		multiline_text_element_base::render(state, x, y);
+	}
+};
+
+// shows where the time of a frame goes, on the cpu and on the gpu, so that a low frame rate can be put down to one or the other
+class frame_profiler_overlay : public multiline_text_element_base {
+private:
+	std::chrono::time_point<std::chrono::steady_clock> last_compute_time{};
+
+public:
+	void render(sys::state& state, int32_t x, int32_t y) noexcept override {
+		std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+		auto milliseconds_since_last_compute = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_compute_time);
+		if(milliseconds_since_last_compute.count() > 500) {
+			auto const& timings = state.open_gl.frame_timings;
+			auto color = black_text ? text::text_color::black : text::text_color::white;
+			auto layout = text::create_endless_layout(state, internal_layout,
+				text::layout_parameters{ 0, 0, static_cast<int16_t>(base_data.size.x), static_cast<int16_t>(base_data.size.y),
+					base_data.data.text.font_handle, 0, text::alignment::left, color, false });
+			auto box = text::open_layout_box(layout, 0);
+
+			float cpu_total = 0.0f;
+			text::add_to_layout_box(state, layout, box, std::string_view("cpu (ms)"), color);
+			text::add_line_break_to_layout_box(state, layout, box);
+			for(int32_t i = 0; i < int32_t(ogl::frame_profiler::cpu_stage_count); ++i) {
+				auto s = ogl::frame_profiler::cpu_stage(i);
+				cpu_total += timings.cpu_ms(s);
+				text::add_to_layout_box(state, layout, box, std::string(ogl::frame_profiler::name(s)) + ": " + text::format_float(timings.cpu_ms(s), 2), color);
+				text::add_line_break_to_layout_box(state, layout, box);
+			}
+			text::add_to_layout_box(state, layout, box, "total: " + text::format_float(cpu_total, 2), color);
+			text::add_line_break_to_layout_box(state, layout, box);
+
+			if(timings.gpu_timers_supported()) {
+				float gpu_total = 0.0f;
+				text::add_to_layout_box(state, layout, box, std::string_view("gpu (ms)"), color);
+				text::add_line_break_to_layout_box(state, layout, box);
+				for(int32_t i = 0; i < int32_t(ogl::frame_profiler::gpu_pass_count); ++i) {
+					auto p = ogl::frame_profiler::gpu_pass(i);
+					gpu_total += timings.gpu_ms(p);
+					text::add_to_layout_box(state, layout, box, std::string(ogl::frame_profiler::name(p)) + ": " + text::format_float(timings.gpu_ms(p), 2), color);
+					text::add_line_break_to_layout_box(state, layout, box);
+				}
+				text::add_to_layout_box(state, layout, box, "total: " + text::format_float(gpu_total, 2), color);
+			} else {
+				text::add_to_layout_box(state, layout, box, std::string_view("gpu timer queries are not supported"), color);
+			}
+			text::close_layout_box(layout, box);
+			last_compute_time = now;
+		}
+
+		multiline_text_element_base::render(state, x, y);
+	}
+};
+
+// shows the bandwidth, command rate, round trip and lag of every client connected to the host
+class network_telemetry_overlay : public multiline_text_element_base {
+private:
+	std::chrono::time_point<std::chrono::steady_clock> last_compute_time{};
+
+public:
+	void render(sys::state& state, int32_t x, int32_t y) noexcept override {
+		std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+		auto milliseconds_since_last_compute = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_compute_time);
+		if(milliseconds_since_last_compute.count() > 500) {
+			auto color = black_text ? text::text_color::black : text::text_color::white;
+			auto layout = text::create_endless_layout(state, internal_layout,
+				text::layout_parameters{ 0, 0, static_cast<int16_t>(base_data.size.x), static_cast<int16_t>(base_data.size.y),
+					base_data.data.text.font_handle, 0, text::alignment::left, color, false });
+			auto box = text::open_layout_box(layout, 0);
+			for(auto& line : network::describe_client_telemetry(state)) {
+				text::add_to_layout_box(state, layout, box, line, color);
+				text::add_line_break_to_layout_box(state, layout, box);
+			}
+			text::close_layout_box(layout, box);
+			last_compute_time = now;
+		}
+
+		multiline_text_element_base::render(state, x, y);
+	}
+};
+
 } // namespace ui
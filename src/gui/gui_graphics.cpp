@@ -323,4 +323,53 @@ void populate_definitions_map(sys::state& state) {
 	}
 }
 
+static void collect_textures(sys::state& state, dcon::gui_def_id id, std::vector<ogl::texture_request>& textures) {
+	auto const& def = state.ui_defs.gui[id];
+	dcon::gfx_object_id gid;
+	switch(def.get_element_type()) {
+	case element_type::button:
+		gid = def.data.button.button_image;
+		break;
+	case element_type::image:
+		gid = def.data.image.gfx_object;
+		break;
+	case element_type::listbox:
+		gid = def.data.list_box.background_image;
+		break;
+	case element_type::window:
+		for(uint32_t i = 0; i < def.data.window.num_children; ++i)
+			collect_textures(state, dcon::gui_def_id(dcon::gui_def_id::value_base_t(i + def.data.window.first_child.index())), textures);
+		break;
+	case element_type::scrollbar:
+		for(uint32_t i = 0; i < def.data.scrollbar.num_children; ++i)
+			collect_textures(state, dcon::gui_def_id(dcon::gui_def_id::value_base_t(i + def.data.scrollbar.first_child.index())), textures);
+		break;
+	default:
+		break;
+	}
+	if(!gid)
+		return;
+
+	// the data is kept for the same textures that the elements drawing them keep it for
+	auto const& gfx_def = state.ui_defs.gfx[gid];
+	if(gfx_def.primary_texture_handle)
+		textures.push_back(ogl::texture_request{ gfx_def.primary_texture_handle, gfx_def.is_partially_transparent() });
+	if(gfx_def.type_dependent != 0) {
+		auto type = gfx_def.get_object_type();
+		if(type == object_type::horizontal_progress_bar || type == object_type::vertical_progress_bar)
+			textures.push_back(ogl::texture_request{ dcon::texture_id(gfx_def.type_dependent - 1), gfx_def.is_partially_transparent() });
+		else if(type == object_type::flag_mask)
+			textures.push_back(ogl::texture_request{ dcon::texture_id(gfx_def.type_dependent - 1), true });
+	}
+}
+
+void prefetch_window_textures(sys::state& state, std::vector<std::string_view> const& window_names) {
+	std::vector<ogl::texture_request> textures;
+	for(auto name : window_names) {
+		if(auto it = state.ui_state.defs_by_name.find(state.lookup_key(name)); it != state.ui_state.defs_by_name.end())
+			collect_textures(state, it->second.definition, textures);
+	}
+	ogl::prefetch_textures(state, textures);
+}
+
 } // namespace ui
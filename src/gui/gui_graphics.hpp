@@ -413,6 +413,17 @@ struct state {
 	element_base* drag_target = nullptr;
 	element_base* edit_target = nullptr;
 	element_base* last_tooltip = nullptr;
+	// where within last_tooltip its tooltip was last generated: a position sensitive tooltip only needs to be generated again
+	// once the mouse moves, or when the game state is updated
+	xy_pair last_tooltip_location = xy_pair{ 0, 0 };
+	// what the map tooltip currently in the tooltip layout was built for: it only needs to be built again once the hovered
+	// province, the map mode or the selection changes, or the game state is updated
+	dcon::province_id map_tooltip_province;
+	uint8_t map_tooltip_mode = 0;
+	dcon::province_id map_tooltip_selected_province;
+	std::vector<dcon::army_id> map_tooltip_armies;
+	std::vector<dcon::navy_id> map_tooltip_navies;
+	int32_t map_tooltip_width = 0;
 	element_base* mouse_sensitive_target = nullptr;
 	xy_pair target_ul_bounds = xy_pair{ 0, 0 };
 	xy_pair target_lr_bounds = xy_pair{ 0, 0 };
@@ -441,6 +452,9 @@ struct state {
 	element_base* main_menu = nullptr; // Settings window
 	element_base* r_main_menu = nullptr; // Settings window for non-in-game modes
 	element_base* fps_counter = nullptr;
+	element_base* tick_profiler_overlay = nullptr;
+	element_base* frame_profiler_overlay = nullptr;
+	element_base* network_telemetry_overlay = nullptr;
 	element_base* console_window = nullptr; // console window
 	element_base* console_window_r = nullptr;
 	element_base* topbar_window = nullptr;
@@ -533,5 +547,8 @@ int32_t ui_width(sys::state const& state);
 int32_t ui_height(sys::state const& state);
 
 void create_in_game_windows(sys::state& state);
+// loads, ahead of time, the textures drawn by the named window definitions and their children; windows that are
+// created from code rather than being children in the definitions are not followed
+void prefetch_window_textures(sys::state& state, std::vector<std::string_view> const& window_names);
 
 } // namespace ui
@@ -8,6 +8,22 @@ namespace ui {
 
 
 
+// Sorts the rows by a key that is worked out once per row rather than twice for every comparison, which matters for keys
+// such as localized names or counts that have to walk a nation's provinces.
+template<typename T, typename F>
+void sort_rows_by_key(std::vector<T>& rows, bool descending, F&& key_of) {
+	using key_type = std::decay_t<decltype(key_of(std::declval<T>()))>;
+	std::vector<std::pair<key_type, T>> keyed;
+	keyed.reserve(rows.size());
+	for(auto r : rows)
+		keyed.emplace_back(key_of(r), r);
+	std::sort(keyed.begin(), keyed.end(), [&](auto const& a, auto const& b) {
+		return descending ? a.first > b.first : a.first < b.first;
+	});
+	for(size_t i = 0; i < keyed.size(); ++i)
+		rows[i] = keyed[i].second;
+}
+
 class ledger_page_number {
 public:
 	int8_t value;
@@ -382,13 +398,7 @@ public:
 				break;
 				
 			default:
-				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-					if(lsort.reversed) {
-						return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-					} else {
-						return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-					}
-				});
+				sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 				break;
 		}
 		update(state);
@@ -587,24 +597,14 @@ public:
 			});
 			break;
 		case ledger_sort_type::factories:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				uint32_t anum_factories = 0;
-				for(auto si : state.world.nation_get_state_ownership(a)) {
+			sort_rows_by_key(row_contents, !lsort.reversed, [&](dcon::nation_id n) {
+				uint32_t num_factories = 0;
+				for(auto si : state.world.nation_get_state_ownership(n)) {
 					province::for_each_province_in_state_instance(state, si.get_state(), [&](dcon::province_id p) {
-						anum_factories += uint32_t(state.world.province_get_factory_location(p).end() - state.world.province_get_factory_location(p).begin());
+						num_factories += uint32_t(state.world.province_get_factory_location(p).end() - state.world.province_get_factory_location(p).begin());
 					});
 				}
-				uint32_t bnum_factories = 0;
-				for(auto si : state.world.nation_get_state_ownership(b)) {
-					province::for_each_province_in_state_instance(state, si.get_state(), [&](dcon::province_id p) {
-						bnum_factories += uint32_t(state.world.province_get_factory_location(p).end() - state.world.province_get_factory_location(p).begin());
-					});
-				}
-				if(lsort.reversed) {
-					return anum_factories < bnum_factories;
-				} else {
-					return anum_factories > bnum_factories;
-				}
+				return num_factories;
 			});
 			break;
 		case ledger_sort_type::literacy:
@@ -637,22 +637,10 @@ public:
 			});
 			break;
 		case ledger_sort_type::ships:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return military::total_ships(state, a) < military::total_ships(state, b);
-				} else {
-					return military::total_ships(state, a) > military::total_ships(state, b);
-				}
-			});
+			sort_rows_by_key(row_contents, !lsort.reversed, [&](dcon::nation_id n) { return military::total_ships(state, n); });
 			break;
 		default:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-				} else {
-					return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 			break;
 		}
 
@@ -832,13 +820,7 @@ public:
 			});
 			break;
 		default:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-				} else {
-					return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 			break;
 		}
 
@@ -987,13 +969,7 @@ public:
 				}
 			});
 		} else {
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-				} else {
-					return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 		}
 
 		update(state);
@@ -1024,13 +1000,7 @@ public:
 				}
 			});
 		} else {
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-				} else {
-					return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 		}
 
 		update(state);
@@ -1163,13 +1133,7 @@ public:
 				}
 			});
 		} else {
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, text::get_name(state, a)) > text::produce_simple_string(state, text::get_name(state, b));
-				} else {
-					return text::produce_simple_string(state, text::get_name(state, a)) < text::produce_simple_string(state, text::get_name(state, b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::nation_id n) { return text::produce_simple_string(state, text::get_name(state, n)); });
 		}
 
 		update(state);
@@ -1428,13 +1392,7 @@ public:
 			});
 			break;
 		default:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::province_id a, dcon::province_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) > text::produce_simple_string(state, state.world.province_get_name(b));
-				} else {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) < text::produce_simple_string(state, state.world.province_get_name(b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::province_id p) { return text::produce_simple_string(state, state.world.province_get_name(p)); });
 			break;
 		}
 
@@ -1560,13 +1518,7 @@ public:
 				}
 			});
 		} else {
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::province_id a, dcon::province_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) > text::produce_simple_string(state, state.world.province_get_name(b));
-				} else {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) < text::produce_simple_string(state, state.world.province_get_name(b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::province_id p) { return text::produce_simple_string(state, state.world.province_get_name(p)); });
 		}
 
 		update(state);
@@ -1785,13 +1737,7 @@ public:
 			break;
 		*/
 		default:
-			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::province_id a, dcon::province_id b) {
-				if(lsort.reversed) {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) > text::produce_simple_string(state, state.world.province_get_name(b));
-				} else {
-					return text::produce_simple_string(state, state.world.province_get_name(a)) < text::produce_simple_string(state, state.world.province_get_name(b));
-				}
-			});
+			sort_rows_by_key(row_contents, lsort.reversed, [&](dcon::province_id p) { return text::produce_simple_string(state, state.world.province_get_name(p)); });
 			break;
 		}
 
@@ -227,11 +227,12 @@ public:
 			auto screen_size =
 				glm::vec2{ float(state.x_size / state.user_settings.ui_scale), float(state.y_size / state.user_settings.ui_scale) };
 			glm::vec2 screen_pos;
-			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
+			// the fog of war test is much cheaper than projecting the position, so it goes first
+			if(!state.map_state.visible_provinces[province::to_map_id(port_for)]) {
 				visible = false;
 				return;
 			}
-			if(!state.map_state.visible_provinces[province::to_map_id(port_for)]) {
+			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
 				visible = false;
 				return;
 			}
@@ -1083,11 +1084,12 @@ public:
 			auto map_pos = state.map_state.normalize_map_coord(mid_point);
 			auto screen_size = glm::vec2{ float(state.x_size / state.user_settings.ui_scale), float(state.y_size / state.user_settings.ui_scale) };
 			glm::vec2 screen_pos;
-			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
+			// the fog of war test is much cheaper than projecting the position, so it goes first
+			if(!state.map_state.visible_provinces[province::to_map_id(prov)]) {
 				visible = false;
 				return;
 			}
-			if(!state.map_state.visible_provinces[province::to_map_id(prov)]) {
+			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
 				visible = false;
 				return;
 			}
@@ -1711,11 +1713,12 @@ public:
 			auto map_pos = state.map_state.normalize_map_coord(mid_point);
 			auto screen_size = glm::vec2{ float(state.x_size / state.user_settings.ui_scale), float(state.y_size / state.user_settings.ui_scale) };
 			glm::vec2 screen_pos;
-			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
+			// the fog of war test is much cheaper than projecting the position, so it goes first
+			if(!state.map_state.visible_provinces[province::to_map_id(prov)]) {
 				visible = false;
 				return;
 			}
-			if(!state.map_state.visible_provinces[province::to_map_id(prov)]) {
+			if(!state.map_state.map_to_screen(state, map_pos, screen_size, screen_pos)) {
 				visible = false;
 				return;
 			}
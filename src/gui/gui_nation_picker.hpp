@@ -229,7 +229,7 @@ public:
 				c.type = command::command_type::notify_save_loaded;
 				c.source = state.local_player_nation;
 				c.data.notify_save_loaded.target = dcon::nation_id{};
-				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length, state.network_state.current_save_checksum);
+				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer, state.network_state.current_save_checksum);
 			} else {
 				state.fill_unsaved_data();
 			}
@@ -47,18 +47,33 @@ private:
 	province_search_list* search_listbox = nullptr;
 	province_search_edit* edit_box = nullptr;
 
+	// lowercased province names, sorted, so that the provinces matching a prefix form one contiguous range; built on the
+	// first search after the window is shown or the locale changes
+	std::vector<std::pair<std::string, dcon::province_id>> name_index;
+
+	void build_name_index(sys::state& state) noexcept {
+		name_index.clear();
+		name_index.reserve(state.world.province_size());
+		state.world.for_each_province([&](dcon::province_id prov_id) {
+			dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
+			name_index.emplace_back(parsers::lowercase_str(text::produce_simple_string(state, fat_id.get_name())), prov_id);
+		});
+		std::sort(name_index.begin(), name_index.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+	}
+
 	std::vector<dcon::province_id> search_provinces(sys::state& state, std::string_view search_term) noexcept {
 		std::vector<dcon::province_id> results{};
 		std::string search_term_lower = parsers::lowercase_str(search_term);
 
 		if(!search_term.empty()) {
-			state.world.for_each_province([&](dcon::province_id prov_id) {
-				dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
-				auto name = parsers::lowercase_str(text::produce_simple_string(state, fat_id.get_name()));
-				if(name.starts_with(search_term_lower)) {
-					results.push_back(prov_id);
-				}
-			});
+			if(name_index.empty())
+				build_name_index(state);
+			auto it = std::lower_bound(name_index.begin(), name_index.end(), search_term_lower,
+					[](auto const& entry, std::string const& term) { return entry.first < term; });
+			for(; it != name_index.end() && it->first.starts_with(search_term_lower); ++it)
+				results.push_back(it->second);
+			// keep listing the matches in province order
+			std::sort(results.begin(), results.end(), [](dcon::province_id a, dcon::province_id b) { return a.index() < b.index(); });
 		}
 
 		return results;
@@ -98,7 +113,14 @@ public:
 		}
 	}
 
+	void on_reset_text(sys::state& state) noexcept override {
+		name_index.clear();
+		window_element_base::on_reset_text(state);
+	}
+
 	void on_visible(sys::state& state) noexcept override {
+		// provinces may have been renamed since the window was last open
+		name_index.clear();
 		state.ui_state.edit_target = edit_box;
 	}
 
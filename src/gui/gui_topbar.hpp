@@ -197,7 +197,7 @@ public:
 
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto literacy_change = demographics::get_estimated_literacy_change(state, nation_id);
+		auto literacy_change = demographics::get_estimated_changes(state, nation_id).literacy;
 		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_four_places{literacy_change});
 		auto total = state.world.nation_get_demographics(nation_id, demographics::total);
 		auto avg_literacy = text::format_percentage(total != 0.f ? (state.world.nation_get_demographics(nation_id, demographics::literacy) / total) : 0.f, 1);
@@ -491,7 +491,7 @@ public:
 		auto nation_id = retrieve<dcon::nation_id>(state, parent);
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto mil_change = demographics::get_estimated_mil_change(state, nation_id);
+		auto mil_change = demographics::get_estimated_changes(state, nation_id).militancy;
 		auto total = state.world.nation_get_demographics(nation_id, demographics::total);
 		text::add_to_substitution_map(sub, text::variable_type::avg,
 				text::fp_two_places{total != 0.f ? state.world.nation_get_demographics(nation_id, demographics::militancy) / total : 0.f});
@@ -532,7 +532,7 @@ public:
 
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto con_change = demographics::get_estimated_con_change(state, nation_id);
+		auto con_change = demographics::get_estimated_changes(state, nation_id).consciousness;
 		auto total = state.world.nation_get_demographics(nation_id, demographics::total);
 		text::add_to_substitution_map(sub, text::variable_type::avg,
 				text::fp_two_places{ total != 0.f ? (state.world.nation_get_demographics(nation_id, demographics::consciousness) / total) : 0.f });
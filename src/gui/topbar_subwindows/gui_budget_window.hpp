@@ -70,21 +70,21 @@ namespace ui {
 class nation_gold_income_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_money(economy::estimate_gold_income(state, state.local_player_nation)));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).gold_income));
 	}
 };
 
 class nation_loan_spending_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_money(economy::interest_payment(state, state.local_player_nation)));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).interest));
 	}
 };
 
 class nation_diplomatic_balance_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_money(economy::estimate_diplomatic_balance(state, state.local_player_nation)));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).diplomatic_balance));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -129,7 +129,7 @@ public:
 class nation_subsidy_spending_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_money(economy::estimate_subsidy_spending(state, state.local_player_nation)));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).subsidy_spending));
 	}
 };
 
@@ -1244,7 +1244,7 @@ class budget_actual_stockpile_spending_text : public budget_scaled_monetary_valu
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		vals[uint8_t(budget_slider_target::stockpile_filling)] =
-			economy::estimate_stockpile_filling_spending(state, state.local_player_nation);
+			economy::get_budget_estimates(state, state.local_player_nation).stockpile_filling_spending;
 	}
 };
 
@@ -1252,17 +1252,17 @@ class budget_estimated_stockpile_spending_text : public budget_scaled_monetary_v
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		vals[uint8_t(budget_slider_target::construction_stock)] =
-				economy::estimate_construction_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::army_stock)] = economy::estimate_land_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::navy_stock)] = economy::estimate_naval_spending(state, state.local_player_nation);
+				economy::get_budget_estimates(state, state.local_player_nation).construction_spending;
+		vals[uint8_t(budget_slider_target::army_stock)] = economy::get_budget_estimates(state, state.local_player_nation).land_spending;
+		vals[uint8_t(budget_slider_target::navy_stock)] = economy::get_budget_estimates(state, state.local_player_nation).naval_spending;
 	}
 };
 
 class budget_military_spending_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
-		vals[uint8_t(budget_slider_target::army_stock)] = economy::estimate_land_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::navy_stock)] = economy::estimate_naval_spending(state, state.local_player_nation);
+		vals[uint8_t(budget_slider_target::army_stock)] = economy::get_budget_estimates(state, state.local_player_nation).land_spending;
+		vals[uint8_t(budget_slider_target::navy_stock)] = economy::get_budget_estimates(state, state.local_player_nation).naval_spending;
 	}
 };
 
@@ -1270,21 +1270,21 @@ class budget_overseas_spending_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		vals[uint8_t(budget_slider_target::overseas)] =
-			economy::estimate_overseas_penalty_spending(state, state.local_player_nation);
+			economy::get_budget_estimates(state, state.local_player_nation).overseas_penalty_spending;
 	}
 };
 
 class budget_tariff_income_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
-		vals[uint8_t(budget_slider_target::tariffs)] = economy::estimate_tariff_income(state, state.local_player_nation);
+		vals[uint8_t(budget_slider_target::tariffs)] = economy::get_budget_estimates(state, state.local_player_nation).tariff_income;
 	}
 };
 
 template<culture::pop_strata Strata, budget_slider_target BudgetTarget>
 class budget_stratified_tax_income_text : public budget_scaled_monetary_value_text {
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
-		vals[uint8_t(BudgetTarget)] = economy::estimate_tax_income_by_strata(state, state.local_player_nation, Strata);
+		vals[uint8_t(BudgetTarget)] = economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(Strata)];
 	}
 };
 
@@ -1292,14 +1292,14 @@ template<culture::income_type IncomeType, budget_slider_target BudgetTarget>
 class budget_expenditure_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
-		vals[uint8_t(BudgetTarget)] = economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, IncomeType);
+		vals[uint8_t(BudgetTarget)] = economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(IncomeType)];
 	}
 };
 
 class budget_social_spending_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
-		vals[uint8_t(budget_slider_target::social)] = economy::estimate_social_spending(state, state.local_player_nation);
+		vals[uint8_t(budget_slider_target::social)] = economy::get_budget_estimates(state, state.local_player_nation).social_spending;
 	}
 };
 
@@ -1307,12 +1307,12 @@ class budget_income_projection_text : public budget_scaled_monetary_value_text {
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		vals[uint8_t(budget_slider_target::poor_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::poor);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::poor)];
 		vals[uint8_t(budget_slider_target::middle_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::middle);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::middle)];
 		vals[uint8_t(budget_slider_target::rich_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::rich);
-		vals[uint8_t(budget_slider_target::gold_income)] = economy::estimate_gold_income(state, state.local_player_nation);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::rich)];
+		vals[uint8_t(budget_slider_target::gold_income)] = economy::get_budget_estimates(state, state.local_player_nation).gold_income;
 	}
 };
 
@@ -1320,23 +1320,23 @@ class budget_expenditure_projection_text : public budget_scaled_monetary_value_t
 public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		vals[uint8_t(budget_slider_target::construction_stock)] =
-				economy::estimate_construction_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::army_stock)] = economy::estimate_land_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::navy_stock)] = economy::estimate_naval_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::social)] = economy::estimate_social_spending(state, state.local_player_nation);
+				economy::get_budget_estimates(state, state.local_player_nation).construction_spending;
+		vals[uint8_t(budget_slider_target::army_stock)] = economy::get_budget_estimates(state, state.local_player_nation).land_spending;
+		vals[uint8_t(budget_slider_target::navy_stock)] = economy::get_budget_estimates(state, state.local_player_nation).naval_spending;
+		vals[uint8_t(budget_slider_target::social)] = economy::get_budget_estimates(state, state.local_player_nation).social_spending;
 		vals[uint8_t(budget_slider_target::education)] =
-				economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::education);
+				economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::education)];
 		vals[uint8_t(budget_slider_target::admin)] =
-				economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::administration);
+				economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::administration)];
 		vals[uint8_t(budget_slider_target::military)] =
-				economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::military);
-		vals[uint8_t(budget_slider_target::domestic_investment)] = economy::estimate_domestic_investment(state, state.local_player_nation)
+				economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::military)];
+		vals[uint8_t(budget_slider_target::domestic_investment)] = economy::get_budget_estimates(state, state.local_player_nation).domestic_investment
 			* state.world.nation_get_domestic_investment_spending(state.local_player_nation) / 100.0f
 			* state.world.nation_get_domestic_investment_spending(state.local_player_nation) / 100.0f;
-		vals[uint8_t(budget_slider_target::subsidies)] = economy::estimate_subsidy_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::overseas)] = economy::estimate_overseas_penalty_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::stockpile_filling)] = economy::estimate_stockpile_filling_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::interest)] = economy::interest_payment(state, state.local_player_nation);
+		vals[uint8_t(budget_slider_target::subsidies)] = economy::get_budget_estimates(state, state.local_player_nation).subsidy_spending;
+		vals[uint8_t(budget_slider_target::overseas)] = economy::get_budget_estimates(state, state.local_player_nation).overseas_penalty_spending;
+		vals[uint8_t(budget_slider_target::stockpile_filling)] = economy::get_budget_estimates(state, state.local_player_nation).stockpile_filling_spending;
+		vals[uint8_t(budget_slider_target::interest)] = economy::get_budget_estimates(state, state.local_player_nation).interest;
 	}
 };
 
@@ -1345,32 +1345,32 @@ public:
 	void put_values(sys::state& state, std::array<float, size_t(budget_slider_target::target_count)>& vals) noexcept override {
 		// income
 		vals[uint8_t(budget_slider_target::poor_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::poor);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::poor)];
 		vals[uint8_t(budget_slider_target::middle_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::middle);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::middle)];
 		vals[uint8_t(budget_slider_target::rich_tax)] =
-				economy::estimate_tax_income_by_strata(state, state.local_player_nation, culture::pop_strata::rich);
-		vals[uint8_t(budget_slider_target::gold_income)] = economy::estimate_gold_income(state, state.local_player_nation);
+				economy::get_budget_estimates(state, state.local_player_nation).tax_income[uint8_t(culture::pop_strata::rich)];
+		vals[uint8_t(budget_slider_target::gold_income)] = economy::get_budget_estimates(state, state.local_player_nation).gold_income;
 
 		// spend
 		vals[uint8_t(budget_slider_target::construction_stock)] =
-				-economy::estimate_construction_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::army_stock)] = -economy::estimate_land_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::navy_stock)] = -economy::estimate_naval_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::social)] = -economy::estimate_social_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::education)] = -economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::education);
-		vals[uint8_t(budget_slider_target::admin)] = -economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::administration);
-		vals[uint8_t(budget_slider_target::military)] = -economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::military);
-		vals[uint8_t(budget_slider_target::subsidies)] = -economy::estimate_subsidy_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::overseas)] = -economy::estimate_overseas_penalty_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::stockpile_filling)] = -economy::estimate_stockpile_filling_spending(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::domestic_investment)] = -economy::estimate_domestic_investment(state, state.local_player_nation)
+				-economy::get_budget_estimates(state, state.local_player_nation).construction_spending;
+		vals[uint8_t(budget_slider_target::army_stock)] = -economy::get_budget_estimates(state, state.local_player_nation).land_spending;
+		vals[uint8_t(budget_slider_target::navy_stock)] = -economy::get_budget_estimates(state, state.local_player_nation).naval_spending;
+		vals[uint8_t(budget_slider_target::social)] = -economy::get_budget_estimates(state, state.local_player_nation).social_spending;
+		vals[uint8_t(budget_slider_target::education)] = -economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::education)];
+		vals[uint8_t(budget_slider_target::admin)] = -economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::administration)];
+		vals[uint8_t(budget_slider_target::military)] = -economy::get_budget_estimates(state, state.local_player_nation).pop_payouts[uint8_t(culture::income_type::military)];
+		vals[uint8_t(budget_slider_target::subsidies)] = -economy::get_budget_estimates(state, state.local_player_nation).subsidy_spending;
+		vals[uint8_t(budget_slider_target::overseas)] = -economy::get_budget_estimates(state, state.local_player_nation).overseas_penalty_spending;
+		vals[uint8_t(budget_slider_target::stockpile_filling)] = -economy::get_budget_estimates(state, state.local_player_nation).stockpile_filling_spending;
+		vals[uint8_t(budget_slider_target::domestic_investment)] = -economy::get_budget_estimates(state, state.local_player_nation).domestic_investment
 			* state.world.nation_get_domestic_investment_spending(state.local_player_nation) / 100.0f
 			* state.world.nation_get_domestic_investment_spending(state.local_player_nation) / 100.0f;
 		// balance
-		vals[uint8_t(budget_slider_target::diplomatic_interest)] = economy::estimate_diplomatic_balance(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::interest)] = -economy::interest_payment(state, state.local_player_nation);
-		vals[uint8_t(budget_slider_target::tariffs)] = economy::estimate_tariff_income(state, state.local_player_nation);
+		vals[uint8_t(budget_slider_target::diplomatic_interest)] = economy::get_budget_estimates(state, state.local_player_nation).diplomatic_balance;
+		vals[uint8_t(budget_slider_target::interest)] = -economy::get_budget_estimates(state, state.local_player_nation).interest;
+		vals[uint8_t(budget_slider_target::tariffs)] = economy::get_budget_estimates(state, state.local_player_nation).tariff_income;
 	}
 };
 
@@ -1833,7 +1833,7 @@ class domestic_investment_estimated_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
 		float value = state.world.nation_get_domestic_investment_spending(state.local_player_nation) / 100.0f;
-		set_text(state, text::format_money(economy::estimate_domestic_investment(state, state.local_player_nation) * value * value));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).domestic_investment * value * value));
 	}
 };
 
@@ -1857,7 +1857,7 @@ class overseas_maintenance_estimated_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
 		float value = state.world.nation_get_overseas_spending(state.local_player_nation) / 100.0f;
-		set_text(state, text::format_money(economy::estimate_overseas_penalty_spending(state, state.local_player_nation) * value));
+		set_text(state, text::format_money(economy::get_budget_estimates(state, state.local_player_nation).overseas_penalty_spending * value));
 	}
 };
 
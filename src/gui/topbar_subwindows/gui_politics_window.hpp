@@ -775,14 +775,15 @@ public:
 				issues_listbox->update(state);
 				break;
 			case politics_issue_sort_order::voter_support:
+			{
+				auto support = politics::get_all_voter_support(state, state.local_player_nation);
 				std::sort(issues_listbox->row_contents.begin(), issues_listbox->row_contents.end(),
 						[&](dcon::issue_option_id a, dcon::issue_option_id b) {
-							auto a_support = politics::get_voter_support(state, state.local_player_nation, a);
-							auto b_support = politics::get_voter_support(state, state.local_player_nation, b);
-							return a_support > b_support;
+							return support[a.index()] > support[b.index()];
 						});
 				issues_listbox->update(state);
 				break;
+			}
 			default:
 				break;
 			}
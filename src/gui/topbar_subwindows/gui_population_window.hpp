@@ -2406,132 +2406,109 @@ private:
 	}
 
 	void sort_pop_list(sys::state& state) {
-		std::function<bool(dcon::pop_id, dcon::pop_id)> fn;
+		auto& rows = country_pop_listbox->row_contents;
+		// The key of every pop is worked out once, up front, instead of twice per comparison. Descending orders store the
+		// negated value so that every key sort is ascending. Names are formatted once per distinct religion, culture or
+		// province rather than once per comparison.
+		std::vector<float> keys;
+		std::vector<std::string> names;
+		auto key_by = [&](auto&& f) {
+			keys.resize(rows.size());
+			for(size_t i = 0; i < rows.size(); ++i)
+				keys[i] = f(rows[i]);
+		};
+		auto name_by = [&](auto&& f) {
+			ankerl::unordered_dense::map<int32_t, std::string> formatted;
+			names.resize(rows.size());
+			for(size_t i = 0; i < rows.size(); ++i) {
+				auto id = f(rows[i]);
+				auto it = formatted.find(int32_t(id.index()));
+				if(it == formatted.end())
+					it = formatted.insert_or_assign(int32_t(id.index()), text::get_name_as_string(state, dcon::fatten(state.world, id))).first;
+				names[i] = it->second;
+			}
+		};
 		switch(sort) {
 		case pop_list_sort::type:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_poptype().id.index() < b_fat_id.get_poptype().id.index();
-			};
+			key_by([&](dcon::pop_id p) { return float(state.world.pop_get_poptype(p).index()); });
 			break;
 		case pop_list_sort::size:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_size() > b_fat_id.get_size();
-			};
+			key_by([&](dcon::pop_id p) { return -state.world.pop_get_size(p); });
 			break;
 		case pop_list_sort::con:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_consciousness(state, a) > pop_demographics::get_consciousness(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_consciousness(state, p); });
 			break;
 		case pop_list_sort::mil:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_militancy(state, a) > pop_demographics::get_militancy(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_militancy(state, p); });
 			break;
 		case pop_list_sort::religion:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return text::get_name_as_string(state, a_fat_id.get_religion()) < text::get_name_as_string(state, b_fat_id.get_religion());
-			};
+			name_by([&](dcon::pop_id p) { return state.world.pop_get_religion(p); });
 			break;
 		case pop_list_sort::nationality:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return text::get_name_as_string(state, a_fat_id.get_culture()) < text::get_name_as_string(state, b_fat_id.get_culture());
-			};
+			name_by([&](dcon::pop_id p) { return state.world.pop_get_culture(p); });
 			break;
 		case pop_list_sort::location:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return text::get_name_as_string(state, a_fat_id.get_province_from_pop_location()) < text::get_name_as_string(state, b_fat_id.get_province_from_pop_location());
-			};
+			name_by([&](dcon::pop_id p) { return state.world.pop_get_province_from_pop_location(p); });
 			break;
 		case pop_list_sort::cash:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_savings() > b_fat_id.get_savings();
-			};
+			key_by([&](dcon::pop_id p) { return -state.world.pop_get_savings(p); });
 			break;
 		case pop_list_sort::unemployment:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return pop_demographics::get_employment(state, a) / a_fat_id.get_size() < pop_demographics::get_employment(state, b) / b_fat_id.get_size();
-			};
+			key_by([&](dcon::pop_id p) { return pop_demographics::get_employment(state, p) / state.world.pop_get_size(p); });
 			break;
 		case pop_list_sort::ideology:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_dominant_ideology().id.index() < b_fat_id.get_dominant_ideology().id.index();
-			};
+			key_by([&](dcon::pop_id p) { return float(state.world.pop_get_dominant_ideology(p).index()); });
 			break;
 		case pop_list_sort::issues:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_dominant_issue_option().id.index() < b_fat_id.get_dominant_issue_option().id.index();
-			};
+			key_by([&](dcon::pop_id p) { return float(state.world.pop_get_dominant_issue_option(p).index()); });
 			break;
 		case pop_list_sort::life_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_life_needs(state, a) > pop_demographics::get_life_needs(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_life_needs(state, p); });
 			break;
 		case pop_list_sort::everyday_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_everyday_needs(state, a) > pop_demographics::get_everyday_needs(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_everyday_needs(state, p); });
 			break;
 		case pop_list_sort::luxury_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_luxury_needs(state, a) > pop_demographics::get_luxury_needs(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_luxury_needs(state, p); });
 			break;
 		case pop_list_sort::literacy:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				return pop_demographics::get_literacy(state, a) > pop_demographics::get_literacy(state, b);
-			};
+			key_by([&](dcon::pop_id p) { return -pop_demographics::get_literacy(state, p); });
 			break;
 		case pop_list_sort::revoltrisk:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				auto a_reb = a_fat_id.get_rebel_faction_from_pop_rebellion_membership();
-				auto b_reb = b_fat_id.get_rebel_faction_from_pop_rebellion_membership();
-				auto a_mov = a_fat_id.get_movement_from_pop_movement_membership();
-				auto b_mov = b_fat_id.get_movement_from_pop_movement_membership();
+			std::stable_sort(rows.begin(), rows.end(), [&](dcon::pop_id a, dcon::pop_id b) {
+				auto a_reb = state.world.pop_get_rebel_faction_from_pop_rebellion_membership(a);
+				auto b_reb = state.world.pop_get_rebel_faction_from_pop_rebellion_membership(b);
+				auto a_mov = state.world.pop_get_movement_from_pop_movement_membership(a);
+				auto b_mov = state.world.pop_get_movement_from_pop_movement_membership(b);
 				if(a_reb || b_reb) {
-					return a_reb ? (b_reb ? a_reb.id.index() > b_reb.id.index() : true) : false;
+					return a_reb ? (b_reb ? a_reb.index() > b_reb.index() : true) : false;
 				} else if(a_mov || b_mov) {
-					return a_mov ? (b_mov ? a_mov.id.index() > b_mov.id.index() : true) : false;
+					return a_mov ? (b_mov ? a_mov.index() > b_mov.index() : true) : false;
 				} else {
-					return a_fat_id.id.index() > b_fat_id.id.index();
+					return a.index() > b.index();
 				}
-			};
+			});
 			break;
 		case pop_list_sort::change:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return demographics::get_monthly_pop_increase(state, a_fat_id.id) > demographics::get_monthly_pop_increase(state, b_fat_id.id);
-			};
+			key_by([&](dcon::pop_id p) { return -demographics::get_monthly_pop_increase(state, p); });
 			break;
 		}
-		std::stable_sort(country_pop_listbox->row_contents.begin(), country_pop_listbox->row_contents.end(),
-				[&](dcon::pop_id a, dcon::pop_id b) {
-					return fn(a, b);
-				});
+		if(!keys.empty() || !names.empty()) {
+			std::vector<uint32_t> order(rows.size());
+			for(uint32_t i = 0; i < uint32_t(order.size()); ++i)
+				order[i] = i;
+			if(!names.empty()) {
+				std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+			} else {
+				std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+			}
+			std::vector<dcon::pop_id> sorted(rows.size());
+			for(size_t i = 0; i < order.size(); ++i)
+				sorted[i] = rows[order[i]];
+			rows = std::move(sorted);
+		}
 		if(!sort_ascend) {
-			std::reverse(country_pop_listbox->row_contents.begin(), country_pop_listbox->row_contents.end());
+			std::reverse(rows.begin(), rows.end());
 		}
 	}
 
@@ -62,26 +62,27 @@ public:
 	void on_update(sys::state& state) noexcept override {
 		const dcon::factory_id fid = retrieve<dcon::factory_id>(state, parent);
 		const dcon::nation_id n = retrieve<dcon::nation_id>(state, parent);
-		frame = economy::factory_priority(state, fid);
+		frame = command::predicted_factory_priority(state, fid);
 		auto rules = state.world.nation_get_combined_issue_rules(n);
 		disabled = (rules & issue_rule::factory_priority) == 0 || n != state.local_player_nation;
 	}
 
 	void button_action(sys::state& state) noexcept override {
 		const dcon::factory_id fid = retrieve<dcon::factory_id>(state, parent);
-		auto fat = dcon::fatten(state.world, fid);
-		switch(economy::factory_priority(state, fid)) {
+		// from the predicted settings, so that clicking again before the last click has come back from the host still cycles
+		auto subsidized = command::predicted_factory_subsidized(state, fid);
+		switch(command::predicted_factory_priority(state, fid)) {
 		case 0:
-			command::change_factory_settings(state, state.local_player_nation, fid, 1, fat.get_subsidized());
+			command::change_factory_settings(state, state.local_player_nation, fid, 1, subsidized);
 			break;
 		case 1:
-			command::change_factory_settings(state, state.local_player_nation, fid, 2, fat.get_subsidized());
+			command::change_factory_settings(state, state.local_player_nation, fid, 2, subsidized);
 			break;
 		case 2:
-			command::change_factory_settings(state, state.local_player_nation, fid, 3, fat.get_subsidized());
+			command::change_factory_settings(state, state.local_player_nation, fid, 3, subsidized);
 			break;
 		case 3:
-			command::change_factory_settings(state, state.local_player_nation, fid, 0, fat.get_subsidized());
+			command::change_factory_settings(state, state.local_player_nation, fid, 0, subsidized);
 			break;
 		default:
 			break;
@@ -103,7 +104,7 @@ public:
 			text::add_line(state, contents, "cant_prioritize_explanation");
 		} else {
 			text::add_line(state, contents, "production_allowed_to_change_prio_tooltip");
-			switch(economy::factory_priority(state, fid)) {
+			switch(command::predicted_factory_priority(state, fid)) {
 			case 0:
 				text::add_line(state, contents, "diplomacy_prio_none");
 				break;
@@ -354,21 +355,19 @@ public:
 		const dcon::nation_id n = retrieve<dcon::nation_id>(state, parent);
 		auto rules = state.world.nation_get_combined_issue_rules(n);
 		disabled = (rules & issue_rule::can_subsidise) == 0 || state.local_player_nation != n;
-		frame = state.world.factory_get_subsidized(fid) ? 1 : 0;
+		frame = command::predicted_factory_subsidized(state, fid) ? 1 : 0;
 	}
 
 	void button_action(sys::state& state) noexcept override {
 		const dcon::factory_id fid = retrieve<dcon::factory_id>(state, parent);
-		const dcon::nation_id n = retrieve<dcon::nation_id>(state, parent);
-		auto fat = dcon::fatten(state.world, fid);
-		if(fat.get_subsidized()) {
-			if(command::can_change_factory_settings(state, state.local_player_nation, fid, uint8_t(economy::factory_priority(state, fid)), false)) {
-				command::change_factory_settings(state, state.local_player_nation, fid, uint8_t(economy::factory_priority(state, fid)),
-						false);
+		auto priority = command::predicted_factory_priority(state, fid);
+		if(command::predicted_factory_subsidized(state, fid)) {
+			if(command::can_change_factory_settings(state, state.local_player_nation, fid, priority, false)) {
+				command::change_factory_settings(state, state.local_player_nation, fid, priority, false);
 			}
 		} else {
-			if(command::can_change_factory_settings(state, state.local_player_nation, fid, uint8_t(economy::factory_priority(state, fid)), true)) {
-				command::change_factory_settings(state, state.local_player_nation, fid, uint8_t(economy::factory_priority(state, fid)), true);
+			if(command::can_change_factory_settings(state, state.local_player_nation, fid, priority, true)) {
+				command::change_factory_settings(state, state.local_player_nation, fid, priority, true);
 			}
 		}
 	}
@@ -598,10 +597,11 @@ class normal_factory_background : public opaque_element_base {
 
 		//inputs
 
-		float input_total = economy::factory_input_total_cost(state, n, type);
-		float min_input_available = economy::factory_min_input_available(state, n, type);
-		float e_input_total = economy::factory_e_input_total_cost(state, n, type);
-		float min_e_input_available = economy::factory_min_e_input_available(state, n, type);
+		auto type_costs = economy::get_factory_type_costs(state, n, type);
+		float input_total = type_costs.input_total;
+		float min_input_available = type_costs.min_input_available;
+		float e_input_total = type_costs.e_input_total;
+		float min_e_input_available = type_costs.min_e_input_available;
 
 		//modifiers
 
@@ -1828,15 +1828,15 @@ inline table::column<dcon::factory_type_id> factory_type_input_cost = {
 	.sortable = true,
 	.header = "method_input",
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
-		auto av = economy::factory_type_input_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_input_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).input_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).input_cost;
 		if(av != bv)
 			return av > bv;
 		else
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_input_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).input_cost;
 		return text::format_money(value);
 	},
 };
@@ -1845,15 +1845,15 @@ inline table::column<dcon::factory_type_id> factory_type_output_cost = {
 	.sortable = true,
 	.header = "method_output",
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
-		auto av = economy::factory_type_output_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_output_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).output_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).output_cost;
 		if(av != bv)
 			return av > bv;
 		else
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_output_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).output_cost;
 		return text::format_money(value);
 	},
 };
@@ -1862,18 +1862,18 @@ inline table::column<dcon::factory_type_id> factory_type_profit = {
 	.sortable = true,
 	.header = "method_profit",
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
-		auto av = economy::factory_type_output_cost(state, state.local_player_nation, a)
-			- economy::factory_type_input_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_output_cost(state, state.local_player_nation, b)
-			- economy::factory_type_input_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, a).input_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, b).input_cost;
 		if(av != bv)
 			return av > bv;
 		else
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_output_cost(state, state.local_player_nation, id)
-			- economy::factory_type_input_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, id).input_cost;
 		return text::format_money(value);
 	},
 };
@@ -1882,13 +1882,13 @@ inline table::column<dcon::factory_type_id> factory_type_profit_margin = {
 	.sortable = true,
 	.header = "method_margin",
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
-		auto av = economy::factory_type_output_cost(state, state.local_player_nation, a)
-			- economy::factory_type_input_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_output_cost(state, state.local_player_nation, b)
-			- economy::factory_type_input_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, a).input_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, b).input_cost;
 
-		av /= economy::factory_type_output_cost(state, state.local_player_nation, a);
-		bv /= economy::factory_type_output_cost(state, state.local_player_nation, b);
+		av /= economy::get_factory_type_costs(state, state.local_player_nation, a).output_cost;
+		bv /= economy::get_factory_type_costs(state, state.local_player_nation, b).output_cost;
 
 		if(av != bv)
 			return av > bv;
@@ -1896,9 +1896,9 @@ inline table::column<dcon::factory_type_id> factory_type_profit_margin = {
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_output_cost(state, state.local_player_nation, id)
-			- economy::factory_type_input_cost(state, state.local_player_nation, id);
-		value /= economy::factory_type_output_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, id).input_cost;
+		value /= economy::get_factory_type_costs(state, state.local_player_nation, id).output_cost;
 		return text::format_percentage(value, 2);
 	},
 };
@@ -1907,8 +1907,8 @@ inline table::column<dcon::factory_type_id> factory_type_cost = {
 	.sortable = true,
 	.header = "method_cost",
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
-		auto av = economy::factory_type_build_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_build_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).build_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).build_cost;
 
 		if(av != bv)
 			return av > bv;
@@ -1916,7 +1916,7 @@ inline table::column<dcon::factory_type_id> factory_type_cost = {
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_build_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).build_cost;
 		return text::format_money(value);
 	},
 };
@@ -1927,14 +1927,14 @@ inline table::column<dcon::factory_type_id> factory_type_payback = {
 	.compare = [](sys::state& state, element_base* container, dcon::factory_type_id a, dcon::factory_type_id b) {
 
 
-		auto av = economy::factory_type_output_cost(state, state.local_player_nation, a)
-			- economy::factory_type_input_cost(state, state.local_player_nation, a);
-		auto bv = economy::factory_type_output_cost(state, state.local_player_nation, b)
-			- economy::factory_type_input_cost(state, state.local_player_nation, b);
+		auto av = economy::get_factory_type_costs(state, state.local_player_nation, a).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, a).input_cost;
+		auto bv = economy::get_factory_type_costs(state, state.local_player_nation, b).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, b).input_cost;
 		av = std::max(0.f, av);
 		bv = std::max(0.f, bv);
-		av = economy::factory_type_build_cost(state, state.local_player_nation, a) / av;
-		bv = economy::factory_type_build_cost(state, state.local_player_nation, b) / bv;
+		av = economy::get_factory_type_costs(state, state.local_player_nation, a).build_cost / av;
+		bv = economy::get_factory_type_costs(state, state.local_player_nation, b).build_cost / bv;
 
 		if(av != bv)
 			return av > bv;
@@ -1942,10 +1942,10 @@ inline table::column<dcon::factory_type_id> factory_type_payback = {
 			return a.index() < b.index();
 	},
 	.view = [](sys::state& state, element_base* container, dcon::factory_type_id id) {
-		auto value = economy::factory_type_output_cost(state, state.local_player_nation, id)
-			- economy::factory_type_input_cost(state, state.local_player_nation, id);
+		auto value = economy::get_factory_type_costs(state, state.local_player_nation, id).output_cost
+			- economy::get_factory_type_costs(state, state.local_player_nation, id).input_cost;
 		value = std::max(0.f, value);
-		value = economy::factory_type_build_cost(state, state.local_player_nation, id) / value;
+		value = economy::get_factory_type_costs(state, state.local_player_nation, id).build_cost / value;
 
 		return text::format_float(value);
 	},
@@ -95,25 +95,32 @@ struct data {
 		sort_priority.push_back(new_sort_data);
 	}
 
+	// The most recently chosen column decides the order, and the columns chosen before it break its ties. The rows keep their
+	// order from the previous update and the values behind them rarely change by much between updates, so they are put back
+	// in order by insertion sort, which only does work for the rows that actually moved.
 	void update_rows_order(sys::state& state, ui::element_base* container) {
-		for(auto& order : sort_priority) {
-			if(order.order == sort_order::ascending) {
-				std::sort(
-					data.begin(),
-					data.end(),
-					[&](const item_type& a, const item_type& b) {
-						return columns[order.sorted_index].compare(state, container, a, b);
-					}
-				);
-			} else {
-				std::sort(
-					data.begin(),
-					data.end(),
-					[&](const item_type& a, const item_type& b) {
-						return columns[order.sorted_index].compare(state, container, b, a);
-					}
-				);
+		if(sort_priority.empty())
+			return;
+
+		auto goes_before = [&](const item_type& a, const item_type& b) {
+			for(auto i = sort_priority.size(); i-- > 0;) {
+				auto& compare = columns[sort_priority[i].sorted_index].compare;
+				bool ascending = sort_priority[i].order == sort_order::ascending;
+				if(ascending ? compare(state, container, a, b) : compare(state, container, b, a))
+					return true;
+				if(ascending ? compare(state, container, b, a) : compare(state, container, a, b))
+					return false;
 			}
+			return false;
+		};
+		for(size_t i = 1; i < data.size(); ++i) {
+			if(!goes_before(data[i], data[i - 1]))
+				continue;
+			auto row = data[i];
+			size_t j = i;
+			for(; j > 0 && goes_before(row, data[j - 1]); --j)
+				data[j] = data[j - 1];
+			data[j] = row;
 		}
 	}
 };
@@ -989,6 +989,21 @@ void make_mod_file() {
 	std::thread file_maker([path]() {
 		simple_fs::file_system fs_root;
 		simple_fs::restore_state(fs_root, path);
+
+		// if none of the files that went into the newest scenario for these mods has changed since, there is nothing to rebuild
+		auto sources_checksum = sys::compute_scenario_sources_checksum(fs_root);
+		for(auto& f : scenario_files) {
+			if(f.ident.mod_path == path) {
+				if(f.ident.sources.is_equal(sources_checksum) && !f.ident.sources.is_equal(sys::checksum_key{})) {
+					selected_scenario_file = f.file_name;
+					file_is_ready.store(true, std::memory_order::memory_order_release);
+					InvalidateRect((HWND)(m_hwnd), nullptr, FALSE);
+					return;
+				}
+				break;
+			}
+		}
+
 		parsers::error_handler err("");
 		auto root = get_root(fs_root);
 		auto common = open_directory(root, NATIVE("common"));
@@ -1011,6 +1026,7 @@ void make_mod_file() {
 			//
 			auto game_state = std::make_unique<sys::state>();
 			simple_fs::restore_state(game_state->common_fs, path);
+			game_state->scenario_sources_checksum = sources_checksum;
 			game_state->load_scenario_data(err, bookmark_context.bookmark_dates[date_index].date_);
 			if(err.fatal)
 				break;
@@ -1024,7 +1040,13 @@ void make_mod_file() {
 				}
 				++max_scenario_count;
 				selected_scenario_file = base_name + NATIVE("-") + std::to_wstring(append) + NATIVE(".bin");
+				auto write_start = std::chrono::steady_clock::now();
 				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+				{
+					auto write_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - write_start).count();
+					auto timings = err.build_timings + "Writing the scenario file: " + std::to_string(write_ms) + " ms\n";
+					simple_fs::write_file(simple_fs::get_or_create_settings_directory(), NATIVE("scenario_build_times.txt"), timings.data(), uint32_t(timings.length()));
+				}
 				if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 					auto content = view_contents(*of);
 					auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
@@ -2229,15 +2251,19 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 
 		auto sdir = simple_fs::get_or_create_scenario_directory();
 		auto s_files = simple_fs::list_files(sdir, NATIVE(".bin"));
-		for(auto& f : s_files) {
-			auto of = simple_fs::open_file(f);
+		// only the headers are read, but with many mods installed opening the files one after another still adds up
+		std::vector<sys::mod_identifier> s_descs(s_files.size());
+		concurrency::parallel_for(0, int32_t(s_files.size()), [&](int32_t i) {
+			auto of = simple_fs::open_file(s_files[i]);
 			if(of) {
 				auto content = view_contents(*of);
-				auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
-				if(desc.count != 0) {
-					max_scenario_count = std::max(desc.count, max_scenario_count);
-					scenario_files.push_back(scenario_file{ simple_fs::get_file_name(f) , desc });
-				}
+				s_descs[i] = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
+			}
+		});
+		for(size_t i = 0; i < s_files.size(); ++i) {
+			if(s_descs[i].count != 0) {
+				max_scenario_count = std::max(s_descs[i].count, max_scenario_count);
+				scenario_files.push_back(scenario_file{ simple_fs::get_file_name(s_files[i]) , s_descs[i] });
 			}
 		}
 
@@ -5,6 +5,11 @@
 #include "common_types.cpp"
 #include "system_state.cpp"
 #ifndef INCREMENTAL
+#include "tick_graph.cpp"
+#include "tick_profiler.cpp"
+#include "save_checksum.cpp"
+#include "replay.cpp"
+#include "sampling_profiler.cpp"
 #include "parsers.cpp"
 #include "text.cpp"
 #include "float_from_chars.cpp"
@@ -101,11 +101,15 @@ void display_data::update_fog_of_war(sys::state& state) {
 		}
 		for(auto p : state.world.in_province)
 			province_fows[province::to_map_id(p)] = uint32_t(state.map_state.visible_provinces[province::to_map_id(p)] ? 0xFFFFFFFF : 0x7B7B7B7B);
-		gen_prov_color_texture(textures[texture_province_fow], province_fows);
 	} else {
 		state.map_state.visible_provinces.clear();
 		state.map_state.visible_provinces.resize(state.world.province_size() + 1, true);
+	}
+	// this runs after every game state update, including the ones that only reflect a change to the ui, while the set of
+	// visible provinces only changes when units move or something changes hands
+	if(province_fows != uploaded_province_fow) {
 		gen_prov_color_texture(textures[texture_province_fow], province_fows);
+		uploaded_province_fow = std::move(province_fows);
 	}
 }
 
@@ -259,6 +263,47 @@ void display_data::create_border_ogl_objects() {
 	// TODO: remove unused function
 }
 
+// where a point of the map ends up on the globe, as in globe_coords in the map shaders
+glm::vec3 globe_position(glm::vec2 map_pos) {
+	float angle_x = 2.f * map_pos.x * glm::pi<float>();
+	float angle_y = map_pos.y * glm::pi<float>();
+	return glm::vec3(std::cos(angle_x) * std::sin(angle_y), std::sin(angle_x) * std::sin(angle_y), std::cos(angle_y));
+}
+
+template<typename F>
+globe_bounds make_globe_bounds(int32_t count, float margin, F&& position_of) {
+	globe_bounds b;
+	if(count == 0)
+		return b;
+	for(int32_t i = 0; i < count; ++i)
+		b.center += globe_position(position_of(i));
+	b.center /= float(count);
+	for(int32_t i = 0; i < count; ++i)
+		b.radius = std::max(b.radius, glm::length(globe_position(position_of(i)) - b.center));
+	b.radius += margin;
+	return b;
+}
+
+/*
+Since everything between the vertices of the geometry is made of flat triangles and straight lines, a ball that holds the
+vertices holds all of it. On the globe, the shaders put whatever is on the far side (where y is negative once rotated) in front
+of the near plane, which clips it away; in the perspective view even less of the globe can be seen, but the same test still
+holds. The orthographic globe also maps x and z, scaled by 2 / pi and the zoom, straight to the screen.
+*/
+bool globe_bounds_visible(globe_bounds const& b, glm::mat3 const& rotation, map_view map_view_mode, float zoom, float aspect_ratio) {
+	auto c = rotation * b.center;
+	if(c.y + b.radius < 0.f)
+		return false;
+	if(map_view_mode == map_view::globe) {
+		auto scale = 2.f * zoom / glm::pi<float>();
+		if((std::abs(c.x) - b.radius) * scale / aspect_ratio > 1.f)
+			return false;
+		if((std::abs(c.z) - b.radius) * scale > 1.f)
+			return false;
+	}
+	return true;
+}
+
 void display_data::create_meshes() {
 	std::vector<map_vertex> land_vertices;
 
@@ -278,17 +323,51 @@ void display_data::create_meshes() {
 		}
 	}
 
+	// chunks of 20 by 20 squares, so that the ones on the far side of the globe can be skipped
+	constexpr int chunk_size = 20;
 	map_indices.clear();
-	for(int y = 0; y < sections.y; y++) {
-		auto top_row_start = y * (sections.x + 1);
-		auto bottom_row_start = (y + 1) * (sections.x + 1);
-		map_indices.push_back(uint16_t(bottom_row_start + 0));
-		map_indices.push_back(uint16_t(top_row_start + 0));
-		for(int x = 0; x < sections.x; x++) {
-			map_indices.push_back(uint16_t(bottom_row_start + 1 + x));
-			map_indices.push_back(uint16_t(top_row_start + 1 + x));
-		}
-		map_indices.push_back(std::numeric_limits<uint16_t>::max());
+	land_chunk_starts.clear();
+	land_chunk_counts.clear();
+	land_chunk_bounds.clear();
+	for(int chunk_y = 0; chunk_y < sections.y; chunk_y += chunk_size) {
+		auto chunk_end_y = std::min(chunk_y + chunk_size, sections.y);
+		for(int chunk_x = 0; chunk_x < sections.x; chunk_x += chunk_size) {
+			auto chunk_end_x = std::min(chunk_x + chunk_size, sections.x);
+			auto chunk_start = map_indices.size();
+			for(int y = chunk_y; y < chunk_end_y; y++) {
+				auto top_row_start = y * (sections.x + 1);
+				auto bottom_row_start = (y + 1) * (sections.x + 1);
+				map_indices.push_back(uint16_t(bottom_row_start + chunk_x));
+				map_indices.push_back(uint16_t(top_row_start + chunk_x));
+				for(int x = chunk_x; x < chunk_end_x; x++) {
+					map_indices.push_back(uint16_t(bottom_row_start + 1 + x));
+					map_indices.push_back(uint16_t(top_row_start + 1 + x));
+				}
+				map_indices.push_back(std::numeric_limits<uint16_t>::max());
+			}
+			land_chunk_starts.push_back(uint32_t(chunk_start));
+			land_chunk_counts.push_back(GLsizei(map_indices.size() - 1 - chunk_start));
+
+			auto row_length = chunk_end_x - chunk_x + 1;
+			land_chunk_bounds.push_back(make_globe_bounds((chunk_end_y - chunk_y + 1) * row_length, 0.f, [&](int32_t i) {
+				return land_vertices[(chunk_y + i / row_length) * (sections.x + 1) + chunk_x + i % row_length].position_;
+			}));
+		}
+	}
+
+	// the lines are widened on the screen, by much less than this
+	constexpr float line_margin = 0.01f;
+	border_bounds.clear();
+	for(auto const& b : borders) {
+		border_bounds.push_back(make_globe_bounds(b.count, line_margin, [&](int32_t i) {
+			return border_vertices[b.start_index + i].position;
+		}));
+	}
+	river_bounds.clear();
+	for(size_t i = 0; i < river_starts.size(); ++i) {
+		river_bounds.push_back(make_globe_bounds(river_counts[i], line_margin, [&, start = river_starts[i]](int32_t j) {
+			return river_vertices[start + j].position_;
+		}));
 	}
 
 	land_vertex_count = ((uint32_t)land_vertices.size());
@@ -498,6 +577,11 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glUniform1f(shader_uniforms[program][uniform_time], time_counter);
 	};
 
+	// on the globe, only what can be seen is drawn; see globe_bounds_visible
+	auto in_view = [&](globe_bounds const& b) {
+		return globe_bounds_visible(b, globe_rotation, map_view_mode, zoom, screen_size.x / screen_size.y);
+	};
+
 	glEnable(GL_PRIMITIVE_RESTART);
 	//glDisable(GL_CULL_FACE);
 	glPrimitiveRestartIndex(std::numeric_limits<uint16_t>::max());
@@ -531,10 +615,24 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glUniform1ui(shader_uniforms[shader_terrain][uniform_subroutines_index_2], fragment_subroutines);
 	}
 	glBindVertexArray(vao_array[vo_land]);
-	glDrawElements(GL_TRIANGLE_STRIP, GLsizei(map_indices.size() - 1), GL_UNSIGNED_SHORT, map_indices.data());
+	if(map_view_mode == map_view::flat) {
+		glDrawElements(GL_TRIANGLE_STRIP, GLsizei(map_indices.size() - 1), GL_UNSIGNED_SHORT, map_indices.data());
+	} else {
+		land_draw_indices.clear();
+		land_draw_counts.clear();
+		for(size_t i = 0; i < land_chunk_bounds.size(); ++i) {
+			if(in_view(land_chunk_bounds[i])) {
+				land_draw_indices.push_back(map_indices.data() + land_chunk_starts[i]);
+				land_draw_counts.push_back(land_chunk_counts[i]);
+			}
+		}
+		if(!land_draw_indices.empty())
+			glMultiDrawElements(GL_TRIANGLE_STRIP, land_draw_counts.data(), GL_UNSIGNED_SHORT, land_draw_indices.data(), GLsizei(land_draw_indices.size()));
+	}
 
 	//glDrawArrays(GL_TRIANGLES, 0, land_vertex_count);
 	glDisable(GL_PRIMITIVE_RESTART);
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_terrain);
 	//glEnable(GL_CULL_FACE);
 	// Draw the rivers
 	if(state.user_settings.rivers_enabled) {
@@ -556,11 +654,24 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 
 		glBindVertexArray(vao_array[vo_river]);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo_array[vo_river]);
-		glMultiDrawArrays(GL_TRIANGLE_STRIP, river_starts.data(), river_counts.data(), GLsizei(river_starts.size()));
+		if(map_view_mode == map_view::flat) {
+			glMultiDrawArrays(GL_TRIANGLE_STRIP, river_starts.data(), river_counts.data(), GLsizei(river_starts.size()));
+		} else {
+			river_draw_starts.clear();
+			river_draw_counts.clear();
+			for(size_t i = 0; i < river_starts.size(); ++i) {
+				if(in_view(river_bounds[i])) {
+					river_draw_starts.push_back(river_starts[i]);
+					river_draw_counts.push_back(river_counts[i]);
+				}
+			}
+			if(!river_draw_starts.empty())
+				glMultiDrawArrays(GL_TRIANGLE_STRIP, river_draw_starts.data(), river_draw_counts.data(), GLsizei(river_draw_starts.size()));
+		}
 	}
 
 	// Draw the railroads
-	if(zoom > map::zoom_close && !railroad_vertices.empty()) {
+	if(zoom > map::zoom_close && !railroad_starts.empty()) {
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, textures[texture_railroad]);
 		glActiveTexture(GL_TEXTURE1);
@@ -577,6 +688,8 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glMultiDrawArrays(GL_TRIANGLE_STRIP, railroad_starts.data(), railroad_counts.data(), GLsizei(railroad_starts.size()));
 	}
 
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_rivers_and_railroads);
+
 	// Default border parameters
 	constexpr float border_type_national = 0.f;
 	constexpr float border_type_provincial = 1.f;
@@ -594,6 +707,27 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 
 	//glMultiDrawArrays(GL_TRIANGLE_STRIP, coastal_starts.data(), coastal_counts.data(), GLsizei(coastal_starts.size()));
 
+	/*
+	Each style of border is drawn with a single glMultiDrawArrays over the segments that currently have that style, rather
+	than with a draw call per segment. The geometry of the segments never changes; only which of them belong to which style.
+	*/
+	border_in_view.resize(borders.size());
+	for(size_t i = 0; i < borders.size(); ++i)
+		border_in_view[i] = uint8_t(map_view_mode == map_view::flat || in_view(border_bounds[i]));
+	auto draw_borders_if = [&](auto&& include) {
+		border_draw_starts.clear();
+		border_draw_counts.clear();
+		for(size_t i = 0; i < borders.size(); ++i) {
+			auto const& b = borders[i];
+			if(border_in_view[i] && include(b)) {
+				border_draw_starts.push_back(GLint(b.start_index));
+				border_draw_counts.push_back(GLsizei(b.count));
+			}
+		}
+		if(!border_draw_starts.empty())
+			glMultiDrawArrays(GL_TRIANGLE_STRIP, border_draw_starts.data(), border_draw_counts.data(), GLsizei(border_draw_starts.size()));
+	};
+
 	// impassible borders
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, textures[texture_provinces]);
@@ -605,74 +739,60 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_prov_border]);
 
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit | province::border::national_bit | province::border::state_bit)) == 0) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit | province::border::national_bit | province::border::state_bit)) == 0;
+			});
 		}
 		{ // Render state borders
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.0002f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_state_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit | province::border::national_bit | province::border::state_bit)) == province::border::state_bit) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit | province::border::national_bit | province::border::state_bit)) == province::border::state_bit;
+			});
 		}
 		{
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.00085f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_imp_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit)) == province::border::impassible_bit) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::impassible_bit)) == province::border::impassible_bit;
+			});
 		}
 		// national borders
 		{
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.0003f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_national_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::impassible_bit)) == province::border::national_bit) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::impassible_bit)) == province::border::national_bit;
+			});
 		}
 	} else {
 		if(zoom > map::zoom_very_close) { // Render province borders
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.0001f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_prov_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::state_bit)) == 0) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::state_bit)) == 0;
+			});
 		}
 		if(zoom > map::zoom_close) { // Render state borders
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.0002f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_state_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::state_bit)) == province::border::state_bit) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit | province::border::state_bit)) == province::border::state_bit;
+			});
 		}
 		// national borders
 		{
 			glUniform1f(shader_uniforms[shader_borders][uniform_width], 0.0003f); // width
 			glActiveTexture(GL_TEXTURE2);
 			glBindTexture(GL_TEXTURE_2D, textures[texture_state_border]);
-			for(auto b : borders) {
-				if((state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) == province::border::national_bit) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+			draw_borders_if([&](border const& b) {
+				return (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) == province::border::national_bit;
+			});
 		}
 	}
 	if(state.map_state.selected_province || (state.local_player_nation && state.current_scene.borders == game_scene::borders_granularity::nation)) {
@@ -680,38 +800,32 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, textures[texture_state_border]);
 		if(state.local_player_nation && state.current_scene.borders == game_scene::borders_granularity::nation) {
-			for(auto b : borders) {
+			draw_borders_if([&](border const& b) {
 				auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 				auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-				if((state.world.province_get_nation_from_province_ownership(p0) == state.local_player_nation
+				return (state.world.province_get_nation_from_province_ownership(p0) == state.local_player_nation
 					|| state.world.province_get_nation_from_province_ownership(p1) == state.local_player_nation)
-				&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) != 0) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+				&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) != 0;
+			});
 		} else if(state.current_scene.borders == game_scene::borders_granularity::state) {
 			auto owner = state.world.province_get_nation_from_province_ownership(state.map_state.selected_province);
 			if(owner) {
 				auto siid = state.world.province_get_state_membership(state.map_state.selected_province);
 				//per state
-				for(auto b : borders) {
+				draw_borders_if([&](border const& b) {
 					auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 					auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-					if((state.world.province_get_state_membership(p0) == siid
+					return (state.world.province_get_state_membership(p0) == siid
 						|| state.world.province_get_state_membership(p1) == siid)
-					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::state_bit | province::border::national_bit)) != 0) {
-						glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-					}
-				}
+					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::state_bit | province::border::national_bit)) != 0;
+				});
 			}
 		} else if(state.current_scene.borders == game_scene::borders_granularity::province) {
-			for(auto b : borders) {
+			draw_borders_if([&](border const& b) {
 				auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 				auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-				if(p0 == state.map_state.selected_province || p1 == state.map_state.selected_province) {
-					glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-				}
-			}
+				return p0 == state.map_state.selected_province || p1 == state.map_state.selected_province;
+			});
 		}
 	}
 	dcon::province_id prov{};
@@ -728,36 +842,30 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 			auto owner = state.world.province_get_nation_from_province_ownership(prov);
 			if(owner && state.current_scene.borders == game_scene::borders_granularity::nation) {
 				//per nation
-				for(auto b : borders) {
+				draw_borders_if([&](border const& b) {
 					auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 					auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-					if((state.world.province_get_nation_from_province_ownership(p0) == owner
+					return (state.world.province_get_nation_from_province_ownership(p0) == owner
 						|| state.world.province_get_nation_from_province_ownership(p1) == owner)
-					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) != 0) {
-						glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-					}
-				}
+					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::national_bit)) != 0;
+				});
 			} else if(owner && state.current_scene.borders == game_scene::borders_granularity::state) {
 				auto siid = state.world.province_get_state_membership(prov);
 				//per state
-				for(auto b : borders) {
+				draw_borders_if([&](border const& b) {
 					auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 					auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-					if((state.world.province_get_state_membership(p0) == siid
+					return (state.world.province_get_state_membership(p0) == siid
 						|| state.world.province_get_state_membership(p1) == siid)
-					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::state_bit | province::border::national_bit)) != 0) {
-						glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-					}
-				}
+					&& (state.world.province_adjacency_get_type(b.adj) & (province::border::non_adjacent_bit | province::border::coastal_bit | province::border::state_bit | province::border::national_bit)) != 0;
+				});
 			} else if(owner && state.current_scene.borders == game_scene::borders_granularity::province)  {
 				//per province
-				for(auto b : borders) {
+				draw_borders_if([&](border const& b) {
 					auto p0 = state.world.province_adjacency_get_connected_provinces(b.adj, 0);
 					auto p1 = state.world.province_adjacency_get_connected_provinces(b.adj, 1);
-					if(p0 == prov || p1 == prov) {
-						glDrawArrays(GL_TRIANGLE_STRIP, b.start_index, b.count);
-					}
-				}
+					return p0 == prov || p1 == prov;
+				});
 			}
 		}
 	}
@@ -770,6 +878,7 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glBindBuffer(GL_ARRAY_BUFFER, vbo_array[vo_coastal]);
 		glMultiDrawArrays(GL_TRIANGLE_STRIP, coastal_starts.data(), coastal_counts.data(), GLsizei(coastal_starts.size()));
 	}
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_borders);
 
 	if(zoom > map::zoom_close) { //only render if close enough
 		if(!unit_arrow_vertices.empty() || !attack_unit_arrow_vertices.empty() || !retreat_unit_arrow_vertices.empty()
@@ -830,6 +939,8 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		glDrawArrays(GL_TRIANGLES, 0, (GLsizei)drag_box_vertices.size());
 	}
 
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_unit_arrows);
+
 	if(state.user_settings.map_label != sys::map_label_mode::none) {
 		auto const& f = state.font_collection.get_font(state, text::font_selection::map_font);
 		load_shader(shader_text_line);
@@ -847,6 +958,8 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		}
 	}
 
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_text);
+
 		/*
 		else if(state.cheat_data.province_names) {
 			glUniform1f(15, 1.f);
@@ -1196,6 +1309,7 @@ void display_data::render(sys::state& state, glm::vec2 screen_size, glm::vec2 of
 		//glBindBuffer(GL_ARRAY_BUFFER, state.open_gl.msaa_vbo);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 	}
+	state.open_gl.frame_timings.end_pass(ogl::frame_profiler::map_resolve);
 }
 
 GLuint load_province_map(std::vector<uint16_t>& province_index, uint32_t size_x, uint32_t size_y) {
@@ -1257,7 +1371,45 @@ void display_data::set_selected_province(sys::state& state, dcon::province_id pr
 }
 
 void display_data::set_province_color(std::vector<uint32_t> const& prov_color) {
-	gen_prov_color_texture(texture_arrays[texture_array_province_color], prov_color, 2);
+	// the map mode is recalculated after every tick, and most of the time (paused, or a mode that only changes monthly)
+	// none of the colors have changed
+	if(prov_color == uploaded_province_color)
+		return;
+	if(prov_color.size() != uploaded_province_color.size() || prov_color.size() % (2 * 256) != 0) {
+		gen_prov_color_texture(texture_arrays[texture_array_province_color], prov_color, 2);
+		uploaded_province_color = prov_color;
+		return;
+	}
+
+	/*
+	Otherwise only the rows of the texture that contain a changed color are uploaded again, each run of changed rows
+	with a single call: an ownership change or a siege typically touches a handful of provinces, and so a row or two
+	*/
+	uint32_t const layer_size = uint32_t(prov_color.size() / 2);
+	uint32_t const rows = layer_size / 256;
+	auto row_changed = [&](uint32_t layer, uint32_t row) {
+		auto start = layer * layer_size + row * 256;
+		return !std::equal(prov_color.begin() + start, prov_color.begin() + start + 256, uploaded_province_color.begin() + start);
+	};
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture_arrays[texture_array_province_color]);
+	for(uint32_t layer = 0; layer < 2; ++layer) {
+		uint32_t row = 0;
+		while(row < rows) {
+			if(!row_changed(layer, row)) {
+				++row;
+				continue;
+			}
+			auto first_row = row;
+			while(row < rows && row_changed(layer, row))
+				++row;
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, first_row, layer, 256, row - first_row, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+					&prov_color[layer * layer_size + first_row * 256]);
+		}
+	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	uploaded_province_color = prov_color;
 }
 
 void add_drag_box_line(std::vector<screen_vertex>& drag_box_vertices, glm::vec2 pos1, glm::vec2 pos2, glm::vec2 size, bool vertical) {
@@ -1767,51 +1919,106 @@ void display_data::update_railroad_paths(sys::state& state) {
 		}
 	}
 
-	railroad_vertices.clear();
-	railroad_starts.clear();
-	railroad_counts.clear();
-	for(const auto& railroad : railroads) {
-		railroad_starts.push_back(GLint(railroad_vertices.size()));
-		glm::vec2 current_pos = railroad.back();
-		glm::vec2 next_pos = put_in_local(railroad[railroad.size() - 2], current_pos, float(size_x));
-		glm::vec2 prev_perpendicular = glm::normalize(next_pos - current_pos);
-		auto start_normal = glm::vec2(-prev_perpendicular.y, prev_perpendicular.x);
-		auto norm_pos = current_pos / glm::vec2(size_x, size_y);
-		railroad_vertices.emplace_back(textured_line_vertex{ norm_pos, +start_normal, 0.0f, 0.f });//C
-		railroad_vertices.emplace_back(textured_line_vertex{ norm_pos, -start_normal, 1.0f, 0.f });//D
-		float distance = 0.0f;
-		for(auto i = railroad.size() - 1; i-- > 0;) {
-			glm::vec2 next_perpendicular{ 0.0f, 0.0f };
-			next_pos = put_in_local(railroad[i], current_pos, float(size_x));
-			if(i > 0) {
-				glm::vec2 next_next_pos = put_in_local(railroad[i - 1], next_pos, float(size_x));
-				glm::vec2 a_per = glm::normalize(next_pos - current_pos);
-				glm::vec2 b_per = glm::normalize(next_pos - next_next_pos);
-				glm::vec2 temp = a_per + b_per;
-				if(glm::length(temp) < 0.00001f) {
-					next_perpendicular = -a_per;
+	// Sort the railroads into tiles by where they start, and only make new vertices for the tiles whose railroads changed
+	std::vector<std::vector<std::vector<glm::vec2>>> tile_paths(railroad_tiles_x * railroad_tiles_y);
+	for(auto& railroad : railroads) {
+		auto tx = std::clamp(int32_t(railroad.front().x * float(railroad_tiles_x) / float(size_x)), 0, int32_t(railroad_tiles_x) - 1);
+		auto ty = std::clamp(int32_t(railroad.front().y * float(railroad_tiles_y) / float(size_y)), 0, int32_t(railroad_tiles_y) - 1);
+		tile_paths[tx + ty * railroad_tiles_x].push_back(std::move(railroad));
+	}
+
+	bool relayout = railroad_tiles.size() != tile_paths.size();
+	railroad_tiles.resize(tile_paths.size());
+	std::vector<bool> tile_changed(tile_paths.size(), false);
+	for(uint32_t t = 0; t < uint32_t(tile_paths.size()); ++t) {
+		auto& tile = railroad_tiles[t];
+		if(tile.paths == tile_paths[t])
+			continue;
+		tile_changed[t] = true;
+		tile.paths = std::move(tile_paths[t]);
+		tile.vertices.clear();
+		tile.starts.clear();
+		tile.counts.clear();
+		for(const auto& railroad : tile.paths) {
+			tile.starts.push_back(GLint(tile.vertices.size()));
+			glm::vec2 current_pos = railroad.back();
+			glm::vec2 next_pos = put_in_local(railroad[railroad.size() - 2], current_pos, float(size_x));
+			glm::vec2 prev_perpendicular = glm::normalize(next_pos - current_pos);
+			auto start_normal = glm::vec2(-prev_perpendicular.y, prev_perpendicular.x);
+			auto norm_pos = current_pos / glm::vec2(size_x, size_y);
+			tile.vertices.emplace_back(textured_line_vertex{ norm_pos, +start_normal, 0.0f, 0.f });//C
+			tile.vertices.emplace_back(textured_line_vertex{ norm_pos, -start_normal, 1.0f, 0.f });//D
+			float distance = 0.0f;
+			for(auto i = railroad.size() - 1; i-- > 0;) {
+				glm::vec2 next_perpendicular{ 0.0f, 0.0f };
+				next_pos = put_in_local(railroad[i], current_pos, float(size_x));
+				if(i > 0) {
+					glm::vec2 next_next_pos = put_in_local(railroad[i - 1], next_pos, float(size_x));
+					glm::vec2 a_per = glm::normalize(next_pos - current_pos);
+					glm::vec2 b_per = glm::normalize(next_pos - next_next_pos);
+					glm::vec2 temp = a_per + b_per;
+					if(glm::length(temp) < 0.00001f) {
+						next_perpendicular = -a_per;
+					} else {
+						next_perpendicular = glm::normalize(glm::vec2{ -temp.y, temp.x });
+						if(glm::dot(a_per, -next_perpendicular) < glm::dot(a_per, next_perpendicular))
+							next_perpendicular *= -1.0f;
+					}
 				} else {
-					next_perpendicular = glm::normalize(glm::vec2{ -temp.y, temp.x });
-					if(glm::dot(a_per, -next_perpendicular) < glm::dot(a_per, next_perpendicular))
-						next_perpendicular *= -1.0f;
+					next_perpendicular = glm::normalize(current_pos - next_pos);
 				}
-			} else {
-				next_perpendicular = glm::normalize(current_pos - next_pos);
+				add_tl_bezier_to_buffer(tile.vertices, current_pos, next_pos, prev_perpendicular, next_perpendicular, 0.0f, false, float(size_x), float(size_y), default_num_b_segments, distance);
+				prev_perpendicular = -1.0f * next_perpendicular;
+				current_pos = railroad[i];
 			}
-			add_tl_bezier_to_buffer(railroad_vertices, current_pos, next_pos, prev_perpendicular, next_perpendicular, 0.0f, false, float(size_x), float(size_y), default_num_b_segments, distance);
-			prev_perpendicular = -1.0f * next_perpendicular;
-			current_pos = railroad[i];
+			tile.counts.push_back(GLsizei(tile.vertices.size() - tile.starts.back()));
+			assert(tile.counts.back() > 1);
 		}
-		railroad_counts.push_back(GLsizei(railroad_vertices.size() - railroad_starts.back()));
-		assert(railroad_counts.back() > 1);
+		assert(tile.counts.size() == tile.starts.size());
+		relayout = relayout || tile.vertices.size() > tile.capacity;
 	}
-	assert(railroad_counts.size() == railroad_starts.size());
 
-	if(!railroad_vertices.empty()) {
+	/*
+	Each tile has a stretch of the buffer to itself, with room to spare, so that a tile that changed can be rewritten in place
+	without moving the others. The vertices in the spare room are never drawn. Only when a tile outgrows its stretch is the
+	buffer laid out again and uploaded as a whole.
+	*/
+	if(relayout) {
+		uint32_t offset = 0;
+		for(auto& tile : railroad_tiles) {
+			tile.offset = offset;
+			tile.capacity = tile.vertices.empty() ? 0 : uint32_t(tile.vertices.size() + tile.vertices.size() / 2 + 64);
+			offset += tile.capacity;
+		}
+		railroad_vertices.assign(offset, textured_line_vertex{});
+		for(auto& tile : railroad_tiles)
+			std::copy(tile.vertices.begin(), tile.vertices.end(), railroad_vertices.begin() + tile.offset);
+		if(!railroad_vertices.empty()) {
+			glBindBuffer(GL_ARRAY_BUFFER, vbo_array[vo_railroad]);
+			glBufferData(GL_ARRAY_BUFFER, sizeof(textured_line_vertex) * railroad_vertices.size(), railroad_vertices.data(), GL_STATIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	} else {
 		glBindBuffer(GL_ARRAY_BUFFER, vbo_array[vo_railroad]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(textured_line_vertex) * railroad_vertices.size(), railroad_vertices.data(), GL_STATIC_DRAW);
+		for(uint32_t t = 0; t < uint32_t(railroad_tiles.size()); ++t) {
+			auto& tile = railroad_tiles[t];
+			if(!tile_changed[t] || tile.vertices.empty())
+				continue;
+			std::copy(tile.vertices.begin(), tile.vertices.end(), railroad_vertices.begin() + tile.offset);
+			glBufferSubData(GL_ARRAY_BUFFER, sizeof(textured_line_vertex) * tile.offset, sizeof(textured_line_vertex) * tile.vertices.size(), tile.vertices.data());
+		}
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
+
+	railroad_starts.clear();
+	railroad_counts.clear();
+	for(auto& tile : railroad_tiles) {
+		for(uint32_t i = 0; i < uint32_t(tile.starts.size()); ++i) {
+			railroad_starts.push_back(GLint(tile.offset) + tile.starts[i]);
+			railroad_counts.push_back(tile.counts[i]);
+		}
+	}
+	assert(railroad_counts.size() == railroad_starts.size());
 }
 
 void display_data::set_text_lines(sys::state& state, std::vector<text_line_generator_data> const& data) {
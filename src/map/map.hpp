@@ -8,6 +8,7 @@
 #include "map_modes.hpp"
 #include "opengl_wrapper.hpp"
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
 namespace sys {
@@ -89,6 +90,13 @@ struct border {
 	uint16_t padding = 0;
 };
 
+// A ball around a piece of map geometry as it lies on the globe (of radius 1, before it is rotated), so that the pieces on the
+// far side of the globe, or off the screen, can be left out of the draw calls; see display_data::render
+struct globe_bounds {
+	glm::vec3 center{ 0.f, 0.f, 0.f };
+	float radius = 0.f;
+};
+
 enum class map_view;
 class display_data {
 public:
@@ -112,16 +120,39 @@ public:
 	void set_province_text_lines(sys::state& state, std::vector<text_line_generator_data> const& data);
 
 	std::vector<border> borders;
+	std::vector<globe_bounds> border_bounds; // one for each of borders
 	std::vector<textured_line_vertex_b> border_vertices;
 	std::vector<textured_line_with_width_vertex> river_vertices;
 	std::vector<GLint> river_starts;
 	std::vector<GLsizei> river_counts;
-	std::vector<textured_line_vertex> railroad_vertices;
+	std::vector<globe_bounds> river_bounds; // one for each river
+	// the railroads starting in one part of the map, as last laid out; see update_railroad_paths
+	struct railroad_tile {
+		std::vector<std::vector<glm::vec2>> paths;
+		std::vector<textured_line_vertex> vertices;
+		std::vector<GLint> starts; // relative to offset
+		std::vector<GLsizei> counts;
+		uint32_t offset = 0; // where the tile's vertices start in railroad_vertices
+		uint32_t capacity = 0;
+	};
+	static constexpr uint32_t railroad_tiles_x = 16;
+	static constexpr uint32_t railroad_tiles_y = 8;
+	std::vector<railroad_tile> railroad_tiles;
+	std::vector<textured_line_vertex> railroad_vertices; // everything in the railroad buffer, tile by tile
 	std::vector<GLint> railroad_starts;
 	std::vector<GLsizei> railroad_counts;
 	std::vector<textured_line_vertex_b> coastal_vertices;
 	std::vector<GLint> coastal_starts;
 	std::vector<GLsizei> coastal_counts;
+	// scratch space for drawing the land borders of one style at a time
+	std::vector<GLint> border_draw_starts;
+	std::vector<GLsizei> border_draw_counts;
+	std::vector<uint8_t> border_in_view;
+	// scratch space for drawing the parts of the land and the rivers that can be seen on the globe
+	std::vector<void const*> land_draw_indices;
+	std::vector<GLsizei> land_draw_counts;
+	std::vector<GLint> river_draw_starts;
+	std::vector<GLsizei> river_draw_counts;
 	std::vector<GLint> static_mesh_starts;
 	std::vector<GLsizei> static_mesh_counts;
 	//
@@ -161,10 +192,19 @@ public:
 	// map pixel -> province id
 	std::vector<uint16_t> province_id_map;
 	std::vector<uint16_t> map_indices;
+	// the land mesh is laid out in map_indices chunk by chunk, each chunk a block of triangle strips of its own
+	std::vector<uint32_t> land_chunk_starts;
+	std::vector<GLsizei> land_chunk_counts;
+	std::vector<globe_bounds> land_chunk_bounds;
 
 	// province id mask to detect seas 
 	std::vector<uint32_t> province_id_sea_mask;
 
+	// the colors last given to set_province_color, as they are in the province color texture
+	std::vector<uint32_t> uploaded_province_color;
+	// the fog of war values as they are in the fog of war texture
+	std::vector<uint32_t> uploaded_province_fow;
+
 	uint32_t size_x;
 	uint32_t size_y;
 	uint32_t land_vertex_count = 0;
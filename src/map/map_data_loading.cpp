@@ -275,14 +275,20 @@ std::vector<uint8_t> load_bmp(parsers::scenario_building_context& context, nativ
 
 	// Fill the output with the given data - copy over the bmp data to the middle of the output_data
 	for(uint32_t y = top_free_space + size_y - 1; y >= uint32_t(top_free_space); --y) {
-		for(uint32_t x = 0; x < uint32_t(size_x); ++x) {
-			output_data[y * size_x + x] = *data;
-			data++;
-		}
+		std::copy_n(data, size_x, output_data.data() + y * size_x);
+		data += size_x;
 	}
 	return output_data;
 }
 
+// The per-province sums over the map (terrain histograms, mid points) are collected for this many stripes of the map in
+// parallel. The sums are integers, so adding up the stripes afterwards gives exactly the same result.
+constexpr int32_t reduction_stripes = 16;
+
+int stripe_start(int pixel_count, int32_t stripe) {
+	return int(int64_t(pixel_count) * stripe / reduction_stripes);
+}
+
 ankerl::unordered_dense::map<uint32_t, uint8_t> internal_make_index_map() {
 	ankerl::unordered_dense::map<uint32_t, uint8_t> m;
 
@@ -372,7 +378,8 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 		auto terrain_resolution = internal_make_index_map();
 
 		if(terrain_data.size_x == int32_t(size_x) && terrain_data.size_y == int32_t(size_y)) {
-			for(uint32_t ty = 0; ty < size_y; ++ty) {
+			// every row only writes its own pixels, and only reads the image and the index map
+			concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 				uint32_t y = size_y - ty - 1;
 				for(uint32_t x = 0; x < size_x; ++x) {
 
@@ -443,12 +450,12 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 
 					}
 				}
-			}
+			});
 		}
 	}
 
 	// Gets rid of any stray land terrain that has been painted outside the borders
-	for(uint32_t y = 0; y < size_y; ++y) {
+	concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t y) {
 		for(uint32_t x = 0; x < size_x; ++x) {
 			if(province_id_map[y * size_x + x] == 0) { // If there is no province define at that location
 				terrain_id_map[y * size_x + x] = uint8_t(255);
@@ -460,7 +467,7 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 				}
 			}
 		}
-	}
+	});
 
 	// Load the terrain
 	load_median_terrain_type(context);
@@ -471,12 +478,25 @@ void display_data::load_median_terrain_type(parsers::scenario_building_context&
 	median_terrain_type.resize(context.state.world.province_size() + 1);
 	province_area.resize(context.state.world.province_size() + 1);
 	std::vector<std::array<int, 64>> terrain_histogram(context.state.world.province_size() + 1, std::array<int, 64>{});
-	for(int i = size_x * size_y - 1; i-- > 0;) {
-		auto prov_id = province_id_map[i];
-		auto terrain_id = terrain_id_map[i];
-		if(terrain_id < 64)
-			terrain_histogram[prov_id][terrain_id] += 1;
-	}
+	// each stripe of the map is counted into its own histogram, and the counts added up afterwards
+	std::vector<std::vector<std::array<int, 64>>> stripe_histograms(reduction_stripes);
+	int pixel_count = int(size_x * size_y) - 1;
+	concurrency::parallel_for(0, reduction_stripes, [&](int32_t stripe) {
+		auto& histogram = stripe_histograms[stripe];
+		histogram.resize(terrain_histogram.size(), std::array<int, 64>{});
+		for(int i = stripe_start(pixel_count, stripe); i < stripe_start(pixel_count, stripe + 1); ++i) {
+			auto prov_id = province_id_map[i];
+			auto terrain_id = terrain_id_map[i];
+			if(terrain_id < 64)
+				histogram[prov_id][terrain_id] += 1;
+		}
+	});
+	concurrency::parallel_for(0, int32_t(terrain_histogram.size()), [&](int32_t i) {
+		for(auto& histogram : stripe_histograms) {
+			for(int j = 0; j < 64; ++j)
+				terrain_histogram[i][j] += histogram[i][j];
+		}
+	});
 
 	for(int i = context.state.world.province_size(); i-- > 1;) { // map-id province 0 == the invalid province; we don't need to collect data for it
 		int max_index = 64;
@@ -497,12 +517,28 @@ void display_data::load_median_terrain_type(parsers::scenario_building_context&
 void display_data::load_provinces_mid_point(parsers::scenario_building_context& context) {
 	std::vector<glm::ivec2> accumulated_tile_positions(context.state.world.province_size() + 1, glm::vec2(0));
 	std::vector<int> tiles_number(context.state.world.province_size() + 1, 0);
-	for(int i = size_x * size_y - 1; i-- > 0;) {
-		auto prov_id = province_id_map[i];
-		int x = i % size_x;
-		int y = i / size_x;
-		accumulated_tile_positions[prov_id] += glm::vec2(x, y);
-		tiles_number[prov_id]++;
+	// as for the terrain histograms, the sums are collected per stripe and added up afterwards
+	std::vector<std::vector<glm::ivec2>> stripe_positions(reduction_stripes);
+	std::vector<std::vector<int>> stripe_tiles(reduction_stripes);
+	int pixel_count = int(size_x * size_y) - 1;
+	concurrency::parallel_for(0, reduction_stripes, [&](int32_t stripe) {
+		auto& positions = stripe_positions[stripe];
+		auto& tiles = stripe_tiles[stripe];
+		positions.resize(accumulated_tile_positions.size(), glm::ivec2(0));
+		tiles.resize(tiles_number.size(), 0);
+		for(int i = stripe_start(pixel_count, stripe); i < stripe_start(pixel_count, stripe + 1); ++i) {
+			auto prov_id = province_id_map[i];
+			int x = i % size_x;
+			int y = i / size_x;
+			positions[prov_id] += glm::vec2(x, y);
+			tiles[prov_id]++;
+		}
+	});
+	for(int32_t stripe = 0; stripe < reduction_stripes; ++stripe) {
+		for(size_t i = 0; i < tiles_number.size(); ++i) {
+			accumulated_tile_positions[i] += stripe_positions[stripe][i];
+			tiles_number[i] += stripe_tiles[stripe][i];
+		}
 	}
 	// schombert: needs to start from +1 here or you don't catch the last province
 	for(int i = context.state.world.province_size() + 1; i-- > 1;) { // map-id province 0 == the invalid province; we don't need to collect data for it
@@ -533,33 +569,38 @@ void display_data::load_province_data(parsers::scenario_building_context& contex
 			province_id_map[i] = 0;
 		}
 		auto first_actual_map_pixel = top_free_space * size_x; // schombert: where the real data starts
-		for(; i < first_actual_map_pixel + image.size_x * image.size_y; ++i) {
-			uint8_t* ptr = image.data + (i - first_actual_map_pixel) * 4; // schombert: subtract to find our offset in the actual image data
-			auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
-			if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
-				assert(it->second);
-				province_id_map[i] = province::to_map_id(it->second);
-			} else {
-				province_id_map[i] = 0;
+		concurrency::parallel_for(0, image.size_y, [&](int32_t row) {
+			auto row_start = first_actual_map_pixel + uint32_t(row * image.size_x);
+			for(auto j = row_start; j < row_start + uint32_t(image.size_x); ++j) {
+				uint8_t* ptr = image.data + (j - first_actual_map_pixel) * 4; // schombert: subtract to find our offset in the actual image data
+				auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
+				if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
+					assert(it->second);
+					province_id_map[j] = province::to_map_id(it->second);
+				} else {
+					province_id_map[j] = 0;
+				}
 			}
-		}
+		});
+		i = first_actual_map_pixel + image.size_x * image.size_y;
 		for(; i < imsz; ++i) { // schombert: fill remainder with nothing
 			province_id_map[i] = 0;
 		}
 	} else {
 		province_id_map.resize(imsz);
-		for(uint32_t i = 0; i < imsz; ++i) {
-			auto map_x = i % size_x;
-			auto map_y = i / size_x;
-			uint8_t* ptr = image.data + (map_x + size_x * (size_y - map_y - 1)) * 4;
-			auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
-			if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
-				assert(it->second);
-				province_id_map[i] = province::to_map_id(it->second);
-			} else {
-				province_id_map[i] = 0;
+		concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t map_y) {
+			for(uint32_t map_x = 0; map_x < size_x; ++map_x) {
+				auto i = map_x + map_y * size_x;
+				uint8_t* ptr = image.data + (map_x + size_x * (size_y - map_y - 1)) * 4;
+				auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
+				if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
+					assert(it->second);
+					province_id_map[i] = province::to_map_id(it->second);
+				} else {
+					province_id_map[i] = 0;
+				}
 			}
-		}
+		});
 	}
 
 	load_provinces_mid_point(context);
@@ -598,7 +639,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 		std::vector<bmp_pixel_data> color_table;
 		river_data = load_bmp(context, NATIVE("rivers.bmp"), size, 255, &color_table);
 
-		for(uint32_t ty = 0; ty < size_y; ++ty) {
+		concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 			//uint32_t y = size_y - ty - 1;
 			for(uint32_t x = 0; x < size_x; ++x) {
 				uint8_t color_index = river_data[x + size_x * ty];
@@ -617,7 +658,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 					river_data[ty * size_x + x] = std::min<uint8_t>((uint8_t)250, std::max<uint8_t>((uint8_t)2, r / 3 + g / 3 + b / 3));
 				}
 			}
-		}
+		});
 
 	} else {
 		auto river_file = simple_fs::open_file(map_dir, NATIVE("alice_rivers.png"));
@@ -630,7 +671,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 		auto terrain_resolution = internal_make_index_map();
 
 		if(river_image_data.size_x == int32_t(size_x) && river_image_data.size_y == int32_t(size_y)) {
-			for(uint32_t ty = 0; ty < size_y; ++ty) {
+			concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 				uint32_t y = size_y - ty - 1;
 
 				for(uint32_t x = 0; x < size_x; ++x) {
@@ -646,7 +687,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 						river_data[ty * size_x + x] = 255;
 
 				}
-			}
+			});
 		}
 	}
 
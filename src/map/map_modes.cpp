@@ -47,15 +47,11 @@ std::vector<uint32_t> ideology_map_from(sys::state& state) {
 			if((full_color & 0xFF) + (full_color >> 8 & 0xFF) + (full_color >> 16 & 0xFF) > 140 * 3) {
 				empty_color = 0x222222;
 			}
-			auto const pkey = pop_demographics::to_key(state, fat_id.id);
+			auto const demo_key = demographics::to_key(state, fat_id.id);
 			state.world.for_each_province([&](dcon::province_id prov_id) {
 				auto i = province::to_map_id(prov_id);
-				float total = 0.f;
-				float value = 0.f;
-				for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
-					value += pop_demographics::get_demo(state, pl.get_pop(), pkey) * pl.get_pop().get_size();
-					total += pl.get_pop().get_size();
-				}
+				float total = state.world.province_get_demographics(prov_id, demographics::total);
+				float value = state.world.province_get_demographics(prov_id, demo_key);
 				auto ratio = value / total;
 				auto color = ogl::color_gradient(ratio, full_color, empty_color);
 				prov_color[i] = color;
@@ -114,15 +110,11 @@ std::vector<uint32_t> issue_map_from(sys::state& state) {
 			if((full_color & 0xFF) + (full_color >> 8 & 0xFF) + (full_color >> 16 & 0xFF) > 140 * 3) {
 				empty_color = 0x222222;
 			}
-			auto const pkey = pop_demographics::to_key(state, fat_id.id);
+			auto const demo_key = demographics::to_key(state, fat_id.id);
 			state.world.for_each_province([&](dcon::province_id prov_id) {
 				auto i = province::to_map_id(prov_id);
-				float total = 0.f;
-				float value = 0.f;
-				for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
-					value += pop_demographics::get_demo(state, pl.get_pop(), pkey) * pl.get_pop().get_size();
-					total += pl.get_pop().get_size();
-				}
+				float total = state.world.province_get_demographics(prov_id, demographics::total);
+				float value = state.world.province_get_demographics(prov_id, demo_key);
 				auto ratio = value / total;
 				auto color = ogl::color_gradient(ratio, full_color, empty_color);
 				prov_color[i] = color;
@@ -423,9 +415,9 @@ std::vector<uint32_t> life_needs_map_from(sys::state& state) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
 			auto fat_id = dcon::fatten(state.world, prov_id);
-			float population = 0.f;
-			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_life_needs(state, pl.get_pop()) * pl.get_pop().get_size();
+			float population = state.world.province_get_demographics(prov_id, demographics::poor_life_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::middle_life_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::rich_life_needs);
 			auto cid = fat_id.get_continent().id.index();
 			continent_max_pop[cid] = std::max(continent_max_pop[cid], population);
 			auto i = province::to_map_id(prov_id);
@@ -457,9 +449,9 @@ std::vector<uint32_t> everyday_needs_map_from(sys::state& state) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
 			auto fat_id = dcon::fatten(state.world, prov_id);
-			float population = 0.f;
-			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_everyday_needs(state, pl.get_pop()) * pl.get_pop().get_size();
+			float population = state.world.province_get_demographics(prov_id, demographics::poor_everyday_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::middle_everyday_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::rich_everyday_needs);
 			auto cid = fat_id.get_continent().id.index();
 			continent_max_pop[cid] = std::max(continent_max_pop[cid], population);
 			auto i = province::to_map_id(prov_id);
@@ -491,9 +483,9 @@ std::vector<uint32_t> luxury_needs_map_from(sys::state& state) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
 			auto fat_id = dcon::fatten(state.world, prov_id);
-			float population = 0.f;
-			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_luxury_needs(state, pl.get_pop()) * pl.get_pop().get_size();
+			float population = state.world.province_get_demographics(prov_id, demographics::poor_luxury_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::middle_luxury_needs)
+				+ state.world.province_get_demographics(prov_id, demographics::rich_luxury_needs);
 			auto cid = fat_id.get_continent().id.index();
 			continent_max_pop[cid] = std::max(continent_max_pop[cid], population);
 			auto i = province::to_map_id(prov_id);
@@ -714,12 +706,7 @@ std::vector<uint32_t> workforce_map_from(sys::state& state) {
 			float primary_percent = 0.f;
 			float secondary_percent = 0.f;
 			state.world.for_each_pop_type([&](dcon::pop_type_id id) {
-				float volume = 0.f;
-				for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
-					if(pl.get_pop().get_poptype() == id) {
-						volume += pl.get_pop().get_size();
-					}
-				}
+				float volume = state.world.province_get_demographics(prov_id, demographics::to_key(state, id));
 				float percent = volume / total_pops;
 				if(percent > primary_percent) {
 					secondary_id = primary_id;
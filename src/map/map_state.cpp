@@ -11,8 +11,6 @@
 #include "gui_graphics.hpp"
 #include "gui_element_base.hpp"
 
-#include <set>
-
 namespace map {
 
 dcon::province_id map_state::get_selected_province() {
@@ -232,12 +230,40 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 
 	// retroscipt
 	std::vector<text_line_generator_data> text_data;
-	std::vector<bool> visited(65536, false);
-	std::vector<bool> visited_sea_provinces(65536, false);
-	std::vector<bool> friendly_sea_provinces(65536, false);
+	static std::vector<uint8_t> visited;
+	visited.assign(65536, 0);
 	std::vector<uint16_t> group_of_regions;
+	// the regions of the group being labelled are marked with the number of the group
+	static std::vector<int32_t> region_group;
+	region_group.assign(65536, -1);
+	int32_t current_group = 0;
+
+	// The labels are laid out from the provinces of each region, so those are listed region by region (in province order),
+	// and from the graph of regions of the same top overlord, which is kept as sorted edge lists; both are flat, so that
+	// nothing below has to go through every province once per region.
+	static std::vector<dcon::nation_id> province_top_owner;
+	province_top_owner.resize(state.world.province_size());
+	for(auto p : state.world.in_province)
+		province_top_owner[p.id.index()] = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(p));
+
+	static std::vector<uint32_t> region_province_start;
+	static std::vector<dcon::province_id> region_provinces;
+	region_province_start.assign(65536 + 1, 0);
+	for(auto p : state.world.in_province)
+		++region_province_start[p.get_connected_region_id() + 1];
+	for(uint32_t i = 1; i < uint32_t(region_province_start.size()); ++i)
+		region_province_start[i] += region_province_start[i - 1];
+	region_provinces.resize(state.world.province_size());
+	{
+		static std::vector<uint32_t> next_slot;
+		next_slot.assign(region_province_start.begin(), region_province_start.end() - 1);
+		for(auto p : state.world.in_province)
+			region_provinces[next_slot[p.get_connected_region_id()]++] = p;
+	}
 
-	std::unordered_map<uint16_t, std::set<uint16_t>> regions_graph;
+	static std::vector<std::pair<uint16_t, uint16_t>> region_edges;
+	static std::vector<uint32_t> region_edge_start;
+	region_edges.clear();
 
 	int samples_N = 200;
 	int samples_M = 100;
@@ -264,7 +290,7 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 	for(auto candidate : state.world.in_province) {
 		auto rid = candidate.get_connected_region_id();
 
-		auto nation = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(candidate));
+		auto nation = province_top_owner[candidate.id.index()];
 
 		for(auto adj : candidate.get_province_adjacency()) {
 			auto indx = adj.get_connected_provinces(0) != candidate.id ? 0 : 1;
@@ -283,25 +309,33 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 					if(glm::distance(point_candidate, point_potential_friend) > map_data.size_x * 0.5f) {
 						// do nothing
 					} else if(neighbor_of_neighbor.id.index() < state.province_definitions.first_sea_province.index()) {
-						auto nation_2 = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(neighbor_of_neighbor));
+						auto nation_2 = province_top_owner[neighbor_of_neighbor.id.index()];
 						if(nation == nation_2)
-							regions_graph[rid].insert(neighbor_of_neighbor.get_connected_region_id());
+							region_edges.emplace_back(rid, neighbor_of_neighbor.get_connected_region_id());
 					}
 				}
 			} else {
-				auto nation_2 = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(neighbor));
+				auto nation_2 = province_top_owner[neighbor.id.index()];
 				if(nation == nation_2)
-					regions_graph[rid].insert(neighbor.get_connected_region_id());
+					region_edges.emplace_back(rid, neighbor.get_connected_region_id());
 			}
 		}
 	}
+	std::sort(region_edges.begin(), region_edges.end());
+	region_edges.erase(std::unique(region_edges.begin(), region_edges.end()), region_edges.end());
+	region_edge_start.assign(65536 + 1, 0);
+	for(auto& e : region_edges)
+		++region_edge_start[e.first + 1];
+	for(uint32_t i = 1; i < uint32_t(region_edge_start.size()); ++i)
+		region_edge_start[i] += region_edge_start[i - 1];
+
 	for(auto p : state.world.in_province) {
 		if(p.id.index() >= state.province_definitions.first_sea_province.index())
 			break;
 		auto rid = p.get_connected_region_id();
 		if(visited[uint16_t(rid)])
 			continue;
-		visited[uint16_t(rid)] = true;
+		visited[uint16_t(rid)] = 1;
 
 		auto n = p.get_nation_from_province_ownership();
 		n = get_top_overlord(state, n.id);
@@ -314,14 +348,18 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 		while(first_index < vacant_index) {
 			auto current_region = group_of_regions[first_index];
 			first_index++;
-			for(auto neighbour_region : regions_graph[current_region]) {
+			for(uint32_t i = region_edge_start[current_region]; i < region_edge_start[current_region + 1]; ++i) {
+				auto neighbour_region = region_edges[i].second;
 				if(!visited[neighbour_region]) {
 					group_of_regions.push_back(neighbour_region);
-					visited[neighbour_region] = true;
+					visited[neighbour_region] = 1;
 					vacant_index++;
 				}
 			}
 		}
+		++current_group;
+		for(auto visited_region : group_of_regions)
+			region_group[visited_region] = current_group;
 		if(!n || n.get_owned_province_count() == 0)
 			continue;
 
@@ -360,8 +398,9 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 			dcon::province_id last_province;
 			bool in_same_state = true;
 			for(auto visited_region : group_of_regions) {
-				for(auto candidate : state.world.in_province) {
-					if(candidate.get_connected_region_id() == visited_region) {
+				for(uint32_t k = region_province_start[visited_region]; k < region_province_start[visited_region + 1]; ++k) {
+					auto candidate = dcon::fatten(state.world, region_provinces[k]);
+					{
 						if(candidate.get_state_membership() != p.get_state_membership())
 							in_same_state = false;
 						++total_provinces;
@@ -434,8 +473,9 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 		float rough_box_top = 0;
 
 		for(auto visited_region : group_of_regions) {
-			for(auto candidate : state.world.in_province) {
-				if(candidate.get_connected_region_id() == visited_region) {
+			for(uint32_t k = region_province_start[visited_region]; k < region_province_start[visited_region + 1]; ++k) {
+				auto candidate = dcon::fatten(state.world, region_provinces[k]);
+				{
 					glm::vec2 mid_point = candidate.get_mid_point();
 
 					if(mid_point.x < rough_box_left) {
@@ -492,10 +532,8 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 				auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
 				if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
 					auto fat_id = dcon::fatten(state.world, province::from_map_id(map_data.province_id_map[idx]));
-					for(auto visited_region : group_of_regions) {
-						if(fat_id.get_connected_region_id() == visited_region) {
-							points.push_back(candidate);
-						}
+					if(region_group[fat_id.get_connected_region_id()] == current_group) {
+						points.push_back(candidate);
 					}
 				}
 			}
@@ -517,14 +555,13 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 				auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
 				if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
 					auto fat_id = dcon::fatten(state.world, province::from_map_id(map_data.province_id_map[idx]));
-					for(auto visited_region : group_of_regions)
-						if(fat_id.get_connected_region_id() == visited_region) {
-							points_above++;
-							current_length += local_step.x;
-							if(x < left_x) {
-								left_x = x;
-							}
+					if(region_group[fat_id.get_connected_region_id()] == current_group) {
+						points_above++;
+						current_length += local_step.x;
+						if(x < left_x) {
+							left_x = x;
 						}
+					}
 				}
 			}
 
@@ -1082,7 +1119,6 @@ void map_state::update(sys::state& state) {
 		}
 	}
 
-	static float keyboard_zoom_change = 0.f;
 	if(pgup_key_down) {
 		keyboard_zoom_change += 0.1f;
 	}
@@ -1120,6 +1156,27 @@ void map_state::update(sys::state& state) {
 	}
 }
 
+bool map_state::is_camera_moving(sys::state& state) {
+	if(is_dragging || unhandled_province_selection)
+		return true;
+	if(left_arrow_key_down || right_arrow_key_down || up_arrow_key_down || down_arrow_key_down || pgup_key_down || pgdn_key_down)
+		return true;
+	if(glm::length(pos_velocity) > 0.0001f || std::abs(zoom_change) > 0.001f || std::abs(keyboard_zoom_change) > 0.001f)
+		return true;
+	if(state.user_settings.mouse_edge_scrolling) {
+		glm::vec2 mouse_pos_percent{ state.mouse_x_position / float(state.x_size), state.mouse_y_position / float(state.y_size) };
+		if(mouse_pos_percent.x < 0.02f || mouse_pos_percent.x > 0.98f || mouse_pos_percent.y < 0.02f || mouse_pos_percent.y > 0.98f)
+			return true;
+	}
+	return false;
+}
+
+void map_state::stop_camera() {
+	pos_velocity = glm::vec2(0.f);
+	zoom_change = 0.f;
+	keyboard_zoom_change = 0.f;
+}
+
 void map_state::set_province_color(std::vector<uint32_t> const& prov_color, map_mode::mode new_map_mode) {
 	active_map_mode = new_map_mode;
 	map_data.set_province_color(prov_color);
@@ -51,6 +51,11 @@ public:
 	void on_rbutton_down(sys::state& state, int32_t x, int32_t y, int32_t screen_size_x, int32_t screen_size_y, sys::key_modifiers mod);
 	dcon::province_id get_province_under_mouse(sys::state& state, int32_t x, int32_t y, int32_t screen_size_x, int32_t screen_size_y);
 
+	// whether the camera is still moving: by momentum, with a key held down or with the mouse at the edge of the screen
+	bool is_camera_moving(sys::state& state);
+	// drops whatever momentum is too small to matter, so that it is not carried across a pause in the updates
+	void stop_camera();
+
 	dcon::province_id get_selected_province();
 	void set_selected_province(dcon::province_id prov_id);
 
@@ -88,6 +93,7 @@ public:
 	bool shift_key_down = false;
 	bool left_mouse_down = false;
 	glm::vec2 scroll_pos_velocity = glm::vec2(0.f);
+	float keyboard_zoom_change = 0.f;
 	std::vector<bool> visible_provinces;
 
 	void update(sys::state& state);
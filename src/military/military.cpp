@@ -445,9 +445,10 @@ bool compute_blockade_status(sys::state& state, dcon::province_id p) {
 }
 
 void update_blockade_status(sys::state& state) {
-	province::for_each_land_province(state, [&](dcon::province_id p) {
+	// provinces without a port are never blockaded, and no province gains or loses its port once the scenario is built
+	for(auto p : state.province_definitions.port_provinces) {
 		state.world.province_set_is_blockaded(p, compute_blockade_status(state, p));
-	});
+	}
 }
 
 bool province_is_under_siege(sys::state const& state, dcon::province_id ids) {
@@ -473,6 +474,10 @@ bool state_has_naval_base(sys::state const& state, dcon::state_instance_id si) {
 }
 
 bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	auto const& m = state.war_status;
+	if(a && b && uint32_t(a.index()) < m.size && uint32_t(b.index()) < m.size)
+		return ((m.bits[size_t(a.index()) * m.row_words + b.index() / 64] >> (b.index() % 64)) & 1) != 0;
+
 	for(auto wa : state.world.nation_get_war_participant(a)) {
 		auto is_attacker = wa.get_is_attacker();
 		for(auto o : wa.get_war().get_war_participant()) {
@@ -483,6 +488,35 @@ bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
 	return false;
 }
 
+void update_war_status_matrix(sys::state& state) {
+	auto& m = state.war_status;
+	m.size = state.world.nation_size();
+	m.row_words = (m.size + 63) / 64;
+	m.bits.assign(size_t(m.size) * m.row_words, 0);
+
+	// as in are_at_war, the first war the pair shares decides
+	std::vector<uint64_t> seen(m.row_words);
+	for(auto a : state.world.in_nation) {
+		auto wars = a.get_war_participant();
+		if(wars.begin() == wars.end())
+			continue;
+		std::fill(seen.begin(), seen.end(), uint64_t(0));
+		auto row = m.bits.data() + size_t(a.id.index()) * m.row_words;
+		for(auto wa : wars) {
+			auto is_attacker = wa.get_is_attacker();
+			for(auto o : wa.get_war().get_war_participant()) {
+				auto b = o.get_nation().id.index();
+				auto bit = uint64_t(1) << (b % 64);
+				if((seen[b / 64] & bit) != 0)
+					continue;
+				seen[b / 64] |= bit;
+				if(o.get_is_attacker() != is_attacker)
+					row[b / 64] |= bit;
+			}
+		}
+	}
+}
+
 bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
 	for(auto wa : state.world.nation_get_war_participant(a)) {
 		auto is_attacker = wa.get_is_attacker();
@@ -1166,6 +1200,7 @@ float mobilization_impact(sys::state const& state, dcon::nation_id n) {
 }
 
 void update_cbs(sys::state& state) {
+	auto const check_days = int32_t(std::max(state.defines.alice_cb_fabrication_check_days, 1.0f));
 	for(auto n : state.world.in_nation) {
 		if(state.current_date == n.get_reparations_until()) {
 			for(auto urel : n.get_unilateral_relationship_as_source()) {
@@ -1179,30 +1214,39 @@ void update_cbs(sys::state& state) {
 			}
 		}
 
+		auto cancel_fabrication = [&]() {
+			if(n == state.local_player_nation) {
+				notification::post(state, notification::message{
+					[](sys::state& state, text::layout_base& contents) {
+						text::add_line(state, contents, "msg_fab_canceled_1");
+					},
+					"msg_fab_canceled_title",
+					n, dcon::nation_id{}, dcon::nation_id{},
+					sys::message_base_type::cb_fab_cancelled
+				});
+			}
+
+			n.set_constructing_cb_is_discovered(false);
+			n.set_constructing_cb_progress(0.0f);
+			n.set_constructing_cb_target(dcon::nation_id{});
+			n.set_constructing_cb_type(dcon::cb_type_id{});
+		};
+
 		// check for cancellation
+		bool conditions_checked_today = false;
 		if(n.get_constructing_cb_type()) {
 			/*
 			CBs that become invalid (the nations involved no longer satisfy the conditions or enter into a war with each other)
 			are canceled (and the player should be notified in this event).
+			A war with the target or the target ceasing to exist is noticed on the day it happens. The conditions of the cb type
+			run its triggers, which is most of the cost here, so they are only checked every alice_cb_fabrication_check_days
+			days, on a day that depends on the nation so that the checks are spread out, and on the day the cb would be added.
 			*/
 			auto target = n.get_constructing_cb_target();
+			conditions_checked_today = (state.current_date.to_raw_value() + int32_t(n.id.index())) % check_days == 0;
 			if(military::are_at_war(state, n, target) || state.world.nation_get_owned_province_count(target) == 0 ||
-					!cb_conditions_satisfied(state, n, target, n.get_constructing_cb_type())) {
-				if(n == state.local_player_nation) {
-					notification::post(state, notification::message{
-						[](sys::state& state, text::layout_base& contents) {
-							text::add_line(state, contents, "msg_fab_canceled_1");
-						},
-						"msg_fab_canceled_title",
-						n, dcon::nation_id{}, dcon::nation_id{},
-						sys::message_base_type::cb_fab_cancelled
-					});
-				}
-
-				n.set_constructing_cb_is_discovered(false);
-				n.set_constructing_cb_progress(0.0f);
-				n.set_constructing_cb_target(dcon::nation_id{});
-				n.set_constructing_cb_type(dcon::cb_type_id{});
+					(conditions_checked_today && !cb_conditions_satisfied(state, n, target, n.get_constructing_cb_type()))) {
+				cancel_fabrication();
 			}
 		}
 
@@ -1235,7 +1279,10 @@ void update_cbs(sys::state& state) {
 			When fabrication progress reaches 100, the CB will remain valid for define:CREATED_CB_VALID_TIME months (so x30 days
 			for us). Note that pending CBs have their target nation fixed, but all other parameters are flexible.
 			*/
-			if(n.get_constructing_cb_progress() >= 100.0f) {
+			if(n.get_constructing_cb_progress() >= 100.0f && !conditions_checked_today
+				&& !cb_conditions_satisfied(state, n, n.get_constructing_cb_target(), n.get_constructing_cb_type())) {
+				cancel_fabrication();
+			} else if(n.get_constructing_cb_progress() >= 100.0f) {
 				add_cb(state, n, n.get_constructing_cb_type(), n.get_constructing_cb_target());
 
 				if(n == state.local_player_nation) {
@@ -2003,10 +2050,14 @@ void daily_leaders_update(sys::state& state) {
 	That is then the leader's current chance of death out of ... my notes say 11,000 here.
 	*/
 
-	for(uint32_t i = state.world.leader_size(); i-- > 0;) {
+	// Whether a leader dies does not depend on any other leader dying, so the rolls are made for all of them in parallel and
+	// only the deaths are carried out afterwards, in the same order as before (leader ids are stable under deletion).
+	static std::vector<uint8_t> leader_dies;
+	leader_dies.assign(state.world.leader_size(), 0);
+	concurrency::parallel_for(uint32_t(0), state.world.leader_size(), [&](uint32_t i) {
 		dcon::leader_id l{dcon::leader_id::value_base_t(i)};
 		if(!state.world.leader_is_valid(l))
-			continue;
+			return;
 
 		auto age_in_days = state.current_date.to_raw_value() - state.world.leader_get_since(l).to_raw_value();
 		if(age_in_days > 365 * 26) { // assume leaders are created at age 20; no death chance prior to 46
@@ -2029,8 +2080,13 @@ void daily_leaders_update(sys::state& state) {
 			auto rvalue = uint32_t(rng::get_random(state, uint32_t(l.index())) & 0xFFFFFFFF);
 
 			if(rvalue < int_chance)
-				kill_leader(state, l);
+				leader_dies[i] = 1;
 		}
+	});
+
+	for(uint32_t i = state.world.leader_size(); i-- > 0;) {
+		if(leader_dies[i])
+			kill_leader(state, dcon::leader_id{dcon::leader_id::value_base_t(i)});
 	}
 }
 
@@ -2113,6 +2169,7 @@ void add_to_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool as_at
 
 	auto participant = state.world.force_create_war_participant(w, n);
 	state.world.war_participant_set_is_attacker(participant, as_attacker);
+	update_war_status_matrix(state);
 	state.world.nation_set_is_at_war(n, true);
 	state.world.nation_set_disarmed_until(n, sys::date{});
 
@@ -2555,6 +2612,7 @@ void remove_from_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool
 	}
 
 	state.world.delete_war_participant(par);
+	update_war_status_matrix(state);
 	auto rem_wars = state.world.nation_get_war_participant(n);
 	if(rem_wars.begin() == rem_wars.end()) {
 		state.world.nation_set_is_at_war(n, false);
@@ -3916,6 +3974,48 @@ sys::date arrival_time_to(sys::state& state, dcon::navy_id n, dcon::province_id
 	return state.current_date + days;
 }
 
+void set_arrival_time(sys::state& state, dcon::army_id a, sys::date d) {
+	state.world.army_set_arrival_time(a, d);
+	if(d) {
+		std::lock_guard l{ state.unit_arrivals.lock };
+		state.unit_arrivals.armies[d.value].push_back(a);
+	}
+}
+void set_arrival_time(sys::state& state, dcon::navy_id n, sys::date d) {
+	state.world.navy_set_arrival_time(n, d);
+	if(d) {
+		std::lock_guard l{ state.unit_arrivals.lock };
+		state.unit_arrivals.navies[d.value].push_back(n);
+	}
+}
+
+void rebuild_arrival_calendar(sys::state& state) {
+	std::lock_guard l{ state.unit_arrivals.lock };
+	state.unit_arrivals.armies.clear();
+	state.unit_arrivals.navies.clear();
+	for(auto a : state.world.in_army) {
+		if(auto d = a.get_arrival_time(); d)
+			state.unit_arrivals.armies[d.value].push_back(a);
+	}
+	for(auto n : state.world.in_navy) {
+		if(auto d = n.get_arrival_time(); d)
+			state.unit_arrivals.navies[d.value].push_back(n);
+	}
+}
+
+// takes the units filed under the current day out of the calendar, in id order and without repeats
+template<typename T>
+static std::vector<T> take_arrivals(ankerl::unordered_dense::map<sys::date::value_base_t, std::vector<T>>& calendar, sys::date today) {
+	std::vector<T> result;
+	if(auto it = calendar.find(today.value); it != calendar.end()) {
+		result = std::move(it->second);
+		calendar.erase(it);
+	}
+	std::sort(result.begin(), result.end(), [](T a, T b) { return a.index() < b.index(); });
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
 void add_army_to_battle(sys::state& state, dcon::army_id a, dcon::land_battle_id b, war_role r) {
 	assert(state.world.army_is_valid(a));
 	bool battle_attacker = (r == war_role::attacker) == state.world.land_battle_get_war_attacker_is_attacker(b);
@@ -3988,7 +4088,7 @@ void add_army_to_battle(sys::state& state, dcon::army_id a, dcon::land_battle_id
 	}
 
 	state.world.army_set_battle_from_army_battle_participation(a, b);
-	state.world.army_set_arrival_time(a, sys::date{}); // pause movement
+	military::set_arrival_time(state, a, sys::date{}); // pause movement
 }
 
 void army_arrives_in_province(sys::state& state, dcon::army_id a, dcon::province_id p, crossing_type crossing, dcon::land_battle_id from) {
@@ -4186,10 +4286,10 @@ void add_navy_to_battle(sys::state& state, dcon::navy_id n, dcon::naval_battle_i
 	}
 
 	state.world.navy_set_battle_from_navy_battle_participation(n, b);
-	state.world.navy_set_arrival_time(n, sys::date{}); // pause movement
+	military::set_arrival_time(state, n, sys::date{}); // pause movement
 
 	for(auto em : state.world.navy_get_army_transport(n)) {
-		em.get_army().set_arrival_time(sys::date{});
+		military::set_arrival_time(state, em.get_army(), sys::date{});
 	}
 }
 
@@ -4206,7 +4306,7 @@ bool retreat(sys::state& state, dcon::navy_id n) {
 		auto existing_path = state.world.navy_get_path(n);
 		existing_path.load_range(retreat_path.data(), retreat_path.data() + retreat_path.size());
 
-		state.world.navy_set_arrival_time(n, arrival_time_to(state, n, retreat_path.back()));
+		military::set_arrival_time(state, n, arrival_time_to(state, n, retreat_path.back()));
 
 		for(auto em : state.world.navy_get_army_transport(n)) {
 			em.get_army().get_path().clear();
@@ -4230,7 +4330,7 @@ bool retreat(sys::state& state, dcon::army_id n) {
 		auto existing_path = state.world.army_get_path(n);
 		existing_path.load_range(retreat_path.data(), retreat_path.data() + retreat_path.size());
 
-		state.world.army_set_arrival_time(n, arrival_time_to(state, n, retreat_path.back()));
+		military::set_arrival_time(state, n, arrival_time_to(state, n, retreat_path.back()));
 		state.world.army_set_dig_in(n, 0);
 		return true;
 	} else {
@@ -4564,7 +4664,7 @@ void end_battle(sys::state& state, dcon::land_battle_id b, battle_result result)
 		} else {
 			auto path = n.get_army().get_path();
 			if(path.size() > 0) {
-				state.world.army_set_arrival_time(n.get_army(), arrival_time_to(state, n.get_army(), path.at(path.size() - 1)));
+				military::set_arrival_time(state, n.get_army(), arrival_time_to(state, n.get_army(), path.at(path.size() - 1)));
 			}
 		}
 	}
@@ -4776,13 +4876,13 @@ void end_battle(sys::state& state, dcon::naval_battle_id b, battle_result result
 		} else {
 			auto path = n.get_navy().get_path();
 			if(path.size() > 0) {
-				state.world.navy_set_arrival_time(n.get_navy(), arrival_time_to(state, n.get_navy(), path.at(path.size() - 1)));
+				military::set_arrival_time(state, n.get_navy(), arrival_time_to(state, n.get_navy(), path.at(path.size() - 1)));
 			}
 
 			for(auto em : n.get_navy().get_army_transport()) {
 				auto apath = em.get_army().get_path();
 				if(apath.size() > 0) {
-					state.world.army_set_arrival_time(em.get_army(), arrival_time_to(state, em.get_army(), apath.at(apath.size() - 1)));
+					military::set_arrival_time(state, em.get_army(), arrival_time_to(state, em.get_army(), apath.at(apath.size() - 1)));
 				}
 			}
 		}
@@ -5216,6 +5316,12 @@ void apply_regiment_damage(sys::state& state) {
 	}
 }
 
+/*
+Battles are resolved in parallel, one battle per task. This only works as long as the body of the task touches nothing
+but the battle itself and the regiments / ships fighting in it, and takes its randomness from the battle's own id, so
+that the outcome does not depend on which worker runs it. Anything with effects beyond the battle (ending it, retreats,
+battle reports) is only flagged in to_delete and carried out afterwards on a single thread, in battle id order.
+*/
 void update_land_battles(sys::state& state) {
 	auto isize = state.world.land_battle_size();
 	auto to_delete = ve::vectorizable_buffer<uint8_t, dcon::land_battle_id>(isize);
@@ -5337,29 +5443,97 @@ void update_land_battles(sys::state& state) {
 		float attacker_casualties = 0;
 		float defender_casualties = 0;
 
+		/*
+		The stats the damage formulas need for each regiment in the four lines are looked up once per battle, instead of once
+		for every exchange of fire the regiment takes part in. The exchanges themselves are still resolved slot by slot and in
+		the same order: a regiment may be hit from several slots, and each hit is limited by the strength it has left.
+		*/
+		struct line_entry {
+			sys::unit_variable_stats const* stats = nullptr;
+			float tactics = 0.0f; // military tactics modifier of the nation providing the technology
+			float organisation = 0.0f; // land organisation modifier of that nation
+			float maneuver = 0.0f;
+			unit_type type = unit_type::infantry;
+		};
+		std::array<line_entry, 30> att_back_info;
+		std::array<line_entry, 30> def_back_info;
+		std::array<line_entry, 30> att_front_info;
+		std::array<line_entry, 30> def_front_info;
+
+		auto load_line = [&](std::array<dcon::regiment_id, 30> const& line, std::array<line_entry, 30>& info) {
+			for(int32_t i = 0; i < combat_width; ++i) {
+				if(!line[i])
+					continue;
+				assert(state.world.regiment_is_valid(line[i]));
+				auto tech_nation = tech_nation_for_regiment(state, line[i]);
+				auto type = state.world.regiment_get_type(line[i]);
+				info[i].stats = &state.world.nation_get_unit_stats(tech_nation, type);
+				info[i].tactics = state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::military_tactics);
+				info[i].organisation = state.world.nation_get_modifier_values(tech_nation, sys::national_mod_offsets::land_organisation);
+				info[i].maneuver = state.military_definitions.unit_base_definitions[type].maneuver;
+				info[i].type = state.military_definitions.unit_base_definitions[type].type;
+			}
+		};
+		load_line(att_back, att_back_info);
+		load_line(def_back, def_back_info);
+		load_line(att_front, att_front_info);
+		load_line(def_front, def_front_info);
+
+		auto record_defender_loss = [&](unit_type type, float str_damage) {
+			switch(type) {
+				case unit_type::infantry:
+					state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
+					break;
+				case unit_type::cavalry:
+					state.world.land_battle_get_defender_cav_lost(b) += str_damage;
+					break;
+				case unit_type::support:
+					// fallthrough
+				case unit_type::special:
+					state.world.land_battle_get_defender_support_lost(b) += str_damage;
+					break;
+				default:
+					break;
+			}
+		};
+		auto record_attacker_loss = [&](unit_type type, float str_damage) {
+			switch(type) {
+				case unit_type::infantry:
+					state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
+					break;
+				case unit_type::cavalry:
+					state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
+					break;
+				case unit_type::support:
+					// fallthrough
+				case unit_type::special:
+					state.world.land_battle_get_attacker_support_lost(b) += str_damage;
+					break;
+				default:
+					break;
+			}
+		};
+
 		for(int32_t i = 0; i < combat_width; ++i) {
 			// Attackers backline shooting defenders frontline
 			if(att_back[i] && def_front[i]) {
 				assert(state.world.regiment_is_valid(att_back[i]) && state.world.regiment_is_valid(def_front[i]));
 
-				auto tech_att_nation = tech_nation_for_regiment(state, att_back[i]);
-				auto tech_def_nation = tech_nation_for_regiment(state, def_front[i]);
-
 				auto att_str = state.world.regiment_get_strength(att_back[i]);
 
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_back[i]));
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_front[i]));
+				auto& att_stats = *att_back_info[i].stats;
+				auto& def_stats = *def_front_info[i].stats;
 
 				auto& def_exp = state.world.regiment_get_experience(def_front[i]);
 
 				auto str_damage = att_str * str_dam_mul *
 						(att_stats.attack_or_gun_power * 0.1f + 1.0f) * att_stats.support * attacker_mod /
-						(defender_fort * (state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::military_tactics))
+						(defender_fort * (state.defines.base_military_tactics + def_front_info[i].tactics)
 							* (1 + def_exp));
 				auto org_damage = att_str * org_dam_mul *
 						(att_stats.attack_or_gun_power * 0.1f + 1.0f) * att_stats.support * attacker_mod /
 						(defender_fort * defender_org_bonus * def_stats.discipline_or_evasion *
-								(1.0f + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::land_organisation))
+								(1.0f + def_front_info[i].organisation)
 							* (1.0f + def_exp));
 
 				auto& cstr = state.world.regiment_get_strength(def_front[i]);
@@ -5372,39 +5546,21 @@ void update_land_battles(sys::state& state) {
 
 				auto& org = state.world.regiment_get_org(def_front[i]);
 				org = std::max(0.0f, org - org_damage);
-				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front[i])].type) {
-					case unit_type::infantry:
-						state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
-						break;
-					case unit_type::cavalry:
-						state.world.land_battle_get_defender_cav_lost(b) += str_damage;
-						break;
-					case unit_type::support:
-						// fallthrough
-					case unit_type::special:
-						state.world.land_battle_get_defender_support_lost(b) += str_damage;
-						break;
-					default:
-						break;
-				}
+				record_defender_loss(def_front_info[i].type, str_damage);
 			}
 
 			// Defence backline shooting attackers frontline
 			if(def_back[i] && att_front[i]) {
 				assert(state.world.regiment_is_valid(def_back[i]) && state.world.regiment_is_valid(att_front[i]));
 
-				auto tech_def_nation = tech_nation_for_regiment(state, def_back[i]);
-				auto tech_att_nation = tech_nation_for_regiment(state, att_front[i]);
-
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_back[i]));
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_front[i]));
+				auto& def_stats = *def_back_info[i].stats;
 
 				auto& atk_exp = state.world.regiment_get_experience(att_front[i]);
 
 				auto def_str = state.world.regiment_get_strength(def_back[i]);
 
-				auto str_damage = def_str * str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / ((state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::military_tactics)) * (1.f + atk_exp));
-				auto org_damage = def_str * org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::land_organisation)) * (1.f + atk_exp));
+				auto str_damage = def_str * str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / ((state.defines.base_military_tactics + att_front_info[i].tactics) * (1.f + atk_exp));
+				auto org_damage = def_str * org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + att_front_info[i].organisation) * (1.f + atk_exp));
 
 				auto& cstr = state.world.regiment_get_strength(att_front[i]);
 				str_damage = std::min(str_damage, cstr);
@@ -5416,45 +5572,30 @@ void update_land_battles(sys::state& state) {
 
 				auto& org = state.world.regiment_get_org(att_front[i]);
 				org = std::max(0.0f, org - org_damage);
-				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front[i])].type) {
-					case unit_type::infantry:
-						state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
-						break;
-					case unit_type::cavalry:
-						state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
-						break;
-					case unit_type::support:
-						// fallthrough
-					case unit_type::special:
-						state.world.land_battle_get_attacker_support_lost(b) += str_damage;
-						break;
-					default:
-						break;
-				}
+				record_attacker_loss(att_front_info[i].type, str_damage);
 			}
 
 			// Attackers frontline attacking defenders frontline targets
 			if(att_front[i]) {
 				assert(state.world.regiment_is_valid(att_front[i]));
 
-				auto tech_att_nation = tech_nation_for_regiment(state, att_front[i]);
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_front[i]));
+				auto& att_stats = *att_front_info[i].stats;
 
-				auto att_front_target = def_front[i];
-				if(auto mv = state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front[i])].maneuver; !att_front_target && mv > 0.0f) {
+				int32_t target_slot = def_front[i] ? i : -1;
+				if(auto mv = att_front_info[i].maneuver; target_slot == -1 && mv > 0.0f) {
 					for(int32_t cnt = 1; i - cnt * 2 >= 0 && cnt <= int32_t(mv); ++cnt) {
 						if(def_front[i - cnt * 2]) {
-							att_front_target = def_front[i - cnt * 2];
+							target_slot = i - cnt * 2;
 							break;
 						}
 					}
 				}
 
-				if(att_front_target) {
+				if(target_slot != -1) {
+					auto att_front_target = def_front[target_slot];
 					assert(state.world.regiment_is_valid(att_front_target));
 
-					auto tech_def_nation = tech_nation_for_regiment(state, att_front_target);
-					auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(att_front_target));
+					auto& def_stats = *def_front_info[target_slot].stats;
 
 					auto& def_exp = state.world.regiment_get_experience(att_front_target);
 
@@ -5462,11 +5603,11 @@ void update_land_battles(sys::state& state) {
 
 					auto str_damage = att_str * str_dam_mul *
 							(att_stats.attack_or_gun_power * 0.1f + 1.0f) * attacker_mod /
-							(defender_fort * (state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::military_tactics))
+							(defender_fort * (state.defines.base_military_tactics + def_front_info[target_slot].tactics)
 								* (1+ def_exp));
 					auto org_damage = att_str * org_dam_mul *
 							(att_stats.attack_or_gun_power * 0.1f + 1.0f) * attacker_mod /
-							(defender_fort * def_stats.discipline_or_evasion * defender_org_bonus * (1.0f + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::land_organisation))
+							(defender_fort * def_stats.discipline_or_evasion * defender_org_bonus * (1.0f + def_front_info[target_slot].organisation)
 								* (1 + def_exp));
 
 					auto& cstr = state.world.regiment_get_strength(att_front_target);
@@ -5479,21 +5620,7 @@ void update_land_battles(sys::state& state) {
 
 					auto& org = state.world.regiment_get_org(att_front_target);
 					org = std::max(0.0f, org - org_damage);
-					switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front_target)].type) {
-						case unit_type::infantry:
-							state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
-							break;
-						case unit_type::cavalry:
-							state.world.land_battle_get_defender_cav_lost(b) += str_damage;
-							break;
-						case unit_type::support:
-							// fallthrough
-						case unit_type::special:
-							state.world.land_battle_get_defender_support_lost(b) += str_damage;
-							break;
-						default:
-							break;
-					}
+					record_defender_loss(def_front_info[target_slot].type, str_damage);
 				}
 			}
 
@@ -5501,33 +5628,29 @@ void update_land_battles(sys::state& state) {
 			if(def_front[i]) {
 				assert(state.world.regiment_is_valid(def_front[i]));
 
-				auto tech_def_nation = tech_nation_for_regiment(state, def_front[i]);
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_front[i]));
+				auto& def_stats = *def_front_info[i].stats;
 
-				auto def_front_target = att_front[i];
-
-				if(auto mv = state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front[i])].maneuver; !def_front_target && mv > 0.0f) {
+				int32_t target_slot = att_front[i] ? i : -1;
+				if(auto mv = def_front_info[i].maneuver; target_slot == -1 && mv > 0.0f) {
 					for(int32_t cnt = 1; i - cnt * 2 >= 0 && cnt <= int32_t(mv); ++cnt) {
 						if(att_front[i - cnt * 2]) {
-							def_front_target = att_front[i - cnt * 2];
+							target_slot = i - cnt * 2;
 							break;
 						}
 					}
 				}
 
-				if(def_front_target) {
+				if(target_slot != -1) {
+					auto def_front_target = att_front[target_slot];
 					assert(state.world.regiment_is_valid(def_front_target));
 
-					auto tech_att_nation = tech_nation_for_regiment(state, def_front_target);
-					auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(def_front_target));
-
 					auto& atk_exp = state.world.regiment_get_experience(def_front_target);
 
 					auto def_str = state.world.regiment_get_strength(def_front[i]);
 
-					auto str_damage = def_str * str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / ((state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::military_tactics))
+					auto str_damage = def_str * str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / ((state.defines.base_military_tactics + att_front_info[target_slot].tactics)
 						* (1+ atk_exp));
-					auto org_damage = def_str * org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::land_organisation))
+					auto org_damage = def_str * org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + att_front_info[target_slot].organisation)
 						* (1+ atk_exp));
 
 					auto& cstr = state.world.regiment_get_strength(def_front_target);
@@ -5540,21 +5663,7 @@ void update_land_battles(sys::state& state) {
 
 					auto& org = state.world.regiment_get_org(def_front_target);
 					org = std::max(0.0f, org - org_damage);
-					switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front_target)].type) {
-						case unit_type::infantry:
-							state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
-							break;
-						case unit_type::cavalry:
-							state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
-							break;
-						case unit_type::support:
-							// fallthrough
-						case unit_type::special:
-							state.world.land_battle_get_attacker_support_lost(b) += str_damage;
-							break;
-						default:
-							break;
-					}
+					record_attacker_loss(att_front_info[target_slot].type, str_damage);
 				}
 			}
 		}
@@ -5752,6 +5861,7 @@ void update_land_battles(sys::state& state) {
 	}
 }
 
+// see update_land_battles for what may and may not happen inside the parallel section
 void update_naval_battles(sys::state& state) {
 	auto isize = state.world.naval_battle_size();
 	auto to_delete = ve::vectorizable_buffer<uint8_t, dcon::naval_battle_id>(isize);
@@ -6183,7 +6293,18 @@ void navy_arrives_in_province(sys::state& state, dcon::navy_id n, dcon::province
 }
 
 void update_movement(sys::state& state) {
-	for(auto a : state.world.in_army) {
+	std::vector<dcon::army_id> arriving_armies;
+	std::vector<dcon::navy_id> arriving_navies;
+	{
+		std::lock_guard l{ state.unit_arrivals.lock };
+		arriving_armies = take_arrivals(state.unit_arrivals.armies, state.current_date);
+		arriving_navies = take_arrivals(state.unit_arrivals.navies, state.current_date);
+	}
+
+	for(auto aid : arriving_armies) {
+		if(!state.world.army_is_valid(aid))
+			continue;
+		auto a = fatten(state.world, aid);
 		auto arrival = a.get_arrival_time();
 		assert(!arrival || arrival >= state.current_date);
 		if(auto path = a.get_path(); arrival == state.current_date) {
@@ -6254,9 +6375,9 @@ void update_movement(sys::state& state) {
 				// nothing -- movement paused
 			} else if(path.size() > 0) {
 				auto next_dest = path.at(path.size() - 1);
-				a.set_arrival_time(arrival_time_to(state, a, next_dest));
+				military::set_arrival_time(state, a, arrival_time_to(state, a, next_dest));
 			} else {
-				a.set_arrival_time(sys::date{});
+				military::set_arrival_time(state, a, sys::date{});
 				if(a.get_is_retreating()) {
 					a.set_is_retreating(false);
 					army_arrives_in_province(state, a, dest,
@@ -6291,7 +6412,10 @@ void update_movement(sys::state& state) {
 		}
 	}
 
-	for(auto n : state.world.in_navy) {
+	for(auto nid : arriving_navies) {
+		if(!state.world.navy_is_valid(nid))
+			continue;
+		auto n = fatten(state.world, nid);
 		auto arrival = n.get_arrival_time();
 		assert(!arrival || arrival >= state.current_date);
 		if(auto path = n.get_path(); arrival == state.current_date) {
@@ -6311,7 +6435,7 @@ void update_movement(sys::state& state) {
 
 						a.set_navy_from_army_transport(dcon::navy_id{});
 						a.get_path().clear();
-						a.set_arrival_time(sys::date{});
+						military::set_arrival_time(state, a, sys::date{});
 						auto acontroller = a.get_controller_from_army_control();
 
 						if(acontroller && !acontroller.get_is_player_controlled()) {
@@ -6327,7 +6451,7 @@ void update_movement(sys::state& state) {
 									for(uint32_t i = 0; i < new_size; ++i) {
 										existing_path[i] = apath[i];
 									}
-									a.set_arrival_time(military::arrival_time_to(state, a, apath.back()));
+									military::set_arrival_time(state, a, military::arrival_time_to(state, a, apath.back()));
 									a.set_dig_in(0);
 									auto activity = ai::army_activity(a.get_ai_activity());
 									if(activity == ai::army_activity::transport_guard) {
@@ -6355,7 +6479,7 @@ void update_movement(sys::state& state) {
 				for(auto a : state.world.navy_get_army_transport(n)) {
 					a.get_army().set_location_from_army_location(dest);
 					a.get_army().get_path().clear();
-					a.get_army().set_arrival_time(sys::date{});
+					military::set_arrival_time(state, a.get_army(), sys::date{});
 				}
 			}
 
@@ -6363,9 +6487,9 @@ void update_movement(sys::state& state) {
 				// nothing, movement paused
 			} else if(path.size() > 0) {
 				auto next_dest = path.at(path.size() - 1);
-				n.set_arrival_time(arrival_time_to(state, n, next_dest));
+				military::set_arrival_time(state, n, arrival_time_to(state, n, next_dest));
 			} else {
-				n.set_arrival_time(sys::date{});
+				military::set_arrival_time(state, n, sys::date{});
 				if(n.get_is_retreating()) {
 					if(dest.index() >= state.province_definitions.first_sea_province.index())
 						navy_arrives_in_province(state, n, dest, dcon::naval_battle_id{});
@@ -6479,7 +6603,7 @@ void send_rebel_hunter_to_next_province(sys::state& state, dcon::army_id ar, dco
 				existing_path.at(i) = path[i];
 			}
 
-			state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+			military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 			state.world.army_set_dig_in(a, 0);
 
 			break;
@@ -6501,7 +6625,7 @@ void send_rebel_hunter_to_next_province(sys::state& state, dcon::army_id ar, dco
 				existing_path.at(i) = path[i];
 			}
 
-			state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+			military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 			state.world.army_set_dig_in(a, 0);
 		}
 	}
@@ -6525,13 +6649,37 @@ bool siege_potential(sys::state& state, dcon::nation_id army_controller, dcon::n
 void update_siege_progress(sys::state& state) {
 	static auto new_nation_controller = ve::vectorizable_buffer<dcon::nation_id, dcon::province_id>(state.world.province_size());
 	static auto new_rebel_controller = ve::vectorizable_buffer<dcon::rebel_faction_id, dcon::province_id>(state.world.province_size());
-	province::ve_for_each_land_province(state, [&](auto ids) {
-		new_nation_controller.set(ids, dcon::nation_id{});
-		new_rebel_controller.set(ids, dcon::rebel_faction_id{});
+
+	/*
+	A province can only be under siege where an army that would siege it is standing, and the garrison of any other province
+	only changes while it is still recovering from an earlier siege. Every other province would be left exactly as it is, so
+	only these are looked at, in province order as before. In peacetime, without rebels, there are none.
+	*/
+	static std::vector<dcon::province_id> sieged_provinces;
+	sieged_provinces.clear();
+	for(auto ar : state.world.in_army) {
+		if(ar.get_battle_from_army_battle_participation() || ar.get_black_flag() || ar.get_navy_from_army_transport() || ar.get_arrival_time())
+			continue;
+		auto location = ar.get_location_from_army_location();
+		if(!location || location.id.index() >= state.province_definitions.first_sea_province.index())
+			continue;
+		if(siege_potential(state, ar.get_controller_from_army_control(), location.get_nation_from_province_control()))
+			sieged_provinces.push_back(location);
+	}
+	province::for_each_land_province(state, [&](dcon::province_id prov) {
+		if(state.world.province_get_siege_progress(prov) > 0.0f)
+			sieged_provinces.push_back(prov);
 	});
+	std::sort(sieged_provinces.begin(), sieged_provinces.end(), [](dcon::province_id a, dcon::province_id b) { return a.index() < b.index(); });
+	sieged_provinces.erase(std::unique(sieged_provinces.begin(), sieged_provinces.end()), sieged_provinces.end());
+
+	for(auto prov : sieged_provinces) {
+		new_nation_controller.set(prov, dcon::nation_id{});
+		new_rebel_controller.set(prov, dcon::rebel_faction_id{});
+	}
 
-	concurrency::parallel_for(0, state.province_definitions.first_sea_province.index(), [&](int32_t id) {
-		dcon::province_id prov{dcon::province_id::value_base_t(id)};
+	concurrency::parallel_for(0, int32_t(sieged_provinces.size()), [&](int32_t index) {
+		dcon::province_id prov = sieged_provinces[index];
 
 		auto controller = state.world.province_get_nation_from_province_control(prov);
 		auto owner = state.world.province_get_nation_from_province_ownership(prov);
@@ -6695,7 +6843,7 @@ void update_siege_progress(sys::state& state) {
 		}
 	});
 
-	province::for_each_land_province(state, [&](dcon::province_id prov) {
+	for(auto prov : sieged_provinces) {
 		if(auto nc = new_nation_controller.get(prov); nc) {
 			province::set_province_controller(state, prov, nc);
 			eject_ships(state, prov);
@@ -6758,7 +6906,7 @@ void update_siege_progress(sys::state& state) {
 				effect::execute(state, state.world.rebel_type_get_siege_won_effect(t), trigger::to_generic(prov), trigger::to_generic(prov), trigger::to_generic(nr), uint32_t(state.current_date.value), uint32_t(within.index() ^ (nr.index() << 4)));
 			}
 		}
-	});
+	}
 }
 
 void update_blackflag_status(sys::state& state, dcon::province_id p) {
@@ -6790,7 +6938,7 @@ void eject_ships(sys::state& state, dcon::province_id p) {
 		for(auto a : state.world.navy_get_army_transport(n)) {
 			a.get_army().set_location_from_army_location(sea_zone);
 			a.get_army().get_path().clear();
-			a.get_army().set_arrival_time(sys::date{});
+			military::set_arrival_time(state, a.get_army(), sys::date{});
 		}
 	}
 }
@@ -7409,7 +7557,7 @@ void move_land_to_merge(sys::state& state, dcon::nation_id by, dcon::army_id a,
 			assert(path[k]);
 			existing_path[k] = path[k];
 		}
-		state.world.army_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+		military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 		state.world.army_set_moving_to_merge(a, true);
 	}
 }
@@ -7444,7 +7592,7 @@ void move_navy_to_merge(sys::state& state, dcon::nation_id by, dcon::navy_id a,
 			assert(path[k]);
 			existing_path[k] = path[k];
 		}
-		state.world.navy_set_arrival_time(a, military::arrival_time_to(state, a, path.back()));
+		military::set_arrival_time(state, a, military::arrival_time_to(state, a, path.back()));
 		state.world.navy_set_moving_to_merge(a, true);
 	}
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include "dcon_generated.hpp"
 #include "container_types.hpp"
 #include "modifiers.hpp"
@@ -165,6 +166,24 @@ struct global_military_state {
 	bool pending_blackflag_update = false;
 };
 
+// Whether each pair of nations is at war, as are_at_war would find by walking the war participant lists, packed one bit
+// per pair. It must be rebuilt with update_war_status_matrix whenever a nation joins or leaves a war. Nations created
+// since the last rebuild are not covered, and are answered from the participant lists instead.
+struct war_status_matrix {
+	std::vector<uint64_t> bits; // size rows of row_words words
+	uint32_t size = 0;
+	uint32_t row_words = 0;
+};
+
+// Units filed under the day on which they next arrive somewhere, so that update_movement only has to look at the units
+// that move on the current day. Entries are not removed when a unit's movement changes; update_movement skips any unit
+// whose arrival time no longer matches the day it was filed under.
+struct arrival_calendar {
+	ankerl::unordered_dense::map<sys::date::value_base_t, std::vector<dcon::army_id>> armies;
+	ankerl::unordered_dense::map<sys::date::value_base_t, std::vector<dcon::navy_id>> navies;
+	std::mutex lock; // arrival times are also set from parallel sections, such as rebel movement
+};
+
 struct available_cb {
 	sys::date expiration; //2
 	dcon::nation_id target; //2
@@ -263,6 +282,7 @@ void apply_base_unit_stat_modifiers(sys::state& state);
 void restore_unsaved_values(sys::state& state); // must run after determining connectivity
 
 bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
+void update_war_status_matrix(sys::state& state);
 bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 bool are_in_common_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 void remove_from_common_allied_wars(sys::state& state, dcon::nation_id a, dcon::nation_id b);
@@ -435,6 +455,10 @@ float reinforce_amount(sys::state& state, dcon::army_id a);
 
 sys::date arrival_time_to(sys::state& state, dcon::army_id a, dcon::province_id p);
 sys::date arrival_time_to(sys::state& state, dcon::navy_id n, dcon::province_id p);
+// all changes to the arrival time of a unit must go through these, so that the unit is filed in the arrival calendar
+void set_arrival_time(sys::state& state, dcon::army_id a, sys::date d);
+void set_arrival_time(sys::state& state, dcon::navy_id n, sys::date d);
+void rebuild_arrival_calendar(sys::state& state);
 float fractional_distance_covered(sys::state& state, dcon::army_id a);
 float fractional_distance_covered(sys::state& state, dcon::navy_id a);
 
@@ -398,29 +398,67 @@ float prestige_score(sys::state const& state, dcon::nation_id n) {
 				 state.world.nation_get_modifier_values(n, sys::national_mod_offsets::permanent_prestige));
 }
 
+struct rank_sort_key {
+	int32_t group = 0; // compared before the score
+	float score = 0.0f;
+};
+
+// Puts the nations for which include is true into list, ordered by descending group, then descending score, then descending
+// index, and returns how many there are. Rankings rarely change from one day to the next, so the nations start out in the
+// order of their previous rank and are then put in order by insertion sort, which is close to linear for a nearly sorted list.
+template<typename I, typename P>
+static uint32_t order_nations_by_rank_key(sys::state& state, std::vector<dcon::nation_id>& list, std::vector<rank_sort_key> const& keys,
+		I const& include, P const& previous_rank) {
+	auto const nation_count = state.world.nation_size();
+	std::vector<dcon::nation_id> by_previous_rank(nation_count);
+	std::vector<dcon::nation_id> unranked;
+	state.world.for_each_nation([&](dcon::nation_id n) {
+		if(!include(n))
+			return;
+		auto r = uint32_t(previous_rank(n));
+		if(r != 0 && r <= nation_count && !by_previous_rank[r - 1])
+			by_previous_rank[r - 1] = n;
+		else
+			unranked.push_back(n);
+	});
+	uint32_t count = 0;
+	for(auto n : by_previous_rank) {
+		if(n)
+			list[count++] = n;
+	}
+	for(auto n : unranked)
+		list[count++] = n;
+
+	auto goes_before = [&](dcon::nation_id a, dcon::nation_id b) {
+		auto const& ka = keys[a.index()];
+		auto const& kb = keys[b.index()];
+		if(ka.group != kb.group)
+			return ka.group > kb.group;
+		if(ka.score != kb.score)
+			return ka.score > kb.score;
+		return a.index() > b.index(); // create a total order
+	};
+	for(uint32_t i = 1; i < count; ++i) {
+		auto n = list[i];
+		uint32_t j = i;
+		for(; j > 0 && goes_before(n, list[j - 1]); --j)
+			list[j] = list[j - 1];
+		list[j] = n;
+	}
+	return count;
+}
+
 void update_rankings(sys::state& state) {
-	uint32_t to_sort_count = 0;
+	// nations with provinces come first, then the civilized ones, then by total score
+	std::vector<rank_sort_key> keys(state.world.nation_size());
 	state.world.for_each_nation([&](dcon::nation_id n) {
-		state.nations_by_rank[to_sort_count] = n;
-		++to_sort_count;
+		auto fn = fatten(state.world, n);
+		keys[n.index()].group = (fn.get_owned_province_count() != 0 ? 2 : 0) + (fn.get_is_civilized() ? 1 : 0);
+		keys[n.index()].score = fn.get_military_score() + fn.get_industrial_score() + prestige_score(state, n);
 	});
-	std::sort(state.nations_by_rank.begin(), state.nations_by_rank.begin() + to_sort_count,
-			[&](dcon::nation_id a, dcon::nation_id b) {
-				auto fa = fatten(state.world, a);
-				auto fb = fatten(state.world, b);
-				if((fa.get_owned_province_count() != 0) != (fb.get_owned_province_count() != 0)) {
-					return (fa.get_owned_province_count() != 0);
-				}
-				if(fa.get_is_civilized() != fb.get_is_civilized())
-					return fa.get_is_civilized();
-				if(bool(fa.get_overlord_as_subject().get_ruler()) != bool(fa.get_overlord_as_subject().get_ruler()))
-					return !bool(fa.get_overlord_as_subject().get_ruler());
-				auto a_score = fa.get_military_score() + fa.get_industrial_score() + prestige_score(state, a);
-				auto b_score = fb.get_military_score() + fb.get_industrial_score() + prestige_score(state, b);
-				if(a_score != b_score)
-					return a_score > b_score;
-				return a.index() > b.index(); // create a total order
-			});
+	uint32_t to_sort_count = order_nations_by_rank_key(state, state.nations_by_rank, keys,
+			[](dcon::nation_id) { return true; },
+			[&](dcon::nation_id n) { return state.world.nation_get_rank(n); });
 	if(to_sort_count < state.nations_by_rank.size()) {
 		state.nations_by_rank[to_sort_count] = dcon::nation_id{};
 	}
@@ -430,69 +468,25 @@ void update_rankings(sys::state& state) {
 }
 
 void update_ui_rankings(sys::state& state) {
-	uint32_t to_sort_count = 0;
-	state.world.for_each_nation([&](dcon::nation_id n) {
-		if(state.world.nation_get_owned_province_count(n) != 0) {
-			state.nations_by_industrial_score[to_sort_count] = n;
-			state.nations_by_military_score[to_sort_count] = n;
-			state.nations_by_prestige_score[to_sort_count] = n;
-			++to_sort_count;
-		}
-	});
-	std::sort(state.nations_by_industrial_score.begin(), state.nations_by_industrial_score.begin() + to_sort_count,
-			[&](dcon::nation_id a, dcon::nation_id b) {
-				auto fa = fatten(state.world, a);
-				auto fb = fatten(state.world, b);
-				if(fa.get_is_civilized() && !fb.get_is_civilized())
-					return true;
-				if(!fa.get_is_civilized() && fb.get_is_civilized())
-					return false;
-				if(bool(fa.get_overlord_as_subject()) && !bool(fa.get_overlord_as_subject()))
-					return false;
-				if(!bool(fa.get_overlord_as_subject()) && bool(fa.get_overlord_as_subject()))
-					return true;
-				auto a_score = fa.get_industrial_score();
-				auto b_score = fb.get_industrial_score();
-				if(a_score != b_score)
-					return a_score > b_score;
-				return a.index() > b.index();
-			});
-	std::sort(state.nations_by_military_score.begin(), state.nations_by_military_score.begin() + to_sort_count,
-			[&](dcon::nation_id a, dcon::nation_id b) {
-				auto fa = fatten(state.world, a);
-				auto fb = fatten(state.world, b);
-				if(fa.get_is_civilized() && !fb.get_is_civilized())
-					return true;
-				if(!fa.get_is_civilized() && fb.get_is_civilized())
-					return false;
-				if(bool(fa.get_overlord_as_subject()) && !bool(fa.get_overlord_as_subject()))
-					return false;
-				if(!bool(fa.get_overlord_as_subject()) && bool(fa.get_overlord_as_subject()))
-					return true;
-				auto a_score = fa.get_military_score();
-				auto b_score = fb.get_military_score();
-				if(a_score != b_score)
-					return a_score > b_score;
-				return a.index() > b.index();
-			});
-	std::sort(state.nations_by_prestige_score.begin(), state.nations_by_prestige_score.begin() + to_sort_count,
-			[&](dcon::nation_id a, dcon::nation_id b) {
-				auto fa = fatten(state.world, a);
-				auto fb = fatten(state.world, b);
-				if(fa.get_is_civilized() && !fb.get_is_civilized())
-					return true;
-				if(!fa.get_is_civilized() && fb.get_is_civilized())
-					return false;
-				if(bool(fa.get_overlord_as_subject()) && !bool(fa.get_overlord_as_subject()))
-					return false;
-				if(!bool(fa.get_overlord_as_subject()) && bool(fa.get_overlord_as_subject()))
-					return true;
-				auto a_score = prestige_score(state, a);
-				auto b_score = prestige_score(state, b);
-				if(a_score != b_score)
-					return a_score > b_score;
-				return a.index() > b.index();
-			});
+	auto has_provinces = [&](dcon::nation_id n) { return state.world.nation_get_owned_province_count(n) != 0; };
+	// civilized nations come first, then by the score
+	std::vector<rank_sort_key> keys(state.world.nation_size());
+	auto order_by = [&](std::vector<dcon::nation_id>& list, auto const& score, auto const& previous_rank) {
+		state.world.for_each_nation([&](dcon::nation_id n) {
+			keys[n.index()].group = state.world.nation_get_is_civilized(n) ? 1 : 0;
+			keys[n.index()].score = score(n);
+		});
+		return order_nations_by_rank_key(state, list, keys, has_provinces, previous_rank);
+	};
+	uint32_t to_sort_count = order_by(state.nations_by_industrial_score,
+			[&](dcon::nation_id n) { return state.world.nation_get_industrial_score(n); },
+			[&](dcon::nation_id n) { return state.world.nation_get_industrial_rank(n); });
+	order_by(state.nations_by_military_score,
+			[&](dcon::nation_id n) { return state.world.nation_get_military_score(n); },
+			[&](dcon::nation_id n) { return state.world.nation_get_military_rank(n); });
+	order_by(state.nations_by_prestige_score,
+			[&](dcon::nation_id n) { return prestige_score(state, n); },
+			[&](dcon::nation_id n) { return state.world.nation_get_prestige_rank(n); });
 	for(uint32_t i = 0; i < to_sort_count; ++i) {
 		state.world.nation_set_industrial_rank(state.nations_by_industrial_score[i], uint16_t(i + 1));
 		state.world.nation_set_military_rank(state.nations_by_military_score[i], uint16_t(i + 1));
@@ -1304,6 +1298,7 @@ void cleanup_nation(sys::state& state, dcon::nation_id n) {
 	state.world.delete_nation(n);
 	auto new_ident_holder = state.world.create_nation();
 	state.world.try_create_identity_holder(new_ident_holder, old_ident);
+	military::update_war_status_matrix(state);
 
 	for(auto o : state.world.in_nation) {
 		if(o.get_in_sphere_of() == n) {
@@ -2858,7 +2853,7 @@ void make_civilized(sys::state& state, dcon::nation_id n) {
 	for(auto r : state.world.in_reform) {
 		state.world.nation_set_reforms(n, r, dcon::reform_option_id{});
 	}
-	sys::update_single_nation_modifiers(state, n);
+	sys::update_nation_modifiers_soon(state, n);
 	culture::update_nation_issue_rules(state, n);
 
 	event::fire_fixed_event(state, state.national_definitions.on_civilize, trigger::to_generic(n), event::slot_type::nation, n, -1,
@@ -2885,7 +2880,7 @@ void make_uncivilized(sys::state& state, dcon::nation_id n) {
 	for(auto r : state.world.in_reform) {
 		state.world.nation_set_reforms(n, r, dcon::reform_option_id{});
 	}
-	sys::update_single_nation_modifiers(state, n);
+	sys::update_nation_modifiers_soon(state, n);
 	culture::update_nation_issue_rules(state, n);
 }
 
@@ -2931,7 +2926,7 @@ void enact_reform(sys::state& state, dcon::nation_id source, dcon::reform_option
 	state.world.nation_set_reforms(source, state.world.reform_option_get_parent_reform(r), r);
 
 	culture::update_nation_issue_rules(state, source);
-	sys::update_single_nation_modifiers(state, source);
+	sys::update_nation_modifiers_soon(state, source);
 }
 
 void enact_issue(sys::state& state, dcon::nation_id source, dcon::issue_option_id i) {
@@ -3034,7 +3029,7 @@ void enact_issue(sys::state& state, dcon::nation_id source, dcon::issue_option_i
 	state.world.nation_set_issues(source, issue, i);
 
 	culture::update_nation_issue_rules(state, source);
-	sys::update_single_nation_modifiers(state, source);
+	sys::update_nation_modifiers_soon(state, source);
 
 	state.world.nation_set_last_issue_or_reform_change(source, state.current_date);
 }
@@ -15,6 +15,7 @@
 #include <ip2string.h>
 #include "pcp.h"
 #else // NIX
+#include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <netdb.h>
@@ -23,6 +24,8 @@
 #include <unistd.h>
 #endif // ...
 #include <string_view>
+#include <thread>
+#include <chrono>
 #include "system_state.hpp"
 #include "commands.hpp"
 #include "SPSCQueue.h"
@@ -33,6 +36,7 @@
 #define ZSTD_STATIC_LINKING_ONLY
 #define XXH_NAMESPACE ZSTD_
 #include "zstd.h"
+#include "blake2.h"
 
 #ifdef _WIN64
 #pragma comment(lib, "Iphlpapi.lib")
@@ -315,6 +319,9 @@ static int socket_recv(socket_t socket_fd, void* data, size_t len, size_t* m, F&
 			}
 			return err;
 #else
+			if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+				return 0; // nothing to read, or no room to write, right now
+			}
 			return r;
 #endif
 		} else if(r == 0) {
@@ -330,11 +337,12 @@ static int socket_recv(socket_t socket_fd, void* data, size_t len, size_t* m, F&
 	return 0;
 }
 
-static int socket_send(socket_t socket_fd, std::vector<char>& buffer) {
-	while(!buffer.empty()) {
-		int r = internal_socket_send(socket_fd, buffer.data(), buffer.size());
+// sends as much of the n bytes at data as the socket takes right now, counting them in *sent
+static int socket_send_bytes(socket_t socket_fd, char const* data, size_t n, size_t* sent) {
+	while(*sent < n) {
+		int r = internal_socket_send(socket_fd, data + *sent, n - *sent);
 		if(r > 0) {
-			buffer.erase(buffer.begin(), buffer.begin() + static_cast<size_t>(r));
+			*sent += static_cast<size_t>(r);
 		} else if(r < 0) {
 #ifdef _WIN32
 			int err = WSAGetLastError();
@@ -343,6 +351,9 @@ static int socket_send(socket_t socket_fd, std::vector<char>& buffer) {
 			}
 			return err;
 #else
+			if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+				return 0; // nothing to read, or no room to write, right now
+			}
 			return r;
 #endif
 		} else if(r == 0) {
@@ -352,11 +363,110 @@ static int socket_send(socket_t socket_fd, std::vector<char>& buffer) {
 	return 0;
 }
 
+static int socket_send(socket_t socket_fd, std::vector<char>& buffer, size_t n) {
+	size_t sent = 0;
+	int r = socket_send_bytes(socket_fd, buffer.data(), n, &sent);
+	buffer.erase(buffer.begin(), buffer.begin() + sent);
+	return r;
+}
+static int socket_send(socket_t socket_fd, std::vector<char>& buffer) {
+	return socket_send(socket_fd, buffer, buffer.size());
+}
+
+// puts what is left of the save being streamed to the client back in line in its send buffer as a plain copy
+static void unshare_save_stream(client_data& client) {
+	if(client.save_stream) {
+		auto& stream = *client.save_stream;
+		client.send_buffer.insert(client.send_buffer.begin() + client.save_stream_after, stream.begin() + client.save_stream_sent, stream.end());
+		client.save_stream.reset();
+		client.save_stream_after = 0;
+		client.save_stream_sent = 0;
+	}
+}
+
+// the send buffer of a client in game, with the save being streamed to it (if any) spliced in at its place
+static int socket_send_to_client(client_data& client) {
+	if(client.save_stream) {
+		if(client.save_stream_after > 0) {
+			auto old_size = client.send_buffer.size();
+			int r = socket_send(client.socket_fd, client.send_buffer, client.save_stream_after);
+			client.save_stream_after -= old_size - client.send_buffer.size();
+			if(r != 0 || client.save_stream_after > 0)
+				return r;
+		}
+		auto& stream = *client.save_stream;
+		int r = socket_send_bytes(client.socket_fd, reinterpret_cast<char const*>(stream.data()), stream.size(), &client.save_stream_sent);
+		if(r != 0 || client.save_stream_sent < stream.size())
+			return r;
+		client.save_stream.reset();
+		client.save_stream_sent = 0;
+	}
+	return socket_send(client.socket_fd, client.send_buffer);
+}
+
 static void socket_add_to_send_queue(std::vector<char>& buffer, const void *data, size_t n) {
 	buffer.resize(buffer.size() + n);
 	std::memcpy(buffer.data() + buffer.size() - n, data, n);
 }
 
+// writes the wire format of the command to ptr, returning its length
+static size_t write_command_wire_format(uint8_t* ptr, command::payload const& c) {
+	auto data_size = command::payload_data_size(c.type);
+	std::memcpy(ptr, &c.type, sizeof(c.type));
+	std::memcpy(ptr + sizeof(c.type), &c.source, sizeof(c.source));
+	std::memcpy(ptr + command_wire_header_size, &c.data, data_size);
+	return command_wire_header_size + data_size;
+}
+
+static void socket_add_command_to_send_queue(std::vector<char>& buffer, command::payload const& c) {
+	std::array<uint8_t, command_wire_max_size> wire;
+	socket_add_to_send_queue(buffer, wire.data(), write_command_wire_format(wire.data(), c));
+}
+
+// like socket_recv, but for a single command in its wire format, which is decoded into `out` before calling func
+template<typename F>
+static int socket_recv_command(socket_t socket_fd, std::array<uint8_t, command_wire_max_size>& wire_buffer, command::payload& out, size_t* m, F&& func) {
+	// the header is read on its own first, since it determines the length of the rest
+	auto wire_length = [&]() {
+		if(*m < command_wire_header_size)
+			return command_wire_header_size;
+		command::command_type t;
+		std::memcpy(&t, wire_buffer.data(), sizeof(t));
+		return command_wire_header_size + std::min(command::payload_data_size(t), sizeof(command::payload::dtype));
+	};
+	while(*m < wire_length()) {
+		int r = internal_socket_recv(socket_fd, wire_buffer.data() + *m, wire_length() - *m);
+		if(r > 0) {
+			*m += static_cast<size_t>(r);
+		} else if(r < 0) { // error
+#ifdef _WIN32
+			int err = WSAGetLastError();
+			if(err == WSAENOBUFS || err == WSAEWOULDBLOCK) {
+				return 0;
+			}
+			return err;
+#else
+			if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+				return 0; // nothing to read, or no room to write, right now
+			}
+			return r;
+#endif
+		} else if(r == 0) {
+			break;
+		}
+	}
+	// Did we receive a command?
+	if(*m >= command_wire_header_size && *m >= wire_length()) {
+		assert(*m == wire_length());
+		std::memcpy(&out.type, wire_buffer.data(), sizeof(out.type));
+		std::memcpy(&out.source, wire_buffer.data() + sizeof(out.type), sizeof(out.source));
+		std::memcpy(&out.data, wire_buffer.data() + command_wire_header_size, *m - command_wire_header_size);
+		*m = 0; // reset
+		func();
+	}
+	return 0;
+}
+
 static void socket_shutdown(socket_t socket_fd) {
 	if(socket_fd > 0) {
 #ifdef _WIN64
@@ -535,8 +645,13 @@ static void disconnect_client(sys::state& state, client_data& client, bool grace
 	client.send_buffer.clear();
 	client.early_send_buffer.clear();
 	client.total_sent_bytes = 0;
+	client.save_stream.reset();
+	client.save_stream_after = 0;
+	client.save_stream_sent = 0;
 	client.save_stream_size = 0;
 	client.save_stream_offset = 0;
+	client.telemetry = client_telemetry{};
+	client.acked_date = sys::date{};
 	client.playing_as = dcon::nation_id{};
 	client.recv_count = 0;
 	client.handshake = true;
@@ -551,6 +666,14 @@ static uint8_t* write_network_compressed_section(uint8_t* ptr_out, uint8_t const
 	return ptr_out + sizeof(uint32_t) * 2 + section_length;
 }
 
+// the compressed section trimmed to its actual size, since it is kept around for as long as clients may join
+static std::shared_ptr<std::vector<uint8_t> const> make_network_compressed_section(uint8_t const* ptr_in, uint32_t uncompressed_size) {
+	// this is an upper bound, since compacting the data may require less space
+	auto temp_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[ZSTD_compressBound(uncompressed_size) + sizeof(uint32_t) * 2]);
+	auto end = write_network_compressed_section(temp_buffer.get(), ptr_in, uncompressed_size);
+	return std::make_shared<std::vector<uint8_t> const>(temp_buffer.get(), end);
+}
+
 template<typename T>
 static uint8_t const* with_network_decompressed_section(uint8_t const* ptr_in, T const& function) {
 	uint32_t section_length = 0;
@@ -577,18 +700,30 @@ bool client_data::is_banned(sys::state& state) const {
 	}
 }
 
+/* Clients that still hold the state of the previous resync base only need the difference to the current save,
+   which for a client that dropped out shortly before is almost entirely zeroes and compresses far better */
+static void send_save_to_client(sys::state& state, network::client_data& client) {
+	command::payload c;
+	memset(&c, 0, sizeof(command::payload));
+	c.type = command::command_type::notify_save_loaded;
+	c.source = state.local_player_nation;
+	c.data.notify_save_loaded.target = client.playing_as;
+	if(state.network_state.current_delta_buffer && client.hshake_buffer.resync_base_checksum.is_equal(state.network_state.current_delta_base)) {
+		c.data.notify_save_loaded.is_delta = true;
+		network::broadcast_save_to_clients(state, c, state.network_state.current_delta_buffer, state.network_state.current_save_checksum);
+	} else {
+		network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer, state.network_state.current_save_checksum);
+	}
+}
+
 static void send_post_handshake_commands(sys::state& state, network::client_data& client) {
+	unshare_save_stream(client); // the buffer is rebuilt below
 	std::vector<char> tmp = client.send_buffer;
 	client.send_buffer.clear();
 	if(state.current_scene.starting_scene) {
 		/* Send the savefile to the newly connected client (if not a new game) */
 		if(!state.network_state.is_new_game) {
-			command::payload c;
-			memset(&c, 0, sizeof(command::payload));
-			c.type = command::command_type::notify_save_loaded;
-			c.source = state.local_player_nation;
-			c.data.notify_save_loaded.target = client.playing_as;
-			network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length, state.network_state.current_save_checksum);
+			send_save_to_client(state, client);
 #ifndef NDEBUG
 			state.console_log("host:send:cmd: (new(2)->save_loaded)");
 #endif
@@ -609,7 +744,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 				} else if(n.get_is_player_controlled()) {
 					c.source = n;
 					c.data.player_name = state.network_state.map_of_player_names[n.id.index()];
-					socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+					socket_add_command_to_send_queue(client.send_buffer, c);
 #ifndef NDEBUG
 					state.console_log("host:send:cmd: (new(2)->others_join) " + std::to_string(n.id.index()));
 #endif
@@ -633,7 +768,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 				} else if(n.get_is_player_controlled()) {
 					c.source = n;
 					c.data.player_name = state.network_state.map_of_player_names[n.id.index()];
-					socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+					socket_add_command_to_send_queue(client.send_buffer, c);
 #ifndef NDEBUG
 					state.console_log("host:send:cmd: (new->others_join) " + std::to_string(n.id.index()));
 #endif
@@ -651,7 +786,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 			network::write_network_save(state);
 			/* Then reload as if we loaded the save data */
 			state.preload();
-			with_network_decompressed_section(state.network_state.current_save_buffer.get(), [&state](uint8_t const* ptr_in, uint32_t length) {
+			with_network_decompressed_section(state.network_state.current_save_buffer->data(), [&state](uint8_t const* ptr_in, uint32_t length) {
 				read_save_section(ptr_in, ptr_in + length, state);
 			});
 			state.fill_unsaved_data();
@@ -667,7 +802,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 				c.data.notify_reload.checksum = state.get_save_checksum();
 				for(auto& other_client : state.network_state.clients) {
 					if(other_client.playing_as != client.playing_as) {
-						socket_add_to_send_queue(other_client.send_buffer, &c, sizeof(c));
+						socket_add_command_to_send_queue(other_client.send_buffer, c);
 #ifndef NDEBUG
 						state.console_log("host:send:cmd: (new->reload)");
 #endif
@@ -675,12 +810,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 				}
 			}
 			{ /* Send the savefile to the newly connected client (if not a new game) */
-				command::payload c;
-				memset(&c, 0, sizeof(command::payload));
-				c.type = command::command_type::notify_save_loaded;
-				c.source = state.local_player_nation;
-				c.data.notify_save_loaded.target = client.playing_as;
-				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length, state.network_state.current_save_checksum);
+				send_save_to_client(state, client);
 #ifndef NDEBUG
 				state.console_log("host:send:cmd: (new->save_loaded)");
 #endif
@@ -691,7 +821,7 @@ static void send_post_handshake_commands(sys::state& state, network::client_data
 			memset(&c, 0, sizeof(c));
 			c.type = command::command_type::notify_start_game;
 			c.source = state.local_player_nation;
-			socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+			socket_add_command_to_send_queue(client.send_buffer, c);
 #ifndef NDEBUG
 			state.console_log("host:send:cmd: (new->start_game)");
 #endif
@@ -709,6 +839,7 @@ static void receive_from_clients(sys::state& state) {
 		int r = 0;
 		if(client.handshake) {
 			r = socket_recv(client.socket_fd, &client.hshake_buffer, sizeof(client.hshake_buffer), &client.recv_count, [&]() {
+				client.telemetry.received_bytes += sizeof(client.hshake_buffer);
 				if(std::memcmp(client.hshake_buffer.password, state.network_state.password, sizeof(state.network_state.password)) != 0) {
 					disconnect_client(state, client, false);
 					return;
@@ -719,13 +850,28 @@ static void receive_from_clients(sys::state& state) {
 				state.game_state_updated.store(true, std::memory_order::release);
 			});
 		} else {
-			r = socket_recv(client.socket_fd, &client.recv_buffer, sizeof(client.recv_buffer), &client.recv_count, [&]() {
+			r = socket_recv_command(client.socket_fd, client.recv_wire_buffer, client.recv_buffer, &client.recv_count, [&]() {
+				client.telemetry.received_bytes += command_wire_header_size + command::payload_data_size(client.recv_buffer.type);
+				client.telemetry.received_commands++;
 				switch(client.recv_buffer.type) {
+				case command::command_type::notify_ping:
+				{
+					// our own ping, answered
+					auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+					client.telemetry.round_trip_ms = int32_t((now - client.recv_buffer.data.notify_ping.sent_at) / 1000);
+					client.telemetry.ticks_behind = std::max(0, int32_t(state.current_date.value) - int32_t(client.recv_buffer.data.notify_ping.date.value));
+					break;
+				}
+				case command::command_type::notify_tick_ack:
+					client.acked_date = client.recv_buffer.data.notify_tick_ack.date;
+					break;
 				case command::command_type::invalid:
 				case command::command_type::notify_player_ban:
 				case command::command_type::notify_player_kick:
 				case command::command_type::notify_save_loaded:
 				case command::command_type::notify_reload:
+				case command::command_type::notify_checksum_tree:
+				case command::command_type::notify_checksum:
 				case command::command_type::advance_tick:
 				case command::command_type::notify_start_game:
 				case command::command_type::notify_stop_game:
@@ -756,24 +902,63 @@ static void receive_from_clients(sys::state& state) {
 	}
 }
 
+static void set_resync_base(sys::state& state, std::vector<uint8_t>&& data) {
+	state.network_state.resync_base = std::move(data);
+	blake2b(&state.network_state.resync_base_checksum, sizeof(sys::checksum_key), state.network_state.resync_base.data(), state.network_state.resync_base.size(), nullptr, 0);
+}
+
 void write_network_save(sys::state& state) {
 	/* A save lock will be set when we load a save, naturally loading a save implies
 	that we have done preload/fill_unsaved so we will skip doing that again, to save a
 	bit of sanity on our miserable CPU */
 	size_t length = sizeof_save_section(state);
-	auto save_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
+	std::vector<uint8_t> save_buffer(length);
 	/* Clear the player nation */
 	assert(state.local_player_nation == dcon::nation_id{ });
-	write_save_section(save_buffer.get(), state); //writeoff data
-	// this is an upper bound, since compacting the data may require less space
-	state.network_state.current_save_buffer.reset(new uint8_t[ZSTD_compressBound(length) + sizeof(uint32_t) * 2]);
-	auto buffer_position = write_network_compressed_section(state.network_state.current_save_buffer.get(), save_buffer.get(), uint32_t(length));
-	state.network_state.current_save_length = uint32_t(buffer_position - state.network_state.current_save_buffer.get());
+	write_save_section(save_buffer.data(), state); //writeoff data
+	state.network_state.current_save_buffer = make_network_compressed_section(save_buffer.data(), uint32_t(length));
 	state.network_state.current_save_checksum = state.get_save_checksum();
+
+	/* The delta against the previous resync base, for clients that rejoin while still holding it */
+	auto& base = state.network_state.resync_base;
+	if(!base.empty()) {
+		std::vector<uint8_t> delta(length);
+		for(size_t i = 0; i < length; ++i)
+			delta[i] = save_buffer[i] ^ (i < base.size() ? base[i] : uint8_t(0));
+		state.network_state.current_delta_buffer = make_network_compressed_section(delta.data(), uint32_t(length));
+		state.network_state.current_delta_base = state.network_state.resync_base_checksum;
+	} else {
+		state.network_state.current_delta_buffer.reset();
+	}
+	set_resync_base(state, std::move(save_buffer));
 }
 
-void broadcast_save_to_clients(sys::state& state, command::payload& c, uint8_t const* buffer, uint32_t length, sys::checksum_key const& k) {
-	assert(length > 0);
+static std::vector<uint8_t> write_resync_snapshot(sys::state& state) {
+	/* Same layout as write_network_save, so that host and clients end up with identical bytes */
+	dcon::nation_id old_local_player_nation = state.local_player_nation;
+	state.local_player_nation = dcon::nation_id{ };
+	std::vector<uint8_t> buffer(sizeof_save_section(state));
+	write_save_section(buffer.data(), state);
+	state.local_player_nation = old_local_player_nation;
+	return buffer;
+}
+
+void take_resync_snapshot(sys::state& state) {
+	set_resync_base(state, write_resync_snapshot(state));
+}
+
+void take_pending_resync_snapshot(sys::state& state) {
+	state.network_state.pending_resync_base = write_resync_snapshot(state);
+}
+
+void confirm_pending_resync_snapshot(sys::state& state) {
+	if(!state.network_state.pending_resync_base.empty())
+		set_resync_base(state, std::move(state.network_state.pending_resync_base));
+	state.network_state.pending_resync_base.clear();
+}
+
+void broadcast_save_to_clients(sys::state& state, command::payload& c, std::shared_ptr<std::vector<uint8_t> const> const& buffer, sys::checksum_key const& k) {
+	assert(buffer && buffer->size() > 0);
 	assert(c.type == command::command_type::notify_save_loaded);
 	c.data.notify_save_loaded.checksum = k;
 	for(auto& client : state.network_state.clients) {
@@ -781,28 +966,93 @@ void broadcast_save_to_clients(sys::state& state, command::payload& c, uint8_t c
 			continue;
 		bool send_full = (client.playing_as == c.data.notify_save_loaded.target) || (!c.data.notify_save_loaded.target);
 		if(send_full && !state.network_state.is_new_game) {
+			// a client can only be streamed one save at a time
+			unshare_save_stream(client);
 			/* And then we have to first send the command payload itself */
-			client.save_stream_size = size_t(length);
-			c.data.notify_save_loaded.length = size_t(length);
-			socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+			client.save_stream_size = buffer->size();
+			c.data.notify_save_loaded.length = uint32_t(buffer->size());
+			socket_add_command_to_send_queue(client.send_buffer, c);
 			/* And then the bulk payload! */
 			client.save_stream_offset = client.total_sent_bytes + client.send_buffer.size();
-			socket_add_to_send_queue(client.send_buffer, buffer, size_t(length));
+			client.acked_date = sys::date{}; // only paces the host again once it has loaded the save and ticked
+			client.save_stream = buffer;
+			client.save_stream_after = client.send_buffer.size();
+			client.save_stream_sent = 0;
 #ifndef NDEBUG
-			state.console_log("host:send:save: " + std::to_string(uint32_t(length)));
+			state.console_log("host:send:save: " + std::to_string(uint32_t(buffer->size())));
 #endif
 		}
 	}
 }
 
+void send_checksum_tree(sys::state& state, dcon::nation_id target, sys::date checksum_date) {
+	auto it = std::find_if(state.network_state.sent_checksum_trees.begin(), state.network_state.sent_checksum_trees.end(), [&](sys::checksum_tree const& t) {
+		return t.date == checksum_date;
+	});
+	if(it == state.network_state.sent_checksum_trees.end())
+		return; // too old, the oos dumps are all there is to go on
+	auto data = it->serialize();
+
+	command::payload c;
+	memset(&c, 0, sizeof(command::payload));
+	c.type = command::command_type::notify_checksum_tree;
+	c.source = state.local_player_nation;
+	c.data.checksum_tree.date = checksum_date;
+	c.data.checksum_tree.length = uint32_t(data.size());
+	c.data.checksum_tree.target = target;
+	for(auto& client : state.network_state.clients) {
+		if(client.is_active() && client.playing_as == target) {
+			socket_add_command_to_send_queue(client.send_buffer, c);
+			socket_add_to_send_queue(client.send_buffer, data.data(), data.size());
+#ifndef NDEBUG
+			state.console_log("host:send:checksum_tree: " + std::to_string(uint32_t(data.size())));
+#endif
+		}
+	}
+}
+
+static void report_checksum_divergence(sys::state& state) {
+	sys::checksum_tree host_tree;
+	auto const* start = state.network_state.checksum_tree_data.data();
+	if(!host_tree.deserialize(start, start + state.network_state.checksum_tree_data.size())) {
+		state.console_log("client:recv:checksum_tree: malformed");
+		return;
+	}
+	auto report = sys::describe_divergence(state.network_state.mismatched_checksum_tree, host_tree);
+	auto sdir = simple_fs::get_or_create_oos_directory();
+	simple_fs::write_file(sdir, NATIVE("divergence.txt"), report.data(), uint32_t(report.size()));
+	state.console_log("out of sync, diverging records:\n" + report);
+}
+
+// sends the key hashed in the background since the last checksummed advance_tick, waiting for it if need be
+static void broadcast_async_checksum(sys::state& state) {
+	if(!state.save_checksum.async_pending())
+		return;
+	auto [key, tree] = state.save_checksum.async_result();
+	// kept so that a client reporting a mismatch can be told where it diverged
+	state.network_state.sent_checksum_trees.push_back(std::move(tree));
+	if(state.network_state.sent_checksum_trees.size() > max_sent_checksum_trees)
+		state.network_state.sent_checksum_trees.pop_front();
+
+	command::payload c;
+	memset(&c, 0, sizeof(command::payload));
+	c.type = command::command_type::notify_checksum;
+	c.source = state.local_player_nation;
+	c.data.notify_checksum.checksum = key;
+	c.data.notify_checksum.date = state.network_state.async_checksum_date;
+	broadcast_to_clients(state, c);
+}
+
 void broadcast_to_clients(sys::state& state, command::payload& c) {
 	if(c.type == command::command_type::save_game)
 		return;
 	assert(c.type != command::command_type::notify_save_loaded);
-	/* Propagate to all the clients */
+	/* Propagate to all the clients, all of which get the same bytes */
+	std::array<uint8_t, command_wire_max_size> wire;
+	auto length = write_command_wire_format(wire.data(), c);
 	for(auto& client : state.network_state.clients) {
 		if(client.is_active()) {
-			socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+			socket_add_to_send_queue(client.send_buffer, wire.data(), length);
 		}
 	}
 }
@@ -812,9 +1062,10 @@ static void accept_new_clients(sys::state& state) {
 	fd_set rfds;
 	FD_ZERO(&rfds);
 	FD_SET(state.network_state.socket_fd, &rfds);
+	// this runs on every iteration of the game loop, so it must only poll: waiting here would hold up the host's ticks
 	struct timeval tv{};
 	tv.tv_sec = 0;
-	tv.tv_usec = 1000;
+	tv.tv_usec = 0;
 	if(select(socket_t(int(state.network_state.socket_fd) + 1), &rfds, nullptr, nullptr, &tv) <= 0)
 		return;
 	
@@ -850,6 +1101,87 @@ static void accept_new_clients(sys::state& state) {
 	}
 }
 
+void wait_for_host_data(sys::state& state, int32_t milliseconds) {
+	if(state.network_mode != sys::network_mode_type::client || state.network_state.finished) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+		return;
+	}
+	fd_set rfds;
+	FD_ZERO(&rfds);
+	FD_SET(state.network_state.socket_fd, &rfds);
+	struct timeval tv{};
+	tv.tv_sec = 0;
+	tv.tv_usec = milliseconds * 1000;
+	// returns as soon as anything from the host (typically the next advance_tick) can be read, or on an error, which the
+	// following receive will then report
+	select(socket_t(int(state.network_state.socket_fd) + 1), &rfds, nullptr, nullptr, &tv);
+}
+
+bool clients_keep_up(sys::state& state) {
+	for(auto& client : state.network_state.clients) {
+		if(!client.is_active() || client.handshake || !client.acked_date)
+			continue;
+		if(int32_t(state.current_date.value) - int32_t(client.acked_date.value) >= max_client_tick_lag)
+			return false;
+	}
+	return true;
+}
+
+constexpr std::chrono::milliseconds telemetry_sample_interval{ 1000 };
+
+// closes the current telemetry sample of every client that is due, and pings it for the next one
+static void update_client_telemetry(sys::state& state) {
+	auto now = std::chrono::steady_clock::now();
+	for(auto& client : state.network_state.clients) {
+		if(!client.is_active() || client.handshake)
+			continue;
+		auto& t = client.telemetry;
+		auto elapsed = now - t.sample_start;
+		if(elapsed < telemetry_sample_interval)
+			continue;
+
+		if(t.sample_start != std::chrono::steady_clock::time_point{}) {
+			auto seconds = std::chrono::duration<float>(elapsed).count();
+			t.sent_bytes_per_second = float(client.total_sent_bytes - t.sample_sent_bytes) / seconds;
+			t.received_bytes_per_second = float(t.received_bytes - t.sample_received_bytes) / seconds;
+			auto ticks = std::max(1, int32_t(state.current_date.value) - int32_t(t.sample_date.value));
+			t.commands_per_tick = float(t.received_commands - t.sample_received_commands) / float(ticks);
+		}
+		t.sample_start = now;
+		t.sample_sent_bytes = client.total_sent_bytes;
+		t.sample_received_bytes = t.received_bytes;
+		t.sample_received_commands = t.received_commands;
+		t.sample_date = state.current_date;
+
+		command::payload c;
+		memset(&c, 0, sizeof(command::payload));
+		c.type = command::command_type::notify_ping;
+		c.source = state.local_player_nation;
+		c.data.notify_ping.sent_at = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+		c.data.notify_ping.date = state.current_date;
+		socket_add_command_to_send_queue(client.send_buffer, c);
+	}
+}
+
+std::vector<std::string> describe_client_telemetry(sys::state& state) {
+	std::vector<std::string> result;
+	if(state.network_mode != sys::network_mode_type::host)
+		return result;
+	for(auto& client : state.network_state.clients) {
+		if(!client.is_active())
+			continue;
+		auto& t = client.telemetry;
+		std::string line{ state.network_state.map_of_player_names[client.playing_as.index()].to_string_view() };
+		line += ": out " + text::format_float(t.sent_bytes_per_second / 1000.0f, 1) + " kB/s";
+		line += ", in " + text::format_float(t.received_bytes_per_second / 1000.0f, 1) + " kB/s";
+		line += ", " + text::format_float(t.commands_per_tick, 2) + " cmd/tick";
+		line += ", rtt " + (t.round_trip_ms >= 0 ? std::to_string(t.round_trip_ms) + " ms" : std::string("?"));
+		line += ", " + std::to_string(t.ticks_behind) + " ticks behind";
+		result.push_back(std::move(line));
+	}
+	return result;
+}
+
 void send_and_receive_commands(sys::state& state) {
 	/* An issue that arose in multiplayer is that the UI was loading the savefile
 	   directly, while the game state loop was running, this was fine with the
@@ -872,10 +1204,14 @@ void send_and_receive_commands(sys::state& state) {
 		auto* c = state.network_state.outgoing_commands.front();
 		while(c) {
 			if(!command::is_console_command(c->type)) {
-				// Generate checksum on the spot
+				/* Snapshot the state for the checksum on the spot, but hash it in the background: the key follows
+				   in a notify_checksum once it is ready, so that the tick does not have to wait for it */
 				if(c->type == command::command_type::advance_tick) {
 					if(state.current_date.to_ymd(state.start_date).day == 1 || state.cheat_data.daily_oos_check) {
-						c->data.advance_tick.checksum = state.get_save_checksum();
+						broadcast_async_checksum(state); // the clients compare them in order, one at a time
+						state.save_checksum.compute_async(state, state.current_date);
+						state.network_state.async_checksum_date = state.current_date;
+						take_resync_snapshot(state);
 					}
 				}
 				broadcast_to_clients(state, *c);
@@ -888,6 +1224,9 @@ void send_and_receive_commands(sys::state& state) {
 			state.network_state.outgoing_commands.pop();
 			c = state.network_state.outgoing_commands.front();
 		}
+		if(state.save_checksum.async_ready())
+			broadcast_async_checksum(state);
+		update_client_telemetry(state);
 
 		for(auto& client : state.network_state.clients) {
 			if(!client.is_active())
@@ -910,9 +1249,12 @@ void send_and_receive_commands(sys::state& state) {
 #endif
 				}
 			} else {
-				if(client.send_buffer.size() > 0) {
-					size_t old_size = client.send_buffer.size();
-					int r = socket_send(client.socket_fd, client.send_buffer);
+				auto queued_bytes = [&]() {
+					return client.send_buffer.size() + (client.save_stream ? client.save_stream->size() - client.save_stream_sent : size_t(0));
+				};
+				if(queued_bytes() > 0) {
+					size_t old_size = queued_bytes();
+					int r = socket_send_to_client(client);
 					if(r != 0) { // error
 #if !defined(NDEBUG) && defined(_WIN32)
 						state.console_log("host:disconnect: in-send-INGAME err=" + std::to_string(int32_t(r)) + "::" + get_last_error_msg());
@@ -920,9 +1262,9 @@ void send_and_receive_commands(sys::state& state) {
 						disconnect_client(state, client, false);
 						continue;
 					}
-					client.total_sent_bytes += old_size - client.send_buffer.size();
+					client.total_sent_bytes += old_size - queued_bytes();
 #ifndef NDEBUG
-					if(old_size != client.send_buffer.size())
+					if(old_size != queued_bytes())
 						state.console_log("host:send:stats: [SEND] " + std::to_string(uint32_t(client.total_sent_bytes)) + " bytes");
 #endif
 				}
@@ -978,6 +1320,7 @@ void send_and_receive_commands(sys::state& state) {
 				/* Send our client handshake back */
 				client_handshake_data hshake;
 				hshake.nickname = state.network_state.nickname;
+				hshake.resync_base_checksum = state.network_state.resync_base_checksum;
 				std::memcpy(hshake.password, state.network_state.password, sizeof(hshake.password));
 				socket_add_to_send_queue(state.network_state.send_buffer, &hshake, sizeof(hshake));
 				state.network_state.handshake = false;
@@ -1003,7 +1346,14 @@ void send_and_receive_commands(sys::state& state) {
 				dcon::nation_id old_local_player_nation = state.local_player_nation;
 				state.preload();
 				with_network_decompressed_section(state.network_state.save_data.data(), [&state](uint8_t const* ptr_in, uint32_t length) {
-					read_save_section(ptr_in, ptr_in + length, state);
+					std::vector<uint8_t> buffer(ptr_in, ptr_in + length);
+					if(state.network_state.save_stream_is_delta) {
+						auto& base = state.network_state.resync_base;
+						for(size_t i = 0; i < buffer.size() && i < base.size(); ++i)
+							buffer[i] ^= base[i];
+					}
+					read_save_section(buffer.data(), buffer.data() + buffer.size(), state);
+					set_resync_base(state, std::move(buffer));
 				});
 				state.local_player_nation = dcon::nation_id{ };
 				state.fill_unsaved_data();
@@ -1025,31 +1375,77 @@ void send_and_receive_commands(sys::state& state) {
 				network::finish(state, false);
 				return;
 			}
+		} else if(state.network_state.checksum_tree_stream) {
+			int r = socket_recv(state.network_state.socket_fd, state.network_state.checksum_tree_data.data(), state.network_state.checksum_tree_data.size(), &state.network_state.recv_count, [&]() {
+				report_checksum_divergence(state);
+				state.network_state.checksum_tree_data.clear();
+				state.network_state.checksum_tree_stream = false;
+			});
+			if(r != 0) { // error
+				ui::popup_error_window(state, "Network Error", "Network client checksum tree receive error: " + get_last_error_msg());
+				network::finish(state, false);
+				return;
+			}
 		} else {
-			// receive commands from the server and immediately execute them
-			int r = socket_recv(state.network_state.socket_fd, &state.network_state.recv_buffer, sizeof(state.network_state.recv_buffer), &state.network_state.recv_count, [&]() {
-				command::execute_command(state, state.network_state.recv_buffer);
-				command_executed = true;
-				// start save stream!
-				if(state.network_state.recv_buffer.type == command::command_type::notify_save_loaded) {
-					uint32_t save_size = state.network_state.recv_buffer.data.notify_save_loaded.length;
-					state.network_state.save_stream = true;
-					assert(save_size > 0);
-					if(save_size >= 32 * 1000 * 1000) { // 32 MB
-						ui::popup_error_window(state, "Network Error", "Network client save stream too big: " + get_last_error_msg());
-						network::finish(state, false);
+			/* Receive commands from the server and immediately execute them. Everything that has already arrived is
+			   handled at once rather than one command per pass of the game loop, so that a client which has fallen
+			   behind runs the queued ticks back to back; bounded so that our own commands still go out regularly */
+			bool ticked = false;
+			for(int32_t i = 0; i < max_commands_per_receive; ++i) {
+				bool received = false;
+				int r = socket_recv_command(state.network_state.socket_fd, state.network_state.recv_wire_buffer, state.network_state.recv_buffer, &state.network_state.recv_count, [&]() {
+					received = true;
+					if(state.network_state.recv_buffer.type == command::command_type::notify_ping) {
+						// straight back to the host, with how far we have got
+						auto c = state.network_state.recv_buffer;
+						c.source = state.local_player_nation;
+						c.data.notify_ping.date = state.current_date;
+						socket_add_command_to_send_queue(state.network_state.send_buffer, c);
 						return;
 					}
-					state.network_state.save_data.resize(static_cast<size_t>(save_size));
-				}
+					command::execute_command(state, state.network_state.recv_buffer);
+					command_executed = true;
+					if(state.network_state.recv_buffer.type == command::command_type::advance_tick)
+						ticked = true;
+					// start save stream!
+					if(state.network_state.recv_buffer.type == command::command_type::notify_save_loaded) {
+						uint32_t save_size = state.network_state.recv_buffer.data.notify_save_loaded.length;
+						state.network_state.save_stream = true;
+						state.network_state.save_stream_is_delta = state.network_state.recv_buffer.data.notify_save_loaded.is_delta;
+						assert(save_size > 0);
+						if(save_size >= 32 * 1000 * 1000) { // 32 MB
+							ui::popup_error_window(state, "Network Error", "Network client save stream too big: " + get_last_error_msg());
+							network::finish(state, false);
+							return;
+						}
+						state.network_state.save_data.resize(static_cast<size_t>(save_size));
+					} else if(state.network_state.recv_buffer.type == command::command_type::notify_checksum_tree) {
+						uint32_t tree_size = state.network_state.recv_buffer.data.checksum_tree.length;
+						if(tree_size > 0 && tree_size < 32 * 1000 * 1000) {
+							state.network_state.checksum_tree_stream = true;
+							state.network_state.checksum_tree_data.resize(static_cast<size_t>(tree_size));
+						}
+					}
 #ifndef NDEBUG
-				state.console_log("client:recv:cmd: " + std::to_string(uint32_t(state.network_state.recv_buffer.type)));
+					state.console_log("client:recv:cmd: " + std::to_string(uint32_t(state.network_state.recv_buffer.type)));
 #endif
-			});
-			if(r != 0) { // error
-				ui::popup_error_window(state, "Network Error", "Network client command receive error: " + get_last_error_msg());
-				network::finish(state, false);
-				return;
+				});
+				if(r != 0) { // error
+					ui::popup_error_window(state, "Network Error", "Network client command receive error: " + get_last_error_msg());
+					network::finish(state, false);
+					return;
+				}
+				// the streams that follow some commands are read by their own branches above
+				if(!received || state.network_state.save_stream || state.network_state.checksum_tree_stream || state.network_state.finished)
+					break;
+			}
+			if(ticked) { // a single acknowledgement for a whole run of ticks
+				command::payload c;
+				memset(&c, 0, sizeof(command::payload));
+				c.type = command::command_type::notify_tick_ack;
+				c.source = state.local_player_nation;
+				c.data.notify_tick_ack.date = state.current_date;
+				socket_add_command_to_send_queue(state.network_state.send_buffer, c);
 			}
 			// send the outgoing commands to the server and flush the entire queue
 			auto* c = state.network_state.outgoing_commands.front();
@@ -1061,7 +1457,7 @@ void send_and_receive_commands(sys::state& state) {
 					command::execute_command(state, *c);
 					command_executed = true;
 				} else {
-					socket_add_to_send_queue(state.network_state.send_buffer, c, sizeof(*c));
+					socket_add_command_to_send_queue(state.network_state.send_buffer, *c);
 				}
 				state.network_state.outgoing_commands.pop();
 				c = state.network_state.outgoing_commands.front();
@@ -1101,7 +1497,7 @@ void finish(sys::state& state, bool notify_host) {
 					if(c->type == command::command_type::save_game) {
 						command::execute_command(state, *c);
 					} else {
-						socket_add_to_send_queue(state.network_state.send_buffer, c, sizeof(*c));
+						socket_add_command_to_send_queue(state.network_state.send_buffer, *c);
 					}
 					state.network_state.outgoing_commands.pop();
 					c = state.network_state.outgoing_commands.front();
@@ -1112,7 +1508,7 @@ void finish(sys::state& state, bool notify_host) {
 			c.type = command::command_type::notify_player_leaves;
 			c.source = state.local_player_nation;
 			c.data.notify_leave.make_ai = true;
-			socket_add_to_send_queue(state.network_state.send_buffer, &c, sizeof(c));
+			socket_add_command_to_send_queue(state.network_state.send_buffer, c);
 			while(state.network_state.send_buffer.size() > 0) {
 				if(socket_send(state.network_state.socket_fd, state.network_state.send_buffer) != 0) { // error
 					//ui::popup_error_window(state, "Network Error", "Network client command send error: " + get_last_error_msg());
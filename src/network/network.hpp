@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <string>
 #ifdef _WIN64 // WINDOWS
 #define _WINSOCK_DEPRECATED_NO_WARNINGS 1
@@ -14,8 +17,10 @@
 #include <sys/socket.h>
 #endif
 #include "SPSCQueue.h"
+#include "MPSCQueue.h"
 #include "container_types.hpp"
 #include "commands.hpp"
+#include "save_checksum.hpp"
 
 namespace sys {
 struct state;
@@ -24,6 +29,11 @@ struct state;
 namespace network {
 
 inline constexpr short default_server_port = 1984;
+inline constexpr size_t max_sent_checksum_trees = 8;
+// how many days the host may run ahead of the slowest client that is in the game
+inline constexpr int32_t max_client_tick_lag = 10;
+// how many commands from the host a client handles in one pass of the game loop at most
+inline constexpr int32_t max_commands_per_receive = 256;
 
 #ifdef _WIN64
 typedef SOCKET socket_t;
@@ -34,6 +44,7 @@ typedef int socket_t;
 struct client_handshake_data {
 	sys::player_name nickname;
 	uint8_t password[16] = {0};
+	sys::checksum_key resync_base_checksum; // of the last state the client agreed on with the host, if any
 	uint8_t reserved[48] = {0};
 };
 
@@ -45,6 +56,39 @@ struct server_handshake_data {
 	uint8_t reserved[64] = {0};
 };
 
+// commands go over the wire as their type and source, followed by only the command::payload_data_size(type) bytes of the data
+// that their type uses
+inline constexpr size_t command_wire_header_size = sizeof(command::command_type) + sizeof(dcon::nation_id);
+inline constexpr size_t command_wire_max_size = command_wire_header_size + sizeof(command::payload::dtype);
+
+// what a client expects the settings of one of its factories to be once its change_factory_settings commands have made
+// the round trip through the host; only ever read by the ui, never by the simulation
+struct predicted_factory_settings {
+	std::chrono::steady_clock::time_point sent;
+	uint16_t pending = 0; // commands not yet back from the host
+	uint8_t priority = 0;
+	bool subsidized = false;
+};
+
+// Live counters kept by the host for each client, sampled about once a second, see the net-stats console command
+struct client_telemetry {
+	size_t received_bytes = 0;
+	size_t received_commands = 0;
+
+	// as of the last complete sample
+	float sent_bytes_per_second = 0.0f;
+	float received_bytes_per_second = 0.0f;
+	float commands_per_tick = 0.0f; // received from the client per tick of the host
+	int32_t round_trip_ms = -1; // until the first ping is answered
+	int32_t ticks_behind = 0; // how far the date the client answered the last ping with trails that of the host
+
+	std::chrono::steady_clock::time_point sample_start;
+	size_t sample_sent_bytes = 0;
+	size_t sample_received_bytes = 0;
+	size_t sample_received_commands = 0;
+	sys::date sample_date;
+};
+
 struct client_data {
 	dcon::nation_id playing_as{};
 	socket_t socket_fd = 0;
@@ -52,14 +96,24 @@ struct client_data {
 
 	client_handshake_data hshake_buffer;
 	command::payload recv_buffer;
+	std::array<uint8_t, command_wire_max_size> recv_wire_buffer;
 	size_t recv_count = 0;
 	std::vector<char> send_buffer;
 	std::vector<char> early_send_buffer;
 
+	// The save is sent straight out of the compressed buffer shared by every client receiving it, instead of being
+	// copied into each send_buffer. It goes out once the first save_stream_after bytes of send_buffer have been sent,
+	// ahead of whatever was queued after it.
+	std::shared_ptr<std::vector<uint8_t> const> save_stream;
+	size_t save_stream_after = 0;
+	size_t save_stream_sent = 0;
+
 	// accounting for save progress
 	size_t total_sent_bytes = 0;
 	size_t save_stream_offset = 0;
 	size_t save_stream_size = 0;
+	client_telemetry telemetry;
+	sys::date acked_date; // the last advance_tick the client has reported as done, none until it has caught up with a save
 	bool handshake = true;
 
 	bool is_banned(sys::state& state) const;
@@ -73,7 +127,7 @@ struct network_state {
 	sys::player_name nickname;
 	sys::checksum_key current_save_checksum;
 	struct sockaddr_storage address;
-	rigtorp::SPSCQueue<command::payload> outgoing_commands;
+	sys::MPSCQueue<command::payload> outgoing_commands; // issued by the ui as well as by the game thread
 	std::array<client_data, 128> clients;
 	std::vector<struct in6_addr> v6_banlist;
 	std::vector<struct in_addr> v4_banlist;
@@ -81,17 +135,30 @@ struct network_state {
 	std::vector<char> send_buffer;
 	std::vector<char> early_send_buffer;
 	command::payload recv_buffer;
+	std::array<uint8_t, command_wire_max_size> recv_wire_buffer;
 	std::vector<uint8_t> save_data; //client
+	std::vector<uint8_t> checksum_tree_data; //client
+	sys::checksum_tree mismatched_checksum_tree; //client, taken when the host checksum did not match
+	std::deque<sys::checksum_tree> sent_checksum_trees; //host, of the most recent checksums sent to clients
 	ankerl::unordered_dense::map<int32_t, sys::player_name> map_of_player_names;
-	std::unique_ptr<uint8_t[]> current_save_buffer;
+	ankerl::unordered_dense::map<int32_t, predicted_factory_settings> predicted_factories; //client, by factory index
+	// host, compressed; shared with the clients that are still being streamed a copy, see client_data::save_stream
+	std::shared_ptr<std::vector<uint8_t> const> current_save_buffer;
+	std::shared_ptr<std::vector<uint8_t> const> current_delta_buffer; //host, current save xor-ed with the previous resync base
+	std::vector<uint8_t> resync_base; // uncompressed save section of the last state agreed on by host and client
+	std::vector<uint8_t> pending_resync_base; //client, becomes the resync base once the host confirms its checksum
+	sys::checksum_key resync_base_checksum; // blake2b of resync_base
+	sys::checksum_key current_delta_base; //host, the resync base current_delta_buffer was made against
+	sys::date async_checksum_date; // of the checksum being hashed by save_checksum.compute_async
 	size_t recv_count = 0;
-	uint32_t current_save_length = 0;
 	socket_t socket_fd = 0;
 	uint8_t password[16] = { 0 };
 	std::atomic<bool> save_slock = false;
 	bool as_v6 = false;
 	bool as_server = false;
 	bool save_stream = false; //client
+	bool save_stream_is_delta = false; //client
+	bool checksum_tree_stream = false; //client
 	bool is_new_game = true; // has save been loaded?
 	bool out_of_sync = false; // network -> game state signal
 	bool reported_oos = false; // has oos been reported to host yet?
@@ -104,13 +171,23 @@ struct network_state {
 
 void init(sys::state& state);
 void send_and_receive_commands(sys::state& state);
+// on a client, blocks until data from the host arrives or the given time has passed; elsewhere it just sleeps
+void wait_for_host_data(sys::state& state, int32_t milliseconds);
 void finish(sys::state& state, bool notify_host);
+// host, false while a client that is in the game trails the host by max_client_tick_lag days or more
+bool clients_keep_up(sys::state& state);
 void ban_player(sys::state& state, client_data& client);
 void kick_player(sys::state& state, client_data& client);
 void switch_player(sys::state& state, dcon::nation_id new_n, dcon::nation_id old_n);
 void write_network_save(sys::state& state);
-void broadcast_save_to_clients(sys::state& state, command::payload& c, uint8_t const* buffer, uint32_t length, sys::checksum_key const& k);
+void take_resync_snapshot(sys::state& state);
+void take_pending_resync_snapshot(sys::state& state);
+void confirm_pending_resync_snapshot(sys::state& state);
+void broadcast_save_to_clients(sys::state& state, command::payload& c, std::shared_ptr<std::vector<uint8_t> const> const& buffer, sys::checksum_key const& k);
 void broadcast_to_clients(sys::state& state, command::payload& c);
+void send_checksum_tree(sys::state& state, dcon::nation_id target, sys::date checksum_date);
+// one line per connected client, host only
+std::vector<std::string> describe_client_telemetry(sys::state& state);
 
 class port_forwarder {
 private:
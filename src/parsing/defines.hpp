@@ -692,6 +692,10 @@
 	LUA_DEFINES_LIST_ELEMENT(alice_rgo_per_size_employment, 40000.0) \
 	LUA_DEFINES_LIST_ELEMENT(alice_eval_ai_mil_everyday, 0.0) \
 	LUA_DEFINES_LIST_ELEMENT(alice_allow_subjects_declare_wars, 0.0) \
+	LUA_DEFINES_LIST_ELEMENT(alice_pop_update_divisions, 0.0) \
+	LUA_DEFINES_LIST_ELEMENT(alice_pop_update_phase_spacing, 1.0) \
+	LUA_DEFINES_LIST_ELEMENT(alice_ai_planning_period, 30.0) \
+	LUA_DEFINES_LIST_ELEMENT(alice_cb_fabrication_check_days, 5.0) \
 
 // scales the needs values so that they are needs per this many pops
 // this value was arrived at by looking at farmers: 40'000 farmers produces enough grain to satisfy about 2/3
@@ -2,6 +2,12 @@
 #include "nations.hpp"
 #include <charconv>
 #include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define PARSERS_SSE2_SCAN
+#include <emmintrin.h>
+#endif
 
 namespace parsers {
 bool ignorable_char(char c) {
@@ -72,21 +78,39 @@ bool is_fp(char const* start, char const* end) {
 		return is_positive_fp(start, end);
 }
 
-template<typename T>
-char const* scan_for_match(char const* start, char const* end, int32_t& current_line, T&& condition) {
-	while(start < end) {
-		if(condition(*start))
-			return start;
-		if(*start == '\n')
-			++current_line;
-		++start;
+// The scanners below find the first character that is (or is not) one of the given characters, counting the newlines passed
+// over on the way. Where SSE2 is available (every x64 target) they test sixteen characters at a time: a whole block of
+// whitespace or of a comment is then skipped with a handful of instructions, and the position of the first interesting
+// character within a block is found from the bit mask of the comparisons.
+
+#ifdef PARSERS_SSE2_SCAN
+template<char... C>
+uint32_t block_match_mask(__m128i block) {
+	__m128i matches = _mm_setzero_si128();
+	((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(C)))), ...);
+	return uint32_t(_mm_movemask_epi8(matches));
+}
+#endif
+
+template<bool find_match, char... C>
+char const* scan_for_chars(char const* start, char const* end, int32_t& current_line) {
+#ifdef PARSERS_SSE2_SCAN
+	while(end - start >= 16) {
+		auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(start));
+		auto const matches = block_match_mask<C...>(block);
+		auto const found = find_match ? matches : (~matches & 0xFFFFu);
+		auto const newlines = block_match_mask<'\n'>(block);
+		if(found != 0) {
+			auto const offset = std::countr_zero(found);
+			current_line += std::popcount(newlines & ((1u << offset) - 1u));
+			return start + offset;
+		}
+		current_line += std::popcount(newlines);
+		start += 16;
 	}
-	return start;
-}
-template<typename T>
-char const* scan_for_not_match(char const* start, char const* end, int32_t& current_line, T&& condition) {
+#endif
 	while(start < end) {
-		if(!condition(*start))
+		if((((*start) == C) || ...) == find_match)
 			return start;
 		if(*start == '\n')
 			++current_line;
@@ -96,12 +120,12 @@ char const* scan_for_not_match(char const* start, char const* end, int32_t& curr
 }
 
 char const* advance_position_to_next_line(char const* start, char const* end, int32_t& current_line) {
-	auto const start_lterm = scan_for_match(start, end, current_line, line_termination);
-	return scan_for_not_match(start_lterm, end, current_line, line_termination);
+	auto const start_lterm = scan_for_chars<true, '\r', '\n'>(start, end, current_line);
+	return scan_for_chars<false, '\r', '\n'>(start_lterm, end, current_line);
 }
 
 char const* advance_position_to_non_whitespace(char const* start, char const* end, int32_t& current_line) {
-	return scan_for_not_match(start, end, current_line, ignorable_char);
+	return scan_for_chars<false, ' ', '\r', '\f', '\n', '\t', ',', ';'>(start, end, current_line);
 }
 
 char const* advance_position_to_non_comment(char const* start, char const* end, int32_t& current_line) {
@@ -114,10 +138,15 @@ char const* advance_position_to_non_comment(char const* start, char const* end,
 }
 
 char const* advance_position_to_breaking_char(char const* start, char const* end, int32_t& current_line) {
-	return scan_for_match(start, end, current_line, breaking_char);
+	// matches breaking_char
+	return scan_for_chars<true, ' ', '\r', '\f', '\n', '\t', ',', ';', '{', '}', '!', '=', '<', '>', '#'>(start, end, current_line);
 }
 
 token_and_type token_generator::internal_next() {
+	if(token_position != token_end) {
+		current_line = token_position->line;
+		return *(token_position++);
+	}
 	if(position >= file_end)
 		return token_and_type{std::string_view(), current_line, token_type::unknown};
 
@@ -130,11 +159,11 @@ token_and_type token_generator::internal_next() {
 			position = non_ws + 1;
 			return token_and_type{std::string_view(non_ws, 1), current_line, token_type::close_brace};
 		} else if(*non_ws == '\"') {
-			auto const close = scan_for_match(non_ws + 1, file_end, current_line, double_quote_termination);
+			auto const close = scan_for_chars<true, '\r', '\n', '\"'>(non_ws + 1, file_end, current_line);
 			position = close + 1;
 			return token_and_type{std::string_view(non_ws + 1, close - (non_ws + 1)), current_line, token_type::quoted_string};
 		} else if(*non_ws == '\'') {
-			auto const close = scan_for_match(non_ws + 1, file_end, current_line, single_quote_termination);
+			auto const close = scan_for_chars<true, '\r', '\n', '\''>(non_ws + 1, file_end, current_line);
 			position = close + 1;
 			return token_and_type{std::string_view(non_ws + 1, close - (non_ws + 1)), current_line, token_type::quoted_string};
 		} else if(has_fixed_prefix(non_ws, file_end, "==") || has_fixed_prefix(non_ws, file_end, "<=") ||
@@ -157,6 +186,18 @@ token_and_type token_generator::internal_next() {
 	}
 }
 
+std::vector<token_and_type> tokenize_file(char const* file_start, char const* file_end) {
+	std::vector<token_and_type> result;
+	token_generator gen(file_start, file_end);
+	while(true) {
+		auto t = gen.get();
+		result.push_back(t); // including the terminating unknown token, which carries the line on which the file ends
+		if(t.type == token_type::unknown)
+			break;
+	}
+	return result;
+}
+
 token_and_type token_generator::get() {
 	if(peek_1.type != token_type::unknown) {
 		auto const temp = peek_1;
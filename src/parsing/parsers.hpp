@@ -3,6 +3,7 @@
 #include <string_view>
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include "date_interface.hpp"
 
 /*
@@ -39,6 +40,10 @@ private:
 	char const* file_end = nullptr;
 	int32_t current_line = 1;
 
+	// set when reading from tokens produced ahead of time by tokenize_file
+	token_and_type const* token_position = nullptr;
+	token_and_type const* token_end = nullptr;
+
 	token_and_type peek_1;
 	token_and_type peek_2;
 
@@ -47,8 +52,10 @@ private:
 public:
 	token_generator() { }
 	token_generator(char const* file_start, char const* fe) : position(file_start), file_end(fe) { }
+	// the tokens (and the file contents they point into) must outlive the generator and any copies of it
+	token_generator(std::vector<token_and_type> const& tokens) : token_position(tokens.data()), token_end(tokens.data() + tokens.size()) { }
 	bool at_end() const {
-		return peek_2.type == token_type::unknown && peek_1.type == token_type::unknown && position >= file_end;
+		return peek_2.type == token_type::unknown && peek_1.type == token_type::unknown && position >= file_end && token_position == token_end;
 	}
 	token_and_type get();
 	token_and_type next();
@@ -56,11 +63,16 @@ public:
 	void discard_group();
 };
 
+// Splits a file into the tokens that a token_generator would produce from it. Since this does not touch any other state, it
+// can be run for many files in parallel, leaving only the parsing itself to be done in order.
+std::vector<token_and_type> tokenize_file(char const* file_start, char const* file_end);
+
 class error_handler {
 public:
 	std::string file_name;
 	std::string accumulated_errors;
 	std::string accumulated_warnings;
+	std::string build_timings; // filled in by state::load_scenario_data, see sys::scenario_build_timer
 	bool fatal = false;
 
 	error_handler(std::string file_name) : file_name(std::move(file_name)) { }
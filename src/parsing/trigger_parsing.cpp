@@ -784,6 +784,20 @@ bool scope_has_single_member(uint16_t const* source) {
 	return trigger::get_trigger_scope_payload_size(source) == data_offset + trigger::get_trigger_payload_size(source + data_offset);
 }
 
+// 1 for a trigger that is always true, 0 for one that is always false, and -1 for anything else
+int32_t constant_trigger_value(uint16_t const* source) {
+	if((source[0] & trigger::code_mask) != trigger::always)
+		return -1;
+	switch(source[0] & trigger::association_mask) {
+	case trigger::association_gt:
+	case trigger::association_lt:
+	case trigger::association_ne:
+		return 0;
+	default:
+		return 1;
+	}
+}
+
 // yields new source size
 int32_t simplify_trigger(uint16_t* source) {
 	assert((0 <= (*source & trigger::code_mask) && (*source & trigger::code_mask) < trigger::first_invalid_code) ||
@@ -840,6 +854,38 @@ int32_t simplify_trigger(uint16_t* source) {
 			source[1] = uint16_t(source_size - 1);
 		}
 
+		if(source[0] == trigger::generic_scope || source[0] == (trigger::generic_scope | trigger::is_disjunctive_scope)) {
+			/*
+			fold constant members: a member that can't change the result (true in an and, false in an or) is dropped, while
+			a member that decides the result on its own turns the whole scope into that constant. Having been folded, the
+			scope is replaced by a constant rather than removed, since an enclosing scope may still depend on its value
+			*/
+			int32_t const deciding_value = (source[0] & trigger::is_disjunctive_scope) != 0 ? 1 : 0;
+			bool decided = false;
+			bool folded = false;
+			auto sub_units_start = first_member;
+			while(sub_units_start < source + source_size) {
+				auto const size = 1 + trigger::get_trigger_payload_size(sub_units_start);
+				auto const value = constant_trigger_value(sub_units_start);
+				if(value == deciding_value) {
+					decided = true;
+					break;
+				} else if(value != -1) {
+					std::copy(sub_units_start + size, source + source_size, sub_units_start);
+					source_size -= size;
+					folded = true;
+				} else {
+					sub_units_start += size;
+				}
+			}
+			source[1] = uint16_t(source_size - 1);
+			if(decided || (folded && scope_is_empty(source))) {
+				bool const result = decided ? (deciding_value == 1) : (deciding_value == 0);
+				source[0] = uint16_t(trigger::always | trigger::no_payload | (result ? trigger::association_eq : trigger::association_ne));
+				return 1;
+			}
+		}
+
 		if((source[0] & trigger::code_mask) >= trigger::first_scope_code && scope_has_single_member(source)) {
 			if((source[0] & trigger::code_mask) == trigger::generic_scope) { // remove single-member generic scopes
 				std::copy(source + 2, source + source_size, source);
@@ -944,6 +990,22 @@ dcon::value_modifier_key make_value_modifier(token_generator& gen, error_handler
 	auto overall_factor = result.base;
 	auto new_count = context.outer_context.state.value_modifier_segments.size();
 
+	// share an identical run of segments committed earlier, as commit_trigger_data does for trigger bytecode
+	auto& segments = context.outer_context.state.value_modifier_segments;
+	if(new_count > old_count) {
+		auto const run_begin = segments.begin() + old_count;
+		auto existing = std::search(segments.begin(), run_begin, run_begin, segments.end(),
+			[](sys::value_modifier_segment const& a, sys::value_modifier_segment const& b) {
+				return a.factor == b.factor && a.condition == b.condition;
+			});
+		if(existing != run_begin) {
+			auto const existing_offset = size_t(existing - segments.begin());
+			segments.resize(old_count);
+			new_count = existing_offset + (new_count - old_count);
+			old_count = existing_offset;
+		}
+	}
+
 	return context.outer_context.state.value_modifiers.push_back(
 			sys::value_modifier_description{ multiplier, overall_factor, uint16_t(old_count), uint16_t(new_count - old_count)});
 }
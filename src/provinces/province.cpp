@@ -4,6 +4,8 @@
 #include "demographics.hpp"
 #include "nations.hpp"
 #include "system_state.hpp"
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include "rebels.hpp"
 #include "math_fns.hpp"
@@ -26,12 +28,13 @@ bool nations_are_adjacent(sys::state& state, dcon::nation_id a, dcon::nation_id
 	auto it = state.world.get_nation_adjacency_by_nation_adjacency_pair(a, b);
 	return bool(it);
 }
-void update_connected_regions(sys::state& state) {
-	if(!state.adjacency_data_out_of_date)
-		return;
+namespace {
 
-	state.adjacency_data_out_of_date = false;
+bool is_land_connection(dcon::province_adjacency_fat_id rel) {
+	return (rel.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) == 0; // not entering sea, not impassible
+}
 
+void rebuild_all_connected_regions(sys::state& state) {
 	state.world.nation_adjacency_resize(0);
 
 	state.world.for_each_province([&](dcon::province_id id) { state.world.province_set_connected_region_id(id, 0); });
@@ -39,6 +42,7 @@ void update_connected_regions(sys::state& state) {
 	static std::vector<dcon::province_id> to_fill_list;
 	uint16_t current_fill_id = 0;
 	state.province_definitions.connected_region_is_coastal.clear();
+	state.province_definitions.free_connected_regions.clear();
 
 	to_fill_list.reserve(state.world.province_size());
 
@@ -59,8 +63,7 @@ void update_connected_regions(sys::state& state) {
 
 				state.world.province_set_connected_region_id(current_id, current_fill_id);
 				for(auto rel : state.world.province_get_province_adjacency(current_id)) {
-					if((rel.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) ==
-							0) { // not entering sea, not impassible
+					if(is_land_connection(rel)) {
 						auto owner_a = rel.get_connected_provinces(0).get_nation_from_province_ownership();
 						auto owner_b = rel.get_connected_provinces(1).get_nation_from_province_ownership();
 						if(owner_a == owner_b) { // both have the same owner
@@ -79,6 +82,137 @@ void update_connected_regions(sys::state& state) {
 			to_fill_list.clear();
 		}
 	}
+}
+
+void rebuild_nation_adjacency(sys::state& state, dcon::nation_id n) {
+	auto existing = state.world.nation_get_nation_adjacency(n);
+	while(existing.begin() != existing.end()) {
+		state.world.delete_nation_adjacency((*existing.begin()).id);
+	}
+	for(auto po : state.world.nation_get_province_ownership(n)) {
+		for(auto rel : po.get_province().get_province_adjacency()) {
+			if(is_land_connection(rel)) {
+				auto owner_a = rel.get_connected_provinces(0).get_nation_from_province_ownership();
+				auto owner_b = rel.get_connected_provinces(1).get_nation_from_province_ownership();
+				if(owner_a != owner_b)
+					state.world.try_create_nation_adjacency(owner_a, owner_b);
+			}
+		}
+	}
+}
+
+/*
+Only the regions that an ownership change can have split or joined are filled again: the region the province was in, and
+the regions of its neighbors that now have the same owner. Together they contain every province whose region may have
+changed, and no province outside of them is connected to one inside. The adjacency of nations only changes for the old
+and new owners, so only theirs is rebuilt.
+*/
+void update_changed_connected_regions(sys::state& state) {
+	auto& changes = state.province_definitions.ownership_changes;
+	auto& free_ids = state.province_definitions.free_connected_regions;
+
+	static std::vector<dcon::province_id> seeds;
+	static std::vector<dcon::province_id> affected;
+	static std::vector<dcon::province_id> to_fill_list;
+	seeds.clear();
+	affected.clear();
+
+	for(auto p : changes) {
+		seeds.push_back(p);
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		for(auto rel : state.world.province_get_province_adjacency(p)) {
+			if(!is_land_connection(rel))
+				continue;
+			auto other = rel.get_connected_provinces(0) != p ? rel.get_connected_provinces(0) : rel.get_connected_provinces(1);
+			if(other.get_nation_from_province_ownership() == owner)
+				seeds.push_back(other);
+		}
+	}
+
+	// collect the affected regions by their old ids, which stay connected over land; a collected province is left with id 0
+	for(auto s : seeds) {
+		auto region = state.world.province_get_connected_region_id(s);
+		if(region == 0)
+			continue;
+		free_ids.push_back(region);
+		state.world.province_set_connected_region_id(s, 0);
+		to_fill_list.push_back(s);
+		while(!to_fill_list.empty()) {
+			auto current_id = to_fill_list.back();
+			to_fill_list.pop_back();
+			affected.push_back(current_id);
+			for(auto rel : state.world.province_get_province_adjacency(current_id)) {
+				if(!is_land_connection(rel))
+					continue;
+				auto other = rel.get_connected_provinces(0) != current_id ? rel.get_connected_provinces(0) : rel.get_connected_provinces(1);
+				if(other.get_connected_region_id() == region) {
+					other.set_connected_region_id(0);
+					to_fill_list.push_back(other);
+				}
+			}
+		}
+	}
+
+	// hand out the lowest free ids first
+	std::sort(free_ids.begin(), free_ids.end(), std::greater<uint16_t>());
+
+	for(auto id : affected) {
+		if(state.world.province_get_connected_region_id(id) != 0)
+			continue;
+
+		uint16_t fill_id = 0;
+		if(!free_ids.empty()) {
+			fill_id = free_ids.back();
+			free_ids.pop_back();
+		} else {
+			state.province_definitions.connected_region_is_coastal.push_back(false);
+			fill_id = uint16_t(state.province_definitions.connected_region_is_coastal.size());
+		}
+
+		bool found_coast = false;
+		state.world.province_set_connected_region_id(id, fill_id);
+		to_fill_list.push_back(id);
+		while(!to_fill_list.empty()) {
+			auto current_id = to_fill_list.back();
+			to_fill_list.pop_back();
+
+			found_coast = found_coast || state.world.province_get_is_coast(current_id);
+			auto owner = state.world.province_get_nation_from_province_ownership(current_id);
+
+			for(auto rel : state.world.province_get_province_adjacency(current_id)) {
+				if(!is_land_connection(rel))
+					continue;
+				auto other = rel.get_connected_provinces(0) != current_id ? rel.get_connected_provinces(0) : rel.get_connected_provinces(1);
+				if(other.get_connected_region_id() == 0 && other.get_nation_from_province_ownership() == owner) {
+					other.set_connected_region_id(fill_id);
+					to_fill_list.push_back(other);
+				}
+			}
+		}
+		state.province_definitions.connected_region_is_coastal[fill_id - 1] = found_coast;
+	}
+
+	auto& nations = state.province_definitions.ownership_change_nations;
+	std::sort(nations.begin(), nations.end(), [](dcon::nation_id a, dcon::nation_id b) { return a.index() < b.index(); });
+	nations.erase(std::unique(nations.begin(), nations.end()), nations.end());
+	for(auto n : nations)
+		rebuild_nation_adjacency(state, n);
+}
+
+}
+
+void update_connected_regions(sys::state& state) {
+	if(!state.adjacency_data_out_of_date && state.province_definitions.ownership_changes.empty())
+		return;
+
+	if(state.adjacency_data_out_of_date)
+		rebuild_all_connected_regions(state);
+	else
+		update_changed_connected_regions(state);
+
+	state.adjacency_data_out_of_date = false;
+	state.province_definitions.ownership_changes.clear();
+	state.province_definitions.ownership_change_nations.clear();
 
 	// we also invalidate wargoals here that are now unowned
 	military::invalidate_unowned_wargoals(state);
@@ -263,9 +397,7 @@ void update_cached_values(sys::state& state) {
 
 void update_blockaded_cache(sys::state& state) {
 	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_blockaded(ids, ve::int_vector()); });
-	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
-		dcon::province_id pid{ dcon::province_id::value_base_t(i) };
-
+	for(auto pid : state.province_definitions.port_provinces) {
 		auto owner = state.world.province_get_nation_from_province_ownership(pid);
 		if(owner) {
 			if(!is_overseas(state, pid)) {
@@ -277,10 +409,35 @@ void update_blockaded_cache(sys::state& state) {
 	}
 }
 
+void update_colonizable_state(sys::state& state, dcon::state_definition_id d) {
+	bool has_unowned_land = false;
+	for(auto p : state.world.state_definition_get_abstract_state_membership(d)) {
+		if(!p.get_province().get_nation_from_province_ownership() && p.get_province().id.index() < state.province_definitions.first_sea_province.index()) {
+			has_unowned_land = true;
+			break;
+		}
+	}
+	auto& list = state.province_definitions.colonizable_states;
+	auto it = std::lower_bound(list.begin(), list.end(), d, [](dcon::state_definition_id a, dcon::state_definition_id b) { return a.index() < b.index(); });
+	bool listed = it != list.end() && *it == d;
+	if(has_unowned_land && !listed)
+		list.insert(it, d);
+	else if(!has_unowned_land && listed)
+		list.erase(it);
+}
+
 void restore_unsaved_values(sys::state& state) {
+	state.province_definitions.colonizable_states.clear();
+	for(auto d : state.world.in_state_definition)
+		update_colonizable_state(state, d);
+
+	state.province_definitions.port_provinces.clear();
 	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
 		dcon::province_id pid{dcon::province_id::value_base_t(i)};
 
+		if(state.world.province_get_port_to(pid))
+			state.province_definitions.port_provinces.push_back(pid);
+
 		for(auto adj : state.world.province_get_province_adjacency(pid)) {
 			if((state.world.province_adjacency_get_type(adj) & province::border::coastal_bit) != 0 &&
 					(state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0) {
@@ -671,7 +828,14 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 	if(new_owner == old_owner)
 		return;
 
-	state.adjacency_data_out_of_date = true;
+	if(old_owner && new_owner) {
+		state.province_definitions.ownership_changes.push_back(id);
+		state.province_definitions.ownership_change_nations.push_back(old_owner);
+		state.province_definitions.ownership_change_nations.push_back(new_owner);
+	} else {
+		// the adjacency of the provinces without an owner is not tracked for each province, so it has to be found again
+		state.adjacency_data_out_of_date = true;
+	}
 	state.national_cached_values_out_of_date = true;
 
 	bool state_is_new = false;
@@ -824,6 +988,8 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 	}
 
 	state.world.province_set_nation_from_province_ownership(id, new_owner);
+	if(!old_owner || !new_owner)
+		update_colonizable_state(state, state_def);
 	state.world.province_set_rebel_faction_from_province_rebel_control(id, dcon::rebel_faction_id{});
 	state.world.province_set_last_control_change(id, state.current_date);
 	state.world.province_set_nation_from_province_control(id, new_owner);
@@ -963,33 +1129,39 @@ void update_nationalism(sys::state& state) {
 }
 
 void update_crimes(sys::state& state) {
-	for_each_land_province(state, [&](dcon::province_id p) {
+	/*
+	Once per month (the 1st) province crimes are updated. If the province has a crime, the crime fighting percent is the
+	probability of that crime being removed. If there is no crime, the crime fighting percent is the probability that it will
+	remain crime free. If a crime is added to the province, it is selected randomly (with equal probability) from the crimes
+	that are possible for the province (determined by the crime being activated and its trigger passing).
+	*/
+
+	// The new crime of every province is decided in parallel, from the crimes as they were at the start of the update, and
+	// only then written back together with the changes to the national crime counts, which are shared between provinces.
+	// The random values are drawn per province, so the order in which they are decided doesn't matter.
+	constexpr uint8_t unchanged = 0;
+	constexpr uint8_t removed = 1;
+	constexpr uint8_t added = 2;
+	std::vector<uint8_t> change(state.world.province_size(), unchanged);
+	std::vector<dcon::crime_id> new_crime(state.world.province_size());
+
+	concurrency::parallel_for(0, int32_t(state.province_definitions.first_sea_province.index()), [&](int32_t i) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
 		auto owner = state.world.province_get_nation_from_province_ownership(p);
 		if(!owner)
 			return;
 
-		/*
-		Once per month (the 1st) province crimes are updated. If the province has a crime, the crime fighting percent is the
-		probability of that crime being removed. If there is no crime, the crime fighting percent is the probability that it will
-		remain crime free. If a crime is added to the province, it is selected randomly (with equal probability) from the crimes
-		that are possible for the province (determined by the crime being activated and its trigger passing).
-		*/
-
 		auto chance = uint32_t(province::crime_fighting_efficiency(state, p) * 256.0f);
 		auto rvalues = rng::get_random_pair(state, uint32_t((p.index() << 2) + 1));
 		if((rvalues.high & 0xFF) >= chance) {
-			if(state.world.province_get_crime(p)) {
-				if(!province::is_overseas(state, p))
-					state.world.nation_get_central_crime_count(owner) -= uint16_t(1);
-			}
-			state.world.province_set_crime(p, dcon::crime_id{});
+			change[i] = removed;
 		} else {
 			if(!state.world.province_get_crime(p)) {
-				static std::vector<dcon::crime_id> possible_crimes;
+				thread_local std::vector<dcon::crime_id> possible_crimes;
 				possible_crimes.clear();
 
-				for(uint32_t i = 0; i < state.culture_definitions.crimes.size(); ++i) {
-					dcon::crime_id c{dcon::crime_id::value_base_t(i)};
+				for(uint32_t j = 0; j < state.culture_definitions.crimes.size(); ++j) {
+					dcon::crime_id c{dcon::crime_id::value_base_t(j)};
 					if(state.culture_definitions.crimes[c].available_by_default || state.world.nation_get_active_crime(owner, c)) {
 						if(auto t = state.culture_definitions.crimes[c].trigger; t) {
 							if(trigger::evaluate(state, t, trigger::to_generic(p), trigger::to_generic(owner), 0))
@@ -1001,14 +1173,27 @@ void update_crimes(sys::state& state) {
 				}
 
 				if(auto count = possible_crimes.size(); count != 0) {
-					auto selected = possible_crimes[rvalues.low % count];
-					state.world.province_set_crime(p, selected);
-					if(!province::is_overseas(state, p))
-						state.world.nation_get_central_crime_count(owner) += uint16_t(1);
+					change[i] = added;
+					new_crime[i] = possible_crimes[rvalues.low % count];
 				}
 			}
 		}
 	});
+
+	for_each_land_province(state, [&](dcon::province_id p) {
+		auto owner = state.world.province_get_nation_from_province_ownership(p);
+		if(change[p.index()] == removed) {
+			if(state.world.province_get_crime(p)) {
+				if(!province::is_overseas(state, p))
+					state.world.nation_get_central_crime_count(owner) -= uint16_t(1);
+			}
+			state.world.province_set_crime(p, dcon::crime_id{});
+		} else if(change[p.index()] == added) {
+			state.world.province_set_crime(p, new_crime[p.index()]);
+			if(!province::is_overseas(state, p))
+				state.world.nation_get_central_crime_count(owner) += uint16_t(1);
+		}
+	});
 }
 
 bool is_colonizing(sys::state& state, dcon::nation_id n, dcon::state_definition_id d) {
@@ -1544,6 +1729,7 @@ void set_rgo(sys::state& state, dcon::province_id prov, dcon::commodity_id c) {
 
 void enable_canal(sys::state& state, int32_t id) {
 	state.world.province_adjacency_get_type(state.province_definitions.canals[id]) &= ~province::border::impassible_bit;
+	update_movement_regions(state);
 }
 
 // distance between to adjacent provinces
@@ -1566,6 +1752,22 @@ float sorting_distance(sys::state& state, dcon::province_id a, dcon::province_id
 	return -dot;
 }
 
+float path_distance_lower_bound(sys::state& state, dcon::province_id a, dcon::province_id b) {
+	auto bound = direct_distance(state, a, b);
+	auto count = state.province_definitions.landmark_count;
+	if(count == 0)
+		return bound;
+
+	// by the triangle inequality, a path from a to b can be no shorter than the difference of their distances to any landmark
+	float const* da = state.province_definitions.landmark_distances.data() + size_t(a.index()) * size_t(count);
+	float const* db = state.province_definitions.landmark_distances.data() + size_t(b.index()) * size_t(count);
+	for(int32_t i = 0; i < count; ++i) {
+		if(da[i] != std::numeric_limits<float>::max() && db[i] != std::numeric_limits<float>::max())
+			bound = std::max(bound, std::abs(da[i] - db[i]));
+	}
+	return bound;
+}
+
 // whether a ship can dock at a land province
 bool has_naval_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov) {
 	auto controller = state.world.province_get_nation_from_province_control(prov);
@@ -1594,6 +1796,22 @@ bool has_naval_access_to_province(sys::state& state, dcon::nation_id nation_as,
 }
 
 // determines whether a land unit is allowed to move to / be in a province
+scoped_land_access_cache::scoped_land_access_cache(sys::state& state) : state(state) {
+	auto& cache = state.land_access;
+	assert(!cache.enabled);
+	for(auto r : cache.used_rows)
+		cache.rows[r].clear();
+	cache.used_rows.clear();
+	cache.rows.resize(state.world.nation_size());
+	cache.owner = std::this_thread::get_id();
+	cache.enabled = true;
+}
+scoped_land_access_cache::~scoped_land_access_cache() {
+	state.land_access.enabled = false;
+}
+
+static bool nation_has_access_to_controller(sys::state& state, dcon::nation_id nation_as, dcon::nation_id controller);
+
 bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov) {
 	auto controller = state.world.province_get_nation_from_province_control(prov);
 
@@ -1606,6 +1824,23 @@ bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::
 	if(controller == nation_as)
 		return true;
 
+	auto& cache = state.land_access;
+	if(cache.enabled && cache.owner == std::this_thread::get_id() && nation_as.index() < int32_t(cache.rows.size())) {
+		auto& row = cache.rows[nation_as.index()];
+		if(row.empty()) {
+			row.resize(cache.rows.size(), uint8_t(0));
+			cache.used_rows.push_back(nation_as.index());
+		}
+		auto& v = row[controller.index()];
+		if(v == 0)
+			v = nation_has_access_to_controller(state, nation_as, controller) ? 2 : 1;
+		return v == 2;
+	}
+
+	return nation_has_access_to_controller(state, nation_as, controller);
+}
+
+static bool nation_has_access_to_controller(sys::state& state, dcon::nation_id nation_as, dcon::nation_id controller) {
 	if(state.world.nation_get_in_sphere_of(controller) == nation_as)
 		return true;
 
@@ -1652,6 +1887,39 @@ bool has_safe_access_to_province(sys::state& state, dcon::nation_id nation_as, d
 	return false;
 }
 
+// Per-thread stand-in for a province-sized origins buffer, so that the pathfinding functions neither allocate nor clear
+// one on every call: entries written before the most recent reset read as unset.
+class path_origins {
+	std::vector<dcon::province_id> origins;
+	std::vector<uint32_t> stamps;
+	uint32_t generation = 0;
+public:
+	void reset(size_t province_count) {
+		if(origins.size() < province_count) {
+			origins.resize(province_count);
+			stamps.resize(province_count, 0);
+		}
+		++generation;
+		if(generation == 0) { // wrapped around
+			std::fill(stamps.begin(), stamps.end(), 0);
+			generation = 1;
+		}
+	}
+	dcon::province_id get(dcon::province_id p) const {
+		return stamps[p.index()] == generation ? origins[p.index()] : dcon::province_id{};
+	}
+	void set(dcon::province_id p, dcon::province_id v) {
+		stamps[p.index()] = generation;
+		origins[p.index()] = v;
+	}
+};
+
+static path_origins& get_reset_path_origins(sys::state& state) {
+	thread_local path_origins origins;
+	origins.reset(state.world.province_size());
+	return origins;
+}
+
 struct province_and_distance {
 	float distance_covered = 0.0f;
 	float distance_to_target = 0.0f;
@@ -1664,16 +1932,44 @@ struct province_and_distance {
 	}
 };
 
+// like the origins, the heap is reused between searches on the same thread rather than reallocated for every path
+static std::vector<province_and_distance>& get_reset_path_heap() {
+	thread_local std::vector<province_and_distance> heap;
+	heap.clear();
+	return heap;
+}
+
 static void assert_path_result(std::vector<dcon::province_id>& v) {
 	for(auto const e : v)
 		assert(bool(e));
 }
 
 // normal pathfinding
+// Land paths that may not cross the coast can only join provinces in the same movement region, so
+// a destination in any other region can be rejected without expanding the start's whole landmass.
+static bool in_different_land_regions(sys::state& state, dcon::province_id a, dcon::province_id b) {
+	auto const& regions = state.province_definitions.movement_region;
+	if(regions.empty())
+		return false;
+	if(a.index() >= state.province_definitions.first_sea_province.index() || b.index() >= state.province_definitions.first_sea_province.index())
+		return false;
+	return regions[a.index()] != regions[b.index()];
+}
+
+// The sea region a fleet in the province sails in; land provinces use the region of the sea they port to.
+static uint16_t naval_region(sys::state& state, dcon::province_id p) {
+	auto const& regions = state.province_definitions.movement_region;
+	if(p.index() < state.province_definitions.first_sea_province.index()) {
+		auto port = state.world.province_get_port_to(p);
+		return port ? regions[port.index()] : uint16_t(0);
+	}
+	return regions[p.index()];
+}
+
 std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a) {
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& path_heap = get_reset_path_heap();
+	auto& origins_vector = get_reset_path_origins(state);
 
 	std::vector<dcon::province_id> path_result;
 
@@ -1688,7 +1984,7 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 		}
 	};
 
-	path_heap.push_back(province_and_distance{0.0f, direct_distance(state, start, end), start});
+	path_heap.push_back(province_and_distance{0.0f, path_distance_lower_bound(state, start, end), start});
 	while(path_heap.size() > 0) {
 		std::pop_heap(path_heap.begin(), path_heap.end());
 		auto nearest = path_heap.back();
@@ -1713,7 +2009,7 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 						auto armies = state.world.province_get_army_location(other_prov);
 						float danger_factor = (armies.begin() == armies.end() || (*armies.begin()).get_army().get_controller_from_army_control() == nation_as) ? 1.f : 4.f;
 						path_heap.push_back(
-								province_and_distance{nearest.distance_covered + distance * danger_factor, direct_distance(state, other_prov, end) * danger_factor, other_prov});
+								province_and_distance{nearest.distance_covered + distance * danger_factor, path_distance_lower_bound(state, other_prov, end) * danger_factor, other_prov});
 						std::push_heap(path_heap.begin(), path_heap.end());
 						origins_vector.set(other_prov, nearest.province);
 					} else {
@@ -1722,7 +2018,7 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 				} else { // is sea
 					if(military::can_embark_onto_sea_tile(state, nation_as, other_prov, a)) {
 						path_heap.push_back(
-								province_and_distance{nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov});
+								province_and_distance{nearest.distance_covered + distance, path_distance_lower_bound(state, other_prov, end), other_prov});
 						std::push_heap(path_heap.begin(), path_heap.end());
 						origins_vector.set(other_prov, nearest.province);
 					} else {
@@ -1739,13 +2035,15 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 
 std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& path_heap = get_reset_path_heap();
+	auto& origins_vector = get_reset_path_origins(state);
 
 	std::vector<dcon::province_id> path_result;
 
 	if(start == end)
 		return path_result;
+	if(in_different_land_regions(state, start, end))
+		return path_result;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
@@ -1755,7 +2053,7 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 		}
 	};
 
-	path_heap.push_back(province_and_distance{ 0.0f, direct_distance(state, start, end), start });
+	path_heap.push_back(province_and_distance{ 0.0f, path_distance_lower_bound(state, start, end), start });
 	while(path_heap.size() > 0) {
 		std::pop_heap(path_heap.begin(), path_heap.end());
 		auto nearest = path_heap.back();
@@ -1777,7 +2075,7 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 				if(other_prov.id.index() < state.province_definitions.first_sea_province.index()) { // is land
 					if(other_prov.get_siege_progress() == 0 && has_safe_access_to_province(state, nation_as, other_prov)) {
 						path_heap.push_back(
-								province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
+								province_and_distance{ nearest.distance_covered + distance, path_distance_lower_bound(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
 						origins_vector.set(other_prov, nearest.province);
 					} else {
@@ -1794,15 +2092,144 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 	return path_result;
 }
 
+std::vector<dcon::province_id> land_path_field::path_from(dcon::province_id start) const {
+	std::vector<dcon::province_id> path_result;
+	if(start == destination || !reaches(start))
+		return path_result;
+
+	for(auto p = next[start.index()]; p != destination; p = next[p.index()]) {
+		assert(p);
+		path_result.push_back(p);
+	}
+	path_result.push_back(destination);
+	std::reverse(path_result.begin(), path_result.end());
+
+	assert_path_result(path_result);
+	return path_result;
+}
+
+void make_safe_land_path_field(sys::state& state, land_path_field& field, dcon::province_id destination, dcon::nation_id nation_as, std::vector<dcon::province_id> const& sources) {
+	field.destination = destination;
+	field.distances.assign(state.world.province_size(), std::numeric_limits<float>::max());
+	field.next.assign(state.world.province_size(), dcon::province_id{});
+
+	std::vector<bool> unsettled_source(state.world.province_size(), false);
+	int32_t unsettled_count = 0;
+	for(auto s : sources) {
+		if(s != destination && !unsettled_source[s.index()]) {
+			unsettled_source[s.index()] = true;
+			++unsettled_count;
+		}
+	}
+
+	auto& path_heap = get_reset_path_heap();
+	field.distances[destination.index()] = 0.0f;
+	path_heap.push_back(province_and_distance{ 0.0f, 0.0f, destination });
+	while(path_heap.size() > 0 && unsettled_count > 0) {
+		std::pop_heap(path_heap.begin(), path_heap.end());
+		auto nearest = path_heap.back();
+		path_heap.pop_back();
+
+		if(nearest.distance_covered > field.distances[nearest.province.index()])
+			continue; // superseded by a shorter route
+		if(unsettled_source[nearest.province.index()]) {
+			unsettled_source[nearest.province.index()] = false;
+			--unsettled_count;
+		}
+
+		// as in make_safe_land_path, a path may start in any province, but may only pass through safe ones
+		if(nearest.province != destination && (state.world.province_get_siege_progress(nearest.province) != 0 || !has_safe_access_to_province(state, nation_as, nearest.province)))
+			continue;
+
+		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
+			auto other_prov =
+				adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			if((adj.get_type() & province::border::impassible_bit) != 0 || other_prov.id.index() >= state.province_definitions.first_sea_province.index())
+				continue;
+
+			auto distance = nearest.distance_covered + adj.get_distance();
+			if(distance < field.distances[other_prov.id.index()]) {
+				field.distances[other_prov.id.index()] = distance;
+				field.next[other_prov.id.index()] = nearest.province;
+				path_heap.push_back(province_and_distance{ distance, 0.0f, other_prov });
+				std::push_heap(path_heap.begin(), path_heap.end());
+			}
+		}
+	}
+}
+
+void make_land_path_field(sys::state& state, land_path_field& field, dcon::province_id destination, dcon::nation_id nation_as, dcon::army_id largest, std::vector<dcon::province_id> const& sources) {
+	field.destination = destination;
+	field.distances.assign(state.world.province_size(), std::numeric_limits<float>::max());
+	field.next.assign(state.world.province_size(), dcon::province_id{});
+
+	std::vector<bool> unsettled_source(state.world.province_size(), false);
+	int32_t unsettled_count = 0;
+	for(auto s : sources) {
+		if(s != destination && !unsettled_source[s.index()]) {
+			unsettled_source[s.index()] = true;
+			++unsettled_count;
+		}
+	}
+
+	auto& path_heap = get_reset_path_heap();
+	field.distances[destination.index()] = 0.0f;
+	path_heap.push_back(province_and_distance{ 0.0f, 0.0f, destination });
+	while(path_heap.size() > 0 && unsettled_count > 0) {
+		std::pop_heap(path_heap.begin(), path_heap.end());
+		auto nearest = path_heap.back();
+		path_heap.pop_back();
+
+		if(nearest.distance_covered > field.distances[nearest.province.index()])
+			continue; // superseded by a shorter route
+		if(unsettled_source[nearest.province.index()]) {
+			unsettled_source[nearest.province.index()] = false;
+			--unsettled_count;
+		}
+
+		// as in make_land_path, a path may start in any province, but may only pass through the ones it could enter
+		bool is_land = nearest.province.index() < state.province_definitions.first_sea_province.index();
+		if(nearest.province != destination) {
+			if(is_land ? !has_access_to_province(state, nation_as, nearest.province) : !military::can_embark_onto_sea_tile(state, nation_as, nearest.province, largest))
+				continue;
+		}
+		// make_land_path charges for entering a province with an army of someone else in it, which is this province here,
+		// the steps being taken backwards
+		float danger_factor = 1.0f;
+		if(is_land) {
+			auto armies = state.world.province_get_army_location(nearest.province);
+			if(armies.begin() != armies.end() && (*armies.begin()).get_army().get_controller_from_army_control() != nation_as)
+				danger_factor = 4.0f;
+		}
+
+		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
+			auto other_prov =
+				adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			if((adj.get_type() & province::border::impassible_bit) != 0)
+				continue;
+
+			auto distance = nearest.distance_covered + adj.get_distance() * danger_factor;
+			if(distance < field.distances[other_prov.id.index()]) {
+				field.distances[other_prov.id.index()] = distance;
+				field.next[other_prov.id.index()] = nearest.province;
+				path_heap.push_back(province_and_distance{ distance, 0.0f, other_prov });
+				std::push_heap(path_heap.begin(), path_heap.end());
+			}
+		}
+	}
+}
+
 // used for rebel unit and black-flagged unit pathfinding
 std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& path_heap = get_reset_path_heap();
+	auto& origins_vector = get_reset_path_origins(state);
 
 	std::vector<dcon::province_id> path_result;
 
 	if(start == end)
 		return path_result;
+	if(in_different_land_regions(state, start, end))
+		return path_result;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
@@ -1812,7 +2239,7 @@ std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::p
 		}
 	};
 
-	path_heap.push_back(province_and_distance{0.0f, direct_distance(state, start, end), start});
+	path_heap.push_back(province_and_distance{0.0f, path_distance_lower_bound(state, start, end), start});
 	while(path_heap.size() > 0) {
 		std::pop_heap(path_heap.begin(), path_heap.end());
 		auto nearest = path_heap.back();
@@ -1832,7 +2259,7 @@ std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::p
 				}
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is land province
 					path_heap.push_back(
-							province_and_distance{nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov});
+							province_and_distance{nearest.distance_covered + distance, path_distance_lower_bound(state, other_prov, end), other_prov});
 					std::push_heap(path_heap.begin(), path_heap.end());
 					origins_vector.set(other_prov, nearest.province);
 				}
@@ -1847,13 +2274,19 @@ std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::p
 // naval unit pathfinding; start and end provinces may be land provinces; function assumes you have naval access to both
 std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& path_heap = get_reset_path_heap();
+	auto& origins_vector = get_reset_path_origins(state);
 
 	std::vector<dcon::province_id> path_result;
 
 	if(start == end)
 		return path_result;
+	if(!state.province_definitions.movement_region.empty()) {
+		// fleets never leave the sea region they start in, and only enter a port from the sea it ports to
+		auto start_region = naval_region(state, start);
+		if(start_region == 0 || start_region != naval_region(state, end))
+			return path_result;
+	}
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
@@ -1863,7 +2296,7 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 		}
 	};
 
-	path_heap.push_back(province_and_distance{0.0f, direct_distance(state, start, end), start});
+	path_heap.push_back(province_and_distance{0.0f, path_distance_lower_bound(state, start, end), start});
 	while(path_heap.size() > 0) {
 		std::pop_heap(path_heap.begin(), path_heap.end());
 		auto nearest = path_heap.back();
@@ -1889,7 +2322,7 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 						return path_result;
 					} else {
 
-						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
+						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, path_distance_lower_bound(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
 						origins_vector.set(other_prov, nearest.province);
 					}
@@ -1905,7 +2338,7 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 						assert_path_result(path_result);
 						return path_result;
 					} else {
-						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
+						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, path_distance_lower_bound(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
 						origins_vector.set(other_prov, nearest.province);
 					}
@@ -1932,7 +2365,7 @@ struct retreat_province_and_distance {
 std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
 
 	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& origins_vector = get_reset_path_origins(state);
 
 	std::vector<dcon::province_id> path_result;
 
@@ -1986,7 +2419,7 @@ std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::
 std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
 
 	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& origins_vector = get_reset_path_origins(state);
 
 	origins_vector.set(start, dcon::province_id{0});
 
@@ -2035,7 +2468,7 @@ std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::n
 
 std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
 	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& origins_vector = get_reset_path_origins(state);
 
 	origins_vector.set(start, dcon::province_id{0});
 
@@ -2087,7 +2520,7 @@ std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dco
 }
 std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start) {
 	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	auto& origins_vector = get_reset_path_origins(state);
 
 	origins_vector.set(start, dcon::province_id{0});
 
@@ -2157,4 +2590,94 @@ void restore_distances(sys::state& state) {
 	}
 }
 
+// The landmarks are picked one at a time as the province furthest from all of the landmarks picked so far, which spreads them
+// out towards the edges of the map where they give the tightest bounds. Adjacencies are measured whether or not they are
+// impassible, so that opening a canal can't make the bounds too large.
+void update_landmark_distances(sys::state& state) {
+	constexpr int32_t max_landmarks = 16;
+	auto province_count = state.world.province_size();
+	auto& distances = state.province_definitions.landmark_distances;
+	auto& count = state.province_definitions.landmark_count;
+
+	count = std::min(max_landmarks, int32_t(province_count));
+	distances.assign(size_t(province_count) * size_t(count), std::numeric_limits<float>::max());
+	if(count == 0)
+		return;
+
+	std::vector<float> from_landmark(province_count);
+	std::vector<float> nearest_landmark(province_count, std::numeric_limits<float>::max());
+	std::vector<province_and_distance> path_heap;
+	auto shortest_distances_from = [&](dcon::province_id source) {
+		std::fill(from_landmark.begin(), from_landmark.end(), std::numeric_limits<float>::max());
+		from_landmark[source.index()] = 0.0f;
+		path_heap.push_back(province_and_distance{ 0.0f, 0.0f, source });
+		while(path_heap.size() > 0) {
+			std::pop_heap(path_heap.begin(), path_heap.end());
+			auto nearest = path_heap.back();
+			path_heap.pop_back();
+			if(nearest.distance_covered > from_landmark[nearest.province.index()])
+				continue; // superseded by a shorter route
+
+			for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
+				auto other_prov = adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+				auto distance = nearest.distance_covered + adj.get_distance();
+				if(distance < from_landmark[other_prov.id.index()]) {
+					from_landmark[other_prov.id.index()] = distance;
+					path_heap.push_back(province_and_distance{ distance, 0.0f, other_prov });
+					std::push_heap(path_heap.begin(), path_heap.end());
+				}
+			}
+		}
+	};
+
+	// the first landmark is the province furthest from province 0
+	shortest_distances_from(dcon::province_id{ 0 });
+	std::copy(from_landmark.begin(), from_landmark.end(), nearest_landmark.begin());
+	for(int32_t i = 0; i < count; ++i) {
+		// only provinces that can be reached are candidates, so that provinces without any adjacencies don't use up landmarks
+		dcon::province_id furthest{ 0 };
+		for(uint32_t j = 0; j < province_count; ++j) {
+			if(nearest_landmark[j] != std::numeric_limits<float>::max() && nearest_landmark[j] > nearest_landmark[furthest.index()])
+				furthest = dcon::province_id{ dcon::province_id::value_base_t(j) };
+		}
+		shortest_distances_from(furthest);
+		for(uint32_t j = 0; j < province_count; ++j) {
+			distances[size_t(j) * size_t(count) + size_t(i)] = from_landmark[j];
+			if(i == 0)
+				nearest_landmark[j] = from_landmark[j];
+			else
+				nearest_landmark[j] = std::min(nearest_landmark[j], from_landmark[j]);
+		}
+	}
+}
+
+void update_movement_regions(sys::state& state) {
+	auto& regions = state.province_definitions.movement_region;
+	regions.assign(state.world.province_size(), uint16_t(0));
+
+	std::vector<dcon::province_id> to_fill_list;
+	uint16_t current_fill_id = 0;
+	for(auto p : state.world.in_province) {
+		if(regions[p.id.index()] != 0)
+			continue;
+
+		++current_fill_id;
+		regions[p.id.index()] = current_fill_id;
+		to_fill_list.push_back(p);
+		while(!to_fill_list.empty()) {
+			auto current_id = to_fill_list.back();
+			to_fill_list.pop_back();
+			for(auto adj : state.world.province_get_province_adjacency(current_id)) {
+				if((adj.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) == 0) {
+					auto other = adj.get_connected_provinces(0) == current_id ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+					if(regions[other.id.index()] == 0) {
+						regions[other.id.index()] = current_fill_id;
+						to_fill_list.push_back(other);
+					}
+				}
+			}
+		}
+	}
+}
+
 } // namespace province
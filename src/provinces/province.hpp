@@ -1,5 +1,7 @@
 #pragma once
 
+#include <thread>
+#include <vector>
 #include "dcon_generated.hpp"
 #include "constants.hpp"
 
@@ -22,6 +24,30 @@ struct global_provincial_state {
 	std::vector<dcon::province_id> canal_provinces;
 	ankerl::unordered_dense::map<dcon::modifier_id, dcon::gfx_object_id, sys::modifier_hash> terrain_to_gfx_map;
 	std::vector<bool> connected_region_is_coastal;
+	// ids of connected regions that no province is in any more, to be given to new regions first; see update_connected_regions
+	std::vector<uint16_t> free_connected_regions;
+	// the provinces that have changed hands between two nations since the connected regions were last updated, and those
+	// nations; see change_province_owner
+	std::vector<dcon::province_id> ownership_changes;
+	std::vector<dcon::nation_id> ownership_change_nations;
+	// provinces that can reach each other without crossing a coast or an impassible border share a movement region;
+	// land and sea provinces never share one. Unlike the connected regions, these do not depend on ownership.
+	std::vector<uint16_t> movement_region;
+	// the shortest distance from each of landmark_count landmark provinces to every province, over all adjacencies whether
+	// or not they can currently be crossed; province p has the entries [p * landmark_count, (p + 1) * landmark_count).
+	// see path_distance_lower_bound
+	std::vector<float> landmark_distances;
+	int32_t landmark_count = 0;
+	// the land provinces with a port, which are the only ones that can be blockaded; see restore_unsaved_values
+	std::vector<dcon::province_id> port_provinces;
+	// the state definitions with at least one unowned land province, which are the only ones a colony can be started in,
+	// in id order; kept up to date by change_province_owner, see update_colonizable_state
+	std::vector<dcon::state_definition_id> colonizable_states;
+	// for each province, the commodities with a nonzero rgo_max_size_per_good, which together with its main rgo are
+	// the only goods it can produce; the goods of province p are rgo_goods[rgo_goods_start[p] .. rgo_goods_start[p + 1])
+	// see economy::update_rgo_goods
+	std::vector<uint32_t> rgo_goods_start;
+	std::vector<dcon::commodity_id> rgo_goods;
 
 	dcon::province_id first_sea_province;
 	dcon::modifier_id europe;
@@ -38,6 +64,8 @@ void update_cached_values(sys::state& state);
 void update_blockaded_cache(sys::state& state);
 void restore_unsaved_values(sys::state& state);
 void restore_distances(sys::state& state);
+void update_movement_regions(sys::state& state);
+void update_landmark_distances(sys::state& state);
 
 bool is_overseas(sys::state const& state, dcon::province_id ids);
 bool can_integrate_colony(sys::state& state, dcon::state_instance_id id);
@@ -76,6 +104,8 @@ float crime_fighting_efficiency(sys::state& state, dcon::province_id id);
 float revolt_risk(sys::state& state, dcon::province_id id);
 
 void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation_id new_owner);
+// adds the state definition to colonizable_states or removes it, depending on whether it still has unowned land
+void update_colonizable_state(sys::state& state, dcon::state_definition_id d);
 void conquer_province(sys::state& state, dcon::province_id id, dcon::nation_id new_owner);
 
 void update_crimes(sys::state& state);
@@ -103,8 +133,28 @@ float direct_distance(sys::state& state, dcon::province_id a, dcon::province_id
 // sorting distance returns values such that a smaller sorting distance between two provinces
 // means that they are closer, but does not translate 1 to 1 to actual distances (i.e. is the negative dot product)
 float sorting_distance(sys::state& state, dcon::province_id a, dcon::province_id b);
+// a lower bound on the length of any path between the two provinces that is never smaller than their direct distance; used
+// as the heuristic when pathfinding
+float path_distance_lower_bound(sys::state& state, dcon::province_id a, dcon::province_id b);
 float state_sorting_distance(sys::state& state, dcon::state_instance_id state_id, dcon::province_id prov_id);
 
+// While a scoped_land_access_cache is alive, has_access_to_province memoizes whether one nation may enter the provinces
+// controlled by another, which is the expensive part of the check and is asked for every province a land path search
+// expands. The cache is only used on the thread that created the scope, and a scope may only span code that cannot
+// change wars, military access, spheres or overlords.
+struct land_access_cache {
+	std::vector<std::vector<uint8_t>> rows; // by nation_as, then by controller: 0 = not known yet, 1 = no access, 2 = access
+	std::vector<int32_t> used_rows;
+	std::thread::id owner;
+	bool enabled = false;
+};
+class scoped_land_access_cache {
+	sys::state& state;
+public:
+	explicit scoped_land_access_cache(sys::state& state);
+	~scoped_land_access_cache();
+};
+
 // determines whether a land unit is allowed to move to / be in a province
 bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov);
 // whether a ship can dock at a land province
@@ -120,6 +170,25 @@ bool has_safe_access_to_province(sys::state& state, dcon::nation_id nation_as, d
 std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a);
 // pathfind through non-enemy controlled, not under siege provinces
 std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+// Paths from many provinces to a single destination, found by one search outwards from the destination instead of one
+// search per starting province. The search stops once every source province has been settled.
+struct land_path_field {
+	std::vector<float> distances;
+	std::vector<dcon::province_id> next; // the next step towards the destination
+	dcon::province_id destination;
+
+	bool reaches(dcon::province_id p) const {
+		return p == destination || bool(next[p.index()]);
+	}
+	// laid out like the result of make_safe_land_path: the destination first and the first step last
+	std::vector<dcon::province_id> path_from(dcon::province_id start) const;
+};
+// the safe land paths (see make_safe_land_path) to the destination
+void make_safe_land_path_field(sys::state& state, land_path_field& field, dcon::province_id destination, dcon::nation_id nation_as, std::vector<dcon::province_id> const& sources);
+// The normal land paths (see make_land_path) to the destination, for all the armies of a nation that are moved there at once.
+// The sea provinces taken are those the given army can embark onto, so the paths are good for any army no larger than it.
+// The costs are those make_land_path uses, but as this search is exact the paths can be shorter than the ones it finds.
+void make_land_path_field(sys::state& state, land_path_field& field, dcon::province_id destination, dcon::nation_id nation_as, dcon::army_id largest, std::vector<dcon::province_id> const& sources);
 // used for rebel unit and black-flagged unit pathfinding
 std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end);
 // naval unit pathfinding; start and end provinces may be land provinces; function assumes you have naval access to both
@@ -30,6 +30,45 @@ inline uint32_t apply_subeffects(EFFECT_PARAMTERS) {
 	return i;
 }
 
+/*
+Scopes that apply their members to many targets may do so in parallel when every member is one of these effects: each
+changes only its own pop or province, reads nothing that another target's copy writes, and draws no random numbers (so
+the random offsets of later effects don't depend on the order in which the targets were visited).
+*/
+constexpr size_t parallel_effect_min_targets = 256;
+
+bool subeffects_are_target_local(uint16_t const* tval) {
+	auto const source_size = 1 + get_effect_scope_payload_size(tval);
+	auto sub_units_start = tval + 2 + effect_scope_data_payload(tval[0]);
+	while(sub_units_start < tval + source_size) {
+		switch(sub_units_start[0] & effect::code_mask) {
+		case effect::militancy:
+		case effect::consciousness:
+		case effect::literacy:
+		case effect::money:
+		case effect::militancy_province:
+		case effect::consciousness_province:
+		case effect::life_rating:
+			break;
+		default:
+			return false;
+		}
+		sub_units_start += 1 + get_generic_effect_payload_size(sub_units_start);
+	}
+	return true;
+}
+
+template<typename T>
+bool apply_subeffects_in_parallel(EFFECT_PARAMTERS, std::vector<T> const& targets) {
+	if(targets.size() < parallel_effect_min_targets || !subeffects_are_target_local(tval))
+		return false;
+	concurrency::parallel_for(0, int32_t(targets.size()), [&](int32_t j) {
+		bool target_els = els; // none of the target-local effects touch it
+		apply_subeffects(tval, ws, trigger::to_generic(targets[j]), this_slot, from_slot, r_hi, r_lo, target_els);
+	});
+	return true;
+}
+
 uint32_t es_generic_scope(EFFECT_PARAMTERS) {
 	return apply_subeffects(tval, ws, primary_slot, this_slot, from_slot, r_hi, r_lo, els);
 }
@@ -784,6 +823,8 @@ uint32_t es_x_pop_scope_nation(EFFECT_PARAMTERS) {
 			}
 		}
 
+		if(apply_subeffects_in_parallel(tval, ws, primary_slot, this_slot, from_slot, r_hi, r_lo, els, plist))
+			return 0;
 		for(auto p : plist)
 			i += apply_subeffects(tval, ws, trigger::to_generic(p), this_slot, from_slot, r_hi, r_lo + i, els);
 		return i;
@@ -834,6 +875,8 @@ uint32_t es_x_pop_scope_state(EFFECT_PARAMTERS) {
 			});
 		}
 
+		if(apply_subeffects_in_parallel(tval, ws, primary_slot, this_slot, from_slot, r_hi, r_lo, els, plist))
+			return 0;
 		for(auto p : plist)
 			i += apply_subeffects(tval, ws, trigger::to_generic(p), this_slot, from_slot, r_hi, r_lo + i, els);
 		return i;
@@ -878,6 +921,8 @@ uint32_t es_x_pop_scope_province(EFFECT_PARAMTERS) {
 			}
 		}
 
+		if(apply_subeffects_in_parallel(tval, ws, primary_slot, this_slot, from_slot, r_hi, r_lo, els, plist))
+			return 0;
 		for(auto p : plist)
 			i += apply_subeffects(tval, ws, trigger::to_generic(p), this_slot, from_slot, r_hi, r_lo + i, els);
 		return i;
@@ -921,6 +966,8 @@ uint32_t es_x_owned_scope_nation(EFFECT_PARAMTERS) {
 			}
 		}
 
+		if(apply_subeffects_in_parallel(tval, ws, primary_slot, this_slot, from_slot, r_hi, r_lo, els, plist))
+			return 0;
 		uint32_t i = 0;
 		for(auto p : plist) {
 			i += apply_subeffects(tval, ws, trigger::to_generic(p), this_slot, from_slot, r_hi, r_lo + i, els);
@@ -3014,7 +3061,7 @@ uint32_t ef_social_reform(EFFECT_PARAMTERS) {
 	auto opt = trigger::payload(tval[1]).opt_id;
 	politics::set_issue_option(ws, trigger::to_nation(primary_slot), opt);
 	culture::update_nation_issue_rules(ws, trigger::to_nation(primary_slot));
-	sys::update_single_nation_modifiers(ws, trigger::to_nation(primary_slot));
+	sys::update_nation_modifiers_soon(ws, trigger::to_nation(primary_slot));
 	return 0;
 }
 uint32_t ef_social_reform_province(EFFECT_PARAMTERS) {
@@ -3023,7 +3070,7 @@ uint32_t ef_social_reform_province(EFFECT_PARAMTERS) {
 	if(owner) {
 		politics::set_issue_option(ws, owner, opt);
 		culture::update_nation_issue_rules(ws, owner);
-		sys::update_single_nation_modifiers(ws, owner);
+		sys::update_nation_modifiers_soon(ws, owner);
 	}
 	return 0;
 }
@@ -3031,7 +3078,7 @@ uint32_t ef_political_reform(EFFECT_PARAMTERS) {
 	auto opt = trigger::payload(tval[1]).opt_id;
 	politics::set_issue_option(ws, trigger::to_nation(primary_slot), opt);
 	culture::update_nation_issue_rules(ws, trigger::to_nation(primary_slot));
-	sys::update_single_nation_modifiers(ws, trigger::to_nation(primary_slot));
+	sys::update_nation_modifiers_soon(ws, trigger::to_nation(primary_slot));
 	return 0;
 }
 uint32_t ef_political_reform_province(EFFECT_PARAMTERS) {
@@ -3040,7 +3087,7 @@ uint32_t ef_political_reform_province(EFFECT_PARAMTERS) {
 	if(owner) {
 		politics::set_issue_option(ws, owner, opt);
 		culture::update_nation_issue_rules(ws, owner);
-		sys::update_single_nation_modifiers(ws, owner);
+		sys::update_nation_modifiers_soon(ws, owner);
 	}
 	return 0;
 }
@@ -3143,14 +3190,14 @@ uint32_t ef_military_reform(EFFECT_PARAMTERS) {
 	auto opt = trigger::payload(tval[1]).ropt_id;
 	politics::set_reform_option(ws, trigger::to_nation(primary_slot), opt);
 	culture::update_nation_issue_rules(ws, trigger::to_nation(primary_slot));
-	sys::update_single_nation_modifiers(ws, trigger::to_nation(primary_slot));
+	sys::update_nation_modifiers_soon(ws, trigger::to_nation(primary_slot));
 	return 0;
 }
 uint32_t ef_economic_reform(EFFECT_PARAMTERS) {
 	auto opt = trigger::payload(tval[1]).ropt_id;
 	politics::set_reform_option(ws, trigger::to_nation(primary_slot), opt);
 	culture::update_nation_issue_rules(ws, trigger::to_nation(primary_slot));
-	sys::update_single_nation_modifiers(ws, trigger::to_nation(primary_slot));
+	sys::update_nation_modifiers_soon(ws, trigger::to_nation(primary_slot));
 	return 0;
 }
 uint32_t ef_remove_random_military_reforms(EFFECT_PARAMTERS) {
@@ -3168,7 +3215,7 @@ uint32_t ef_remove_random_military_reforms(EFFECT_PARAMTERS) {
 		active_reforms.pop_back();
 	}
 	culture::update_nation_issue_rules(ws, nation_id);
-	sys::update_single_nation_modifiers(ws, nation_id);
+	sys::update_nation_modifiers_soon(ws, nation_id);
 	return tval[1];
 }
 uint32_t ef_remove_random_economic_reforms(EFFECT_PARAMTERS) {
@@ -3186,7 +3233,7 @@ uint32_t ef_remove_random_economic_reforms(EFFECT_PARAMTERS) {
 		active_reforms.pop_back();
 	}
 	culture::update_nation_issue_rules(ws, nation_id);
-	sys::update_single_nation_modifiers(ws, nation_id);
+	sys::update_nation_modifiers_soon(ws, nation_id);
 	return tval[1];
 }
 uint32_t ef_add_crime(EFFECT_PARAMTERS) {
@@ -4191,23 +4238,23 @@ uint32_t ef_country_event_this_nation(EFFECT_PARAMTERS) {
 	auto name = text::produce_simple_string(ws, dcon::fatten(ws.world, trigger::payload(tval[1]).nev_id).get_name());
 	auto nationtag = text::produce_simple_string(ws, dcon::fatten(ws.world, trigger::to_nation(primary_slot)).get_identity_from_identity_holder().get_name());
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), future_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::nation});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::nation});
 	return 0;
 }
 uint32_t ef_country_event_immediate_this_nation(EFFECT_PARAMTERS) {
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), ws.current_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::nation});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::nation});
 	return 0;
 }
 uint32_t ef_province_event_this_nation(EFFECT_PARAMTERS) {
 	auto postpone = int32_t(tval[2]);
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::nation});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::nation});
 	return 0;
 }
 uint32_t ef_province_event_immediate_this_nation(EFFECT_PARAMTERS) {
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::nation});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::nation});
 	return 0;
 }
 uint32_t ef_country_event_this_state(EFFECT_PARAMTERS) {
@@ -4215,23 +4262,23 @@ uint32_t ef_country_event_this_state(EFFECT_PARAMTERS) {
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), future_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::state});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::state});
 	return 0;
 }
 uint32_t ef_country_event_immediate_this_state(EFFECT_PARAMTERS) {
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), ws.current_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::state});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::state});
 	return 0;
 }
 uint32_t ef_province_event_this_state(EFFECT_PARAMTERS) {
 	auto postpone = int32_t(tval[2]);
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::state});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::state});
 	return 0;
 }
 uint32_t ef_province_event_immediate_this_state(EFFECT_PARAMTERS) {
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::state});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::state});
 	return 0;
 }
 uint32_t ef_country_event_this_province(EFFECT_PARAMTERS) {
@@ -4239,23 +4286,23 @@ uint32_t ef_country_event_this_province(EFFECT_PARAMTERS) {
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), future_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::province});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::province});
 	return 0;
 }
 uint32_t ef_country_event_immediate_this_province(EFFECT_PARAMTERS) {
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), ws.current_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::province});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::province});
 	return 0;
 }
 uint32_t ef_province_event_this_province(EFFECT_PARAMTERS) {
 	auto postpone = int32_t(tval[2]);
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::province});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::province});
 	return 0;
 }
 uint32_t ef_province_event_immediate_this_province(EFFECT_PARAMTERS) {
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::province});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::province});
 	return 0;
 }
 uint32_t ef_country_event_this_pop(EFFECT_PARAMTERS) {
@@ -4263,23 +4310,23 @@ uint32_t ef_country_event_this_pop(EFFECT_PARAMTERS) {
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), future_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::pop});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, future_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::pop});
 	return 0;
 }
 uint32_t ef_country_event_immediate_this_pop(EFFECT_PARAMTERS) {
 	if(!event::would_be_duplicate_instance(ws, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), ws.current_date))
-		ws.future_n_event.push_back(event::pending_human_n_event {r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::pop});
+		event::add_future_event(ws, event::pending_human_n_event{r_lo + 1, r_hi, primary_slot, this_slot, ws.current_date, trigger::payload(tval[1]).nev_id, trigger::to_nation(primary_slot), event::slot_type::nation, event::slot_type::pop});
 	return 0;
 }
 uint32_t ef_province_event_this_pop(EFFECT_PARAMTERS) {
 	auto postpone = int32_t(tval[2]);
 	assert(postpone > 0);
 	auto future_date = ws.current_date + postpone;
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::pop});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, future_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::pop});
 	return 0;
 }
 uint32_t ef_province_event_immediate_this_pop(EFFECT_PARAMTERS) {
-	ws.future_p_event.push_back(event::pending_human_p_event {r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::pop});
+	event::add_future_event(ws, event::pending_human_p_event{r_lo + 1, r_hi, this_slot, ws.current_date, trigger::payload(tval[1]).pev_id, trigger::to_prov(primary_slot), event::slot_type::pop});
 	return 0;
 }
 uint32_t ef_country_event_province_this_nation(EFFECT_PARAMTERS) {
@@ -5403,12 +5450,15 @@ uint32_t internal_execute_effect(EFFECT_PARAMTERS) {
 
 void execute(sys::state& state, dcon::effect_key key, int32_t primary, int32_t this_slot, int32_t from_slot, uint32_t r_lo,
 		uint32_t r_hi) {
+	sys::scoped_script_timer timer{ state.script_timings, int32_t(key.index()), true };
+	sys::scoped_deferred_nation_modifiers deferred_modifiers{ state };
 	bool els = false;
 	internal_execute_effect(state.effect_data.data() + state.effect_data_indices[key.index() + 1], state, primary, this_slot, from_slot, r_lo, r_hi, els);
 }
 
 void execute(sys::state& state, uint16_t const* data, int32_t primary, int32_t this_slot, int32_t from_slot, uint32_t r_lo,
 		uint32_t r_hi) {
+	sys::scoped_deferred_nation_modifiers deferred_modifiers{ state };
 	bool els = false;
 	internal_execute_effect(data, state, primary, this_slot, from_slot, r_lo, r_hi, els);
 }
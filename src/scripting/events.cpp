@@ -470,7 +470,34 @@ bool would_be_duplicate_instance(sys::state& state, dcon::national_event_id e, d
 	return false;
 }
 
+void add_future_event(sys::state& state, pending_human_n_event const& e) {
+	state.future_n_event.push_back(e);
+	if(!state.next_future_event || e.date < state.next_future_event)
+		state.next_future_event = e.date;
+}
+void add_future_event(sys::state& state, pending_human_p_event const& e) {
+	state.future_p_event.push_back(e);
+	if(!state.next_future_event || e.date < state.next_future_event)
+		state.next_future_event = e.date;
+}
+
+void update_next_future_event(sys::state& state) {
+	state.next_future_event = sys::date{};
+	for(auto const& e : state.future_n_event) {
+		if(!state.next_future_event || e.date < state.next_future_event)
+			state.next_future_event = e.date;
+	}
+	for(auto const& e : state.future_p_event) {
+		if(!state.next_future_event || e.date < state.next_future_event)
+			state.next_future_event = e.date;
+	}
+}
+
 void update_future_events(sys::state& state) {
+	// nothing is due yet, so there is no need to look through the pending events
+	if(!state.next_future_event || state.current_date < state.next_future_event)
+		return;
+
 	for(uint32_t i = 0; i < uint32_t(state.defines.alice_max_event_iterations); i++) {
 		bool fired_n = false;
 		uint32_t n_n_events = uint32_t(state.future_n_event.size());
@@ -512,6 +539,34 @@ void update_future_events(sys::state& state) {
 		if(!fired_p && !fired_n)
 			break;
 	}
+	update_next_future_event(state);
+}
+
+// The first year in which the trigger could be satisfied, judging only by `year` conditions that must hold for it to be:
+// either the trigger itself or members of its outermost and. Returns the minimum int32_t when there is no such bound.
+int32_t earliest_trigger_year(uint16_t const* data) {
+	auto const code = data[0] & trigger::code_mask;
+	if(code == trigger::year) {
+		switch(data[0] & trigger::association_mask) {
+		case trigger::association_eq:
+		case trigger::association_ge:
+			return int32_t(data[1]);
+		case trigger::association_gt:
+			return int32_t(data[1]) + 1;
+		default:
+			return std::numeric_limits<int32_t>::min();
+		}
+	}
+	if(data[0] == trigger::generic_scope) {
+		int32_t result = std::numeric_limits<int32_t>::min();
+		auto sub_units_start = data + 2;
+		while(sub_units_start < data + 2 + trigger::get_trigger_scope_payload_size(data)) {
+			result = std::max(result, earliest_trigger_year(sub_units_start));
+			sub_units_start += 1 + trigger::get_trigger_payload_size(sub_units_start);
+		}
+		return result;
+	}
+	return std::numeric_limits<int32_t>::min();
 }
 
 void update_events(sys::state& state) {
@@ -522,22 +577,69 @@ void update_events(sys::state& state) {
 
 	concurrency::combinable<std::vector<event_nation_pair>> events_triggered;
 
+	/*
+	An event that can't fire before some later year is not polled until then: its trigger would be false for every nation
+	or province, and since each random value is keyed by the event and target, skipping the poll changes no other outcome.
+	*/
+	auto const current_year = state.current_date.to_ymd(state.start_date).year;
+	auto too_early = [&](dcon::trigger_key t) {
+		return t && current_year < earliest_trigger_year(state.trigger_data.data() + state.trigger_data_indices[t.index() + 1]);
+	};
+
 	auto n_block_end = block_index == 31 ? state.world.free_national_event_size() : n_block_size * (block_index + 1);
 	concurrency::parallel_for(n_block_size * block_index, n_block_end, [&](uint32_t i) {
 		dcon::free_national_event_id id{dcon::national_event_id::value_base_t(i)};
 		auto mod = state.world.free_national_event_get_mtth(id);
 		auto t = state.world.free_national_event_get_trigger(id);
+		auto t_fn = state.world.free_national_event_get_trigger_fn(id);
+		auto mod_fn = state.world.free_national_event_get_mtth_fn(id);
+
+		if(too_early(t))
+			return;
 
 		if(state.world.free_national_event_get_only_once(id) == false || state.world.free_national_event_get_has_been_triggered(id) == false) {
+			if((!t || t_fn) && (!mod || mod_fn)) {
+				// the same calculation as below, one nation at a time through the compiled trigger and mtth
+				using ftype = float(*)(int32_t);
+				for(auto n : state.world.in_nation) {
+					if(n.get_owned_province_count() == 0)
+						continue;
+					if(t) {
+						float llvm_result = ((ftype)t_fn)(n.id.index());
+#ifdef CHECK_LLVM_RESULTS
+						assert((llvm_result != 0.0f) == trigger::evaluate(state, t, trigger::to_generic(n.id), trigger::to_generic(n.id), 0));
+#endif
+						if(llvm_result == 0.0f)
+							continue;
+					}
+					float chances = 1.0f;
+					if(mod) {
+						chances = ((ftype)mod_fn)(n.id.index());
+#ifdef CHECK_LLVM_RESULTS
+						assert(chances == trigger::evaluate_multiplicative_modifier(state, mod, trigger::to_generic(n.id), trigger::to_generic(n.id), 0));
+#endif
+					}
+					auto adj_chance = 1.0f - (chances <= 1.0f ? 1.0f : 1.0f / chances);
+					auto adj_chance_2 = adj_chance * adj_chance;
+					auto adj_chance_4 = adj_chance_2 * adj_chance_2;
+					auto adj_chance_8 = adj_chance_4 * adj_chance_4;
+					auto adj_chance_16 = adj_chance_8 * adj_chance_8;
+					if(float(rng::get_random(state, uint32_t((i << 1) ^ n.id.index())) & 0xFFFFFF) / float(0xFFFFFF + 1) >= adj_chance_16) {
+						events_triggered.local().push_back(event_nation_pair{ n.id, id });
+					}
+				}
+				return;
+			}
 			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
 				/*
 				For national events: the base factor (scaled to days) is multiplied with all modifiers that hold. If the value is
 				non positive, we take the probability of the event occurring as 0.000001. If the value is less than 0.001, the
 				event is guaranteed to happen. Otherwise, the probability is the multiplicative inverse of the value.
 				*/
-				auto some_exist = t
-					? (state.world.nation_get_owned_province_count(ids) != 0) && trigger::evaluate(state, t, trigger::to_generic(ids), trigger::to_generic(ids), 0)
-					: (state.world.nation_get_owned_province_count(ids) != 0);
+				auto some_exist = state.world.nation_get_owned_province_count(ids) != 0;
+				// a block of nations that no longer exist doesn't need the trigger evaluated at all
+				if(t && ve::compress_mask(some_exist).v != 0)
+					some_exist = some_exist && trigger::evaluate(state, t, trigger::to_generic(ids), trigger::to_generic(ids), 0);
 				if(ve::compress_mask(some_exist).v != 0) {
 					auto chances = mod ?
 						trigger::evaluate_multiplicative_modifier(state, mod, trigger::to_generic(ids), trigger::to_generic(ids), 0) : ve::fp_vector{ 1.0f };
@@ -582,8 +684,46 @@ void update_events(sys::state& state) {
 		dcon::free_provincial_event_id id{dcon::free_provincial_event_id::value_base_t(i)};
 		auto mod = state.world.free_provincial_event_get_mtth(id);
 		auto t = state.world.free_provincial_event_get_trigger(id);
+		auto t_fn = state.world.free_provincial_event_get_trigger_fn(id);
+		auto mod_fn = state.world.free_provincial_event_get_mtth_fn(id);
+
+		if(too_early(t))
+			return;
 
 		if(state.world.free_provincial_event_get_only_once(id) == false || state.world.free_provincial_event_get_has_been_triggered(id) == false) {
+			if((!t || t_fn) && (!mod || mod_fn)) {
+				// the same calculation as below, one province at a time through the compiled trigger and mtth
+				using ftype = float(*)(int32_t);
+				for(int32_t j = 0; j < state.province_definitions.first_sea_province.index(); ++j) {
+					dcon::province_id p{ dcon::province_id::value_base_t(j) };
+					if(!state.world.province_get_nation_from_province_ownership(p))
+						continue;
+					if(t) {
+						float llvm_result = ((ftype)t_fn)(p.index());
+#ifdef CHECK_LLVM_RESULTS
+						assert((llvm_result != 0.0f) == trigger::evaluate(state, t, trigger::to_generic(p), trigger::to_generic(p), 0));
+#endif
+						if(llvm_result == 0.0f)
+							continue;
+					}
+					float chances = 2.0f;
+					if(mod) {
+						chances = ((ftype)mod_fn)(p.index());
+#ifdef CHECK_LLVM_RESULTS
+						assert(chances == trigger::evaluate_multiplicative_modifier(state, mod, trigger::to_generic(p), trigger::to_generic(p), 0));
+#endif
+					}
+					auto adj_chance = 1.0f - (chances <= 2.0f ? 1.0f : 2.0f / chances);
+					auto adj_chance_2 = adj_chance * adj_chance;
+					auto adj_chance_4 = adj_chance_2 * adj_chance_2;
+					auto adj_chance_8 = adj_chance_4 * adj_chance_4;
+					auto adj_chance_16 = adj_chance_8 * adj_chance_8;
+					if(float(rng::get_random(state, uint32_t((i << 1) ^ p.index())) & 0xFFFFFF) / float(0xFFFFFF + 1) >= adj_chance_16) {
+						p_events_triggered.local().push_back(event_prov_pair{ p, id });
+					}
+				}
+				return;
+			}
 			ve::execute_serial_fast<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
 					[&](ve::contiguous_tags<dcon::province_id> ids) {
 						/*
@@ -591,9 +731,10 @@ void update_events(sys::state& state) {
 						happen.
 						*/
 						auto owners = state.world.province_get_nation_from_province_ownership(ids);
-						auto some_exist = t ? (owners != dcon::nation_id{}) &&
-							trigger::evaluate(state, t, trigger::to_generic(ids), trigger::to_generic(ids), 0)
-							: (owners != dcon::nation_id{});
+						auto some_exist = owners != dcon::nation_id{};
+						// likewise for a block of provinces that are all unowned
+						if(t && ve::compress_mask(some_exist).v != 0)
+							some_exist = some_exist && trigger::evaluate(state, t, trigger::to_generic(ids), trigger::to_generic(ids), 0);
 						if(ve::compress_mask(some_exist).v != 0) {
 							auto chances = mod
 								? trigger::evaluate_multiplicative_modifier(state, mod, trigger::to_generic(ids), trigger::to_generic(ids), 0)
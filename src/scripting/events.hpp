@@ -103,6 +103,10 @@ void take_option(sys::state& state, pending_human_p_event const& e, uint8_t opt)
 void take_option(sys::state& state, pending_human_f_p_event const& e, uint8_t opt);
 
 bool would_be_duplicate_instance(sys::state& state, dcon::national_event_id e, dcon::nation_id n, sys::date date);
+// all future events must be added through these, so that update_future_events knows when the next one is due
+void add_future_event(sys::state& state, pending_human_n_event const& e);
+void add_future_event(sys::state& state, pending_human_p_event const& e);
+void update_next_future_event(sys::state& state);
 void update_future_events(sys::state& state);
 void update_events(sys::state& state);
 
@@ -5218,18 +5218,37 @@ inline void add_import(std::string_view name, void* ptr, fif_call interpreter_im
 }
 
 #ifdef USE_LLVM
-inline void perform_jit(environment& e) {
+// When cached_object is not empty, it is linked in place of the module built up in e, which is then discarded without being
+// optimized or compiled. It must have been produced by an earlier call, for the same definitions, that passed emitted_object:
+// such a call optimizes and compiles the module ahead of time and copies the resulting object code into emitted_object.
+inline void perform_jit(environment& e, std::string_view cached_object = std::string_view{}, std::string* emitted_object = nullptr) {
 	//add_exportable_functions_to_globals(e);
 
-	char* out_message = nullptr;
-	auto result = LLVMVerifyModule(e.llvm_module, LLVMVerifierFailureAction::LLVMPrintMessageAction, &out_message);
-	if(result) {
-		e.report_error(out_message);
-		return;
+	LLVMMemoryBufferRef object_buffer = nullptr;
+	if(!cached_object.empty()) {
+		object_buffer = LLVMCreateMemoryBufferWithMemoryRangeCopy(cached_object.data(), cached_object.size(), "cached_module_main");
+	} else {
+		char* out_message = nullptr;
+		auto result = LLVMVerifyModule(e.llvm_module, LLVMVerifierFailureAction::LLVMPrintMessageAction, &out_message);
+		if(result) {
+			e.report_error(out_message);
+			return;
+		}
+		if(out_message)
+			LLVMDisposeMessage(out_message);
+
+		if(emitted_object) {
+			module_transform(nullptr, e.llvm_module);
+			char* emit_message = nullptr;
+			if(LLVMTargetMachineEmitToMemoryBuffer(e.llvm_target_machine, e.llvm_module, LLVMObjectFile, &emit_message, &object_buffer)) {
+				e.report_error(emit_message);
+				LLVMDisposeMessage(emit_message);
+				return;
+			}
+			emitted_object->assign(LLVMGetBufferStart(object_buffer), LLVMGetBufferSize(object_buffer));
+		}
 	}
-	if(out_message)
-		LLVMDisposeMessage(out_message);
-	
+
 	LLVMDisposeBuilder(e.llvm_builder);
 	e.llvm_builder = nullptr;
 
@@ -5290,7 +5309,13 @@ inline void perform_jit(environment& e) {
 		}
 	}
 
-	auto error = LLVMOrcLLJITAddLLVMIRModule(e.llvm_jit, main_dyn_lib, orc_mod);
+	LLVMErrorRef error = nullptr;
+	if(object_buffer) { // takes ownership of the buffer
+		LLVMOrcDisposeThreadSafeModule(orc_mod);
+		error = LLVMOrcLLJITAddObjectFile(e.llvm_jit, main_dyn_lib, object_buffer);
+	} else {
+		error = LLVMOrcLLJITAddLLVMIRModule(e.llvm_jit, main_dyn_lib, orc_mod);
+	}
 	if(error) {
 		auto msg = LLVMGetErrorMessage(error);
 		e.report_error(msg);
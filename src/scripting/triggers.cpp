@@ -1,3 +1,4 @@
+#include <atomic>
 #include "triggers.hpp"
 #include "system_state.hpp"
 #include "demographics.hpp"
@@ -8,6 +9,7 @@
 #include "ve_scalar_extensions.hpp"
 #include "script_constants.hpp"
 #include "politics.hpp"
+#include "unordered_dense.h"
 
 namespace trigger {
 
@@ -116,34 +118,6 @@ template<typename A>
 		return !value_a;
 	}
 }
-float read_float_from_payload(uint16_t const* data) {
-	union {
-		struct {
-			uint16_t low;
-			uint16_t high;
-		} v;
-		float f;
-	} pack_float;
-
-	pack_float.v.low = data[0];
-	pack_float.v.high = data[1];
-
-	return pack_float.f;
-}
-int32_t read_int32_t_from_payload(uint16_t const* data) {
-	union {
-		struct {
-			uint16_t low;
-			uint16_t high;
-		} v;
-		int32_t f;
-	} pack_float;
-
-	pack_float.v.low = data[0];
-	pack_float.v.high = data[1];
-
-	return pack_float.f;
-}
 
 template<typename T>
 struct gathered_s {
@@ -5634,8 +5608,12 @@ TRIGGER_FUNCTION(tf_invention_pop) {
 TRIGGER_FUNCTION(tf_test) {
 	auto sid = trigger::payload(tval[1]).str_id;
 	auto tid = ws.world.stored_trigger_get_function(sid);
-	auto test_result = test_trigger_generic<return_type>(ws.trigger_data.data() + ws.trigger_data_indices[tid.index() + 1], ws, primary_slot, this_slot, from_slot);
-	return compare_to_true(tval[0], test_result);
+	if constexpr(std::is_same_v<return_type, bool>) { // goes through the memo, if there is one
+		return compare_to_true(tval[0], evaluate(ws, tid, primary_slot, this_slot, from_slot));
+	} else {
+		auto test_result = test_trigger_generic<return_type>(ws.trigger_data.data() + ws.trigger_data_indices[tid.index() + 1], ws, primary_slot, this_slot, from_slot);
+		return compare_to_true(tval[0], test_result);
+	}
 }
 
 TRIGGER_FUNCTION(tf_has_building_bank) {
@@ -5793,6 +5771,28 @@ float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_k
 	}
 	return product;
 }
+void evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, std::span<int32_t const> primary, int32_t this_slot, int32_t from_slot, std::span<float> out) {
+	assert(out.size() >= primary.size());
+	auto base = state.value_modifiers[modifier];
+	for(size_t j = 0; j < primary.size(); ++j)
+		out[j] = base.factor;
+	/*
+	The segments are walked once for the whole batch rather than once per primary slot. Each result is still multiplied by
+	the factors of its passing segments in segment order, and a result that has reached zero stops testing conditions, just
+	as in the scalar version.
+	*/
+	for(uint32_t i = 0; i < base.segments_count; ++i) {
+		auto seg = state.value_modifier_segments[base.first_segment_offset + i];
+		if(!seg.condition)
+			continue;
+		auto condition = state.trigger_data.data() + state.trigger_data_indices[seg.condition.index() + 1];
+		for(size_t j = 0; j < primary.size(); ++j) {
+			if(out[j] != 0 && test_trigger_generic<bool>(condition, state, primary[j], this_slot, from_slot)) {
+				out[j] *= seg.factor;
+			}
+		}
+	}
+}
 float evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot) {
 	auto base = state.value_modifiers[modifier];
 	float sum = base.base;
@@ -5862,9 +5862,65 @@ ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier
 	return sum * base.factor;
 }
 
+namespace {
+
+struct memo_key {
+	int32_t trigger = 0;
+	int32_t primary = 0;
+	int32_t this_slot = 0;
+	int32_t from_slot = 0;
+
+	bool operator==(memo_key const& o) const noexcept = default;
+};
+struct memo_key_hash {
+	using is_avalanching = void;
+	uint64_t operator()(memo_key const& k) const noexcept {
+		return ankerl::unordered_dense::detail::wyhash::hash(&k, sizeof(k));
+	}
+};
+struct thread_memo {
+	uint32_t generation = 0;
+	ankerl::unordered_dense::map<memo_key, bool, memo_key_hash> results;
+};
+
+// 0 while no memo exists; each memo gets a new value, so that a thread can tell its remembered results are stale
+std::atomic<uint32_t> active_memo_generation = 0;
+uint32_t last_memo_generation = 0;
+thread_local thread_memo local_memo;
+
+}
+
+scoped_evaluation_memo::scoped_evaluation_memo() {
+	assert(active_memo_generation.load(std::memory_order_relaxed) == 0);
+	++last_memo_generation;
+	if(last_memo_generation == 0)
+		++last_memo_generation;
+	active_memo_generation.store(last_memo_generation, std::memory_order_release);
+}
+scoped_evaluation_memo::~scoped_evaluation_memo() {
+	active_memo_generation.store(0, std::memory_order_release);
+}
+
 bool evaluate(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot) {
-	return test_trigger_generic<bool>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state, primary,
+	sys::scoped_script_timer timer{ state.script_timings, int32_t(key.index()), false };
+	auto generation = active_memo_generation.load(std::memory_order_acquire);
+	if(generation == 0) {
+		return test_trigger_generic<bool>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state, primary,
+				this_slot, from_slot);
+	}
+
+	if(local_memo.generation != generation) {
+		local_memo.results.clear();
+		local_memo.generation = generation;
+	}
+	memo_key k{ int32_t(key.index()), primary, this_slot, from_slot };
+	if(auto it = local_memo.results.find(k); it != local_memo.results.end())
+		return it->second;
+	// evaluating may itself add to the memo (through `test`), so no iterator is held across it
+	auto result = test_trigger_generic<bool>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state, primary,
 			this_slot, from_slot);
+	local_memo.results.insert_or_assign(k, result);
+	return result;
 }
 bool evaluate(sys::state& state, uint16_t const* data, int32_t primary, int32_t this_slot, int32_t from_slot) {
 	return test_trigger_generic<bool>(data, state, primary, this_slot, from_slot);
@@ -5872,6 +5928,7 @@ bool evaluate(sys::state& state, uint16_t const* data, int32_t primary, int32_t
 
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguous_tags<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	sys::scoped_script_timer timer{ state.script_timings, int32_t(key.index()), false };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
@@ -5882,6 +5939,7 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous
 
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::tagged_vector<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	sys::scoped_script_timer timer{ state.script_timings, int32_t(key.index()), false };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
@@ -5892,6 +5950,7 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::tagged_vec
 
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguous_tags<int32_t> primary,
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot) {
+	sys::scoped_script_timer timer{ state.script_timings, int32_t(key.index()), false };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
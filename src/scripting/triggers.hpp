@@ -1,13 +1,41 @@
 #pragma once
 
+#include <span>
 #include "script_constants.hpp"
 #include "dcon_generated.hpp"
 #include "container_types.hpp"
 
 namespace trigger {
 
-float read_float_from_payload(uint16_t const* data);
-int32_t read_int32_t_from_payload(uint16_t const* data);
+// inline, since the interpreters (and the tooltips) decode an operand this way for most numeric comparisons
+inline float read_float_from_payload(uint16_t const* data) {
+	union {
+		struct {
+			uint16_t low;
+			uint16_t high;
+		} v;
+		float f;
+	} pack_float;
+
+	pack_float.v.low = data[0];
+	pack_float.v.high = data[1];
+
+	return pack_float.f;
+}
+inline int32_t read_int32_t_from_payload(uint16_t const* data) {
+	union {
+		struct {
+			uint16_t low;
+			uint16_t high;
+		} v;
+		int32_t f;
+	} pack_float;
+
+	pack_float.v.low = data[0];
+	pack_float.v.high = data[1];
+
+	return pack_float.f;
+}
 
 inline int32_t to_generic(dcon::province_id v) {
 	return v.index();
@@ -168,6 +196,9 @@ inline ve::partial_contiguous_tags<dcon::rebel_faction_id> to_rebel(ve::partial_
 float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
 ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+// evaluates the modifier once for each of the primary slots, all sharing the same this and from slots, writing the
+// results to out (which must be as long as primary); gives the same values as calling the scalar version once per primary
+void evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, std::span<int32_t const> primary, int32_t this_slot, int32_t from_slot, std::span<float> out);
 
 ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 float evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
@@ -177,6 +208,18 @@ ve::fp_vector evaluate_purely_additive_modifier(sys::state& state, dcon::value_m
 float evaluate_purely_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
 ve::fp_vector evaluate_purely_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
 
+// While one of these exists, the results of scalar evaluations of whole triggers by key (including the scripted triggers
+// reached through `test`) are remembered per (trigger, primary, this, from), separately on each thread that evaluates them.
+// Only create one, on the game thread, around a pass that does not change the game state; nothing is remembered past its
+// destruction, and they cannot be nested.
+class scoped_evaluation_memo {
+public:
+	scoped_evaluation_memo();
+	~scoped_evaluation_memo();
+	scoped_evaluation_memo(scoped_evaluation_memo const&) = delete;
+	scoped_evaluation_memo& operator=(scoped_evaluation_memo const&) = delete;
+};
+
 bool evaluate(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot);
 bool evaluate(sys::state& state, uint16_t const* data, int32_t primary, int32_t this_slot, int32_t from_slot);
 
@@ -31,26 +31,41 @@ void sound_impl::set_volume(std::optional<ma_sound>& sound, float volume) {
 	}
 }
 
-void sound_impl::override_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume) {
+void sound_impl::override_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume, ma_uint32 flags) {
 	if(sound.has_value()) {
 		ma_sound_uninit(&*sound);
 	}
 
 	sound.reset();
 	sound.emplace();
-	ma_result result = ma_sound_init_from_file(&engine, s.filename.c_str(), 0, NULL, NULL, &*sound);
+	ma_result result = ma_sound_init_from_file(&engine, s.filename.c_str(), flags, NULL, NULL, &*sound);
 	if(result == MA_SUCCESS) {
 		set_volume(sound, volume);
 		ma_sound_start(&*sound);
 	}
 }
 
+void sound_impl::play_decoded_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume) {
+	/*
+	A sound's data is normally released with the last ma_sound playing it, which for the effects (one at a time, each replacing
+	the last) meant reading and decoding the file again on every play. A file registered with the resource manager stays
+	in memory, already decoded, until the engine is shut down, and every sound initialized from it afterwards shares that.
+	*/
+	if(!s.decoded) {
+		ma_resource_manager_register_file(ma_engine_get_resource_manager(&engine), s.filename.c_str(), MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE);
+		s.decoded = true;
+	}
+	override_sound(sound, s, volume, MA_SOUND_FLAG_DECODE);
+}
+
 void sound_impl::play_music(int32_t track, float volume) {
 	current_music = track;
 
 	audio_instance audio{};
 	audio.filename = music_list[track].filename.c_str();
-	override_sound(music, audio, volume);
+	// the tracks are long: rather than holding a whole one in memory, it is decoded bit by bit on the resource manager's
+	// thread, which also opens it, so that changing tracks does not hold up the frame
+	override_sound(music, audio, volume, MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC);
 }
 
 void sound_impl::play_new_track(sys::state& ws) {
@@ -198,12 +213,12 @@ void change_music_volume(sys::state& state, float v) {
 void play_effect(sys::state& state, audio_instance& s, float volume) {
 	if(state.sound_ptr->global_pause)
 		return;
-	state.sound_ptr->override_sound(state.sound_ptr->effect_sound, s, volume);
+	state.sound_ptr->play_decoded_sound(state.sound_ptr->effect_sound, s, volume);
 }
 void play_interface_sound(sys::state& state, audio_instance& s, float volume) {
 	if(state.sound_ptr->global_pause)
 		return;
-	state.sound_ptr->override_sound(state.sound_ptr->interface_sound, s, volume);
+	state.sound_ptr->play_decoded_sound(state.sound_ptr->interface_sound, s, volume);
 }
 
 void stop_music(sys::state& state) {
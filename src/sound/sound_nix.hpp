@@ -8,6 +8,7 @@ namespace sound {
 class audio_instance {
 public:
 	native_string filename;
+	bool decoded = false; // registered with the resource manager, which keeps the decoded samples from then on
 
 	audio_instance() = default;
 	audio_instance& operator=(audio_instance const& o) {
@@ -17,6 +18,7 @@ public:
 	~audio_instance() { }
 	void set_file(native_string_view name) {
 		filename = native_string(name);
+		decoded = false;
 	}
 };
 
@@ -85,7 +87,10 @@ public:
 	sound_impl();
 	~sound_impl();
 	void set_volume(std::optional<ma_sound>& sound, float volume);
-	void override_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume);
+	// starts s in place of whatever sound was playing; flags are the MA_SOUND_FLAG_ ones
+	void override_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume, ma_uint32 flags);
+	// starts s, decoding it the first time it is played; the samples are kept for every later play
+	void play_decoded_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume);
 	void play_music(int32_t track, float volume);
 	void play_new_track(sys::state& ws);
 	void play_next_track(sys::state& ws);
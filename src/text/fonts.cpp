@@ -1,5 +1,6 @@
 #include <cmath>
 #include <bit>
+#include <cstring>
 
 #include "hb.h"
 #include "hb-ft.h"
@@ -8,6 +9,7 @@
 #include "parsers.hpp"
 #include "simple_fs.hpp"
 #include "system_state.hpp"
+#include "blake2.h"
 #ifdef _WIN32
 #include <icu.h>
 #else
@@ -280,6 +282,8 @@ void dead_reckoning(float distance_map[dr_size * dr_size], bool const in_map[dr_
 
 void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 	current_locale = l;
+	for(auto& fnt : font_array)
+		fnt.clear_shaping_cache();
 
 	uint32_t end_language = 0;
 	auto locale_name = state.world.locale_get_locale_name(l);
@@ -320,6 +324,7 @@ void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 			font_array.emplace_back();
 			auto content = simple_fs::view_contents(*ff);
 			load_font(font_array.back(), content.data, content.file_size);
+			attach_glyph_cache(font_array.back(), content.data, content.file_size);
 			font_array.back().only_raw_codepoints = state.user_settings.use_classic_fonts;
 			font_array.back().file_name = fname;
 			resolved = &(font_array.back());
@@ -353,6 +358,7 @@ void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 			font_array.emplace_back();
 			auto content = simple_fs::view_contents(*ff);
 			load_font(font_array.back(), content.data, content.file_size);
+			attach_glyph_cache(font_array.back(), content.data, content.file_size);
 			font_array.back().only_raw_codepoints = state.user_settings.use_classic_fonts;
 			font_array.back().file_name = fname;
 			resolved = &(font_array.back());
@@ -386,6 +392,7 @@ void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 			font_array.emplace_back();
 			auto content = simple_fs::view_contents(*ff);
 			load_font(font_array.back(), content.data, content.file_size);
+			attach_glyph_cache(font_array.back(), content.data, content.file_size);
 			font_array.back().only_raw_codepoints = state.user_settings.use_classic_fonts;
 			font_array.back().file_name = fname;
 			resolved = &(font_array.back());
@@ -475,54 +482,215 @@ float font::base_glyph_width(char32_t ch_in) {
 	make_glyph(ch_in);
 	return glyph_positions[ch_in].x_advance;
 }
+
+void make_glyph_distance_field(glyph_rasterizer::job& j) {
+	bool in_map[dr_size * dr_size] = {false};
+	float distance_map[dr_size * dr_size] = {0.0f};
+	init_in_map(in_map, j.bitmap.data(), j.btmap_x_off, j.btmap_y_off, j.width, j.height, j.pitch);
+	dead_reckoning(distance_map, in_map);
+	for(int y = 0; y < 64; ++y) {
+		for(int x = 0; x < 64; ++x) {
+			const size_t index = size_t(x + y * 64);
+			float const distance_value = distance_map[(x * magnification_factor + magnification_factor / 2) + (y * magnification_factor + magnification_factor / 2) * dr_size] / float(magnification_factor * 64);
+			int const int_value = int(distance_value * -255.0f + 128.0f);
+			const uint8_t small_value = uint8_t(std::min(255, std::max(0, int_value)));
+			j.result.pixels[index] = small_value;
+		}
+	}
+}
+
+void upload_glyph(uint32_t texture, uint16_t sub_index, uint8_t const* pixels) {
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, (sub_index & 7) * 64, ((sub_index >> 3) & 7) * 64, 64, 64, GL_RED, GL_UNSIGNED_BYTE, pixels);
+}
+
+void write_glyph_cache(glyph_disk_cache const& cache) {
+	auto count = uint32_t(cache.loaded.size() + cache.added.size());
+	std::vector<char> file_data(sizeof(cache.key) + sizeof(count) + size_t(count) * sizeof(sdf_glyph));
+	auto ptr = file_data.data();
+	std::memcpy(ptr, cache.key.key, sizeof(cache.key));
+	ptr += sizeof(cache.key);
+	std::memcpy(ptr, &count, sizeof(count));
+	ptr += sizeof(count);
+	if(!cache.loaded.empty())
+		std::memcpy(ptr, cache.loaded.data(), cache.loaded.size() * sizeof(sdf_glyph));
+	ptr += cache.loaded.size() * sizeof(sdf_glyph);
+	if(!cache.added.empty())
+		std::memcpy(ptr, cache.added.data(), cache.added.size() * sizeof(sdf_glyph));
+	auto dir = simple_fs::get_or_create_font_cache_directory();
+	simple_fs::write_file(dir, simple_fs::utf8_to_native(cache.file_name), file_data.data(), uint32_t(file_data.size()));
+}
+
+glyph_rasterizer::~glyph_rasterizer() {
+	{
+		std::lock_guard l{ lock };
+		stopping = true;
+	}
+	wake.notify_one();
+	if(worker.joinable())
+		worker.join();
+}
+
+void glyph_rasterizer::submit(job&& j) {
+	{
+		std::lock_guard l{ lock };
+		pending.push_back(std::move(j));
+	}
+	if(!worker.joinable())
+		worker = std::thread([this]() { run(); });
+	wake.notify_one();
+}
+
+void glyph_rasterizer::run() {
+	std::vector<glyph_disk_cache*> unsaved;
+	while(true) {
+		job j;
+		{
+			std::unique_lock l{ lock };
+			if(pending.empty() && !unsaved.empty()) {
+				l.unlock();
+				for(auto c : unsaved)
+					write_glyph_cache(*c);
+				unsaved.clear();
+				l.lock();
+			}
+			wake.wait(l, [&]() { return stopping || !pending.empty(); });
+			if(pending.empty())
+				return;
+			j = std::move(pending.front());
+			pending.pop_front();
+		}
+
+		make_glyph_distance_field(j);
+		if(j.cache) {
+			j.cache->added.push_back(j.result);
+			if(std::find(unsaved.begin(), unsaved.end(), j.cache) == unsaved.end())
+				unsaved.push_back(j.cache);
+		}
+		j.bitmap.clear();
+		j.bitmap.shrink_to_fit();
+
+		std::lock_guard l{ lock };
+		finished.push_back(std::move(j));
+	}
+}
+
+void glyph_rasterizer::upload_finished_glyphs() {
+	static std::vector<job> to_upload;
+	to_upload.clear();
+	{
+		std::lock_guard l{ lock };
+		if(finished.empty())
+			return;
+		std::swap(to_upload, finished);
+	}
+	for(auto& j : to_upload)
+		upload_glyph(j.texture, j.sub_index, j.result.pixels);
+}
+
+void font_manager::attach_glyph_cache(font& fnt, char const* file_data, uint32_t file_size) {
+	// the fields depend on the font and on how they are made, so a change to either has to start a new file
+	constexpr char const* field_version = "sdf 1";
+	auto cache = std::make_unique<glyph_disk_cache>();
+	blake2b_state hash;
+	blake2b_init(&hash, sizeof(cache->key));
+	blake2b_update(&hash, field_version, std::strlen(field_version));
+	int32_t const sizes[] = { magnification_factor, dr_size };
+	blake2b_update(&hash, sizes, sizeof(sizes));
+	blake2b_update(&hash, file_data, file_size);
+	blake2b_final(&hash, cache->key.key, sizeof(cache->key));
+
+	cache->file_name = "glyphs_";
+	for(uint32_t i = 0; i < 8; ++i) {
+		char const* digits = "0123456789abcdef";
+		cache->file_name += digits[cache->key.key[i] >> 4];
+		cache->file_name += digits[cache->key.key[i] & 0x0F];
+	}
+	cache->file_name += ".bin";
+
+	// the file holds the full key, the number of glyphs, and then the glyphs themselves
+	auto dir = simple_fs::get_or_create_font_cache_directory();
+	if(auto f = simple_fs::open_file(dir, simple_fs::utf8_to_native(cache->file_name)); f) {
+		auto contents = simple_fs::view_contents(*f);
+		uint32_t count = 0;
+		if(contents.file_size >= sizeof(cache->key) + sizeof(count) && std::memcmp(contents.data, cache->key.key, sizeof(cache->key)) == 0) {
+			std::memcpy(&count, contents.data + sizeof(cache->key), sizeof(count));
+			if((contents.file_size - sizeof(cache->key) - sizeof(count)) / sizeof(sdf_glyph) >= count) {
+				cache->loaded.resize(count);
+				if(count > 0)
+					std::memcpy(cache->loaded.data(), contents.data + sizeof(cache->key) + sizeof(count), size_t(count) * sizeof(sdf_glyph));
+				for(uint32_t i = 0; i < count; ++i)
+					cache->loaded_index.insert_or_assign(cache->loaded[i].glyph, i);
+			}
+		}
+	}
+
+	fnt.disk_cache = cache.get();
+	fnt.rasterizer = &rasterizer;
+	disk_caches.push_back(std::move(cache));
+}
+
 void font::make_glyph(char32_t ch_in) {
 	if(glyph_positions.find(ch_in) != glyph_positions.end())
 		return;
 
 	// load all glyph metrics
 	if(ch_in) {
-		FT_Load_Glyph(font_face, ch_in, FT_LOAD_TARGET_NORMAL | FT_LOAD_RENDER);
-
-		FT_Glyph g_result;
-		auto err = FT_Get_Glyph(font_face->glyph, &g_result);
-		if(err != 0) {
-			glyph_sub_offset gso;
-			gso.x = 0.f;
-			gso.y = 0.f;
-			gso.x_advance = 0.f;
-			gso.texture_slot = 0;
-			glyph_positions.insert_or_assign(ch_in, gso);
-			return;
-		}
-
-		FT_Bitmap const& bitmap = ((FT_BitmapGlyphRec*)g_result)->bitmap;
-
-		float const hb_x = float(font_face->glyph->metrics.horiBearingX) / 64.f;
-		float const hb_y = float(font_face->glyph->metrics.horiBearingY) / 64.f;
+		glyph_sub_offset gso;
+		glyph_rasterizer::job j;
 
-		
-		uint8_t pixel_buffer[64 * 64] = { 0 };
-		int const btmap_x_off = 32 * magnification_factor - bitmap.width / 2;
-		int const btmap_y_off = 32 * magnification_factor - bitmap.rows / 2;
+		// a glyph made on an earlier run only has to be put into its slot
+		sdf_glyph const* cached = nullptr;
+		if(disk_cache) {
+			if(auto it = disk_cache->loaded_index.find(ch_in); it != disk_cache->loaded_index.end())
+				cached = &(disk_cache->loaded[it->second]);
+		}
 
-		glyph_sub_offset gso;
-		gso.x = (hb_x - float(btmap_x_off)) * 1.0f / float(magnification_factor);
-		gso.y = (-hb_y - float(btmap_y_off)) * 1.0f / float(magnification_factor);
-		gso.x_advance = float(font_face->glyph->metrics.horiAdvance) / float((1 << 6) * magnification_factor);
-
-		bool in_map[dr_size * dr_size] = {false};
-		float distance_map[dr_size * dr_size] = {0.0f};
-		init_in_map(in_map, bitmap.buffer, btmap_x_off, btmap_y_off, bitmap.width, bitmap.rows, uint32_t(bitmap.pitch));
-		dead_reckoning(distance_map, in_map);
-		for(int y = 0; y < 64; ++y) {
-			for(int x = 0; x < 64; ++x) {
-				const size_t index = size_t(x + y * 64);
-				float const distance_value = distance_map[(x * magnification_factor + magnification_factor / 2) + (y * magnification_factor + magnification_factor / 2) * dr_size] / float(magnification_factor * 64);
-				int const int_value = int(distance_value * -255.0f + 128.0f);
-				const uint8_t small_value = uint8_t(std::min(255, std::max(0, int_value)));
-				pixel_buffer[index] = small_value;
+		if(cached) {
+			gso.x = cached->x;
+			gso.y = cached->y;
+			gso.x_advance = cached->x_advance;
+		} else {
+			FT_Load_Glyph(font_face, ch_in, FT_LOAD_TARGET_NORMAL | FT_LOAD_RENDER);
+
+			FT_Glyph g_result;
+			auto err = FT_Get_Glyph(font_face->glyph, &g_result);
+			if(err != 0) {
+				gso.x = 0.f;
+				gso.y = 0.f;
+				gso.x_advance = 0.f;
+				gso.texture_slot = 0;
+				glyph_positions.insert_or_assign(ch_in, gso);
+				return;
 			}
+
+			FT_Bitmap const& bitmap = ((FT_BitmapGlyphRec*)g_result)->bitmap;
+
+			float const hb_x = float(font_face->glyph->metrics.horiBearingX) / 64.f;
+			float const hb_y = float(font_face->glyph->metrics.horiBearingY) / 64.f;
+
+			int const btmap_x_off = 32 * magnification_factor - bitmap.width / 2;
+			int const btmap_y_off = 32 * magnification_factor - bitmap.rows / 2;
+
+			gso.x = (hb_x - float(btmap_x_off)) * 1.0f / float(magnification_factor);
+			gso.y = (-hb_y - float(btmap_y_off)) * 1.0f / float(magnification_factor);
+			gso.x_advance = float(font_face->glyph->metrics.horiAdvance) / float((1 << 6) * magnification_factor);
+
+			// the face cannot be shared with another thread, so the distance field is made from a copy of the bitmap
+			j.btmap_x_off = btmap_x_off;
+			j.btmap_y_off = btmap_y_off;
+			j.width = bitmap.width;
+			j.height = bitmap.rows;
+			j.pitch = uint32_t(bitmap.pitch);
+			j.bitmap.assign(bitmap.buffer, bitmap.buffer + size_t(bitmap.rows) * size_t(bitmap.pitch));
+			j.result.glyph = ch_in;
+			j.result.x = gso.x;
+			j.result.y = gso.y;
+			j.result.x_advance = gso.x_advance;
+			j.cache = disk_cache;
+			FT_Done_Glyph(g_result);
 		}
+
 		//The array
 		gso.texture_slot = first_free_slot;
 		GLuint texid = 0;
@@ -542,13 +710,20 @@ void font::make_glyph(char32_t ch_in) {
 			assert(textures.size() > 0);
 			texid = textures.back();
 			assert(texid);
-			glBindTexture(GL_TEXTURE_2D, texid);
 		}
 		if(texid) {
-			auto sub_index = first_free_slot & 63;
-			glTexSubImage2D(GL_TEXTURE_2D, 0, (sub_index & 7) * 64, ((sub_index >> 3) & 7) * 64, 64, 64, GL_RED, GL_UNSIGNED_BYTE, pixel_buffer);
+			auto sub_index = uint16_t(first_free_slot & 63);
+			if(cached) {
+				upload_glyph(texid, sub_index, cached->pixels);
+			} else if(rasterizer) {
+				j.texture = texid;
+				j.sub_index = sub_index;
+				rasterizer->submit(std::move(j));
+			} else {
+				make_glyph_distance_field(j);
+				upload_glyph(texid, sub_index, j.result.pixels);
+			}
 		}
-		FT_Done_Glyph(g_result);
 		//after texture slot
 		glyph_positions.insert_or_assign(ch_in, gso);
 		++first_free_slot;
@@ -578,6 +753,15 @@ stored_glyphs::stored_glyphs(stored_glyphs& other, uint32_t offset, uint32_t cou
 	std::copy_n(other.glyph_info.data() + offset, count, glyph_info.data());
 }
 
+static std::u16string shaping_cache_key(font_selection type, bool with_bidi, std::span<uint16_t> source) {
+	std::u16string key;
+	key.reserve(source.size() + 1);
+	key.push_back(char16_t(uint16_t(type) | (with_bidi ? 0x100 : 0)));
+	for(auto c : source)
+		key.push_back(char16_t(c));
+	return key;
+}
+
 void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& txt, std::span<uint16_t> source) {
 	txt.glyph_info.clear();
 
@@ -594,6 +778,13 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 		return;
 	}
 
+	// the glyphs of a cached entry have already been made by the call that shaped it
+	auto key = shaping_cache_key(type, true, source);
+	if(auto it = shaping_cache.find(key); it != shaping_cache.end()) {
+		txt.glyph_info = it->second;
+		return;
+	}
+
 	auto locale = state.font_collection.get_current_locale();
 	UBiDi* para;
 	UErrorCode errorCode = U_ZERO_ERROR;
@@ -654,6 +845,10 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 	}
 
 	ubidi_close(para);
+
+	if(shaping_cache.size() >= shaping_cache_limit)
+		shaping_cache.clear();
+	shaping_cache.insert_or_assign(std::move(key), txt.glyph_info);
 }
 
 void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_glyphs& txt, std::span<uint16_t> source) {
@@ -671,6 +866,12 @@ void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_
 		return;
 	}
 
+	auto key = shaping_cache_key(type, false, source);
+	if(auto it = shaping_cache.find(key); it != shaping_cache.end()) {
+		txt.glyph_info = it->second;
+		return;
+	}
+
 	auto locale = state.font_collection.get_current_locale();
 	
 	hb_feature_t feature_buffer[10];
@@ -707,6 +908,10 @@ void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_
 	if(state.world.locale_get_native_rtl(locale)) {
 		std::reverse(txt.glyph_info.begin(), txt.glyph_info.end());
 	}
+
+	if(shaping_cache.size() >= shaping_cache_limit)
+		shaping_cache.clear();
+	shaping_cache.insert_or_assign(std::move(key), txt.glyph_info);
 }
 
 void font::remake_cache(stored_glyphs& txt, std::string const& s) {
@@ -5,7 +5,12 @@
 #include "unordered_dense.h"
 #include "hb.h"
 #include "bmfont.hpp"
+#include "container_types.hpp"
 #include <span>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace sys {
 struct state;
@@ -37,7 +42,59 @@ struct glyph_sub_offset {
 
 class font_manager;
 
-enum class font_feature {
+// A glyph's signed distance field, at the size it has in a texture slot, along with its metrics.
+struct sdf_glyph {
+	char32_t glyph = 0;
+	float x = 0.0f;
+	float y = 0.0f;
+	float x_advance = 0.0f;
+	uint8_t pixels[64 * 64] = { 0 };
+};
+
+// The distance fields made for one font, kept on disk so that they do not have to be made again the next time the game
+// starts. The file belongs to the contents of the font, not its name.
+struct glyph_disk_cache {
+	std::string file_name;
+	sys::checksum_key key;
+	std::vector<sdf_glyph> loaded; // not changed after being read in, so that any thread can read it
+	ankerl::unordered_dense::map<char32_t, uint32_t> loaded_index;
+	std::vector<sdf_glyph> added; // belongs to the glyph_rasterizer thread
+};
+
+// Makes the distance fields of glyphs that have not been cached on a thread of its own, so that text with new characters in
+// it does not hold up the frame. The glyph's slot in the texture stays blank until upload_finished_glyphs puts the field in.
+// Whenever it runs out of work, the thread writes what it has added to the glyph_disk_cache files.
+class glyph_rasterizer {
+public:
+	struct job {
+		glyph_disk_cache* cache = nullptr;
+		uint32_t texture = 0;
+		uint16_t sub_index = 0;
+		int32_t btmap_x_off = 0;
+		int32_t btmap_y_off = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t pitch = 0;
+		std::vector<uint8_t> bitmap;
+		sdf_glyph result;
+	};
+
+	~glyph_rasterizer();
+	void submit(job&& j);
+	// has to be called on the thread that owns the opengl context
+	void upload_finished_glyphs();
+
+private:
+	void run();
+
+	std::thread worker;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::deque<job> pending;
+	std::vector<job> finished;
+	bool stopping = false;
+};
+
 	none, small_caps
 };
 
@@ -121,6 +178,15 @@ public:
 	uint16_t first_free_slot = 0;
 	std::unique_ptr<FT_Byte[]> file_data;
 	bool only_raw_codepoints = false;
+	// both are owned by the font_manager, and are only set for its own fonts; without them, glyphs are made on the spot
+	glyph_disk_cache* disk_cache = nullptr;
+	glyph_rasterizer* rasterizer = nullptr;
+
+	// The glyphs of recently shaped utf16 text. The key is the text, prefixed with a character holding the font selection
+	// and whether bidi runs were resolved. The shaping also depends on the locale, so the cache is cleared when the locale
+	// changes, as well as whenever it reaches shaping_cache_limit entries.
+	static constexpr size_t shaping_cache_limit = 8192;
+	ankerl::unordered_dense::map<std::u16string, std::vector<stored_glyph>> shaping_cache;
 
 	~font();
 	bool can_display(char32_t ch_in) const;
@@ -135,10 +201,13 @@ public:
 	void remake_cache(stored_glyphs& txt, std::string const& source);
 	void remake_cache(sys::state& state, font_selection type, stored_glyphs& txt, std::span<uint16_t> source);
 	void remake_bidiless_cache(sys::state& state, font_selection type, stored_glyphs& txt, std::span<uint16_t> source);
+	void clear_shaping_cache() {
+		shaping_cache.clear();
+	}
 
 	friend class font_manager;
 
-	font(font&& o) noexcept : file_name(std::move(o.file_name)), textures(std::move(o.textures)), glyph_positions(std::move(o.glyph_positions)), file_data(std::move(o.file_data)), first_free_slot(o.first_free_slot), only_raw_codepoints(o.only_raw_codepoints) {
+	font(font&& o) noexcept : file_name(std::move(o.file_name)), textures(std::move(o.textures)), glyph_positions(std::move(o.glyph_positions)), file_data(std::move(o.file_data)), first_free_slot(o.first_free_slot), only_raw_codepoints(o.only_raw_codepoints), disk_cache(o.disk_cache), rasterizer(o.rasterizer) {
 		font_face = o.font_face;
 		o.font_face = nullptr;
 		hb_font_face = o.hb_font_face;
@@ -167,6 +236,8 @@ public:
 		internal_top_adj = o.internal_top_adj;
 		first_free_slot = o.first_free_slot;
 		only_raw_codepoints = o.only_raw_codepoints;
+		disk_cache = o.disk_cache;
+		rasterizer = o.rasterizer;
 	}
 };
 
@@ -181,6 +252,9 @@ public:
 private:
 	std::vector<font> font_array;
 	dcon::locale_id current_locale;
+	std::vector<std::unique_ptr<glyph_disk_cache>> disk_caches;
+	glyph_rasterizer rasterizer; // after disk_caches, so that its thread is done with them before they go
+	void attach_glyph_cache(font& fnt, char const* file_data, uint32_t file_size);
 public:
 	std::vector<uint8_t> compiled_ubrk_rules;
 	bool map_font_is_black = false;
@@ -194,6 +268,9 @@ public:
 	float line_height(sys::state& state, uint16_t font_id);
 	float text_extent(sys::state& state, stored_glyphs const& txt, uint32_t starting_offset, uint32_t count, uint16_t font_id);
 	void set_classic_fonts(bool v);
+	void upload_finished_glyphs() {
+		rasterizer.upload_finished_glyphs();
+	}
 };
 
 std::string_view classic_unligate_utf8(text::font& font, char32_t c);
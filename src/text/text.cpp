@@ -93,34 +93,79 @@ bool codepoint_is_line_break(uint32_t c) noexcept {
 	return  c == 0x2029 || c == 0x2028 || c == uint32_t('\n') || c == uint32_t('\r');
 }
 
-void consume_csv_file(sys::state& state, char const* file_content, uint32_t file_size, int32_t target_column, bool as_unicode) {
+// the same conversion as done by state::add_key_win1252 and state::add_locale_data_win1252
+void append_win1252_as_utf8(std::string& out, std::string_view text) {
+	for(auto c : text) {
+		auto unicode = win1250toUTF16(c);
+		if(unicode == 0x00A7)
+			unicode = uint16_t('?'); // convert section symbol to ?
+		if(unicode <= 0x007F) {
+			out.push_back(char(unicode));
+		} else if(unicode <= 0x7FF) {
+			out.push_back(char(0xC0 | uint8_t(0x1F & (unicode >> 6))));
+			out.push_back(char(0x80 | uint8_t(0x3F & unicode)));
+		} else { // if unicode <= 0xFFFF
+			out.push_back(char(0xE0 | uint8_t(0x0F & (unicode >> 12))));
+			out.push_back(char(0x80 | uint8_t(0x3F & (unicode >> 6))));
+			out.push_back(char(0x80 | uint8_t(0x3F & unicode)));
+		}
+	}
+}
+
+csv_entries read_csv_file(char const* file_content, uint32_t file_size, int32_t target_column, bool as_unicode) {
+	csv_entries result;
+	result.as_unicode = as_unicode;
+	result.data.reserve(file_size);
+
 	auto cpos = file_content;
+	if(as_unicode && file_size >= 3) {
+		// skip utf8 BOM if present
+		// 0xEF, 0xBB, 0xBF)
+		if(int(file_content[0]) == 0xEF && int(file_content[1]) == 0xBB && int(file_content[2]) == 0xBF)
+			cpos += 3;
+	}
+	while(cpos < file_content + file_size) {
+		cpos = parsers::parse_fixed_amount_csv_values<14>(cpos, file_content + file_size, ';', [&](std::string_view const* values) {
+			csv_entries::row r;
+			r.key_start = uint32_t(result.data.size());
+			if(as_unicode)
+				result.data += values[0];
+			else
+				append_win1252_as_utf8(result.data, values[0]);
+			r.key_length = uint32_t(result.data.size()) - r.key_start;
+			r.value_start = uint32_t(result.data.size());
+			if(as_unicode)
+				result.data += values[target_column];
+			else
+				append_win1252_as_utf8(result.data, values[target_column]);
+			r.value_length = uint32_t(result.data.size()) - r.value_start;
+			result.rows.push_back(r);
+		});
+	}
+	return result;
+}
 
-	if(as_unicode) {
-		if(file_size >= 3) {
-			// skip utf8 BOM if present
-			// 0xEF, 0xBB, 0xBF)
-			if(int(file_content[0]) == 0xEF && int(file_content[1]) == 0xBB && int(file_content[2]) == 0xBF)
-				cpos += 3;
-		}
-		while(cpos < file_content + file_size) {
-			cpos = parsers::parse_fixed_amount_csv_values<14>(cpos, file_content + file_size, ';', [&](std::string_view const* values) {
-				auto key = state.add_key_utf8(values[0]);
-				auto entry = state.add_locale_data_utf8(values[target_column]);
-				state.locale_key_to_text_sequence.insert_or_assign(key, entry);
-			});
-		}
-	} else {
-		while(cpos < file_content + file_size) {
-			cpos = parsers::parse_fixed_amount_csv_values<14>(cpos, file_content + file_size, ';', [&](std::string_view const* values) {
-				auto key = state.add_key_win1252(values[0]);
-				auto entry = state.add_locale_data_win1252(values[target_column]);
-				state.locale_key_to_text_sequence.insert_or_assign(key, entry);
-			});
+void add_csv_entries(sys::state& state, csv_entries const& entries) {
+	for(auto& r : entries.rows) {
+		auto key = state.add_key_utf8(std::string_view(entries.data.data() + r.key_start, r.key_length));
+		auto value = std::string_view(entries.data.data() + r.value_start, r.value_length);
+		uint32_t entry = 0;
+		if(entries.as_unicode) {
+			entry = state.add_locale_data_utf8(value);
+		} else {
+			// unlike add_locale_data_utf8, add_locale_data_win1252 gives even an empty value its own terminator
+			entry = uint32_t(state.locale_text_data.size());
+			state.locale_text_data.insert(state.locale_text_data.end(), value.begin(), value.end());
+			state.locale_text_data.push_back(0);
 		}
+		state.locale_key_to_text_sequence.insert_or_assign(key, entry);
 	}
 }
 
+void consume_csv_file(sys::state& state, char const* file_content, uint32_t file_size, int32_t target_column, bool as_unicode) {
+	add_csv_entries(state, read_csv_file(file_content, file_size, target_column, as_unicode));
+}
+
 template<size_t N>
 bool is_fixed_token_ci(std::string_view v, char const (&t)[N]) {
 	if(v.length() != (N - 1))
@@ -626,6 +671,8 @@ std::string produce_simple_string(sys::state const& state, dcon::text_key id) {
 	} else {
 		sv = state.to_string_view(id);
 	}
+	// the escapes are only ever removed, so this is the only allocation the result needs
+	result.reserve(sv.length());
 
 	char const* section_start = sv.data();
 	for(char const* pos = sv.data(); pos < sv.data() + sv.length();) {
@@ -930,6 +930,21 @@ void close_layout_box(layout_base& dest, layout_box& box);
 void add_to_substitution_map(substitution_map& mp, variable_type key, substitution value);
 void add_to_substitution_map(substitution_map& mp, variable_type key, std::string const&); // DO NOT USE THIS FUNCTION
 
+// The rows of a localisation csv file, with the key and the wanted column already converted to utf8. Reading a file into one
+// does not touch the state, so that several files can be read in parallel; add_csv_entries then adds them to the state in order.
+struct csv_entries {
+	struct row {
+		uint32_t key_start = 0;
+		uint32_t key_length = 0;
+		uint32_t value_start = 0;
+		uint32_t value_length = 0;
+	};
+	std::string data;
+	std::vector<row> rows;
+	bool as_unicode = false;
+};
+csv_entries read_csv_file(char const* file_content, uint32_t file_size, int32_t target_column, bool as_unicode);
+void add_csv_entries(sys::state& state, csv_entries const& entries);
 void consume_csv_file(sys::state& state, char const* file_content, uint32_t file_size, int32_t target_column, bool as_unicode);
 variable_type variable_type_from_name(std::string_view);
 char16_t win1250toUTF16(char in);
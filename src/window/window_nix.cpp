@@ -262,6 +262,11 @@ void window_maximize_callback(GLFWwindow* window, int maximized) {
 	on_window_change(window);
 }
 
+void window_refresh_callback(GLFWwindow* window) {
+	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
+	state->note_window_event();
+}
+
 void focus_callback(GLFWwindow* window, int focused) {
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 	if(focused) {
@@ -313,6 +318,7 @@ void create_window(sys::state& game_state, creation_parameters const& params) {
 	glfwSetWindowMaximizeCallback(window, window_maximize_callback);
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 	glfwSetWindowFocusCallback(window, focus_callback);
+	glfwSetWindowRefreshCallback(window, window_refresh_callback);
 	glfwSetWindowSizeLimits(window, 640, 400, 2400, 1800);
 	if(params.borderless_fullscreen){
 		int width, height;
@@ -338,8 +344,13 @@ void create_window(sys::state& game_state, creation_parameters const& params) {
 		glfwPollEvents();
 		// Run game code
 
-		game_state.render();
-		glfwSwapBuffers(window);
+		if(game_state.frame_needed()) {
+			game_state.render();
+			glfwSwapBuffers(window);
+		} else {
+			// the last frame is still up to date: wait for an event, or until it is time to look for changes again
+			glfwWaitEventsTimeout(0.02);
+		}
 
 		sound::update_music_track(game_state);
 	}
@@ -273,6 +273,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 
 	case WM_PAINT:
 	case WM_DISPLAYCHANGE: {
+		state->note_window_event();
 		PAINTSTRUCT ps;
 		BeginPaint(hwnd, &ps);
 		EndPaint(hwnd, &ps);
@@ -393,11 +394,14 @@ void create_window(sys::state& game_state, creation_parameters const& params) {
 			if(game_state.ui_state.edit_target)
 				TranslateMessage(&msg);
 			DispatchMessageW(&msg);
-		} else {
+		} else if(game_state.frame_needed()) {
 			// Run game code
 
 			game_state.render();
 			SwapBuffers(game_state.win_ptr->opengl_window_dc);
+		} else {
+			// the last frame is still up to date: wait for a message, or until it is time to look for changes again
+			MsgWaitForMultipleObjects(0, nullptr, FALSE, 20, QS_ALLINPUT);
 		}
 	}
 }
@@ -7,6 +7,11 @@
 #include "system_state.hpp"
 #include "serialization.hpp"
 #include "prng.hpp"
+#ifdef _WIN32
+#include <concrt.h>
+#else
+#include <oneapi/tbb/global_control.h>
+#endif
 
 TEST_CASE("prng_simple", "[determinism]") {
 	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
@@ -26,6 +31,19 @@ TEST_CASE("prng_low_entropy", "[determinism]") {
 	REQUIRE(r1 == r2);
 }
 
+TEST_CASE("prng_batch", "[determinism]") {
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
+	game_state->game_seed = 64273;
+	game_state->current_date.value = 49963;
+	std::vector<uint32_t> values;
+	for(uint32_t i = 0; i < 37; ++i) // not a multiple of the block size
+		values.push_back(i * 0x9E37u ^ ~uint32_t(0x6a3f));
+	std::vector<uint64_t> results(values.size());
+	rng::get_random_batch(*game_state, values.data(), results.data(), uint32_t(values.size()));
+	for(size_t i = 0; i < values.size(); ++i)
+		REQUIRE(results[i] == rng::get_random(*game_state, values[i]));
+}
+
 #define UNOPTIMIZABLE_FLOAT(name, value) \
 	char name##_storage[sizeof(float)]; \
 	new (&name##_storage) float(value); \
@@ -98,7 +116,7 @@ void compare_game_states(sys::state& ws1, sys::state& ws2) {
 	auto tmp1 = std::unique_ptr<uint8_t[]>(new uint8_t[sizeof_save_section(ws1)]);
 	write_save_section(tmp1.get(), ws1);
 	auto tmp2 = std::unique_ptr<uint8_t[]>(new uint8_t[sizeof_save_section(ws2)]);
-	write_save_section(tmp2.get(), ws1);
+	write_save_section(tmp2.get(), ws2);
 	REQUIRE(sizeof_save_section(ws1) == sizeof_save_section(ws2));
 	REQUIRE(std::memcmp(tmp1.get(), tmp2.get(), sizeof_save_section(ws1)) == 0);
 }
@@ -288,7 +306,7 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 	province::update_cached_values(ws2);
 	compare_game_states(ws1, ws2);
 	nations::update_cached_values(ws1);
-	nations::update_cached_values(ws1);
+	nations::update_cached_values(ws2);
 	compare_game_states(ws1, ws2);
 
 	ws1.current_date += 1;
@@ -514,9 +532,6 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 			province::update_nationalism(ws2);
 			break;
 		case 12:
-			ai::update_ai_research(ws1);
-			ai::update_ai_research(ws2);
-			compare_game_states(ws1, ws2);
 			rebel::update_armies(ws1);
 			rebel::update_armies(ws2);
 			compare_game_states(ws1, ws2);
@@ -539,20 +554,6 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 			ai::take_ai_decisions(ws1);
 			ai::take_ai_decisions(ws2);
 			break;
-		case 17:
-			ai::build_ships(ws1);
-			ai::build_ships(ws2);
-			compare_game_states(ws1, ws2);
-			ai::update_land_constructions(ws1);
-			ai::update_land_constructions(ws2);
-			break;
-		case 18:
-			ai::update_ai_econ_construction(ws1);
-			ai::update_ai_econ_construction(ws2);
-			break;
-		case 19:
-			ai::update_budget(ws1);
-			ai::update_budget(ws2);
 		case 20:
 			nations::monthly_flashpoint_update(ws1);
 			nations::monthly_flashpoint_update(ws2);
@@ -571,9 +572,6 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 		case 23:
 			ai::civilize(ws1);
 			ai::civilize(ws2);
-			compare_game_states(ws1, ws2);
-			ai::make_war_decs(ws1);
-			ai::make_war_decs(ws2);
 			break;
 		case 24:
 			rebel::execute_rebel_victories(ws1);
@@ -628,6 +626,28 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 		compare_game_states(ws1, ws2);
 	}
 
+	ai::schedule_ai_planning(ws1);
+	ai::schedule_ai_planning(ws2);
+	compare_game_states(ws1, ws2);
+	ai::update_ai_research(ws1);
+	ai::update_ai_research(ws2);
+	compare_game_states(ws1, ws2);
+	ai::build_ships(ws1);
+	ai::build_ships(ws2);
+	compare_game_states(ws1, ws2);
+	ai::update_land_constructions(ws1);
+	ai::update_land_constructions(ws2);
+	compare_game_states(ws1, ws2);
+	ai::update_ai_econ_construction(ws1);
+	ai::update_ai_econ_construction(ws2);
+	compare_game_states(ws1, ws2);
+	ai::update_budget(ws1);
+	ai::update_budget(ws2);
+	compare_game_states(ws1, ws2);
+	ai::make_war_decs(ws1);
+	ai::make_war_decs(ws2);
+	compare_game_states(ws1, ws2);
+
 	military::apply_regiment_damage(ws1);
 	military::apply_regiment_damage(ws2);
 	compare_game_states(ws1, ws2);
@@ -713,3 +733,54 @@ TEST_CASE("sim_year", "[determinism]") {
 		checked_single_tick(*game_state_1, *game_state_2);
 	}
 }
+
+// While one of these exists, parallel_for and friends run everything on the calling thread
+class scoped_serial_execution {
+#ifdef _WIN32
+public:
+	scoped_serial_execution() {
+		concurrency::CurrentScheduler::Create(concurrency::SchedulerPolicy(2, concurrency::MinConcurrency, 1, concurrency::MaxConcurrency, 1));
+	}
+	~scoped_serial_execution() {
+		concurrency::CurrentScheduler::Detach();
+	}
+#else
+	tbb::global_control control{ tbb::global_control::max_allowed_parallelism, 1 };
+#endif
+};
+
+void compare_serial_and_parallel(int32_t days) {
+	// The same game run once on a single thread and once with full parallelism must stay bitwise identical, or the
+	// simulation depends on how the work happened to be scheduled (and multiplayer games will drift out of sync)
+	std::unique_ptr<sys::state> serial_state = load_testing_scenario_file();
+	std::unique_ptr<sys::state> parallel_state = load_testing_scenario_file();
+	serial_state->game_seed = parallel_state->game_seed = 808080;
+	serial_state->local_player_nation = parallel_state->local_player_nation = dcon::nation_id{};
+
+	for(int32_t i = 0; i < days; ++i) {
+		{
+			scoped_serial_execution serial;
+			serial_state->single_game_tick();
+		}
+		parallel_state->single_game_tick();
+
+		auto serial_key = serial_state->get_save_checksum();
+		auto parallel_key = parallel_state->get_save_checksum();
+		if(!serial_key.is_equal(parallel_key)) {
+			// the trees hold the per column hashes of the checksums just taken
+			auto serial_tree = serial_state->save_checksum.make_tree(serial_state->current_date);
+			auto parallel_tree = parallel_state->save_checksum.make_tree(parallel_state->current_date);
+			auto ymd = serial_state->current_date.to_ymd(serial_state->start_date);
+			INFO(ymd.year << "." << ymd.month << "." << ymd.day << " (serial vs parallel):\n" << sys::describe_divergence(serial_tree, parallel_tree));
+			FAIL("the serial and parallel runs diverged");
+		}
+	}
+}
+
+TEST_CASE("serial_parallel_week", "[determinism]") {
+	compare_serial_and_parallel(7);
+}
+
+TEST_CASE("serial_parallel_month", "[determinism]") {
+	compare_serial_and_parallel(31);
+}
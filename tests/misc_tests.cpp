@@ -60,6 +60,16 @@ TEST_CASE("date tests", "[misc_tests]") {
 	REQUIRE(ymdc.day == 16);
 }
 
+TEST_CASE("history encoding tests", "[misc_tests]") {
+	REQUIRE(economy::decode_history_value(economy::encode_history_value(0.0f)) == 0.0f);
+	REQUIRE(economy::encode_history_value(-5.0f) == economy::encode_history_value(0.0f));
+	for(float v : { 0.5f, 1.0f, 37.25f, 1234.0f, 9.5e6f, 3.0e12f }) {
+		auto decoded = economy::decode_history_value(economy::encode_history_value(v));
+		REQUIRE(std::abs(decoded - v) <= v * 0.001f);
+	}
+	REQUIRE(economy::encode_history_value(1.0e30f) == uint16_t(65535));
+}
+
 TEST_CASE("cyto payload tests", "[misc_tests]") {
 	SECTION("int_emplace") {
 		Cyto::Any payload = int(64);
@@ -225,3 +235,49 @@ TEST_CASE("cyto payload tests", "[misc_tests]") {
 		REQUIRE(any_cast<void *>(vp_payload) == (void *)nullptr);
 	}
 }
+
+TEST_CASE("mpsc queue tests", "[misc_tests]") {
+	SECTION("single thread") {
+		sys::MPSCQueue<int32_t> q(3);
+		REQUIRE(q.front() == nullptr);
+		REQUIRE(q.try_push(1));
+		REQUIRE(q.try_push(2));
+		REQUIRE(q.try_push(3));
+		REQUIRE(q.try_push(4));
+		REQUIRE(!q.try_push(5));
+		for(int32_t i = 1; i <= 4; ++i) {
+			REQUIRE(q.front() != nullptr);
+			REQUIRE(*q.front() == i);
+			q.pop();
+		}
+		REQUIRE(q.front() == nullptr);
+		REQUIRE(q.try_push(6));
+		REQUIRE(*q.front() == 6);
+	}
+	SECTION("several producers") {
+		sys::MPSCQueue<int32_t> q(64);
+		constexpr int32_t per_thread = 10000;
+		std::vector<std::thread> producers;
+		for(int32_t t = 0; t < 4; ++t) {
+			producers.emplace_back([&q, t]() {
+				for(int32_t i = 0; i < per_thread; ++i)
+					q.push(t * per_thread + i);
+			});
+		}
+		std::vector<int32_t> last_seen(4, -1);
+		int32_t received = 0;
+		while(received < 4 * per_thread) {
+			if(auto* v = q.front(); v) {
+				auto t = *v / per_thread;
+				// each producer's elements arrive in the order in which it pushed them
+				REQUIRE(*v % per_thread == last_seen[t] + 1);
+				last_seen[t] = *v % per_thread;
+				q.pop();
+				++received;
+			}
+		}
+		for(auto& p : producers)
+			p.join();
+		REQUIRE(q.front() == nullptr);
+	}
+}
@@ -0,0 +1,214 @@
+#include <atomic>
+#include <random>
+#include <thread>
+#include "catch.hpp"
+#include "system_state.hpp"
+#include "commands.hpp"
+#include "network.hpp"
+
+// nobody reads the ui-bound queues of the headless peers, and a full queue would block the tick that pushes into it
+void drain_peer_ui_queues(sys::state& state) {
+	while(state.new_n_event.front())
+		state.new_n_event.pop();
+	while(state.new_f_n_event.front())
+		state.new_f_n_event.pop();
+	while(state.new_p_event.front())
+		state.new_p_event.pop();
+	while(state.new_f_p_event.front())
+		state.new_f_p_event.pop();
+	while(state.new_requests.front())
+		state.new_requests.pop();
+	while(state.new_messages.front())
+		state.new_messages.pop();
+	while(state.naval_battle_reports.front())
+		state.naval_battle_reports.pop();
+	while(state.land_battle_reports.front())
+		state.land_battle_reports.pop();
+}
+
+// something a player might do at any moment; what the nation is not allowed to do right now is skipped
+void issue_random_command(sys::state& state, std::mt19937& gen) {
+	auto n = state.local_player_nation;
+	switch(gen() % 4) {
+	case 0:
+	{
+		auto target = dcon::nation_id{ dcon::nation_id::value_base_t(gen() % state.world.nation_size()) };
+		if(command::can_increase_relations(state, n, target))
+			command::increase_relations(state, n, target);
+		break;
+	}
+	case 1:
+	{
+		auto tech = dcon::technology_id{ dcon::technology_id::value_base_t(gen() % state.world.technology_size()) };
+		if(command::can_start_research(state, n, tech))
+			command::start_research(state, n, tech);
+		break;
+	}
+	case 2:
+	{
+		command::budget_settings_data values;
+		for(auto v : { &values.education_spending, &values.military_spending, &values.administrative_spending, &values.social_spending,
+			&values.land_spending, &values.naval_spending, &values.construction_spending, &values.poor_tax, &values.middle_tax,
+			&values.rich_tax, &values.tariffs, &values.domestic_investment, &values.overseas }) {
+			*v = int8_t(gen() % 101);
+		}
+		if(command::can_change_budget_settings(state, n, values))
+			command::change_budget_settings(state, n, values);
+		break;
+	}
+	default:
+	{
+		auto c = dcon::commodity_id{ dcon::commodity_id::value_base_t(gen() % state.world.commodity_size()) };
+		auto amount = float(gen() % 1000);
+		bool draw = (gen() & 1) != 0;
+		if(command::can_change_stockpile_settings(state, n, c, amount, draw))
+			command::change_stockpile_settings(state, n, c, amount, draw);
+		break;
+	}
+	}
+}
+
+int32_t clients_in_game(sys::state& host) {
+	int32_t count = 0;
+	for(auto& client : host.network_state.clients) {
+		if(client.is_active() && !client.handshake)
+			++count;
+	}
+	return count;
+}
+
+// One host and client_count clients, each a complete game state of its own in this process, play days days over the
+// loopback interface, each on a thread of its own that does what state::game_loop does, while every player gives random
+// commands. The host checks the state of the clients against its own every day, so any divergence is caught on the day it
+// happens; afterwards all of them must be on the same day with the same state, having got there at no less than
+// minimum_ticks_per_second.
+void run_lockstep_soak(int32_t client_count, int32_t days, double minimum_ticks_per_second) {
+	std::unique_ptr<sys::state> host = load_testing_scenario_file();
+	host->game_seed = 808080;
+	host->network_mode = sys::network_mode_type::host;
+	host->network_state.nickname = sys::player_name{ "host" };
+	host->cheat_data.daily_oos_check = true;
+	network::init(*host);
+	auto end_date = host->current_date + days;
+
+	std::vector<std::unique_ptr<sys::state>> clients;
+	for(int32_t i = 0; i < client_count; ++i) {
+		clients.push_back(load_testing_scenario_file());
+		clients.back()->network_mode = sys::network_mode_type::client;
+		clients.back()->network_state.ip_address = "127.0.0.1";
+		clients.back()->network_state.nickname = sys::player_name{ "client" };
+		clients.back()->cheat_data.daily_oos_check = true;
+	}
+
+	std::atomic<bool> issue_commands = true;
+	std::atomic<bool> stop = false;
+	std::atomic<bool> started = false;
+	std::vector<std::atomic<int32_t>> dates(clients.size() + 1);
+	for(auto& d : dates)
+		d.store(int32_t(host->current_date.value));
+
+	std::chrono::steady_clock::time_point run_start;
+	std::chrono::steady_clock::time_point run_end;
+	std::thread host_thread([&]() {
+		std::mt19937 gen(1);
+		bool start_sent = false;
+		bool reached_end = false;
+		while(!stop.load(std::memory_order::acquire)) {
+			network::send_and_receive_commands(*host);
+			command::execute_pending_commands(*host);
+			drain_peer_ui_queues(*host);
+			if(!start_sent) {
+				if(clients_in_game(*host) == client_count) {
+					command::notify_start_game(*host, host->local_player_nation);
+					start_sent = true;
+					run_start = std::chrono::steady_clock::now();
+				} else {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				continue;
+			}
+			if(!host->current_scene.game_in_progress) { // until the notify_start_game has gone out
+				continue;
+			}
+			started.store(true, std::memory_order::release);
+			if(issue_commands.load(std::memory_order::acquire) && gen() % 4 == 0)
+				issue_random_command(*host, gen);
+			if(host->current_date == end_date && !reached_end) {
+				run_end = std::chrono::steady_clock::now();
+				reached_end = true;
+			}
+			if(host->current_date < end_date && network::clients_keep_up(*host)) {
+				command::advance_tick(*host, host->local_player_nation);
+			} else {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			dates[0].store(int32_t(host->current_date.value), std::memory_order::release);
+		}
+	});
+
+	std::vector<std::thread> client_threads;
+	for(size_t i = 0; i < clients.size(); ++i) {
+		network::init(*clients[i]);
+		client_threads.emplace_back([&, i]() {
+			auto& state = *clients[i];
+			std::mt19937 gen(uint32_t(i + 2));
+			while(!stop.load(std::memory_order::acquire)) {
+				network::send_and_receive_commands(state);
+				command::execute_pending_commands(state);
+				drain_peer_ui_queues(state);
+				if(state.current_scene.game_in_progress && issue_commands.load(std::memory_order::acquire) && gen() % 4 == 0)
+					issue_random_command(state, gen);
+				network::wait_for_host_data(state, 1);
+				dates[i + 1].store(int32_t(state.current_date.value), std::memory_order::release);
+			}
+		});
+	}
+
+	// the host stops on end_date by itself; wait for the clients to catch up with it, then give the last commands time to
+	// make their way to everyone
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(days) + std::chrono::minutes(2);
+	auto all_done = [&]() {
+		for(auto& d : dates) {
+			if(d.load(std::memory_order::acquire) != int32_t(end_date.value))
+				return false;
+		}
+		return true;
+	};
+	while(!all_done() && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	issue_commands.store(false, std::memory_order::release);
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	stop.store(true, std::memory_order::release);
+	host_thread.join();
+	for(auto& t : client_threads)
+		t.join();
+
+	REQUIRE(started.load());
+	REQUIRE(host->current_date == end_date);
+	auto host_checksum = host->get_save_checksum();
+	for(size_t i = 0; i < clients.size(); ++i) {
+		INFO("client " << i);
+		REQUIRE(!clients[i]->network_state.out_of_sync);
+		REQUIRE(clients[i]->current_date == end_date);
+		REQUIRE(clients[i]->get_save_checksum().is_equal(host_checksum));
+	}
+
+	auto run_ms = std::chrono::duration_cast<std::chrono::milliseconds>(run_end - run_start).count();
+	auto ticks_per_second = double(days) * 1000.0 / double(std::max(run_ms, int64_t(1)));
+	INFO(days << " days with " << client_count << " clients at " << ticks_per_second << " ticks/sec");
+	REQUIRE(ticks_per_second >= minimum_ticks_per_second);
+
+	for(auto& c : clients)
+		network::finish(*c, false);
+	network::finish(*host, false);
+}
+
+TEST_CASE("lockstep_loopback_month", "[network]") {
+	// the floor is only there to catch the lockstep stalling (on a missed acknowledgement, say), not slow ticks
+	run_lockstep_soak(2, 31, 1.0);
+}
+
+// thousands of ticks take a while, so this one only runs when asked for, with the [soak] tag
+TEST_CASE("lockstep_loopback_soak", "[.][soak][network]") {
+	run_lockstep_soak(3, 2000, 5.0);
+}
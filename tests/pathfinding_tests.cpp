@@ -0,0 +1,143 @@
+#include "catch.hpp"
+#include "system_state.hpp"
+#include "province.hpp"
+#include "province_templates.hpp"
+#include "prng.hpp"
+
+// the sum of the adjacency distances along a path laid out as the path functions return it (destination first, first step
+// last); fails if two consecutive provinces are not connected by a passable border
+float checked_path_length(sys::state& state, dcon::province_id start, std::vector<dcon::province_id> const& path) {
+	float total = 0.0f;
+	auto from = start;
+	for(auto i = path.size(); i-- > 0;) {
+		auto adj = state.world.get_province_adjacency_by_province_pair(from, path[i]);
+		REQUIRE(bool(adj));
+		REQUIRE((state.world.province_adjacency_get_type(adj) & province::border::impassible_bit) == 0);
+		total += state.world.province_adjacency_get_distance(adj);
+		from = path[i];
+	}
+	return total;
+}
+
+TEST_CASE("random land paths", "[pathfinding]") {
+	auto ws = load_testing_scenario_file();
+	ws->game_seed = 808080;
+
+	std::vector<dcon::province_id> land_provinces;
+	province::for_each_land_province(*ws, [&](dcon::province_id id) { land_provinces.push_back(id); });
+	REQUIRE(land_provinces.size() > 1);
+
+	std::vector<dcon::province_id> sources(1);
+	province::land_path_field field;
+
+	for(uint32_t i = 0; i < 2000; ++i) {
+		auto start = land_provinces[rng::get_random(*ws, i, 0) % land_provinces.size()];
+		auto end = land_provinces[rng::get_random(*ws, i, 1) % land_provinces.size()];
+		auto nation = ws->world.province_get_nation_from_province_ownership(start);
+		INFO(i << ": " << start.index() << " -> " << end.index());
+
+		auto land_path = province::make_land_path(*ws, start, end, nation, dcon::army_id{});
+		if(!land_path.empty()) {
+			REQUIRE(land_path.front() == end);
+			checked_path_length(*ws, start, land_path);
+		}
+
+		// the search outwards from the destination that moves of several armies use must reach the same provinces
+		sources[0] = start;
+		province::make_land_path_field(*ws, field, end, nation, dcon::army_id{}, sources);
+		if(start != end) {
+			REQUIRE(land_path.empty() == !field.reaches(start));
+			if(!land_path.empty()) {
+				auto field_path = field.path_from(start);
+				REQUIRE(field_path.front() == end);
+				checked_path_length(*ws, start, field_path);
+			}
+		}
+
+		// the single search and the search outwards from the destination must agree on which provinces can reach it, and
+		// neither the heuristic nor the path found may be shorter than the shortest path
+		auto safe_path = province::make_safe_land_path(*ws, start, end, nation);
+		sources[0] = start;
+		province::make_safe_land_path_field(*ws, field, end, nation, sources);
+		if(start == end) {
+			REQUIRE(safe_path.empty());
+			continue;
+		}
+		REQUIRE(safe_path.empty() == !field.reaches(start));
+		if(!safe_path.empty()) {
+			REQUIRE(safe_path.front() == end);
+			auto shortest = field.distances[start.index()];
+			auto length = checked_path_length(*ws, start, safe_path);
+			REQUIRE(length >= shortest * 0.999f);
+			REQUIRE(province::path_distance_lower_bound(*ws, start, end) <= shortest * 1.001f + 0.01f);
+			REQUIRE(checked_path_length(*ws, start, field.path_from(start)) == Approx(shortest).epsilon(0.001));
+		}
+	}
+}
+
+// the regions and nation adjacency as update_connected_regions leaves them, in a form that does not depend on the region
+// ids handed out or the order the adjacency was created in
+struct connected_region_snapshot {
+	std::vector<uint16_t> first_province_of_region; // for each land province, the lowest land province in its region
+	std::vector<bool> region_is_coastal;
+	std::vector<std::pair<int32_t, int32_t>> adjacent_nations;
+};
+connected_region_snapshot take_connected_region_snapshot(sys::state& state) {
+	connected_region_snapshot result;
+	std::vector<uint16_t> first_of_id(state.province_definitions.connected_region_is_coastal.size() + 1, uint16_t(0xFFFF));
+	province::for_each_land_province(state, [&](dcon::province_id id) {
+		auto region = state.world.province_get_connected_region_id(id);
+		REQUIRE(region != 0);
+		REQUIRE(size_t(region) < first_of_id.size());
+		if(first_of_id[region] == 0xFFFF)
+			first_of_id[region] = uint16_t(id.index());
+		result.first_province_of_region.push_back(first_of_id[region]);
+		result.region_is_coastal.push_back(state.province_definitions.connected_region_is_coastal[region - 1]);
+	});
+	for(auto a : state.world.in_nation_adjacency) {
+		auto x = a.get_connected_nations(0).id.index();
+		auto y = a.get_connected_nations(1).id.index();
+		result.adjacent_nations.emplace_back(std::min(x, y), std::max(x, y));
+	}
+	std::sort(result.adjacent_nations.begin(), result.adjacent_nations.end());
+	return result;
+}
+
+TEST_CASE("connected regions after ownership changes", "[pathfinding]") {
+	auto ws = load_testing_scenario_file();
+	ws->game_seed = 808080;
+
+	std::vector<dcon::province_id> land_provinces;
+	province::for_each_land_province(*ws, [&](dcon::province_id id) { land_provinces.push_back(id); });
+
+	// hand provinces to the owner of a neighbor, as wars do, and compare what the regions were updated to with what they
+	// would have been built as from scratch
+	for(uint32_t i = 0; i < 400; ++i) {
+		auto p = land_provinces[rng::get_random(*ws, i, 0) % land_provinces.size()];
+		if(!ws->world.province_get_nation_from_province_ownership(p))
+			continue;
+		dcon::nation_id new_owner;
+		for(auto adj : ws->world.province_get_province_adjacency(p)) {
+			auto other = adj.get_connected_provinces(0) != p ? adj.get_connected_provinces(0) : adj.get_connected_provinces(1);
+			if(other.id.index() < ws->province_definitions.first_sea_province.index() && other.get_nation_from_province_ownership() && other.get_nation_from_province_ownership() != ws->world.province_get_nation_from_province_ownership(p)) {
+				new_owner = other.get_nation_from_province_ownership();
+				break;
+			}
+		}
+		if(!new_owner)
+			continue;
+		province::change_province_owner(*ws, p, new_owner);
+
+		if(i % 8 != 0)
+			continue;
+		INFO(i);
+		province::update_connected_regions(*ws);
+		auto updated = take_connected_region_snapshot(*ws);
+		ws->adjacency_data_out_of_date = true;
+		province::update_connected_regions(*ws);
+		auto rebuilt = take_connected_region_snapshot(*ws);
+		REQUIRE(updated.first_province_of_region == rebuilt.first_province_of_region);
+		REQUIRE(updated.region_is_coastal == rebuilt.region_is_coastal);
+		REQUIRE(updated.adjacent_nations == rebuilt.adjacent_nations);
+	}
+}
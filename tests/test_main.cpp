@@ -45,6 +45,8 @@ std::unique_ptr<sys::state> load_testing_scenario_file() {
 #include "triggers_tests.cpp"
 #include "dcon_tests.cpp"
 #include "determinism_tests.cpp"
+#include "pathfinding_tests.cpp"
+#include "network_tests.cpp"
 
 TEST_CASE("Dummy test", "[dummy test instance]") {
 	REQUIRE(1 + 1 == 2);
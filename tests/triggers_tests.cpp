@@ -433,6 +433,61 @@ TEST_CASE("and folding", "[trigger_tests]") {
 	}
 }
 
+TEST_CASE("constant folding", "[trigger_tests]") {
+	{ // a false member decides an and
+		std::vector<uint16_t> t;
+		t.push_back(uint16_t(trigger::generic_scope));
+		t.push_back(uint16_t(4));
+		t.push_back(uint16_t(trigger::association_eq | trigger::blockade));
+		t.push_back(uint16_t(2));
+		t.push_back(uint16_t(1));
+		t.push_back(uint16_t(trigger::association_ne | trigger::no_payload | trigger::always));
+
+		const auto new_size = parsers::simplify_trigger(t.data());
+
+		REQUIRE(1 == new_size);
+		REQUIRE(t[0] == uint16_t(trigger::association_ne | trigger::no_payload | trigger::always));
+	}
+	{ // a false member is dropped from an or
+		std::vector<uint16_t> t;
+		t.push_back(uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope));
+		t.push_back(uint16_t(6));
+		t.push_back(uint16_t(trigger::association_ne | trigger::no_payload | trigger::always));
+		t.push_back(uint16_t(trigger::association_eq | trigger::blockade));
+		t.push_back(uint16_t(2));
+		t.push_back(uint16_t(1));
+		t.push_back(uint16_t(trigger::association_eq | trigger::no_payload | trigger::owns));
+		t.push_back(uint16_t(0));
+
+		const auto new_size = parsers::simplify_trigger(t.data());
+
+		REQUIRE(7 == new_size);
+		REQUIRE(t[0] == uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope));
+		REQUIRE(t[1] == uint16_t(6));
+		REQUIRE(t[2] == uint16_t(trigger::association_eq | trigger::blockade));
+		REQUIRE(t[3] == uint16_t(2));
+		REQUIRE(t[4] == uint16_t(1));
+		REQUIRE(t[5] == uint16_t(trigger::association_eq | trigger::no_payload | trigger::owns));
+		REQUIRE(t[6] == uint16_t(0));
+	}
+	{ // a scope folded to a constant stays as that constant inside its parent
+		std::vector<uint16_t> t;
+		t.push_back(uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope));
+		t.push_back(uint16_t(6));
+		t.push_back(uint16_t(trigger::generic_scope));
+		t.push_back(uint16_t(1));
+		t.push_back(uint16_t(trigger::association_eq | trigger::no_payload | trigger::always));
+		t.push_back(uint16_t(trigger::association_eq | trigger::blockade));
+		t.push_back(uint16_t(2));
+		t.push_back(uint16_t(1));
+
+		const auto new_size = parsers::simplify_trigger(t.data());
+
+		REQUIRE(1 == new_size);
+		REQUIRE(t[0] == uint16_t(trigger::association_eq | trigger::no_payload | trigger::always));
+	}
+}
+
 TEST_CASE("effect scope absorbsion", "[effect_tests]") {
 	{
 		std::vector<uint16_t> t;
@@ -775,13 +830,10 @@ TEST_CASE("complex full reduction", "[trigger_tests]") {
 	const auto new_size = parsers::simplify_trigger(tc.compiled_trigger.data());
 	tc.compiled_trigger.resize(static_cast<size_t>(new_size));
 
-	REQUIRE(size_t(8) == tc.compiled_trigger.size());
-	REQUIRE(tc.compiled_trigger[0] == uint16_t(trigger::is_disjunctive_scope | trigger::generic_scope));
-	REQUIRE(tc.compiled_trigger[1] == uint16_t(7));
-	REQUIRE(tc.compiled_trigger[2] == uint16_t(trigger::association_ne | trigger::no_payload | trigger::always));
-	REQUIRE(tc.compiled_trigger[3] == uint16_t(trigger::is_disjunctive_scope | trigger::x_core_scope_nation));
-	REQUIRE(tc.compiled_trigger[4] == uint16_t(4));
-	REQUIRE(tc.compiled_trigger[5] == uint16_t(trigger::association_lt | trigger::average_consciousness_province));
+	REQUIRE(size_t(5) == tc.compiled_trigger.size());
+	REQUIRE(tc.compiled_trigger[0] == uint16_t(trigger::is_disjunctive_scope | trigger::x_core_scope_nation));
+	REQUIRE(tc.compiled_trigger[1] == uint16_t(4));
+	REQUIRE(tc.compiled_trigger[2] == uint16_t(trigger::association_lt | trigger::average_consciousness_province));
 }
 
 TEST_CASE("batch-individual comparision", "[trigger_tests]") {